@@ -0,0 +1,91 @@
+/******************************************************************************/
+/*                                                                            */
+/*    ODYSSEUS/EduCOSMOS Educational-Purpose Object Storage System            */
+/*                                                                            */
+/*    Developed by Professor Kyu-Young Whang et al.                           */
+/*                                                                            */
+/*    Database and Multimedia Laboratory                                      */
+/*                                                                            */
+/*    Computer Science Department and                                         */
+/*    Advanced Information Technology Research Center (AITrc)                 */
+/*    Korea Advanced Institute of Science and Technology (KAIST)              */
+/*                                                                            */
+/*    e-mail: kywhang@cs.kaist.ac.kr                                          */
+/*    phone: +82-42-350-7722                                                  */
+/*    fax: +82-42-350-8380                                                    */
+/*                                                                            */
+/*    Copyright (c) 1995-2013 by Kyu-Young Whang                              */
+/*                                                                            */
+/*    All rights reserved. No part of this software may be reproduced,        */
+/*    stored in a retrieval system, or transmitted, in any form or by any     */
+/*    means, electronic, mechanical, photocopying, recording, or otherwise,   */
+/*    without prior written permission of the copyright owner.                */
+/*                                                                            */
+/******************************************************************************/
+/*
+ * Module: EduArtM_CreateIndex.c
+ *
+ * Description:
+ *  Create a new adaptive radix tree index.
+ *
+ * Exports:
+ *  Four EduArtM_CreateIndex(KeyDesc*, ArtIndex**)
+ */
+
+
+#include <stdlib.h>
+#include "EduBtM_common.h"
+#include "EduArtM_Internal.h"
+
+
+
+/*@================================
+ * EduArtM_CreateIndex()
+ *================================*/
+/*
+ * Function: Four EduArtM_CreateIndex(KeyDesc*, ArtIndex**)
+ *
+ * Description:
+ *  Create a new, empty adaptive radix tree index. The index lives only in
+ *  the memory and is independent of the B+ tree indexes of the same data
+ *  file; it is saved to and rebuilt from a data file by EduArtM_Snapshot()
+ *  and EduArtM_Rebuild().
+ *  The key parts should be SM_INT of 4 bytes or SM_VARSTRING, and the keys
+ *  should be unique.
+ *
+ * Returns:
+ *  error code
+ *    eBADPARAMETER_BTM
+ *    eNOTSUPPORTED_EDUBTM
+ *    eMEMORYALLOCERR_BTM
+ *
+ * Side effects:
+ *  index : the new index
+ */
+Four EduArtM_CreateIndex(
+    KeyDesc             *kdesc,         /* IN key descriptor */
+    ArtIndex            **index)        /* OUT the new index */
+{
+    int                 i;              /* index for # of key parts */
+
+
+    if (kdesc == NULL || index == NULL) ERR(eBADPARAMETER_BTM);
+
+    /* Error check whether using not supported functionality by EduBtM */
+    for(i=0; i<kdesc->nparts; i++)
+    {
+        if(!(kdesc->kpart[i].type==SM_INT && kdesc->kpart[i].length==sizeof(Four_Invariable)) &&
+           kdesc->kpart[i].type!=SM_VARSTRING)
+            ERR(eNOTSUPPORTED_EDUBTM);
+    }
+
+	*index = (ArtIndex*)malloc(sizeof(ArtIndex));
+	if (*index == NULL) ERR(eMEMORYALLOCERR_BTM);
+
+	(*index)->kdesc = *kdesc;
+	(*index)->root = NULL;
+	(*index)->nEntries = 0;
+
+    return(eNOERROR);
+
+} /* EduArtM_CreateIndex() */
@@ -0,0 +1,81 @@
+/******************************************************************************/
+/*                                                                            */
+/*    ODYSSEUS/EduCOSMOS Educational-Purpose Object Storage System            */
+/*                                                                            */
+/*    Developed by Professor Kyu-Young Whang et al.                           */
+/*                                                                            */
+/*    Database and Multimedia Laboratory                                      */
+/*                                                                            */
+/*    Computer Science Department and                                         */
+/*    Advanced Information Technology Research Center (AITrc)                 */
+/*    Korea Advanced Institute of Science and Technology (KAIST)              */
+/*                                                                            */
+/*    e-mail: kywhang@cs.kaist.ac.kr                                          */
+/*    phone: +82-42-350-7722                                                  */
+/*    fax: +82-42-350-8380                                                    */
+/*                                                                            */
+/*    Copyright (c) 1995-2013 by Kyu-Young Whang                              */
+/*                                                                            */
+/*    All rights reserved. No part of this software may be reproduced,        */
+/*    stored in a retrieval system, or transmitted, in any form or by any     */
+/*    means, electronic, mechanical, photocopying, recording, or otherwise,   */
+/*    without prior written permission of the copyright owner.                */
+/*                                                                            */
+/******************************************************************************/
+/*
+ * Module: EduArtM_DeleteObject.c
+ *
+ * Description:
+ *  Delete an ObjectID from an adaptive radix tree index.
+ *
+ * Exports:
+ *  Four EduArtM_DeleteObject(ArtIndex*, KeyValue*, ObjectID*)
+ */
+
+
+#include <stdlib.h>
+#include "EduBtM_common.h"
+#include "EduArtM_Internal.h"
+
+
+
+/*@================================
+ * EduArtM_DeleteObject()
+ *================================*/
+/*
+ * Function: Four EduArtM_DeleteObject(ArtIndex*, KeyValue*, ObjectID*)
+ *
+ * Description:
+ *  Delete the pair (key, ObjectID) from the index.
+ *
+ * Returns:
+ *  error code
+ *    eBADPARAMETER_BTM
+ *    eNOTFOUND_BTM
+ *    some errors caused by function calls
+ */
+Four EduArtM_DeleteObject(
+    ArtIndex            *index,         /* IN the index */
+    KeyValue            *kval,          /* IN key value */
+    ObjectID            *oid)           /* IN ObjectID to delete */
+{
+    Four                e;              /* error number */
+    Two                 nlen;           /* length of the normalized key */
+    unsigned char       nkey[MAXKEYLEN]; /* the normalized key */
+    ArtLeaf             *leaf;          /* the removed leaf */
+
+
+    if (index == NULL || kval == NULL || oid == NULL) ERR(eBADPARAMETER_BTM);
+
+	e = eduartm_NormalizeKey(&index->kdesc, kval, nkey, &nlen);
+	if (e < 0) ERR(e);
+
+	leaf = eduartm_Delete(&index->root, nkey, nlen, 0, oid);
+	if (leaf == NULL) ERR(eNOTFOUND_BTM);
+
+	free(leaf);
+	index->nEntries--;
+
+    return(eNOERROR);
+
+} /* EduArtM_DeleteObject() */
@@ -0,0 +1,67 @@
+/******************************************************************************/
+/*                                                                            */
+/*    ODYSSEUS/EduCOSMOS Educational-Purpose Object Storage System            */
+/*                                                                            */
+/*    Developed by Professor Kyu-Young Whang et al.                           */
+/*                                                                            */
+/*    Database and Multimedia Laboratory                                      */
+/*                                                                            */
+/*    Computer Science Department and                                         */
+/*    Advanced Information Technology Research Center (AITrc)                 */
+/*    Korea Advanced Institute of Science and Technology (KAIST)              */
+/*                                                                            */
+/*    e-mail: kywhang@cs.kaist.ac.kr                                          */
+/*    phone: +82-42-350-7722                                                  */
+/*    fax: +82-42-350-8380                                                    */
+/*                                                                            */
+/*    Copyright (c) 1995-2013 by Kyu-Young Whang                              */
+/*                                                                            */
+/*    All rights reserved. No part of this software may be reproduced,        */
+/*    stored in a retrieval system, or transmitted, in any form or by any     */
+/*    means, electronic, mechanical, photocopying, recording, or otherwise,   */
+/*    without prior written permission of the copyright owner.                */
+/*                                                                            */
+/******************************************************************************/
+/*
+ * Module: EduArtM_DropIndex.c
+ *
+ * Description:
+ *  Drop an adaptive radix tree index.
+ *
+ * Exports:
+ *  Four EduArtM_DropIndex(ArtIndex*)
+ */
+
+
+#include <stdlib.h>
+#include "EduBtM_common.h"
+#include "EduArtM_Internal.h"
+
+
+
+/*@================================
+ * EduArtM_DropIndex()
+ *================================*/
+/*
+ * Function: Four EduArtM_DropIndex(ArtIndex*)
+ *
+ * Description:
+ *  Free all the nodes and the leaves of the index and the index itself.
+ *  A snapshot of the index in a data file is not affected.
+ *
+ * Returns:
+ *  error code
+ *    eBADPARAMETER_BTM
+ */
+Four EduArtM_DropIndex(
+    ArtIndex            *index)         /* IN the index to drop */
+{
+
+    if (index == NULL) ERR(eBADPARAMETER_BTM);
+
+	eduartm_FreeTree(index->root);
+	free(index);
+
+    return(eNOERROR);
+
+} /* EduArtM_DropIndex() */
@@ -0,0 +1,121 @@
+/******************************************************************************/
+/*                                                                            */
+/*    ODYSSEUS/EduCOSMOS Educational-Purpose Object Storage System            */
+/*                                                                            */
+/*    Developed by Professor Kyu-Young Whang et al.                           */
+/*                                                                            */
+/*    Database and Multimedia Laboratory                                      */
+/*                                                                            */
+/*    Computer Science Department and                                         */
+/*    Advanced Information Technology Research Center (AITrc)                 */
+/*    Korea Advanced Institute of Science and Technology (KAIST)              */
+/*                                                                            */
+/*    e-mail: kywhang@cs.kaist.ac.kr                                          */
+/*    phone: +82-42-350-7722                                                  */
+/*    fax: +82-42-350-8380                                                    */
+/*                                                                            */
+/*    Copyright (c) 1995-2013 by Kyu-Young Whang                              */
+/*                                                                            */
+/*    All rights reserved. No part of this software may be reproduced,        */
+/*    stored in a retrieval system, or transmitted, in any form or by any     */
+/*    means, electronic, mechanical, photocopying, recording, or otherwise,   */
+/*    without prior written permission of the copyright owner.                */
+/*                                                                            */
+/******************************************************************************/
+/*
+ * Module: EduArtM_Fetch.c
+ *
+ * Description:
+ *  Find the first object satisfying the given condition in an adaptive
+ *  radix tree index. The conditions are those of EduBtM_Fetch(): if the
+ *  start condition is one of SM_BOF, SM_EQ, SM_GT and SM_GE the scan goes
+ *  forward, and if it is one of SM_EOF, SM_LT and SM_LE the scan goes
+ *  backward.
+ *
+ * Exports:
+ *  Four EduArtM_Fetch(ArtIndex*, KeyValue*, Four, KeyValue*, Four, BtreeCursor*)
+ */
+
+
+#include "EduBtM_common.h"
+#include "EduArtM_Internal.h"
+
+
+
+/*@================================
+ * EduArtM_Fetch()
+ *================================*/
+/*
+ * Function: Four EduArtM_Fetch(ArtIndex*, KeyValue*, Four, KeyValue*, Four, BtreeCursor*)
+ *
+ * Description:
+ *  Find the first object satisfying the given condition. See above for detail.
+ *
+ * Returns:
+ *  error code
+ *    eBADPARAMETER_BTM
+ *    eBADCOMPOP_BTM
+ *    some errors caused by function calls
+ *
+ * Side effects:
+ *  cursor  : The found ObjectID and its key, or CURSOR_EOS. The position
+ *            of the cursor is its key, so the cursor stays valid when the
+ *            index is updated.
+ */
+Four EduArtM_Fetch(
+    ArtIndex            *index,         /* IN the index */
+    KeyValue            *startKval,     /* IN key value of start condition */
+    Four                startCompOp,    /* IN comparison operator of start condition */
+    KeyValue            *stopKval,      /* IN key value of stop condition */
+    Four                stopCompOp,     /* IN comparison operator of stop condition */
+    BtreeCursor         *cursor)        /* OUT ART Cursor */
+{
+    Four                e;              /* error number */
+    Two                 nlen;           /* length of the normalized key */
+    unsigned char       nkey[MAXKEYLEN]; /* the normalized start key */
+    ArtLeaf             *leaf;          /* the leaf found */
+
+
+    if (index == NULL || cursor == NULL) ERR(eBADPARAMETER_BTM);
+    if (startCompOp != SM_BOF && startCompOp != SM_EOF && startKval == NULL) ERR(eBADPARAMETER_BTM);
+    if (stopCompOp != SM_BOF && stopCompOp != SM_EOF && stopKval == NULL) ERR(eBADPARAMETER_BTM);
+
+	if (startCompOp != SM_BOF && startCompOp != SM_EOF)
+	{
+		e = eduartm_NormalizeKey(&index->kdesc, startKval, nkey, &nlen);
+		if (e < 0) ERR(e);
+	}
+
+	switch (startCompOp)
+	{
+	  case SM_BOF:
+		leaf = eduartm_Minimum(index->root);
+		break;
+
+	  case SM_EOF:
+		leaf = eduartm_Maximum(index->root);
+		break;
+
+	  case SM_EQ:
+		leaf = eduartm_Search(index->root, nkey, nlen);
+		break;
+
+	  case SM_GE:
+	  case SM_GT:
+		leaf = eduartm_Seek(index->root, nkey, nlen, 0, TRUE, startCompOp == SM_GT);
+		break;
+
+	  case SM_LE:
+	  case SM_LT:
+		leaf = eduartm_Seek(index->root, nkey, nlen, 0, FALSE, startCompOp == SM_LT);
+		break;
+
+	  default:
+		ERR(eBADCOMPOP_BTM);
+	}
+
+	eduartm_SetCursor(index, leaf, stopKval, stopCompOp, cursor);
+
+    return(eNOERROR);
+
+} /* EduArtM_Fetch() */
@@ -0,0 +1,109 @@
+/******************************************************************************/
+/*                                                                            */
+/*    ODYSSEUS/EduCOSMOS Educational-Purpose Object Storage System            */
+/*                                                                            */
+/*    Developed by Professor Kyu-Young Whang et al.                           */
+/*                                                                            */
+/*    Database and Multimedia Laboratory                                      */
+/*                                                                            */
+/*    Computer Science Department and                                         */
+/*    Advanced Information Technology Research Center (AITrc)                 */
+/*    Korea Advanced Institute of Science and Technology (KAIST)              */
+/*                                                                            */
+/*    e-mail: kywhang@cs.kaist.ac.kr                                          */
+/*    phone: +82-42-350-7722                                                  */
+/*    fax: +82-42-350-8380                                                    */
+/*                                                                            */
+/*    Copyright (c) 1995-2013 by Kyu-Young Whang                              */
+/*                                                                            */
+/*    All rights reserved. No part of this software may be reproduced,        */
+/*    stored in a retrieval system, or transmitted, in any form or by any     */
+/*    means, electronic, mechanical, photocopying, recording, or otherwise,   */
+/*    without prior written permission of the copyright owner.                */
+/*                                                                            */
+/******************************************************************************/
+/*
+ * Module: EduArtM_FetchNext.c
+ *
+ * Description:
+ *  Find the next object of the cursor in an adaptive radix tree index.
+ *
+ * Exports:
+ *  Four EduArtM_FetchNext(ArtIndex*, KeyValue*, Four, BtreeCursor*, BtreeCursor*)
+ */
+
+
+#include "EduBtM_common.h"
+#include "EduArtM_Internal.h"
+
+
+
+/*@================================
+ * EduArtM_FetchNext()
+ *================================*/
+/*
+ * Function: Four EduArtM_FetchNext(ArtIndex*, KeyValue*, Four, BtreeCursor*, BtreeCursor*)
+ *
+ * Description:
+ *  Find the next object after the key of the current cursor. The scan goes
+ *  forward if the stop condition is one of SM_EOF, SM_LT and SM_LE, and
+ *  backward if it is one of SM_BOF, SM_GT and SM_GE; there is no next
+ *  object if it is SM_EQ, as the keys are unique.
+ *
+ * Returns:
+ *  error code
+ *    eBADPARAMETER_BTM
+ *    eBADCURSOR
+ *    eBADCOMPOP_BTM
+ *    some errors caused by function calls
+ *
+ * Side effects:
+ *  next : the next object or CURSOR_EOS
+ */
+Four EduArtM_FetchNext(
+    ArtIndex            *index,         /* IN the index */
+    KeyValue            *kval,          /* IN key value of stop condition */
+    Four                compOp,         /* IN comparison operator of stop condition */
+    BtreeCursor         *current,       /* IN current cursor */
+    BtreeCursor         *next)          /* OUT next cursor */
+{
+    Four                e;              /* error number */
+    Two                 nlen;           /* length of the normalized key */
+    unsigned char       nkey[MAXKEYLEN]; /* the normalized current key */
+    ArtLeaf             *leaf;          /* the leaf found */
+
+
+    if (index == NULL || current == NULL || next == NULL) ERR(eBADPARAMETER_BTM);
+    if (compOp != SM_BOF && compOp != SM_EOF && kval == NULL) ERR(eBADPARAMETER_BTM);
+    if (current->flag != CURSOR_ON) ERR(eBADCURSOR);
+
+	e = eduartm_NormalizeKey(&index->kdesc, &current->key, nkey, &nlen);
+	if (e < 0) ERR(e);
+
+	switch (compOp)
+	{
+	  case SM_EQ:
+		leaf = NULL;
+		break;
+
+	  case SM_EOF:
+	  case SM_LT:
+	  case SM_LE:
+		leaf = eduartm_Seek(index->root, nkey, nlen, 0, TRUE, TRUE);
+		break;
+
+	  case SM_BOF:
+	  case SM_GT:
+	  case SM_GE:
+		leaf = eduartm_Seek(index->root, nkey, nlen, 0, FALSE, TRUE);
+		break;
+
+	  default:
+		ERR(eBADCOMPOP_BTM);
+	}
+
+	eduartm_SetCursor(index, leaf, kval, compOp, next);
+
+    return(eNOERROR);
+
+} /* EduArtM_FetchNext() */
@@ -0,0 +1,99 @@
+/******************************************************************************/
+/*                                                                            */
+/*    ODYSSEUS/EduCOSMOS Educational-Purpose Object Storage System            */
+/*                                                                            */
+/*    Developed by Professor Kyu-Young Whang et al.                           */
+/*                                                                            */
+/*    Database and Multimedia Laboratory                                      */
+/*                                                                            */
+/*    Computer Science Department and                                         */
+/*    Advanced Information Technology Research Center (AITrc)                 */
+/*    Korea Advanced Institute of Science and Technology (KAIST)              */
+/*                                                                            */
+/*    e-mail: kywhang@cs.kaist.ac.kr                                          */
+/*    phone: +82-42-350-7722                                                  */
+/*    fax: +82-42-350-8380                                                    */
+/*                                                                            */
+/*    Copyright (c) 1995-2013 by Kyu-Young Whang                              */
+/*                                                                            */
+/*    All rights reserved. No part of this software may be reproduced,        */
+/*    stored in a retrieval system, or transmitted, in any form or by any     */
+/*    means, electronic, mechanical, photocopying, recording, or otherwise,   */
+/*    without prior written permission of the copyright owner.                */
+/*                                                                            */
+/******************************************************************************/
+/*
+ * Module: EduArtM_InsertObject.c
+ *
+ * Description:
+ *  Insert an ObjectID into an adaptive radix tree index.
+ *
+ * Exports:
+ *  Four EduArtM_InsertObject(ArtIndex*, KeyValue*, ObjectID*)
+ */
+
+
+#include <stdlib.h>
+#include <string.h>
+#include "EduBtM_common.h"
+#include "EduArtM_Internal.h"
+
+
+
+/*@================================
+ * EduArtM_InsertObject()
+ *================================*/
+/*
+ * Function: Four EduArtM_InsertObject(ArtIndex*, KeyValue*, ObjectID*)
+ *
+ * Description:
+ *  Insert the pair (key, ObjectID) into the index. The leaf keeps the
+ *  normalized key, by which the tree is searched, and the key value, which
+ *  is returned in the cursors.
+ *
+ * Returns:
+ *  error code
+ *    eBADPARAMETER_BTM
+ *    eDUPLICATEDKEY_BTM
+ *    eMEMORYALLOCERR_BTM
+ *    some errors caused by function calls
+ */
+Four EduArtM_InsertObject(
+    ArtIndex            *index,         /* IN the index */
+    KeyValue            *kval,          /* IN key value */
+    ObjectID            *oid)           /* IN ObjectID to insert */
+{
+    Four                e;              /* error number */
+    Two                 nlen;           /* length of the normalized key */
+    unsigned char       nkey[MAXKEYLEN]; /* the normalized key */
+    ArtLeaf             *leaf;          /* the new leaf */
+
+
+    if (index == NULL || kval == NULL || oid == NULL) ERR(eBADPARAMETER_BTM);
+    if (kval->len < 0 || kval->len > MAXKEYLEN) ERR(eBADPARAMETER_BTM);
+
+	e = eduartm_NormalizeKey(&index->kdesc, kval, nkey, &nlen);
+	if (e < 0) ERR(e);
+
+	leaf = (ArtLeaf*)malloc(ART_LEAF_FIXED + nlen + kval->len);
+	if (leaf == NULL) ERR(eMEMORYALLOCERR_BTM);
+
+	leaf->type = ART_LEAF;
+	leaf->nlen = nlen;
+	leaf->klen = kval->len;
+	leaf->oid = *oid;
+	memcpy(leaf->key, nkey, nlen);
+	memcpy(&leaf->key[nlen], kval->val, kval->len);
+
+	e = eduartm_Insert(&index->root, leaf->key, nlen, 0, leaf);
+	if (e < 0)
+	{
+		free(leaf);
+		ERR(e);
+	}
+
+	index->nEntries++;
+
+    return(eNOERROR);
+
+} /* EduArtM_InsertObject() */
@@ -0,0 +1,182 @@
+/******************************************************************************/
+/*                                                                            */
+/*    ODYSSEUS/EduCOSMOS Educational-Purpose Object Storage System            */
+/*                                                                            */
+/*    Developed by Professor Kyu-Young Whang et al.                           */
+/*                                                                            */
+/*    Database and Multimedia Laboratory                                      */
+/*                                                                            */
+/*    Computer Science Department and                                         */
+/*    Advanced Information Technology Research Center (AITrc)                 */
+/*    Korea Advanced Institute of Science and Technology (KAIST)              */
+/*                                                                            */
+/*    e-mail: kywhang@cs.kaist.ac.kr                                          */
+/*    phone: +82-42-350-7722                                                  */
+/*    fax: +82-42-350-8380                                                    */
+/*                                                                            */
+/*    Copyright (c) 1995-2013 by Kyu-Young Whang                              */
+/*                                                                            */
+/*    All rights reserved. No part of this software may be reproduced,        */
+/*    stored in a retrieval system, or transmitted, in any form or by any     */
+/*    means, electronic, mechanical, photocopying, recording, or otherwise,   */
+/*    without prior written permission of the copyright owner.                */
+/*                                                                            */
+/******************************************************************************/
+/*
+ * Module: EduArtM_Snapshot.c
+ *
+ * Description:
+ *  Save an adaptive radix tree index to a data file and rebuild it. The
+ *  entries are written in the order of the keys as records of a Two key
+ *  length, the key value and the ObjectID, packed into objects of up to
+ *  ART_SNAPSHOTOBJLEN bytes; an object holds only whole records.
+ *
+ * Exports:
+ *  Four EduArtM_Snapshot(ObjectID*, ArtIndex*)
+ *  Four EduArtM_Rebuild(ObjectID*, KeyDesc*, ArtIndex**)
+ */
+
+
+#include <string.h>
+#include "EduBtM_common.h"
+#include "EduArtM.h"
+
+
+
+/*@================================
+ * EduArtM_Snapshot()
+ *================================*/
+/*
+ * Function: Four EduArtM_Snapshot(ObjectID*, ArtIndex*)
+ *
+ * Description:
+ *  Write all the entries of the index into the data file, which should be
+ *  empty. The leaves are visited in the order of the keys, so the file is
+ *  read back by EduArtM_Rebuild() in that order.
+ *
+ * Returns:
+ *  error code
+ *    eBADPARAMETER_BTM
+ *    some errors caused by function calls
+ */
+Four EduArtM_Snapshot(
+    ObjectID            *catObjForFile, /* IN catalog object of the data file */
+    ArtIndex            *index)         /* IN the index */
+{
+    Four                e;              /* error number */
+    Four                len;            /* # of the bytes used in 'buf' */
+    Four                rlen;           /* length of a record */
+    ObjectHdr           objHdr;         /* header of the new object */
+    ObjectID            oid;            /* ObjectID of the new object */
+    ArtLeaf             *leaf;          /* the current leaf */
+    char                buf[ART_SNAPSHOTOBJLEN]; /* the object being filled */
+
+
+    if (catObjForFile == NULL || index == NULL) ERR(eBADPARAMETER_BTM);
+
+	objHdr.properties = 0;
+	objHdr.tag = 0;
+	objHdr.length = 0;
+
+	len = 0;
+	for (leaf = eduartm_Minimum(index->root); leaf != NULL;
+	     leaf = eduartm_Seek(index->root, leaf->key, leaf->nlen, 0, TRUE, TRUE))
+	{
+		rlen = sizeof(Two) + leaf->klen + sizeof(ObjectID);
+		if (len + rlen > ART_SNAPSHOTOBJLEN)
+		{
+			e = OM_CreateObject(catObjForFile, NULL, &objHdr, len, buf, &oid);
+			if (e < 0) ERR(e);
+			len = 0;
+		}
+
+		memcpy(&buf[len], &leaf->klen, sizeof(Two));
+		memcpy(&buf[len+sizeof(Two)], &leaf->key[leaf->nlen], leaf->klen);
+		memcpy(&buf[len+sizeof(Two)+leaf->klen], &leaf->oid, sizeof(ObjectID));
+		len += rlen;
+	}
+
+	if (len > 0)
+	{
+		e = OM_CreateObject(catObjForFile, NULL, &objHdr, len, buf, &oid);
+		if (e < 0) ERR(e);
+	}
+
+    return(eNOERROR);
+
+} /* EduArtM_Snapshot() */
+
+
+
+/*@================================
+ * EduArtM_Rebuild()
+ *================================*/
+/*
+ * Function: Four EduArtM_Rebuild(ObjectID*, KeyDesc*, ArtIndex**)
+ *
+ * Description:
+ *  Create a new index and insert into it all the entries saved in the data
+ *  file by EduArtM_Snapshot().
+ *
+ * Returns:
+ *  error code
+ *    eBADPARAMETER_BTM
+ *    some errors caused by function calls
+ *
+ * Side effects:
+ *  index : the new index
+ */
+Four EduArtM_Rebuild(
+    ObjectID            *catObjForFile, /* IN catalog object of the data file */
+    KeyDesc             *kdesc,         /* IN key descriptor */
+    ArtIndex            **index)        /* OUT the new index */
+{
+    Four                e;              /* error number */
+    Four                len;            /* # of the bytes in 'buf' */
+    Four                i;              /* position in 'buf' */
+    ObjectHdr           objHdr;         /* header of the object */
+    ObjectID            curOid;         /* the current object */
+    ObjectID            nextOid;        /* the next object */
+    ObjectID            oid;            /* ObjectID of an entry */
+    KeyValue            kval;           /* key value of an entry */
+    char                buf[ART_SNAPSHOTOBJLEN]; /* the object read */
+
+
+    if (catObjForFile == NULL || kdesc == NULL || index == NULL) ERR(eBADPARAMETER_BTM);
+
+	e = EduArtM_CreateIndex(kdesc, index);
+	if (e < 0) ERR(e);
+
+	e = OM_NextObject(catObjForFile, NULL, &nextOid, &objHdr);
+	while (e == eNOERROR)
+	{
+		if (objHdr.length > ART_SNAPSHOTOBJLEN) { e = eBADPARAMETER_BTM; break; }
+
+		len = OM_ReadObject(&nextOid, 0, objHdr.length, buf);
+		if (len < 0) { e = len; break; }
+
+		for (i = 0; i < len; i += sizeof(Two) + kval.len + sizeof(ObjectID))
+		{
+			memcpy(&kval.len, &buf[i], sizeof(Two));
+			if (kval.len < 0 || kval.len > MAXKEYLEN) { e = eBADPARAMETER_BTM; break; }
+			memcpy(kval.val, &buf[i+sizeof(Two)], kval.len);
+			memcpy(&oid, &buf[i+sizeof(Two)+kval.len], sizeof(ObjectID));
+
+			e = EduArtM_InsertObject(*index, &kval, &oid);
+			if (e < 0) break;
+		}
+		if (e < 0) break;
+
+		curOid = nextOid;
+		e = OM_NextObject(catObjForFile, &curOid, &nextOid, &objHdr);
+	}
+
+	if (e < 0)
+	{
+		(Four)EduArtM_DropIndex(*index);
+		ERR(e);
+	}
+
+    return(eNOERROR);
+
+} /* EduArtM_Rebuild() */
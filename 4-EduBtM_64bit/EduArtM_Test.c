@@ -0,0 +1,902 @@
+/******************************************************************************/
+/*                                                                            */
+/*    ODYSSEUS/EduCOSMOS Educational-Purpose Object Storage System            */
+/*                                                                            */
+/*    Developed by Professor Kyu-Young Whang et al.                           */
+/*                                                                            */
+/*    Database and Multimedia Laboratory                                      */
+/*                                                                            */
+/*    Computer Science Department and                                         */
+/*    Advanced Information Technology Research Center (AITrc)                 */
+/*    Korea Advanced Institute of Science and Technology (KAIST)              */
+/*                                                                            */
+/*    e-mail: kywhang@cs.kaist.ac.kr                                          */
+/*    phone: +82-42-350-7722                                                  */
+/*    fax: +82-42-350-8380                                                    */
+/*                                                                            */
+/*    Copyright (c) 1995-2013 by Kyu-Young Whang                              */
+/*                                                                            */
+/*    All rights reserved. No part of this software may be reproduced,        */
+/*    stored in a retrieval system, or transmitted, in any form or by any     */
+/*    means, electronic, mechanical, photocopying, recording, or otherwise,   */
+/*    without prior written permission of the copyright owner.                */
+/*                                                                            */
+/******************************************************************************/
+/*
+ * Module: EduArtM_Test.c
+ *
+ * Description :
+ *  Differential test of the adaptive radix tree index against a sorted
+ *  array. The string keys are made of one of ATEST_NUMGROUPS group names
+ *  longer than ART_MAXPREFIXLEN and one of 255 bytes, so the node of a
+ *  group has up to 255 children below a long compressed path. The index
+ *  goes through
+ *   - the insertion of all the keys in random order, in which the nodes
+ *     grow through all the four types,
+ *   - random insertions and deletions, including insertions of keys in the
+ *     index and deletions of keys not in it or with another ObjectID,
+ *   - a snapshot and a rebuild; the rebuilt index replaces the old one,
+ *   - deletions until a group has at most 3 keys, in which the nodes
+ *     shrink and are merged into their children, and
+ *   - another snapshot and rebuild, and the deletion of all the keys.
+ *  Each check compares searches and forward, backward and range scans
+ *  with the array, and walks the tree to check that every node has a
+ *  number of children allowed for its type, that its compressed path is
+ *  the common prefix of the keys below it, and that its children are in
+ *  the order of their key bytes.
+ *
+ *  Usage: EduArtM_Test
+ *
+ *  The exit status is 0 if all the checks pass.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "EduBtM_common.h"
+#include "EduBtM_basictypes.h"
+#include "BfM.h"
+#include "EduArtM.h"
+#include "EduBtM_TestModule.h"
+
+
+#define ATEST_VOLUME        "arttest.vol"
+#define ATEST_NUMPAGES      4000    /* # of pages of the volume */
+#define ATEST_NUMGROUPS     40      /* # of the group names */
+#define ATEST_GROUPSIZE     255     /* # of keys of a group; one for each nonzero byte */
+#define ATEST_NUMKEYS       (ATEST_NUMGROUPS*ATEST_GROUPSIZE)
+#define ATEST_KEYLEN        48      /* maximum length of the string keys */
+#define ATEST_MAXSLOT       100     /* 'slotNo' of the ObjectIDs are in [1, ATEST_MAXSLOT] */
+#define ATEST_ROUNDS        6       /* # of rounds of random updates */
+#define ATEST_UPDATES       5000    /* # of random updates in a round */
+#define ATEST_SEARCHES      500     /* # of random searches in a check */
+#define ATEST_RANGES        50      /* # of random range scans in a check */
+#define ATEST_SHRINKSIZE    3       /* # of keys of a group left by the shrinking */
+#define ATEST_NUMCHECKS     32      /* # of checks while growing and while shrinking */
+
+Four SM_CreateFile(Four, FileID*, Boolean, void*);
+Four sm_GetCatalogEntryFromDataFileId(Four, FileID*, ObjectID*);
+
+Four EduArtM_Test(Four, Four);
+Four atest_Insert(ArtIndex*, Four, Four);
+Four atest_Delete(ArtIndex*, Four, Four);
+Four atest_Rebuild(Four, ArtIndex**, char*);
+Four atest_Check(ArtIndex*, char*);
+Four atest_Search(ArtIndex*, Four);
+Four atest_Seen(char*);
+Four atest_Scan(ArtIndex*, Four, Four, Boolean, Boolean, Boolean);
+void atest_Walk(void*, Four, Four*);
+void atest_MakeKey(Four, KeyValue*);
+int atest_CompareNumber(const void*, const void*);
+
+static char atest_str[ATEST_NUMKEYS][ATEST_KEYLEN]; /* string of each key */
+static Four atest_order[ATEST_NUMKEYS];     /* the keys in the order of the strings */
+static Two  atest_slot[ATEST_NUMKEYS];      /* 'slotNo' of the ObjectID of each key; 0 if not in the index */
+static Four atest_nNodes[ART_NODE256+1];    /* # of the nodes of each type found by the last walk */
+static Four atest_seen[ART_NODE256+1];      /* # of the walks which found a node of each type */
+static Four atest_nErrors;                  /* # of violations found by the current check */
+
+
+
+/*@================================
+ * main()
+ *================================*/
+int main(int argc, char *argv[])
+{
+	Four	e;									/* for errors */
+	Four	handle;								/* system handle */
+	char 	*devNames[1];						/* device name */
+	Four 	volId = 1000;						/* volume identifier */
+	Four 	numPagesInDevices[1];				/* # of pages in the device */
+	XactID 	xactId;								/* transaction identifier */
+
+
+	devNames[0] = ATEST_VOLUME;
+	numPagesInDevices[0] = ATEST_NUMPAGES;
+
+	e = LRDS_Init();
+	if (e < eNOERROR) { printf("LRDS_Init failed!!!\n"); exit(1); }
+
+	e = LRDS_AllocHandle(&handle);
+	if (e < eNOERROR) { printf("LRDS_AllocHandle failed!!!\n"); LRDS_Final(); exit(1); }
+
+	e = LRDS_FormatDataVolume(1, devNames, "arttest", volId, 16, numPagesInDevices, 16);
+	if (e < eNOERROR) { printf("LRDS_FormatDataVolume failed!!!\n"); LRDS_FreeHandle(handle); LRDS_Final(); exit(1); }
+
+	e = LRDS_Mount(1, devNames, &volId);
+	if (e < eNOERROR) { printf("LRDS_Mount failed!!!\n"); LRDS_FreeHandle(handle); LRDS_Final(); exit(1); }
+
+	e = LRDS_BeginTransaction(&xactId, X_RR_RR);
+	if (e < eNOERROR) { LRDS_Dismount(volId); LRDS_FreeHandle(handle); LRDS_Final(); exit(1); }
+
+	e = EduArtM_Test(volId, handle);
+	if (e < eNOERROR) {
+		printf("EduArtM_Test failed!!!\n");
+		LRDS_AbortTransaction(&xactId);
+		LRDS_Dismount(volId);
+		LRDS_FreeHandle(handle);
+		LRDS_Final();
+		exit(1);
+	}
+
+	e = LRDS_CommitTransaction(&xactId);
+	if (e < eNOERROR) printf("LRDS_CommitTransaction failed!!!\n");
+
+	LRDS_Dismount(volId);
+	LRDS_FreeHandle(handle);
+	LRDS_Final();
+
+	return 0;
+}
+
+
+
+/*@================================
+ * EduArtM_Test()
+ *================================*/
+/*
+ * Function: Four EduArtM_Test(Four, Four)
+ *
+ * Description:
+ *  Run the steps of the test described above on an index.
+ *
+ * Returns:
+ *  error code
+ *    eBADBTREEPAGE_BTM if a check fails
+ *    some errors caused by function calls
+ */
+Four EduArtM_Test(
+    Four        volId,                  /* IN volume identifier */
+    Four        handle)                 /* IN system handle */
+{
+    Four        e;                      /* error number */
+    Four        i, j;                   /* indexes */
+    Four        v;                      /* number of a key */
+    Four        nLeft[ATEST_NUMGROUPS]; /* # of keys of each group in the index */
+    Four        perm[ATEST_NUMKEYS];    /* the keys in random order */
+    KeyDesc     kdesc;                  /* key descriptor */
+    ArtIndex    *index;                 /* the index */
+    char        step[64];               /* name of a step */
+
+
+	kdesc.flag = KEYFLAG_UNIQUE;
+	kdesc.nparts = 1;
+	kdesc.kpart[0].type = SM_VARSTRING;
+	kdesc.kpart[0].offset = 0;
+	kdesc.kpart[0].length = ATEST_KEYLEN;
+
+	// Key v is the byte 1 + v % ATEST_GROUPSIZE in the group v / ATEST_GROUPSIZE;
+	// the keys of odd bytes get a tail, so some leaves are deeper than others.
+	for (v = 0; v < ATEST_NUMKEYS; v++)
+	{
+		sprintf(atest_str[v], "group-%02ld/a-shared-path/%c%s", (long)(v / ATEST_GROUPSIZE),
+		        (char)(1 + v % ATEST_GROUPSIZE), (v % 2 == 0) ? "/tail" : "");
+		atest_order[v] = v;
+	}
+	qsort(atest_order, ATEST_NUMKEYS, sizeof(Four), atest_CompareNumber);
+
+	srand(31);
+	for (v = 0; v < ATEST_NUMKEYS; v++) perm[v] = v;
+	for (v = ATEST_NUMKEYS - 1; v > 0; v--)
+	{
+		j = rand() % (v + 1);
+		i = perm[v]; perm[v] = perm[j]; perm[j] = i;
+	}
+
+	e = EduArtM_CreateIndex(&kdesc, &index);
+	if (e < eNOERROR) ERR(e);
+
+	memset(atest_slot, 0, sizeof(atest_slot));
+	memset(atest_seen, 0, sizeof(atest_seen));
+
+	/* Grow the nodes. */
+	for (v = 0; v < ATEST_NUMKEYS; v++)
+	{
+		e = atest_Insert(index, perm[v], rand() % ATEST_MAXSLOT + 1);
+		if (e < eNOERROR) ERR(e);
+
+		if ((v + 1) % (ATEST_NUMKEYS / ATEST_NUMCHECKS) == 0)
+		{
+			sprintf(step, "grow %ld", (long)(v + 1));
+			e = atest_Check(index, step);
+			if (e < eNOERROR) ERR(e);
+		}
+	}
+
+	e = atest_Seen("grow");
+	if (e < eNOERROR) ERR(e);
+
+	/* Random updates */
+	for (i = 0; i < ATEST_ROUNDS; i++)
+	{
+		for (j = 0; j < ATEST_UPDATES; j++)
+		{
+			v = rand() % ATEST_NUMKEYS;
+			if (rand() % 2 == 0)
+				e = atest_Insert(index, v, rand() % ATEST_MAXSLOT + 1);
+			else if (atest_slot[v] != 0 && rand() % 4 != 0)
+				e = atest_Delete(index, v, atest_slot[v]);
+			else
+				e = atest_Delete(index, v, atest_slot[v] % ATEST_MAXSLOT + 1);
+			if (e < eNOERROR) ERR(e);
+		}
+
+		sprintf(step, "update round %ld", (long)i);
+		e = atest_Check(index, step);
+		if (e < eNOERROR) ERR(e);
+	}
+
+	e = atest_Rebuild(volId, &index, "rebuild");
+	if (e < eNOERROR) ERR(e);
+
+	/* Shrink the nodes. */
+	memset(nLeft, 0, sizeof(nLeft));
+	for (v = 0; v < ATEST_NUMKEYS; v++)
+		if (atest_slot[v] != 0) nLeft[v / ATEST_GROUPSIZE]++;
+
+	memset(atest_seen, 0, sizeof(atest_seen));
+	for (v = 0; v < ATEST_NUMKEYS; v++)
+	{
+		if (atest_slot[perm[v]] != 0 && nLeft[perm[v] / ATEST_GROUPSIZE] > ATEST_SHRINKSIZE)
+		{
+			e = atest_Delete(index, perm[v], atest_slot[perm[v]]);
+			if (e < eNOERROR) ERR(e);
+			nLeft[perm[v] / ATEST_GROUPSIZE]--;
+		}
+
+		if ((v + 1) % (ATEST_NUMKEYS / ATEST_NUMCHECKS) == 0)
+		{
+			sprintf(step, "shrink %ld", (long)(v + 1));
+			e = atest_Check(index, step);
+			if (e < eNOERROR) ERR(e);
+		}
+	}
+
+	e = atest_Seen("shrink");
+	if (e < eNOERROR) ERR(e);
+
+	e = atest_Rebuild(volId, &index, "rebuild of the shrunk");
+	if (e < eNOERROR) ERR(e);
+
+	for (v = 0; v < ATEST_NUMKEYS; v++)
+	{
+		if (atest_slot[v] == 0) continue;
+
+		e = atest_Delete(index, v, atest_slot[v]);
+		if (e < eNOERROR) ERR(e);
+	}
+
+	e = atest_Check(index, "empty");
+	if (e < eNOERROR) ERR(e);
+
+	if (index->root != NULL || index->nEntries != 0)
+	{
+		printf("  the empty index has %ld entries\n", (long)index->nEntries);
+		ERR(eBADBTREEPAGE_BTM);
+	}
+
+	e = EduArtM_DropIndex(index);
+	if (e < eNOERROR) ERR(e);
+
+	printf("all checks passed\n");
+
+	return(eNOERROR);
+
+} /* EduArtM_Test() */
+
+
+
+/*@================================
+ * atest_Insert()
+ *================================*/
+/*
+ * Function: Four atest_Insert(ArtIndex*, Four, Four)
+ *
+ * Description:
+ *  Insert the given key with the ObjectID of the given 'slotNo' and update
+ *  the array. An insertion of a key in the array should return
+ *  eDUPLICATEDKEY_BTM.
+ *
+ * Returns:
+ *  error code
+ *    eBADBTREEPAGE_BTM if the result does not match the array
+ *    some errors caused by function calls
+ */
+Four atest_Insert(
+    ArtIndex        *index,             /* IN the index */
+    Four            v,                  /* IN number of the key */
+    Four            slot)               /* IN 'slotNo' of the ObjectID */
+{
+    Four            e;                  /* error number */
+    KeyValue        kval;               /* key value */
+    ObjectID        oid;                /* ObjectID of the key */
+
+
+	atest_MakeKey(v, &kval);
+	oid.volNo = 1; oid.pageNo = v; oid.slotNo = slot; oid.unique = 0;
+
+	e = EduArtM_InsertObject(index, &kval, &oid);
+	if (e == eDUPLICATEDKEY_BTM)
+	{
+		if (atest_slot[v] != 0) return(eNOERROR);
+
+		printf("  the insertion of the key %ld not in the index returns eDUPLICATEDKEY_BTM\n", (long)v);
+		ERR(eBADBTREEPAGE_BTM);
+	}
+	if (e < eNOERROR) ERR(e);
+
+	if (atest_slot[v] != 0)
+	{
+		printf("  the insertion of the duplicated key %ld succeeds\n", (long)v);
+		ERR(eBADBTREEPAGE_BTM);
+	}
+
+	atest_slot[v] = slot;
+
+	return(eNOERROR);
+
+} /* atest_Insert() */
+
+
+
+/*@================================
+ * atest_Delete()
+ *================================*/
+/*
+ * Function: Four atest_Delete(ArtIndex*, Four, Four)
+ *
+ * Description:
+ *  Delete the given key with the ObjectID of the given 'slotNo' and update
+ *  the array. A deletion of a pair not in the array should return
+ *  eNOTFOUND_BTM.
+ *
+ * Returns:
+ *  error code
+ *    eBADBTREEPAGE_BTM if the result does not match the array
+ *    some errors caused by function calls
+ */
+Four atest_Delete(
+    ArtIndex        *index,             /* IN the index */
+    Four            v,                  /* IN number of the key */
+    Four            slot)               /* IN 'slotNo' of the ObjectID */
+{
+    Four            e;                  /* error number */
+    KeyValue        kval;               /* key value */
+    ObjectID        oid;                /* ObjectID of the key */
+
+
+	atest_MakeKey(v, &kval);
+	oid.volNo = 1; oid.pageNo = v; oid.slotNo = slot; oid.unique = 0;
+
+	e = EduArtM_DeleteObject(index, &kval, &oid);
+	if (e == eNOTFOUND_BTM)
+	{
+		if (atest_slot[v] != slot) return(eNOERROR);
+
+		printf("  the deletion of the key %ld in the index returns eNOTFOUND_BTM\n", (long)v);
+		ERR(eBADBTREEPAGE_BTM);
+	}
+	if (e < eNOERROR) ERR(e);
+
+	if (atest_slot[v] != slot)
+	{
+		printf("  the deletion of the key %ld with the slot %ld succeeds\n", (long)v, (long)slot);
+		ERR(eBADBTREEPAGE_BTM);
+	}
+
+	atest_slot[v] = 0;
+
+	return(eNOERROR);
+
+} /* atest_Delete() */
+
+
+
+/*@================================
+ * atest_Rebuild()
+ *================================*/
+/*
+ * Function: Four atest_Rebuild(Four, ArtIndex**, char*)
+ *
+ * Description:
+ *  Save the index into a new data file, rebuild it from the file and check
+ *  the rebuilt index. The rebuilt index replaces the old one, which is
+ *  dropped.
+ *
+ * Returns:
+ *  error code
+ *    eBADBTREEPAGE_BTM if the check fails
+ *    some errors caused by function calls
+ */
+Four atest_Rebuild(
+    Four            volId,              /* IN volume identifier */
+    ArtIndex        **index,            /* INOUT the index */
+    char            *name)              /* IN name of the step */
+{
+    Four            e;                  /* error number */
+    FileID          fid;                /* the data file of the snapshot */
+    ObjectID        catalogEntry;       /* catalog object of the data file */
+    ArtIndex        *rebuilt;           /* the rebuilt index */
+
+
+	e = SM_CreateFile(volId, &fid, FALSE, NULL);
+	if (e < eNOERROR) ERR(e);
+
+	e = sm_GetCatalogEntryFromDataFileId(ARRAYINDEX, &fid, &catalogEntry);
+	if (e < eNOERROR) ERR(e);
+
+	e = EduArtM_Snapshot(&catalogEntry, *index);
+	if (e < eNOERROR) ERR(e);
+
+	e = EduArtM_Rebuild(&catalogEntry, &(*index)->kdesc, &rebuilt);
+	if (e < eNOERROR) ERR(e);
+
+	e = EduArtM_DropIndex(*index);
+	if (e < eNOERROR) ERR(e);
+
+	*index = rebuilt;
+
+	e = atest_Check(*index, name);
+	if (e < eNOERROR) ERR(e);
+
+	return(eNOERROR);
+
+} /* atest_Rebuild() */
+
+
+
+/*@================================
+ * atest_Check()
+ *================================*/
+/*
+ * Function: Four atest_Check(ArtIndex*, char*)
+ *
+ * Description:
+ *  Check the index against the array by random searches, full scans in
+ *  both directions, random range scans and a walk of the tree. The
+ *  violations are printed.
+ *
+ * Returns:
+ *  error code
+ *    eBADBTREEPAGE_BTM if the check fails
+ *    some errors caused by function calls
+ */
+Four atest_Check(
+    ArtIndex        *index,             /* IN the index */
+    char            *name)              /* IN name of the step */
+{
+    Four            e;                  /* error number */
+    Four            i;                  /* index */
+    Four            lo, hi;             /* ranks of the bounds of a range */
+    Four            nAlive;             /* # of keys of the array */
+    Four            nLeaves;            /* # of leaves found by the walk */
+
+
+	atest_nErrors = 0;
+
+	for (i = 0; i < ATEST_SEARCHES; i++)
+	{
+		e = atest_Search(index, rand() % ATEST_NUMKEYS);
+		if (e < eNOERROR) ERR(e);
+	}
+
+	e = atest_Scan(index, -1, ATEST_NUMKEYS, FALSE, FALSE, TRUE);
+	if (e < eNOERROR) ERR(e);
+
+	e = atest_Scan(index, -1, ATEST_NUMKEYS, FALSE, FALSE, FALSE);
+	if (e < eNOERROR) ERR(e);
+
+	for (i = 0; i < ATEST_RANGES; i++)
+	{
+		lo = rand() % ATEST_NUMKEYS;
+		hi = lo + rand() % (ATEST_NUMKEYS / 10);
+		if (hi >= ATEST_NUMKEYS) hi = ATEST_NUMKEYS - 1;
+
+		e = atest_Scan(index, lo, hi, rand() % 2, rand() % 2, rand() % 2);
+		if (e < eNOERROR) ERR(e);
+	}
+
+	nAlive = 0;
+	for (i = 0; i < ATEST_NUMKEYS; i++)
+		if (atest_slot[i] != 0) nAlive++;
+
+	memset(atest_nNodes, 0, sizeof(atest_nNodes));
+	nLeaves = 0;
+	atest_Walk(index->root, 0, &nLeaves);
+
+	for (i = ART_NODE4; i <= ART_NODE256; i++)
+		if (atest_nNodes[i] > 0) atest_seen[i]++;
+
+	if (nLeaves != nAlive || index->nEntries != nAlive)
+	{
+		printf("  the tree has %ld leaves and %ld entries instead of %ld\n",
+		       (long)nLeaves, (long)index->nEntries, (long)nAlive);
+		atest_nErrors++;
+	}
+
+	printf("%-24s %6ld keys %4ld/%4ld/%3ld/%3ld nodes %s\n", name, (long)nAlive,
+	       (long)atest_nNodes[ART_NODE4], (long)atest_nNodes[ART_NODE16],
+	       (long)atest_nNodes[ART_NODE48], (long)atest_nNodes[ART_NODE256],
+	       (atest_nErrors == 0) ? "ok" : "FAILED");
+
+	if (atest_nErrors > 0) ERR(eBADBTREEPAGE_BTM);
+
+	return(eNOERROR);
+
+} /* atest_Check() */
+
+
+
+/*@================================
+ * atest_Search()
+ *================================*/
+/*
+ * Function: Four atest_Search(ArtIndex*, Four)
+ *
+ * Description:
+ *  Search for the given key and compare the result with the array. The
+ *  violations are printed and counted.
+ *
+ * Returns:
+ *  error code
+ *    some errors caused by function calls
+ */
+Four atest_Search(
+    ArtIndex        *index,             /* IN the index */
+    Four            v)                  /* IN number of the key */
+{
+    Four            e;                  /* error number */
+    KeyValue        kval;               /* key value */
+    BtreeCursor     cursor;             /* cursor of the search */
+
+
+	atest_MakeKey(v, &kval);
+
+	e = EduArtM_Fetch(index, &kval, SM_EQ, &kval, SM_EQ, &cursor);
+	if (e < eNOERROR) ERR(e);
+
+	if (cursor.flag != CURSOR_ON && atest_slot[v] != 0)
+	{
+		printf("  the search misses the key %ld\n", (long)v);
+		atest_nErrors++;
+	}
+	else if (cursor.flag == CURSOR_ON && (cursor.oid.pageNo != v || cursor.oid.slotNo != atest_slot[v]))
+	{
+		printf("  the search for the key %ld returns the ObjectID (%ld, %ld) instead of (%ld, %ld)\n",
+		       (long)v, (long)cursor.oid.pageNo, (long)cursor.oid.slotNo, (long)v, (long)atest_slot[v]);
+		atest_nErrors++;
+	}
+
+	return(eNOERROR);
+
+} /* atest_Search() */
+
+
+
+/*@================================
+ * atest_Seen()
+ *================================*/
+/*
+ * Function: Four atest_Seen(char*)
+ *
+ * Description:
+ *  Check that the walks of the step found nodes of all the four types.
+ *
+ * Returns:
+ *  error code
+ *    eBADBTREEPAGE_BTM if the check fails
+ */
+Four atest_Seen(
+    char            *name)              /* IN name of the step */
+{
+    Four            i;                  /* type of a node */
+
+
+	for (i = ART_NODE4; i <= ART_NODE256; i++)
+		if (atest_seen[i] == 0)
+		{
+			printf("  no node of type %ld is found while the nodes %s\n", (long)i, name);
+			ERR(eBADBTREEPAGE_BTM);
+		}
+
+	return(eNOERROR);
+
+} /* atest_Seen() */
+
+
+
+/*@================================
+ * atest_Scan()
+ *================================*/
+/*
+ * Function: Four atest_Scan(ArtIndex*, Four, Four, Boolean, Boolean, Boolean)
+ *
+ * Description:
+ *  Scan the keys between the keys of the ranks 'lo' and 'hi' in the order
+ *  of the strings, excluding the bounds which are strict, and compare the
+ *  keys returned with the array. A 'lo' of -1 is the beginning and a 'hi'
+ *  of ATEST_NUMKEYS is the end of the index. The bounds need not be in
+ *  the index. The violations are printed and counted.
+ *
+ * Returns:
+ *  error code
+ *    some errors caused by function calls
+ */
+Four atest_Scan(
+    ArtIndex        *index,             /* IN the index */
+    Four            lo,                 /* IN rank of the lower bound */
+    Four            hi,                 /* IN rank of the upper bound */
+    Boolean         strictLo,           /* IN TRUE if the lower bound is excluded */
+    Boolean         strictHi,           /* IN TRUE if the upper bound is excluded */
+    Boolean         forward)            /* IN TRUE if the scan goes forward */
+{
+    Four            e;                  /* error number */
+    Four            r;                  /* rank of the expected key */
+    Four            first, last;        /* ranks of the first and the last keys in the range */
+    Four            loOp, hiOp;         /* comparison operators of the bounds */
+    Four            v;                  /* number of a key */
+    KeyValue        loKval, hiKval;     /* key values of the bounds */
+    KeyValue        kval;               /* key value of the expected key */
+    BtreeCursor     cursor;             /* cursor of the scan */
+    BtreeCursor     next;               /* the next cursor of the scan */
+
+
+	first = (lo < 0) ? 0 : (strictLo ? lo + 1 : lo);
+	last = (hi >= ATEST_NUMKEYS) ? ATEST_NUMKEYS - 1 : (strictHi ? hi - 1 : hi);
+
+	if (lo >= 0) atest_MakeKey(atest_order[lo], &loKval);
+	if (hi < ATEST_NUMKEYS) atest_MakeKey(atest_order[hi], &hiKval);
+
+	// The operators of a bound are the same for the start and the stop conditions.
+	loOp = (lo < 0) ? SM_BOF : (strictLo ? SM_GT : SM_GE);
+	hiOp = (hi >= ATEST_NUMKEYS) ? SM_EOF : (strictHi ? SM_LT : SM_LE);
+
+	if (forward)
+		e = EduArtM_Fetch(index, &loKval, loOp, &hiKval, hiOp, &cursor);
+	else
+		e = EduArtM_Fetch(index, &hiKval, hiOp, &loKval, loOp, &cursor);
+	if (e < eNOERROR) ERR(e);
+
+	r = forward ? first : last;
+
+	for (;;)
+	{
+		// Skip the keys of the array which are not in the index.
+		while (r >= first && r <= last && atest_slot[atest_order[r]] == 0)
+			r += forward ? 1 : -1;
+
+		if (cursor.flag != CURSOR_ON) break;
+
+		if (r < first || r > last)
+		{
+			printf("  the scan of [%ld, %ld] %s returns a key after the range\n",
+			       (long)lo, (long)hi, forward ? "forward" : "backward");
+			atest_nErrors++;
+			return(eNOERROR);
+		}
+
+		v = atest_order[r];
+		atest_MakeKey(v, &kval);
+		if (cursor.key.len != kval.len || memcmp(cursor.key.val, kval.val, kval.len) != 0 ||
+		    cursor.oid.pageNo != v || cursor.oid.slotNo != atest_slot[v])
+		{
+			printf("  the scan of [%ld, %ld] %s returns the ObjectID (%ld, %ld) instead of (%ld, %ld)\n",
+			       (long)lo, (long)hi, forward ? "forward" : "backward",
+			       (long)cursor.oid.pageNo, (long)cursor.oid.slotNo, (long)v, (long)atest_slot[v]);
+			atest_nErrors++;
+			return(eNOERROR);
+		}
+		r += forward ? 1 : -1;
+
+		if (forward)
+			e = EduArtM_FetchNext(index, &hiKval, hiOp, &cursor, &next);
+		else
+			e = EduArtM_FetchNext(index, &loKval, loOp, &cursor, &next);
+		if (e < eNOERROR) ERR(e);
+		cursor = next;
+	}
+
+	if (r >= first && r <= last)
+	{
+		printf("  the scan of [%ld, %ld] %s misses the key %ld\n",
+		       (long)lo, (long)hi, forward ? "forward" : "backward", (long)atest_order[r]);
+		atest_nErrors++;
+	}
+
+	return(eNOERROR);
+
+} /* atest_Scan() */
+
+
+
+/*@================================
+ * atest_Walk()
+ *================================*/
+/*
+ * Function: void atest_Walk(void*, Four, Four*)
+ *
+ * Description:
+ *  Walk the tree below the node 'p', whose key bytes start at 'depth',
+ *  count its nodes by type and its leaves, and check the nodes. The
+ *  violations are printed and counted.
+ *
+ * Returns:
+ *  None
+ */
+void atest_Walk(
+    void            *p,                 /* IN a node or a leaf */
+    Four            depth,              /* IN # of the key bytes above the node */
+    Four            *nLeaves)           /* INOUT # of the leaves */
+{
+    Four            i;                  /* index */
+    Four            n;                  /* # of children found */
+    Four            c;                  /* key byte of a child */
+    Four            minChildren;        /* the least # of children of the type */
+    Four            maxChildren;        /* the most # of children of the type */
+    void            *child;             /* a child */
+    ArtNode         *node;              /* 'p' as an inner node */
+    ArtLeaf         *minLeaf, *maxLeaf; /* leaves of the smallest and the largest keys below */
+    static Four     bounds[ART_NODE256+1][2] = { {0, 0}, {2, 4}, {4, 16}, {13, 48}, {38, 256} };
+
+
+	if (p == NULL) return;
+
+	if (ART_TYPE(p) == ART_LEAF)
+	{
+		(*nLeaves)++;
+		return;
+	}
+
+	node = (ArtNode*)p;
+	if (node->type < ART_NODE4 || node->type > ART_NODE256)
+	{
+		printf("  a node of type %ld is found\n", (long)node->type);
+		atest_nErrors++;
+		return;
+	}
+	atest_nNodes[node->type]++;
+
+	minChildren = bounds[node->type][0];
+	maxChildren = bounds[node->type][1];
+	if (node->nChildren < minChildren || node->nChildren > maxChildren)
+	{
+		printf("  a node of type %ld has %ld children\n", (long)node->type, (long)node->nChildren);
+		atest_nErrors++;
+	}
+
+	// The compressed path should be the common prefix of the keys below.
+	minLeaf = eduartm_Minimum(p);
+	maxLeaf = eduartm_Maximum(p);
+	if (depth + node->prefixLen >= minLeaf->nlen || depth + node->prefixLen >= maxLeaf->nlen ||
+	    memcmp(&minLeaf->key[depth], &maxLeaf->key[depth], node->prefixLen) != 0 ||
+	    memcmp(node->prefix, &minLeaf->key[depth],
+	           (node->prefixLen < ART_MAXPREFIXLEN) ? node->prefixLen : ART_MAXPREFIXLEN) != 0)
+	{
+		printf("  a node of type %ld at the depth %ld has a wrong compressed path of %ld bytes\n",
+		       (long)node->type, (long)depth, (long)node->prefixLen);
+		atest_nErrors++;
+		return;
+	}
+	depth += node->prefixLen;
+
+	n = 0;
+	for (c = 0; c < 256; c++)
+	{
+		switch (node->type)
+		{
+		  case ART_NODE4:
+			child = (n < node->nChildren) ? ((ArtNode4*)node)->children[n] : NULL;
+			if (child != NULL && ((ArtNode4*)node)->keys[n] != c) child = NULL;
+			break;
+
+		  case ART_NODE16:
+			child = (n < node->nChildren) ? ((ArtNode16*)node)->children[n] : NULL;
+			if (child != NULL && ((ArtNode16*)node)->keys[n] != c) child = NULL;
+			break;
+
+		  case ART_NODE48:
+			i = ((ArtNode48*)node)->index[c];
+			child = (i == 0) ? NULL : ((ArtNode48*)node)->children[i-1];
+			if (i != 0 && child == NULL)
+			{
+				printf("  a node of type %ld has no child at the index of the byte %ld\n", (long)node->type, (long)c);
+				atest_nErrors++;
+			}
+			break;
+
+		  default:
+			child = ((ArtNode256*)node)->children[c];
+			break;
+		}
+		if (child == NULL) continue;
+
+		minLeaf = eduartm_Minimum(child);
+		if (minLeaf->key[depth] != c || eduartm_Maximum(child)->key[depth] != c)
+		{
+			printf("  the child of the byte %ld of a node of type %ld has other keys\n", (long)c, (long)node->type);
+			atest_nErrors++;
+		}
+
+		n++;
+		atest_Walk(child, depth + 1, nLeaves);
+	}
+
+	// The sorted types should have found all their children in the order of the bytes.
+	if (n != node->nChildren)
+	{
+		printf("  a node of type %ld with %ld children has %ld children in order\n",
+		       (long)node->type, (long)node->nChildren, (long)n);
+		atest_nErrors++;
+	}
+
+} /* atest_Walk() */
+
+
+
+/*@================================
+ * atest_MakeKey()
+ *================================*/
+/*
+ * Function: void atest_MakeKey(Four, KeyValue*)
+ *
+ * Description:
+ *  Make the string key value of the given number.
+ *
+ * Returns:
+ *  None
+ */
+void atest_MakeKey(
+    Four            v,                  /* IN number of the key */
+    KeyValue        *kval)              /* OUT key value */
+{
+    Two             len;                /* length of the string with its terminating 0 */
+
+
+	len = strlen(atest_str[v]) + 1;
+	memcpy(kval->val, &len, sizeof(Two));
+	memcpy(&kval->val[sizeof(Two)], atest_str[v], len);
+	kval->len = sizeof(Two) + len;
+
+} /* atest_MakeKey() */
+
+
+
+/*@================================
+ * atest_CompareNumber()
+ *================================*/
+/*
+ * Function: int atest_CompareNumber(const void*, const void*)
+ *
+ * Description:
+ *  Compare the strings of two key numbers for qsort(). strcmp() compares
+ *  the bytes as unsigned, as the normalized keys are compared.
+ *
+ * Returns:
+ *  negative, 0 or positive as for strcmp()
+ */
+int atest_CompareNumber(
+    const void      *a,                 /* IN the first key number */
+    const void      *b)                 /* IN the second key number */
+{
+	return(strcmp(atest_str[*(Four*)a], atest_str[*(Four*)b]));
+
+} /* atest_CompareNumber() */
@@ -0,0 +1,1313 @@
+/******************************************************************************/
+/*                                                                            */
+/*    ODYSSEUS/EduCOSMOS Educational-Purpose Object Storage System            */
+/*                                                                            */
+/*    Developed by Professor Kyu-Young Whang et al.                           */
+/*                                                                            */
+/*    Database and Multimedia Laboratory                                      */
+/*                                                                            */
+/*    Computer Science Department and                                         */
+/*    Advanced Information Technology Research Center (AITrc)                 */
+/*    Korea Advanced Institute of Science and Technology (KAIST)              */
+/*                                                                            */
+/*    e-mail: kywhang@cs.kaist.ac.kr                                          */
+/*    phone: +82-42-350-7722                                                  */
+/*    fax: +82-42-350-8380                                                    */
+/*                                                                            */
+/*    Copyright (c) 1995-2013 by Kyu-Young Whang                              */
+/*                                                                            */
+/*    All rights reserved. No part of this software may be reproduced,        */
+/*    stored in a retrieval system, or transmitted, in any form or by any     */
+/*    means, electronic, mechanical, photocopying, recording, or otherwise,   */
+/*    without prior written permission of the copyright owner.                */
+/*                                                                            */
+/******************************************************************************/
+/*
+ * Module: EduBtM_Bench.c
+ *
+ * Description :
+ *  Microbenchmarks of EduBtM. The latency of the split of a full leaf page
+ *  and a full internal page and of the deletion from a leaf page is
+ *  measured directly on the page routines, for the integer keys and the
+ *  variable length string keys. Every run starts from the same full page
+ *  and inserts the item at a random position.
+ *  The search in a page is measured for the binary search and the
+ *  interpolation search of the integer keys, on the uniform keys and on
+ *  the skewed keys, as the keys read and the time per lookup.
+ *  The delete policies are compared under churn by the splits, merges and
+ *  redistributions, which give the page writes per update, and by the
+ *  fill of the leaves left behind.
+ *  The suite builds indexes of the integer keys, the multi-part keys and
+ *  the string keys in the sequential, the random and the Zipfian order,
+ *  and runs point lookups, range scans and churn on them; it reports the
+ *  operations per second, the pages fixed per operation, the height and
+ *  the fill of the leaves as CSV rows.
+ *
+ *  Usage: EduBtM_Bench [# of runs] [# of keys of the suite]
+ *
+ * Exports:
+ *  Four EduBtM_Bench(Four, Four)
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include "EduBtM_common.h"
+#include "EduBtM_basictypes.h"
+#include "EduBtM.h"
+#include "EduBtM_Internal.h"
+#include "EduBtM_TestModule.h"
+
+
+#define BENCH_VOLUME        "bench.vol"
+#define BENCH_NUMPAGES      20000   /* # of pages of the volume; a split allocates a page */
+#define BENCH_DEFAULTRUNS   1000    /* default # of runs of each benchmark */
+#define BENCH_STRINGKEYLEN  40      /* length of the string keys */
+#define BENCH_SEARCHBATCH   1000    /* # of lookups timed together */
+#define BENCH_CHURNKEYS     10000   /* # of keys of the churn benchmark */
+#define BENCH_CHURNCYCLES   4       /* # of times the index shrinks to the half and grows back */
+#define BENCH_CHURNDOMAIN   4       /* the keys are drawn from BENCH_CHURNDOMAIN times as many */
+#define BENCH_CHURNREORGSTEP 64     /* # of leaves of a step of the deferred repair */
+#define BENCH_DEFAULTKEYS   100000  /* default # of keys of the indexes of the suite */
+#define BENCH_KEYSPERPAGE   4       /* the volume has a page for this many keys of the suite */
+#define BENCH_SUITELOOKUPS  100000  /* maximum # of point lookups of the suite */
+#define BENCH_SUITESCANS    100     /* maximum # of range scans of each selectivity */
+#define BENCH_SUITESCANROWS 1000000 /* maximum # of keys read by the scans of each selectivity */
+#define BENCH_SUITECHURN    100000  /* maximum # of deletions (and insertions) of the churn */
+#define BENCH_NSELECTIVITIES 5      /* # of selectivities of the range scans */
+#define BENCH_ZIPFCLUSTER   64      /* # of consecutive keys of a cluster of the Zipfian order */
+#define BENCH_ZIPFTHETA     0.99    /* skew of the Zipfian order */
+
+/* insertion orders of the suite */
+#define BENCH_SEQUENTIAL    0
+#define BENCH_RANDOM        1
+#define BENCH_ZIPFIAN       2
+
+#define BENCH_MAKEOID(oid, v, p, s, u) \
+BEGIN_MACRO \
+    (oid).volNo = (v); (oid).pageNo = (p); (oid).slotNo = (s); (oid).unique = (u); \
+END_MACRO
+
+Four SM_CreateFile(Four, FileID*, Boolean, void*);
+Four sm_GetCatalogEntryFromDataFileId(Four, FileID*, ObjectID*);
+
+Four EduBtM_Bench(Four, Four);
+Four bench_SplitLeaf(ObjectID*, KeyDesc*, Four);
+Four bench_SplitInternal(ObjectID*, KeyDesc*, Four);
+Four bench_DeleteLeaf(ObjectID*, KeyDesc*, Four);
+Four bench_Search(ObjectID*, KeyDesc*, Four);
+Four bench_Churn(ObjectID*, KeyDesc*, Four);
+Four bench_Suite(ObjectID*, KeyDesc*, Four);
+Four bench_Order(Four, Four, Four*);
+void bench_SuiteRow(KeyDesc*, char*, Four, char*, double, Four, double, BtreeStats*);
+void bench_SkewKeys(char*, Two*, Two, Two);
+Four bench_AllocPage(ObjectID*, Boolean, PageID*);
+Two bench_FillLeaf(BtreeLeaf*, KeyDesc*);
+Two bench_FillInternal(BtreeInternal*, KeyDesc*);
+void bench_MakeKey(KeyDesc*, Four, KeyValue*);
+char *bench_KeyName(KeyDesc*);
+double bench_Now(void);
+void bench_Report(char*, KeyDesc*, double*, Four);
+int bench_Compare(const void*, const void*);
+
+static BtreePage bench_template;    /* the full page every run starts from */
+static Four bench_runs = BENCH_DEFAULTRUNS;
+static Four bench_keys = BENCH_DEFAULTKEYS;
+
+
+
+/*@================================
+ * main()
+ *================================*/
+int main(int argc, char *argv[])
+{
+	Four	e;									/* for errors */
+	Four	handle;								/* system handle */
+	char 	*devNames[1];						/* device name */
+	Four 	volId = 1000;						/* volume identifier */
+	Four 	numPagesInDevices[1];				/* # of pages in the device */
+	XactID 	xactId;								/* transaction identifier */
+
+
+	if (argc > 1) bench_runs = atoi(argv[1]);
+	if (bench_runs <= 0) bench_runs = BENCH_DEFAULTRUNS;
+	if (argc > 2) bench_keys = atoi(argv[2]);
+	if (bench_keys <= 0) bench_keys = BENCH_DEFAULTKEYS;
+
+	devNames[0] = BENCH_VOLUME;
+	numPagesInDevices[0] = BENCH_NUMPAGES + bench_keys / BENCH_KEYSPERPAGE;
+
+	e = LRDS_Init();
+	if (e < eNOERROR) { printf("LRDS_Init failed!!!\n"); exit(1); }
+
+	e = LRDS_AllocHandle(&handle);
+	if (e < eNOERROR) { printf("LRDS_AllocHandle failed!!!\n"); LRDS_Final(); exit(1); }
+
+	e = LRDS_FormatDataVolume(1, devNames, "bench", volId, 16, numPagesInDevices, 16);
+	if (e < eNOERROR) { printf("LRDS_FormatDataVolume failed!!!\n"); LRDS_FreeHandle(handle); LRDS_Final(); exit(1); }
+
+	e = LRDS_Mount(1, devNames, &volId);
+	if (e < eNOERROR) { printf("LRDS_Mount failed!!!\n"); LRDS_FreeHandle(handle); LRDS_Final(); exit(1); }
+
+	e = LRDS_BeginTransaction(&xactId, X_RR_RR);
+	if (e < eNOERROR) { LRDS_Dismount(volId); LRDS_FreeHandle(handle); LRDS_Final(); exit(1); }
+
+	e = EduBtM_Bench(volId, handle);
+	if (e < eNOERROR) {
+		printf("EduBtM_Bench failed!!!\n");
+		LRDS_AbortTransaction(&xactId);
+		LRDS_Dismount(volId);
+		LRDS_FreeHandle(handle);
+		LRDS_Final();
+		exit(1);
+	}
+
+	e = LRDS_CommitTransaction(&xactId);
+	if (e < eNOERROR) printf("LRDS_CommitTransaction failed!!!\n");
+
+	LRDS_Dismount(volId);
+	LRDS_FreeHandle(handle);
+	LRDS_Final();
+
+	return 0;
+}
+
+
+
+/*@================================
+ * EduBtM_Bench()
+ *================================*/
+/*
+ * Function: Four EduBtM_Bench(Four, Four)
+ *
+ * Description:
+ *  Run the benchmarks for the integer keys and the string keys.
+ *
+ * Returns:
+ *  error code
+ *    some errors caused by function calls
+ */
+Four EduBtM_Bench(
+    Four        volId,                  /* IN volume identifier */
+    Four        handle)                 /* IN system handle */
+{
+    Four        e;                      /* error number */
+    Four        i;                      /* index */
+    FileID      fid;                    /* file identifier */
+    ObjectID    catalogEntry;           /* catalog object */
+    KeyDesc     kdesc[3];               /* key descriptors of the integer, the string and the multi-part keys */
+
+
+	e = SM_CreateFile(volId, &fid, FALSE, NULL);
+	if (e < eNOERROR) ERR(e);
+
+	e = sm_GetCatalogEntryFromDataFileId(ARRAYINDEX, &fid, &catalogEntry);
+	if (e < eNOERROR) ERR(e);
+
+	kdesc[0].flag = KEYFLAG_UNIQUE;
+	kdesc[0].nparts = 1;
+	kdesc[0].kpart[0].type = SM_INT;
+	kdesc[0].kpart[0].offset = 0;
+	kdesc[0].kpart[0].length = sizeof(Four_Invariable);
+
+	kdesc[1] = kdesc[0];
+	kdesc[1].kpart[0].type = SM_VARSTRING;
+	kdesc[1].kpart[0].length = BENCH_STRINGKEYLEN;
+
+	// (a number of the thousands, a string of the rest)
+	kdesc[2] = kdesc[0];
+	kdesc[2].nparts = 2;
+	kdesc[2].kpart[1].type = SM_VARSTRING;
+	kdesc[2].kpart[1].offset = sizeof(Four_Invariable);
+	kdesc[2].kpart[1].length = 4;
+
+	srand(1);
+	printf("%-16s %-8s %8s %10s %10s %10s %10s\n", "benchmark", "key", "ops", "avg(us)", "p50(us)", "p99(us)", "max(us)");
+
+	for (i = 0; i < 2; i++)
+	{
+		e = bench_SplitLeaf(&catalogEntry, &kdesc[i], bench_runs);
+		if (e < eNOERROR) ERR(e);
+
+		e = bench_SplitInternal(&catalogEntry, &kdesc[i], bench_runs);
+		if (e < eNOERROR) ERR(e);
+
+		e = bench_DeleteLeaf(&catalogEntry, &kdesc[i], bench_runs/10 + 1);
+		if (e < eNOERROR) ERR(e);
+	}
+
+	e = bench_Search(&catalogEntry, &kdesc[0], bench_runs);
+	if (e < eNOERROR) ERR(e);
+
+	for (i = 0; i < 2; i++)
+	{
+		e = bench_Churn(&catalogEntry, &kdesc[i], BENCH_CHURNKEYS);
+		if (e < eNOERROR) ERR(e);
+	}
+
+	printf("\nkey,order,keys,operation,parameter,ops,ops/sec,fixes/op,height,fill\n");
+	for (i = 0; i < 3; i++)
+	{
+		e = bench_Suite(&catalogEntry, &kdesc[(i+2)%3], bench_keys);
+		if (e < eNOERROR) ERR(e);
+	}
+
+	return(eNOERROR);
+
+} /* EduBtM_Bench() */
+
+
+
+/*@================================
+ * bench_SplitLeaf()
+ *================================*/
+/*
+ * Function: Four bench_SplitLeaf(ObjectID*, KeyDesc*, Four)
+ *
+ * Description:
+ *  Split a full leaf page 'runs' times by edubtm_SplitLeaf().
+ *
+ * Returns:
+ *  error code
+ *    some errors caused by function calls
+ */
+Four bench_SplitLeaf(
+    ObjectID        *catObjForFile,     /* IN catalog object of B+ tree file */
+    KeyDesc         *kdesc,             /* IN key descriptor */
+    Four            runs)               /* IN # of runs */
+{
+    Four            e;                  /* error number */
+    Four            i;                  /* index */
+    PageID          pid;                /* the page to split */
+    BtreeLeaf       *apage;             /* buffer of the page */
+    Two             n;                  /* # of entries of the full page */
+    Two             high;               /* slot No. for the new item */
+    LeafItem        item;               /* the item to insert */
+    InternalItem    ritem;              /* the item returned by the split */
+    KeyValue        kval;               /* key value */
+    double          *lat;               /* latencies */
+    double          t;                  /* start time */
+
+
+	e = bench_AllocPage(catObjForFile, TRUE, &pid);
+	if (e < eNOERROR) ERR(e);
+
+	e = BfM_GetTrain(&pid, &apage, PAGE_BUF);
+	if (e < eNOERROR) ERR(e);
+
+	n = bench_FillLeaf(apage, kdesc);
+	memcpy(&bench_template, apage, PAGESIZE);
+
+	lat = (double*)malloc(sizeof(double) * runs);
+	if (lat == NULL) ERRB1(eMEMORYALLOCERR_BTM, &pid, PAGE_BUF);
+
+	for (i = 0; i < runs; i++)
+	{
+		memcpy(apage, &bench_template, PAGESIZE);
+
+		high = rand() % (n+1) - 1;
+		bench_MakeKey(kdesc, 2*(high+1)-1, &kval);
+		item.nObjects = 1;
+		BTM_COPY_KEY(&item.klen, &kval);
+		BENCH_MAKEOID(item.oid, pid.volNo, pid.pageNo, i, i);
+
+		t = bench_Now();
+		e = edubtm_SplitLeaf(catObjForFile, &pid, apage, high, &item, &ritem);
+		lat[i] = bench_Now() - t;
+		if (e < eNOERROR) { free(lat); ERRB1(e, &pid, PAGE_BUF); }
+	}
+
+	bench_Report("split-leaf", kdesc, lat, runs);
+	free(lat);
+
+	e = BfM_FreeTrain(&pid, PAGE_BUF);
+	if (e < eNOERROR) ERR(e);
+
+	return(eNOERROR);
+
+} /* bench_SplitLeaf() */
+
+
+
+/*@================================
+ * bench_SplitInternal()
+ *================================*/
+/*
+ * Function: Four bench_SplitInternal(ObjectID*, KeyDesc*, Four)
+ *
+ * Description:
+ *  Split a full internal page 'runs' times by edubtm_SplitInternal().
+ *
+ * Returns:
+ *  error code
+ *    some errors caused by function calls
+ */
+Four bench_SplitInternal(
+    ObjectID        *catObjForFile,     /* IN catalog object of B+ tree file */
+    KeyDesc         *kdesc,             /* IN key descriptor */
+    Four            runs)               /* IN # of runs */
+{
+    Four            e;                  /* error number */
+    Four            i;                  /* index */
+    PageID          pid;                /* the page to split */
+    BtreeInternal   *apage;             /* buffer of the page */
+    Two             n;                  /* # of entries of the full page */
+    Two             high;               /* slot No. for the new item */
+    InternalItem    item;               /* the item to insert */
+    InternalItem    ritem;              /* the item returned by the split */
+    KeyValue        kval;               /* key value */
+    double          *lat;               /* latencies */
+    double          t;                  /* start time */
+
+
+	e = bench_AllocPage(catObjForFile, FALSE, &pid);
+	if (e < eNOERROR) ERR(e);
+
+	e = BfM_GetTrain(&pid, &apage, PAGE_BUF);
+	if (e < eNOERROR) ERR(e);
+
+	n = bench_FillInternal(apage, kdesc);
+	memcpy(&bench_template, apage, PAGESIZE);
+
+	lat = (double*)malloc(sizeof(double) * runs);
+	if (lat == NULL) ERRB1(eMEMORYALLOCERR_BTM, &pid, PAGE_BUF);
+
+	for (i = 0; i < runs; i++)
+	{
+		memcpy(apage, &bench_template, PAGESIZE);
+
+		high = rand() % (n+1) - 1;
+		bench_MakeKey(kdesc, 2*(high+1)-1, &kval);
+		item.spid = pid.pageNo;
+		BTM_COPY_KEY(&item.klen, &kval);
+
+		t = bench_Now();
+		e = edubtm_SplitInternal(catObjForFile, apage, high, &item, &ritem);
+		lat[i] = bench_Now() - t;
+		if (e < eNOERROR) { free(lat); ERRB1(e, &pid, PAGE_BUF); }
+	}
+
+	bench_Report("split-internal", kdesc, lat, runs);
+	free(lat);
+
+	e = BfM_FreeTrain(&pid, PAGE_BUF);
+	if (e < eNOERROR) ERR(e);
+
+	return(eNOERROR);
+
+} /* bench_SplitInternal() */
+
+
+
+/*@================================
+ * bench_DeleteLeaf()
+ *================================*/
+/*
+ * Function: Four bench_DeleteLeaf(ObjectID*, KeyDesc*, Four)
+ *
+ * Description:
+ *  Delete all entries of a full leaf page in a random order by
+ *  edubtm_DeleteLeaf(), 'runs' times.
+ *
+ * Returns:
+ *  error code
+ *    some errors caused by function calls
+ */
+Four bench_DeleteLeaf(
+    ObjectID        *catObjForFile,     /* IN catalog object of B+ tree file */
+    KeyDesc         *kdesc,             /* IN key descriptor */
+    Four            runs)               /* IN # of runs */
+{
+    Four            e;                  /* error number */
+    Four            i, j, k;            /* indexes */
+    PageID          pid;                /* the page to delete from */
+    PhysicalFileID  pFid;               /* FileID of the B+ tree file */
+    BtreeLeaf       *apage;             /* buffer of the page */
+    Two             n;                  /* # of entries of the full page */
+    Two             *order;             /* the order of the deletions */
+    Two             tmp;                /* for swapping */
+    KeyValue        kval;               /* key value */
+    ObjectID        oid;                /* ObjectID of the key */
+    Boolean         f, h;               /* flags from edubtm_DeleteLeaf() */
+    InternalItem    item;               /* item from edubtm_DeleteLeaf() */
+    double          *lat;               /* latencies */
+    double          t;                  /* start time */
+
+
+	e = bench_AllocPage(catObjForFile, TRUE, &pid);
+	if (e < eNOERROR) ERR(e);
+
+	e = BfM_GetTrain(&pid, &apage, PAGE_BUF);
+	if (e < eNOERROR) ERR(e);
+
+	MAKE_PHYSICALFILEID(pFid, catObjForFile->volNo, catObjForFile->pageNo);
+	n = bench_FillLeaf(apage, kdesc);
+	memcpy(&bench_template, apage, PAGESIZE);
+
+	lat = (double*)malloc(sizeof(double) * runs * n);
+	order = (Two*)malloc(sizeof(Two) * n);
+	if (lat == NULL || order == NULL) ERRB1(eMEMORYALLOCERR_BTM, &pid, PAGE_BUF);
+
+	for (i = 0; i < n; i++) order[i] = i;
+
+	for (i = 0; i < runs; i++)
+	{
+		memcpy(apage, &bench_template, PAGESIZE);
+
+		for (j = n-1; j > 0; j--)
+		{
+			k = rand() % (j+1);
+			tmp = order[j]; order[j] = order[k]; order[k] = tmp;
+		}
+
+		for (j = 0; j < n; j++)
+		{
+			bench_MakeKey(kdesc, 2*order[j], &kval);
+			BENCH_MAKEOID(oid, pid.volNo, pid.pageNo, order[j], order[j]);
+
+			t = bench_Now();
+			e = edubtm_DeleteLeaf(&pFid, &pid, apage, kdesc, &kval, &oid, &f, &h, &item, &dlPool, &dlHead);
+			lat[i*n + j] = bench_Now() - t;
+			if (e < eNOERROR) { free(lat); free(order); ERRB1(e, &pid, PAGE_BUF); }
+		}
+	}
+
+	bench_Report("delete-leaf", kdesc, lat, runs * n);
+	free(lat);
+	free(order);
+
+	e = BfM_FreeTrain(&pid, PAGE_BUF);
+	if (e < eNOERROR) ERR(e);
+
+	return(eNOERROR);
+
+} /* bench_DeleteLeaf() */
+
+
+
+/*@================================
+ * bench_Search()
+ *================================*/
+/*
+ * Function: Four bench_Search(ObjectID*, KeyDesc*, Four)
+ *
+ * Description:
+ *  Search a full leaf page and a full internal page of the integer keys
+ *  'runs' times BENCH_SEARCHBATCH keys by the binary search and by the
+ *  interpolation search. The keys are 0, 2, 4, ... or their cubes; half
+ *  of the lookups miss.
+ *
+ * Returns:
+ *  error code
+ *    some errors caused by function calls
+ */
+Four bench_Search(
+    ObjectID        *catObjForFile,     /* IN catalog object of B+ tree file */
+    KeyDesc         *kdesc,             /* IN key descriptor of the integer keys */
+    Four            runs)               /* IN # of runs */
+{
+    Four            e;                  /* error number */
+    Four            i, j;               /* indexes */
+    Four            isLeaf;             /* 1 for the leaf page */
+    Four            skewed;             /* 1 for the skewed keys */
+    Four            mode;               /* 1 for the interpolation search */
+    PageID          pid;                /* the page to search */
+    BtreePage       *apage;             /* buffer of the page */
+    char            *data;              /* data area of the page */
+    Two             *slot;              /* the first slot of the page */
+    Two             keyOffset;          /* offset of the key value in an entry */
+    Two             n;                  /* # of entries of the full page */
+    Two             idx;                /* result of the search */
+    KeyDesc         kd;                 /* key descriptor of the mode */
+    KeyValue        *kvals;             /* the keys to look up */
+    Four_Invariable v;                  /* a key */
+    Four            probes;             /* # of keys read */
+    double          *lat;               /* time of the batches */
+    double          t;                  /* start time */
+
+
+	kvals = (KeyValue*)malloc(sizeof(KeyValue) * BENCH_SEARCHBATCH);
+	lat = (double*)malloc(sizeof(double) * runs);
+	if (kvals == NULL || lat == NULL) { free(kvals); free(lat); ERR(eMEMORYALLOCERR_BTM); }
+
+	printf("\n%-16s %-8s %-8s %8s %10s %10s %10s\n", "search", "page", "keys", "lookups", "probes", "p50(ns)", "avg(ns)");
+
+	for (isLeaf = 1; isLeaf >= 0; isLeaf--)
+	for (skewed = 0; skewed <= 1; skewed++)
+	{
+		e = bench_AllocPage(catObjForFile, isLeaf, &pid);
+		if (e < eNOERROR) { free(kvals); free(lat); ERR(e); }
+
+		e = BfM_GetTrain(&pid, &apage, PAGE_BUF);
+		if (e < eNOERROR) { free(kvals); free(lat); ERR(e); }
+
+		if (isLeaf)
+		{
+			n = bench_FillLeaf(&apage->bl, kdesc);
+			data = apage->bl.data; slot = apage->bl.slot;
+			keyOffset = sizeof(Two) + sizeof(Two);
+		}
+		else
+		{
+			n = bench_FillInternal(&apage->bi, kdesc);
+			data = apage->bi.data; slot = apage->bi.slot;
+			keyOffset = sizeof(ShortPageID) + sizeof(Two);
+		}
+		if (skewed) bench_SkewKeys(data, slot, n, keyOffset);
+
+		for (mode = 0; mode <= 1; mode++)
+		{
+			kd = *kdesc;
+			if (mode) kd.flag |= KEYFLAG_INTERPOLATE;
+
+			edubtm_nProbes = 0;
+			for (i = 0; i < runs; i++)
+			{
+				for (j = 0; j < BENCH_SEARCHBATCH; j++)
+				{
+					memcpy(&v, data + slot[-1*(rand() % n)] + keyOffset, sizeof(Four_Invariable));
+					v += rand() % 2;
+					bench_MakeKey(&kd, v, &kvals[j]);
+				}
+
+				t = bench_Now();
+				for (j = 0; j < BENCH_SEARCHBATCH; j++)
+				{
+					if (isLeaf) edubtm_BinarySearchLeaf(&apage->bl, &kd, &kvals[j], &idx);
+					else edubtm_BinarySearchInternal(&apage->bi, &kd, &kvals[j], &idx);
+				}
+				lat[i] = (bench_Now() - t) * 1e3 / BENCH_SEARCHBATCH;
+			}
+			probes = edubtm_nProbes;
+
+			qsort(lat, runs, sizeof(double), bench_Compare);
+			for (t = 0, i = 0; i < runs; i++) t += lat[i];
+
+			printf("%-16s %-8s %-8s %8ld %10.2f %10.1f %10.1f\n", mode ? "interpolation" : "binary",
+				   isLeaf ? "leaf" : "internal", skewed ? "skewed" : "uniform", (long)runs * BENCH_SEARCHBATCH,
+				   (double)probes / ((double)runs * BENCH_SEARCHBATCH), lat[runs/2], t / runs);
+		}
+
+		e = BfM_FreeTrain(&pid, PAGE_BUF);
+		if (e < eNOERROR) { free(kvals); free(lat); ERR(e); }
+	}
+
+	free(kvals);
+	free(lat);
+
+	return(eNOERROR);
+
+} /* bench_Search() */
+
+
+
+/*@================================
+ * bench_Churn()
+ *================================*/
+/*
+ * Function: Four bench_Churn(ObjectID*, KeyDesc*, Four)
+ *
+ * Description:
+ *  Measure the write amplification of the delete policies under churn.
+ *  An index of 'n' random keys shrinks to the half by random deletions
+ *  and grows back by random insertions, BENCH_CHURNCYCLES times, with
+ *  merge-at-half (the default), KEYFLAG_MERGEQUARTER and KEYFLAG_FREEEMPTY.
+ *  The splits, the merges and the redistributions are counted; each of
+ *  them writes two pages besides the leaf of the update, the sibling and
+ *  the parent, which gives the page writes per update. The leaves and
+ *  their fill are reported after the churn and after the merge phase of
+ *  EduBtM_Reorganize(), the deferred repair of the lazy policies.
+ *
+ * Returns:
+ *  error code
+ *    some errors caused by function calls
+ */
+Four bench_Churn(
+    ObjectID        *catObjForFile,     /* IN catalog object of B+ tree file */
+    KeyDesc         *kdesc,             /* IN key descriptor */
+    Four            n)                  /* IN # of keys */
+{
+    Four            e;                  /* error number */
+    Four            i, c;               /* indexes */
+    Four            p;                  /* the delete policy */
+    Four            v;                  /* a key */
+    Four            nLive;              /* # of keys in the index */
+    Four            *live;              /* the keys in the index */
+    char            *used;              /* whether each key of the domain is in the index */
+    Four            ops;                /* # of updates of the churn */
+    Four            splits;             /* # of splits of the churn */
+    Four            merges;             /* # of merges of the churn */
+    Four            redists;            /* # of redistributions of the churn */
+    PageID          root;               /* root of the index */
+    KeyDesc         kd;                 /* key descriptor of the policy */
+    KeyValue        kval;               /* key value */
+    ObjectID        oid;                /* ObjectID of the key */
+    BtreeStats      stats;              /* statistics of the index */
+    BtreeReorgCursor cursor;            /* cursor of the reorganization */
+    Two             leaf;               /* level of the leaves */
+    Four            leaves;             /* # of leaves after the churn */
+    double          fill;               /* fill of the leaves after the churn */
+    static Two      policies[3] = { 0, KEYFLAG_MERGEQUARTER, KEYFLAG_FREEEMPTY };
+    static char     *names[3] = { "half", "quarter", "empty" };
+
+
+	live = (Four*)malloc(sizeof(Four) * n);
+	used = (char*)malloc(BENCH_CHURNDOMAIN * n);
+	if (live == NULL || used == NULL) { free(live); free(used); ERR(eMEMORYALLOCERR_BTM); }
+
+	printf("\n%-16s %-8s %-8s %8s %8s %8s %8s %10s %8s %6s %8s %6s\n", "churn", "key", "policy", "ops",
+		   "splits", "merges", "redist", "writes/op", "leaves", "fill", "reorg", "fill");
+
+	for (p = 0; p < 3; p++)
+	{
+		kd = *kdesc;
+		kd.flag |= policies[p];
+
+		e = EduBtM_CreateIndex(catObjForFile, &root);
+		if (e < eNOERROR) { free(live); free(used); ERR(e); }
+
+		memset(used, 0, BENCH_CHURNDOMAIN * n);
+		srand(1);
+		ops = 0;
+
+		// Grow the index to 'n' keys; the growth of the first round is not counted.
+		for (c = 0, nLive = 0; c <= BENCH_CHURNCYCLES; c++)
+		{
+			if (c == 1)
+			{
+				edubtm_nSplits = edubtm_nMerges = edubtm_nRedistributions = 0;
+				ops = 0;
+			}
+
+			for (; c > 0 && nLive > n/2; nLive--, ops++)
+			{
+				i = rand() % nLive;
+				v = live[i];
+				live[i] = live[nLive-1];
+				used[v] = FALSE;
+
+				bench_MakeKey(&kd, v, &kval);
+				BENCH_MAKEOID(oid, root.volNo, root.pageNo, v % 1000, v);
+				e = EduBtM_DeleteObject(catObjForFile, &root, &kd, &kval, &oid, &dlPool, &dlHead);
+				if (e < eNOERROR) { free(live); free(used); ERR(e); }
+			}
+
+			for (; nLive < n; nLive++, ops++)
+			{
+				do v = rand() % (BENCH_CHURNDOMAIN * n); while (used[v]);
+				live[nLive] = v;
+				used[v] = TRUE;
+
+				bench_MakeKey(&kd, v, &kval);
+				BENCH_MAKEOID(oid, root.volNo, root.pageNo, v % 1000, v);
+				e = EduBtM_InsertObject(catObjForFile, &root, &kd, &kval, &oid, &dlPool, &dlHead);
+				if (e < eNOERROR) { free(live); free(used); ERR(e); }
+			}
+		}
+		splits = edubtm_nSplits;
+		merges = edubtm_nMerges;
+		redists = edubtm_nRedistributions;
+
+		e = EduBtM_GetStats(&root, &kd, &stats);
+		if (e < eNOERROR) { free(live); free(used); ERR(e); }
+		leaf = stats.height - 1;
+		leaves = stats.nPages[leaf];
+		fill = stats.avgFill[leaf];
+
+		// Run the merge phase only; the relocation does not change the fill.
+		cursor.phase = REORG_BEGIN;
+		while (cursor.phase == REORG_BEGIN || cursor.phase == REORG_MERGE)
+		{
+			e = EduBtM_Reorganize(catObjForFile, &root, &kd, &cursor, BENCH_CHURNREORGSTEP, &dlPool, &dlHead);
+			if (e < eNOERROR) { free(live); free(used); ERR(e); }
+		}
+
+		e = EduBtM_GetStats(&root, &kd, &stats);
+		if (e < eNOERROR) { free(live); free(used); ERR(e); }
+		leaf = stats.height - 1;
+
+		printf("%-16s %-8s %-8s %8ld %8ld %8ld %8ld %10.3f %8ld %6.2f %8ld %6.2f\n", "delete-policy",
+			   (kd.kpart[0].type == SM_INT) ? "int" : "string", names[p], (long)ops,
+			   (long)splits, (long)merges, (long)redists, (double)(ops + 2*(splits+merges+redists)) / ops, (long)leaves, fill, (long)stats.nPages[leaf], stats.avgFill[leaf]);
+	}
+
+	free(live);
+	free(used);
+
+	return(eNOERROR);
+
+} /* bench_Churn() */
+
+
+
+/*@================================
+ * bench_Suite()
+ *================================*/
+/*
+ * Function: Four bench_Suite(ObjectID*, KeyDesc*, Four)
+ *
+ * Description:
+ *  Build an index of 'n' keys for each insertion order (sequential,
+ *  random and Zipfian, see bench_Order()) and run on it the point lookups
+ *  of random keys, the range scans of BENCH_NSELECTIVITIES selectivities
+ *  and the churn of random deletions each followed by the insertion of a
+ *  new key. Every step is printed as a CSV row by bench_SuiteRow().
+ *
+ * Returns:
+ *  error code
+ *    eMEMORYALLOCERR_BTM
+ *    some errors caused by function calls
+ */
+Four bench_Suite(
+    ObjectID        *catObjForFile,     /* IN catalog object of B+ tree file */
+    KeyDesc         *kdesc,             /* IN key descriptor */
+    Four            n)                  /* IN # of keys */
+{
+    Four            e;                  /* error number */
+    Four            i, s;               /* indexes */
+    Four            order;              /* the insertion order */
+    Four            v;                  /* a key */
+    Four            m;                  /* # of operations */
+    Four            len;                /* # of keys of a range scan */
+    Four            rows;               /* # of keys read by the range scans */
+    Four            *keys;              /* the keys in the index */
+    PageID          root;               /* root of the index */
+    KeyValue        kval;               /* key value */
+    KeyValue        stopKval;           /* key value of the stop condition */
+    ObjectID        oid;                /* ObjectID of the key */
+    BtreeCursor     cursor;             /* cursor of a lookup or a scan */
+    BtreeCursor     next;               /* the next cursor of a scan */
+    BtreeStats      stats;              /* statistics of the index */
+    double          t;                  /* start time */
+    static double   selectivities[BENCH_NSELECTIVITIES] = { 0.00001, 0.0001, 0.001, 0.01, 0.1 };
+    static char     *orders[3] = { "sequential", "random", "zipfian" };
+
+
+	keys = (Four*)malloc(sizeof(Four) * n);
+	if (keys == NULL) ERR(eMEMORYALLOCERR_BTM);
+
+	for (order = BENCH_SEQUENTIAL; order <= BENCH_ZIPFIAN; order++)
+	{
+		srand(1);
+		e = bench_Order(n, order, keys);
+		if (e < eNOERROR) { free(keys); ERR(e); }
+
+		e = EduBtM_CreateIndex(catObjForFile, &root);
+		if (e < eNOERROR) { free(keys); ERR(e); }
+
+		// Build the index in the given order.
+		edubtm_nFixes = 0;
+		t = bench_Now();
+		for (i = 0; i < n; i++)
+		{
+			bench_MakeKey(kdesc, keys[i], &kval);
+			BENCH_MAKEOID(oid, root.volNo, root.pageNo, keys[i] % 1000, keys[i]);
+			e = EduBtM_InsertObject(catObjForFile, &root, kdesc, &kval, &oid, &dlPool, &dlHead);
+			if (e < eNOERROR) { free(keys); ERR(e); }
+		}
+		t = bench_Now() - t;
+
+		e = EduBtM_GetStats(&root, kdesc, &stats);
+		if (e < eNOERROR) { free(keys); ERR(e); }
+		bench_SuiteRow(kdesc, orders[order], n, "insert", 0, n, t, &stats);
+
+		// Point lookups of random keys in the index.
+		m = MIN(n, BENCH_SUITELOOKUPS);
+		edubtm_nFixes = 0;
+		t = bench_Now();
+		for (i = 0; i < m; i++)
+		{
+			bench_MakeKey(kdesc, keys[rand() % n], &kval);
+			e = EduBtM_Fetch(&root, kdesc, &kval, SM_EQ, &kval, SM_EQ, &cursor);
+			if (e < eNOERROR) { free(keys); ERR(e); }
+		}
+		t = bench_Now() - t;
+		bench_SuiteRow(kdesc, orders[order], n, "lookup", 0, m, t, &stats);
+
+		// Range scans; each selectivity reads up to BENCH_SUITESCANROWS keys.
+		for (s = 0; s < BENCH_NSELECTIVITIES; s++)
+		{
+			len = (Four)(n * selectivities[s]);
+			if (len < 1) len = 1;
+			m = MIN(BENCH_SUITESCANS, BENCH_SUITESCANROWS / len);
+			if (m < 1) m = 1;
+			rows = 0;
+			edubtm_nFixes = 0;
+			t = bench_Now();
+			for (i = 0; i < m; i++)
+			{
+				v = rand() % (n - len + 1);
+				bench_MakeKey(kdesc, v, &kval);
+				bench_MakeKey(kdesc, v + len - 1, &stopKval);
+				e = EduBtM_Fetch(&root, kdesc, &kval, SM_GE, &stopKval, SM_LE, &cursor);
+				if (e < eNOERROR) { free(keys); ERR(e); }
+
+				while (cursor.flag == CURSOR_ON)
+				{
+					rows++;
+					e = EduBtM_FetchNext(&root, kdesc, &stopKval, SM_LE, &cursor, &next);
+					if (e < eNOERROR) { free(keys); ERR(e); }
+					cursor = next;
+				}
+			}
+			t = bench_Now() - t;
+			bench_SuiteRow(kdesc, orders[order], n, "scan", selectivities[s], m, t, &stats);
+		}
+
+		// Churn: a random key is deleted and a new key is inserted.
+		m = MIN(n, BENCH_SUITECHURN);
+		edubtm_nFixes = 0;
+		t = bench_Now();
+		for (i = 0; i < m; i++)
+		{
+			s = rand() % n;
+			v = keys[s];
+			bench_MakeKey(kdesc, v, &kval);
+			BENCH_MAKEOID(oid, root.volNo, root.pageNo, v % 1000, v);
+			e = EduBtM_DeleteObject(catObjForFile, &root, kdesc, &kval, &oid, &dlPool, &dlHead);
+			if (e < eNOERROR) { free(keys); ERR(e); }
+
+			v = keys[s] = n + i;
+			bench_MakeKey(kdesc, v, &kval);
+			BENCH_MAKEOID(oid, root.volNo, root.pageNo, v % 1000, v);
+			e = EduBtM_InsertObject(catObjForFile, &root, kdesc, &kval, &oid, &dlPool, &dlHead);
+			if (e < eNOERROR) { free(keys); ERR(e); }
+		}
+		t = bench_Now() - t;
+
+		e = EduBtM_GetStats(&root, kdesc, &stats);
+		if (e < eNOERROR) { free(keys); ERR(e); }
+		bench_SuiteRow(kdesc, orders[order], n, "churn", 0, 2*m, t, &stats);
+	}
+
+	free(keys);
+
+	return(eNOERROR);
+
+} /* bench_Suite() */
+
+
+
+/*@================================
+ * bench_Order()
+ *================================*/
+/*
+ * Function: Four bench_Order(Four, Four, Four*)
+ *
+ * Description:
+ *  Put the numbers 0 to n-1 into 'keys' in the insertion order 'order':
+ *  increasing for BENCH_SEQUENTIAL and a random permutation for
+ *  BENCH_RANDOM. BENCH_ZIPFIAN cuts the numbers into clusters of
+ *  BENCH_ZIPFCLUSTER consecutive ones scattered over the key space in a
+ *  random popularity rank, and draws the cluster of each insertion by the
+ *  Zipf distribution of the ranks; a cluster is filled in increasing
+ *  order, and the draw of a full cluster goes to the next rank with room.
+ *
+ * Returns:
+ *  error code
+ *    eMEMORYALLOCERR_BTM
+ */
+Four bench_Order(
+    Four            n,                  /* IN # of keys */
+    Four            order,              /* IN the insertion order */
+    Four            *keys)              /* OUT the keys in the insertion order */
+{
+    Four            i, j, t;            /* indexes */
+    Four            r, root;            /* popularity ranks */
+    Four            c;                  /* a cluster */
+    Four            nClusters;          /* # of clusters */
+    Four            *cluster;           /* the cluster of each rank */
+    Four            *used;              /* # of numbers taken from each cluster */
+    Four            *room;              /* a rank not after the first rank with room */
+    double          *cdf;               /* the cumulative Zipf weights of the ranks */
+    double          u;                  /* a random point of 'cdf' */
+
+
+	if (order != BENCH_ZIPFIAN)
+	{
+		for (i = 0; i < n; i++) keys[i] = i;
+
+		if (order == BENCH_RANDOM)
+			for (i = n-1; i > 0; i--)
+			{
+				j = rand() % (i+1);
+				t = keys[i]; keys[i] = keys[j]; keys[j] = t;
+			}
+
+		return(eNOERROR);
+	}
+
+	nClusters = (n + BENCH_ZIPFCLUSTER - 1) / BENCH_ZIPFCLUSTER;
+	cluster = (Four*)malloc(sizeof(Four) * nClusters);
+	used = (Four*)calloc(nClusters, sizeof(Four));
+	room = (Four*)malloc(sizeof(Four) * (nClusters+1));
+	cdf = (double*)malloc(sizeof(double) * nClusters);
+	if (cluster == NULL || used == NULL || room == NULL || cdf == NULL)
+	{
+		free(cluster); free(used); free(room); free(cdf);
+		ERR(eMEMORYALLOCERR_BTM);
+	}
+
+	for (r = 0, u = 0; r < nClusters; r++)
+	{
+		u += 1.0 / pow(r+1, BENCH_ZIPFTHETA);
+		cdf[r] = u;
+		cluster[r] = r;
+		room[r] = r;
+	}
+	room[nClusters] = nClusters;
+
+	for (r = nClusters-1; r > 0; r--)
+	{
+		j = rand() % (r+1);
+		t = cluster[r]; cluster[r] = cluster[j]; cluster[j] = t;
+	}
+
+	for (i = 0; i < n; i++)
+	{
+		// Draw a rank and go to the first rank with room from it, wrapping around.
+		u = cdf[nClusters-1] * rand() / ((double)RAND_MAX + 1);
+		for (r = 0, j = nClusters-1; r < j; )
+		{
+			t = (r + j) / 2;
+			if (cdf[t] <= u) r = t + 1;
+			else j = t;
+		}
+
+		for (root = r; room[root] != root; root = room[root]);
+		for (; room[r] != root; r = t) { t = room[r]; room[r] = root; }
+		if (root == nClusters)
+			for (root = 0; room[root] != root; root = room[root]);
+		r = root;
+
+		c = cluster[r];
+		keys[i] = c * BENCH_ZIPFCLUSTER + used[c]++;
+		if (used[c] == BENCH_ZIPFCLUSTER || keys[i] == n-1) room[r] = r + 1;
+	}
+
+	free(cluster);
+	free(used);
+	free(room);
+	free(cdf);
+
+	return(eNOERROR);
+
+} /* bench_Order() */
+
+
+
+/*@================================
+ * bench_SuiteRow()
+ *================================*/
+/*
+ * Function: void bench_SuiteRow(KeyDesc*, char*, Four, char*, double, Four, double, BtreeStats*)
+ *
+ * Description:
+ *  Print a CSV row of bench_Suite(): the key type, the insertion order,
+ *  the # of keys, the operation and its parameter, the # of operations,
+ *  the operations per second, the pages fixed per operation counted in
+ *  edubtm_nFixes, and the height of the index and the fill of its leaves.
+ *
+ * Returns:
+ *  None
+ */
+void bench_SuiteRow(
+    KeyDesc         *kdesc,             /* IN key descriptor */
+    char            *order,             /* IN name of the insertion order */
+    Four            n,                  /* IN # of keys */
+    char            *op,                /* IN name of the operation */
+    double          param,              /* IN parameter of the operation */
+    Four            ops,                /* IN # of operations */
+    double          t,                  /* IN elapsed time in microseconds */
+    BtreeStats      *stats)             /* IN statistics of the index */
+{
+
+	printf("%s,%s,%ld,%s,%g,%ld,%.0f,%.2f,%d,%.3f\n", bench_KeyName(kdesc), order, (long)n, op, param,
+		   (long)ops, ops / (t / 1e6), (double)edubtm_nFixes / ops, stats->height, stats->avgFill[stats->height-1]);
+
+} /* bench_SuiteRow() */
+
+
+
+/*@================================
+ * bench_SkewKeys()
+ *================================*/
+/*
+ * Function: void bench_SkewKeys(char*, Two*, Two, Two)
+ *
+ * Description:
+ *  Replace the integer key of the k-th slot by k cubed, which keeps the
+ *  order but crowds the small keys at the beginning of the page.
+ *
+ * Returns:
+ *  None
+ */
+void bench_SkewKeys(
+    char            *data,              /* INOUT data area of the page */
+    Two             *slot,              /* IN the first slot of the page */
+    Two             n,                  /* IN # of entries */
+    Two             keyOffset)          /* IN offset of the key value in an entry */
+{
+    Two             k;                  /* slot No. */
+    Four_Invariable v;                  /* the new key */
+
+
+	for (k = 0; k < n; k++)
+	{
+		v = 2 * (Four_Invariable)k * k * k;
+		memcpy(data + slot[-1*k] + keyOffset, &v, sizeof(Four_Invariable));
+	}
+
+} /* bench_SkewKeys() */
+
+/*@================================
+ * bench_AllocPage()
+ *================================*/
+/*
+ * Function: Four bench_AllocPage(ObjectID*, Boolean, PageID*)
+ *
+ * Description:
+ *  Allocate an empty leaf or internal page in the B+ tree file.
+ *
+ * Returns:
+ *  error code
+ *    some errors caused by function calls
+ */
+Four bench_AllocPage(
+    ObjectID        *catObjForFile,     /* IN catalog object of B+ tree file */
+    Boolean         isLeaf,             /* IN TRUE for a leaf page */
+    PageID          *pid)               /* OUT the allocated page */
+{
+    Four            e;                  /* error number */
+    PageID          root;               /* root page of a new index; the near page */
+
+
+	e = EduBtM_CreateIndex(catObjForFile, &root);
+	if (e < eNOERROR) ERR(e);
+
+	e = btm_AllocPage(catObjForFile, &root, pid);
+	if (e < eNOERROR) ERR(e);
+
+	if (isLeaf)
+		e = edubtm_InitLeaf(pid, FALSE, FALSE);
+	else
+		e = edubtm_InitInternal(pid, FALSE, FALSE);
+	if (e < eNOERROR) ERR(e);
+
+	return(eNOERROR);
+
+} /* bench_AllocPage() */
+
+
+
+/*@================================
+ * bench_FillLeaf()
+ *================================*/
+/*
+ * Function: Two bench_FillLeaf(BtreeLeaf*, KeyDesc*)
+ *
+ * Description:
+ *  Fill the leaf page with the keys 0, 2, 4, ... until no more fits.
+ *
+ * Returns:
+ *  # of entries of the page
+ */
+Two bench_FillLeaf(
+    BtreeLeaf       *apage,             /* INOUT leaf page */
+    KeyDesc         *kdesc)             /* IN key descriptor */
+{
+    Two             n;                  /* # of entries */
+    LeafItem        item;               /* the item to insert */
+    KeyValue        kval;               /* key value */
+
+
+	for (n = 0; ; n++)
+	{
+		bench_MakeKey(kdesc, 2*n, &kval);
+		item.nObjects = 1;
+		BTM_COPY_KEY(&item.klen, &kval);
+		BENCH_MAKEOID(item.oid, apage->hdr.pid.volNo, apage->hdr.pid.pageNo, n, n);
+		if ((Four)BL_FREE(apage) < BL_ITEMLEN(apage, &item) + (Four)sizeof(Two)) break;
+
+		edubtm_InsertLeafEntry(apage, n, &item);
+	}
+
+	return(n);
+
+} /* bench_FillLeaf() */
+
+
+
+/*@================================
+ * bench_FillInternal()
+ *================================*/
+/*
+ * Function: Two bench_FillInternal(BtreeInternal*, KeyDesc*)
+ *
+ * Description:
+ *  Fill the internal page with the keys 0, 2, 4, ... until no more fits.
+ *
+ * Returns:
+ *  # of entries of the page
+ */
+Two bench_FillInternal(
+    BtreeInternal   *apage,             /* INOUT internal page */
+    KeyDesc         *kdesc)             /* IN key descriptor */
+{
+    Two             n;                  /* # of entries */
+    InternalItem    item;               /* the item to insert */
+    KeyValue        kval;               /* key value */
+
+
+	apage->hdr.p0 = apage->hdr.pid.pageNo;
+	for (n = 0; ; n++)
+	{
+		bench_MakeKey(kdesc, 2*n, &kval);
+		item.spid = apage->hdr.pid.pageNo;
+		BTM_COPY_KEY(&item.klen, &kval);
+		if ((Four)BI_FREE(apage) < BI_ENTRYLEN(&item) + (Four)sizeof(Two)) break;
+
+		edubtm_InsertInternalEntry(apage, n, &item);
+	}
+
+	return(n);
+
+} /* bench_FillInternal() */
+
+
+
+/*@================================
+ * bench_MakeKey()
+ *================================*/
+/*
+ * Function: void bench_MakeKey(KeyDesc*, Four, KeyValue*)
+ *
+ * Description:
+ *  Make the key value of the given number. A string key is the number
+ *  padded to the length of the key part; a multi-part key is the number
+ *  divided by 1000 and the remainder as a string. The keys keep the
+ *  order of the numbers.
+ *
+ * Returns:
+ *  None
+ */
+void bench_MakeKey(
+    KeyDesc         *kdesc,             /* IN key descriptor */
+    Four            v,                  /* IN number of the key */
+    KeyValue        *kval)              /* OUT key value */
+{
+    Two             len;                /* length of the string */
+    Four_Invariable q;                  /* the integer part of a multi-part key */
+
+
+	if (kdesc->nparts == 2)
+	{
+		q = v / 1000;
+		memcpy(kval->val, &q, sizeof(Four_Invariable));
+		sprintf(&kval->val[sizeof(Four_Invariable) + sizeof(Two)], "%0*ld", kdesc->kpart[1].length - 1, (long)(v % 1000));
+		len = kdesc->kpart[1].length;
+		memcpy(&kval->val[sizeof(Four_Invariable)], &len, sizeof(Two));
+		kval->len = sizeof(Four_Invariable) + sizeof(Two) + len;
+	}
+	else if (kdesc->kpart[0].type == SM_INT)
+	{
+		kval->len = sizeof(Four_Invariable);
+		memcpy(kval->val, &v, sizeof(Four_Invariable));
+	}
+	else
+	{
+		sprintf(&kval->val[sizeof(Two)], "%0*ld", kdesc->kpart[0].length - 1, (long)v);
+		len = kdesc->kpart[0].length;
+		memcpy(kval->val, &len, sizeof(Two));
+		kval->len = sizeof(Two) + len;
+	}
+
+} /* bench_MakeKey() */
+
+
+
+/*@================================
+ * bench_KeyName()
+ *================================*/
+/*
+ * Function: char *bench_KeyName(KeyDesc*)
+ *
+ * Description:
+ *  Return the name of the key type of the key descriptor.
+ */
+char *bench_KeyName(
+    KeyDesc         *kdesc)             /* IN key descriptor */
+{
+
+	if (kdesc->nparts > 1) return("multi");
+
+	return((kdesc->kpart[0].type == SM_INT) ? "int" : "string");
+
+} /* bench_KeyName() */
+
+
+
+/*@================================
+ * bench_Now()
+ *================================*/
+/*
+ * Function: double bench_Now(void)
+ *
+ * Description:
+ *  Return the current time of the monotonic clock in microseconds.
+ */
+double bench_Now(void)
+{
+    struct timespec ts;
+
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+
+	return(ts.tv_sec * 1e6 + ts.tv_nsec / 1e3);
+
+} /* bench_Now() */
+
+
+
+/*@================================
+ * bench_Report()
+ *================================*/
+/*
+ * Function: void bench_Report(char*, KeyDesc*, double*, Four)
+ *
+ * Description:
+ *  Print the average, the median, the 99th percentile and the maximum
+ *  of the latencies. 'lat' is sorted.
+ */
+void bench_Report(
+    char            *name,              /* IN name of the benchmark */
+    KeyDesc         *kdesc,             /* IN key descriptor */
+    double          *lat,               /* INOUT latencies in microseconds */
+    Four            n)                  /* IN # of latencies */
+{
+    Four            i;                  /* index */
+    double          sum = 0;            /* sum of the latencies */
+
+
+	qsort(lat, n, sizeof(double), bench_Compare);
+	for (i = 0; i < n; i++) sum += lat[i];
+
+	printf("%-16s %-8s %8ld %10.3f %10.3f %10.3f %10.3f\n", name,
+		   (kdesc->kpart[0].type == SM_INT) ? "int" : "string", (long)n,
+		   sum / n, lat[n/2], lat[n*99/100], lat[n-1]);
+
+} /* bench_Report() */
+
+
+
+/*@================================
+ * bench_Compare()
+ *================================*/
+int bench_Compare(const void *a, const void *b)
+{
+	double x = *(double*)a, y = *(double*)b;
+
+	return((x > y) - (x < y));
+
+} /* bench_Compare() */
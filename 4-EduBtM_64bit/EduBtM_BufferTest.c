@@ -0,0 +1,525 @@
+/******************************************************************************/
+/*                                                                            */
+/*    ODYSSEUS/EduCOSMOS Educational-Purpose Object Storage System            */
+/*                                                                            */
+/*    Developed by Professor Kyu-Young Whang et al.                           */
+/*                                                                            */
+/*    Database and Multimedia Laboratory                                      */
+/*                                                                            */
+/*    Computer Science Department and                                         */
+/*    Advanced Information Technology Research Center (AITrc)                 */
+/*    Korea Advanced Institute of Science and Technology (KAIST)              */
+/*                                                                            */
+/*    e-mail: kywhang@cs.kaist.ac.kr                                          */
+/*    phone: +82-42-350-7722                                                  */
+/*    fax: +82-42-350-8380                                                    */
+/*                                                                            */
+/*    Copyright (c) 1995-2013 by Kyu-Young Whang                              */
+/*                                                                            */
+/*    All rights reserved. No part of this software may be reproduced,        */
+/*    stored in a retrieval system, or transmitted, in any form or by any     */
+/*    means, electronic, mechanical, photocopying, recording, or otherwise,   */
+/*    without prior written permission of the copyright owner.                */
+/*                                                                            */
+/******************************************************************************/
+/*
+ * Module: EduBtM_BufferTest.c
+ *
+ * Description :
+ *  Regression test of the B-epsilon index (KEYFLAG_BUFFERED). A unique and
+ *  a non-unique buffered index of integer keys go through random mixed
+ *  insertions and deletions, including insertions of keys already in the
+ *  index, deletions of pairs not in it, and deletions right after the
+ *  insertion of the same pair. The results are kept in a set of pairs:
+ *   - an insertion of a key in the index returns eDUPLICATEDKEY_BTM in the
+ *     unique index and is dropped in the other,
+ *   - a deletion of a pair not in the index is dropped,
+ *   - a search for a random key returns the ObjectID of the set, and
+ *   - a scan from the first key to the last returns exactly the pairs of
+ *     the set, in the order of the keys.
+ *
+ *  Usage: EduBtM_BufferTest
+ *
+ *  The exit status is 0 if all the checks pass.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "EduBtM_common.h"
+#include "EduBtM_basictypes.h"
+#include "BfM.h"
+#include "EduBtM.h"
+#include "EduBtM_Internal.h"
+#include "EduBtM_TestModule.h"
+
+
+#define BTEST_VOLUME        "buffertest.vol"
+#define BTEST_NUMPAGES      8000    /* # of pages of the volume */
+#define BTEST_NUMKEYS       20000   /* the keys are the numbers in [0, BTEST_NUMKEYS) */
+#define BTEST_ROUNDS        20      /* # of rounds of updates between full checks */
+#define BTEST_UPDATES       5000    /* # of random updates in a round */
+#define BTEST_SEARCHES      500     /* # of random searches in a round */
+
+Four SM_CreateFile(Four, FileID*, Boolean, void*);
+Four sm_GetCatalogEntryFromDataFileId(Four, FileID*, ObjectID*);
+
+Four EduBtM_BufferTest(Four, Four);
+Four btest_Run(ObjectID*, Two, char*);
+Four btest_Insert(ObjectID*, PageID*, KeyDesc*, Four, Four);
+Four btest_Delete(ObjectID*, PageID*, KeyDesc*, Four, Four);
+Four btest_Search(PageID*, KeyDesc*, Four);
+Four btest_Check(PageID*, KeyDesc*, char*);
+void btest_MakeKey(Four, KeyValue*);
+Four btest_KeyNumber(KeyValue*);
+
+static Four btest_oid[BTEST_NUMKEYS];       /* 'unique' of the ObjectID of each key; 0 if not in the index */
+static Four btest_nextOid;                  /* 'unique' of the next ObjectID */
+static Four btest_nErrors;                  /* # of violations found by the current check */
+
+
+
+/*@================================
+ * main()
+ *================================*/
+int main(int argc, char *argv[])
+{
+	Four	e;									/* for errors */
+	Four	handle;								/* system handle */
+	char 	*devNames[1];						/* device name */
+	Four 	volId = 1000;						/* volume identifier */
+	Four 	numPagesInDevices[1];				/* # of pages in the device */
+	XactID 	xactId;								/* transaction identifier */
+
+
+	devNames[0] = BTEST_VOLUME;
+	numPagesInDevices[0] = BTEST_NUMPAGES;
+
+	e = LRDS_Init();
+	if (e < eNOERROR) { printf("LRDS_Init failed!!!\n"); exit(1); }
+
+	e = LRDS_AllocHandle(&handle);
+	if (e < eNOERROR) { printf("LRDS_AllocHandle failed!!!\n"); LRDS_Final(); exit(1); }
+
+	e = LRDS_FormatDataVolume(1, devNames, "buffertest", volId, 16, numPagesInDevices, 16);
+	if (e < eNOERROR) { printf("LRDS_FormatDataVolume failed!!!\n"); LRDS_FreeHandle(handle); LRDS_Final(); exit(1); }
+
+	e = LRDS_Mount(1, devNames, &volId);
+	if (e < eNOERROR) { printf("LRDS_Mount failed!!!\n"); LRDS_FreeHandle(handle); LRDS_Final(); exit(1); }
+
+	e = LRDS_BeginTransaction(&xactId, X_RR_RR);
+	if (e < eNOERROR) { LRDS_Dismount(volId); LRDS_FreeHandle(handle); LRDS_Final(); exit(1); }
+
+	e = EduBtM_BufferTest(volId, handle);
+	if (e < eNOERROR) {
+		printf("EduBtM_BufferTest failed!!!\n");
+		LRDS_AbortTransaction(&xactId);
+		LRDS_Dismount(volId);
+		LRDS_FreeHandle(handle);
+		LRDS_Final();
+		exit(1);
+	}
+
+	e = LRDS_CommitTransaction(&xactId);
+	if (e < eNOERROR) printf("LRDS_CommitTransaction failed!!!\n");
+
+	LRDS_Dismount(volId);
+	LRDS_FreeHandle(handle);
+	LRDS_Final();
+
+	return 0;
+}
+
+
+
+/*@================================
+ * EduBtM_BufferTest()
+ *================================*/
+/*
+ * Function: Four EduBtM_BufferTest(Four, Four)
+ *
+ * Description:
+ *  Run the test on a unique and on a non-unique buffered index.
+ *
+ * Returns:
+ *  error code
+ *    eBADBTREEPAGE_BTM if a check fails
+ *    some errors caused by function calls
+ */
+Four EduBtM_BufferTest(
+    Four        volId,                  /* IN volume identifier */
+    Four        handle)                 /* IN system handle */
+{
+    Four        e;                      /* error number */
+    FileID      fid;                    /* file identifier */
+    ObjectID    catalogEntry;           /* catalog object */
+
+
+	e = SM_CreateFile(volId, &fid, FALSE, NULL);
+	if (e < eNOERROR) ERR(e);
+
+	e = sm_GetCatalogEntryFromDataFileId(ARRAYINDEX, &fid, &catalogEntry);
+	if (e < eNOERROR) ERR(e);
+
+	srand(17);
+
+	e = btest_Run(&catalogEntry, KEYFLAG_BUFFERED|KEYFLAG_UNIQUE, "unique");
+	if (e < eNOERROR) ERR(e);
+
+	e = btest_Run(&catalogEntry, KEYFLAG_BUFFERED, "non-unique");
+	if (e < eNOERROR) ERR(e);
+
+	printf("all checks passed\n");
+
+	return(eNOERROR);
+
+} /* EduBtM_BufferTest() */
+
+
+
+/*@================================
+ * btest_Run()
+ *================================*/
+/*
+ * Function: Four btest_Run(ObjectID*, Two, char*)
+ *
+ * Description:
+ *  Create a buffered index with the given flags, run the rounds of random
+ *  updates and searches on it, and check it after each round.
+ *
+ * Returns:
+ *  error code
+ *    eBADBTREEPAGE_BTM if a check fails
+ *    some errors caused by function calls
+ */
+Four btest_Run(
+    ObjectID        *catObjForFile,     /* IN catalog object of B+ tree file */
+    Two             flag,               /* IN flags of the key descriptor */
+    char            *name)              /* IN name of the index */
+{
+    Four            e;                  /* error number */
+    Four            i, j;               /* indexes */
+    Four            v;                  /* number of a key */
+    PageID          root;               /* root of the index */
+    KeyDesc         kdesc;              /* key descriptor */
+    char            step[64];           /* name of a step */
+
+
+	kdesc.flag = flag;
+	kdesc.nparts = 1;
+	kdesc.kpart[0].type = SM_INT;
+	kdesc.kpart[0].offset = 0;
+	kdesc.kpart[0].length = sizeof(Four_Invariable);
+
+	e = EduBtM_CreateIndex(catObjForFile, &root);
+	if (e < eNOERROR) ERR(e);
+
+	memset(btest_oid, 0, sizeof(btest_oid));
+	btest_nextOid = 1;
+
+	for (i = 0; i < BTEST_ROUNDS; i++)
+	{
+		for (j = 0; j < BTEST_UPDATES; j++)
+		{
+			v = rand() % BTEST_NUMKEYS;
+
+			// Insertions win in the first half of the rounds, deletions in the second.
+			if (rand() % 100 < ((i < BTEST_ROUNDS/2) ? 70 : 30))
+				e = btest_Insert(catObjForFile, &root, &kdesc, v, btest_nextOid++);
+			else if (btest_oid[v] != 0 && rand() % 4 != 0)
+				e = btest_Delete(catObjForFile, &root, &kdesc, v, btest_oid[v]);
+			else
+				e = btest_Delete(catObjForFile, &root, &kdesc, v, btest_nextOid++);
+			if (e < eNOERROR) ERR(e);
+
+			// Delete right after the insertion, while both are in the root.
+			if (rand() % 10 == 0)
+			{
+				e = btest_Insert(catObjForFile, &root, &kdesc, v, btest_nextOid++);
+				if (e < eNOERROR) ERR(e);
+
+				e = btest_Delete(catObjForFile, &root, &kdesc, v, btest_oid[v]);
+				if (e < eNOERROR) ERR(e);
+			}
+		}
+
+		btest_nErrors = 0;
+		for (j = 0; j < BTEST_SEARCHES; j++)
+		{
+			e = btest_Search(&root, &kdesc, rand() % BTEST_NUMKEYS);
+			if (e < eNOERROR) ERR(e);
+		}
+
+		sprintf(step, "%s round %ld", name, (long)i);
+		e = btest_Check(&root, &kdesc, step);
+		if (e < eNOERROR) ERR(e);
+	}
+
+	return(eNOERROR);
+
+} /* btest_Run() */
+
+
+
+/*@================================
+ * btest_Insert()
+ *================================*/
+/*
+ * Function: Four btest_Insert(ObjectID*, PageID*, KeyDesc*, Four, Four)
+ *
+ * Description:
+ *  Insert the pair of the given key and ObjectID and update the set. An
+ *  insertion of a key in the set should return eDUPLICATEDKEY_BTM in a
+ *  unique index and change nothing in the other.
+ *
+ * Returns:
+ *  error code
+ *    some errors caused by function calls
+ */
+Four btest_Insert(
+    ObjectID        *catObjForFile,     /* IN catalog object of B+ tree file */
+    PageID          *root,              /* IN root of the index */
+    KeyDesc         *kdesc,             /* IN key descriptor */
+    Four            v,                  /* IN number of the key */
+    Four            unique)             /* IN 'unique' of the ObjectID */
+{
+    Four            e;                  /* error number */
+    KeyValue        kval;               /* key value */
+    ObjectID        oid;                /* ObjectID of the key */
+
+
+	btest_MakeKey(v, &kval);
+	oid.volNo = catObjForFile->volNo; oid.pageNo = 1; oid.slotNo = 0; oid.unique = unique;
+
+	e = EduBtM_InsertObject(catObjForFile, root, kdesc, &kval, &oid, &dlPool, &dlHead);
+	if (e == eDUPLICATEDKEY_BTM && (kdesc->flag & KEYFLAG_UNIQUE) && btest_oid[v] != 0)
+		return(eNOERROR);
+	if (e < eNOERROR) ERR(e);
+
+	if ((kdesc->flag & KEYFLAG_UNIQUE) && btest_oid[v] != 0)
+	{
+		printf("  the insertion of the duplicated key %ld succeeds\n", (long)v);
+		ERR(eBADBTREEPAGE_BTM);
+	}
+
+	if (btest_oid[v] == 0) btest_oid[v] = unique;
+
+	return(eNOERROR);
+
+} /* btest_Insert() */
+
+
+
+/*@================================
+ * btest_Delete()
+ *================================*/
+/*
+ * Function: Four btest_Delete(ObjectID*, PageID*, KeyDesc*, Four, Four)
+ *
+ * Description:
+ *  Delete the pair of the given key and ObjectID and update the set. The
+ *  pair need not be in the set.
+ *
+ * Returns:
+ *  error code
+ *    some errors caused by function calls
+ */
+Four btest_Delete(
+    ObjectID        *catObjForFile,     /* IN catalog object of B+ tree file */
+    PageID          *root,              /* IN root of the index */
+    KeyDesc         *kdesc,             /* IN key descriptor */
+    Four            v,                  /* IN number of the key */
+    Four            unique)             /* IN 'unique' of the ObjectID */
+{
+    Four            e;                  /* error number */
+    KeyValue        kval;               /* key value */
+    ObjectID        oid;                /* ObjectID of the key */
+
+
+	btest_MakeKey(v, &kval);
+	oid.volNo = catObjForFile->volNo; oid.pageNo = 1; oid.slotNo = 0; oid.unique = unique;
+
+	e = EduBtM_DeleteObject(catObjForFile, root, kdesc, &kval, &oid, &dlPool, &dlHead);
+	if (e < eNOERROR) ERR(e);
+
+	if (btest_oid[v] == unique) btest_oid[v] = 0;
+
+	return(eNOERROR);
+
+} /* btest_Delete() */
+
+
+
+/*@================================
+ * btest_Search()
+ *================================*/
+/*
+ * Function: Four btest_Search(PageID*, KeyDesc*, Four)
+ *
+ * Description:
+ *  Search for the given key and compare the result with the set. The
+ *  violations are printed and counted.
+ *
+ * Returns:
+ *  error code
+ *    some errors caused by function calls
+ */
+Four btest_Search(
+    PageID          *root,              /* IN root of the index */
+    KeyDesc         *kdesc,             /* IN key descriptor */
+    Four            v)                  /* IN number of the key */
+{
+    Four            e;                  /* error number */
+    KeyValue        kval;               /* key value */
+    BtreeCursor     cursor;             /* cursor of the search */
+
+
+	btest_MakeKey(v, &kval);
+
+	e = EduBtM_Fetch(root, kdesc, &kval, SM_EQ, &kval, SM_EQ, &cursor);
+	if (e < eNOERROR) ERR(e);
+
+	if (cursor.flag != CURSOR_ON && btest_oid[v] != 0)
+	{
+		printf("  the search misses the key %ld\n", (long)v);
+		btest_nErrors++;
+	}
+	else if (cursor.flag == CURSOR_ON && cursor.oid.unique != btest_oid[v])
+	{
+		printf("  the search for the key %ld returns the ObjectID %ld instead of %ld\n",
+		       (long)v, (long)cursor.oid.unique, (long)btest_oid[v]);
+		btest_nErrors++;
+	}
+
+	return(eNOERROR);
+
+} /* btest_Search() */
+
+
+
+/*@================================
+ * btest_Check()
+ *================================*/
+/*
+ * Function: Four btest_Check(PageID*, KeyDesc*, char*)
+ *
+ * Description:
+ *  Check the pairs returned by a full scan against the set. The violations
+ *  are printed.
+ *
+ * Returns:
+ *  error code
+ *    eBADBTREEPAGE_BTM if the check fails
+ *    some errors caused by function calls
+ */
+Four btest_Check(
+    PageID          *root,              /* IN root of the index */
+    KeyDesc         *kdesc,             /* IN key descriptor */
+    char            *name)              /* IN name of the step */
+{
+    Four            e;                  /* error number */
+    Four            v;                  /* number of a key */
+    Four            prev;               /* number of the previous key */
+    Four            nKeys;              /* # of keys returned by the scan */
+    Four            nAlive;             /* # of keys of the set */
+    KeyValue        kval;               /* a dummy key of the scan */
+    BtreeCursor     cursor;             /* cursor of the scan */
+    BtreeCursor     next;               /* the next cursor of the scan */
+
+
+	nKeys = nAlive = 0;
+	for (v = 0; v < BTEST_NUMKEYS; v++)
+		if (btest_oid[v] != 0) nAlive++;
+
+	prev = -1;
+	btest_MakeKey(0, &kval);
+	e = EduBtM_Fetch(root, kdesc, &kval, SM_BOF, &kval, SM_EOF, &cursor);
+	if (e < eNOERROR) ERR(e);
+
+	while (cursor.flag == CURSOR_ON)
+	{
+		v = btest_KeyNumber(&cursor.key);
+		if (v <= prev)
+		{
+			printf("  the scan returns the key %ld after %ld\n", (long)v, (long)prev);
+			btest_nErrors++;
+		}
+		else if (v >= BTEST_NUMKEYS || btest_oid[v] != cursor.oid.unique)
+		{
+			printf("  the scan returns the pair of the key %ld and the ObjectID %ld\n",
+			       (long)v, (long)cursor.oid.unique);
+			btest_nErrors++;
+		}
+		prev = v;
+		nKeys++;
+
+		e = EduBtM_FetchNext(root, kdesc, &kval, SM_EOF, &cursor, &next);
+		if (e < eNOERROR) ERR(e);
+		cursor = next;
+	}
+
+	if (nKeys != nAlive)
+	{
+		printf("  the scan returns %ld keys instead of %ld\n", (long)nKeys, (long)nAlive);
+		btest_nErrors++;
+	}
+
+	printf("%-32s %6ld keys %s\n", name, (long)nKeys, (btest_nErrors == 0) ? "ok" : "FAILED");
+
+	if (btest_nErrors > 0) ERR(eBADBTREEPAGE_BTM);
+
+	return(eNOERROR);
+
+} /* btest_Check() */
+
+
+
+/*@================================
+ * btest_MakeKey()
+ *================================*/
+/*
+ * Function: void btest_MakeKey(Four, KeyValue*)
+ *
+ * Description:
+ *  Make the integer key value of the given number.
+ *
+ * Returns:
+ *  None
+ */
+void btest_MakeKey(
+    Four            v,                  /* IN number of the key */
+    KeyValue        *kval)              /* OUT key value */
+{
+    Four_Invariable k;                  /* the key as an integer */
+
+
+	k = v;
+	memcpy(kval->val, &k, sizeof(Four_Invariable));
+	kval->len = sizeof(Four_Invariable);
+
+} /* btest_MakeKey() */
+
+
+
+/*@================================
+ * btest_KeyNumber()
+ *================================*/
+/*
+ * Function: Four btest_KeyNumber(KeyValue*)
+ *
+ * Description:
+ *  Return the number of a key made by btest_MakeKey().
+ *
+ * Returns:
+ *  number of the key
+ */
+Four btest_KeyNumber(
+    KeyValue        *kval)              /* IN key value */
+{
+    Four_Invariable k;                  /* the key as an integer */
+
+
+	memcpy(&k, kval->val, sizeof(Four_Invariable));
+
+	return(k);
+
+} /* btest_KeyNumber() */
@@ -30,6 +30,8 @@
  *
  * Exports:
  *  Four EduBtM_CreateIndex(ObjectID*, PageID*)
+ *  Four EduBtM_CreateCoveringIndex(ObjectID*, PageID*, Two)
+ *  Four EduBtM_CreatePackedIndex(ObjectID*, PageID*)
  */
 
 
@@ -72,7 +74,7 @@ Four EduBtM_CreateIndex(
 
 
 	MAKE_PAGEID(pFid, catObjForFile->volNo, catObjForFile->pageNo);
-	e = BfM_GetTrain(&pFid, &catPage, PAGE_BUF);
+	e = edubtm_GetTrain(&pFid, &catPage, PAGE_BUF);
 	if (e < 0) ERR(e);	
 	GET_PTR_TO_CATENTRY_FOR_BTREE(catObjForFile, catPage, catEntry);
 	MAKE_PAGEID(*rootPid, catObjForFile->volNo, catEntry->firstPage);
@@ -89,3 +91,109 @@ Four EduBtM_CreateIndex(
     return(eNOERROR);
     
 } /* EduBtM_CreateIndex() */
+
+
+
+/*@================================
+ * EduBtM_CreateCoveringIndex()
+ *================================*/
+/* 
+ * Function: Four  EduBtM_CreateCoveringIndex(ObjectID*, PageID*, Two)
+ *
+ * Description : 
+ *  Create a new B+ tree index whose leaf entries carry 'includedLen' bytes
+ *  of included columns after the ObjectID. The included columns are given
+ *  by EduBtM_InsertCovering() and returned in the cursors of EduBtM_Fetch()
+ *  and EduBtM_FetchNext(), so the queries on them need not read the data
+ *  file.
+ *
+ * Returns :
+ *  error code
+ *    eBADPARAMETER_BTM
+ *    some errors caused by function calls
+ *
+ * Side effects:
+ *  The parameter rootPid is filled with the new root page's PageID. 
+ */
+Four EduBtM_CreateCoveringIndex(
+    ObjectID *catObjForFile,	/* IN catalog object of B+ tree file */
+    PageID *rootPid,		/* OUT root page of the newly created B+tree */
+    Two includedLen)		/* IN length of the included columns */
+{
+    Four 			e;			/* error number */
+    BtreeLeaf 		*rootPage;	/* buffer of the root page */
+
+
+	if (includedLen < 0 || includedLen > MAXINCLUDEDLEN) ERR(eBADPARAMETER_BTM);
+
+	e = EduBtM_CreateIndex(catObjForFile, rootPid);
+	if (e < 0) ERR(e);
+
+	// The length is inherited by the leaves split off from the root.
+	e = edubtm_GetTrain(rootPid, &rootPage, PAGE_BUF);
+	if (e < 0) ERR(e);
+
+	rootPage->hdr.reserved = includedLen;
+
+	e = BfM_SetDirty(rootPid, PAGE_BUF);
+	if (e < 0) ERRB1(e, rootPid, PAGE_BUF);
+
+	e = BfM_FreeTrain(rootPid, PAGE_BUF);
+	if (e < 0) ERR(e);
+
+
+    return(eNOERROR);
+    
+} /* EduBtM_CreateCoveringIndex() */
+
+
+
+/*@================================
+ * EduBtM_CreatePackedIndex()
+ *================================*/
+/* 
+ * Function: Four  EduBtM_CreatePackedIndex(ObjectID*, PageID*)
+ *
+ * Description : 
+ *  Create a new B+ tree index whose leaf entries store the ObjectIDs packed
+ *  relative to a base of the leaf (see btm_OidBase), which takes fewer
+ *  bytes when the ObjectIDs point to nearby data pages. The index is used
+ *  as an ordinary one; the cursors get the ObjectIDs unpacked.
+ *
+ * Returns :
+ *  error code
+ *    some errors caused by function calls
+ *
+ * Side effects:
+ *  The parameter rootPid is filled with the new root page's PageID. 
+ */
+Four EduBtM_CreatePackedIndex(
+    ObjectID *catObjForFile,	/* IN catalog object of B+ tree file */
+    PageID *rootPid)		/* OUT root page of the newly created B+tree */
+{
+    Four 			e;			/* error number */
+    BtreeLeaf 		*rootPage;	/* buffer of the root page */
+
+
+	e = EduBtM_CreateIndex(catObjForFile, rootPid);
+	if (e < 0) ERR(e);
+
+	// The format is inherited by the leaves split off from the root.
+	e = edubtm_GetTrain(rootPid, &rootPage, PAGE_BUF);
+	if (e < 0) ERR(e);
+
+	rootPage->hdr.type |= PACKED;
+	BL_OIDBASE(rootPage)->pageNo = NIL;
+	BL_OIDBASE(rootPage)->volNo = rootPid->volNo;
+	rootPage->hdr.free = BL_DATASTART(rootPage);
+
+	e = BfM_SetDirty(rootPid, PAGE_BUF);
+	if (e < 0) ERRB1(e, rootPid, PAGE_BUF);
+
+	e = BfM_FreeTrain(rootPid, PAGE_BUF);
+	if (e < 0) ERR(e);
+
+
+    return(eNOERROR);
+    
+} /* EduBtM_CreatePackedIndex() */
@@ -59,9 +59,15 @@
  *  may be splitted in spite of deleting. In this case, it is used the 'lh'
  *  flag and an internal item as similar to inserting.
  *
+ *  In a B-epsilon index (KEYFLAG_BUFFERED), the deletion is put into the
+ *  message buffer of the root and goes down to the leaf later. The deletion
+ *  does not read the leaves, so deleting a pair which does not exist is not
+ *  reported; it is dropped at the leaf.
+ *
  * Returns:
  *  error code
  *    eBADPARAMETER_BTM
+ *    eNOTFOUND_BTM
  *    some errors caused by fucntion calls
  */
 Four EduBtM_DeleteObject(
@@ -103,22 +109,36 @@ Four EduBtM_DeleteObject(
             ERR(eNOTSUPPORTED_EDUBTM);
     }
 
+	edubtm_TraceBegin(BTM_TRACE_DELETE);
+
+	/* B-epsilon index: put the deletion into the message buffers */
+	if (kdesc->flag & KEYFLAG_BUFFERED)
+	{
+		e = edubtm_PutMessage(catObjForFile, root, kdesc, BTM_MSG_DELETE, kval, oid, dlPool, dlHead);
+		if (e < 0) ERRT(e, BTM_TRACE_DELETE);
+
+		edubtm_TraceEnd(BTM_TRACE_DELETE);
+		return(eNOERROR);
+	}
+
 	MAKE_PAGEID(pFid, catObjForFile->volNo, catObjForFile->pageNo);
 
 	e = edubtm_Delete(catObjForFile, root, kdesc, kval, oid, &lf, &lh, &item, dlPool, dlHead);
-	if (e < 0) ERR(e);
+	if (e < 0) ERRT(e, BTM_TRACE_DELETE);
 
 	if (lf == TRUE)
 	{
+		edubtm_TopCacheInvalidate(root);
 		e = btm_root_delete(&pFid, root, dlPool, dlHead);
-		if (e < 0) ERR(e);
+		if (e < 0) ERRT(e, BTM_TRACE_DELETE);
 	}
 
 	if (lh == TRUE)
 	{
 		e = edubtm_root_insert(catObjForFile, root, &item);
-		if (e < 0) ERR(e);
+		if (e < 0) ERRT(e, BTM_TRACE_DELETE);
 	}
+	edubtm_TraceEnd(BTM_TRACE_DELETE);
     
     return(eNOERROR);
     
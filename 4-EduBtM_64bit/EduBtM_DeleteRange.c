@@ -0,0 +1,162 @@
+/******************************************************************************/
+/*                                                                            */
+/*    ODYSSEUS/EduCOSMOS Educational-Purpose Object Storage System            */
+/*                                                                            */
+/*    Developed by Professor Kyu-Young Whang et al.                           */
+/*                                                                            */
+/*    Database and Multimedia Laboratory                                      */
+/*                                                                            */
+/*    Computer Science Department and                                         */
+/*    Advanced Information Technology Research Center (AITrc)                 */
+/*    Korea Advanced Institute of Science and Technology (KAIST)              */
+/*                                                                            */
+/*    e-mail: kywhang@cs.kaist.ac.kr                                          */
+/*    phone: +82-42-350-7722                                                  */
+/*    fax: +82-42-350-8380                                                    */
+/*                                                                            */
+/*    Copyright (c) 1995-2013 by Kyu-Young Whang                              */
+/*                                                                            */
+/*    All rights reserved. No part of this software may be reproduced,        */
+/*    stored in a retrieval system, or transmitted, in any form or by any     */
+/*    means, electronic, mechanical, photocopying, recording, or otherwise,   */
+/*    without prior written permission of the copyright owner.                */
+/*                                                                            */
+/******************************************************************************/
+/*
+ * Module: EduBtM_DeleteRange.c
+ *
+ * Description : 
+ *  Delete from a B+tree all the ObjectIDs whose keys are in a range.
+ *
+ * Exports:
+ *  Four EduBtM_DeleteRange(ObjectID*, PageID*, KeyDesc*, KeyValue*, Four, KeyValue*, Four,
+ *                          Pool*, DeallocListElem*)
+ */
+
+
+#include "EduBtM_common.h"
+#include "BfM.h"
+#include "OM_Internal.h"
+#include "EduBtM_Internal.h"
+
+
+
+/*@================================
+ * EduBtM_DeleteRange()
+ *================================*/
+/*
+ * Function: Four EduBtM_DeleteRange(ObjectID*, PageID*, KeyDesc*, KeyValue*, Four,
+ *                                   KeyValue*, Four, Pool*, DeallocListElem*)
+ *
+ * Description : 
+ *  Delete from a B+tree all the ObjectIDs whose keys satisfy both the start
+ *  condition ('startCompOp' is SM_BOF, SM_GE or SM_GT) and the stop
+ *  condition ('stopCompOp' is SM_EOF, SM_LE or SM_LT).
+ *
+ *  Only the pages on the paths to the two ends of the range are visited.
+ *  The subtrees between the two paths are put into the dealloc list as a
+ *  whole, the leaves at the two ends are linked to each other, and then
+ *  the underfull pages on the two paths are merged or redistributed. So
+ *  the cost depends on the height of the tree, not on the number of keys
+ *  deleted.
+ *
+ * Returns:
+ *  error code
+ *    eBADPARAMETER_BTM
+ *    eBADCOMPOP_BTM
+ *    eNOTSUPPORTED_EDUBTM
+ *    some errors caused by fucntion calls
+ *
+ * Note:
+ *  The scan cursors opened before the deletion are not valid after it.
+ */
+Four EduBtM_DeleteRange(
+    ObjectID *catObjForFile,	/* IN catalog object of B+-tree file */
+    PageID   *root,		/* IN root Page IDentifier */
+    KeyDesc  *kdesc,		/* IN a key descriptor */
+    KeyValue *startKval,	/* IN key value of start condition */
+    Four     startCompOp,	/* IN comparison operator of start condition */
+    KeyValue *stopKval,		/* IN key value of stop condition */
+    Four     stopCompOp,	/* IN comparison operator of stop condition */
+    Pool     *dlPool,		/* INOUT pool of dealloc list elements */
+    DeallocListElem *dlHead) /* INOUT head of the dealloc list */
+{
+    int		i;
+    Four    e;			/* error number */
+    Four    cmp;		/* result of comparison */
+    Boolean lf;			/* flag for merging */
+    Boolean lh;			/* flag for splitting */
+    InternalItem item;		/* Internal item */
+    PhysicalFileID pFid;        /* B+-tree file's FileID */
+
+
+    /*@ check parameters */
+    if (catObjForFile == NULL) ERR(eBADPARAMETER_BTM);
+
+    if (root == NULL) ERR(eBADPARAMETER_BTM);
+
+    if (kdesc == NULL) ERR(eBADPARAMETER_BTM);
+
+    if (dlPool == NULL || dlHead == NULL) ERR(eBADPARAMETER_BTM);
+
+    if (startCompOp != SM_BOF && startCompOp != SM_GE && startCompOp != SM_GT) ERR(eBADCOMPOP_BTM);
+
+    if (stopCompOp != SM_EOF && stopCompOp != SM_LE && stopCompOp != SM_LT) ERR(eBADCOMPOP_BTM);
+
+    if ((startCompOp != SM_BOF && startKval == NULL) || (stopCompOp != SM_EOF && stopKval == NULL))
+        ERR(eBADPARAMETER_BTM);
+
+    /* Error check whether using not supported functionality by EduBtM */
+    for(i=0; i<kdesc->nparts; i++)
+    {
+        if(kdesc->kpart[i].type!=SM_INT && kdesc->kpart[i].type!=SM_VARSTRING)
+            ERR(eNOTSUPPORTED_EDUBTM);
+    }
+
+	/* The messages of a B-epsilon index may hold keys in the subtrees to be freed. */
+	if (kdesc->flag & KEYFLAG_BUFFERED) ERR(eNOTSUPPORTED_EDUBTM);
+
+	if (startCompOp == SM_BOF) startKval = NULL;
+	if (stopCompOp == SM_EOF) stopKval = NULL;
+
+	// An empty range deletes nothing.
+	if (startKval != NULL && stopKval != NULL)
+	{
+		cmp = edubtm_KeyCompare(kdesc, startKval, stopKval);
+		if (cmp == GREATER || (cmp == EQUAL && (startCompOp == SM_GT || stopCompOp == SM_LT)))
+			return(eNOERROR);
+	}
+
+	MAKE_PAGEID(pFid, catObjForFile->volNo, catObjForFile->pageNo);
+
+	e = edubtm_DeleteRange(&pFid, root, kdesc, startKval, startCompOp, stopKval, stopCompOp, dlPool, dlHead);
+	if (e < 0) ERR(e);
+
+	e = edubtm_RangeLinkLeaves(root, kdesc, startKval, stopKval);
+	if (e < 0) ERR(e);
+
+	// Repair the path to the start, and then the path to the stop.
+	for (i = 0; i < 2; i++)
+	{
+		if (i == 0)
+			e = edubtm_RangeRepair(catObjForFile, root, kdesc, startKval, FALSE, &lf, &lh, &item, dlPool, dlHead);
+		else
+			e = edubtm_RangeRepair(catObjForFile, root, kdesc, stopKval, TRUE, &lf, &lh, &item, dlPool, dlHead);
+		if (e < 0) ERR(e);
+
+		if (lh == TRUE)
+		{
+			e = edubtm_root_insert(catObjForFile, root, &item);
+			if (e < 0) ERR(e);
+		}
+		else if (lf == TRUE)
+		{
+			edubtm_TopCacheInvalidate(root);
+			e = btm_root_delete(&pFid, root, dlPool, dlHead);
+			if (e < 0) ERR(e);
+		}
+	}
+    
+    return(eNOERROR);
+    
+}   /* EduBtM_DeleteRange() */
@@ -63,6 +63,8 @@ Four EduBtM_DropIndex(
     Four e;			/* for the error number */
 
 
+	edubtm_TopCacheDrop(rootPid);
+
     /*@ Free all pages concerned with the root. */
 	e = edubtm_FreePages(pFid, rootPid, dlPool, dlHead);
 	if (e<0) ERR(e);
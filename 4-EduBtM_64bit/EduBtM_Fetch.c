@@ -47,6 +47,7 @@
 
 /*@ Internal Function Prototypes */
 Four edubtm_Fetch(PageID*, KeyDesc*, KeyValue*, Four, KeyValue*, Four, BtreeCursor*);
+Four edubtm_BufferedFetch(PageID*, KeyDesc*, KeyValue*, Four, KeyValue*, Four, BtreeCursor*);
 
 
 
@@ -70,6 +71,7 @@ Four edubtm_Fetch(PageID*, KeyDesc*, KeyValue*, Four, KeyValue*, Four, BtreeCurs
  * Side effects:
  *  cursor  : The found ObjectID and its position in the Btree Leaf
  *            (it may indicate a ObjectID in an  overflow page).
+ *            The included columns of a covering index are also returned.
  */
 Four EduBtM_Fetch(
     PageID   *root,		/* IN The current root of the subtree */
@@ -82,6 +84,7 @@ Four EduBtM_Fetch(
 {
     int i;
     Four e;		   /* error number */
+    PageID start;	   /* the page to start the search from */
 
     
     if (root == NULL) ERR(eBADPARAMETER_BTM);
@@ -93,13 +96,23 @@ Four EduBtM_Fetch(
             ERR(eNOTSUPPORTED_EDUBTM);
     }
 
-	if (startCompOp == SM_BOF)
+	edubtm_TraceBegin(BTM_TRACE_FETCH);
+	if (kdesc->flag & KEYFLAG_BUFFERED)
+		e = edubtm_BufferedFetch(root, kdesc, startKval, startCompOp, stopKval, stopCompOp, cursor);
+	else if (startCompOp == SM_BOF)
 		e = edubtm_FirstObject(root, kdesc, stopKval, stopCompOp, cursor);
 	else if (startCompOp == SM_EOF)
 		e = edubtm_LastObject(root, kdesc, stopKval, stopCompOp, cursor);
 	else
-		e = edubtm_Fetch(root, kdesc, startKval, startCompOp, stopKval, stopCompOp, cursor);
-    if (e < 0) ERR(e);
+	{
+		/* the cached top levels are passed without fixing their pages */
+		e = edubtm_TopCacheSearch(root, startKval, &start);
+		if (e < 0) ERRT(e, BTM_TRACE_FETCH);
+
+		e = edubtm_Fetch(&start, kdesc, startKval, startCompOp, stopKval, stopCompOp, cursor);
+	}
+    if (e < 0) ERRT(e, BTM_TRACE_FETCH);
+	edubtm_TraceEnd(BTM_TRACE_FETCH);
 
 
     return(eNOERROR);
@@ -166,7 +179,7 @@ Four edubtm_Fetch(
             ERR(eNOTSUPPORTED_EDUBTM);
     }
 
-	e = BfM_GetTrain(root, &apage, PAGE_BUF);
+	e = edubtm_GetTrain(root, &apage, PAGE_BUF);
 	if (e < 0) ERR(e);
 
 	/* If root page is internal page */
@@ -187,7 +200,9 @@ Four edubtm_Fetch(
 		}
 		
 		// Fetch a object from the child page.
+		edubtm_traceDepth++;
 		e = edubtm_Fetch(&child, kdesc, startKval, startCompOp, stopKval, stopCompOp, cursor);
+		edubtm_traceDepth--;
 		if (e < 0) ERR(e);
 		
 		e = BfM_FreeTrain(root, PAGE_BUF);
@@ -237,7 +252,6 @@ Four edubtm_Fetch(
 			{
 				MAKE_PAGEID(prevPid, root->volNo, apage->bl.hdr.prevPage);
 				leafPid = &prevPid;
-				idx = apage->bl.hdr.nSlots-1;
 			}
 			else
 			{
@@ -259,15 +273,19 @@ Four edubtm_Fetch(
 		}
 		e = BfM_FreeTrain(root, PAGE_BUF);
 		if (e < 0) ERR(e);
-		e = BfM_GetTrain(leafPid, &apage, PAGE_BUF);
+		e = edubtm_GetTrain(leafPid, &apage, PAGE_BUF);
 		if (e < 0) ERR(e);
 
+		// The last entry of the previous leaf.
+		if (leafPid == &prevPid) idx = apage->bl.hdr.nSlots-1;
+
 		if (cursor->flag != CURSOR_EOS)
 		{
 			lEntry = apage->bl.data + apage->bl.slot[-1*idx];
-			alignedKlen = ALIGNED_LENGTH(lEntry->klen);
-			memcpy(&cursor->oid, &lEntry->kval + alignedKlen, sizeof(ObjectID));
-			memcpy(&cursor->key, &lEntry->klen, sizeof(KeyValue));
+			edubtm_GetOid(&apage->bl, lEntry, &cursor->oid);
+			cursor->includedLen = apage->bl.hdr.reserved;
+			memcpy(cursor->included, BL_INCLUDED(&apage->bl, lEntry), cursor->includedLen);
+			BTM_COPY_KEY(&cursor->key, &lEntry->klen);
 			cursor->leaf = *leafPid;
 			cursor->slotNo = idx;
 
@@ -288,3 +306,70 @@ Four edubtm_Fetch(
     
 } /* edubtm_Fetch() */
 
+
+
+/*@================================
+ * edubtm_BufferedFetch()
+ *================================*/
+/*
+ * Function: Four edubtm_BufferedFetch(PageID*, KeyDesc*, KeyVlaue*, Four, KeyValue*, Four, BtreeCursor*)
+ *
+ * Description:
+ *  Find the first object satisfying the given condition in a B-epsilon
+ *  index. The messages in the internal pages are applied while searching;
+ *  they are not moved down, so the index is not changed.
+ *  The scan goes forward only; this function handles the following start
+ *  conditions: SM_BOF, SM_EQ, SM_GT, SM_GE.
+ *
+ * Returns:
+ *  Error code
+ *    eBADCOMPOP_BTM
+ *    some errors caused by function calls
+ */
+Four edubtm_BufferedFetch(
+    PageID              *root,          /* IN The current root of the subtree */
+    KeyDesc             *kdesc,         /* IN Btree key descriptor */
+    KeyValue            *startKval,     /* IN key value of start condition */
+    Four                startCompOp,    /* IN comparison operator of start condition */
+    KeyValue            *stopKval,      /* IN key value of stop condition */
+    Four                stopCompOp,     /* IN comparison operator of stop condition */
+    BtreeCursor         *cursor)        /* OUT Btree Cursor */
+{
+    Four                e;              /* error number */
+    Four                cmp;            /* result of comparison */
+    Boolean             found;          /* search result */
+
+
+	if (startCompOp == SM_BOF)
+		e = edubtm_BufferedNext(root, kdesc, NULL, TRUE, &found, &cursor->key, &cursor->oid);
+	else if (startCompOp == SM_GE || startCompOp == SM_GT)
+		e = edubtm_BufferedNext(root, kdesc, startKval, startCompOp == SM_GE, &found, &cursor->key, &cursor->oid);
+	else if (startCompOp == SM_EQ)
+	{
+		e = edubtm_BufferedLookup(root, kdesc, startKval, &found, &cursor->oid);
+		BTM_COPY_KEY(&cursor->key, startKval);
+	}
+	else
+		ERR(eBADCOMPOP_BTM);
+	if (e < 0) ERR(e);
+
+	cursor->flag = (found == TRUE) ? CURSOR_ON : CURSOR_EOS;
+	cursor->leaf = *root;
+	cursor->slotNo = NIL;
+	cursor->includedLen = 0;	/* the messages carry no included columns */
+
+	if (cursor->flag == CURSOR_ON && stopCompOp != SM_EOF)
+	{
+		cmp = edubtm_KeyCompare(kdesc, &cursor->key, stopKval);
+		if ((stopCompOp == SM_EQ && cmp != EQUAL) ||
+				(stopCompOp == SM_LT && cmp != LESS) ||
+				(stopCompOp == SM_LE && cmp == GREATER) ||
+				(stopCompOp == SM_GT && cmp != GREATER) ||
+				(stopCompOp == SM_GE && cmp == LESS))
+			cursor->flag = CURSOR_EOS;
+	}
+
+
+    return(eNOERROR);
+
+} /* edubtm_BufferedFetch() */
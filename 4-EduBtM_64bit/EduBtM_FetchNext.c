@@ -42,6 +42,7 @@
 
 /*@ Internal Function Prototypes */
 Four edubtm_FetchNext(KeyDesc*, KeyValue*, Four, BtreeCursor*, BtreeCursor*);
+Four edubtm_BufferedFetchNext(PageID*, KeyDesc*, KeyValue*, Four, BtreeCursor*, BtreeCursor*);
 
 
 
@@ -107,8 +108,13 @@ Four EduBtM_FetchNext(
             ERR(eNOTSUPPORTED_EDUBTM);
     }
 
-	e = edubtm_FetchNext(kdesc, kval, compOp, current, next);
-	if (e < 0) ERR(e);
+	edubtm_TraceBegin(BTM_TRACE_FETCHNEXT);
+	if (kdesc->flag & KEYFLAG_BUFFERED)
+		e = edubtm_BufferedFetchNext(root, kdesc, kval, compOp, current, next);
+	else
+		e = edubtm_FetchNext(kdesc, kval, compOp, current, next);
+	if (e < 0) ERRT(e, BTM_TRACE_FETCHNEXT);
+	edubtm_TraceEnd(BTM_TRACE_FETCHNEXT);
 
     
     return(eNOERROR);
@@ -168,7 +174,7 @@ Four edubtm_FetchNext(
 	nextLeaf = curLeaf;
 	next->flag = CURSOR_ON;
 
-	e = BfM_GetTrain(&curLeaf, &apage, PAGE_BUF);	
+	e = edubtm_GetTrain(&curLeaf, &apage, PAGE_BUF);	
 	if (e < 0) ERR(e);
 
 	// Decide next leaf index.
@@ -186,7 +192,7 @@ Four edubtm_FetchNext(
 			MAKE_PAGEID(nextLeaf, curLeaf.volNo, apage->hdr.prevPage);
 			e = BfM_FreeTrain(&curLeaf, PAGE_BUF);
 			if (e < 0) ERR(e);
-			e = BfM_GetTrain(&nextLeaf, &apage, PAGE_BUF);
+			e = edubtm_GetTrain(&nextLeaf, &apage, PAGE_BUF);
 			if (e < 0) ERR(e);
 			idx = apage->hdr.nSlots-1;
 		}
@@ -202,7 +208,7 @@ Four edubtm_FetchNext(
 			MAKE_PAGEID(nextLeaf, curLeaf.volNo, apage->hdr.nextPage);
 			e = BfM_FreeTrain(&curLeaf, PAGE_BUF);
 			if (e < 0) ERR(e);
-			e = BfM_GetTrain(&nextLeaf, &apage, PAGE_BUF);
+			e = edubtm_GetTrain(&nextLeaf, &apage, PAGE_BUF);
 			if (e < 0) ERR(e);
 			idx = 0;
 		}
@@ -215,7 +221,7 @@ Four edubtm_FetchNext(
 	{
 		e = BfM_FreeTrain(&curLeaf, PAGE_BUF);
 		if (e < 0) ERR(e);
-		e = BfM_GetTrain(&nextLeaf, &apage, PAGE_BUF);
+		e = edubtm_GetTrain(&nextLeaf, &apage, PAGE_BUF);
 		if (e < 0) ERR(e);
 	}
 
@@ -228,9 +234,10 @@ Four edubtm_FetchNext(
 	{
 		// Make next cursor.
 		entry = apage->data + apage->slot[-1*idx];
-		alignedKlen = ALIGNED_LENGTH(entry->klen);
-		memcpy(&next->oid, &entry->kval + alignedKlen, sizeof(ObjectID));
-		memcpy(&next->key, &entry->klen, sizeof(KeyValue));
+		edubtm_GetOid(apage, entry, &next->oid);
+		next->includedLen = apage->hdr.reserved;
+		memcpy(next->included, BL_INCLUDED(apage, entry), next->includedLen);
+		BTM_COPY_KEY(&next->key, &entry->klen);
 		next->leaf = nextLeaf;
 		next->slotNo = idx;
 
@@ -249,3 +256,71 @@ Four edubtm_FetchNext(
     return(eNOERROR);
     
 } /* edubtm_FetchNext() */
+
+
+
+/*@================================
+ * edubtm_BufferedFetchNext()
+ *================================*/
+/*
+ * Function: Four edubtm_BufferedFetchNext(PageID*, KeyDesc*, KeyValue*, Four,
+ *                                      BtreeCursor*, BtreeCursor*)
+ *
+ * Description:
+ *  Get the next item of a B-epsilon index, i.e., the smallest key greater
+ *  than the key of the current cursor. The cursor keeps no position in a
+ *  leaf because the messages may move down between the calls.
+ *
+ * Returns:
+ *  Error code
+ *    eBADCOMPOP_BTM
+ *    some errors caused by function calls
+ */
+Four edubtm_BufferedFetchNext(
+    PageID              *root,          /* IN root page's PageID */
+    KeyDesc             *kdesc,         /* IN key descriptor */
+    KeyValue            *kval,          /* IN key value of stop condition */
+    Four                compOp,         /* IN comparison operator of stop condition */
+    BtreeCursor         *current,       /* IN current cursor */
+    BtreeCursor         *next)          /* OUT next cursor */
+{
+    Four                e;              /* error number */
+    Four                cmp;            /* comparison result */
+    Boolean             found;          /* search result */
+
+
+	/* copy only the used bytes of the key instead of the whole cursor */
+	next->flag = current->flag;
+	next->leaf = current->leaf;
+	next->overflow = current->overflow;
+	next->slotNo = current->slotNo;
+	next->oidArrayElemNo = current->oidArrayElemNo;
+	next->includedLen = 0;
+	next->oid = current->oid;
+	BTM_COPY_KEY(&next->key, &current->key);
+
+	// Each key has one ObjectID, so an equality scan has no next item.
+	if (compOp == SM_EQ)
+	{
+		next->flag = CURSOR_EOS;
+		return(eNOERROR);
+	}
+	if (compOp != SM_LT && compOp != SM_LE && compOp != SM_EOF)
+		ERR(eBADCOMPOP_BTM);
+
+	e = edubtm_BufferedNext(root, kdesc, &current->key, FALSE, &found, &next->key, &next->oid);
+	if (e < 0) ERR(e);
+
+	next->flag = (found == TRUE) ? CURSOR_ON : CURSOR_EOS;
+
+	if (next->flag == CURSOR_ON && compOp != SM_EOF)
+	{
+		cmp = edubtm_KeyCompare(kdesc, &next->key, kval);
+		if ((compOp == SM_LT && cmp != LESS) || (compOp == SM_LE && cmp == GREATER))
+			next->flag = CURSOR_EOS;
+	}
+
+
+    return(eNOERROR);
+
+} /* edubtm_BufferedFetchNext() */
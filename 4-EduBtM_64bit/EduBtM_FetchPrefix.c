@@ -0,0 +1,209 @@
+/******************************************************************************/
+/*                                                                            */
+/*    ODYSSEUS/EduCOSMOS Educational-Purpose Object Storage System            */
+/*                                                                            */
+/*    Developed by Professor Kyu-Young Whang et al.                           */
+/*                                                                            */
+/*    Database and Multimedia Laboratory                                      */
+/*                                                                            */
+/*    Computer Science Department and                                         */
+/*    Advanced Information Technology Research Center (AITrc)                 */
+/*    Korea Advanced Institute of Science and Technology (KAIST)              */
+/*                                                                            */
+/*    e-mail: kywhang@cs.kaist.ac.kr                                          */
+/*    phone: +82-42-350-7722                                                  */
+/*    fax: +82-42-350-8380                                                    */
+/*                                                                            */
+/*    Copyright (c) 1995-2013 by Kyu-Young Whang                              */
+/*                                                                            */
+/*    All rights reserved. No part of this software may be reproduced,        */
+/*    stored in a retrieval system, or transmitted, in any form or by any     */
+/*    means, electronic, mechanical, photocopying, recording, or otherwise,   */
+/*    without prior written permission of the copyright owner.                */
+/*                                                                            */
+/******************************************************************************/
+/*
+ * Module: EduBtM_FetchPrefix.c
+ *
+ * Description:
+ *  Scan a B+ tree of a multi-part key by the first k parts of the key. The
+ *  conditions are those of EduBtM_Fetch() and EduBtM_FetchNext(), but the
+ *  key values of the conditions hold only the first k parts, and only those
+ *  parts of the keys in the index are compared; e.g., SM_EQ gives all the
+ *  entries having the given first k parts.
+ *
+ * Exports:
+ *  Four EduBtM_FetchPrefix(PageID*, KeyDesc*, Two, KeyValue*, Four, KeyValue*, Four, BtreeCursor*)
+ *  Four EduBtM_FetchNextPrefix(PageID*, KeyDesc*, Two, KeyValue*, Four, BtreeCursor*, BtreeCursor*)
+ */
+
+
+#include "EduBtM_common.h"
+#include "BfM.h"
+#include "EduBtM_Internal.h"
+
+
+/*@ Internal Function Prototypes */
+Four edubtm_FetchNext(KeyDesc*, KeyValue*, Four, BtreeCursor*, BtreeCursor*);
+
+
+
+/*@================================
+ * EduBtM_FetchPrefix()
+ *================================*/
+/*
+ * Function: Four EduBtM_FetchPrefix(PageID*, KeyDesc*, Two, KeyValue*, Four,
+ *                                   KeyValue*, Four, BtreeCursor*)
+ *
+ * Description:
+ *  Find the first object satisfying the given condition on the first
+ *  'nparts' parts of the key. See above for detail.
+ *
+ * Returns:
+ *  error code
+ *    eBADPARAMETER_BTM
+ *    eBADCOMPOP_BTM
+ *    eNOTSUPPORTED_EDUBTM
+ *    some errors caused by function calls
+ *
+ * Side effects:
+ *  cursor  : The found ObjectID and its position in the Btree Leaf
+ */
+Four EduBtM_FetchPrefix(
+    PageID   *root,		/* IN The current root of the subtree */
+    KeyDesc  *kdesc,		/* IN Btree key descriptor */
+    Two      nparts,		/* IN # of the compared key parts */
+    KeyValue *startKval,	/* IN key value of start condition */
+    Four     startCompOp,	/* IN comparison operator of start condition */
+    KeyValue *stopKval,		/* IN key value of stop condition */
+    Four     stopCompOp,	/* IN comparison operator of stop condition */
+    BtreeCursor *cursor)	/* OUT Btree Cursor */
+{
+    int i;
+    Four e;		   /* error number */
+    Four cmp;		   /* result of comparison */
+    KeyDesc pdesc;	   /* key descriptor of the compared parts */
+
+
+    if (root == NULL || kdesc == NULL || cursor == NULL) ERR(eBADPARAMETER_BTM);
+    if (nparts < 1 || nparts > kdesc->nparts) ERR(eBADPARAMETER_BTM);
+    if (startCompOp != SM_BOF && startCompOp != SM_EOF && startKval == NULL) ERR(eBADPARAMETER_BTM);
+    if (stopCompOp != SM_BOF && stopCompOp != SM_EOF && stopKval == NULL) ERR(eBADPARAMETER_BTM);
+
+    /* Error check whether using not supported functionality by EduBtM */
+    for(i=0; i<kdesc->nparts; i++)
+    {
+        if(kdesc->kpart[i].type!=SM_INT && kdesc->kpart[i].type!=SM_VARSTRING)
+            ERR(eNOTSUPPORTED_EDUBTM);
+    }
+
+	/* The messages of a B-epsilon index are searched by whole keys. */
+	if (kdesc->flag & KEYFLAG_BUFFERED) ERR(eNOTSUPPORTED_EDUBTM);
+
+	pdesc = *kdesc;
+	pdesc.nparts = nparts;
+
+	switch (startCompOp)
+	{
+	  case SM_BOF:
+		e = edubtm_FirstObject(root, &pdesc, stopKval, stopCompOp, cursor);
+		break;
+
+	  case SM_EOF:
+		e = edubtm_LastObject(root, &pdesc, stopKval, stopCompOp, cursor);
+		break;
+
+	  case SM_EQ:
+		e = edubtm_SeekPrefix(root, &pdesc, startKval, SM_GE, cursor);
+		if (e >= 0 && cursor->flag == CURSOR_ON &&
+		    edubtm_KeyCompare(&pdesc, &cursor->key, startKval) != EQUAL)
+			cursor->flag = CURSOR_EOS;
+		break;
+
+	  case SM_GE:
+	  case SM_GT:
+	  case SM_LE:
+	  case SM_LT:
+		e = edubtm_SeekPrefix(root, &pdesc, startKval, startCompOp, cursor);
+		break;
+
+	  default:
+		ERR(eBADCOMPOP_BTM);
+	}
+	if (e < 0) ERR(e);
+
+	if (cursor->flag == CURSOR_ON && stopCompOp != SM_EOF && stopCompOp != SM_BOF)
+	{
+		cmp = edubtm_KeyCompare(&pdesc, &cursor->key, stopKval);
+		if ((stopCompOp == SM_EQ && cmp != EQUAL) ||
+				(stopCompOp == SM_LT && cmp != LESS) ||
+				(stopCompOp == SM_LE && cmp == GREATER) ||
+				(stopCompOp == SM_GT && cmp != GREATER) ||
+				(stopCompOp == SM_GE && cmp == LESS))
+			cursor->flag = CURSOR_EOS;
+	}
+
+
+    return(eNOERROR);
+
+} /* EduBtM_FetchPrefix() */
+
+
+
+/*@================================
+ * EduBtM_FetchNextPrefix()
+ *================================*/
+/*
+ * Function: Four EduBtM_FetchNextPrefix(PageID*, KeyDesc*, Two, KeyValue*, Four,
+ *                                       BtreeCursor*, BtreeCursor*)
+ *
+ * Description:
+ *  Fetch the next ObjectID satisfying the given condition on the first
+ *  'nparts' parts of the key. Unlike EduBtM_FetchNext(), SM_EQ scans
+ *  forward over the entries having the same first parts.
+ *
+ * Returns:
+ *  error code
+ *    eBADPARAMETER_BTM
+ *    eBADCURSOR
+ *    eNOTSUPPORTED_EDUBTM
+ *    some errors caused by function calls
+ */
+Four EduBtM_FetchNextPrefix(
+    PageID                      *root,          /* IN root page's PageID */
+    KeyDesc                     *kdesc,         /* IN key descriptor */
+    Two                         nparts,         /* IN # of the compared key parts */
+    KeyValue                    *kval,          /* IN key value of stop condition */
+    Four                        compOp,         /* IN comparison operator of stop condition */
+    BtreeCursor                 *current,       /* IN current B+ tree cursor */
+    BtreeCursor                 *next)          /* OUT next B+ tree cursor */
+{
+    Four                        e;              /* error number */
+    KeyDesc                     pdesc;          /* key descriptor of the compared parts */
+
+
+    if (root == NULL || kdesc == NULL || kval == NULL || current == NULL || next == NULL)
+		ERR(eBADPARAMETER_BTM);
+    if (nparts < 1 || nparts > kdesc->nparts) ERR(eBADPARAMETER_BTM);
+
+    /* Is the current cursor valid? */
+    if (current->flag != CURSOR_ON && current->flag != CURSOR_EOS)
+		ERR(eBADCURSOR);
+
+    if (current->flag == CURSOR_EOS) return(eNOERROR);
+
+	if (kdesc->flag & KEYFLAG_BUFFERED) ERR(eNOTSUPPORTED_EDUBTM);
+
+	pdesc = *kdesc;
+	pdesc.nparts = nparts;
+
+	/* The scan starts at the first equal entry, so it stops after the last one. */
+	if (compOp == SM_EQ) compOp = SM_LE;
+
+	e = edubtm_FetchNext(&pdesc, kval, compOp, current, next);
+	if (e < 0) ERR(e);
+
+
+    return(eNOERROR);
+
+} /* EduBtM_FetchNextPrefix() */
@@ -0,0 +1,424 @@
+/******************************************************************************/
+/*                                                                            */
+/*    ODYSSEUS/EduCOSMOS Educational-Purpose Object Storage System            */
+/*                                                                            */
+/*    Developed by Professor Kyu-Young Whang et al.                           */
+/*                                                                            */
+/*    Database and Multimedia Laboratory                                      */
+/*                                                                            */
+/*    Computer Science Department and                                         */
+/*    Advanced Information Technology Research Center (AITrc)                 */
+/*    Korea Advanced Institute of Science and Technology (KAIST)              */
+/*                                                                            */
+/*    e-mail: kywhang@cs.kaist.ac.kr                                          */
+/*    phone: +82-42-350-7722                                                  */
+/*    fax: +82-42-350-8380                                                    */
+/*                                                                            */
+/*    Copyright (c) 1995-2013 by Kyu-Young Whang                              */
+/*                                                                            */
+/*    All rights reserved. No part of this software may be reproduced,        */
+/*    stored in a retrieval system, or transmitted, in any form or by any     */
+/*    means, electronic, mechanical, photocopying, recording, or otherwise,   */
+/*    without prior written permission of the copyright owner.                */
+/*                                                                            */
+/******************************************************************************/
+/*
+ * Module: EduBtM_GetStats.c
+ *
+ * Description :
+ *  Collect the statistics of a B+ tree for the cost estimation: the height,
+ *  the page counts and the fill factors of the levels, the estimated
+ *  numbers of the keys and an equi-depth key histogram.
+ *
+ *  The internal levels are visited completely; they are small compared
+ *  with the leaf level. The leaf level is not scanned: the number of leaves
+ *  comes from the lowest internal level, and the rest is estimated from
+ *  BTM_STATS_NSAMPLES random descents from the root. A descent choosing a
+ *  child uniformly at random reaches a leaf with the probability of
+ *  1/(product of the fan-outs on the path), so each sample is weighted by
+ *  that product to make the estimates unbiased.
+ *
+ * Exports:
+ *  Four EduBtM_GetStats(PageID*, KeyDesc*, BtreeStats*)
+ */
+
+
+#include <stdlib.h>
+#include <string.h>
+#include "EduBtM_common.h"
+#include "BfM.h"
+#include "EduBtM_Internal.h"
+
+
+/* a key sampled from a leaf and the estimated # of keys it represents */
+typedef struct {
+    double   weight;
+    KeyValue key;
+} btm_StatsSample;
+
+
+/*@ Internal Function Prototypes */
+Four edubtm_StatsWalk(PageID*, Two, BtreeStats*);
+Four edubtm_StatsSample(PageID*, KeyDesc*, BtreeStats*, btm_StatsSample*, double*, double*);
+void edubtm_StatsHistogram(KeyDesc*, BtreeStats*, btm_StatsSample*, Four);
+void edubtm_StatsFill(BtreeStats*, Two, double);
+
+
+
+/*@================================
+ * EduBtM_GetStats()
+ *================================*/
+/*
+ * Function: Four EduBtM_GetStats(PageID*, KeyDesc*, BtreeStats*)
+ *
+ * Description :
+ *  Fill 'stats' with the statistics of the B+ tree given by 'root'. The
+ *  fill factors of the leaf level, the numbers of the keys, the number of
+ *  the overflow pages and the histogram are estimated by sampling; the
+ *  others are exact. The messages in the internal pages of a B-epsilon
+ *  index are not counted.
+ *
+ * Returns:
+ *  error code
+ *    eBADPARAMETER_BTM
+ *    eMEMORYALLOCERR_BTM
+ *    some errors caused by function calls
+ */
+Four EduBtM_GetStats(
+    PageID              *root,          /* IN root page of the B+ tree */
+    KeyDesc             *kdesc,         /* IN a key descriptor */
+    BtreeStats          *stats)         /* OUT statistics */
+{
+    Four                e;              /* error number */
+    Two                 i;              /* index */
+    PageID              pid;            /* a page on the leftmost path */
+    BtreePage           *apage;         /* buffer of 'pid' */
+    ShortPageID         p0;             /* the first child */
+    btm_StatsSample     *samples;       /* sampled keys */
+    double              sumW;           /* sum of the weights of the samples */
+    double              nObjects;       /* weighted sum of # of ObjectIDs in the sampled leaves */
+
+
+    /*@ check parameters */
+    if (root == NULL || kdesc == NULL || stats == NULL) ERR(eBADPARAMETER_BTM);
+
+    /* Error check whether using not supported functionality by EduBtM */
+    for (i=0; i<kdesc->nparts; i++)
+    {
+        if (kdesc->kpart[i].type!=SM_INT && kdesc->kpart[i].type!=SM_VARSTRING)
+            ERR(eNOTSUPPORTED_EDUBTM);
+    }
+
+	memset(stats, 0, sizeof(BtreeStats));
+	for (i = 0; i < BTM_STATS_MAXLEVELS; i++)
+		stats->minFill[i] = 1.0;
+
+	// The height is the length of the leftmost path.
+	pid = *root;
+	for (;;)
+	{
+		e = edubtm_GetTrain(&pid, &apage, PAGE_BUF);
+		if (e < 0) ERR(e);
+
+		stats->height++;
+		if (apage->any.hdr.type & LEAF)
+		{
+			e = BfM_FreeTrain(&pid, PAGE_BUF);
+			if (e < 0) ERR(e);
+			break;
+		}
+
+		p0 = apage->bi.hdr.p0;
+		e = BfM_FreeTrain(&pid, PAGE_BUF);
+		if (e < 0) ERR(e);
+		MAKE_PAGEID(pid, root->volNo, p0);
+	}
+	if (stats->height > BTM_STATS_MAXLEVELS) ERR(eBADBTREEPAGE_BTM);
+
+	// Visit the internal levels.
+	if (stats->height > 1)
+	{
+		e = edubtm_StatsWalk(root, 0, stats);
+		if (e < 0) ERR(e);
+	}
+	else
+		stats->nPages[0] = 1;
+
+	for (i = 0; i < stats->height-1; i++)
+		stats->avgFill[i] /= stats->nPages[i];
+
+	// Estimate the leaf level by the sampled descents.
+	samples = (btm_StatsSample*)malloc(sizeof(btm_StatsSample) * BTM_STATS_NSAMPLES);
+	if (samples == NULL) ERR(eMEMORYALLOCERR_BTM);
+
+	e = edubtm_StatsSample(root, kdesc, stats, samples, &sumW, &nObjects);
+	if (e < 0) { free(samples); ERR(e); }
+
+	stats->nObjects = (Four)(nObjects / BTM_STATS_NSAMPLES + 0.5);
+	edubtm_StatsHistogram(kdesc, stats, samples, BTM_STATS_NSAMPLES);
+	stats->avgFill[stats->height-1] = (sumW > 0) ? stats->avgFill[stats->height-1] / sumW : 0;
+	if (stats->minFill[stats->height-1] > stats->maxFill[stats->height-1])
+		stats->minFill[stats->height-1] = stats->maxFill[stats->height-1];
+
+	free(samples);
+
+	return(eNOERROR);
+
+} /* EduBtM_GetStats() */
+
+
+
+/*@================================
+ * edubtm_StatsWalk()
+ *================================*/
+/*
+ * Function: Four edubtm_StatsWalk(PageID*, Two, BtreeStats*)
+ *
+ * Description:
+ *  Count the internal page at 'level' and its internal descendants. The
+ *  pages of the leaf level are counted from the lowest internal level.
+ *
+ * Returns:
+ *  error code
+ *    some errors caused by function calls
+ */
+Four edubtm_StatsWalk(
+    PageID              *pid,           /* IN an internal page */
+    Two                 level,          /* IN level of the page */
+    BtreeStats          *stats)         /* INOUT statistics */
+{
+    Four                e;              /* error number */
+    Two                 i;              /* slot No. */
+    PageID              child;          /* a child page */
+    BtreeInternal       *apage;         /* buffer of the page */
+    btm_InternalEntry   *iEntry;        /* an internal entry */
+
+
+	e = edubtm_GetTrain(pid, &apage, PAGE_BUF);
+	if (e < 0) ERR(e);
+
+	stats->nPages[level]++;
+	edubtm_StatsFill(stats, level, (double)BI_USED(apage) / (BI_USED(apage) + (Four)BI_FREE(apage)));
+	stats->avgFill[level] += (double)BI_USED(apage) / (BI_USED(apage) + (Four)BI_FREE(apage));
+
+	if (level+2 == stats->height)
+		stats->nPages[level+1] += apage->hdr.nSlots + 1;
+	else
+	{
+		for (i = -1; i < apage->hdr.nSlots; i++)
+		{
+			if (i < 0)
+				MAKE_PAGEID(child, pid->volNo, apage->hdr.p0);
+			else
+			{
+				iEntry = (btm_InternalEntry*)&(apage->data[apage->slot[-1*i]]);
+				MAKE_PAGEID(child, pid->volNo, iEntry->spid);
+			}
+
+			e = edubtm_StatsWalk(&child, level+1, stats);
+			if (e < 0) ERRB1(e, pid, PAGE_BUF);
+		}
+	}
+
+	e = BfM_FreeTrain(pid, PAGE_BUF);
+	if (e < 0) ERR(e);
+
+	return(eNOERROR);
+
+} /* edubtm_StatsWalk() */
+
+
+
+/*@================================
+ * edubtm_StatsSample()
+ *================================*/
+/*
+ * Function: Four edubtm_StatsSample(PageID*, KeyDesc*, BtreeStats*, btm_StatsSample*,
+ *                                   double*, double*)
+ *
+ * Description:
+ *  Descend BTM_STATS_NSAMPLES times from the root choosing a random child,
+ *  and take a random key of each leaf reached. The weight of a leaf is the
+ *  product of the fan-outs on the path; the weight of its key is that times
+ *  the # of keys in the leaf.
+ *
+ * Returns:
+ *  error code
+ *    some errors caused by function calls
+ *
+ * Side effects:
+ *  sumW     : sum of the weights of the leaves
+ *  nObjects : weighted sum of the # of ObjectIDs in the leaves
+ */
+Four edubtm_StatsSample(
+    PageID              *root,          /* IN root page */
+    KeyDesc             *kdesc,         /* IN a key descriptor */
+    BtreeStats          *stats,         /* INOUT statistics */
+    btm_StatsSample     *samples,       /* OUT sampled keys */
+    double              *sumW,          /* OUT sum of the weights of the leaves */
+    double              *nObjects)      /* OUT weighted sum of # of ObjectIDs */
+{
+    Four                e;              /* error number */
+    Four                s;              /* sample No. */
+    Two                 i;              /* slot No. */
+    Two                 level;          /* level of the page */
+    double              w;              /* weight of the path */
+    double              fill;           /* used fraction of the leaf */
+    double              overflow;       /* # of overflow pages of the leaf */
+    double              objs;           /* # of ObjectIDs of the leaf */
+    PageID              pid;            /* a page on the path */
+    PageID              child;          /* the chosen child */
+    BtreePage           *apage;         /* buffer of 'pid' */
+    btm_InternalEntry   *iEntry;        /* an internal entry */
+    btm_LeafEntry       *lEntry;        /* a leaf entry */
+    unsigned int        seed;           /* state of the random numbers */
+
+
+	/* a generator of its own leaves the caller's rand() sequence alone
+	   and makes the samples the same on every call */
+	seed = 1;
+
+	level = stats->height-1;
+	*sumW = *nObjects = 0;
+
+	for (s = 0; s < BTM_STATS_NSAMPLES; s++)
+	{
+		pid = *root;
+		w = 1;
+		for (;;)
+		{
+			e = edubtm_GetTrain(&pid, &apage, PAGE_BUF);
+			if (e < 0) ERR(e);
+
+			if (apage->any.hdr.type & LEAF) break;
+
+			i = rand_r(&seed) % (apage->bi.hdr.nSlots + 1) - 1;
+			w *= apage->bi.hdr.nSlots + 1;
+			if (i < 0)
+				MAKE_PAGEID(child, pid.volNo, apage->bi.hdr.p0);
+			else
+			{
+				iEntry = (btm_InternalEntry*)&(apage->bi.data[apage->bi.slot[-1*i]]);
+				MAKE_PAGEID(child, pid.volNo, iEntry->spid);
+			}
+
+			e = BfM_FreeTrain(&pid, PAGE_BUF);
+			if (e < 0) ERR(e);
+			pid = child;
+		}
+
+		fill = (double)BL_USED(&apage->bl) / (BL_USED(&apage->bl) + (Four)BL_FREE(&apage->bl));
+		edubtm_StatsFill(stats, level, fill);
+		stats->avgFill[level] += w * fill;
+		*sumW += w;
+
+		// EduBtM keeps one ObjectID in an entry; more ObjectIDs go to overflow pages.
+		objs = overflow = 0;
+		for (i = 0; i < apage->bl.hdr.nSlots; i++)
+		{
+			lEntry = (btm_LeafEntry*)&(apage->bl.data[apage->bl.slot[-1*i]]);
+			objs += lEntry->nObjects;
+			if (lEntry->nObjects > 1)
+				overflow += (lEntry->nObjects + NO_OF_OBJECTS - 1) / NO_OF_OBJECTS;
+		}
+		*nObjects += w * objs;
+		stats->nOverflowPages += (Four)(w * overflow / BTM_STATS_NSAMPLES + 0.5);
+
+		samples[s].weight = w * apage->bl.hdr.nSlots;
+		samples[s].key.len = 0;
+		if (apage->bl.hdr.nSlots > 0)
+		{
+			lEntry = (btm_LeafEntry*)&(apage->bl.data[apage->bl.slot[-1*(rand_r(&seed) % apage->bl.hdr.nSlots)]]);
+			memcpy(&samples[s].key, &lEntry->klen, sizeof(Two) + lEntry->klen);
+		}
+
+		e = BfM_FreeTrain(&pid, PAGE_BUF);
+		if (e < 0) ERR(e);
+	}
+
+	return(eNOERROR);
+
+} /* edubtm_StatsSample() */
+
+
+
+/*@================================
+ * edubtm_StatsHistogram()
+ *================================*/
+/*
+ * Function: void edubtm_StatsHistogram(KeyDesc*, BtreeStats*, btm_StatsSample*, Four)
+ *
+ * Description:
+ *  Estimate the # of distinct keys, sort the sampled keys, and cut them
+ *  into BTM_STATS_NBUCKETS buckets of the same total weight.
+ *
+ * Returns:
+ *  None
+ */
+void edubtm_StatsHistogram(
+    KeyDesc             *kdesc,         /* IN a key descriptor */
+    BtreeStats          *stats,         /* INOUT statistics */
+    btm_StatsSample     *samples,       /* INOUT sampled keys */
+    Four                n)              /* IN # of samples */
+{
+    Four                i, j;           /* indexes */
+    Four                m = 0;          /* # of samples with a key */
+    double              total = 0;      /* total weight */
+    double              cum = 0;        /* cumulative weight */
+    double              prev = 0;       /* cumulative weight at the previous bound */
+    btm_StatsSample     tmp;            /* for sorting */
+
+
+	// Drop the empty leaves and sort the keys by insertion sort.
+	for (i = 0; i < n; i++)
+	{
+		if (samples[i].weight <= 0) continue;
+		total += samples[i].weight;
+		tmp = samples[i];
+		for (j = m; j > 0 && edubtm_KeyCompare(kdesc, &samples[j-1].key, &tmp.key) == GREATER; j--)
+			samples[j] = samples[j-1];
+		samples[j] = tmp;
+		m++;
+	}
+
+	stats->nDistinctKeys = (Four)(total / n + 0.5);
+	if (m == 0) return;
+
+	for (i = 0; i < m; i++)
+	{
+		cum += samples[i].weight;
+		if (i == m-1 || cum * BTM_STATS_NBUCKETS >= total * (stats->nBuckets + 1))
+		{
+			stats->bound[stats->nBuckets] = samples[i].key;
+			stats->depth[stats->nBuckets] = (Four)((cum - prev) / n + 0.5);
+			stats->nBuckets++;
+			prev = cum;
+			if (stats->nBuckets == BTM_STATS_NBUCKETS) break;
+		}
+	}
+
+} /* edubtm_StatsHistogram() */
+
+
+
+/*@================================
+ * edubtm_StatsFill()
+ *================================*/
+/*
+ * Function: void edubtm_StatsFill(BtreeStats*, Two, double)
+ *
+ * Description:
+ *  Update the minimum and the maximum fill of the level.
+ *
+ * Returns:
+ *  None
+ */
+void edubtm_StatsFill(
+    BtreeStats          *stats,         /* INOUT statistics */
+    Two                 level,          /* IN level of the page */
+    double              fill)           /* IN used fraction of the page */
+{
+	if (fill < stats->minFill[level]) stats->minFill[level] = fill;
+	if (fill > stats->maxFill[level]) stats->maxFill[level] = fill;
+
+} /* edubtm_StatsFill() */
@@ -0,0 +1,175 @@
+/******************************************************************************/
+/*                                                                            */
+/*    ODYSSEUS/EduCOSMOS Educational-Purpose Object Storage System            */
+/*                                                                            */
+/*    Developed by Professor Kyu-Young Whang et al.                           */
+/*                                                                            */
+/*    Database and Multimedia Laboratory                                      */
+/*                                                                            */
+/*    Computer Science Department and                                         */
+/*    Advanced Information Technology Research Center (AITrc)                 */
+/*    Korea Advanced Institute of Science and Technology (KAIST)              */
+/*                                                                            */
+/*    e-mail: kywhang@cs.kaist.ac.kr                                          */
+/*    phone: +82-42-350-7722                                                  */
+/*    fax: +82-42-350-8380                                                    */
+/*                                                                            */
+/*    Copyright (c) 1995-2013 by Kyu-Young Whang                              */
+/*                                                                            */
+/*    All rights reserved. No part of this software may be reproduced,        */
+/*    stored in a retrieval system, or transmitted, in any form or by any     */
+/*    means, electronic, mechanical, photocopying, recording, or otherwise,   */
+/*    without prior written permission of the copyright owner.                */
+/*                                                                            */
+/******************************************************************************/
+/*
+ * Module: EduBtM_InsertBatch.c
+ *
+ * Description :
+ *  Insert a batch of (key, ObjectID) pairs into a B+ tree index at once.
+ *
+ * Exports:
+ *  Four EduBtM_InsertBatch(ObjectID*, PageID*, KeyDesc*, BtreeBatchItem*, Four, Pool*, DeallocListElem*)
+ */
+
+
+#include <stdlib.h>
+#include "EduBtM_common.h"
+#include "BfM.h"
+#include "EduBtM_Internal.h"
+#include "EduBtM.h"
+
+
+
+/*@================================
+ * EduBtM_InsertBatch()
+ *================================*/
+/*
+ * Function: Four EduBtM_InsertBatch(ObjectID*, PageID*, KeyDesc*, BtreeBatchItem*, Four,
+ *                                   Pool*, DeallocListElem*)
+ *
+ * Description:
+ *  Insert the 'n' pairs of 'pairs' into the B+ tree index. The pairs are
+ *  sorted by the key values first, and then the tree is traversed once:
+ *  each leaf takes all the pairs falling into it together and is split
+ *  only once even if it needs several new pages, and the separators of
+ *  the new pages go up into their parent together.
+ *
+ * Returns:
+ *  error code
+ *    eBADPARAMETER_BTM
+ *    eDUPLICATEDKEY_BTM
+ *    eDUPLICATEDOBJECTID_BTM
+ *    eMEMORYALLOCERR_BTM
+ *    some errors caused by function calls
+ *
+ * Note:
+ *  Two pairs with the same key in the batch are rejected before the index
+ *  is changed. A key which is already in the index is detected when its
+ *  leaf is reached, so the pairs with the smaller keys may have been
+ *  inserted by then.
+ *  A B-epsilon index inserts the pairs one by one in the key order.
+ */
+Four EduBtM_InsertBatch(
+    ObjectID            *catObjForFile, /* IN catalog object of B+ tree file */
+    PageID              *root,          /* IN the root of Btree */
+    KeyDesc             *kdesc,         /* IN key descriptor */
+    BtreeBatchItem      *pairs,         /* IN the pairs to insert */
+    Four                n,              /* IN # of pairs */
+    Pool                *dlPool,        /* INOUT pool of dealloc list */
+    DeallocListElem     *dlHead)        /* INOUT head of the dealloc list */
+{
+    int                 i;
+    Four                e;              /* error number */
+    Four                *order;         /* indexes of the pairs in key order */
+    InternalItem        *items;         /* items of the pages split off from the root */
+    Four                nItems;         /* # of 'items' */
+    InternalItem        *moreItems;     /* items of the pages split off from the new root */
+    Four                nMoreItems;     /* # of 'moreItems' */
+    BtreeInternal       *rpage;         /* buffer of the new root */
+
+
+    /*@ check parameters */
+
+    if (catObjForFile == NULL) ERR(eBADPARAMETER_BTM);
+
+    if (root == NULL) ERR(eBADPARAMETER_BTM);
+
+    if (kdesc == NULL) ERR(eBADPARAMETER_BTM);
+
+    if (pairs == NULL || n < 0) ERR(eBADPARAMETER_BTM);
+
+    if (n == 0) return(eNOERROR);
+
+    /* Error check whether using not supported functionality by EduBtM */
+    for(i=0; i<kdesc->nparts; i++)
+    {
+        if(kdesc->kpart[i].type!=SM_INT && kdesc->kpart[i].type!=SM_VARSTRING)
+            ERR(eNOTSUPPORTED_EDUBTM);
+    }
+
+	order = (Four*)malloc(2*n*sizeof(Four));
+	if (order == NULL) ERR(eMEMORYALLOCERR_BTM);
+
+	for (i = 0; i < n; i++) order[i] = i;
+	edubtm_SortBatch(kdesc, pairs, order, order+n, n);
+
+	for (i = 1; i < n; i++)
+		if (edubtm_KeyCompare(kdesc, &pairs[order[i-1]].kval, &pairs[order[i]].kval) == EQUAL)
+		{
+			e = edubtm_DuplicateError(kdesc, &pairs[order[i-1]].oid, &pairs[order[i]].oid);
+			free(order);
+			ERR(e);
+		}
+
+	/* B-epsilon index: the messages are put one by one */
+	if (kdesc->flag & KEYFLAG_BUFFERED)
+	{
+		for (i = 0; i < n; i++)
+		{
+			e = EduBtM_InsertObject(catObjForFile, root, kdesc, &pairs[order[i]].kval,
+						&pairs[order[i]].oid, dlPool, dlHead);
+			if (e < 0) { free(order); ERR(e); }
+		}
+
+		free(order);
+		return(eNOERROR);
+	}
+
+	e = edubtm_InsertBatch(catObjForFile, root, kdesc, pairs, order, n, &items, &nItems);
+	free(order);
+	if (e < 0) ERR(e);
+
+	/* The root was split; the root gets a new level until it holds all the items. */
+	while (nItems > 0)
+	{
+		e = edubtm_root_insert(catObjForFile, root, &items[0]);
+		if (e < 0) { free(items); ERR(e); }
+
+		nMoreItems = 0;
+		moreItems = NULL;
+		if (nItems > 1)
+		{
+			e = edubtm_GetTrain(root, &rpage, PAGE_BUF);
+			if (e < 0) { free(items); ERR(e); }
+
+			e = edubtm_InsertBatchInternal(catObjForFile, root, rpage, kdesc, &items[1], nItems-1,
+							&moreItems, &nMoreItems);
+			if (e < 0) { free(items); ERRB1(e, root, PAGE_BUF); }
+
+			e = BfM_SetDirty(root, PAGE_BUF);
+			if (e < 0) { free(items); free(moreItems); ERRB1(e, root, PAGE_BUF); }
+
+			e = BfM_FreeTrain(root, PAGE_BUF);
+			if (e < 0) { free(items); free(moreItems); ERR(e); }
+		}
+
+		free(items);
+		items = moreItems;
+		nItems = nMoreItems;
+	}
+
+
+    return(eNOERROR);
+
+}   /* EduBtM_InsertBatch() */
@@ -30,6 +30,7 @@
  *
  * Exports:
  *  Four EduBtM_InsertObject(ObjectID*, PageID*, KeyDesc*, KeyValue*, ObjectID*, Pool*, DeallocListElem*)
+ *  Four EduBtM_InsertCovering(ObjectID*, PageID*, KeyDesc*, KeyValue*, ObjectID*, char*, Pool*, DeallocListElem*)
  */
 
 
@@ -37,6 +38,7 @@
 #include "BfM.h"
 #include "EduBtM_Internal.h"
 #include "OM_Internal.h"
+#include "EduBtM.h"
 
 
 
@@ -54,9 +56,25 @@
  *  If an overflow page is created as the result of the insert, it may occur
  *  merging or redistibuting two leaves and this may affect the root.
  *
+ *  In a B-epsilon index (KEYFLAG_BUFFERED), the insertion is put into the
+ *  message buffer of the root and goes down to the leaf later. Only a
+ *  unique index searches for the key first; in other indexes an insertion
+ *  of a key which is already in the index is dropped at the leaf without
+ *  being reported.
+ *
+ *  In a covering index, the included columns of the new entry are zero.
+ *
+ *  A key which is already in the index is found by the binary search of
+ *  the insertion in its leaf, so no separate lookup is needed: a unique
+ *  index (KEYFLAG_UNIQUE) returns eDUPLICATEDKEY_BTM. Another index returns
+ *  eDUPLICATEDOBJECTID_BTM for the same pair and eDUPLICATEDKEY_BTM for a
+ *  second ObjectID of the key.
+ *
  * Returns:
  *  error code
  *    eBADPARAMETER_BTM
+ *    eDUPLICATEDKEY_BTM
+ *    eDUPLICATEDOBJECTID_BTM
  *    some errors caused by function calls
  */
 Four EduBtM_InsertObject(
@@ -67,6 +85,42 @@ Four EduBtM_InsertObject(
     ObjectID *oid,		/* IN ObjectID which will be inserted */
     Pool     *dlPool,		/* INOUT pool of dealloc list */
     DeallocListElem *dlHead) /* INOUT head of the dealloc list */
+{
+	return(EduBtM_InsertCovering(catObjForFile, root, kdesc, kval, oid, NULL, dlPool, dlHead));
+
+}   /* EduBtM_InsertObject() */
+
+
+
+/*@================================
+ * EduBtM_InsertCovering() 
+ *================================*/
+/*
+ * Function: Four EduBtM_InsertCovering(ObjectID*, PageID*, KeyDesc*, KeyValue*, ObjectID*, char*, Pool*, DeallocListElem*)
+ * 
+ * Description :
+ *  Insert an ObjectID 'oid' into a Btree whose key value is 'kval', with the
+ *  included columns 'included' of the index created by
+ *  EduBtM_CreateCoveringIndex(). 'included' holds as many bytes as given at
+ *  the creation; NULL means zero-filled included columns.
+ *
+ * Returns:
+ *  error code
+ *    eBADPARAMETER_BTM
+ *    eDUPLICATEDKEY_BTM
+ *    eDUPLICATEDOBJECTID_BTM
+ *    eNOTSUPPORTED_EDUBTM
+ *    some errors caused by function calls
+ */
+Four EduBtM_InsertCovering(
+    ObjectID *catObjForFile,	/* IN catalog object of B+ tree file */
+    PageID   *root,		/* IN the root of Btree */
+    KeyDesc  *kdesc,		/* IN key descriptor */
+    KeyValue *kval,		/* IN key value */
+    ObjectID *oid,		/* IN ObjectID which will be inserted */
+    char     *included,		/* IN included columns or NULL */
+    Pool     *dlPool,		/* INOUT pool of dealloc list */
+    DeallocListElem *dlHead) /* INOUT head of the dealloc list */
 {
     int i;
     Four e;			/* error number */
@@ -76,6 +130,8 @@ Four EduBtM_InsertObject(
     SlottedPage *catPage;	/* buffer page containing the catalog object */
     sm_CatOverlayForBtree *catEntry; /* pointer to Btree file catalog information */
     PhysicalFileID pFid;	 /* B+-tree file's FileID */
+    Boolean found;		/* TRUE if the key is in the index */
+    ObjectID tOid;		/* ObjectID of the key in the index */
 
     
     /*@ check parameters */
@@ -97,16 +153,39 @@ Four EduBtM_InsertObject(
             ERR(eNOTSUPPORTED_EDUBTM);
     }
 
-	e = edubtm_Insert(catObjForFile, root, kdesc, kval, oid, &lf, &lh, &item, dlPool, dlHead);
-    if (e < 0) ERR(e);
+	/* the messages of a B-epsilon index carry no included columns */
+	if ((kdesc->flag & KEYFLAG_BUFFERED) && included != NULL) ERR(eNOTSUPPORTED_EDUBTM);
+
+	edubtm_TraceBegin(BTM_TRACE_INSERT);
+
+	/* B-epsilon index: put the insertion into the message buffers */
+	if (kdesc->flag & KEYFLAG_BUFFERED)
+	{
+		if (kdesc->flag & KEYFLAG_UNIQUE)
+		{
+			e = edubtm_BufferedLookup(root, kdesc, kval, &found, &tOid);
+			if (e < 0) ERRT(e, BTM_TRACE_INSERT);
+			if (found == TRUE) ERRT(edubtm_DuplicateError(kdesc, &tOid, oid), BTM_TRACE_INSERT);
+		}
+
+		e = edubtm_PutMessage(catObjForFile, root, kdesc, BTM_MSG_INSERT, kval, oid, dlPool, dlHead);
+		if (e < 0) ERRT(e, BTM_TRACE_INSERT);
+
+		edubtm_TraceEnd(BTM_TRACE_INSERT);
+		return(eNOERROR);
+	}
+
+	e = edubtm_Insert(catObjForFile, root, kdesc, kval, oid, included, &lf, &lh, &item, dlPool, dlHead);
+    if (e < 0) ERRT(e, BTM_TRACE_INSERT);
 
 	if (lh == TRUE) 
 	{
 		e = edubtm_root_insert(catObjForFile, root, &item);
-		if (e < 0) ERR(e);
+		if (e < 0) ERRT(e, BTM_TRACE_INSERT);
 	}
+	edubtm_TraceEnd(BTM_TRACE_INSERT);
 
     
     return(eNOERROR);
     
-}   /* EduBtM_InsertObject() */
+}   /* EduBtM_InsertCovering() */
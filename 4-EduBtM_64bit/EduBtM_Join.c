@@ -0,0 +1,286 @@
+/******************************************************************************/
+/*                                                                            */
+/*    ODYSSEUS/EduCOSMOS Educational-Purpose Object Storage System            */
+/*                                                                            */
+/*    Developed by Professor Kyu-Young Whang et al.                           */
+/*                                                                            */
+/*    Database and Multimedia Laboratory                                      */
+/*                                                                            */
+/*    Computer Science Department and                                         */
+/*    Advanced Information Technology Research Center (AITrc)                 */
+/*    Korea Advanced Institute of Science and Technology (KAIST)              */
+/*                                                                            */
+/*    e-mail: kywhang@cs.kaist.ac.kr                                          */
+/*    phone: +82-42-350-7722                                                  */
+/*    fax: +82-42-350-8380                                                    */
+/*                                                                            */
+/*    Copyright (c) 1995-2013 by Kyu-Young Whang                              */
+/*                                                                            */
+/*    All rights reserved. No part of this software may be reproduced,        */
+/*    stored in a retrieval system, or transmitted, in any form or by any     */
+/*    means, electronic, mechanical, photocopying, recording, or otherwise,   */
+/*    without prior written permission of the copyright owner.                */
+/*                                                                            */
+/******************************************************************************/
+/*
+ * Module: EduBtM_Join.c
+ *
+ * Description :
+ *  Join operators over B+ tree indexes. Both return the matching pairs of
+ *  ObjectIDs in arrays given by the caller instead of one cursor step per
+ *  call.
+ *
+ * Exports:
+ *  Four EduBtM_IndexJoin(PageID*, KeyDesc*, BtreeBatchItem*, Four, BtreeJoinPair*, Four*)
+ *  Four EduBtM_MergeJoin(PageID*, KeyDesc*, PageID*, KeyDesc*, KeyValue*, Four, KeyValue*, Four,
+ *                        BtreeJoinCursor*, BtreeJoinPair*, Four, Four*)
+ */
+
+
+#include <stdlib.h>
+#include "EduBtM_common.h"
+#include "BfM.h"
+#include "EduBtM_Internal.h"
+#include "EduBtM.h"
+
+
+
+/*@================================
+ * EduBtM_IndexJoin()
+ *================================*/
+/*
+ * Function: Four EduBtM_IndexJoin(PageID*, KeyDesc*, BtreeBatchItem*, Four,
+ *                                 BtreeJoinPair*, Four*)
+ *
+ * Description:
+ *  Index nested-loop join of the 'nOuter' outer rows with the B+ tree
+ *  index. Each outer row is given as its key value and its ObjectID. The
+ *  rows are sorted by the key values first, and then the tree is descended
+ *  once for all of them: each page on the way down is fixed once and
+ *  gets the whole run of the keys falling into its subtree, as in
+ *  EduBtM_InsertBatch().
+ *
+ *  For each outer row whose key is in the index, a pair of the ObjectID of
+ *  the row and the ObjectID of the index entry is put into 'pairs', in key
+ *  order. 'pairs' should have room for 'nOuter' pairs.
+ *
+ * Returns:
+ *  error code
+ *    eBADPARAMETER_BTM
+ *    eNOTSUPPORTED_EDUBTM
+ *    eMEMORYALLOCERR_BTM
+ *    some errors caused by function calls
+ *
+ * Side effects:
+ *  pairs  : the matching pairs
+ *  nPairs : # of 'pairs'
+ *
+ * Note:
+ *  A B-epsilon index looks up the keys one by one in the key order.
+ */
+Four EduBtM_IndexJoin(
+    PageID              *root,          /* IN root of the inner index */
+    KeyDesc             *kdesc,         /* IN key descriptor of the inner index */
+    BtreeBatchItem      *outer,         /* IN the outer rows */
+    Four                nOuter,         /* IN # of outer rows */
+    BtreeJoinPair       *pairs,         /* OUT the matching pairs */
+    Four                *nPairs)        /* OUT # of 'pairs' */
+{
+    int                 i;
+    Four                e;              /* error number */
+    Four                *order;         /* indexes of the outer rows in key order */
+    Boolean             found;          /* search result */
+
+
+    /*@ check parameters */
+
+    if (root == NULL) ERR(eBADPARAMETER_BTM);
+
+    if (kdesc == NULL) ERR(eBADPARAMETER_BTM);
+
+    if (outer == NULL || nOuter < 0) ERR(eBADPARAMETER_BTM);
+
+    if (pairs == NULL || nPairs == NULL) ERR(eBADPARAMETER_BTM);
+
+    /* Error check whether using not supported functionality by EduBtM */
+    for(i=0; i<kdesc->nparts; i++)
+    {
+        if(kdesc->kpart[i].type!=SM_INT && kdesc->kpart[i].type!=SM_VARSTRING)
+            ERR(eNOTSUPPORTED_EDUBTM);
+    }
+
+	*nPairs = 0;
+	if (nOuter == 0) return(eNOERROR);
+
+	order = (Four*)malloc(2*nOuter*sizeof(Four));
+	if (order == NULL) ERR(eMEMORYALLOCERR_BTM);
+
+	for (i = 0; i < nOuter; i++) order[i] = i;
+	edubtm_SortBatch(kdesc, outer, order, order+nOuter, nOuter);
+
+	/* B-epsilon index: the messages on the way down decide each key */
+	if (kdesc->flag & KEYFLAG_BUFFERED)
+	{
+		for (i = 0; i < nOuter; i++)
+		{
+			e = edubtm_BufferedLookup(root, kdesc, &outer[order[i]].kval, &found, &pairs[*nPairs].inner);
+			if (e < 0) { free(order); ERR(e); }
+
+			if (found == TRUE) pairs[(*nPairs)++].outer = outer[order[i]].oid;
+		}
+
+		free(order);
+		return(eNOERROR);
+	}
+
+	e = edubtm_IndexJoin(root, kdesc, outer, order, nOuter, pairs, nPairs);
+	free(order);
+	if (e < 0) ERR(e);
+
+
+    return(eNOERROR);
+
+}   /* EduBtM_IndexJoin() */
+
+
+
+/*@================================
+ * EduBtM_MergeJoin()
+ *================================*/
+/*
+ * Function: Four EduBtM_MergeJoin(PageID*, KeyDesc*, PageID*, KeyDesc*, KeyValue*, Four,
+ *                                 KeyValue*, Four, BtreeJoinCursor*, BtreeJoinPair*,
+ *                                 Four, Four*)
+ *
+ * Description:
+ *  Merge join of the outer and the inner B+ tree indexes over the keys
+ *  satisfying both the start condition ('startCompOp' is SM_BOF, SM_GE or
+ *  SM_GT) and the stop condition ('stopCompOp' is SM_EOF, SM_LE or SM_LT).
+ *  The two key descriptors should describe the same key format.
+ *
+ *  The leaves of the two indexes are scanned together in key order. Each
+ *  leaf is fixed once while it is scanned, and the index behind skips to
+ *  the key of the other one with a binary search in its leaf, or goes to
+ *  its next leaf at once when the key is beyond the leaf.
+ *
+ *  A call puts up to 'maxPairs' pairs of the ObjectIDs of the entries with
+ *  the same key into 'pairs', and the next call continues from there. The
+ *  caller sets 'cursor->flag' to CURSOR_INVALID before the first call; it
+ *  becomes CURSOR_EOS when the join is over.
+ *
+ * Returns:
+ *  error code
+ *    eBADPARAMETER_BTM
+ *    eBADCOMPOP_BTM
+ *    eBADCURSOR
+ *    eNOTSUPPORTED_EDUBTM
+ *    some errors caused by function calls
+ *
+ * Side effects:
+ *  cursor : the position of the join in the two indexes
+ *  pairs  : the matching pairs
+ *  nPairs : # of 'pairs'
+ *
+ * Note:
+ *  As the other cursors, 'cursor' is not valid after either index is
+ *  changed.
+ */
+Four EduBtM_MergeJoin(
+    PageID              *outerRoot,     /* IN root of the outer index */
+    KeyDesc             *outerKdesc,    /* IN key descriptor of the outer index */
+    PageID              *innerRoot,     /* IN root of the inner index */
+    KeyDesc             *innerKdesc,    /* IN key descriptor of the inner index */
+    KeyValue            *startKval,     /* IN key value of start condition */
+    Four                startCompOp,    /* IN comparison operator of start condition */
+    KeyValue            *stopKval,      /* IN key value of stop condition */
+    Four                stopCompOp,     /* IN comparison operator of stop condition */
+    BtreeJoinCursor     *cursor,        /* INOUT position of the join */
+    BtreeJoinPair       *pairs,         /* OUT the matching pairs */
+    Four                maxPairs,       /* IN room of 'pairs' */
+    Four                *nPairs)        /* OUT # of 'pairs' */
+{
+    int                 i;
+    Four                e;              /* error number */
+    PageID              *root[2];       /* roots of the outer and the inner index */
+    KeyDesc             *kdesc[2];      /* key descriptors of them */
+    KeyValue            *kval;          /* key value given as the stop condition */
+    BtreeCursor         tCursor;        /* the first entry of the range */
+
+
+    /*@ check parameters */
+
+    if (outerRoot == NULL || innerRoot == NULL) ERR(eBADPARAMETER_BTM);
+
+    if (outerKdesc == NULL || innerKdesc == NULL) ERR(eBADPARAMETER_BTM);
+
+    if (cursor == NULL || pairs == NULL || maxPairs < 0 || nPairs == NULL) ERR(eBADPARAMETER_BTM);
+
+    if (startCompOp != SM_BOF && startCompOp != SM_GE && startCompOp != SM_GT) ERR(eBADCOMPOP_BTM);
+
+    if (stopCompOp != SM_EOF && stopCompOp != SM_LE && stopCompOp != SM_LT) ERR(eBADCOMPOP_BTM);
+
+    if ((startCompOp != SM_BOF && startKval == NULL) || (stopCompOp != SM_EOF && stopKval == NULL))
+        ERR(eBADPARAMETER_BTM);
+
+    /* Error check whether using not supported functionality by EduBtM */
+    for(i=0; i<outerKdesc->nparts; i++)
+    {
+        if(outerKdesc->kpart[i].type!=SM_INT && outerKdesc->kpart[i].type!=SM_VARSTRING)
+            ERR(eNOTSUPPORTED_EDUBTM);
+    }
+
+	/* The keys of the two indexes are compared with each other as they are. */
+	if (innerKdesc->nparts != outerKdesc->nparts) ERR(eBADPARAMETER_BTM);
+	for (i = 0; i < outerKdesc->nparts; i++)
+	{
+		if (innerKdesc->kpart[i].type != outerKdesc->kpart[i].type) ERR(eBADPARAMETER_BTM);
+		if (outerKdesc->kpart[i].type == SM_INT && innerKdesc->kpart[i].length != outerKdesc->kpart[i].length)
+			ERR(eBADPARAMETER_BTM);
+	}
+
+	/* The leaves of a B-epsilon index miss the messages buffered above them. */
+	if ((outerKdesc->flag & KEYFLAG_BUFFERED) || (innerKdesc->flag & KEYFLAG_BUFFERED))
+		ERR(eNOTSUPPORTED_EDUBTM);
+
+	*nPairs = 0;
+
+	if (cursor->flag == CURSOR_EOS) return(eNOERROR);
+
+	if (cursor->flag == CURSOR_INVALID)
+	{
+		root[0] = outerRoot;
+		root[1] = innerRoot;
+		kdesc[0] = outerKdesc;
+		kdesc[1] = innerKdesc;
+
+		// edubtm_Fetch() compares the first key with the stop key even for SM_EOF.
+		kval = (stopCompOp == SM_EOF) ? startKval : stopKval;
+
+		// Both indexes start at the first key of the range.
+		for (i = 0; i < 2; i++)
+		{
+			e = EduBtM_Fetch(root[i], kdesc[i], startKval, startCompOp, kval, stopCompOp, &tCursor);
+			if (e < 0) ERR(e);
+
+			if (tCursor.flag == CURSOR_EOS)
+			{
+				cursor->flag = CURSOR_EOS;
+				return(eNOERROR);
+			}
+
+			cursor->leaf[i] = tCursor.leaf;
+			cursor->slotNo[i] = tCursor.slotNo;
+		}
+
+		cursor->flag = CURSOR_ON;
+	}
+	else if (cursor->flag != CURSOR_ON)
+		ERR(eBADCURSOR);
+
+	e = edubtm_MergeJoin(outerKdesc, innerKdesc, stopKval, stopCompOp, cursor, pairs, maxPairs, nPairs);
+	if (e < 0) ERR(e);
+
+
+    return(eNOERROR);
+
+}   /* EduBtM_MergeJoin() */
@@ -0,0 +1,596 @@
+/******************************************************************************/
+/*                                                                            */
+/*    ODYSSEUS/EduCOSMOS Educational-Purpose Object Storage System            */
+/*                                                                            */
+/*    Developed by Professor Kyu-Young Whang et al.                           */
+/*                                                                            */
+/*    Database and Multimedia Laboratory                                      */
+/*                                                                            */
+/*    Computer Science Department and                                         */
+/*    Advanced Information Technology Research Center (AITrc)                 */
+/*    Korea Advanced Institute of Science and Technology (KAIST)              */
+/*                                                                            */
+/*    e-mail: kywhang@cs.kaist.ac.kr                                          */
+/*    phone: +82-42-350-7722                                                  */
+/*    fax: +82-42-350-8380                                                    */
+/*                                                                            */
+/*    Copyright (c) 1995-2013 by Kyu-Young Whang                              */
+/*                                                                            */
+/*    All rights reserved. No part of this software may be reproduced,        */
+/*    stored in a retrieval system, or transmitted, in any form or by any     */
+/*    means, electronic, mechanical, photocopying, recording, or otherwise,   */
+/*    without prior written permission of the copyright owner.                */
+/*                                                                            */
+/******************************************************************************/
+/*
+ * Module: EduBtM_RangeTest.c
+ *
+ * Description :
+ *  Regression test of EduBtM_DeleteRange(). An index of string keys of
+ *  height 3 is built by random insertions and then goes through range
+ *  deletions at both ends of the keys, with the start and stop keys below
+ *  the minimum and above the maximum, through random ranges with
+ *  insertions in between, and through the deletion of all the keys.
+ *  After every step the whole tree is checked against the set of keys it
+ *  should hold:
+ *   - no page but the root is an empty leaf or an internal page without
+ *     slot,
+ *   - the keys of every page lie between the separators of its parent,
+ *   - the leaf list links the leaves in the order of the tree, and
+ *   - a scan from the first key to the last returns exactly the keys of
+ *     the set.
+ *
+ *  Usage: EduBtM_RangeTest
+ *
+ *  The exit status is 0 if all the checks pass.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "EduBtM_common.h"
+#include "EduBtM_basictypes.h"
+#include "BfM.h"
+#include "EduBtM.h"
+#include "EduBtM_Internal.h"
+#include "EduBtM_TestModule.h"
+
+
+#define RTEST_VOLUME        "rangetest.vol"
+#define RTEST_NUMPAGES      8000    /* # of pages of the volume; the freed pages stay in the dealloc list */
+#define RTEST_STRINGKEYLEN  40      /* length of the string keys */
+#define RTEST_NUMKEYS       6000    /* the keys are the numbers in [0, RTEST_NUMKEYS) */
+#define RTEST_INSERTS       20000   /* # of random insertions building the index */
+#define RTEST_RANGES        200     /* # of random range deletions */
+#define RTEST_BELOWMIN      (-1)    /* a key below all the keys */
+#define RTEST_ABOVEMAX      (10*RTEST_NUMKEYS) /* a key above all the keys */
+#define RTEST_MAXLEAVES     10000   /* maximum # of leaves of the index */
+
+Four SM_CreateFile(Four, FileID*, Boolean, void*);
+Four sm_GetCatalogEntryFromDataFileId(Four, FileID*, ObjectID*);
+
+Four EduBtM_RangeTest(Four, Four);
+Four rtest_Insert(ObjectID*, PageID*, KeyDesc*, Four);
+Four rtest_Delete(ObjectID*, PageID*, KeyDesc*, Four, Four, Four, Four, char*);
+Four rtest_Check(PageID*, KeyDesc*, char*);
+Four rtest_CheckPage(PageID*, KeyDesc*, KeyValue*, KeyValue*, Boolean);
+void rtest_MakeKey(Four, KeyValue*);
+Four rtest_KeyNumber(KeyValue*);
+
+static char rtest_alive[RTEST_NUMKEYS];     /* whether each key should be in the index */
+static ShortPageID rtest_leaves[RTEST_MAXLEAVES]; /* the leaves in the order of the tree */
+static Four rtest_nLeaves;
+static Four rtest_nErrors;                  /* # of violations found by the current check */
+
+
+
+/*@================================
+ * main()
+ *================================*/
+int main(int argc, char *argv[])
+{
+	Four	e;									/* for errors */
+	Four	handle;								/* system handle */
+	char 	*devNames[1];						/* device name */
+	Four 	volId = 1000;						/* volume identifier */
+	Four 	numPagesInDevices[1];				/* # of pages in the device */
+	XactID 	xactId;								/* transaction identifier */
+
+
+	devNames[0] = RTEST_VOLUME;
+	numPagesInDevices[0] = RTEST_NUMPAGES;
+
+	e = LRDS_Init();
+	if (e < eNOERROR) { printf("LRDS_Init failed!!!\n"); exit(1); }
+
+	e = LRDS_AllocHandle(&handle);
+	if (e < eNOERROR) { printf("LRDS_AllocHandle failed!!!\n"); LRDS_Final(); exit(1); }
+
+	e = LRDS_FormatDataVolume(1, devNames, "rangetest", volId, 16, numPagesInDevices, 16);
+	if (e < eNOERROR) { printf("LRDS_FormatDataVolume failed!!!\n"); LRDS_FreeHandle(handle); LRDS_Final(); exit(1); }
+
+	e = LRDS_Mount(1, devNames, &volId);
+	if (e < eNOERROR) { printf("LRDS_Mount failed!!!\n"); LRDS_FreeHandle(handle); LRDS_Final(); exit(1); }
+
+	e = LRDS_BeginTransaction(&xactId, X_RR_RR);
+	if (e < eNOERROR) { LRDS_Dismount(volId); LRDS_FreeHandle(handle); LRDS_Final(); exit(1); }
+
+	e = EduBtM_RangeTest(volId, handle);
+	if (e < eNOERROR) {
+		printf("EduBtM_RangeTest failed!!!\n");
+		LRDS_AbortTransaction(&xactId);
+		LRDS_Dismount(volId);
+		LRDS_FreeHandle(handle);
+		LRDS_Final();
+		exit(1);
+	}
+
+	e = LRDS_CommitTransaction(&xactId);
+	if (e < eNOERROR) printf("LRDS_CommitTransaction failed!!!\n");
+
+	LRDS_Dismount(volId);
+	LRDS_FreeHandle(handle);
+	LRDS_Final();
+
+	return 0;
+}
+
+
+
+/*@================================
+ * EduBtM_RangeTest()
+ *================================*/
+/*
+ * Function: Four EduBtM_RangeTest(Four, Four)
+ *
+ * Description:
+ *  Run the range deletions and check the tree after each of them.
+ *
+ * Returns:
+ *  error code
+ *    eBADBTREEPAGE_BTM if a check fails
+ *    some errors caused by function calls
+ */
+Four EduBtM_RangeTest(
+    Four        volId,                  /* IN volume identifier */
+    Four        handle)                 /* IN system handle */
+{
+    Four        e;                      /* error number */
+    Four        i;                      /* index */
+    Four        lo, hi;                 /* bounds of a random range */
+    Four        startCompOp;            /* comparison operator of the start condition */
+    Four        stopCompOp;             /* comparison operator of the stop condition */
+    FileID      fid;                    /* file identifier */
+    ObjectID    catalogEntry;           /* catalog object */
+    PageID      root;                   /* root of the index */
+    KeyDesc     kdesc;                  /* key descriptor */
+    BtreeStats  stats;                  /* statistics of the index */
+    char        name[64];               /* name of a step */
+
+
+	e = SM_CreateFile(volId, &fid, FALSE, NULL);
+	if (e < eNOERROR) ERR(e);
+
+	e = sm_GetCatalogEntryFromDataFileId(ARRAYINDEX, &fid, &catalogEntry);
+	if (e < eNOERROR) ERR(e);
+
+	kdesc.flag = KEYFLAG_UNIQUE;
+	kdesc.nparts = 1;
+	kdesc.kpart[0].type = SM_VARSTRING;
+	kdesc.kpart[0].offset = 0;
+	kdesc.kpart[0].length = RTEST_STRINGKEYLEN;
+
+	e = EduBtM_CreateIndex(&catalogEntry, &root);
+	if (e < eNOERROR) ERR(e);
+
+	srand(11);
+	e = rtest_Insert(&catalogEntry, &root, &kdesc, RTEST_INSERTS);
+	if (e < eNOERROR) ERR(e);
+
+	e = EduBtM_GetStats(&root, &kdesc, &stats);
+	if (e < eNOERROR) ERR(e);
+	printf("index of height %ld\n", (long)stats.height);
+
+	e = rtest_Check(&root, &kdesc, "insert");
+	if (e < eNOERROR) ERR(e);
+
+	// The stop key above the maximum empties a leaf whose parent loses all its slots.
+	e = rtest_Delete(&catalogEntry, &root, &kdesc, 2486, SM_GT, 8428, SM_LT, "middle to above the maximum");
+	if (e < eNOERROR) ERR(e);
+
+	e = rtest_Delete(&catalogEntry, &root, &kdesc, RTEST_BELOWMIN, SM_GE, 300, SM_LT, "below the minimum");
+	if (e < eNOERROR) ERR(e);
+
+	e = rtest_Delete(&catalogEntry, &root, &kdesc, 5700, SM_GE, RTEST_ABOVEMAX, SM_LE, "above the maximum");
+	if (e < eNOERROR) ERR(e);
+
+	e = rtest_Delete(&catalogEntry, &root, &kdesc, 0, SM_BOF, 700, SM_LE, "from the first key");
+	if (e < eNOERROR) ERR(e);
+
+	e = rtest_Delete(&catalogEntry, &root, &kdesc, 2000, SM_GT, 0, SM_EOF, "to the last key");
+	if (e < eNOERROR) ERR(e);
+
+	for (i = 0; i < RTEST_RANGES; i++)
+	{
+		e = rtest_Insert(&catalogEntry, &root, &kdesc, RTEST_NUMKEYS/20 + rand()%(RTEST_NUMKEYS/4));
+		if (e < eNOERROR) ERR(e);
+
+		lo = rand() % RTEST_NUMKEYS;
+		hi = lo + rand() % (RTEST_NUMKEYS/2);
+		startCompOp = (rand() % 2) ? SM_GE : SM_GT;
+		stopCompOp = (rand() % 2) ? SM_LE : SM_LT;
+		if (i % 7 == 0) startCompOp = SM_BOF;
+		if (i % 5 == 0) stopCompOp = SM_EOF;
+		if (i % 9 == 0) lo = RTEST_BELOWMIN;
+		if (i % 6 == 0) hi = RTEST_ABOVEMAX;
+
+		sprintf(name, "random range %ld", (long)i);
+		e = rtest_Delete(&catalogEntry, &root, &kdesc, lo, startCompOp, hi, stopCompOp, name);
+		if (e < eNOERROR) ERR(e);
+	}
+
+	e = rtest_Delete(&catalogEntry, &root, &kdesc, RTEST_BELOWMIN, SM_GT, RTEST_ABOVEMAX, SM_LT, "all the keys");
+	if (e < eNOERROR) ERR(e);
+
+	e = rtest_Insert(&catalogEntry, &root, &kdesc, RTEST_NUMKEYS);
+	if (e < eNOERROR) ERR(e);
+
+	e = rtest_Check(&root, &kdesc, "insert into the emptied index");
+	if (e < eNOERROR) ERR(e);
+
+	printf("all checks passed\n");
+
+	return(eNOERROR);
+
+} /* EduBtM_RangeTest() */
+
+
+
+/*@================================
+ * rtest_Insert()
+ *================================*/
+/*
+ * Function: Four rtest_Insert(ObjectID*, PageID*, KeyDesc*, Four)
+ *
+ * Description:
+ *  Insert the given number of random keys; a key already in the index is
+ *  skipped.
+ *
+ * Returns:
+ *  error code
+ *    some errors caused by function calls
+ */
+Four rtest_Insert(
+    ObjectID        *catObjForFile,     /* IN catalog object of B+ tree file */
+    PageID          *root,              /* IN root of the index */
+    KeyDesc         *kdesc,             /* IN key descriptor */
+    Four            n)                  /* IN # of random insertions */
+{
+    Four            e;                  /* error number */
+    Four            i;                  /* index */
+    Four            v;                  /* number of the key */
+    KeyValue        kval;               /* key value */
+    ObjectID        oid;                /* ObjectID of the key */
+
+
+	for (i = 0; i < n; i++)
+	{
+		v = rand() % RTEST_NUMKEYS;
+		if (rtest_alive[v]) continue;
+
+		rtest_MakeKey(v, &kval);
+		oid.volNo = catObjForFile->volNo; oid.pageNo = 1; oid.slotNo = 0; oid.unique = v;
+
+		e = EduBtM_InsertObject(catObjForFile, root, kdesc, &kval, &oid, &dlPool, &dlHead);
+		if (e < eNOERROR) ERR(e);
+
+		rtest_alive[v] = TRUE;
+	}
+
+	return(eNOERROR);
+
+} /* rtest_Insert() */
+
+
+
+/*@================================
+ * rtest_Delete()
+ *================================*/
+/*
+ * Function: Four rtest_Delete(ObjectID*, PageID*, KeyDesc*, Four, Four, Four, Four, char*)
+ *
+ * Description:
+ *  Delete the keys of the range by EduBtM_DeleteRange(), drop them from
+ *  the set and check the tree.
+ *
+ * Returns:
+ *  error code
+ *    eBADBTREEPAGE_BTM if the check fails
+ *    some errors caused by function calls
+ */
+Four rtest_Delete(
+    ObjectID        *catObjForFile,     /* IN catalog object of B+ tree file */
+    PageID          *root,              /* IN root of the index */
+    KeyDesc         *kdesc,             /* IN key descriptor */
+    Four            lo,                 /* IN number of the start key */
+    Four            startCompOp,        /* IN comparison operator of the start condition */
+    Four            hi,                 /* IN number of the stop key */
+    Four            stopCompOp,         /* IN comparison operator of the stop condition */
+    char            *name)              /* IN name of the step */
+{
+    Four            e;                  /* error number */
+    Four            v;                  /* number of a key */
+    KeyValue        startKval;          /* start key */
+    KeyValue        stopKval;           /* stop key */
+
+
+	rtest_MakeKey(lo, &startKval);
+	rtest_MakeKey(hi, &stopKval);
+
+	e = EduBtM_DeleteRange(catObjForFile, root, kdesc, &startKval, startCompOp, &stopKval, stopCompOp, &dlPool, &dlHead);
+	if (e < eNOERROR) ERR(e);
+
+	for (v = 0; v < RTEST_NUMKEYS; v++)
+	{
+		if (startCompOp == SM_GE && v < lo) continue;
+		if (startCompOp == SM_GT && v <= lo) continue;
+		if (stopCompOp == SM_LE && v > hi) continue;
+		if (stopCompOp == SM_LT && v >= hi) continue;
+		rtest_alive[v] = FALSE;
+	}
+
+	return(rtest_Check(root, kdesc, name));
+
+} /* rtest_Delete() */
+
+
+
+/*@================================
+ * rtest_Check()
+ *================================*/
+/*
+ * Function: Four rtest_Check(PageID*, KeyDesc*, char*)
+ *
+ * Description:
+ *  Check the pages of the tree, the leaf list and the keys returned by a
+ *  full scan against the set of keys. The violations are printed.
+ *
+ * Returns:
+ *  error code
+ *    eBADBTREEPAGE_BTM if the check fails
+ *    some errors caused by function calls
+ */
+Four rtest_Check(
+    PageID          *root,              /* IN root of the index */
+    KeyDesc         *kdesc,             /* IN key descriptor */
+    char            *name)              /* IN name of the step */
+{
+    Four            e;                  /* error number */
+    Four            i;                  /* index */
+    Four            v;                  /* number of a key */
+    Four            nKeys;              /* # of keys returned by the scan */
+    Four            nAlive;             /* # of keys of the set */
+    PageID          pid;                /* a leaf */
+    BtreeLeaf       *apage;             /* buffer of the leaf */
+    KeyValue        kval;               /* a dummy key of the scan */
+    BtreeCursor     cursor;             /* cursor of the scan */
+    BtreeCursor     next;               /* the next cursor of the scan */
+
+
+	rtest_nErrors = 0;
+	rtest_nLeaves = 0;
+
+	e = rtest_CheckPage(root, kdesc, NULL, NULL, TRUE);
+	if (e < eNOERROR) ERR(e);
+
+	for (i = 0; i < rtest_nLeaves; i++)
+	{
+		MAKE_PAGEID(pid, root->volNo, rtest_leaves[i]);
+		e = BfM_GetTrain(&pid, (char**)&apage, PAGE_BUF);
+		if (e < eNOERROR) ERR(e);
+
+		if (apage->hdr.prevPage != ((i > 0) ? rtest_leaves[i-1] : NIL) ||
+		    apage->hdr.nextPage != ((i+1 < rtest_nLeaves) ? rtest_leaves[i+1] : NIL))
+		{
+			printf("  leaf %ld is not linked to its neighbors\n", (long)pid.pageNo);
+			rtest_nErrors++;
+		}
+
+		e = BfM_FreeTrain(&pid, PAGE_BUF);
+		if (e < eNOERROR) ERR(e);
+	}
+
+	nKeys = nAlive = 0;
+	for (v = 0; v < RTEST_NUMKEYS; v++)
+		if (rtest_alive[v]) nAlive++;
+
+	rtest_MakeKey(0, &kval);
+	e = EduBtM_Fetch(root, kdesc, &kval, SM_BOF, &kval, SM_EOF, &cursor);
+	if (e < eNOERROR) ERR(e);
+
+	while (cursor.flag == CURSOR_ON)
+	{
+		v = rtest_KeyNumber(&cursor.key);
+		if (v < 0 || v >= RTEST_NUMKEYS || !rtest_alive[v])
+		{
+			printf("  the scan returns the deleted key %ld\n", (long)v);
+			rtest_nErrors++;
+		}
+		nKeys++;
+
+		e = EduBtM_FetchNext(root, kdesc, &kval, SM_EOF, &cursor, &next);
+		if (e < eNOERROR) ERR(e);
+		cursor = next;
+	}
+
+	if (nKeys != nAlive)
+	{
+		printf("  the scan returns %ld keys instead of %ld\n", (long)nKeys, (long)nAlive);
+		rtest_nErrors++;
+	}
+
+	printf("%-32s %6ld keys %6ld leaves %s\n", name, (long)nKeys, (long)rtest_nLeaves,
+	       (rtest_nErrors == 0) ? "ok" : "FAILED");
+
+	if (rtest_nErrors > 0) ERR(eBADBTREEPAGE_BTM);
+
+	return(eNOERROR);
+
+} /* rtest_Check() */
+
+
+
+/*@================================
+ * rtest_CheckPage()
+ *================================*/
+/*
+ * Function: Four rtest_CheckPage(PageID*, KeyDesc*, KeyValue*, KeyValue*, Boolean)
+ *
+ * Description:
+ *  Check the subtree 'pid' whose keys should lie in ['lo', 'hi'); a NULL
+ *  bound is open. The leaves are appended to the list of the leaves in
+ *  the order of the tree.
+ *
+ * Returns:
+ *  error code
+ *    some errors caused by function calls
+ */
+Four rtest_CheckPage(
+    PageID          *pid,               /* IN root of the subtree */
+    KeyDesc         *kdesc,             /* IN key descriptor */
+    KeyValue        *lo,                /* IN the lower bound or NULL */
+    KeyValue        *hi,                /* IN the upper bound or NULL */
+    Boolean         isRoot)             /* IN whether 'pid' is the root */
+{
+    Four            e;                  /* error number */
+    Two             i;                  /* slot No. */
+    PageID          child;              /* a child page */
+    KeyValue        *clo, *chi;         /* bounds of the child */
+    KeyValue        *kval;              /* a key of the page */
+    BtreePage       *apage;             /* buffer of the page */
+    btm_InternalEntry *iEntry;          /* an internal entry */
+    btm_LeafEntry   *lEntry;            /* a leaf entry */
+
+
+	e = BfM_GetTrain(pid, (char**)&apage, PAGE_BUF);
+	if (e < eNOERROR) ERR(e);
+
+	if (apage->any.hdr.type & INTERNAL)
+	{
+		if (apage->bi.hdr.nSlots == 0 && isRoot == FALSE)
+		{
+			printf("  internal page %ld has no slot\n", (long)pid->pageNo);
+			rtest_nErrors++;
+		}
+
+		for (i = -1; i < apage->bi.hdr.nSlots; i++)
+		{
+			clo = lo;
+			chi = hi;
+			if (i >= 0)
+			{
+				iEntry = (btm_InternalEntry*)&(apage->bi.data[apage->bi.slot[-1*i]]);
+				clo = (KeyValue*)&iEntry->klen;
+				MAKE_PAGEID(child, pid->volNo, iEntry->spid);
+			}
+			else
+				MAKE_PAGEID(child, pid->volNo, apage->bi.hdr.p0);
+
+			if (i+1 < apage->bi.hdr.nSlots)
+			{
+				iEntry = (btm_InternalEntry*)&(apage->bi.data[apage->bi.slot[-1*(i+1)]]);
+				chi = (KeyValue*)&iEntry->klen;
+			}
+
+			if (clo != NULL && chi != NULL && edubtm_KeyCompare(kdesc, clo, chi) != LESS)
+			{
+				printf("  internal page %ld has separators out of order\n", (long)pid->pageNo);
+				rtest_nErrors++;
+			}
+
+			e = rtest_CheckPage(&child, kdesc, clo, chi, FALSE);
+			if (e < eNOERROR) ERRB1(e, pid, PAGE_BUF);
+		}
+	}
+	else
+	{
+		if (rtest_nLeaves < RTEST_MAXLEAVES)
+			rtest_leaves[rtest_nLeaves++] = pid->pageNo;
+
+		if (apage->bl.hdr.nSlots == 0 && isRoot == FALSE)
+		{
+			printf("  leaf %ld is empty\n", (long)pid->pageNo);
+			rtest_nErrors++;
+		}
+
+		for (i = 0; i < apage->bl.hdr.nSlots; i++)
+		{
+			lEntry = (btm_LeafEntry*)&(apage->bl.data[apage->bl.slot[-1*i]]);
+			kval = (KeyValue*)&lEntry->klen;
+			if ((lo != NULL && edubtm_KeyCompare(kdesc, kval, lo) == LESS) ||
+			    (hi != NULL && edubtm_KeyCompare(kdesc, kval, hi) != LESS))
+			{
+				printf("  leaf %ld has the key %ld outside its separators\n",
+				       (long)pid->pageNo, (long)rtest_KeyNumber(kval));
+				rtest_nErrors++;
+			}
+		}
+	}
+
+	e = BfM_FreeTrain(pid, PAGE_BUF);
+	if (e < eNOERROR) ERR(e);
+
+	return(eNOERROR);
+
+} /* rtest_CheckPage() */
+
+
+
+/*@================================
+ * rtest_MakeKey()
+ *================================*/
+/*
+ * Function: void rtest_MakeKey(Four, KeyValue*)
+ *
+ * Description:
+ *  Make the key value of the given number, padded with zeros to the
+ *  length of the key as bench_MakeKey() does. The keys keep the order of
+ *  the numbers; a negative number is below all the others.
+ *
+ * Returns:
+ *  None
+ */
+void rtest_MakeKey(
+    Four            v,                  /* IN number of the key */
+    KeyValue        *kval)              /* OUT key value */
+{
+    Two             len;                /* length of the string */
+
+
+	sprintf(&kval->val[sizeof(Two)], "%0*ld", RTEST_STRINGKEYLEN - 1, (long)v);
+	len = RTEST_STRINGKEYLEN;
+	memcpy(kval->val, &len, sizeof(Two));
+	kval->len = sizeof(Two) + len;
+
+} /* rtest_MakeKey() */
+
+
+
+/*@================================
+ * rtest_KeyNumber()
+ *================================*/
+/*
+ * Function: Four rtest_KeyNumber(KeyValue*)
+ *
+ * Description:
+ *  Return the number of a key made by rtest_MakeKey().
+ *
+ * Returns:
+ *  number of the key
+ */
+Four rtest_KeyNumber(
+    KeyValue        *kval)              /* IN key value */
+{
+
+	return(atol(&kval->val[sizeof(Two)]));
+
+} /* rtest_KeyNumber() */
@@ -0,0 +1,173 @@
+/******************************************************************************/
+/*                                                                            */
+/*    ODYSSEUS/EduCOSMOS Educational-Purpose Object Storage System            */
+/*                                                                            */
+/*    Developed by Professor Kyu-Young Whang et al.                           */
+/*                                                                            */
+/*    Database and Multimedia Laboratory                                      */
+/*                                                                            */
+/*    Computer Science Department and                                         */
+/*    Advanced Information Technology Research Center (AITrc)                 */
+/*    Korea Advanced Institute of Science and Technology (KAIST)              */
+/*                                                                            */
+/*    e-mail: kywhang@cs.kaist.ac.kr                                          */
+/*    phone: +82-42-350-7722                                                  */
+/*    fax: +82-42-350-8380                                                    */
+/*                                                                            */
+/*    Copyright (c) 1995-2013 by Kyu-Young Whang                              */
+/*                                                                            */
+/*    All rights reserved. No part of this software may be reproduced,        */
+/*    stored in a retrieval system, or transmitted, in any form or by any     */
+/*    means, electronic, mechanical, photocopying, recording, or otherwise,   */
+/*    without prior written permission of the copyright owner.                */
+/*                                                                            */
+/******************************************************************************/
+/*
+ * Module: EduBtM_Reorganize.c
+ *
+ * Description :
+ *  Reorganize a B+ tree index incrementally.
+ *
+ * Exports:
+ *  Four EduBtM_Reorganize(ObjectID*, PageID*, KeyDesc*, BtreeReorgCursor*, Four,
+ *                         Pool*, DeallocListElem*)
+ */
+
+
+#include "EduBtM_common.h"
+#include "BfM.h"
+#include "EduBtM_Internal.h"
+
+
+
+/*@================================
+ * EduBtM_Reorganize()
+ *================================*/
+/*
+ * Function: Four EduBtM_Reorganize(ObjectID*, PageID*, KeyDesc*, BtreeReorgCursor*,
+ *                                  Four, Pool*, DeallocListElem*)
+ *
+ * Description :
+ *  Do a step of the reorganization of the B+ tree given by 'root'. A step
+ *  visits at most 'maxPages' leaves in key order from the position saved
+ *  in 'cursor', so the work of a step is bounded and the index can be used
+ *  between the steps. The reorganization has two phases:
+ *
+ *  REORG_MERGE    : an underfull page on the path to each leaf is merged
+ *                   with its sibling or the entries are redistributed. The
+ *                   root collapses when it has a single child, which shrinks
+ *                   the height of the tree.
+ *  REORG_RELOCATE : each leaf is copied to a newly allocated page next to
+ *                   the previously written leaf unless it already follows
+ *                   it, so the leaves are laid out in key order and a range
+ *                   scan reads the pages sequentially.
+ *
+ *  The caller sets 'cursor->phase' to REORG_BEGIN and calls this function
+ *  until 'cursor->phase' becomes REORG_DONE. A B-epsilon index
+ *  (KEYFLAG_BUFFERED) skips REORG_MERGE since its internal pages hold
+ *  messages.
+ *
+ * Returns:
+ *  error code
+ *    eBADPARAMETER_BTM
+ *    some errors caused by function calls
+ *
+ * Note:
+ *  The scan cursors opened before a step are not valid after the step
+ *  since leaves may be freed or moved.
+ */
+Four EduBtM_Reorganize(
+    ObjectID            *catObjForFile, /* IN catalog object of B+-tree file */
+    PageID              *root,          /* IN root Page IDentifier */
+    KeyDesc             *kdesc,         /* IN a key descriptor */
+    BtreeReorgCursor    *cursor,        /* INOUT state of the reorganization */
+    Four                maxPages,       /* IN maximum # of leaves to visit in this step */
+    Pool                *dlPool,        /* INOUT pool of dealloc list elements */
+    DeallocListElem     *dlHead)        /* INOUT head of the dealloc list */
+{
+    Four                e;              /* error number */
+    Four                i;              /* index */
+    Four                n;              /* # of leaves visited */
+    Boolean             merged;         /* TRUE if pages are merged on the path */
+    Boolean             found;          /* TRUE if the next leaf exists */
+    Boolean             lf;             /* TRUE if the root is not half full */
+    Boolean             lh;             /* TRUE if the root is splitted */
+    InternalItem        item;           /* internal item for the new root */
+    PhysicalFileID      pFid;           /* B+-tree file's FileID */
+
+
+    /*@ check parameters */
+    if (catObjForFile == NULL) ERR(eBADPARAMETER_BTM);
+
+    if (root == NULL) ERR(eBADPARAMETER_BTM);
+
+    if (kdesc == NULL) ERR(eBADPARAMETER_BTM);
+
+    if (cursor == NULL || maxPages <= 0) ERR(eBADPARAMETER_BTM);
+
+    if (dlPool == NULL || dlHead == NULL) ERR(eBADPARAMETER_BTM);
+
+    /* Error check whether using not supported functionality by EduBtM */
+    for (i=0; i<kdesc->nparts; i++)
+    {
+        if (kdesc->kpart[i].type!=SM_INT && kdesc->kpart[i].type!=SM_VARSTRING)
+            ERR(eNOTSUPPORTED_EDUBTM);
+    }
+
+	MAKE_PAGEID(pFid, catObjForFile->volNo, catObjForFile->pageNo);
+
+	if (cursor->phase == REORG_BEGIN)
+	{
+		cursor->phase = (kdesc->flag & KEYFLAG_BUFFERED) ? REORG_RELOCATE : REORG_MERGE;
+		e = edubtm_ReorgStart(root, cursor);
+		if (e < 0) ERR(e);
+	}
+
+	for (n = 0; n < maxPages && cursor->phase != REORG_DONE; n++)
+	{
+		if (cursor->phase == REORG_MERGE)
+		{
+			lf = lh = merged = FALSE;
+			e = edubtm_ReorgMerge(catObjForFile, root, kdesc, &cursor->key, &merged, &lf, &lh, &item, dlPool, dlHead);
+			if (e < 0) ERR(e);
+
+			if (lh == TRUE)
+			{
+				e = edubtm_root_insert(catObjForFile, root, &item);
+				if (e < 0) ERR(e);
+			}
+			else if (lf == TRUE)
+			{
+				edubtm_TopCacheInvalidate(root);
+				e = btm_root_delete(&pFid, root, dlPool, dlHead);
+				if (e < 0) ERR(e);
+			}
+
+			// A merged leaf is visited again; it may merge with the next one.
+			if (merged == TRUE) continue;
+		}
+		else
+		{
+			e = edubtm_RelocateLeaf(catObjForFile, root, kdesc, cursor, dlPool, dlHead);
+			if (e < 0) ERR(e);
+		}
+
+		e = edubtm_ReorgNext(root, kdesc, &cursor->key, &found);
+		if (e < 0) ERR(e);
+
+		if (found == FALSE)
+		{
+			if (cursor->phase == REORG_MERGE)
+			{
+				cursor->phase = REORG_RELOCATE;
+				e = edubtm_ReorgStart(root, cursor);
+				if (e < 0) ERR(e);
+			}
+			else
+				cursor->phase = REORG_DONE;
+		}
+	}
+
+	return(eNOERROR);
+
+} /* EduBtM_Reorganize() */
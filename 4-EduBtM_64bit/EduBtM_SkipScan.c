@@ -0,0 +1,360 @@
+/******************************************************************************/
+/*                                                                            */
+/*    ODYSSEUS/EduCOSMOS Educational-Purpose Object Storage System            */
+/*                                                                            */
+/*    Developed by Professor Kyu-Young Whang et al.                           */
+/*                                                                            */
+/*    Database and Multimedia Laboratory                                      */
+/*                                                                            */
+/*    Computer Science Department and                                         */
+/*    Advanced Information Technology Research Center (AITrc)                 */
+/*    Korea Advanced Institute of Science and Technology (KAIST)              */
+/*                                                                            */
+/*    e-mail: kywhang@cs.kaist.ac.kr                                          */
+/*    phone: +82-42-350-7722                                                  */
+/*    fax: +82-42-350-8380                                                    */
+/*                                                                            */
+/*    Copyright (c) 1995-2013 by Kyu-Young Whang                              */
+/*                                                                            */
+/*    All rights reserved. No part of this software may be reproduced,        */
+/*    stored in a retrieval system, or transmitted, in any form or by any     */
+/*    means, electronic, mechanical, photocopying, recording, or otherwise,   */
+/*    without prior written permission of the copyright owner.                */
+/*                                                                            */
+/******************************************************************************/
+/*
+ * Module: EduBtM_SkipScan.c
+ *
+ * Description:
+ *  Skip-scan of a B+ tree of a multi-part key. The condition is given on
+ *  the key parts after the first 'nskip' parts, which have no condition:
+ *  the key values of the conditions hold the parts from the (nskip+1)-th
+ *  on, and may leave out the trailing parts, which are then not compared.
+ *  The entries having the same first 'nskip' parts form a group ordered
+ *  by the other parts; in each group the scan jumps to the start key and
+ *  leaves the group at the stop key, re-descending from the root instead
+ *  of reading the leaves in between.
+ *  The scan goes forward only; the start condition is one among SM_BOF,
+ *  SM_EQ, SM_GT, SM_GE and the stop condition is one among SM_EOF, SM_EQ,
+ *  SM_LT, SM_LE.
+ *
+ * Exports:
+ *  Four EduBtM_SkipScan(PageID*, KeyDesc*, Two, KeyValue*, Four, KeyValue*, Four, BtreeCursor*)
+ *  Four EduBtM_SkipScanNext(PageID*, KeyDesc*, Two, KeyValue*, Four, KeyValue*, Four,
+ *                           BtreeCursor*, BtreeCursor*)
+ */
+
+
+#include <string.h>
+#include "EduBtM_common.h"
+#include "BfM.h"
+#include "EduBtM_Internal.h"
+
+
+/*@ Internal Function Prototypes */
+Four edubtm_FetchNext(KeyDesc*, KeyValue*, Four, BtreeCursor*, BtreeCursor*);
+Four edubtm_SkipScan(PageID*, KeyDesc*, Two, KeyValue*, Four, KeyValue*, Four, BtreeCursor*);
+Two edubtm_TrailingParts(KeyDesc*, Two, KeyValue*);
+
+
+
+/*@================================
+ * EduBtM_SkipScan()
+ *================================*/
+/*
+ * Function: Four EduBtM_SkipScan(PageID*, KeyDesc*, Two, KeyValue*, Four,
+ *                                KeyValue*, Four, BtreeCursor*)
+ *
+ * Description:
+ *  Find the first object whose key parts after the first 'nskip' parts
+ *  satisfy the given condition. See above for detail.
+ *
+ * Returns:
+ *  error code
+ *    eBADPARAMETER_BTM
+ *    eBADCOMPOP_BTM
+ *    eNOTSUPPORTED_EDUBTM
+ *    some errors caused by function calls
+ *
+ * Side effects:
+ *  cursor  : The found ObjectID and its position in the Btree Leaf
+ */
+Four EduBtM_SkipScan(
+    PageID   *root,		/* IN The current root of the subtree */
+    KeyDesc  *kdesc,		/* IN Btree key descriptor */
+    Two      nskip,		/* IN # of the leading key parts without condition */
+    KeyValue *startKval,	/* IN key value of start condition */
+    Four     startCompOp,	/* IN comparison operator of start condition */
+    KeyValue *stopKval,		/* IN key value of stop condition */
+    Four     stopCompOp,	/* IN comparison operator of stop condition */
+    BtreeCursor *cursor)	/* OUT Btree Cursor */
+{
+    int i;
+    Four e;		   /* error number */
+
+
+    if (root == NULL || kdesc == NULL || cursor == NULL) ERR(eBADPARAMETER_BTM);
+    if (nskip < 1 || nskip >= kdesc->nparts) ERR(eBADPARAMETER_BTM);
+
+    /* Error check whether using not supported functionality by EduBtM */
+    for(i=0; i<kdesc->nparts; i++)
+    {
+        if(kdesc->kpart[i].type!=SM_INT && kdesc->kpart[i].type!=SM_VARSTRING)
+            ERR(eNOTSUPPORTED_EDUBTM);
+    }
+
+	if (kdesc->flag & KEYFLAG_BUFFERED) ERR(eNOTSUPPORTED_EDUBTM);
+
+	e = edubtm_FirstObject(root, kdesc, stopKval, SM_EOF, cursor);
+	if (e < 0) ERR(e);
+
+	e = edubtm_SkipScan(root, kdesc, nskip, startKval, startCompOp, stopKval, stopCompOp, cursor);
+	if (e < 0) ERR(e);
+
+
+    return(eNOERROR);
+
+} /* EduBtM_SkipScan() */
+
+
+
+/*@================================
+ * EduBtM_SkipScanNext()
+ *================================*/
+/*
+ * Function: Four EduBtM_SkipScanNext(PageID*, KeyDesc*, Two, KeyValue*, Four,
+ *                                    KeyValue*, Four, BtreeCursor*, BtreeCursor*)
+ *
+ * Description:
+ *  Find the next object of the skip-scan. The conditions should be the same
+ *  as those given to EduBtM_SkipScan().
+ *
+ * Returns:
+ *  error code
+ *    eBADPARAMETER_BTM
+ *    eBADCURSOR
+ *    eBADCOMPOP_BTM
+ *    eNOTSUPPORTED_EDUBTM
+ *    some errors caused by function calls
+ */
+Four EduBtM_SkipScanNext(
+    PageID                      *root,          /* IN root page's PageID */
+    KeyDesc                     *kdesc,         /* IN key descriptor */
+    Two                         nskip,          /* IN # of the leading key parts without condition */
+    KeyValue                    *startKval,     /* IN key value of start condition */
+    Four                        startCompOp,    /* IN comparison operator of start condition */
+    KeyValue                    *stopKval,      /* IN key value of stop condition */
+    Four                        stopCompOp,     /* IN comparison operator of stop condition */
+    BtreeCursor                 *current,       /* IN current B+ tree cursor */
+    BtreeCursor                 *next)          /* OUT next B+ tree cursor */
+{
+    Four                        e;              /* error number */
+
+
+    if (root == NULL || kdesc == NULL || current == NULL || next == NULL)
+		ERR(eBADPARAMETER_BTM);
+    if (nskip < 1 || nskip >= kdesc->nparts) ERR(eBADPARAMETER_BTM);
+
+    /* Is the current cursor valid? */
+    if (current->flag != CURSOR_ON && current->flag != CURSOR_EOS)
+		ERR(eBADCURSOR);
+
+    if (current->flag == CURSOR_EOS) return(eNOERROR);
+
+	if (kdesc->flag & KEYFLAG_BUFFERED) ERR(eNOTSUPPORTED_EDUBTM);
+
+	e = edubtm_FetchNext(kdesc, &current->key, SM_EOF, current, next);
+	if (e < 0) ERR(e);
+
+	e = edubtm_SkipScan(root, kdesc, nskip, startKval, startCompOp, stopKval, stopCompOp, next);
+	if (e < 0) ERR(e);
+
+
+    return(eNOERROR);
+
+} /* EduBtM_SkipScanNext() */
+
+
+
+/*@================================
+ * edubtm_SkipScan()
+ *================================*/
+/*
+ * Function: Four edubtm_SkipScan(PageID*, KeyDesc*, Two, KeyValue*, Four,
+ *                                KeyValue*, Four, BtreeCursor*)
+ *
+ * Description:
+ *  Move the cursor forward to the first entry satisfying the condition,
+ *  starting from the entry of the cursor. An entry before the start key
+ *  of its group makes the cursor jump to the start key (or to the stop key
+ *  of SM_EQ), and an entry after the stop key makes it jump to the next
+ *  group.
+ *
+ * Returns:
+ *  Error code
+ *    eBADPARAMETER_BTM
+ *    eBADCOMPOP_BTM
+ *    some errors caused by function calls
+ *
+ * Side effects:
+ *  cursor : the entry found or CURSOR_EOS
+ */
+Four edubtm_SkipScan(
+    PageID              *root,          /* IN root page's PageID */
+    KeyDesc             *kdesc,         /* IN key descriptor */
+    Two                 nskip,          /* IN # of the leading key parts without condition */
+    KeyValue            *startKval,     /* IN key value of start condition */
+    Four                startCompOp,    /* IN comparison operator of start condition */
+    KeyValue            *stopKval,      /* IN key value of stop condition */
+    Four                stopCompOp,     /* IN comparison operator of stop condition */
+    BtreeCursor         *cursor)        /* INOUT Btree Cursor */
+{
+    Four                e;              /* error number */
+    Four                cmp;            /* result of comparison */
+    Two                 i;              /* index for # of key parts */
+    Two                 offset;         /* length of the leading parts */
+    Two                 nStart;         /* # of the key parts of 'startKval' */
+    Two                 nStop;          /* # of the key parts of 'stopKval' */
+    Two                 nJump;          /* # of the key parts of 'jump' */
+    Four                jumpOp;         /* comparison operator of the jump */
+    KeyValue            *jump;          /* trailing parts to jump to in the group */
+    Boolean             leave;          /* TRUE if the rest of the group fails */
+    KeyDesc             pdesc;          /* key descriptor of the leading parts */
+    KeyDesc             tdesc;          /* key descriptor of the trailing parts */
+    KeyValue            rest;           /* the trailing parts of the current key */
+    KeyValue            bound;          /* key value to jump to */
+
+
+	if (startCompOp != SM_BOF && startCompOp != SM_EQ &&
+	    startCompOp != SM_GT && startCompOp != SM_GE) ERR(eBADCOMPOP_BTM);
+	if (stopCompOp != SM_EOF && stopCompOp != SM_EQ &&
+	    stopCompOp != SM_LT && stopCompOp != SM_LE) ERR(eBADCOMPOP_BTM);
+
+	nStart = nStop = 0;
+	if (startCompOp != SM_BOF)
+	{
+		if (startKval == NULL) ERR(eBADPARAMETER_BTM);
+		nStart = edubtm_TrailingParts(kdesc, nskip, startKval);
+		if (nStart == 0) ERR(eBADPARAMETER_BTM);
+	}
+	if (stopCompOp != SM_EOF)
+	{
+		if (stopKval == NULL) ERR(eBADPARAMETER_BTM);
+		nStop = edubtm_TrailingParts(kdesc, nskip, stopKval);
+		if (nStop == 0) ERR(eBADPARAMETER_BTM);
+	}
+
+	pdesc = *kdesc;
+	tdesc = *kdesc;
+	tdesc.nparts = kdesc->nparts - nskip;
+	for (i = 0; i < tdesc.nparts; i++)
+		tdesc.kpart[i] = kdesc->kpart[nskip+i];
+
+	while (cursor->flag == CURSOR_ON)
+	{
+		offset = edubtm_KeyPartsLength(kdesc, &cursor->key, nskip);
+		rest.len = cursor->key.len - offset;
+		memcpy(rest.val, &cursor->key.val[offset], rest.len);
+		jump = NULL;
+		leave = FALSE;
+
+		if (startCompOp != SM_BOF)
+		{
+			tdesc.nparts = nStart;
+			cmp = edubtm_KeyCompare(&tdesc, &rest, startKval);
+
+			if (cmp == LESS || (cmp == EQUAL && startCompOp == SM_GT))
+			{
+				jump = startKval;
+				nJump = nStart;
+				jumpOp = (startCompOp == SM_GT) ? SM_GT : SM_GE;
+			}
+			else if (cmp == GREATER && startCompOp == SM_EQ)
+				leave = TRUE;
+		}
+
+		if (jump == NULL && !leave && stopCompOp != SM_EOF)
+		{
+			tdesc.nparts = nStop;
+			cmp = edubtm_KeyCompare(&tdesc, &rest, stopKval);
+
+			if (cmp == LESS && stopCompOp == SM_EQ)
+			{
+				jump = stopKval;
+				nJump = nStop;
+				jumpOp = SM_GE;
+			}
+			else
+				leave = (stopCompOp == SM_EQ && cmp != EQUAL) ||
+					(stopCompOp == SM_LT && cmp != LESS) ||
+					(stopCompOp == SM_LE && cmp == GREATER);
+		}
+
+		if (jump != NULL)
+		{
+			/* Jump to the key in this group. */
+			if (offset + jump->len > MAXKEYLEN) ERR(eBADPARAMETER_BTM);
+			bound.len = offset + jump->len;
+			memcpy(bound.val, cursor->key.val, offset);
+			memcpy(&bound.val[offset], jump->val, jump->len);
+
+			pdesc.nparts = nskip + nJump;
+			e = edubtm_SeekPrefix(root, &pdesc, &bound, jumpOp, cursor);
+			if (e < 0) ERR(e);
+		}
+		else if (leave)
+		{
+			/* Jump to the next group. */
+			BTM_COPY_KEY(&bound, &cursor->key);
+			pdesc.nparts = nskip;
+			e = edubtm_SeekPrefix(root, &pdesc, &bound, SM_GT, cursor);
+			if (e < 0) ERR(e);
+		}
+		else
+			break;
+	}
+
+
+    return(eNOERROR);
+
+} /* edubtm_SkipScan() */
+
+
+
+/*@================================
+ * edubtm_TrailingParts()
+ *================================*/
+/*
+ * Function: Two edubtm_TrailingParts(KeyDesc*, Two, KeyValue*)
+ *
+ * Description:
+ *  Return the # of the key parts, from the (nskip+1)-th on, held in the
+ *  key value.
+ *
+ * Returns:
+ *  # of the key parts
+ */
+Two edubtm_TrailingParts(
+    KeyDesc             *kdesc,         /* IN key descriptor */
+    Two                 nskip,          /* IN # of the leading key parts */
+    KeyValue            *kval)          /* IN key value of the trailing parts */
+{
+    Two                 i;              /* index for # of key parts */
+    Two                 j;              /* position in the key value */
+    Two                 len;            /* string length */
+
+
+	for (i = nskip, j = 0; i < kdesc->nparts && j < kval->len; i++)
+	{
+		if (kdesc->kpart[i].type == SM_VARSTRING)
+		{
+			memcpy(&len, &kval->val[j], sizeof(Two));
+			j += sizeof(Two) + len;
+		}
+		else
+			j += kdesc->kpart[i].length;
+	}
+
+	return(i - nskip);
+
+} /* edubtm_TrailingParts() */
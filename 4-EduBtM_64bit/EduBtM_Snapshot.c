@@ -0,0 +1,462 @@
+/******************************************************************************/
+/*                                                                            */
+/*    ODYSSEUS/EduCOSMOS Educational-Purpose Object Storage System            */
+/*                                                                            */
+/*    Developed by Professor Kyu-Young Whang et al.                           */
+/*                                                                            */
+/*    Database and Multimedia Laboratory                                      */
+/*                                                                            */
+/*    Computer Science Department and                                         */
+/*    Advanced Information Technology Research Center (AITrc)                 */
+/*    Korea Advanced Institute of Science and Technology (KAIST)              */
+/*                                                                            */
+/*    e-mail: kywhang@cs.kaist.ac.kr                                          */
+/*    phone: +82-42-350-7722                                                  */
+/*    fax: +82-42-350-8380                                                    */
+/*                                                                            */
+/*    Copyright (c) 1995-2013 by Kyu-Young Whang                              */
+/*                                                                            */
+/*    All rights reserved. No part of this software may be reproduced,        */
+/*    stored in a retrieval system, or transmitted, in any form or by any     */
+/*    means, electronic, mechanical, photocopying, recording, or otherwise,   */
+/*    without prior written permission of the copyright owner.                */
+/*                                                                            */
+/******************************************************************************/
+/*
+ * Module: EduBtM_Snapshot.c
+ *
+ * Description :
+ *  Read-only snapshots of a B+ tree index. EduBtM_ExportSnapshot() writes
+ *  the entries of an index into a file in a compact layout with no page
+ *  structure, and the readers map the file into their memory and search it
+ *  directly; no buffer, no latch and no copy are needed, and the processes
+ *  mapping the same file share its pages in the memory.
+ *
+ * Exports:
+ *  Four EduBtM_ExportSnapshot(PageID*, KeyDesc*, char*)
+ *  Four EduBtM_OpenSnapshot(char*, BtreeSnapshot*)
+ *  Four EduBtM_CloseSnapshot(BtreeSnapshot*)
+ *  Four EduBtM_SnapshotFetch(BtreeSnapshot*, KeyValue*, Four, KeyValue*, Four, BtreeSnapshotCursor*)
+ *  Four EduBtM_SnapshotFetchNext(BtreeSnapshot*, KeyValue*, Four, BtreeSnapshotCursor*, BtreeSnapshotCursor*)
+ */
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "EduBtM_common.h"
+#include "EduBtM_Internal.h"
+#include "EduBtM.h"
+
+
+/*@ Internal Function Prototypes */
+Four edubtm_WriteSnapshot(char*, BtreeSnapshotHdr*, char*);
+
+
+
+/*@================================
+ * EduBtM_ExportSnapshot()
+ *================================*/
+/*
+ * Function: Four EduBtM_ExportSnapshot(PageID*, KeyDesc*, char*)
+ *
+ * Description:
+ *  Write all the entries of the index into the file 'fileName'. The first
+ *  scan finds the number of the entries and the longest key, which fix
+ *  the size of an entry; the second scan puts each entry in its place in
+ *  the Eytzinger order. The file is written under a temporary name and
+ *  renamed, so a reader never sees a partial file.
+ *
+ * Returns:
+ *  error code
+ *    eBADPARAMETER_BTM
+ *    eMEMORYALLOCERR_BTM
+ *    eSNAPSHOTIO_BTM
+ *    some errors caused by function calls
+ */
+Four EduBtM_ExportSnapshot(
+    PageID              *root,          /* IN the root of Btree */
+    KeyDesc             *kdesc,         /* IN key descriptor */
+    char                *fileName)      /* IN name of the snapshot file */
+{
+    Four                e;              /* error number */
+    Four                k;              /* entry No. */
+    Two                 maxKlen = 0;    /* length of the longest key */
+    double              size;           /* size of the file */
+    char                *entries;       /* the entries in the Eytzinger order */
+    btm_SnapshotEntry   *entry;         /* an entry */
+    BtreeSnapshot       snap;           /* the snapshot being built */
+    BtreeSnapshotHdr    hdr;            /* header of the snapshot */
+    BtreeCursor         cursor;         /* a cursor on the index */
+    BtreeCursor         next;           /* the next cursor */
+    KeyValue            noKval;         /* key value for SM_BOF and SM_EOF */
+
+
+    /*@ check parameters */
+
+    if (root == NULL) ERR(eBADPARAMETER_BTM);
+
+    if (kdesc == NULL) ERR(eBADPARAMETER_BTM);
+
+    if (fileName == NULL) ERR(eBADPARAMETER_BTM);
+
+	memset(&hdr, 0, sizeof(BtreeSnapshotHdr));
+	hdr.magic = BTM_SNAPSHOT_MAGIC;
+	hdr.version = BTM_SNAPSHOT_VERSION;
+	hdr.kdesc = *kdesc;
+	memset(&noKval, 0, sizeof(KeyValue));
+
+	/* count the entries */
+	e = EduBtM_Fetch(root, kdesc, &noKval, SM_BOF, &noKval, SM_EOF, &cursor);
+	if (e < 0) ERR(e);
+
+	while (cursor.flag == CURSOR_ON)
+	{
+		hdr.nEntries++;
+		if (cursor.key.len > maxKlen) maxKlen = cursor.key.len;
+		hdr.includedLen = cursor.includedLen;
+
+		e = EduBtM_FetchNext(root, kdesc, &noKval, SM_EOF, &cursor, &next);
+		if (e < 0) ERR(e);
+		cursor = next;
+	}
+
+	hdr.entrySize = ALIGNED_LENGTH(sizeof(Two) + maxKlen) + sizeof(ObjectID) + ALIGNED_LENGTH(hdr.includedLen);
+
+	size = (double)PAGESIZE + (double)hdr.nEntries * hdr.entrySize;
+	if (size > 0x7fffffff) ERR(eNOTSUPPORTED_EDUBTM);
+
+	entries = (char*)calloc(hdr.nEntries > 0 ? hdr.nEntries : 1, hdr.entrySize);
+	if (entries == NULL) ERR(eMEMORYALLOCERR_BTM);
+
+	snap.hdr = &hdr;
+	snap.entries = entries;
+
+	/* the keys come in ascending order; so does the in-order walk */
+	e = EduBtM_Fetch(root, kdesc, &noKval, SM_BOF, &noKval, SM_EOF, &cursor);
+	if (e < 0) { free(entries); ERR(e); }
+
+	for (k = edubtm_SnapshotFirst(hdr.nEntries); k != 0 && cursor.flag == CURSOR_ON;
+			k = edubtm_SnapshotNext(hdr.nEntries, k))
+	{
+		entry = BTM_SNAPSHOT_ENTRY(&snap, k);
+		entry->klen = cursor.key.len;
+		memcpy(entry->kval, cursor.key.val, cursor.key.len);
+		memcpy(BTM_SNAPSHOT_OID(&snap, entry), &cursor.oid, sizeof(ObjectID));
+		memcpy((char*)BTM_SNAPSHOT_OID(&snap, entry) + sizeof(ObjectID), cursor.included, hdr.includedLen);
+
+		e = EduBtM_FetchNext(root, kdesc, &noKval, SM_EOF, &cursor, &next);
+		if (e < 0) { free(entries); ERR(e); }
+		cursor = next;
+	}
+
+	e = edubtm_WriteSnapshot(fileName, &hdr, entries);
+	free(entries);
+	if (e < 0) ERR(e);
+
+
+    return(eNOERROR);
+
+} /* EduBtM_ExportSnapshot() */
+
+
+
+/*@================================
+ * edubtm_WriteSnapshot()
+ *================================*/
+/*
+ * Function: Four edubtm_WriteSnapshot(char*, BtreeSnapshotHdr*, char*)
+ *
+ * Description:
+ *  Write the header page and the entries into the file 'fileName'.
+ *
+ * Returns:
+ *  error code
+ *    eMEMORYALLOCERR_BTM
+ *    eSNAPSHOTIO_BTM
+ */
+Four edubtm_WriteSnapshot(
+    char                *fileName,      /* IN name of the snapshot file */
+    BtreeSnapshotHdr    *hdr,           /* IN header of the snapshot */
+    char                *entries)       /* IN the entries */
+{
+    int                 fd;             /* file descriptor */
+    char                *tmpName;       /* name of the file being written */
+    char                *hdrPage;       /* the first page of the file */
+    size_t              size;           /* size of the entries */
+    ssize_t             n;              /* # of bytes written */
+    Boolean             ok;             /* TRUE if all are written */
+
+
+	tmpName = (char*)malloc(strlen(fileName) + 5);
+	if (tmpName == NULL) ERR(eMEMORYALLOCERR_BTM);
+	sprintf(tmpName, "%s.tmp", fileName);
+
+	hdrPage = (char*)calloc(1, PAGESIZE);
+	if (hdrPage == NULL) { free(tmpName); ERR(eMEMORYALLOCERR_BTM); }
+	memcpy(hdrPage, hdr, sizeof(BtreeSnapshotHdr));
+
+	fd = open(tmpName, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+	if (fd < 0) { free(hdrPage); free(tmpName); ERR(eSNAPSHOTIO_BTM); }
+
+	ok = (write(fd, hdrPage, PAGESIZE) == PAGESIZE);
+	size = (size_t)hdr->nEntries * hdr->entrySize;
+	while (ok && size > 0)
+	{
+		n = write(fd, entries, size);
+		if (n <= 0) ok = FALSE;
+		else { entries += n; size -= n; }
+	}
+	if (fsync(fd) < 0) ok = FALSE;
+	if (close(fd) < 0) ok = FALSE;
+	free(hdrPage);
+
+	if (ok && rename(tmpName, fileName) < 0) ok = FALSE;
+	if (!ok) unlink(tmpName);
+	free(tmpName);
+
+	if (!ok) ERR(eSNAPSHOTIO_BTM);
+
+	return(eNOERROR);
+
+} /* edubtm_WriteSnapshot() */
+
+
+
+/*@================================
+ * EduBtM_OpenSnapshot()
+ *================================*/
+/*
+ * Function: Four EduBtM_OpenSnapshot(char*, BtreeSnapshot*)
+ *
+ * Description:
+ *  Map the snapshot file into the memory for reading. Nothing is read
+ *  until a search touches it.
+ *
+ * Returns:
+ *  error code
+ *    eBADPARAMETER_BTM
+ *    eSNAPSHOTIO_BTM
+ *    eBADSNAPSHOT_BTM
+ */
+Four EduBtM_OpenSnapshot(
+    char                *fileName,      /* IN name of the snapshot file */
+    BtreeSnapshot       *snap)          /* OUT the opened snapshot */
+{
+    int                 fd;             /* file descriptor */
+    struct stat         st;             /* status of the file */
+    void                *base;          /* start of the mapping */
+    BtreeSnapshotHdr    *hdr;           /* header of the snapshot */
+
+
+    /*@ check parameters */
+
+    if (fileName == NULL) ERR(eBADPARAMETER_BTM);
+
+    if (snap == NULL) ERR(eBADPARAMETER_BTM);
+
+	fd = open(fileName, O_RDONLY);
+	if (fd < 0) ERR(eSNAPSHOTIO_BTM);
+
+	if (fstat(fd, &st) < 0) { close(fd); ERR(eSNAPSHOTIO_BTM); }
+	if (st.st_size < PAGESIZE || st.st_size > 0x7fffffff) { close(fd); ERR(eBADSNAPSHOT_BTM); }
+
+	base = mmap(NULL, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+	close(fd);
+	if (base == MAP_FAILED) ERR(eSNAPSHOTIO_BTM);
+
+	hdr = (BtreeSnapshotHdr*)base;
+	if (hdr->magic != BTM_SNAPSHOT_MAGIC || hdr->version != BTM_SNAPSHOT_VERSION ||
+			hdr->nEntries < 0 || hdr->entrySize <= 0 ||
+			st.st_size != (double)PAGESIZE + (double)hdr->nEntries * hdr->entrySize)
+	{
+		munmap(base, st.st_size);
+		ERR(eBADSNAPSHOT_BTM);
+	}
+
+	snap->hdr = hdr;
+	snap->entries = (char*)base + PAGESIZE;
+	snap->size = st.st_size;
+
+
+    return(eNOERROR);
+
+} /* EduBtM_OpenSnapshot() */
+
+
+
+/*@================================
+ * EduBtM_CloseSnapshot()
+ *================================*/
+/*
+ * Function: Four EduBtM_CloseSnapshot(BtreeSnapshot*)
+ *
+ * Description:
+ *  Unmap the snapshot. The cursors on it should not be used any more.
+ *
+ * Returns:
+ *  error code
+ *    eBADPARAMETER_BTM
+ *    eSNAPSHOTIO_BTM
+ */
+Four EduBtM_CloseSnapshot(
+    BtreeSnapshot       *snap)          /* INOUT the snapshot */
+{
+
+    /*@ check parameters */
+
+    if (snap == NULL || snap->hdr == NULL) ERR(eBADPARAMETER_BTM);
+
+	if (munmap(snap->hdr, snap->size) < 0) ERR(eSNAPSHOTIO_BTM);
+
+	snap->hdr = NULL;
+	snap->entries = NULL;
+
+
+    return(eNOERROR);
+
+} /* EduBtM_CloseSnapshot() */
+
+
+
+/*@================================
+ * EduBtM_SnapshotFetch()
+ *================================*/
+/*
+ * Function: Four EduBtM_SnapshotFetch(BtreeSnapshot*, KeyValue*, Four, KeyValue*, Four,
+ *                                     BtreeSnapshotCursor*)
+ *
+ * Description:
+ *  Find the first entry satisfying the given condition as EduBtM_Fetch()
+ *  does on the index; the comparison operator is one among SM_BOF, SM_EOF,
+ *  SM_EQ, SM_LT, SM_LE, SM_GT, SM_GE. The snapshot is never changed, so
+ *  any number of threads and processes can search it at the same time.
+ *
+ * Returns:
+ *  error code
+ *    eBADPARAMETER_BTM
+ *    eBADCOMPOP_BTM
+ *
+ * Side effects:
+ *  cursor  : the found entry, or CURSOR_EOS in 'flag'
+ */
+Four EduBtM_SnapshotFetch(
+    BtreeSnapshot       *snap,          /* IN the snapshot */
+    KeyValue            *startKval,     /* IN key value of start condition */
+    Four                startCompOp,    /* IN comparison operator of start condition */
+    KeyValue            *stopKval,      /* IN key value of stop condition */
+    Four                stopCompOp,     /* IN comparison operator of stop condition */
+    BtreeSnapshotCursor *cursor)        /* OUT the cursor */
+{
+    Four                k;              /* entry No. */
+    Four                n;              /* # of entries */
+
+
+    /*@ check parameters */
+
+    if (snap == NULL || snap->hdr == NULL) ERR(eBADPARAMETER_BTM);
+
+    if (cursor == NULL) ERR(eBADPARAMETER_BTM);
+
+	n = snap->hdr->nEntries;
+
+	switch (startCompOp)
+	{
+	  case SM_BOF:
+		k = edubtm_SnapshotFirst(n);
+		break;
+
+	  case SM_EOF:
+		k = edubtm_SnapshotLast(n);
+		break;
+
+	  case SM_EQ:
+		k = edubtm_SnapshotSearch(snap, startKval, FALSE);
+		if (k != 0 && edubtm_KeyCompare(&snap->hdr->kdesc,
+				(KeyValue*)&BTM_SNAPSHOT_ENTRY(snap, k)->klen, startKval) != EQUAL)
+			k = 0;
+		break;
+
+	  case SM_GE:
+	  case SM_GT:
+		k = edubtm_SnapshotSearch(snap, startKval, startCompOp == SM_GT);
+		break;
+
+	  case SM_LT:
+	  case SM_LE:
+		k = edubtm_SnapshotSearch(snap, startKval, startCompOp == SM_LE);
+		k = (k == 0) ? edubtm_SnapshotLast(n) : edubtm_SnapshotPrev(n, k);
+		break;
+
+	  default:
+		ERR(eBADCOMPOP_BTM);
+	}
+
+	edubtm_SnapshotSetCursor(snap, k, stopKval, stopCompOp, cursor);
+
+
+    return(eNOERROR);
+
+} /* EduBtM_SnapshotFetch() */
+
+
+
+/*@================================
+ * EduBtM_SnapshotFetchNext()
+ *================================*/
+/*
+ * Function: Four EduBtM_SnapshotFetchNext(BtreeSnapshot*, KeyValue*, Four,
+ *                                         BtreeSnapshotCursor*, BtreeSnapshotCursor*)
+ *
+ * Description:
+ *  Find the next entry satisfying the stop condition as EduBtM_FetchNext()
+ *  does; the scan goes forward for SM_LT, SM_LE and SM_EOF, and backward
+ *  for SM_GT, SM_GE and SM_BOF.
+ *
+ * Returns:
+ *  error code
+ *    eBADPARAMETER_BTM
+ *    eBADCURSOR
+ *
+ * Side effects:
+ *  next    : the next entry, or CURSOR_EOS in 'flag'
+ */
+Four EduBtM_SnapshotFetchNext(
+    BtreeSnapshot       *snap,          /* IN the snapshot */
+    KeyValue            *kval,          /* IN key value of stop condition */
+    Four                compOp,         /* IN comparison operator of stop condition */
+    BtreeSnapshotCursor *current,       /* IN the current cursor */
+    BtreeSnapshotCursor *next)          /* OUT the next cursor */
+{
+    Four                k;              /* entry No. */
+    Four                n;              /* # of entries */
+
+
+    /*@ check parameters */
+
+    if (snap == NULL || snap->hdr == NULL) ERR(eBADPARAMETER_BTM);
+
+    if (current == NULL || next == NULL) ERR(eBADPARAMETER_BTM);
+
+	n = snap->hdr->nEntries;
+
+	if (current->flag != CURSOR_ON || current->pos < 1 || current->pos > n) ERR(eBADCURSOR);
+
+	/* the keys are unique */
+	if (compOp == SM_EQ)
+		k = 0;
+	else if (compOp == SM_LT || compOp == SM_LE || compOp == SM_EOF)
+		k = edubtm_SnapshotNext(n, current->pos);
+	else
+		k = edubtm_SnapshotPrev(n, current->pos);
+
+	edubtm_SnapshotSetCursor(snap, k, kval, compOp, next);
+
+
+    return(eNOERROR);
+
+} /* EduBtM_SnapshotFetchNext() */
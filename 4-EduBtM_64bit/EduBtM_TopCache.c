@@ -0,0 +1,151 @@
+/******************************************************************************/
+/*                                                                            */
+/*    ODYSSEUS/EduCOSMOS Educational-Purpose Object Storage System            */
+/*                                                                            */
+/*    Developed by Professor Kyu-Young Whang et al.                           */
+/*                                                                            */
+/*    Database and Multimedia Laboratory                                      */
+/*                                                                            */
+/*    Computer Science Department and                                         */
+/*    Advanced Information Technology Research Center (AITrc)                 */
+/*    Korea Advanced Institute of Science and Technology (KAIST)              */
+/*                                                                            */
+/*    e-mail: kywhang@cs.kaist.ac.kr                                          */
+/*    phone: +82-42-350-7722                                                  */
+/*    fax: +82-42-350-8380                                                    */
+/*                                                                            */
+/*    Copyright (c) 1995-2013 by Kyu-Young Whang                              */
+/*                                                                            */
+/*    All rights reserved. No part of this software may be reproduced,        */
+/*    stored in a retrieval system, or transmitted, in any form or by any     */
+/*    means, electronic, mechanical, photocopying, recording, or otherwise,   */
+/*    without prior written permission of the copyright owner.                */
+/*                                                                            */
+/******************************************************************************/
+/*
+ * Module: EduBtM_TopCache.c
+ *
+ * Description :
+ *  Keep the top levels of the internal pages of an index decoded in the
+ *  memory. EduBtM_Fetch() goes down those levels without fixing their
+ *  pages in the buffer and without the slot indirection of the pages.
+ *  The cache stays coherent: a split, a merge or any other change of a
+ *  mirrored page marks it invalid, and the next search builds it again.
+ *
+ * Exports:
+ *  Four EduBtM_CacheTopLevels(PageID*, KeyDesc*, Four)
+ *  Four EduBtM_UncacheTopLevels(PageID*)
+ */
+
+
+#include "EduBtM_common.h"
+#include "EduBtM_Internal.h"
+#include "EduBtM.h"
+
+
+
+/*@================================
+ * EduBtM_CacheTopLevels()
+ *================================*/
+/*
+ * Function: Four EduBtM_CacheTopLevels(PageID*, KeyDesc*, Four)
+ *
+ * Description:
+ *  Mirror the top 'nLevels' levels of the internal pages of the index in
+ *  the memory; the root is the first level. An index cached already gets
+ *  the new number of levels. The leaves are never cached.
+ *
+ * Returns:
+ *  error code
+ *    eBADPARAMETER_BTM
+ *    eNOTSUPPORTED_EDUBTM
+ *    eTOOMANYTOPCACHES_BTM
+ *    some errors caused by function calls
+ *
+ * Note:
+ *  A B-epsilon index (KEYFLAG_BUFFERED) is not supported since a search
+ *  has to read the message buffers of its internal pages.
+ */
+Four EduBtM_CacheTopLevels(
+    PageID              *root,          /* IN root of the index */
+    KeyDesc             *kdesc,         /* IN key descriptor */
+    Four                nLevels)        /* IN # of levels to cache */
+{
+    Four                e;              /* error number */
+    Four                i;              /* index */
+    btm_TopCache        *cache;         /* cache of the index */
+
+
+    /*@ check parameters */
+
+    if (root == NULL) ERR(eBADPARAMETER_BTM);
+
+    if (kdesc == NULL) ERR(eBADPARAMETER_BTM);
+
+    if (nLevels <= 0) ERR(eBADPARAMETER_BTM);
+
+    /* Error check whether using not supported functionality by EduBtM */
+    for(i=0; i<kdesc->nparts; i++)
+    {
+        if(kdesc->kpart[i].type!=SM_INT && kdesc->kpart[i].type!=SM_VARSTRING)
+            ERR(eNOTSUPPORTED_EDUBTM);
+    }
+
+	if (kdesc->flag & KEYFLAG_BUFFERED) ERR(eNOTSUPPORTED_EDUBTM);
+
+	cache = edubtm_TopCacheFind(root);
+	if (cache == NULL)
+	{
+		for (i = 0; i < BTM_MAXTOPCACHES; i++)
+			if (edubtm_topCaches[i].nLevels == 0) break;
+		if (i == BTM_MAXTOPCACHES) ERR(eTOOMANYTOPCACHES_BTM);
+
+		cache = &edubtm_topCaches[i];
+		cache->root = *root;
+		cache->nodes = NULL;
+		cache->nNodes = 0;
+		edubtm_nTopCaches++;
+	}
+
+	cache->kdesc = *kdesc;
+	cache->nLevels = nLevels;
+
+	e = edubtm_TopCacheBuild(cache);
+	if (e < 0)
+	{
+		edubtm_TopCacheDrop(root);
+		ERR(e);
+	}
+
+	return(eNOERROR);
+
+} /* EduBtM_CacheTopLevels() */
+
+
+
+/*@================================
+ * EduBtM_UncacheTopLevels()
+ *================================*/
+/*
+ * Function: Four EduBtM_UncacheTopLevels(PageID*)
+ *
+ * Description:
+ *  Free the cache of the top levels of the index. Nothing is done for an
+ *  index not cached.
+ *
+ * Returns:
+ *  error code
+ *    eBADPARAMETER_BTM
+ */
+Four EduBtM_UncacheTopLevels(
+    PageID              *root)          /* IN root of the index */
+{
+    /*@ check parameters */
+
+    if (root == NULL) ERR(eBADPARAMETER_BTM);
+
+	edubtm_TopCacheDrop(root);
+
+	return(eNOERROR);
+
+} /* EduBtM_UncacheTopLevels() */
@@ -0,0 +1,415 @@
+/******************************************************************************/
+/*                                                                            */
+/*    ODYSSEUS/EduCOSMOS Educational-Purpose Object Storage System            */
+/*                                                                            */
+/*    Developed by Professor Kyu-Young Whang et al.                           */
+/*                                                                            */
+/*    Database and Multimedia Laboratory                                      */
+/*                                                                            */
+/*    Computer Science Department and                                         */
+/*    Advanced Information Technology Research Center (AITrc)                 */
+/*    Korea Advanced Institute of Science and Technology (KAIST)              */
+/*                                                                            */
+/*    e-mail: kywhang@cs.kaist.ac.kr                                          */
+/*    phone: +82-42-350-7722                                                  */
+/*    fax: +82-42-350-8380                                                    */
+/*                                                                            */
+/*    Copyright (c) 1995-2013 by Kyu-Young Whang                              */
+/*                                                                            */
+/*    All rights reserved. No part of this software may be reproduced,        */
+/*    stored in a retrieval system, or transmitted, in any form or by any     */
+/*    means, electronic, mechanical, photocopying, recording, or otherwise,   */
+/*    without prior written permission of the copyright owner.                */
+/*                                                                            */
+/******************************************************************************/
+/*
+ * Module: EduBtM_Trace.c
+ *
+ * Description :
+ *  Trace the index operations to see where their time goes. While the
+ *  tracing is on, EduBtM_Fetch(), EduBtM_FetchNext(), EduBtM_InsertCovering()
+ *  and EduBtM_DeleteObject() are counted with the page fixes they make and
+ *  the keys their searches in the pages compare (edubtm_nProbes), and the latency of every BTM_TRACE_SAMPLEPERIOD-th
+ *  operation of each kind is put into a log2 histogram. The page fixes are
+ *  also counted by the level of the page and by whether the page was found
+ *  in the buffer; the splits, the merges and the redistributions are counted
+ *  where they happen.
+ *
+ *  The level of a fixed page is the number of the descents made to reach
+ *  it, which the recursive functions keep in 'edubtm_traceDepth'. A leaf
+ *  reached through the chain of the leaves without a descent, as by
+ *  EduBtM_FetchNext(), is charged to the level of the last leaf reached by
+ *  a descent.
+ *
+ *  The B+ tree code fixes its pages by edubtm_GetTrain(), which counts
+ *  them in 'edubtm_nFixes' for the benchmarks and passes them to
+ *  edubtm_TraceFix() while the tracing is on. When the tracing is off, the
+ *  only cost is a test of 'edubtm_tracing' per page fix. An operation
+ *  ending with an error is ended by ERRT() and counted as the others are,
+ *  so no later page fix is charged to it.
+ *
+ * Exports:
+ *  Four EduBtM_StartTrace(FILE*, Four)
+ *  Four EduBtM_StopTrace(void)
+ *  Four EduBtM_GetTrace(BtreeTrace*)
+ *  Four EduBtM_DumpTrace(FILE*)
+ */
+
+
+#include <string.h>
+#include <time.h>
+#include "EduBtM_common.h"
+#include "BfM.h"
+#include "EduBtM_Internal.h"
+
+
+/* # of the pages fixed by EduBtM; for the benchmarks */
+Four edubtm_nFixes = 0;
+
+/* TRUE while the tracing is on */
+Boolean edubtm_tracing = FALSE;
+
+/* the counters of the tracing */
+BtreeTrace edubtm_trace;
+
+/* # of the descents made by the current operation */
+Two edubtm_traceDepth = 0;
+
+/* the current operation; -1 if none is traced */
+Four edubtm_traceOp = -1;
+
+/* level of the last leaf reached by a descent */
+Two edubtm_traceLeafLevel = 0;
+
+/* edubtm_nProbes when the current operation started */
+Four edubtm_traceProbes = 0;
+
+/* TRUE if the latency of the current operation is measured */
+Boolean edubtm_traceSampling = FALSE;
+
+/* start time of the current operation if it is measured */
+struct timespec edubtm_traceStart;
+
+/* # of the operations ended since EduBtM_StartTrace() */
+Eight edubtm_traceNEnded = 0;
+
+/* where and how often the counters are dumped */
+FILE *edubtm_traceDumpFile = NULL;
+Four edubtm_traceDumpPeriod = 0;
+
+/* names of the operations for EduBtM_DumpTrace() */
+static char *edubtm_traceOpNames[BTM_TRACE_NOPS] = { "fetch", "fetchnext", "insert", "delete" };
+
+
+
+/*@================================
+ * EduBtM_StartTrace()
+ *================================*/
+/*
+ * Function: Four EduBtM_StartTrace(FILE*, Four)
+ *
+ * Description :
+ *  Reset the counters and start the tracing. If 'dumpFile' is not NULL, the
+ *  counters are written to it by EduBtM_DumpTrace() every 'dumpPeriod'
+ *  traced operations.
+ *
+ * Returns:
+ *  error code
+ *    eBADPARAMETER_BTM
+ */
+Four EduBtM_StartTrace(
+    FILE                *dumpFile,      /* IN file to dump the counters periodically; NULL for none */
+    Four                dumpPeriod)     /* IN # of the operations between the dumps */
+{
+	if (dumpFile != NULL && dumpPeriod <= 0) ERR(eBADPARAMETER_BTM);
+
+	memset(&edubtm_trace, 0, sizeof(BtreeTrace));
+	edubtm_traceOp = -1;
+	edubtm_traceDepth = 0;
+	edubtm_traceLeafLevel = 0;
+	edubtm_traceSampling = FALSE;
+	edubtm_traceNEnded = 0;
+	edubtm_traceDumpFile = dumpFile;
+	edubtm_traceDumpPeriod = dumpPeriod;
+	edubtm_tracing = TRUE;
+
+	return(eNOERROR);
+
+} /* EduBtM_StartTrace() */
+
+
+
+/*@================================
+ * EduBtM_StopTrace()
+ *================================*/
+/*
+ * Function: Four EduBtM_StopTrace(void)
+ *
+ * Description :
+ *  Stop the tracing. The counters are kept for EduBtM_GetTrace() and
+ *  EduBtM_DumpTrace().
+ *
+ * Returns:
+ *  error code
+ */
+Four EduBtM_StopTrace(void)
+{
+	edubtm_tracing = FALSE;
+	edubtm_traceOp = -1;
+	edubtm_traceDumpFile = NULL;
+
+	return(eNOERROR);
+
+} /* EduBtM_StopTrace() */
+
+
+
+/*@================================
+ * EduBtM_GetTrace()
+ *================================*/
+/*
+ * Function: Four EduBtM_GetTrace(BtreeTrace*)
+ *
+ * Description :
+ *  Copy the counters of the tracing into 'trace'.
+ *
+ * Returns:
+ *  error code
+ *    eBADPARAMETER_BTM
+ */
+Four EduBtM_GetTrace(
+    BtreeTrace          *trace)         /* OUT the counters */
+{
+	if (trace == NULL) ERR(eBADPARAMETER_BTM);
+
+	*trace = edubtm_trace;
+
+	return(eNOERROR);
+
+} /* EduBtM_GetTrace() */
+
+
+
+/*@================================
+ * EduBtM_DumpTrace()
+ *================================*/
+/*
+ * Function: Four EduBtM_DumpTrace(FILE*)
+ *
+ * Description :
+ *  Write the counters of the tracing to 'fp' in a readable form. The empty
+ *  levels and the empty buckets of the histograms are left out.
+ *
+ * Returns:
+ *  error code
+ *    eBADPARAMETER_BTM
+ */
+Four EduBtM_DumpTrace(
+    FILE                *fp)            /* IN file to write to */
+{
+	Four                op;             /* index of an operation */
+	Four                i;              /* index */
+	BtreeTrace          *t = &edubtm_trace;
+
+
+	if (fp == NULL) ERR(eBADPARAMETER_BTM);
+
+	fprintf(fp, "btree trace:\n");
+	for (op = 0; op < BTM_TRACE_NOPS; op++)
+	{
+		if (t->nOps[op] == 0) continue;
+
+		fprintf(fp, "  %-9s ops %ld  fixes/op %.2f  comparisons/op %.2f\n", edubtm_traceOpNames[op],
+				t->nOps[op], (double)t->nFixes[op]/t->nOps[op], (double)t->nComparisons[op]/t->nOps[op]);
+		if (t->nSampled[op] == 0) continue;
+
+		fprintf(fp, "    latency(ns) of %ld sampled:", t->nSampled[op]);
+		for (i = 0; i < BTM_TRACE_NBUCKETS; i++)
+			if (t->latency[op][i] > 0)
+				fprintf(fp, " [%ld,%ld):%ld", 1L << i, 1L << (i+1), t->latency[op][i]);
+		fprintf(fp, "\n");
+	}
+
+	for (i = 0; i < BTM_STATS_MAXLEVELS; i++)
+		if (t->nHits[i] + t->nMisses[i] > 0)
+			fprintf(fp, "  level %ld  hits %ld  misses %ld\n", (long)i, t->nHits[i], t->nMisses[i]);
+	if (t->nOtherHits + t->nOtherMisses > 0)
+		fprintf(fp, "  other    hits %ld  misses %ld\n", t->nOtherHits, t->nOtherMisses);
+
+	fprintf(fp, "  splits leaf %ld internal %ld  merges %ld  redistributions %ld\n",
+			t->nLeafSplits, t->nInternalSplits, t->nMerges, t->nRedistributions);
+
+	return(eNOERROR);
+
+} /* EduBtM_DumpTrace() */
+
+
+
+/*@================================
+ * edubtm_TraceBegin()
+ *================================*/
+/*
+ * Function: void edubtm_TraceBegin(Four)
+ *
+ * Description :
+ *  Start tracing the operation 'op' if the tracing is on; the clock is
+ *  read only for the sampled operations.
+ *
+ * Returns:
+ *  None
+ */
+void edubtm_TraceBegin(
+    Four                op)             /* IN BTM_TRACE_FETCH, ... */
+{
+	if (!edubtm_tracing) return;
+
+	edubtm_traceOp = op;
+	edubtm_traceDepth = 0;
+	edubtm_traceProbes = edubtm_nProbes;
+
+	edubtm_traceSampling = (edubtm_trace.nOps[op] % BTM_TRACE_SAMPLEPERIOD == 0);
+	edubtm_trace.nOps[op]++;
+	if (edubtm_traceSampling)
+		clock_gettime(CLOCK_MONOTONIC, &edubtm_traceStart);
+
+} /* edubtm_TraceBegin() */
+
+
+
+/*@================================
+ * edubtm_TraceEnd()
+ *================================*/
+/*
+ * Function: void edubtm_TraceEnd(Four)
+ *
+ * Description :
+ *  End tracing the operation 'op': record its latency if it is sampled and
+ *  dump the counters if the period has passed.
+ *
+ * Returns:
+ *  None
+ */
+void edubtm_TraceEnd(
+    Four                op)             /* IN BTM_TRACE_FETCH, ... */
+{
+	struct timespec     now;            /* end time */
+	Eight               ns;             /* latency */
+	Four                b;              /* bucket of the latency */
+
+
+	if (edubtm_traceOp != op) return;
+	edubtm_traceOp = -1;
+
+	edubtm_trace.nComparisons[op] += edubtm_nProbes - edubtm_traceProbes;
+
+	if (edubtm_traceSampling)
+	{
+		clock_gettime(CLOCK_MONOTONIC, &now);
+		ns = (Eight)(now.tv_sec - edubtm_traceStart.tv_sec) * 1000000000L
+			 + (now.tv_nsec - edubtm_traceStart.tv_nsec);
+
+		for (b = 0; b < BTM_TRACE_NBUCKETS-1 && (ns >> (b+1)) > 0; b++);
+		edubtm_trace.latency[op][b]++;
+		edubtm_trace.nSampled[op]++;
+	}
+
+	edubtm_traceNEnded++;
+	if (edubtm_traceDumpFile != NULL && edubtm_traceNEnded % edubtm_traceDumpPeriod == 0)
+	{
+		EduBtM_DumpTrace(edubtm_traceDumpFile);
+		fflush(edubtm_traceDumpFile);
+	}
+
+} /* edubtm_TraceEnd() */
+
+
+
+/*@================================
+ * edubtm_GetTrain()
+ *================================*/
+/*
+ * Function: Four edubtm_GetTrain(PageID*, char**, Four)
+ *
+ * Description :
+ *  Fix the page as BfM_GetTrain() does and count it in 'edubtm_nFixes';
+ *  while the tracing is on, the fix is also accounted by edubtm_TraceFix().
+ *
+ * Returns:
+ *  error code
+ *    some errors caused by function calls
+ */
+Four edubtm_GetTrain(
+    PageID              *pid,           /* IN page to fix */
+    char                **buf,          /* OUT buffer of the page */
+    Four                type)           /* IN buffer type */
+{
+	edubtm_nFixes++;
+
+	if (edubtm_tracing) return(edubtm_TraceFix(pid, buf, type));
+
+	return(BfM_GetTrain(pid, buf, type));
+
+} /* edubtm_GetTrain() */
+
+
+
+/*@================================
+ * edubtm_TraceFix()
+ *================================*/
+/*
+ * Function: Four edubtm_TraceFix(PageID*, char**, Four)
+ *
+ * Description :
+ *  Fix the page as BfM_GetTrain() does and account the fix to the current
+ *  operation and to the level of the page. Whether the page was in the
+ *  buffer is asked from the buffer manager before the fix. The pages which
+ *  are not B+ tree internal or leaf pages, and the pages fixed outside the
+ *  traced operations, are counted as 'other'.
+ *
+ * Returns:
+ *  error code
+ *    some errors caused by function calls
+ */
+Four edubtm_TraceFix(
+    PageID              *pid,           /* IN page to fix */
+    char                **buf,          /* OUT buffer of the page */
+    Four                type)           /* IN buffer type */
+{
+	Four                e;              /* error number */
+	Boolean             hit;            /* TRUE if the page was in the buffer */
+	BtreePage           *apage;         /* the fixed page */
+	Two                 level;          /* level of the page */
+
+
+	hit = (bfm_LookUp(pid, type) >= 0);
+
+	e = BfM_GetTrain(pid, buf, type);
+	if (e < 0) ERR(e);
+
+	if (edubtm_traceOp >= 0) edubtm_trace.nFixes[edubtm_traceOp]++;
+
+	apage = (BtreePage*)*buf;
+	if (edubtm_traceOp < 0 || (apage->any.hdr.flags & PAGE_TYPE_VECTOR_MASK) != BTREE_PAGE_TYPE
+		|| !(apage->any.hdr.type & (INTERNAL | LEAF)))
+	{
+		if (hit) edubtm_trace.nOtherHits++;
+		else edubtm_trace.nOtherMisses++;
+		return(eNOERROR);
+	}
+
+	if (apage->any.hdr.type & ROOT)
+		level = 0;
+	else if ((apage->any.hdr.type & LEAF) && edubtm_traceDepth == 0)
+		level = edubtm_traceLeafLevel;
+	else
+	{
+		level = MIN(edubtm_traceDepth, BTM_STATS_MAXLEVELS-1);
+		if (apage->any.hdr.type & LEAF) edubtm_traceLeafLevel = level;
+	}
+
+	if (hit) edubtm_trace.nHits[level]++;
+	else edubtm_trace.nMisses[level]++;
+
+	return(eNOERROR);
+
+} /* edubtm_TraceFix() */
@@ -0,0 +1,112 @@
+/******************************************************************************/
+/*                                                                            */
+/*    ODYSSEUS/EduCOSMOS Educational-Purpose Object Storage System            */
+/*                                                                            */
+/*    Developed by Professor Kyu-Young Whang et al.                           */
+/*                                                                            */
+/*    Database and Multimedia Laboratory                                      */
+/*                                                                            */
+/*    Computer Science Department and                                         */
+/*    Advanced Information Technology Research Center (AITrc)                 */
+/*    Korea Advanced Institute of Science and Technology (KAIST)              */
+/*                                                                            */
+/*    e-mail: kywhang@cs.kaist.ac.kr                                          */
+/*    phone: +82-42-350-7722                                                  */
+/*    fax: +82-42-350-8380                                                    */
+/*                                                                            */
+/*    Copyright (c) 1995-2013 by Kyu-Young Whang                              */
+/*                                                                            */
+/*    All rights reserved. No part of this software may be reproduced,        */
+/*    stored in a retrieval system, or transmitted, in any form or by any     */
+/*    means, electronic, mechanical, photocopying, recording, or otherwise,   */
+/*    without prior written permission of the copyright owner.                */
+/*                                                                            */
+/******************************************************************************/
+/* 
+ * Module :	EduHtM_CreateIndex.c
+ *
+ * Description : 
+ *  Create the new hash Index. 
+ *
+ * Exports:
+ *  Four EduHtM_CreateIndex(ObjectID*, PageID*)
+ */
+
+
+#include "EduBtM_common.h"
+#include "EduHtM_Internal.h"
+#include "OM_Internal.h"
+#include "BfM.h"
+
+
+
+/*@================================
+ * EduHtM_CreateIndex()
+ *================================*/
+/* 
+ * Function: Four  EduHtM_CreateIndex(ObjectID*, PageID*)
+ *
+ * Description : 
+ *  Create the new hash Index. 
+ *  We allocate the meta page, which is the root of the index, and the
+ *  primary page of the first bucket, and initialize them.
+ *
+ * Returns :
+ *  error code
+ *    some errors caused by function calls
+ *
+ * Side effects:
+ *  The parameter rootPid is filled with the new meta page's PageID. 
+ */
+Four EduHtM_CreateIndex(
+    ObjectID *catObjForFile,	/* IN catalog object of the index file */
+    PageID *rootPid)		/* OUT meta page of the newly created hash index */
+{
+    Four 			e;			/* error number */
+    SlottedPage 	*catPage;	/* buffer page containing the catalog object */
+    sm_CatOverlayForBtree *catEntry; /* pointer to index file catalog information */
+    PhysicalFileID 	pFid;		/* physical file ID */
+    PageID			bucketPid;	/* primary page of the first bucket */
+    HashMeta		*meta;		/* pointer to the buffer holding the meta page */
+
+
+	MAKE_PAGEID(pFid, catObjForFile->volNo, catObjForFile->pageNo);
+	e = BfM_GetTrain(&pFid, &catPage, PAGE_BUF);
+	if (e < 0) ERR(e);
+	GET_PTR_TO_CATENTRY_FOR_BTREE(catObjForFile, catPage, catEntry);
+	MAKE_PAGEID(*rootPid, catObjForFile->volNo, catEntry->firstPage);
+
+	e = BfM_FreeTrain(&pFid, PAGE_BUF);
+	if (e < 0) ERR(e);
+
+	e = btm_AllocPage(catObjForFile, rootPid, rootPid);
+	if (e < 0) ERR(e);
+	e = btm_AllocPage(catObjForFile, rootPid, &bucketPid);
+	if (e < 0) ERR(e);
+	e = eduhtm_InitBucket(&bucketPid, FALSE);
+	if (e < 0) ERR(e);
+
+	e = BfM_GetNewTrain(rootPid, &meta, PAGE_BUF);
+	if (e < 0) ERR(e);
+
+	MAKE_PAGEID(meta->hdr.pid, rootPid->volNo, rootPid->pageNo);
+	SET_PAGE_TYPE(meta, BTREE_PAGE_TYPE);
+	meta->hdr.type = HASH | ROOT;
+	meta->hdr.level = 0;
+	meta->hdr.next = 0;
+	meta->hdr.nBuckets = 1;
+	meta->hdr.nEntries = 0;
+	meta->hdr.nDirPages = 0;
+	meta->bucket[0] = bucketPid.pageNo;
+
+	e = BfM_SetDirty(rootPid, PAGE_BUF);
+	if (e < 0) ERRB1(e, rootPid, PAGE_BUF);
+	e = BfM_FreeTrain(rootPid, PAGE_BUF);
+	if (e < 0) ERR(e);
+
+	/* the meta page may be the one of a dropped index */
+	eduhtm_DiscardDirectory(rootPid);
+
+    return(eNOERROR);
+    
+} /* EduHtM_CreateIndex() */
@@ -0,0 +1,170 @@
+/******************************************************************************/
+/*                                                                            */
+/*    ODYSSEUS/EduCOSMOS Educational-Purpose Object Storage System            */
+/*                                                                            */
+/*    Developed by Professor Kyu-Young Whang et al.                           */
+/*                                                                            */
+/*    Database and Multimedia Laboratory                                      */
+/*                                                                            */
+/*    Computer Science Department and                                         */
+/*    Advanced Information Technology Research Center (AITrc)                 */
+/*    Korea Advanced Institute of Science and Technology (KAIST)              */
+/*                                                                            */
+/*    e-mail: kywhang@cs.kaist.ac.kr                                          */
+/*    phone: +82-42-350-7722                                                  */
+/*    fax: +82-42-350-8380                                                    */
+/*                                                                            */
+/*    Copyright (c) 1995-2013 by Kyu-Young Whang                              */
+/*                                                                            */
+/*    All rights reserved. No part of this software may be reproduced,        */
+/*    stored in a retrieval system, or transmitted, in any form or by any     */
+/*    means, electronic, mechanical, photocopying, recording, or otherwise,   */
+/*    without prior written permission of the copyright owner.                */
+/*                                                                            */
+/******************************************************************************/
+/*
+ * Module: EduHtM_DeleteObject.c
+ *
+ * Description : 
+ *  Delete from a hash index an ObjectID 'oid' whose key value is given by "kval".
+ *
+ * Exports:
+ *  Four EduHtM_DeleteObject(ObjectID*, PageID*, KeyDesc*, KeyValue*, ObjectID*, Pool*, DeallocListElem*)
+ */
+
+
+#include "EduBtM_common.h"
+#include "BfM.h"
+#include "EduHtM_Internal.h"
+
+
+
+/*@================================
+ * EduHtM_DeleteObject()
+ *================================*/
+/*
+ * Function: Four EduHtM_DeleteObject(ObjectID*, PageID*, KeyDesc*, KeyValue*, ObjectID*, Pool*, DeallocListElem*)
+ *
+ * Description : 
+ *  Delete from a hash index an ObjectID 'oid' whose key value is given by "kval".
+ *  The entry is removed from the page of the bucket chain holding it. An
+ *  overflow page which became empty is unlinked from the chain and freed.
+ *  Buckets are never merged; the index keeps the number of buckets it grew to.
+ *
+ * Returns:
+ *  error code
+ *    eBADPARAMETER_BTM
+ *    eBADPAGETYPE_BTM
+ *    eNOTFOUND_BTM
+ *    some errors caused by fucntion calls
+ */
+Four EduHtM_DeleteObject(
+    ObjectID *catObjForFile,	/* IN catalog object of the index file */
+    PageID   *root,		/* IN meta page of the hash index */
+    KeyDesc  *kdesc,		/* IN a key descriptor */
+    KeyValue *kval,		/* IN key value */
+    ObjectID *oid,		/* IN Object IDentifier */
+    Pool     *dlPool,		/* INOUT pool of dealloc list elements */
+    DeallocListElem *dlHead) /* INOUT head of the dealloc list */
+{
+    int		i;
+    Four    e;			/* error number */
+    UFour   hash;		/* hash value of the key */
+    Two     offset;		/* offset of the found entry */
+    Boolean found;		/* search result */
+    PageID  prevPid;		/* previous page of the bucket chain */
+    PageID  curPid;		/* current page of the bucket chain */
+    PageID  nextPid;		/* next page of the bucket chain */
+    HashMeta *meta;		/* pointer to the buffer holding the meta page */
+    HashBucket *page;		/* pointer to the buffer holding a bucket page */
+    HashBucket *ppage;		/* pointer to the buffer holding the previous page */
+
+
+    /*@ check parameters */
+    if (catObjForFile == NULL) ERR(eBADPARAMETER_BTM);
+
+    if (root == NULL) ERR(eBADPARAMETER_BTM);
+
+    if (kdesc == NULL) ERR(eBADPARAMETER_BTM);
+
+    if (kval == NULL) ERR(eBADPARAMETER_BTM);
+
+    if (oid == NULL) ERR(eBADPARAMETER_BTM);
+    
+    if (dlPool == NULL || dlHead == NULL) ERR(eBADPARAMETER_BTM);
+
+    /* Error check whether using not supported functionality by EduBtM */
+    for(i=0; i<kdesc->nparts; i++)
+    {
+        if(kdesc->kpart[i].type!=SM_INT && kdesc->kpart[i].type!=SM_VARSTRING)
+            ERR(eNOTSUPPORTED_EDUBTM);
+    }
+
+	e = BfM_GetTrain(root, &meta, PAGE_BUF);
+	if (e < 0) ERR(e);
+
+	if (meta->hdr.type != (HASH | ROOT)) ERRB1(eBADPAGETYPE_BTM, root, PAGE_BUF);
+
+	hash = eduhtm_Hash(kdesc, kval);
+	e = eduhtm_GetBucket(meta, eduhtm_BucketNo(&meta->hdr, hash), &curPid);
+	if (e < 0) ERRB1(e, root, PAGE_BUF);
+
+	prevPid.pageNo = NIL;
+	found = FALSE;
+	while (curPid.pageNo != NIL)
+	{
+		e = BfM_GetTrain(&curPid, &page, PAGE_BUF);
+		if (e < 0) ERRB1(e, root, PAGE_BUF);
+
+		offset = 0;
+		found = eduhtm_SearchBucket(page, kdesc, kval, hash, oid, &offset);
+		if (found) break;
+
+		prevPid = curPid;
+		MAKE_PAGEID(curPid, prevPid.volNo, page->hdr.nextPage);
+		e = BfM_FreeTrain(&prevPid, PAGE_BUF);
+		if (e < 0) ERRB1(e, root, PAGE_BUF);
+	}
+
+	if (!found) ERRB1(eNOTFOUND_BTM, root, PAGE_BUF);
+
+	eduhtm_RemoveEntry(page, offset);
+	meta->hdr.nEntries--;
+
+	e = BfM_SetDirty(&curPid, PAGE_BUF);
+	if (e < 0) ERRB2(e, &curPid, PAGE_BUF, root, PAGE_BUF);
+
+	/* Unlink the empty overflow page from the chain. */
+	if (page->hdr.nEntries == 0 && prevPid.pageNo != NIL)
+	{
+		MAKE_PAGEID(nextPid, curPid.volNo, page->hdr.nextPage);
+		page->hdr.nextPage = NIL;
+
+		e = BfM_GetTrain(&prevPid, &ppage, PAGE_BUF);
+		if (e < 0) ERRB2(e, &curPid, PAGE_BUF, root, PAGE_BUF);
+		ppage->hdr.nextPage = nextPid.pageNo;
+		e = BfM_SetDirty(&prevPid, PAGE_BUF);
+		if (e < 0) ERRB2(e, &prevPid, PAGE_BUF, root, PAGE_BUF);
+		e = BfM_FreeTrain(&prevPid, PAGE_BUF);
+		if (e < 0) ERRB2(e, &curPid, PAGE_BUF, root, PAGE_BUF);
+
+		e = BfM_FreeTrain(&curPid, PAGE_BUF);
+		if (e < 0) ERRB1(e, root, PAGE_BUF);
+
+		e = eduhtm_FreePage(&curPid, dlPool, dlHead);
+		if (e < 0) ERRB1(e, root, PAGE_BUF);
+	}
+	else
+	{
+		e = BfM_FreeTrain(&curPid, PAGE_BUF);
+		if (e < 0) ERRB1(e, root, PAGE_BUF);
+	}
+
+	e = BfM_SetDirty(root, PAGE_BUF);
+	if (e < 0) ERRB1(e, root, PAGE_BUF);
+	e = BfM_FreeTrain(root, PAGE_BUF);
+	if (e < 0) ERR(e);
+    
+    return(eNOERROR);
+    
+}   /* EduHtM_DeleteObject() */
@@ -0,0 +1,105 @@
+/******************************************************************************/
+/*                                                                            */
+/*    ODYSSEUS/EduCOSMOS Educational-Purpose Object Storage System            */
+/*                                                                            */
+/*    Developed by Professor Kyu-Young Whang et al.                           */
+/*                                                                            */
+/*    Database and Multimedia Laboratory                                      */
+/*                                                                            */
+/*    Computer Science Department and                                         */
+/*    Advanced Information Technology Research Center (AITrc)                 */
+/*    Korea Advanced Institute of Science and Technology (KAIST)              */
+/*                                                                            */
+/*    e-mail: kywhang@cs.kaist.ac.kr                                          */
+/*    phone: +82-42-350-7722                                                  */
+/*    fax: +82-42-350-8380                                                    */
+/*                                                                            */
+/*    Copyright (c) 1995-2013 by Kyu-Young Whang                              */
+/*                                                                            */
+/*    All rights reserved. No part of this software may be reproduced,        */
+/*    stored in a retrieval system, or transmitted, in any form or by any     */
+/*    means, electronic, mechanical, photocopying, recording, or otherwise,   */
+/*    without prior written permission of the copyright owner.                */
+/*                                                                            */
+/******************************************************************************/
+/* 
+ * Module:	EduHtM_DropIndex.c
+ *
+ * Description : 
+ *  Drop the hash Index specified by 'rootPid', the meta PageID of the index.
+ *
+ * Exports:
+ *  Four EduHtM_DropIndex(PhysicalFileID*, PageID*, Pool*, DeallocListElem*)
+ */
+
+
+#include "EduBtM_common.h"
+#include "BfM.h"
+#include "EduHtM_Internal.h"
+
+
+
+/*@================================
+ * EduHtM_DropIndex()
+ *================================*/
+/* 
+ * Function: Four EduHtM_DropIndex(PhysicalFileID*, PageID*, Pool*, DeallocListElem*)
+ *
+ * Description : 
+ *  Drop the hash Index specified by 'rootPid', the meta PageID of the index.
+ *  The chains of all buckets, the directory pages and the meta page are
+ *  put into the dealloc list.
+ *
+ * Returns:
+ *  error code
+ *    eBADPARAMETER_BTM
+ *    eBADPAGETYPE_BTM
+ *    some errors : by other function calls
+ */
+Four EduHtM_DropIndex(
+    PhysicalFileID *pFid,	/* IN FileID of the index file */
+    PageID *rootPid,		/* IN meta PageID to be dropped */
+    Pool   *dlPool,		/* INOUT pool of the dealloc list elements */
+    DeallocListElem *dlHead) /* INOUT head of the dealloc list */
+{
+    Four e;			/* for the error number */
+    Four i;			/* bucket number */
+    PageID bucketPid;		/* primary page of a bucket */
+    PageID dirPid;		/* directory page */
+    HashMeta *meta;		/* pointer to the buffer holding the meta page */
+
+
+    if (pFid == NULL || rootPid == NULL || dlPool == NULL || dlHead == NULL) ERR(eBADPARAMETER_BTM);
+
+	eduhtm_DiscardDirectory(rootPid);
+
+	e = BfM_GetTrain(rootPid, &meta, PAGE_BUF);
+	if (e < 0) ERR(e);
+
+	if (meta->hdr.type != (HASH | ROOT)) ERRB1(eBADPAGETYPE_BTM, rootPid, PAGE_BUF);
+
+	for (i = 0; i < meta->hdr.nBuckets; i++)
+	{
+		e = eduhtm_GetBucket(meta, i, &bucketPid);
+		if (e < 0) ERRB1(e, rootPid, PAGE_BUF);
+
+		e = eduhtm_FreeChain(&bucketPid, dlPool, dlHead);
+		if (e < 0) ERRB1(e, rootPid, PAGE_BUF);
+	}
+
+	for (i = 0; i < meta->hdr.nDirPages; i++)
+	{
+		MAKE_PAGEID(dirPid, rootPid->volNo, meta->dirPage[i]);
+		e = eduhtm_FreePage(&dirPid, dlPool, dlHead);
+		if (e < 0) ERRB1(e, rootPid, PAGE_BUF);
+	}
+
+	e = BfM_FreeTrain(rootPid, PAGE_BUF);
+	if (e < 0) ERR(e);
+
+	e = eduhtm_FreePage(rootPid, dlPool, dlHead);
+	if (e < 0) ERR(e);
+	
+    return(eNOERROR);
+    
+} /* EduHtM_DropIndex() */
@@ -0,0 +1,181 @@
+/******************************************************************************/
+/*                                                                            */
+/*    ODYSSEUS/EduCOSMOS Educational-Purpose Object Storage System            */
+/*                                                                            */
+/*    Developed by Professor Kyu-Young Whang et al.                           */
+/*                                                                            */
+/*    Database and Multimedia Laboratory                                      */
+/*                                                                            */
+/*    Computer Science Department and                                         */
+/*    Advanced Information Technology Research Center (AITrc)                 */
+/*    Korea Advanced Institute of Science and Technology (KAIST)              */
+/*                                                                            */
+/*    e-mail: kywhang@cs.kaist.ac.kr                                          */
+/*    phone: +82-42-350-7722                                                  */
+/*    fax: +82-42-350-8380                                                    */
+/*                                                                            */
+/*    Copyright (c) 1995-2013 by Kyu-Young Whang                              */
+/*                                                                            */
+/*    All rights reserved. No part of this software may be reproduced,        */
+/*    stored in a retrieval system, or transmitted, in any form or by any     */
+/*    means, electronic, mechanical, photocopying, recording, or otherwise,   */
+/*    without prior written permission of the copyright owner.                */
+/*                                                                            */
+/******************************************************************************/
+/*
+ * Module: EduHtM_Fetch.c
+ *
+ * Description:
+ *  Find the first object satisfying the given condition from a hash index.
+ *
+ * Exports:
+ *  Four EduHtM_Fetch(PageID*, KeyDesc*, KeyValue*, Four, BtreeCursor*)
+ */
+
+
+#include <string.h>
+#include "EduBtM_common.h"
+#include "BfM.h"
+#include "EduHtM_Internal.h"
+
+
+/*@ Internal Function Prototypes */
+Four eduhtm_FetchFrom(PageID*, Two, KeyDesc*, KeyValue*, BtreeCursor*);
+
+
+
+/*@================================
+ * EduHtM_Fetch()
+ *================================*/
+/*
+ * Function: Four EduHtM_Fetch(PageID*, KeyDesc*, KeyValue*, Four, BtreeCursor*)
+ *
+ * Description:
+ *  Find the first object whose key is equal to 'kval' from a hash index.
+ *  Only the equality condition SM_EQ is supported because the hash index
+ *  does not keep the order of the keys. The bucket is found in the
+ *  directory kept in memory, so a lookup fixes only the pages of one
+ *  bucket chain.
+ *
+ * Returns:
+ *  error code
+ *    eBADPARAMETER_BTM
+ *    eBADCOMPOP_BTM
+ *    eBADPAGETYPE_BTM
+ *    some errors caused by function calls
+ *
+ * Side effects:
+ *  cursor  : The found ObjectID and its position in the bucket.
+ *            The leaf of the cursor is the bucket page holding the entry and
+ *            the slotNo is the offset of the entry in the page.
+ */
+Four EduHtM_Fetch(
+    PageID   *root,		/* IN meta page of the hash index */
+    KeyDesc  *kdesc,		/* IN key descriptor */
+    KeyValue *kval,		/* IN key value to be searched */
+    Four     compOp,		/* IN comparison operator; only SM_EQ */
+    BtreeCursor *cursor)	/* OUT Hash Cursor */
+{
+    int i;
+    Four e;		   /* error number */
+    PageID bucketPid;	   /* primary page of the bucket */
+    HtmDirectory *dir;	   /* directory of the index */
+
+    
+    if (root == NULL) ERR(eBADPARAMETER_BTM);
+
+    if (kdesc == NULL || kval == NULL || cursor == NULL) ERR(eBADPARAMETER_BTM);
+
+    /* Error check whether using not supported functionality by EduBtM */
+    for(i=0; i<kdesc->nparts; i++)
+    {
+        if(kdesc->kpart[i].type!=SM_INT && kdesc->kpart[i].type!=SM_VARSTRING)
+            ERR(eNOTSUPPORTED_EDUBTM);
+    }
+
+	if (compOp != SM_EQ) ERR(eBADCOMPOP_BTM);
+
+	e = eduhtm_GetDirectory(root, &dir);
+	if (e < 0) ERR(e);
+
+	MAKE_PAGEID(bucketPid, root->volNo, dir->bucket[eduhtm_BucketNo(&dir->hdr, eduhtm_Hash(kdesc, kval))]);
+
+	e = eduhtm_FetchFrom(&bucketPid, 0, kdesc, kval, cursor);
+	if (e < 0) ERR(e);
+
+    return(eNOERROR);
+
+} /* EduHtM_Fetch() */
+
+
+
+/*@================================
+ * eduhtm_FetchFrom()
+ *================================*/
+/*
+ * Function: Four eduhtm_FetchFrom(PageID*, Two, KeyDesc*, KeyValue*, BtreeCursor*)
+ *
+ * Description:
+ *  Find the first entry having the key 'kval' in the bucket chain, starting
+ *  from the entry at 'offset' in the page 'pid'.
+ *
+ * Returns:
+ *  error code
+ *    some errors caused by function calls
+ *
+ * Side effects:
+ *  cursor  : The found ObjectID and its position, or CURSOR_EOS
+ */
+Four eduhtm_FetchFrom(
+    PageID   *pid,		/* IN page where the search starts */
+    Two      offset,		/* IN offset where the search starts */
+    KeyDesc  *kdesc,		/* IN key descriptor */
+    KeyValue *kval,		/* IN key value to be searched */
+    BtreeCursor *cursor)	/* OUT Hash Cursor */
+{
+    Four e;		   /* error number */
+    UFour hash;		   /* hash value of the key */
+    PageID curPid;	   /* current page of the bucket chain */
+    PageID nextPid;	   /* next page of the bucket chain */
+    HashBucket *page;	   /* pointer to the buffer holding a bucket page */
+    htm_Entry *entry;	   /* the found entry */
+
+
+	hash = eduhtm_Hash(kdesc, kval);
+	curPid = *pid;
+
+	while (curPid.pageNo != NIL)
+	{
+		e = BfM_GetTrain(&curPid, &page, PAGE_BUF);
+		if (e < 0) ERR(e);
+
+		if (eduhtm_SearchBucket(page, kdesc, kval, hash, NULL, &offset))
+		{
+			entry = (htm_Entry*)&page->data[offset];
+
+			cursor->flag = CURSOR_ON;
+			cursor->leaf = curPid;
+			cursor->slotNo = offset;
+			cursor->key.len = entry->klen;
+			memcpy(&cursor->key.val[0], &entry->kval[0], entry->klen);
+			memcpy(&cursor->oid, &entry->kval[ALIGNED_LENGTH(entry->klen)], sizeof(ObjectID));
+
+			e = BfM_FreeTrain(&curPid, PAGE_BUF);
+			if (e < 0) ERR(e);
+
+			return(eNOERROR);
+		}
+
+		MAKE_PAGEID(nextPid, curPid.volNo, page->hdr.nextPage);
+		e = BfM_FreeTrain(&curPid, PAGE_BUF);
+		if (e < 0) ERR(e);
+
+		curPid = nextPid;
+		offset = 0;
+	}
+
+	cursor->flag = CURSOR_EOS;
+
+    return(eNOERROR);
+
+} /* eduhtm_FetchFrom() */
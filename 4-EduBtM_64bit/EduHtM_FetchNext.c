@@ -0,0 +1,101 @@
+/******************************************************************************/
+/*                                                                            */
+/*    ODYSSEUS/EduCOSMOS Educational-Purpose Object Storage System            */
+/*                                                                            */
+/*    Developed by Professor Kyu-Young Whang et al.                           */
+/*                                                                            */
+/*    Database and Multimedia Laboratory                                      */
+/*                                                                            */
+/*    Computer Science Department and                                         */
+/*    Advanced Information Technology Research Center (AITrc)                 */
+/*    Korea Advanced Institute of Science and Technology (KAIST)              */
+/*                                                                            */
+/*    e-mail: kywhang@cs.kaist.ac.kr                                          */
+/*    phone: +82-42-350-7722                                                  */
+/*    fax: +82-42-350-8380                                                    */
+/*                                                                            */
+/*    Copyright (c) 1995-2013 by Kyu-Young Whang                              */
+/*                                                                            */
+/*    All rights reserved. No part of this software may be reproduced,        */
+/*    stored in a retrieval system, or transmitted, in any form or by any     */
+/*    means, electronic, mechanical, photocopying, recording, or otherwise,   */
+/*    without prior written permission of the copyright owner.                */
+/*                                                                            */
+/******************************************************************************/
+/*
+ * Module: EduHtM_FetchNext.c
+ *
+ * Description:
+ *  Find the next ObjectID having the same key from a hash index. The current
+ *  ObjectID is specified by the 'current'.
+ *
+ * Exports:
+ *  Four EduHtM_FetchNext(PageID*, KeyDesc*, KeyValue*, BtreeCursor*, BtreeCursor*)
+ */
+
+
+#include "EduBtM_common.h"
+#include "BfM.h"
+#include "EduHtM_Internal.h"
+
+
+/*@ Internal Function Prototypes */
+Four eduhtm_FetchFrom(PageID*, Two, KeyDesc*, KeyValue*, BtreeCursor*);
+
+
+
+/*@================================
+ * EduHtM_FetchNext()
+ *================================*/
+/*
+ * Function: Four EduHtM_FetchNext(PageID*, KeyDesc*, KeyValue*, BtreeCursor*, BtreeCursor*)
+ *
+ * Description:
+ *  Fetch the next ObjectID whose key is equal to 'kval'. The search
+ *  continues from the entry following the current one in the bucket chain.
+ *  The cursor is invalidated if the index is updated after it was fetched.
+ *
+ * Returns:
+ *  error code
+ *    eBADPARAMETER_BTM
+ *    eBADCURSOR
+ *    some errors caused by function calls
+ */
+Four EduHtM_FetchNext(
+    PageID                      *root,          /* IN meta page of the hash index */
+    KeyDesc                     *kdesc,         /* IN key descriptor */
+    KeyValue                    *kval,          /* IN key value to be searched */
+    BtreeCursor                 *current,       /* IN current Hash cursor */
+    BtreeCursor                 *next)          /* OUT next Hash cursor */
+{
+    int							i;
+    Four                        e;              /* error number */
+    Two                         offset;         /* offset of the next entry */
+
+
+    if (root == NULL || kdesc == NULL || kval == NULL ||
+        current == NULL || next == NULL) ERR(eBADPARAMETER_BTM);
+
+    /* Error check whether using not supported functionality by EduBtM */
+    for(i=0; i<kdesc->nparts; i++)
+    {
+        if(kdesc->kpart[i].type!=SM_INT && kdesc->kpart[i].type!=SM_VARSTRING)
+            ERR(eNOTSUPPORTED_EDUBTM);
+    }
+
+	if (current->flag == CURSOR_EOS)
+	{
+		*next = *current;
+		return(eNOERROR);
+	}
+
+	if (current->flag != CURSOR_ON) ERR(eBADCURSOR);
+
+	offset = current->slotNo + HTM_ENTRY_LEN(current->key.len);
+
+	e = eduhtm_FetchFrom(&current->leaf, offset, kdesc, kval, next);
+	if (e < 0) ERR(e);
+
+    return(eNOERROR);
+
+} /* EduHtM_FetchNext() */
@@ -0,0 +1,157 @@
+/******************************************************************************/
+/*                                                                            */
+/*    ODYSSEUS/EduCOSMOS Educational-Purpose Object Storage System            */
+/*                                                                            */
+/*    Developed by Professor Kyu-Young Whang et al.                           */
+/*                                                                            */
+/*    Database and Multimedia Laboratory                                      */
+/*                                                                            */
+/*    Computer Science Department and                                         */
+/*    Advanced Information Technology Research Center (AITrc)                 */
+/*    Korea Advanced Institute of Science and Technology (KAIST)              */
+/*                                                                            */
+/*    e-mail: kywhang@cs.kaist.ac.kr                                          */
+/*    phone: +82-42-350-7722                                                  */
+/*    fax: +82-42-350-8380                                                    */
+/*                                                                            */
+/*    Copyright (c) 1995-2013 by Kyu-Young Whang                              */
+/*                                                                            */
+/*    All rights reserved. No part of this software may be reproduced,        */
+/*    stored in a retrieval system, or transmitted, in any form or by any     */
+/*    means, electronic, mechanical, photocopying, recording, or otherwise,   */
+/*    without prior written permission of the copyright owner.                */
+/*                                                                            */
+/******************************************************************************/
+/*
+ * Module: EduHtM_InsertObject.c
+ *
+ * Description :
+ *  Insert an ObjectID 'oid' into a hash index whose key value is 'kval'. 
+ *
+ * Exports:
+ *  Four EduHtM_InsertObject(ObjectID*, PageID*, KeyDesc*, KeyValue*, ObjectID*, Pool*, DeallocListElem*)
+ */
+
+
+#include "EduBtM_common.h"
+#include "BfM.h"
+#include "EduHtM_Internal.h"
+
+
+
+/*@================================
+ * EduHtM_InsertObject() 
+ *================================*/
+/*
+ * Function: Four EduHtM_InsertObject(ObjectID*, PageID*, KeyDesc*, KeyValue*, ObjectID*, Pool*, DeallocListElem*)
+ * 
+ * Description :
+ *  Insert an ObjectID 'oid' into a hash index whose key value is 'kval'. 
+ *  The entry is appended to the bucket of the key. If the entry does not
+ *  fit in the primary page of the bucket, one bucket is splitted by the
+ *  linear hashing, which keeps the overflow chains short.
+ *  If the index is unique (KEYFLAG_UNIQUE), the key should not exist;
+ *  otherwise the pair of the key and the ObjectID should not exist.
+ *
+ * Returns:
+ *  error code
+ *    eBADPARAMETER_BTM
+ *    eBADPAGETYPE_BTM
+ *    eDUPLICATEDKEY_BTM
+ *    eDUPLICATEDOBJECTID_BTM
+ *    some errors caused by function calls
+ */
+Four EduHtM_InsertObject(
+    ObjectID *catObjForFile,	/* IN catalog object of the index file */
+    PageID   *root,		/* IN the meta page of the hash index */
+    KeyDesc  *kdesc,		/* IN key descriptor */
+    KeyValue *kval,		/* IN key value */
+    ObjectID *oid,		/* IN ObjectID which will be inserted */
+    Pool     *dlPool,		/* INOUT pool of dealloc list */
+    DeallocListElem *dlHead) /* INOUT head of the dealloc list */
+{
+    int i;
+    Four e;			/* error number */
+    UFour hash;			/* hash value of the key */
+    Two offset;			/* offset of the found entry */
+    Boolean found;		/* search result */
+    Boolean overflowed;		/* TRUE if the entry went to an overflow page */
+    PageID bucketPid;		/* primary page of the bucket */
+    PageID curPid;		/* current page of the bucket chain */
+    PageID nextPid;		/* next page of the bucket chain */
+    HashMeta *meta;		/* pointer to the buffer holding the meta page */
+    HashBucket *page;		/* pointer to the buffer holding a bucket page */
+
+    
+    /*@ check parameters */
+    
+    if (catObjForFile == NULL) ERR(eBADPARAMETER_BTM);
+    
+    if (root == NULL) ERR(eBADPARAMETER_BTM);
+
+    if (kdesc == NULL) ERR(eBADPARAMETER_BTM);
+
+    if (kval == NULL) ERR(eBADPARAMETER_BTM);
+
+    if (oid == NULL) ERR(eBADPARAMETER_BTM);    
+
+    /* Error check whether using not supported functionality by EduBtM */
+    for(i=0; i<kdesc->nparts; i++)
+    {
+        if(kdesc->kpart[i].type!=SM_INT && kdesc->kpart[i].type!=SM_VARSTRING)
+            ERR(eNOTSUPPORTED_EDUBTM);
+    }
+
+	e = BfM_GetTrain(root, &meta, PAGE_BUF);
+	if (e < 0) ERR(e);
+
+	if (meta->hdr.type != (HASH | ROOT)) ERRB1(eBADPAGETYPE_BTM, root, PAGE_BUF);
+
+	hash = eduhtm_Hash(kdesc, kval);
+	e = eduhtm_GetBucket(meta, eduhtm_BucketNo(&meta->hdr, hash), &bucketPid);
+	if (e < 0) ERRB1(e, root, PAGE_BUF);
+
+	/* Check the duplication in the chain of the bucket. */
+	curPid = bucketPid;
+	while (curPid.pageNo != NIL)
+	{
+		e = BfM_GetTrain(&curPid, &page, PAGE_BUF);
+		if (e < 0) ERRB1(e, root, PAGE_BUF);
+
+		offset = 0;
+		if (kdesc->flag & KEYFLAG_UNIQUE)
+		{
+			found = eduhtm_SearchBucket(page, kdesc, kval, hash, NULL, &offset);
+			if (found) ERRB2(eDUPLICATEDKEY_BTM, &curPid, PAGE_BUF, root, PAGE_BUF);
+		}
+		else
+		{
+			found = eduhtm_SearchBucket(page, kdesc, kval, hash, oid, &offset);
+			if (found) ERRB2(eDUPLICATEDOBJECTID_BTM, &curPid, PAGE_BUF, root, PAGE_BUF);
+		}
+
+		MAKE_PAGEID(nextPid, curPid.volNo, page->hdr.nextPage);
+		e = BfM_FreeTrain(&curPid, PAGE_BUF);
+		if (e < 0) ERRB1(e, root, PAGE_BUF);
+		curPid = nextPid;
+	}
+
+	e = eduhtm_AppendEntry(catObjForFile, &bucketPid, hash, kval, oid, &overflowed);
+	if (e < 0) ERRB1(e, root, PAGE_BUF);
+	meta->hdr.nEntries++;
+
+	if (overflowed)
+	{
+		e = eduhtm_SplitBucket(catObjForFile, meta, dlPool, dlHead);
+		if (e < 0) ERRB1(e, root, PAGE_BUF);
+	}
+
+	e = BfM_SetDirty(root, PAGE_BUF);
+	if (e < 0) ERRB1(e, root, PAGE_BUF);
+	e = BfM_FreeTrain(root, PAGE_BUF);
+	if (e < 0) ERR(e);
+
+    
+    return(eNOERROR);
+    
+}   /* EduHtM_InsertObject() */
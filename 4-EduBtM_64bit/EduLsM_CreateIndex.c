@@ -0,0 +1,101 @@
+/******************************************************************************/
+/*                                                                            */
+/*    ODYSSEUS/EduCOSMOS Educational-Purpose Object Storage System            */
+/*                                                                            */
+/*    Developed by Professor Kyu-Young Whang et al.                           */
+/*                                                                            */
+/*    Database and Multimedia Laboratory                                      */
+/*                                                                            */
+/*    Computer Science Department and                                         */
+/*    Advanced Information Technology Research Center (AITrc)                 */
+/*    Korea Advanced Institute of Science and Technology (KAIST)              */
+/*                                                                            */
+/*    e-mail: kywhang@cs.kaist.ac.kr                                          */
+/*    phone: +82-42-350-7722                                                  */
+/*    fax: +82-42-350-8380                                                    */
+/*                                                                            */
+/*    Copyright (c) 1995-2013 by Kyu-Young Whang                              */
+/*                                                                            */
+/*    All rights reserved. No part of this software may be reproduced,        */
+/*    stored in a retrieval system, or transmitted, in any form or by any     */
+/*    means, electronic, mechanical, photocopying, recording, or otherwise,   */
+/*    without prior written permission of the copyright owner.                */
+/*                                                                            */
+/******************************************************************************/
+/* 
+ * Module :	EduLsM_CreateIndex.c
+ *
+ * Description : 
+ *  Create the new LSM Index. 
+ *
+ * Exports:
+ *  Four EduLsM_CreateIndex(ObjectID*, PageID*)
+ */
+
+
+#include "EduBtM_common.h"
+#include "EduLsM_Internal.h"
+#include "OM_Internal.h"
+#include "BfM.h"
+
+
+
+/*@================================
+ * EduLsM_CreateIndex()
+ *================================*/
+/* 
+ * Function: Four  EduLsM_CreateIndex(ObjectID*, PageID*)
+ *
+ * Description : 
+ *  Create the new LSM Index. 
+ *  We allocate the meta page, which is the root of the index, and
+ *  initialize it with no run. The write buffer is created by the first
+ *  insertion.
+ *
+ * Returns :
+ *  error code
+ *    some errors caused by function calls
+ *
+ * Side effects:
+ *  The parameter rootPid is filled with the new meta page's PageID. 
+ */
+Four EduLsM_CreateIndex(
+    ObjectID *catObjForFile,	/* IN catalog object of the index file */
+    PageID *rootPid)		/* OUT meta page of the newly created LSM index */
+{
+    Four 			e;			/* error number */
+    SlottedPage 	*catPage;	/* buffer page containing the catalog object */
+    sm_CatOverlayForBtree *catEntry; /* pointer to index file catalog information */
+    PhysicalFileID 	pFid;		/* physical file ID */
+    LsmMeta			*meta;		/* pointer to the buffer holding the meta page */
+
+
+	MAKE_PAGEID(pFid, catObjForFile->volNo, catObjForFile->pageNo);
+	e = BfM_GetTrain(&pFid, &catPage, PAGE_BUF);
+	if (e < 0) ERR(e);
+	GET_PTR_TO_CATENTRY_FOR_BTREE(catObjForFile, catPage, catEntry);
+	MAKE_PAGEID(*rootPid, catObjForFile->volNo, catEntry->firstPage);
+
+	e = BfM_FreeTrain(&pFid, PAGE_BUF);
+	if (e < 0) ERR(e);
+
+	e = btm_AllocPage(catObjForFile, rootPid, rootPid);
+	if (e < 0) ERR(e);
+
+	e = BfM_GetNewTrain(rootPid, &meta, PAGE_BUF);
+	if (e < 0) ERR(e);
+
+	MAKE_PAGEID(meta->hdr.pid, rootPid->volNo, rootPid->pageNo);
+	SET_PAGE_TYPE(meta, BTREE_PAGE_TYPE);
+	meta->hdr.type = LSM | ROOT;
+	meta->hdr.nRuns = 0;
+
+	e = BfM_SetDirty(rootPid, PAGE_BUF);
+	if (e < 0) ERRB1(e, rootPid, PAGE_BUF);
+	e = BfM_FreeTrain(rootPid, PAGE_BUF);
+	if (e < 0) ERR(e);
+
+
+    return(eNOERROR);
+    
+} /* EduLsM_CreateIndex() */
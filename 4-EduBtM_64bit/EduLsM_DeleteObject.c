@@ -0,0 +1,116 @@
+/******************************************************************************/
+/*                                                                            */
+/*    ODYSSEUS/EduCOSMOS Educational-Purpose Object Storage System            */
+/*                                                                            */
+/*    Developed by Professor Kyu-Young Whang et al.                           */
+/*                                                                            */
+/*    Database and Multimedia Laboratory                                      */
+/*                                                                            */
+/*    Computer Science Department and                                         */
+/*    Advanced Information Technology Research Center (AITrc)                 */
+/*    Korea Advanced Institute of Science and Technology (KAIST)              */
+/*                                                                            */
+/*    e-mail: kywhang@cs.kaist.ac.kr                                          */
+/*    phone: +82-42-350-7722                                                  */
+/*    fax: +82-42-350-8380                                                    */
+/*                                                                            */
+/*    Copyright (c) 1995-2013 by Kyu-Young Whang                              */
+/*                                                                            */
+/*    All rights reserved. No part of this software may be reproduced,        */
+/*    stored in a retrieval system, or transmitted, in any form or by any     */
+/*    means, electronic, mechanical, photocopying, recording, or otherwise,   */
+/*    without prior written permission of the copyright owner.                */
+/*                                                                            */
+/******************************************************************************/
+/*
+ * Module: EduLsM_DeleteObject.c
+ *
+ * Description :
+ *  Delete from an LSM index an ObjectID 'oid' whose key value is given by "kval".
+ *
+ * Exports:
+ *  Four EduLsM_DeleteObject(ObjectID*, PageID*, KeyDesc*, KeyValue*, ObjectID*, Pool*, DeallocListElem*)
+ */
+
+
+#include <string.h>
+#include "EduBtM_common.h"
+#include "BfM.h"
+#include "EduLsM_Internal.h"
+
+
+
+/*@================================
+ * EduLsM_DeleteObject()
+ *================================*/
+/*
+ * Function: Four EduLsM_DeleteObject(ObjectID*, PageID*, KeyDesc*, KeyValue*, ObjectID*, Pool*, DeallocListElem*)
+ * 
+ * Description :
+ *  Delete from an LSM index an ObjectID 'oid' whose key value is given by "kval".
+ *  A deletion entry is put into the write buffer; it hides the pair in the
+ *  older runs and is dropped when it is merged into the oldest run. The
+ *  deletion does not read the runs, so deleting a pair which does not
+ *  exist is not reported.
+ *
+ * Returns:
+ *  error code
+ *    eBADPARAMETER_BTM
+ *    some errors caused by function calls
+ */
+Four EduLsM_DeleteObject(
+    ObjectID *catObjForFile,	/* IN catalog object of the index file */
+    PageID   *root,		/* IN meta page of the LSM index */
+    KeyDesc  *kdesc,		/* IN key descriptor */
+    KeyValue *kval,		/* IN key value */
+    ObjectID *oid,		/* IN ObjectID which will be deleted */
+    Pool     *dlPool,		/* INOUT pool of dealloc list */
+    DeallocListElem *dlHead) /* INOUT head of the dealloc list */
+{
+    int i;
+    Four e;			/* error number */
+    LsmBuffer *buf;		/* the write buffer */
+    lsm_Item item;		/* the buffered operation */
+
+
+    /*@ check parameters */
+    
+    if (catObjForFile == NULL) ERR(eBADPARAMETER_BTM);
+    
+    if (root == NULL) ERR(eBADPARAMETER_BTM);
+
+    if (kdesc == NULL) ERR(eBADPARAMETER_BTM);
+
+    if (kval == NULL) ERR(eBADPARAMETER_BTM);
+
+    if (oid == NULL) ERR(eBADPARAMETER_BTM);    
+
+    if (dlPool == NULL || dlHead == NULL) ERR(eBADPARAMETER_BTM);
+
+    /* Error check whether using not supported functionality by EduBtM */
+    for(i=0; i<kdesc->nparts; i++)
+    {
+        if(kdesc->kpart[i].type!=SM_INT && kdesc->kpart[i].type!=SM_VARSTRING)
+            ERR(eNOTSUPPORTED_EDUBTM);
+    }
+
+	e = edulsm_GetBuffer(root, TRUE, &buf);
+	if (e < 0) ERR(e);
+
+	if (buf->nItems == LSM_BUFFERENTRIES)
+	{
+		e = edulsm_FlushBuffer(catObjForFile, root, kdesc, dlPool, dlHead);
+		if (e < 0) ERR(e);
+	}
+
+	item.oid = *oid;
+	item.nObjects = LSM_DELETE;
+	item.key.len = kval->len;
+	memcpy(item.key.val, kval->val, kval->len);
+
+	edulsm_PutBuffer(buf, kdesc, &item);
+
+    
+    return(eNOERROR);
+    
+}   /* EduLsM_DeleteObject() */
@@ -0,0 +1,95 @@
+/******************************************************************************/
+/*                                                                            */
+/*    ODYSSEUS/EduCOSMOS Educational-Purpose Object Storage System            */
+/*                                                                            */
+/*    Developed by Professor Kyu-Young Whang et al.                           */
+/*                                                                            */
+/*    Database and Multimedia Laboratory                                      */
+/*                                                                            */
+/*    Computer Science Department and                                         */
+/*    Advanced Information Technology Research Center (AITrc)                 */
+/*    Korea Advanced Institute of Science and Technology (KAIST)              */
+/*                                                                            */
+/*    e-mail: kywhang@cs.kaist.ac.kr                                          */
+/*    phone: +82-42-350-7722                                                  */
+/*    fax: +82-42-350-8380                                                    */
+/*                                                                            */
+/*    Copyright (c) 1995-2013 by Kyu-Young Whang                              */
+/*                                                                            */
+/*    All rights reserved. No part of this software may be reproduced,        */
+/*    stored in a retrieval system, or transmitted, in any form or by any     */
+/*    means, electronic, mechanical, photocopying, recording, or otherwise,   */
+/*    without prior written permission of the copyright owner.                */
+/*                                                                            */
+/******************************************************************************/
+/* 
+ * Module:	EduLsM_DropIndex.c
+ *
+ * Description : 
+ *  Drop the LSM Index specified by 'rootPid', the meta PageID of the index.
+ *
+ * Exports:
+ *  Four EduLsM_DropIndex(PhysicalFileID*, PageID*, Pool*, DeallocListElem*)
+ */
+
+
+#include "EduBtM_common.h"
+#include "BfM.h"
+#include "EduLsM_Internal.h"
+#include "EduHtM_Internal.h"
+
+
+
+/*@================================
+ * EduLsM_DropIndex()
+ *================================*/
+/* 
+ * Function: Four EduLsM_DropIndex(PhysicalFileID*, PageID*, Pool*, DeallocListElem*)
+ *
+ * Description : 
+ *  Drop the LSM Index specified by 'rootPid', the meta PageID of the index.
+ *  The write buffer is discarded, and the pages of all runs and the meta
+ *  page are put into the dealloc list.
+ *
+ * Returns:
+ *  error code
+ *    eBADPARAMETER_BTM
+ *    eBADPAGETYPE_BTM
+ *    some errors : by other function calls
+ */
+Four EduLsM_DropIndex(
+    PhysicalFileID *pFid,	/* IN FileID of the index file */
+    PageID *rootPid,		/* IN meta PageID to be dropped */
+    Pool   *dlPool,		/* INOUT pool of the dealloc list elements */
+    DeallocListElem *dlHead) /* INOUT head of the dealloc list */
+{
+    Four e;			/* for the error number */
+    Two  i;			/* index of a run */
+    LsmMeta *meta;		/* pointer to the buffer holding the meta page */
+
+
+    if (pFid == NULL || rootPid == NULL || dlPool == NULL || dlHead == NULL) ERR(eBADPARAMETER_BTM);
+
+	e = BfM_GetTrain(rootPid, &meta, PAGE_BUF);
+	if (e < 0) ERR(e);
+
+	if (meta->hdr.type != (LSM | ROOT)) ERRB1(eBADPAGETYPE_BTM, rootPid, PAGE_BUF);
+
+	edulsm_DiscardBuffer(rootPid);
+
+	for (i = 0; i < meta->hdr.nRuns; i++)
+	{
+		e = edulsm_FreeRun(rootPid->volNo, &meta->run[i], dlPool, dlHead);
+		if (e < 0) ERRB1(e, rootPid, PAGE_BUF);
+	}
+
+	e = BfM_FreeTrain(rootPid, PAGE_BUF);
+	if (e < 0) ERR(e);
+
+	e = eduhtm_FreePage(rootPid, dlPool, dlHead);
+	if (e < 0) ERR(e);
+
+    
+    return(eNOERROR);
+    
+} /* EduLsM_DropIndex() */
@@ -0,0 +1,246 @@
+/******************************************************************************/
+/*                                                                            */
+/*    ODYSSEUS/EduCOSMOS Educational-Purpose Object Storage System            */
+/*                                                                            */
+/*    Developed by Professor Kyu-Young Whang et al.                           */
+/*                                                                            */
+/*    Database and Multimedia Laboratory                                      */
+/*                                                                            */
+/*    Computer Science Department and                                         */
+/*    Advanced Information Technology Research Center (AITrc)                 */
+/*    Korea Advanced Institute of Science and Technology (KAIST)              */
+/*                                                                            */
+/*    e-mail: kywhang@cs.kaist.ac.kr                                          */
+/*    phone: +82-42-350-7722                                                  */
+/*    fax: +82-42-350-8380                                                    */
+/*                                                                            */
+/*    Copyright (c) 1995-2013 by Kyu-Young Whang                              */
+/*                                                                            */
+/*    All rights reserved. No part of this software may be reproduced,        */
+/*    stored in a retrieval system, or transmitted, in any form or by any     */
+/*    means, electronic, mechanical, photocopying, recording, or otherwise,   */
+/*    without prior written permission of the copyright owner.                */
+/*                                                                            */
+/******************************************************************************/
+/*
+ * Module: EduLsM_Fetch.c
+ *
+ * Description :
+ *  Find the first object satisfying the given condition from an LSM index.
+ *  The entries of the write buffer and of all runs are merged on the fly;
+ *  for a pair (key, ObjectID) only the newest entry counts, and the pair is
+ *  skipped if that entry is a deletion.
+ *  The start condition is one among SM_BOF, SM_EQ, SM_GT, SM_GE and the
+ *  stop condition is one among SM_EOF, SM_EQ, SM_LT, SM_LE; that is, only
+ *  the forward scan is supported.
+ *
+ * Exports:
+ *  Four EduLsM_Fetch(PageID*, KeyDesc*, KeyValue*, Four, KeyValue*, Four, BtreeCursor*)
+ */
+
+
+#include <string.h>
+#include "EduBtM_common.h"
+#include "BfM.h"
+#include "EduLsM_Internal.h"
+
+
+
+/*@================================
+ * EduLsM_Fetch()
+ *================================*/
+/*
+ * Function: Four EduLsM_Fetch(PageID*, KeyDesc*, KeyValue*, Four, KeyValue*, Four, BtreeCursor*)
+ *
+ * Description:
+ *  Find the first object satisfying the given condition. See above for detail.
+ *
+ * Returns:
+ *  error code
+ *    eBADPARAMETER_BTM
+ *    eBADCOMPOP_BTM
+ *    some errors caused by function calls
+ *
+ * Side effects:
+ *  cursor  : The found ObjectID and its key. The position of the cursor is
+ *            its pair (key, ObjectID), so the cursor stays valid when the
+ *            write buffer is flushed or the runs are merged.
+ */
+Four EduLsM_Fetch(
+    PageID   *root,		/* IN meta page of the LSM index */
+    KeyDesc  *kdesc,		/* IN key descriptor */
+    KeyValue *startKval,	/* IN key value of start condition */
+    Four     startCompOp,	/* IN comparison operator of start condition */
+    KeyValue *stopKval,		/* IN key value of stop condition */
+    Four     stopCompOp,	/* IN comparison operator of stop condition */
+    BtreeCursor *cursor)	/* OUT LSM Cursor */
+{
+    int i;
+    Four e;		   /* error number */
+    Four mode;		   /* seek mode of the start condition */
+
+    
+    if (root == NULL || kdesc == NULL || cursor == NULL) ERR(eBADPARAMETER_BTM);
+
+    /* Error check whether using not supported functionality by EduBtM */
+    for(i=0; i<kdesc->nparts; i++)
+    {
+        if(kdesc->kpart[i].type!=SM_INT && kdesc->kpart[i].type!=SM_VARSTRING)
+            ERR(eNOTSUPPORTED_EDUBTM);
+    }
+
+	switch (startCompOp) {
+	  case SM_BOF:
+		mode = LSM_SEEK_FIRST;
+		break;
+	  case SM_EQ:
+	  case SM_GE:
+		mode = LSM_SEEK_GE;
+		break;
+	  case SM_GT:
+		mode = LSM_SEEK_GT;
+		break;
+	  default:
+		ERR(eBADCOMPOP_BTM);
+	}
+
+	if (stopCompOp != SM_EOF && stopCompOp != SM_EQ &&
+	    stopCompOp != SM_LT && stopCompOp != SM_LE) ERR(eBADCOMPOP_BTM);
+
+	if (mode != LSM_SEEK_FIRST && startKval == NULL) ERR(eBADPARAMETER_BTM);
+	if (stopCompOp != SM_EOF && stopKval == NULL) ERR(eBADPARAMETER_BTM);
+
+	e = edulsm_Next(root, kdesc, startKval, NULL, mode, stopKval, stopCompOp, cursor);
+	if (e < 0) ERR(e);
+
+    return(eNOERROR);
+
+} /* EduLsM_Fetch() */
+
+
+
+/*@================================
+ * edulsm_Next()
+ *================================*/
+/*
+ * Function: Four edulsm_Next(PageID*, KeyDesc*, KeyValue*, ObjectID*, Four,
+ *                            KeyValue*, Four, BtreeCursor*)
+ *
+ * Description:
+ *  Find the first live pair satisfying the seek condition and the stop
+ *  condition. Each source (the write buffer and the runs from the newest)
+ *  is searched for its first entry after the seek position, and the
+ *  smallest one is taken; on a tie the newest source wins. If it is a
+ *  deletion, the search goes on after the deleted pair. When the stop
+ *  condition is SM_EQ, the runs whose filter does not have the key are
+ *  not searched at all.
+ *
+ * Returns:
+ *  Error code
+ *    eBADPAGETYPE_BTM
+ *    some errors caused by function calls
+ *
+ * Side effects:
+ *  cursor  : The found ObjectID and its key, or CURSOR_EOS
+ */
+Four edulsm_Next(
+    PageID      *root,          /* IN meta page of the LSM index */
+    KeyDesc     *kdesc,         /* IN key descriptor */
+    KeyValue    *kval,          /* IN key value of the seek */
+    ObjectID    *oid,           /* IN ObjectID of the seek */
+    Four        mode,           /* IN seek mode */
+    KeyValue    *stopKval,      /* IN key value of stop condition */
+    Four        stopCompOp,     /* IN comparison operator of stop condition */
+    BtreeCursor *cursor)        /* OUT LSM Cursor */
+{
+    Four        e;              /* error number */
+    Two         i;              /* index of a run */
+    Four        cmp;            /* result of comparison */
+    Boolean     found;          /* TRUE if a source has an entry */
+    Boolean     haveBest;       /* TRUE if 'best' is valid */
+    Boolean     skip[LSM_MAXRUNS]; /* TRUE if the filter excludes the run */
+    LsmBuffer   *buf;           /* the write buffer */
+    LsmMeta     *meta;          /* pointer to the buffer holding the meta page */
+    lsm_Item    best;           /* the smallest entry */
+    lsm_Item    cand;           /* the entry of a source */
+    KeyValue    curKey;         /* key of the deleted pair */
+    ObjectID    curOid;         /* ObjectID of the deleted pair */
+
+
+	e = edulsm_GetBuffer(root, FALSE, &buf);
+	if (e < 0) ERR(e);
+
+	e = BfM_GetTrain(root, &meta, PAGE_BUF);
+	if (e < 0) ERR(e);
+
+	if (meta->hdr.type != (LSM | ROOT)) ERRB1(eBADPAGETYPE_BTM, root, PAGE_BUF);
+
+	for (i = 0; i < meta->hdr.nRuns; i++)
+	{
+		skip[i] = FALSE;
+		if (stopCompOp == SM_EQ)
+		{
+			e = edulsm_MayContain(root->volNo, &meta->run[i], kdesc, stopKval, &found);
+			if (e < 0) ERRB1(e, root, PAGE_BUF);
+			skip[i] = !found;
+		}
+	}
+
+	cursor->flag = CURSOR_EOS;
+
+	for (;;)
+	{
+		haveBest = FALSE;
+		if (buf != NULL && edulsm_SeekBuffer(buf, kdesc, kval, oid, mode, &best))
+			haveBest = TRUE;
+
+		for (i = 0; i < meta->hdr.nRuns; i++)
+		{
+			if (skip[i]) continue;
+
+			e = edulsm_SeekRun(root->volNo, &meta->run[i], kdesc, kval, oid, mode, &cand, &found);
+			if (e < 0) ERRB1(e, root, PAGE_BUF);
+
+			if (found && (!haveBest ||
+			    edulsm_Compare(kdesc, &cand.key, &cand.oid, &best.key, &best.oid) == LESS))
+			{
+				best = cand;
+				haveBest = TRUE;
+			}
+		}
+
+		if (!haveBest) break;
+
+		if (stopCompOp != SM_EOF)
+		{
+			cmp = edubtm_KeyCompare(kdesc, &best.key, stopKval);
+			if ((stopCompOp == SM_EQ && cmp != EQUAL) ||
+			    (stopCompOp == SM_LT && cmp != LESS) ||
+			    (stopCompOp == SM_LE && cmp == GREAT)) break;
+		}
+
+		if (best.nObjects == LSM_INSERT)
+		{
+			cursor->flag = CURSOR_ON;
+			cursor->oid = best.oid;
+			cursor->key.len = best.key.len;
+			memcpy(cursor->key.val, best.key.val, best.key.len);
+			cursor->leaf = *root;
+			break;
+		}
+
+		/* The pair is deleted; continue after it. */
+		curKey.len = best.key.len;
+		memcpy(curKey.val, best.key.val, best.key.len);
+		curOid = best.oid;
+		kval = &curKey;
+		oid = &curOid;
+		mode = LSM_SEEK_AFTER;
+	}
+
+	e = BfM_FreeTrain(root, PAGE_BUF);
+	if (e < 0) ERR(e);
+
+    return(eNOERROR);
+
+} /* edulsm_Next() */
@@ -0,0 +1,101 @@
+/******************************************************************************/
+/*                                                                            */
+/*    ODYSSEUS/EduCOSMOS Educational-Purpose Object Storage System            */
+/*                                                                            */
+/*    Developed by Professor Kyu-Young Whang et al.                           */
+/*                                                                            */
+/*    Database and Multimedia Laboratory                                      */
+/*                                                                            */
+/*    Computer Science Department and                                         */
+/*    Advanced Information Technology Research Center (AITrc)                 */
+/*    Korea Advanced Institute of Science and Technology (KAIST)              */
+/*                                                                            */
+/*    e-mail: kywhang@cs.kaist.ac.kr                                          */
+/*    phone: +82-42-350-7722                                                  */
+/*    fax: +82-42-350-8380                                                    */
+/*                                                                            */
+/*    Copyright (c) 1995-2013 by Kyu-Young Whang                              */
+/*                                                                            */
+/*    All rights reserved. No part of this software may be reproduced,        */
+/*    stored in a retrieval system, or transmitted, in any form or by any     */
+/*    means, electronic, mechanical, photocopying, recording, or otherwise,   */
+/*    without prior written permission of the copyright owner.                */
+/*                                                                            */
+/******************************************************************************/
+/*
+ * Module: EduLsM_FetchNext.c
+ *
+ * Description:
+ *  Find the next ObjectID satisfying the given condition from an LSM index.
+ *  The current ObjectID is specified by the 'current'.
+ *
+ * Exports:
+ *  Four EduLsM_FetchNext(PageID*, KeyDesc*, KeyValue*, Four, BtreeCursor*, BtreeCursor*)
+ */
+
+
+#include "EduBtM_common.h"
+#include "BfM.h"
+#include "EduLsM_Internal.h"
+
+
+
+/*@================================
+ * EduLsM_FetchNext()
+ *================================*/
+/*
+ * Function: Four EduLsM_FetchNext(PageID*, KeyDesc*, KeyValue*,
+ *                              Four, BtreeCursor*, BtreeCursor*)
+ *
+ * Description:
+ *  Fetch the next ObjectID satisfying the given condition. The search
+ *  starts after the pair (key, ObjectID) of the current cursor, so the
+ *  insertions, deletions, flushes and merges done after the current cursor
+ *  was fetched are seen by the scan.
+ *
+ * Returns:
+ *  error code
+ *    eBADPARAMETER_BTM
+ *    eBADCOMPOP_BTM
+ *    eBADCURSOR
+ *    some errors caused by function calls
+ */
+Four EduLsM_FetchNext(
+    PageID                      *root,          /* IN meta page of the LSM index */
+    KeyDesc                     *kdesc,         /* IN key descriptor */
+    KeyValue                    *kval,          /* IN key value of stop condition */
+    Four                        compOp,         /* IN comparison operator of stop condition */
+    BtreeCursor                 *current,       /* IN current LSM cursor */
+    BtreeCursor                 *next)          /* OUT next LSM cursor */
+{
+    int							i;
+    Four                        e;              /* error number */
+
+
+    if (root == NULL || kdesc == NULL || current == NULL || next == NULL) ERR(eBADPARAMETER_BTM);
+
+    /* Error check whether using not supported functionality by EduBtM */
+    for(i=0; i<kdesc->nparts; i++)
+    {
+        if(kdesc->kpart[i].type!=SM_INT && kdesc->kpart[i].type!=SM_VARSTRING)
+            ERR(eNOTSUPPORTED_EDUBTM);
+    }
+
+	if (compOp != SM_EOF && compOp != SM_EQ && compOp != SM_LT && compOp != SM_LE) ERR(eBADCOMPOP_BTM);
+
+	if (compOp != SM_EOF && kval == NULL) ERR(eBADPARAMETER_BTM);
+
+	if (current->flag == CURSOR_EOS)
+	{
+		*next = *current;
+		return(eNOERROR);
+	}
+
+	if (current->flag != CURSOR_ON) ERR(eBADCURSOR);
+
+	e = edulsm_Next(root, kdesc, &current->key, &current->oid, LSM_SEEK_AFTER, kval, compOp, next);
+	if (e < 0) ERR(e);
+
+    return(eNOERROR);
+
+} /* EduLsM_FetchNext() */
@@ -0,0 +1,173 @@
+/******************************************************************************/
+/*                                                                            */
+/*    ODYSSEUS/EduCOSMOS Educational-Purpose Object Storage System            */
+/*                                                                            */
+/*    Developed by Professor Kyu-Young Whang et al.                           */
+/*                                                                            */
+/*    Database and Multimedia Laboratory                                      */
+/*                                                                            */
+/*    Computer Science Department and                                         */
+/*    Advanced Information Technology Research Center (AITrc)                 */
+/*    Korea Advanced Institute of Science and Technology (KAIST)              */
+/*                                                                            */
+/*    e-mail: kywhang@cs.kaist.ac.kr                                          */
+/*    phone: +82-42-350-7722                                                  */
+/*    fax: +82-42-350-8380                                                    */
+/*                                                                            */
+/*    Copyright (c) 1995-2013 by Kyu-Young Whang                              */
+/*                                                                            */
+/*    All rights reserved. No part of this software may be reproduced,        */
+/*    stored in a retrieval system, or transmitted, in any form or by any     */
+/*    means, electronic, mechanical, photocopying, recording, or otherwise,   */
+/*    without prior written permission of the copyright owner.                */
+/*                                                                            */
+/******************************************************************************/
+/*
+ * Module: EduLsM_Flush.c
+ *
+ * Description :
+ *  Write the write buffer of an LSM index as a new run.
+ *
+ * Exports:
+ *  Four EduLsM_Flush(ObjectID*, PageID*, KeyDesc*, Pool*, DeallocListElem*)
+ */
+
+
+#include <string.h>
+#include "EduBtM_common.h"
+#include "BfM.h"
+#include "EduLsM_Internal.h"
+
+
+
+/*@================================
+ * EduLsM_Flush()
+ *================================*/
+/*
+ * Function: Four EduLsM_Flush(ObjectID*, PageID*, KeyDesc*, Pool*, DeallocListElem*)
+ *
+ * Description :
+ *  Write the write buffer of an LSM index as a new run. The write buffer
+ *  lives only in memory, so it should be flushed before the transaction
+ *  which updated the index commits.
+ *
+ * Returns:
+ *  error code
+ *    eBADPARAMETER_BTM
+ *    some errors caused by function calls
+ */
+Four EduLsM_Flush(
+    ObjectID *catObjForFile,	/* IN catalog object of the index file */
+    PageID   *root,		/* IN meta page of the LSM index */
+    KeyDesc  *kdesc,		/* IN key descriptor */
+    Pool     *dlPool,		/* INOUT pool of dealloc list */
+    DeallocListElem *dlHead) /* INOUT head of the dealloc list */
+{
+    int i;
+    Four e;			/* error number */
+
+
+    if (catObjForFile == NULL || root == NULL || kdesc == NULL) ERR(eBADPARAMETER_BTM);
+
+    if (dlPool == NULL || dlHead == NULL) ERR(eBADPARAMETER_BTM);
+
+    /* Error check whether using not supported functionality by EduBtM */
+    for(i=0; i<kdesc->nparts; i++)
+    {
+        if(kdesc->kpart[i].type!=SM_INT && kdesc->kpart[i].type!=SM_VARSTRING)
+            ERR(eNOTSUPPORTED_EDUBTM);
+    }
+
+	e = edulsm_FlushBuffer(catObjForFile, root, kdesc, dlPool, dlHead);
+	if (e < 0) ERR(e);
+
+    return(eNOERROR);
+
+}   /* EduLsM_Flush() */
+
+
+
+/*@================================
+ * edulsm_FlushBuffer()
+ *================================*/
+/*
+ * Function: Four edulsm_FlushBuffer(ObjectID*, PageID*, KeyDesc*, Pool*, DeallocListElem*)
+ *
+ * Description :
+ *  Build a run of tier 0 from the sorted items of the write buffer and put
+ *  it in front of the runs, and then merge the full tiers. The deletion
+ *  entries are not written if the index has no run, because there is no
+ *  entry for them to hide.
+ *
+ * Returns:
+ *  error code
+ *    eBADPAGETYPE_BTM
+ *    eTOOMANYRUNS_BTM
+ *    some errors caused by function calls
+ */
+Four edulsm_FlushBuffer(
+    ObjectID *catObjForFile,	/* IN catalog object of the index file */
+    PageID   *root,		/* IN meta page of the LSM index */
+    KeyDesc  *kdesc,		/* IN key descriptor */
+    Pool     *dlPool,		/* INOUT pool of dealloc list */
+    DeallocListElem *dlHead) /* INOUT head of the dealloc list */
+{
+    Four e;			/* error number */
+    Four i;			/* index of an item */
+    LsmBuffer *buf;		/* the write buffer */
+    LsmMeta *meta;		/* pointer to the buffer holding the meta page */
+    lsm_RunBuilder b;		/* state of building the run */
+    LsmRun run;			/* the new run */
+
+
+	e = edulsm_GetBuffer(root, FALSE, &buf);
+	if (e < 0) ERR(e);
+
+	if (buf == NULL || buf->nItems == 0) return(eNOERROR);
+
+	e = BfM_GetTrain(root, &meta, PAGE_BUF);
+	if (e < 0) ERR(e);
+
+	if (meta->hdr.type != (LSM | ROOT)) ERRB1(eBADPAGETYPE_BTM, root, PAGE_BUF);
+
+	if (meta->hdr.nRuns == LSM_MAXRUNS) ERRB1(eTOOMANYRUNS_BTM, root, PAGE_BUF);
+
+	e = edulsm_BeginRun(catObjForFile, root, &b);
+	if (e < 0) ERRB1(e, root, PAGE_BUF);
+
+	for (i = 0; i < buf->nItems; i++)
+	{
+		if (meta->hdr.nRuns == 0 && buf->order[i]->nObjects == LSM_DELETE) continue;
+
+		e = edulsm_AppendRun(&b, kdesc, buf->order[i]);
+		if (e < 0) ERRB1(e, root, PAGE_BUF);
+	}
+
+	e = edulsm_EndRun(&b, &run);
+	if (e < 0) ERRB1(e, root, PAGE_BUF);
+
+	buf->nItems = 0;
+
+	if (run.nEntries > 0)
+	{
+		memmove(&meta->run[1], &meta->run[0], sizeof(LsmRun)*meta->hdr.nRuns);
+		meta->run[0] = run;
+		meta->hdr.nRuns++;
+
+		e = edulsm_MergeRuns(catObjForFile, meta, kdesc, dlPool, dlHead);
+		if (e < 0) ERRB1(e, root, PAGE_BUF);
+	}
+	else
+	{
+		e = edulsm_FreeRun(root->volNo, &run, dlPool, dlHead);
+		if (e < 0) ERRB1(e, root, PAGE_BUF);
+	}
+
+	e = BfM_SetDirty(root, PAGE_BUF);
+	if (e < 0) ERRB1(e, root, PAGE_BUF);
+	e = BfM_FreeTrain(root, PAGE_BUF);
+	if (e < 0) ERR(e);
+
+    return(eNOERROR);
+
+}   /* edulsm_FlushBuffer() */
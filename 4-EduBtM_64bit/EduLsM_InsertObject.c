@@ -0,0 +1,127 @@
+/******************************************************************************/
+/*                                                                            */
+/*    ODYSSEUS/EduCOSMOS Educational-Purpose Object Storage System            */
+/*                                                                            */
+/*    Developed by Professor Kyu-Young Whang et al.                           */
+/*                                                                            */
+/*    Database and Multimedia Laboratory                                      */
+/*                                                                            */
+/*    Computer Science Department and                                         */
+/*    Advanced Information Technology Research Center (AITrc)                 */
+/*    Korea Advanced Institute of Science and Technology (KAIST)              */
+/*                                                                            */
+/*    e-mail: kywhang@cs.kaist.ac.kr                                          */
+/*    phone: +82-42-350-7722                                                  */
+/*    fax: +82-42-350-8380                                                    */
+/*                                                                            */
+/*    Copyright (c) 1995-2013 by Kyu-Young Whang                              */
+/*                                                                            */
+/*    All rights reserved. No part of this software may be reproduced,        */
+/*    stored in a retrieval system, or transmitted, in any form or by any     */
+/*    means, electronic, mechanical, photocopying, recording, or otherwise,   */
+/*    without prior written permission of the copyright owner.                */
+/*                                                                            */
+/******************************************************************************/
+/*
+ * Module: EduLsM_InsertObject.c
+ *
+ * Description :
+ *  Insert an ObjectID 'oid' into an LSM index whose key value is 'kval'.
+ *
+ * Exports:
+ *  Four EduLsM_InsertObject(ObjectID*, PageID*, KeyDesc*, KeyValue*, ObjectID*, Pool*, DeallocListElem*)
+ */
+
+
+#include <string.h>
+#include "EduBtM_common.h"
+#include "BfM.h"
+#include "EduLsM_Internal.h"
+
+
+
+/*@================================
+ * EduLsM_InsertObject()
+ *================================*/
+/*
+ * Function: Four EduLsM_InsertObject(ObjectID*, PageID*, KeyDesc*, KeyValue*, ObjectID*, Pool*, DeallocListElem*)
+ * 
+ * Description :
+ *  Insert an ObjectID 'oid' into an LSM index whose key value is 'kval'.
+ *  The insertion is put into the write buffer; the buffer is written as a
+ *  new run when it is full. If the index is unique (KEYFLAG_UNIQUE), the
+ *  key is searched first, which reads the runs whose filter has the key.
+ *  Inserting a pair which already exists is not an error; the pair is
+ *  kept once.
+ *
+ * Returns:
+ *  error code
+ *    eBADPARAMETER_BTM
+ *    eDUPLICATEDKEY_BTM
+ *    some errors caused by function calls
+ */
+Four EduLsM_InsertObject(
+    ObjectID *catObjForFile,	/* IN catalog object of the index file */
+    PageID   *root,		/* IN meta page of the LSM index */
+    KeyDesc  *kdesc,		/* IN key descriptor */
+    KeyValue *kval,		/* IN key value */
+    ObjectID *oid,		/* IN ObjectID which will be inserted */
+    Pool     *dlPool,		/* INOUT pool of dealloc list */
+    DeallocListElem *dlHead) /* INOUT head of the dealloc list */
+{
+    int i;
+    Four e;			/* error number */
+    LsmBuffer *buf;		/* the write buffer */
+    lsm_Item item;		/* the buffered operation */
+    BtreeCursor cursor;		/* cursor for the unique check */
+
+
+    /*@ check parameters */
+    
+    if (catObjForFile == NULL) ERR(eBADPARAMETER_BTM);
+    
+    if (root == NULL) ERR(eBADPARAMETER_BTM);
+
+    if (kdesc == NULL) ERR(eBADPARAMETER_BTM);
+
+    if (kval == NULL) ERR(eBADPARAMETER_BTM);
+
+    if (oid == NULL) ERR(eBADPARAMETER_BTM);    
+
+    if (dlPool == NULL || dlHead == NULL) ERR(eBADPARAMETER_BTM);
+
+    /* Error check whether using not supported functionality by EduBtM */
+    for(i=0; i<kdesc->nparts; i++)
+    {
+        if(kdesc->kpart[i].type!=SM_INT && kdesc->kpart[i].type!=SM_VARSTRING)
+            ERR(eNOTSUPPORTED_EDUBTM);
+    }
+
+	if (kdesc->flag & KEYFLAG_UNIQUE)
+	{
+		e = edulsm_Next(root, kdesc, kval, NULL, LSM_SEEK_GE, kval, SM_EQ, &cursor);
+		if (e < 0) ERR(e);
+
+		if (cursor.flag == CURSOR_ON) ERR(eDUPLICATEDKEY_BTM);
+	}
+
+	e = edulsm_GetBuffer(root, TRUE, &buf);
+	if (e < 0) ERR(e);
+
+	if (buf->nItems == LSM_BUFFERENTRIES)
+	{
+		e = edulsm_FlushBuffer(catObjForFile, root, kdesc, dlPool, dlHead);
+		if (e < 0) ERR(e);
+	}
+
+	item.oid = *oid;
+	item.nObjects = LSM_INSERT;
+	item.key.len = kval->len;
+	memcpy(item.key.val, kval->val, kval->len);
+
+	edulsm_PutBuffer(buf, kdesc, &item);
+
+    
+    return(eNOERROR);
+    
+}   /* EduLsM_InsertObject() */
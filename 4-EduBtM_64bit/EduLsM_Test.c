@@ -0,0 +1,644 @@
+/******************************************************************************/
+/*                                                                            */
+/*    ODYSSEUS/EduCOSMOS Educational-Purpose Object Storage System            */
+/*                                                                            */
+/*    Developed by Professor Kyu-Young Whang et al.                           */
+/*                                                                            */
+/*    Database and Multimedia Laboratory                                      */
+/*                                                                            */
+/*    Computer Science Department and                                         */
+/*    Advanced Information Technology Research Center (AITrc)                 */
+/*    Korea Advanced Institute of Science and Technology (KAIST)              */
+/*                                                                            */
+/*    e-mail: kywhang@cs.kaist.ac.kr                                          */
+/*    phone: +82-42-350-7722                                                  */
+/*    fax: +82-42-350-8380                                                    */
+/*                                                                            */
+/*    Copyright (c) 1995-2013 by Kyu-Young Whang                              */
+/*                                                                            */
+/*    All rights reserved. No part of this software may be reproduced,        */
+/*    stored in a retrieval system, or transmitted, in any form or by any     */
+/*    means, electronic, mechanical, photocopying, recording, or otherwise,   */
+/*    without prior written permission of the copyright owner.                */
+/*                                                                            */
+/******************************************************************************/
+/*
+ * Module: EduLsM_Test.c
+ *
+ * Description :
+ *  Regression test of the LSM index. A unique and a non-unique index of
+ *  integer keys go through random mixed insertions and deletions, enough
+ *  of them to fill the write buffer many times and to merge the runs of
+ *  several tiers. Some rounds also end with EduLsM_Flush(), so the checks
+ *  see both a full and an empty write buffer. The results are kept in a
+ *  set of pairs:
+ *   - an insertion of a key in the index returns eDUPLICATEDKEY_BTM in the
+ *     unique index, and an insertion of a pair in the index is dropped in
+ *     the other,
+ *   - a deletion of a pair not in the index is dropped,
+ *   - a search for a random key returns exactly the ObjectIDs of the set,
+ *     in order, and
+ *   - a scan from the first key to the last returns exactly the pairs of
+ *     the set, in order.
+ *  The test fails also if no run of the second tier was made, since then
+ *  the merges of merged runs were not tested.
+ *
+ *  Usage: EduLsM_Test
+ *
+ *  The exit status is 0 if all the checks pass.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "EduBtM_common.h"
+#include "EduBtM_basictypes.h"
+#include "BfM.h"
+#include "EduLsM.h"
+#include "EduBtM_TestModule.h"
+
+
+#define LTEST_VOLUME        "lsmtest.vol"
+#define LTEST_NUMPAGES      20000   /* # of pages of the volume */
+#define LTEST_NUMKEYS       10000   /* the keys are the numbers in [0, LTEST_NUMKEYS) */
+#define LTEST_NUMOIDS       8       /* the ObjectIDs of a key are the numbers in [1, LTEST_NUMOIDS] */
+#define LTEST_ROUNDS        16      /* # of rounds of updates between full checks */
+#define LTEST_UPDATES       4000    /* # of random updates in a round */
+#define LTEST_SEARCHES      500     /* # of random searches in a round */
+#define LTEST_MINTIER       2       /* the highest tier of a run should reach this */
+
+Four SM_CreateFile(Four, FileID*, Boolean, void*);
+Four sm_GetCatalogEntryFromDataFileId(Four, FileID*, ObjectID*);
+
+Four EduLsM_Test(Four, Four);
+Four ltest_Run(ObjectID*, Two, char*);
+Four ltest_Insert(ObjectID*, PageID*, KeyDesc*, Four, Four);
+Four ltest_Delete(ObjectID*, PageID*, KeyDesc*, Four, Four);
+Four ltest_Search(PageID*, KeyDesc*, Four);
+Four ltest_Check(PageID*, KeyDesc*, char*);
+Four ltest_Runs(PageID*, Four*, Four*);
+void ltest_MakeKey(Four, KeyValue*);
+void ltest_MakeOid(ObjectID*, Four, ObjectID*);
+Four ltest_KeyNumber(KeyValue*);
+
+static unsigned char ltest_oids[LTEST_NUMKEYS]; /* bit u-1 is set if the pair of the key and the ObjectID u is in the index */
+static Four ltest_maxTier;                      /* the highest tier of a run so far */
+static Four ltest_nErrors;                      /* # of violations found by the current check */
+
+
+
+/*@================================
+ * main()
+ *================================*/
+int main(int argc, char *argv[])
+{
+	Four	e;									/* for errors */
+	Four	handle;								/* system handle */
+	char 	*devNames[1];						/* device name */
+	Four 	volId = 1000;						/* volume identifier */
+	Four 	numPagesInDevices[1];				/* # of pages in the device */
+	XactID 	xactId;								/* transaction identifier */
+
+
+	devNames[0] = LTEST_VOLUME;
+	numPagesInDevices[0] = LTEST_NUMPAGES;
+
+	e = LRDS_Init();
+	if (e < eNOERROR) { printf("LRDS_Init failed!!!\n"); exit(1); }
+
+	e = LRDS_AllocHandle(&handle);
+	if (e < eNOERROR) { printf("LRDS_AllocHandle failed!!!\n"); LRDS_Final(); exit(1); }
+
+	e = LRDS_FormatDataVolume(1, devNames, "lsmtest", volId, 16, numPagesInDevices, 16);
+	if (e < eNOERROR) { printf("LRDS_FormatDataVolume failed!!!\n"); LRDS_FreeHandle(handle); LRDS_Final(); exit(1); }
+
+	e = LRDS_Mount(1, devNames, &volId);
+	if (e < eNOERROR) { printf("LRDS_Mount failed!!!\n"); LRDS_FreeHandle(handle); LRDS_Final(); exit(1); }
+
+	e = LRDS_BeginTransaction(&xactId, X_RR_RR);
+	if (e < eNOERROR) { LRDS_Dismount(volId); LRDS_FreeHandle(handle); LRDS_Final(); exit(1); }
+
+	e = EduLsM_Test(volId, handle);
+	if (e < eNOERROR) {
+		printf("EduLsM_Test failed!!!\n");
+		LRDS_AbortTransaction(&xactId);
+		LRDS_Dismount(volId);
+		LRDS_FreeHandle(handle);
+		LRDS_Final();
+		exit(1);
+	}
+
+	e = LRDS_CommitTransaction(&xactId);
+	if (e < eNOERROR) printf("LRDS_CommitTransaction failed!!!\n");
+
+	LRDS_Dismount(volId);
+	LRDS_FreeHandle(handle);
+	LRDS_Final();
+
+	return 0;
+}
+
+
+
+/*@================================
+ * EduLsM_Test()
+ *================================*/
+/*
+ * Function: Four EduLsM_Test(Four, Four)
+ *
+ * Description:
+ *  Run the test on a unique and on a non-unique LSM index.
+ *
+ * Returns:
+ *  error code
+ *    eBADBTREEPAGE_BTM if a check fails
+ *    some errors caused by function calls
+ */
+Four EduLsM_Test(
+    Four        volId,                  /* IN volume identifier */
+    Four        handle)                 /* IN system handle */
+{
+    Four        e;                      /* error number */
+    FileID      fid;                    /* file identifier */
+    ObjectID    catalogEntry;           /* catalog object */
+
+
+	e = SM_CreateFile(volId, &fid, FALSE, NULL);
+	if (e < eNOERROR) ERR(e);
+
+	e = sm_GetCatalogEntryFromDataFileId(ARRAYINDEX, &fid, &catalogEntry);
+	if (e < eNOERROR) ERR(e);
+
+	srand(23);
+
+	e = ltest_Run(&catalogEntry, KEYFLAG_UNIQUE, "unique");
+	if (e < eNOERROR) ERR(e);
+
+	e = ltest_Run(&catalogEntry, 0, "non-unique");
+	if (e < eNOERROR) ERR(e);
+
+	printf("all checks passed\n");
+
+	return(eNOERROR);
+
+} /* EduLsM_Test() */
+
+
+
+/*@================================
+ * ltest_Run()
+ *================================*/
+/*
+ * Function: Four ltest_Run(ObjectID*, Two, char*)
+ *
+ * Description:
+ *  Create an LSM index with the given flags, run the rounds of random
+ *  updates and searches on it, and check it after each round. The index
+ *  is dropped at the end.
+ *
+ * Returns:
+ *  error code
+ *    eBADBTREEPAGE_BTM if a check fails
+ *    some errors caused by function calls
+ */
+Four ltest_Run(
+    ObjectID        *catObjForFile,     /* IN catalog object of the index file */
+    Two             flag,               /* IN flags of the key descriptor */
+    char            *name)              /* IN name of the index */
+{
+    Four            e;                  /* error number */
+    Four            i, j;               /* indexes */
+    Four            v;                  /* number of a key */
+    Four            u;                  /* number of an ObjectID */
+    PageID          root;               /* meta page of the index */
+    PhysicalFileID  pFid;               /* file of the index */
+    KeyDesc         kdesc;              /* key descriptor */
+    char            step[64];           /* name of a step */
+
+
+	kdesc.flag = flag;
+	kdesc.nparts = 1;
+	kdesc.kpart[0].type = SM_INT;
+	kdesc.kpart[0].offset = 0;
+	kdesc.kpart[0].length = sizeof(Four_Invariable);
+
+	e = EduLsM_CreateIndex(catObjForFile, &root);
+	if (e < eNOERROR) ERR(e);
+
+	memset(ltest_oids, 0, sizeof(ltest_oids));
+	ltest_maxTier = 0;
+
+	for (i = 0; i < LTEST_ROUNDS; i++)
+	{
+		for (j = 0; j < LTEST_UPDATES; j++)
+		{
+			v = rand() % LTEST_NUMKEYS;
+			u = rand() % LTEST_NUMOIDS + 1;
+
+			// Insertions win in the first half of the rounds, deletions in the second.
+			if (rand() % 100 < ((i < LTEST_ROUNDS/2) ? 70 : 30))
+				e = ltest_Insert(catObjForFile, &root, &kdesc, v, u);
+			else
+				e = ltest_Delete(catObjForFile, &root, &kdesc, v, u);
+			if (e < eNOERROR) ERR(e);
+		}
+
+		if (i % 2 == 1)
+		{
+			e = EduLsM_Flush(catObjForFile, &root, &kdesc, &dlPool, &dlHead);
+			if (e < eNOERROR) ERR(e);
+		}
+
+		ltest_nErrors = 0;
+		for (j = 0; j < LTEST_SEARCHES; j++)
+		{
+			e = ltest_Search(&root, &kdesc, rand() % LTEST_NUMKEYS);
+			if (e < eNOERROR) ERR(e);
+		}
+
+		sprintf(step, "%s round %ld", name, (long)i);
+		e = ltest_Check(&root, &kdesc, step);
+		if (e < eNOERROR) ERR(e);
+	}
+
+	if (ltest_maxTier < LTEST_MINTIER)
+	{
+		printf("  the highest tier of a run is %ld instead of %ld\n", (long)ltest_maxTier, (long)LTEST_MINTIER);
+		ERR(eBADBTREEPAGE_BTM);
+	}
+
+	e = EduLsM_Flush(catObjForFile, &root, &kdesc, &dlPool, &dlHead);
+	if (e < eNOERROR) ERR(e);
+
+	MAKE_PAGEID(pFid, catObjForFile->volNo, catObjForFile->pageNo);
+	e = EduLsM_DropIndex(&pFid, &root, &dlPool, &dlHead);
+	if (e < eNOERROR) ERR(e);
+
+	return(eNOERROR);
+
+} /* ltest_Run() */
+
+
+
+/*@================================
+ * ltest_Insert()
+ *================================*/
+/*
+ * Function: Four ltest_Insert(ObjectID*, PageID*, KeyDesc*, Four, Four)
+ *
+ * Description:
+ *  Insert the pair of the given key and ObjectID and update the set. An
+ *  insertion of a key in the set should return eDUPLICATEDKEY_BTM in a
+ *  unique index.
+ *
+ * Returns:
+ *  error code
+ *    eBADBTREEPAGE_BTM if the result does not match the set
+ *    some errors caused by function calls
+ */
+Four ltest_Insert(
+    ObjectID        *catObjForFile,     /* IN catalog object of the index file */
+    PageID          *root,              /* IN meta page of the index */
+    KeyDesc         *kdesc,             /* IN key descriptor */
+    Four            v,                  /* IN number of the key */
+    Four            u)                  /* IN number of the ObjectID */
+{
+    Four            e;                  /* error number */
+    KeyValue        kval;               /* key value */
+    ObjectID        oid;                /* ObjectID of the key */
+
+
+	ltest_MakeKey(v, &kval);
+	ltest_MakeOid(catObjForFile, u, &oid);
+
+	e = EduLsM_InsertObject(catObjForFile, root, kdesc, &kval, &oid, &dlPool, &dlHead);
+	if (e == eDUPLICATEDKEY_BTM && (kdesc->flag & KEYFLAG_UNIQUE))
+	{
+		if (ltest_oids[v] != 0) return(eNOERROR);
+
+		printf("  the insertion of the key %ld not in the index returns eDUPLICATEDKEY_BTM\n", (long)v);
+		ERR(eBADBTREEPAGE_BTM);
+	}
+	if (e < eNOERROR) ERR(e);
+
+	if ((kdesc->flag & KEYFLAG_UNIQUE) && ltest_oids[v] != 0)
+	{
+		printf("  the insertion of the duplicated key %ld succeeds\n", (long)v);
+		ERR(eBADBTREEPAGE_BTM);
+	}
+
+	ltest_oids[v] |= 1 << (u - 1);
+
+	return(eNOERROR);
+
+} /* ltest_Insert() */
+
+
+
+/*@================================
+ * ltest_Delete()
+ *================================*/
+/*
+ * Function: Four ltest_Delete(ObjectID*, PageID*, KeyDesc*, Four, Four)
+ *
+ * Description:
+ *  Delete the pair of the given key and ObjectID and update the set. The
+ *  pair need not be in the set.
+ *
+ * Returns:
+ *  error code
+ *    some errors caused by function calls
+ */
+Four ltest_Delete(
+    ObjectID        *catObjForFile,     /* IN catalog object of the index file */
+    PageID          *root,              /* IN meta page of the index */
+    KeyDesc         *kdesc,             /* IN key descriptor */
+    Four            v,                  /* IN number of the key */
+    Four            u)                  /* IN number of the ObjectID */
+{
+    Four            e;                  /* error number */
+    KeyValue        kval;               /* key value */
+    ObjectID        oid;                /* ObjectID of the key */
+
+
+	ltest_MakeKey(v, &kval);
+	ltest_MakeOid(catObjForFile, u, &oid);
+
+	e = EduLsM_DeleteObject(catObjForFile, root, kdesc, &kval, &oid, &dlPool, &dlHead);
+	if (e < eNOERROR) ERR(e);
+
+	ltest_oids[v] &= ~(1 << (u - 1));
+
+	return(eNOERROR);
+
+} /* ltest_Delete() */
+
+
+
+/*@================================
+ * ltest_Search()
+ *================================*/
+/*
+ * Function: Four ltest_Search(PageID*, KeyDesc*, Four)
+ *
+ * Description:
+ *  Search for all the ObjectIDs of the given key and compare them with
+ *  the set. The violations are printed and counted.
+ *
+ * Returns:
+ *  error code
+ *    some errors caused by function calls
+ */
+Four ltest_Search(
+    PageID          *root,              /* IN meta page of the index */
+    KeyDesc         *kdesc,             /* IN key descriptor */
+    Four            v)                  /* IN number of the key */
+{
+    Four            e;                  /* error number */
+    Four            prev;               /* number of the previous ObjectID */
+    Four            found;              /* bit set of the ObjectIDs found */
+    KeyValue        kval;               /* key value */
+    BtreeCursor     cursor;             /* cursor of the search */
+    BtreeCursor     next;               /* the next cursor of the search */
+
+
+	ltest_MakeKey(v, &kval);
+
+	e = EduLsM_Fetch(root, kdesc, &kval, SM_EQ, &kval, SM_EQ, &cursor);
+	if (e < eNOERROR) ERR(e);
+
+	prev = 0;
+	found = 0;
+	while (cursor.flag == CURSOR_ON)
+	{
+		if (ltest_KeyNumber(&cursor.key) != v || cursor.oid.pageNo <= prev || cursor.oid.pageNo > LTEST_NUMOIDS)
+		{
+			printf("  the search for the key %ld returns the pair of the key %ld and the ObjectID %ld\n",
+			       (long)v, (long)ltest_KeyNumber(&cursor.key), (long)cursor.oid.pageNo);
+			ltest_nErrors++;
+			break;
+		}
+		prev = cursor.oid.pageNo;
+		found |= 1 << (prev - 1);
+
+		e = EduLsM_FetchNext(root, kdesc, &kval, SM_EQ, &cursor, &next);
+		if (e < eNOERROR) ERR(e);
+		cursor = next;
+	}
+
+	if (found != ltest_oids[v])
+	{
+		printf("  the search for the key %ld returns the ObjectIDs 0x%02lx instead of 0x%02lx\n",
+		       (long)v, (long)found, (long)ltest_oids[v]);
+		ltest_nErrors++;
+	}
+
+	return(eNOERROR);
+
+} /* ltest_Search() */
+
+
+
+/*@================================
+ * ltest_Check()
+ *================================*/
+/*
+ * Function: Four ltest_Check(PageID*, KeyDesc*, char*)
+ *
+ * Description:
+ *  Check the pairs returned by a full scan against the set. The violations
+ *  are printed.
+ *
+ * Returns:
+ *  error code
+ *    eBADBTREEPAGE_BTM if the check fails
+ *    some errors caused by function calls
+ */
+Four ltest_Check(
+    PageID          *root,              /* IN meta page of the index */
+    KeyDesc         *kdesc,             /* IN key descriptor */
+    char            *name)              /* IN name of the step */
+{
+    Four            e;                  /* error number */
+    Four            v, u;               /* numbers of a pair */
+    Four            prevV, prevU;       /* numbers of the previous pair */
+    Four            nPairs;             /* # of pairs returned by the scan */
+    Four            nAlive;             /* # of pairs of the set */
+    Four            nRuns;              /* # of runs of the index */
+    Four            maxTier;            /* the highest tier of the runs */
+    KeyValue        kval;               /* a dummy key of the scan */
+    BtreeCursor     cursor;             /* cursor of the scan */
+    BtreeCursor     next;               /* the next cursor of the scan */
+
+
+	nPairs = nAlive = 0;
+	for (v = 0; v < LTEST_NUMKEYS; v++)
+		for (u = 1; u <= LTEST_NUMOIDS; u++)
+			if (ltest_oids[v] & (1 << (u - 1))) nAlive++;
+
+	prevV = -1; prevU = 0;
+	ltest_MakeKey(0, &kval);
+	e = EduLsM_Fetch(root, kdesc, &kval, SM_BOF, &kval, SM_EOF, &cursor);
+	if (e < eNOERROR) ERR(e);
+
+	while (cursor.flag == CURSOR_ON)
+	{
+		v = ltest_KeyNumber(&cursor.key);
+		u = cursor.oid.pageNo;
+		if (v < prevV || (v == prevV && u <= prevU))
+		{
+			printf("  the scan returns the pair (%ld, %ld) after (%ld, %ld)\n",
+			       (long)v, (long)u, (long)prevV, (long)prevU);
+			ltest_nErrors++;
+		}
+		else if (v >= LTEST_NUMKEYS || u < 1 || u > LTEST_NUMOIDS || !(ltest_oids[v] & (1 << (u - 1))))
+		{
+			printf("  the scan returns the pair of the key %ld and the ObjectID %ld\n", (long)v, (long)u);
+			ltest_nErrors++;
+		}
+		prevV = v; prevU = u;
+		nPairs++;
+
+		e = EduLsM_FetchNext(root, kdesc, &kval, SM_EOF, &cursor, &next);
+		if (e < eNOERROR) ERR(e);
+		cursor = next;
+	}
+
+	if (nPairs != nAlive)
+	{
+		printf("  the scan returns %ld pairs instead of %ld\n", (long)nPairs, (long)nAlive);
+		ltest_nErrors++;
+	}
+
+	e = ltest_Runs(root, &nRuns, &maxTier);
+	if (e < eNOERROR) ERR(e);
+
+	if (maxTier > ltest_maxTier) ltest_maxTier = maxTier;
+
+	printf("%-32s %6ld pairs %2ld runs %s\n", name, (long)nPairs, (long)nRuns, (ltest_nErrors == 0) ? "ok" : "FAILED");
+
+	if (ltest_nErrors > 0) ERR(eBADBTREEPAGE_BTM);
+
+	return(eNOERROR);
+
+} /* ltest_Check() */
+
+
+
+/*@================================
+ * ltest_Runs()
+ *================================*/
+/*
+ * Function: Four ltest_Runs(PageID*, Four*, Four*)
+ *
+ * Description:
+ *  Get the number of runs of the index and the highest tier among them
+ *  from the meta page.
+ *
+ * Returns:
+ *  error code
+ *    some errors caused by function calls
+ */
+Four ltest_Runs(
+    PageID          *root,              /* IN meta page of the index */
+    Four            *nRuns,             /* OUT # of runs */
+    Four            *maxTier)           /* OUT the highest tier of the runs */
+{
+    Four            e;                  /* error number */
+    Four            i;                  /* index of a run */
+    LsmMeta         *meta;              /* buffer of the meta page */
+
+
+	e = BfM_GetTrain(root, (char**)&meta, PAGE_BUF);
+	if (e < eNOERROR) ERR(e);
+
+	*nRuns = meta->hdr.nRuns;
+	*maxTier = 0;
+	for (i = 0; i < meta->hdr.nRuns; i++)
+		if (meta->run[i].tier > *maxTier) *maxTier = meta->run[i].tier;
+
+	e = BfM_FreeTrain(root, PAGE_BUF);
+	if (e < eNOERROR) ERR(e);
+
+	return(eNOERROR);
+
+} /* ltest_Runs() */
+
+
+
+/*@================================
+ * ltest_MakeKey()
+ *================================*/
+/*
+ * Function: void ltest_MakeKey(Four, KeyValue*)
+ *
+ * Description:
+ *  Make the integer key value of the given number.
+ *
+ * Returns:
+ *  None
+ */
+void ltest_MakeKey(
+    Four            v,                  /* IN number of the key */
+    KeyValue        *kval)              /* OUT key value */
+{
+    Four_Invariable k;                  /* the key as an integer */
+
+
+	k = v;
+	memcpy(kval->val, &k, sizeof(Four_Invariable));
+	kval->len = sizeof(Four_Invariable);
+
+} /* ltest_MakeKey() */
+
+
+
+/*@================================
+ * ltest_MakeOid()
+ *================================*/
+/*
+ * Function: void ltest_MakeOid(ObjectID*, Four, ObjectID*)
+ *
+ * Description:
+ *  Make the ObjectID of the given number. The number is put into 'pageNo',
+ *  since the pairs are ordered and told apart without 'unique'.
+ *
+ * Returns:
+ *  None
+ */
+void ltest_MakeOid(
+    ObjectID        *catObjForFile,     /* IN catalog object of the index file */
+    Four            u,                  /* IN number of the ObjectID */
+    ObjectID        *oid)               /* OUT ObjectID */
+{
+	oid->volNo = catObjForFile->volNo;
+	oid->pageNo = u;
+	oid->slotNo = 0;
+	oid->unique = u;
+
+} /* ltest_MakeOid() */
+
+
+
+/*@================================
+ * ltest_KeyNumber()
+ *================================*/
+/*
+ * Function: Four ltest_KeyNumber(KeyValue*)
+ *
+ * Description:
+ *  Return the number of a key made by ltest_MakeKey().
+ *
+ * Returns:
+ *  number of the key
+ */
+Four ltest_KeyNumber(
+    KeyValue        *kval)              /* IN key value */
+{
+    Four_Invariable k;                  /* the key as an integer */
+
+
+	memcpy(&k, kval->val, sizeof(Four_Invariable));
+
+	return(k);
+
+} /* ltest_KeyNumber() */
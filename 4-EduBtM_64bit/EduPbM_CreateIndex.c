@@ -0,0 +1,78 @@
+/******************************************************************************/
+/*                                                                            */
+/*    ODYSSEUS/EduCOSMOS Educational-Purpose Object Storage System            */
+/*                                                                            */
+/*    Developed by Professor Kyu-Young Whang et al.                           */
+/*                                                                            */
+/*    Database and Multimedia Laboratory                                      */
+/*                                                                            */
+/*    Computer Science Department and                                         */
+/*    Advanced Information Technology Research Center (AITrc)                 */
+/*    Korea Advanced Institute of Science and Technology (KAIST)              */
+/*                                                                            */
+/*    e-mail: kywhang@cs.kaist.ac.kr                                          */
+/*    phone: +82-42-350-7722                                                  */
+/*    fax: +82-42-350-8380                                                    */
+/*                                                                            */
+/*    Copyright (c) 1995-2013 by Kyu-Young Whang                              */
+/*                                                                            */
+/*    All rights reserved. No part of this software may be reproduced,        */
+/*    stored in a retrieval system, or transmitted, in any form or by any     */
+/*    means, electronic, mechanical, photocopying, recording, or otherwise,   */
+/*    without prior written permission of the copyright owner.                */
+/*                                                                            */
+/******************************************************************************/
+/* 
+ * Module :	EduPbM_CreateIndex.c
+ *
+ * Description : 
+ *  Create the new partitioned B+ tree index. 
+ *
+ * Exports:
+ *  Four EduPbM_CreateIndex(ObjectID*, PageID*)
+ */
+
+
+#include "EduBtM_common.h"
+#include "EduPbM.h"
+#include "EduBtM.h"
+
+
+
+/*@================================
+ * EduPbM_CreateIndex()
+ *================================*/
+/* 
+ * Function: Four  EduPbM_CreateIndex(ObjectID*, PageID*)
+ *
+ * Description : 
+ *  Create the new partitioned B+ tree index. 
+ *  The index is an ordinary B+ tree of the index file; it has no partition
+ *  until the first insertion. The partitions remembered for an index
+ *  dropped before at the same root page are forgotten.
+ *
+ * Returns :
+ *  error code
+ *    eBADPARAMETER_BTM
+ *    some errors caused by function calls
+ *
+ * Side effects:
+ *  The parameter rootPid is filled with the new root page's PageID. 
+ */
+Four EduPbM_CreateIndex(
+    ObjectID *catObjForFile,	/* IN catalog object of the index file */
+    PageID *rootPid)		/* OUT root page of the newly created index */
+{
+    Four e;			/* error number */
+
+
+    if (catObjForFile == NULL || rootPid == NULL) ERR(eBADPARAMETER_BTM);
+
+	e = EduBtM_CreateIndex(catObjForFile, rootPid);
+	if (e < 0) ERR(e);
+
+	edupbm_DiscardPartitions(rootPid);
+
+    return(eNOERROR);
+    
+} /* EduPbM_CreateIndex() */
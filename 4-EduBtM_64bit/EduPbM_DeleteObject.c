@@ -0,0 +1,110 @@
+/******************************************************************************/
+/*                                                                            */
+/*    ODYSSEUS/EduCOSMOS Educational-Purpose Object Storage System            */
+/*                                                                            */
+/*    Developed by Professor Kyu-Young Whang et al.                           */
+/*                                                                            */
+/*    Database and Multimedia Laboratory                                      */
+/*                                                                            */
+/*    Computer Science Department and                                         */
+/*    Advanced Information Technology Research Center (AITrc)                 */
+/*    Korea Advanced Institute of Science and Technology (KAIST)              */
+/*                                                                            */
+/*    e-mail: kywhang@cs.kaist.ac.kr                                          */
+/*    phone: +82-42-350-7722                                                  */
+/*    fax: +82-42-350-8380                                                    */
+/*                                                                            */
+/*    Copyright (c) 1995-2013 by Kyu-Young Whang                              */
+/*                                                                            */
+/*    All rights reserved. No part of this software may be reproduced,        */
+/*    stored in a retrieval system, or transmitted, in any form or by any     */
+/*    means, electronic, mechanical, photocopying, recording, or otherwise,   */
+/*    without prior written permission of the copyright owner.                */
+/*                                                                            */
+/******************************************************************************/
+/*
+ * Module: EduPbM_DeleteObject.c
+ *
+ * Description :
+ *  Delete an ObjectID 'oid' whose key value is 'kval' from a partitioned
+ *  B+ tree.
+ *
+ * Exports:
+ *  Four EduPbM_DeleteObject(ObjectID*, PageID*, KeyDesc*, KeyValue*, ObjectID*, Pool*, DeallocListElem*)
+ */
+
+
+#include "EduBtM_common.h"
+#include "EduPbM.h"
+#include "EduBtM.h"
+
+
+
+/*@================================
+ * EduPbM_DeleteObject()
+ *================================*/
+/*
+ * Function: Four EduPbM_DeleteObject(ObjectID*, PageID*, KeyDesc*, KeyValue*, ObjectID*, Pool*, DeallocListElem*)
+ * 
+ * Description :
+ *  Delete an ObjectID 'oid' whose key value is 'kval' from a partitioned
+ *  B+ tree. The partitions are searched from the newest one, and the entry
+ *  is deleted from the partition holding the key.
+ *
+ * Returns:
+ *  error code
+ *    eBADPARAMETER_BTM
+ *    eNOTFOUND_BTM
+ *    some errors caused by function calls
+ */
+Four EduPbM_DeleteObject(
+    ObjectID *catObjForFile,	/* IN catalog object of the index file */
+    PageID   *root,		/* IN root page of the partitioned B+ tree */
+    KeyDesc  *kdesc,		/* IN key descriptor */
+    KeyValue *kval,		/* IN key value */
+    ObjectID *oid,		/* IN ObjectID which will be deleted */
+    Pool     *dlPool,		/* INOUT pool of dealloc list */
+    DeallocListElem *dlHead) /* INOUT head of the dealloc list */
+{
+    Four e;			/* error number */
+    Two  i;			/* index of a partition */
+    KeyDesc pkdesc;		/* key descriptor of the B+ tree */
+    KeyValue pkval;		/* key of the B+ tree */
+    BtreeCursor cursor;		/* cursor on the key */
+    PbmPartitions *parts;	/* the partitions of the index */
+
+
+    /*@ check parameters */
+    
+    if (catObjForFile == NULL || root == NULL || kval == NULL || oid == NULL) ERR(eBADPARAMETER_BTM);
+
+    if (dlPool == NULL || dlHead == NULL) ERR(eBADPARAMETER_BTM);
+
+	e = edupbm_KeyDesc(kdesc, &pkdesc);
+	if (e < 0) ERR(e);
+
+	e = edupbm_GetPartitions(root, kdesc, &parts);
+	if (e < 0) ERR(e);
+
+	for (i = parts->nPartitions - 1; i >= 0; i--)
+	{
+		e = edupbm_FetchPartition(root, kdesc, parts->partition[i], kval, SM_GE, kval, SM_EQ, &cursor);
+		if (e < 0) ERR(e);
+
+		if (cursor.flag == CURSOR_ON) break;
+	}
+
+	/* the key is in at most one partition */
+	if (i < 0 || btm_ObjectIdComp(&cursor.oid, oid) != EQUAL) ERR(eNOTFOUND_BTM);
+
+	e = edupbm_MakeKey(kdesc, parts->partition[i], kval, &pkval);
+	if (e < 0) ERR(e);
+
+	e = EduBtM_DeleteObject(catObjForFile, root, &pkdesc, &pkval, oid, dlPool, dlHead);
+	if (e < 0) ERR(e);
+
+	if (i == parts->nPartitions - 1) parts->nNewest--;
+
+    return(eNOERROR);
+    
+}   /* EduPbM_DeleteObject() */
@@ -0,0 +1,77 @@
+/******************************************************************************/
+/*                                                                            */
+/*    ODYSSEUS/EduCOSMOS Educational-Purpose Object Storage System            */
+/*                                                                            */
+/*    Developed by Professor Kyu-Young Whang et al.                           */
+/*                                                                            */
+/*    Database and Multimedia Laboratory                                      */
+/*                                                                            */
+/*    Computer Science Department and                                         */
+/*    Advanced Information Technology Research Center (AITrc)                 */
+/*    Korea Advanced Institute of Science and Technology (KAIST)              */
+/*                                                                            */
+/*    e-mail: kywhang@cs.kaist.ac.kr                                          */
+/*    phone: +82-42-350-7722                                                  */
+/*    fax: +82-42-350-8380                                                    */
+/*                                                                            */
+/*    Copyright (c) 1995-2013 by Kyu-Young Whang                              */
+/*                                                                            */
+/*    All rights reserved. No part of this software may be reproduced,        */
+/*    stored in a retrieval system, or transmitted, in any form or by any     */
+/*    means, electronic, mechanical, photocopying, recording, or otherwise,   */
+/*    without prior written permission of the copyright owner.                */
+/*                                                                            */
+/******************************************************************************/
+/* 
+ * Module:	EduPbM_DropIndex.c
+ *
+ * Description : 
+ *  Drop the partitioned B+ tree index specified by 'rootPid', the root
+ *  PageID of the index.
+ *
+ * Exports:
+ *  Four EduPbM_DropIndex(PhysicalFileID*, PageID*, Pool*, DeallocListElem*)
+ */
+
+
+#include "EduBtM_common.h"
+#include "EduPbM.h"
+#include "EduBtM.h"
+
+
+
+/*@================================
+ * EduPbM_DropIndex()
+ *================================*/
+/* 
+ * Function: Four EduPbM_DropIndex(PhysicalFileID*, PageID*, Pool*, DeallocListElem*)
+ *
+ * Description : 
+ *  Drop the partitioned B+ tree index specified by 'rootPid'. All the
+ *  partitions are in the one B+ tree, whose pages are put into the dealloc
+ *  list; the partitions kept in memory are forgotten.
+ *
+ * Returns:
+ *  error code
+ *    eBADPARAMETER_BTM
+ *    some errors : by other function calls
+ */
+Four EduPbM_DropIndex(
+    PhysicalFileID *pFid,	/* IN FileID of the index file */
+    PageID *rootPid,		/* IN root PageID to be dropped */
+    Pool   *dlPool,		/* INOUT pool of the dealloc list elements */
+    DeallocListElem *dlHead) /* INOUT head of the dealloc list */
+{
+    Four e;			/* for the error number */
+
+
+    if (pFid == NULL || rootPid == NULL || dlPool == NULL || dlHead == NULL) ERR(eBADPARAMETER_BTM);
+
+	edupbm_DiscardPartitions(rootPid);
+
+	e = EduBtM_DropIndex(pFid, rootPid, dlPool, dlHead);
+	if (e < 0) ERR(e);
+
+    return(eNOERROR);
+
+} /* EduPbM_DropIndex() */
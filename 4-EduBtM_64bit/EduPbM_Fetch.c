@@ -0,0 +1,243 @@
+/******************************************************************************/
+/*                                                                            */
+/*    ODYSSEUS/EduCOSMOS Educational-Purpose Object Storage System            */
+/*                                                                            */
+/*    Developed by Professor Kyu-Young Whang et al.                           */
+/*                                                                            */
+/*    Database and Multimedia Laboratory                                      */
+/*                                                                            */
+/*    Computer Science Department and                                         */
+/*    Advanced Information Technology Research Center (AITrc)                 */
+/*    Korea Advanced Institute of Science and Technology (KAIST)              */
+/*                                                                            */
+/*    e-mail: kywhang@cs.kaist.ac.kr                                          */
+/*    phone: +82-42-350-7722                                                  */
+/*    fax: +82-42-350-8380                                                    */
+/*                                                                            */
+/*    Copyright (c) 1995-2013 by Kyu-Young Whang                              */
+/*                                                                            */
+/*    All rights reserved. No part of this software may be reproduced,        */
+/*    stored in a retrieval system, or transmitted, in any form or by any     */
+/*    means, electronic, mechanical, photocopying, recording, or otherwise,   */
+/*    without prior written permission of the copyright owner.                */
+/*                                                                            */
+/******************************************************************************/
+/*
+ * Module: EduPbM_Fetch.c
+ *
+ * Description :
+ *  Find the first object satisfying the given condition from a partitioned
+ *  B+ tree. Every live partition is searched for its first entry satisfying
+ *  the condition, and the entry with the smallest key is taken; the keys
+ *  are unique over all the partitions, so no two entries tie. The partition
+ *  numbers are not seen in the keys of the cursors.
+ *  The start condition is one among SM_BOF, SM_EQ, SM_GT, SM_GE and the
+ *  stop condition is one among SM_EOF, SM_EQ, SM_LT, SM_LE; that is, only
+ *  the forward scan is supported.
+ *
+ * Exports:
+ *  Four EduPbM_Fetch(PageID*, KeyDesc*, KeyValue*, Four, KeyValue*, Four, BtreeCursor*)
+ *  Four edupbm_FetchPartition(PageID*, KeyDesc*, Four, KeyValue*, Four, KeyValue*, Four, BtreeCursor*)
+ *  Four edupbm_Next(PageID*, KeyDesc*, PbmPartitions*, KeyValue*, Four, KeyValue*, Four, BtreeCursor*)
+ */
+
+
+#include "EduBtM_common.h"
+#include "EduPbM.h"
+#include "EduBtM.h"
+
+
+
+/*@================================
+ * EduPbM_Fetch()
+ *================================*/
+/*
+ * Function: Four EduPbM_Fetch(PageID*, KeyDesc*, KeyValue*, Four, KeyValue*, Four, BtreeCursor*)
+ *
+ * Description:
+ *  Find the first object satisfying the given condition. See above for detail.
+ *
+ * Returns:
+ *  error code
+ *    eBADPARAMETER_BTM
+ *    eBADCOMPOP_BTM
+ *    some errors caused by function calls
+ *
+ * Side effects:
+ *  cursor  : The found ObjectID and its key. The position of the cursor is
+ *            its key, so the cursor stays valid when the partitions are
+ *            merged.
+ */
+Four EduPbM_Fetch(
+    PageID   *root,		/* IN root page of the partitioned B+ tree */
+    KeyDesc  *kdesc,		/* IN key descriptor */
+    KeyValue *startKval,	/* IN key value of start condition */
+    Four     startCompOp,	/* IN comparison operator of start condition */
+    KeyValue *stopKval,		/* IN key value of stop condition */
+    Four     stopCompOp,	/* IN comparison operator of stop condition */
+    BtreeCursor *cursor)	/* OUT the cursor */
+{
+    Four e;		   /* error number */
+    Four seekOp;	   /* comparison operator of the seek in each partition */
+    PbmPartitions *parts;  /* the partitions of the index */
+
+    
+    if (root == NULL || kdesc == NULL || cursor == NULL) ERR(eBADPARAMETER_BTM);
+
+	switch (startCompOp) {
+	  case SM_BOF:
+		seekOp = SM_BOF;
+		break;
+	  case SM_EQ:
+	  case SM_GE:
+		seekOp = SM_GE;
+		break;
+	  case SM_GT:
+		seekOp = SM_GT;
+		break;
+	  default:
+		ERR(eBADCOMPOP_BTM);
+	}
+
+	if (stopCompOp != SM_EOF && stopCompOp != SM_EQ &&
+	    stopCompOp != SM_LT && stopCompOp != SM_LE) ERR(eBADCOMPOP_BTM);
+
+	if (seekOp != SM_BOF && startKval == NULL) ERR(eBADPARAMETER_BTM);
+	if (stopCompOp != SM_EOF && stopKval == NULL) ERR(eBADPARAMETER_BTM);
+
+	e = edupbm_GetPartitions(root, kdesc, &parts);
+	if (e < 0) ERR(e);
+
+	e = edupbm_Next(root, kdesc, parts, startKval, seekOp, stopKval, stopCompOp, cursor);
+	if (e < 0) ERR(e);
+
+    return(eNOERROR);
+
+} /* EduPbM_Fetch() */
+
+
+
+/*@================================
+ * edupbm_FetchPartition()
+ *================================*/
+/*
+ * Function: Four edupbm_FetchPartition(PageID*, KeyDesc*, Four, KeyValue*, Four,
+ *                                      KeyValue*, Four, BtreeCursor*)
+ *
+ * Description:
+ *  Find the first entry of the partition satisfying the conditions on the
+ *  user's keys. SM_BOF starts at the smallest key of the partition and
+ *  SM_EOF stops before the smallest key of the next partition number;
+ *  SM_EQ stops after the first entry unless its key is the stop key.
+ *
+ * Returns:
+ *  Error code
+ *    some errors caused by function calls
+ *
+ * Side effects:
+ *  cursor : a cursor of the B+ tree; its key has the partition number
+ */
+Four edupbm_FetchPartition(
+    PageID              *root,          /* IN root page of the index */
+    KeyDesc             *kdesc,         /* IN the user's key descriptor */
+    Four                partition,      /* IN the partition number */
+    KeyValue            *startKval,     /* IN the user's key of the start condition */
+    Four                startCompOp,    /* IN SM_BOF, SM_GE or SM_GT */
+    KeyValue            *stopKval,      /* IN the user's key of the stop condition */
+    Four                stopCompOp,     /* IN SM_EOF, SM_EQ, SM_LT or SM_LE */
+    BtreeCursor         *cursor)        /* OUT the cursor */
+{
+    Four                e;              /* error number */
+    KeyDesc             pkdesc;         /* key descriptor of the B+ tree */
+    KeyValue            start;          /* key of the start condition */
+    KeyValue            stop;           /* key of the stop condition */
+
+
+	e = edupbm_KeyDesc(kdesc, &pkdesc);
+	if (e < 0) ERR(e);
+
+	if (startCompOp == SM_BOF)
+	{
+		e = edupbm_MakeKey(kdesc, partition, NULL, &start);
+		startCompOp = SM_GE;
+	}
+	else
+		e = edupbm_MakeKey(kdesc, partition, startKval, &start);
+	if (e < 0) ERR(e);
+
+	if (stopCompOp == SM_EOF)
+	{
+		e = edupbm_MakeKey(kdesc, partition + 1, NULL, &stop);
+		stopCompOp = SM_LT;
+	}
+	else
+		e = edupbm_MakeKey(kdesc, partition, stopKval, &stop);
+	if (e < 0) ERR(e);
+
+	/* EduBtM_Fetch() takes SM_EQ as a stop condition of no effect */
+	e = EduBtM_Fetch(root, &pkdesc, &start, startCompOp, &stop,
+	                 (stopCompOp == SM_EQ) ? SM_LE : stopCompOp, cursor);
+	if (e < 0) ERR(e);
+
+	if (stopCompOp == SM_EQ && cursor->flag == CURSOR_ON &&
+	    edubtm_KeyCompare(&pkdesc, &cursor->key, &stop) != EQUAL)
+		cursor->flag = CURSOR_EOS;
+
+	return(eNOERROR);
+
+} /* edupbm_FetchPartition() */
+
+
+
+/*@================================
+ * edupbm_Next()
+ *================================*/
+/*
+ * Function: Four edupbm_Next(PageID*, KeyDesc*, PbmPartitions*, KeyValue*, Four,
+ *                            KeyValue*, Four, BtreeCursor*)
+ *
+ * Description:
+ *  Find the entry with the smallest key over the first entries of the
+ *  partitions satisfying the conditions.
+ *
+ * Returns:
+ *  Error code
+ *    some errors caused by function calls
+ *
+ * Side effects:
+ *  cursor : the entry found with the user's key, or CURSOR_EOS
+ */
+Four edupbm_Next(
+    PageID              *root,          /* IN root page of the index */
+    KeyDesc             *kdesc,         /* IN the user's key descriptor */
+    PbmPartitions       *parts,         /* IN the partitions */
+    KeyValue            *startKval,     /* IN the user's key of the start condition */
+    Four                startCompOp,    /* IN SM_BOF, SM_GE or SM_GT */
+    KeyValue            *stopKval,      /* IN the user's key of the stop condition */
+    Four                stopCompOp,     /* IN SM_EOF, SM_EQ, SM_LT or SM_LE */
+    BtreeCursor         *cursor)        /* OUT the cursor */
+{
+    Four                e;              /* error number */
+    Two                 i;              /* index of a partition */
+    BtreeCursor         c;              /* the first entry of a partition */
+
+
+	cursor->flag = CURSOR_EOS;
+
+	for (i = 0; i < parts->nPartitions; i++)
+	{
+		e = edupbm_FetchPartition(root, kdesc, parts->partition[i], startKval, startCompOp,
+		                          stopKval, stopCompOp, &c);
+		if (e < 0) ERR(e);
+
+		if (c.flag != CURSOR_ON) continue;
+
+		edupbm_UserKey(&c.key, &c.key);
+
+		if (cursor->flag != CURSOR_ON || edubtm_KeyCompare(kdesc, &c.key, &cursor->key) == LESS)
+			*cursor = c;
+	}
+
+	return(eNOERROR);
+
+} /* edupbm_Next() */
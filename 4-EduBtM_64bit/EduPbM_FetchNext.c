@@ -0,0 +1,98 @@
+/******************************************************************************/
+/*                                                                            */
+/*    ODYSSEUS/EduCOSMOS Educational-Purpose Object Storage System            */
+/*                                                                            */
+/*    Developed by Professor Kyu-Young Whang et al.                           */
+/*                                                                            */
+/*    Database and Multimedia Laboratory                                      */
+/*                                                                            */
+/*    Computer Science Department and                                         */
+/*    Advanced Information Technology Research Center (AITrc)                 */
+/*    Korea Advanced Institute of Science and Technology (KAIST)              */
+/*                                                                            */
+/*    e-mail: kywhang@cs.kaist.ac.kr                                          */
+/*    phone: +82-42-350-7722                                                  */
+/*    fax: +82-42-350-8380                                                    */
+/*                                                                            */
+/*    Copyright (c) 1995-2013 by Kyu-Young Whang                              */
+/*                                                                            */
+/*    All rights reserved. No part of this software may be reproduced,        */
+/*    stored in a retrieval system, or transmitted, in any form or by any     */
+/*    means, electronic, mechanical, photocopying, recording, or otherwise,   */
+/*    without prior written permission of the copyright owner.                */
+/*                                                                            */
+/******************************************************************************/
+/*
+ * Module: EduPbM_FetchNext.c
+ *
+ * Description:
+ *  Find the next ObjectID satisfying the given condition from a partitioned
+ *  B+ tree. The current ObjectID is specified by the 'current'.
+ *
+ * Exports:
+ *  Four EduPbM_FetchNext(PageID*, KeyDesc*, KeyValue*, Four, BtreeCursor*, BtreeCursor*)
+ */
+
+
+#include "EduBtM_common.h"
+#include "EduPbM.h"
+
+
+
+/*@================================
+ * EduPbM_FetchNext()
+ *================================*/
+/*
+ * Function: Four EduPbM_FetchNext(PageID*, KeyDesc*, KeyValue*,
+ *                              Four, BtreeCursor*, BtreeCursor*)
+ *
+ * Description:
+ *  Fetch the next ObjectID satisfying the given condition. The search
+ *  starts after the key of the current cursor in every partition, so the
+ *  insertions, deletions and merges done after the current cursor was
+ *  fetched are seen by the scan.
+ *
+ * Returns:
+ *  error code
+ *    eBADPARAMETER_BTM
+ *    eBADCOMPOP_BTM
+ *    eBADCURSOR
+ *    some errors caused by function calls
+ */
+Four EduPbM_FetchNext(
+    PageID                      *root,          /* IN root page of the partitioned B+ tree */
+    KeyDesc                     *kdesc,         /* IN key descriptor */
+    KeyValue                    *kval,          /* IN key value of stop condition */
+    Four                        compOp,         /* IN comparison operator of stop condition */
+    BtreeCursor                 *current,       /* IN current cursor */
+    BtreeCursor                 *next)          /* OUT next cursor */
+{
+    Four                        e;              /* error number */
+    PbmPartitions               *parts;         /* the partitions of the index */
+    KeyValue                    after;          /* key of the current cursor */
+
+
+    if (root == NULL || kdesc == NULL || current == NULL || next == NULL) ERR(eBADPARAMETER_BTM);
+
+	if (compOp != SM_EOF && compOp != SM_EQ && compOp != SM_LT && compOp != SM_LE) ERR(eBADCOMPOP_BTM);
+
+	if (compOp != SM_EOF && kval == NULL) ERR(eBADPARAMETER_BTM);
+
+	if (current->flag == CURSOR_EOS)
+	{
+		*next = *current;
+		return(eNOERROR);
+	}
+
+	if (current->flag != CURSOR_ON) ERR(eBADCURSOR);
+
+	e = edupbm_GetPartitions(root, kdesc, &parts);
+	if (e < 0) ERR(e);
+
+	after = current->key;
+	e = edupbm_Next(root, kdesc, parts, &after, SM_GT, kval, compOp, next);
+	if (e < 0) ERR(e);
+
+    return(eNOERROR);
+
+} /* EduPbM_FetchNext() */
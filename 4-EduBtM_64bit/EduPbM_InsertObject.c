@@ -0,0 +1,122 @@
+/******************************************************************************/
+/*                                                                            */
+/*    ODYSSEUS/EduCOSMOS Educational-Purpose Object Storage System            */
+/*                                                                            */
+/*    Developed by Professor Kyu-Young Whang et al.                           */
+/*                                                                            */
+/*    Database and Multimedia Laboratory                                      */
+/*                                                                            */
+/*    Computer Science Department and                                         */
+/*    Advanced Information Technology Research Center (AITrc)                 */
+/*    Korea Advanced Institute of Science and Technology (KAIST)              */
+/*                                                                            */
+/*    e-mail: kywhang@cs.kaist.ac.kr                                          */
+/*    phone: +82-42-350-7722                                                  */
+/*    fax: +82-42-350-8380                                                    */
+/*                                                                            */
+/*    Copyright (c) 1995-2013 by Kyu-Young Whang                              */
+/*                                                                            */
+/*    All rights reserved. No part of this software may be reproduced,        */
+/*    stored in a retrieval system, or transmitted, in any form or by any     */
+/*    means, electronic, mechanical, photocopying, recording, or otherwise,   */
+/*    without prior written permission of the copyright owner.                */
+/*                                                                            */
+/******************************************************************************/
+/*
+ * Module: EduPbM_InsertObject.c
+ *
+ * Description :
+ *  Insert an ObjectID 'oid' into a partitioned B+ tree whose key value is
+ *  'kval'.
+ *
+ * Exports:
+ *  Four EduPbM_InsertObject(ObjectID*, PageID*, KeyDesc*, KeyValue*, ObjectID*, Pool*, DeallocListElem*)
+ */
+
+
+#include "EduBtM_common.h"
+#include "EduPbM.h"
+#include "EduBtM.h"
+
+
+
+/*@================================
+ * EduPbM_InsertObject()
+ *================================*/
+/*
+ * Function: Four EduPbM_InsertObject(ObjectID*, PageID*, KeyDesc*, KeyValue*, ObjectID*, Pool*, DeallocListElem*)
+ * 
+ * Description :
+ *  Insert an ObjectID 'oid' into a partitioned B+ tree whose key value is
+ *  'kval'. The entry goes to the newest partition, whose pages are few
+ *  and stay in the buffer, so a stream of insertions writes no leaf of
+ *  the older partitions. A new partition is started when the newest one
+ *  has PBM_PARTITIONENTRIES entries or has been sealed by
+ *  EduPbM_NewPartition(), unless there are PBM_MAXPARTITIONS partitions.
+ *  As EduBtM keeps one ObjectID per key, the key is searched in the older
+ *  partitions first and rejected as EduBtM_InsertObject() would reject it.
+ *
+ * Returns:
+ *  error code
+ *    eBADPARAMETER_BTM
+ *    eDUPLICATEDKEY_BTM
+ *    eDUPLICATEDOBJECTID_BTM
+ *    eNOTSUPPORTED_EDUBTM
+ *    some errors caused by function calls
+ */
+Four EduPbM_InsertObject(
+    ObjectID *catObjForFile,	/* IN catalog object of the index file */
+    PageID   *root,		/* IN root page of the partitioned B+ tree */
+    KeyDesc  *kdesc,		/* IN key descriptor */
+    KeyValue *kval,		/* IN key value */
+    ObjectID *oid,		/* IN ObjectID which will be inserted */
+    Pool     *dlPool,		/* INOUT pool of dealloc list */
+    DeallocListElem *dlHead) /* INOUT head of the dealloc list */
+{
+    Four e;			/* error number */
+    Two  i;			/* index of a partition */
+    KeyDesc pkdesc;		/* key descriptor of the B+ tree */
+    KeyValue pkval;		/* key of the B+ tree */
+    BtreeCursor cursor;		/* cursor for the duplicate check */
+    PbmPartitions *parts;	/* the partitions of the index */
+
+
+    /*@ check parameters */
+    
+    if (catObjForFile == NULL || root == NULL || kval == NULL || oid == NULL) ERR(eBADPARAMETER_BTM);
+
+    if (dlPool == NULL || dlHead == NULL) ERR(eBADPARAMETER_BTM);
+
+	e = edupbm_KeyDesc(kdesc, &pkdesc);
+	if (e < 0) ERR(e);
+
+	e = edupbm_GetPartitions(root, kdesc, &parts);
+	if (e < 0) ERR(e);
+
+	if (parts->nPartitions == 0 ||
+	    ((parts->sealed || parts->nNewest >= PBM_PARTITIONENTRIES) && parts->nPartitions < PBM_MAXPARTITIONS))
+	{
+		e = edupbm_AddPartition(parts);
+		if (e < 0) ERR(e);
+	}
+
+	/* the newest partition is checked by EduBtM_InsertObject() */
+	for (i = 0; i < parts->nPartitions - 1; i++)
+	{
+		e = edupbm_FetchPartition(root, kdesc, parts->partition[i], kval, SM_GE, kval, SM_EQ, &cursor);
+		if (e < 0) ERR(e);
+
+		if (cursor.flag == CURSOR_ON) ERR(edubtm_DuplicateError(kdesc, &cursor.oid, oid));
+	}
+
+	e = edupbm_MakeKey(kdesc, parts->partition[parts->nPartitions - 1], kval, &pkval);
+	if (e < 0) ERR(e);
+
+	e = EduBtM_InsertObject(catObjForFile, root, &pkdesc, &pkval, oid, dlPool, dlHead);
+	if (e < 0) ERR(e);
+
+	parts->nNewest++;
+
+    return(eNOERROR);
+    
+}   /* EduPbM_InsertObject() */
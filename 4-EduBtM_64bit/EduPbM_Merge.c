@@ -0,0 +1,164 @@
+/******************************************************************************/
+/*                                                                            */
+/*    ODYSSEUS/EduCOSMOS Educational-Purpose Object Storage System            */
+/*                                                                            */
+/*    Developed by Professor Kyu-Young Whang et al.                           */
+/*                                                                            */
+/*    Database and Multimedia Laboratory                                      */
+/*                                                                            */
+/*    Computer Science Department and                                         */
+/*    Advanced Information Technology Research Center (AITrc)                 */
+/*    Korea Advanced Institute of Science and Technology (KAIST)              */
+/*                                                                            */
+/*    e-mail: kywhang@cs.kaist.ac.kr                                          */
+/*    phone: +82-42-350-7722                                                  */
+/*    fax: +82-42-350-8380                                                    */
+/*                                                                            */
+/*    Copyright (c) 1995-2013 by Kyu-Young Whang                              */
+/*                                                                            */
+/*    All rights reserved. No part of this software may be reproduced,        */
+/*    stored in a retrieval system, or transmitted, in any form or by any     */
+/*    means, electronic, mechanical, photocopying, recording, or otherwise,   */
+/*    without prior written permission of the copyright owner.                */
+/*                                                                            */
+/******************************************************************************/
+/*
+ * Module: EduPbM_Merge.c
+ *
+ * Description :
+ *  Merge the partitions of a partitioned B+ tree step by step. A step moves
+ *  the smallest entries of the oldest partition but one into the oldest
+ *  partition: the entries are read in the order of their keys, inserted
+ *  into the oldest partition together by EduBtM_InsertBatch(), which
+ *  writes each leaf once for all its new entries, and then removed from
+ *  their partition by EduBtM_DeleteRange(). Each key is in exactly one
+ *  partition between the steps, so the scans and the updates may go on
+ *  while the partitions are merged. The newest partition is not merged
+ *  unless it has been sealed by EduPbM_NewPartition(); it takes the
+ *  insertions.
+ *
+ * Exports:
+ *  Four EduPbM_Merge(ObjectID*, PageID*, KeyDesc*, Four, Four*, Pool*, DeallocListElem*)
+ */
+
+
+#include <stdlib.h>
+#include "EduBtM_common.h"
+#include "EduPbM.h"
+#include "EduBtM.h"
+
+
+
+/*@================================
+ * EduPbM_Merge()
+ *================================*/
+/*
+ * Function: Four EduPbM_Merge(ObjectID*, PageID*, KeyDesc*, Four, Four*, Pool*, DeallocListElem*)
+ *
+ * Description:
+ *  Move at most 'maxEntries' entries of the partitions into the oldest
+ *  partition. See above for detail. The application calls this when the
+ *  system is idle, in place of a background merge; the partitions are
+ *  all merged when it moves fewer than 'maxEntries' entries.
+ *
+ * Returns:
+ *  error code
+ *    eBADPARAMETER_BTM
+ *    eMEMORYALLOCERR_BTM
+ *    some errors caused by function calls
+ *
+ * Side effects:
+ *  nMoved : # of the entries moved
+ */
+Four EduPbM_Merge(
+    ObjectID *catObjForFile,	/* IN catalog object of the index file */
+    PageID   *root,		/* IN root page of the partitioned B+ tree */
+    KeyDesc  *kdesc,		/* IN key descriptor */
+    Four     maxEntries,	/* IN maximum # of the entries to move */
+    Four     *nMoved,		/* OUT # of the entries moved */
+    Pool     *dlPool,		/* INOUT pool of dealloc list */
+    DeallocListElem *dlHead) /* INOUT head of the dealloc list */
+{
+    Four e;			/* error number */
+    Four n;			/* # of the entries of a step */
+    Four want;			/* # of the entries wanted by a step */
+    Four src;			/* the partition merged */
+    Four dst;			/* the oldest partition */
+    Two  nMergeable;		/* # of the partitions which may be merged */
+    KeyDesc pkdesc;		/* key descriptor of the B+ tree */
+    KeyValue first;		/* key of the first entry moved */
+    KeyValue last;		/* key of the last entry moved */
+    KeyValue stop;		/* the smallest key after the partition */
+    BtreeCursor cursor;		/* cursor on the partition merged */
+    BtreeCursor next;		/* the next cursor */
+    BtreeBatchItem *items;	/* the entries moved by a step */
+    PbmPartitions *parts;	/* the partitions of the index */
+
+
+    /*@ check parameters */
+    
+    if (catObjForFile == NULL || root == NULL || maxEntries < 0 || nMoved == NULL) ERR(eBADPARAMETER_BTM);
+
+    if (dlPool == NULL || dlHead == NULL) ERR(eBADPARAMETER_BTM);
+
+	e = edupbm_KeyDesc(kdesc, &pkdesc);
+	if (e < 0) ERR(e);
+
+	e = edupbm_GetPartitions(root, kdesc, &parts);
+	if (e < 0) ERR(e);
+
+	items = (BtreeBatchItem*)malloc(sizeof(BtreeBatchItem)*PBM_MERGEBATCH);
+	if (items == NULL) ERR(eMEMORYALLOCERR_BTM);
+
+	*nMoved = 0;
+	while (*nMoved < maxEntries)
+	{
+		nMergeable = parts->sealed ? parts->nPartitions : parts->nPartitions - 1;
+		if (nMergeable < 2) break;
+
+		dst = parts->partition[0];
+		src = parts->partition[1];
+
+		/* read the smallest entries of the partition */
+		e = edupbm_MakeKey(kdesc, src + 1, NULL, &stop);
+		if (e < 0) { free(items); ERR(e); }
+
+		e = edupbm_FetchPartition(root, kdesc, src, NULL, SM_BOF, NULL, SM_EOF, &cursor);
+		if (e < 0) { free(items); ERR(e); }
+
+		want = MIN(PBM_MERGEBATCH, maxEntries - *nMoved);
+		for (n = 0; n < want && cursor.flag == CURSOR_ON; n++)
+		{
+			if (n == 0) first = cursor.key;
+			last = cursor.key;
+
+			edupbm_UserKey(&cursor.key, &cursor.key);
+			e = edupbm_MakeKey(kdesc, dst, &cursor.key, &items[n].kval);
+			if (e < 0) { free(items); ERR(e); }
+			items[n].oid = cursor.oid;
+
+			e = EduBtM_FetchNext(root, &pkdesc, &stop, SM_LT, &cursor, &next);
+			if (e < 0) { free(items); ERR(e); }
+			cursor = next;
+		}
+
+		if (n > 0)
+		{
+			e = EduBtM_InsertBatch(catObjForFile, root, &pkdesc, items, n, dlPool, dlHead);
+			if (e < 0) { free(items); ERR(e); }
+
+			e = EduBtM_DeleteRange(catObjForFile, root, &pkdesc, &first, SM_GE, &last, SM_LE, dlPool, dlHead);
+			if (e < 0) { free(items); ERR(e); }
+
+			*nMoved += n;
+			if (parts->nPartitions == 2) parts->nNewest -= n;
+		}
+
+		if (cursor.flag != CURSOR_ON) edupbm_RemovePartition(parts, 1);
+	}
+
+	free(items);
+
+    return(eNOERROR);
+    
+}   /* EduPbM_Merge() */
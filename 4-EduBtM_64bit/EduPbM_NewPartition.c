@@ -0,0 +1,75 @@
+/******************************************************************************/
+/*                                                                            */
+/*    ODYSSEUS/EduCOSMOS Educational-Purpose Object Storage System            */
+/*                                                                            */
+/*    Developed by Professor Kyu-Young Whang et al.                           */
+/*                                                                            */
+/*    Database and Multimedia Laboratory                                      */
+/*                                                                            */
+/*    Computer Science Department and                                         */
+/*    Advanced Information Technology Research Center (AITrc)                 */
+/*    Korea Advanced Institute of Science and Technology (KAIST)              */
+/*                                                                            */
+/*    e-mail: kywhang@cs.kaist.ac.kr                                          */
+/*    phone: +82-42-350-7722                                                  */
+/*    fax: +82-42-350-8380                                                    */
+/*                                                                            */
+/*    Copyright (c) 1995-2013 by Kyu-Young Whang                              */
+/*                                                                            */
+/*    All rights reserved. No part of this software may be reproduced,        */
+/*    stored in a retrieval system, or transmitted, in any form or by any     */
+/*    means, electronic, mechanical, photocopying, recording, or otherwise,   */
+/*    without prior written permission of the copyright owner.                */
+/*                                                                            */
+/******************************************************************************/
+/*
+ * Module: EduPbM_NewPartition.c
+ *
+ * Description :
+ *  Seal the newest partition of a partitioned B+ tree.
+ *
+ * Exports:
+ *  Four EduPbM_NewPartition(PageID*, KeyDesc*)
+ */
+
+
+#include "EduBtM_common.h"
+#include "EduPbM.h"
+
+
+
+/*@================================
+ * EduPbM_NewPartition()
+ *================================*/
+/*
+ * Function: Four EduPbM_NewPartition(PageID*, KeyDesc*)
+ *
+ * Description:
+ *  Seal the newest partition: the next insertion starts a new partition,
+ *  and EduPbM_Merge() may merge the sealed one. Sealing an empty
+ *  partition has no effect. E.g., a bulk load seals the partition after
+ *  each batch so that the batches are merged while the next ones come.
+ *
+ * Returns:
+ *  error code
+ *    eBADPARAMETER_BTM
+ *    some errors caused by function calls
+ */
+Four EduPbM_NewPartition(
+    PageID   *root,		/* IN root page of the partitioned B+ tree */
+    KeyDesc  *kdesc)		/* IN key descriptor */
+{
+    Four e;			/* error number */
+    PbmPartitions *parts;	/* the partitions of the index */
+
+
+    if (root == NULL || kdesc == NULL) ERR(eBADPARAMETER_BTM);
+
+	e = edupbm_GetPartitions(root, kdesc, &parts);
+	if (e < 0) ERR(e);
+
+	if (parts->nPartitions > 0 && parts->nNewest > 0) parts->sealed = TRUE;
+
+    return(eNOERROR);
+    
+}   /* EduPbM_NewPartition() */
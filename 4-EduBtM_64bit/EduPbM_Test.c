@@ -0,0 +1,679 @@
+/******************************************************************************/
+/*                                                                            */
+/*    ODYSSEUS/EduCOSMOS Educational-Purpose Object Storage System            */
+/*                                                                            */
+/*    Developed by Professor Kyu-Young Whang et al.                           */
+/*                                                                            */
+/*    Database and Multimedia Laboratory                                      */
+/*                                                                            */
+/*    Computer Science Department and                                         */
+/*    Advanced Information Technology Research Center (AITrc)                 */
+/*    Korea Advanced Institute of Science and Technology (KAIST)              */
+/*                                                                            */
+/*    e-mail: kywhang@cs.kaist.ac.kr                                          */
+/*    phone: +82-42-350-7722                                                  */
+/*    fax: +82-42-350-8380                                                    */
+/*                                                                            */
+/*    Copyright (c) 1995-2013 by Kyu-Young Whang                              */
+/*                                                                            */
+/*    All rights reserved. No part of this software may be reproduced,        */
+/*    stored in a retrieval system, or transmitted, in any form or by any     */
+/*    means, electronic, mechanical, photocopying, recording, or otherwise,   */
+/*    without prior written permission of the copyright owner.                */
+/*                                                                            */
+/******************************************************************************/
+/*
+ * Module: EduPbM_Test.c
+ *
+ * Description :
+ *  Regression test of the partitioned B+ tree. An index of integer keys
+ *  goes through random mixed insertions and deletions, interleaved with
+ *  EduPbM_NewPartition() and with merge steps of random sizes, so the keys
+ *  are spread over many partitions which are merged while they are
+ *  updated. The results are kept in an array of the ObjectID of each key:
+ *   - an insertion of a key in the index returns eDUPLICATEDKEY_BTM, with
+ *     the same ObjectID or another one, since the index is unique,
+ *   - a deletion of a key not in the index or with another ObjectID
+ *     returns eNOTFOUND_BTM,
+ *   - a search for a random key returns the ObjectID of the array, and
+ *   - a scan from the first key to the last, and a scan of a random
+ *     range, return exactly the keys of the array in order, although
+ *     merge steps are taken in the middle of the scans.
+ *  Some checks forget the partitions kept in memory first, so they are
+ *  found again from the keys. At the end all the partitions are merged
+ *  into one. The test fails also if the index never had more than a few
+ *  partitions or the merges moved no entry.
+ *
+ *  Usage: EduPbM_Test
+ *
+ *  The exit status is 0 if all the checks pass.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "EduBtM_common.h"
+#include "EduBtM_basictypes.h"
+#include "BfM.h"
+#include "EduPbM.h"
+#include "EduBtM_TestModule.h"
+
+
+#define PTEST_VOLUME        "pbmtest.vol"
+#define PTEST_NUMPAGES      8000    /* # of pages of the volume */
+#define PTEST_NUMKEYS       20000   /* the keys are the numbers in [0, PTEST_NUMKEYS) */
+#define PTEST_ROUNDS        12      /* # of rounds of updates between full checks */
+#define PTEST_UPDATES       3000    /* # of random updates in a round */
+#define PTEST_SEARCHES      500     /* # of random searches in a round */
+#define PTEST_SEALRATE      400     /* one in PTEST_SEALRATE updates seals the newest partition */
+#define PTEST_MERGERATE     1500    /* one in PTEST_MERGERATE updates takes a merge step */
+#define PTEST_MERGESTEP     400     /* maximum # of the entries moved by a merge step */
+#define PTEST_SCANSTEP      2000    /* # of the entries of a scan between the merge steps */
+#define PTEST_MINPARTITIONS 4       /* the # of partitions should reach this */
+
+Four SM_CreateFile(Four, FileID*, Boolean, void*);
+Four sm_GetCatalogEntryFromDataFileId(Four, FileID*, ObjectID*);
+
+Four EduPbM_Test(Four, Four);
+Four ptest_Insert(ObjectID*, PageID*, KeyDesc*, Four, Four);
+Four ptest_Delete(ObjectID*, PageID*, KeyDesc*, Four, Four);
+Four ptest_Merge(ObjectID*, PageID*, KeyDesc*, Four);
+Four ptest_Search(PageID*, KeyDesc*, Four);
+Four ptest_Scan(ObjectID*, PageID*, KeyDesc*, Four, Four);
+Four ptest_Check(ObjectID*, PageID*, KeyDesc*, char*);
+void ptest_MakeKey(Four, KeyValue*);
+void ptest_MakeOid(ObjectID*, Four, ObjectID*);
+Four ptest_KeyNumber(KeyValue*);
+
+static Four ptest_oid[PTEST_NUMKEYS];       /* 'unique' of the ObjectID of each key; 0 if not in the index */
+static Four ptest_nextOid;                  /* 'unique' of the next ObjectID */
+static Four ptest_maxPartitions;            /* the most partitions of the index so far */
+static Four ptest_nMoved;                   /* # of the entries moved by the merges so far */
+static Four ptest_nErrors;                  /* # of violations found by the current check */
+
+
+
+/*@================================
+ * main()
+ *================================*/
+int main(int argc, char *argv[])
+{
+	Four	e;									/* for errors */
+	Four	handle;								/* system handle */
+	char 	*devNames[1];						/* device name */
+	Four 	volId = 1000;						/* volume identifier */
+	Four 	numPagesInDevices[1];				/* # of pages in the device */
+	XactID 	xactId;								/* transaction identifier */
+
+
+	devNames[0] = PTEST_VOLUME;
+	numPagesInDevices[0] = PTEST_NUMPAGES;
+
+	e = LRDS_Init();
+	if (e < eNOERROR) { printf("LRDS_Init failed!!!\n"); exit(1); }
+
+	e = LRDS_AllocHandle(&handle);
+	if (e < eNOERROR) { printf("LRDS_AllocHandle failed!!!\n"); LRDS_Final(); exit(1); }
+
+	e = LRDS_FormatDataVolume(1, devNames, "pbmtest", volId, 16, numPagesInDevices, 16);
+	if (e < eNOERROR) { printf("LRDS_FormatDataVolume failed!!!\n"); LRDS_FreeHandle(handle); LRDS_Final(); exit(1); }
+
+	e = LRDS_Mount(1, devNames, &volId);
+	if (e < eNOERROR) { printf("LRDS_Mount failed!!!\n"); LRDS_FreeHandle(handle); LRDS_Final(); exit(1); }
+
+	e = LRDS_BeginTransaction(&xactId, X_RR_RR);
+	if (e < eNOERROR) { LRDS_Dismount(volId); LRDS_FreeHandle(handle); LRDS_Final(); exit(1); }
+
+	e = EduPbM_Test(volId, handle);
+	if (e < eNOERROR) {
+		printf("EduPbM_Test failed!!!\n");
+		LRDS_AbortTransaction(&xactId);
+		LRDS_Dismount(volId);
+		LRDS_FreeHandle(handle);
+		LRDS_Final();
+		exit(1);
+	}
+
+	e = LRDS_CommitTransaction(&xactId);
+	if (e < eNOERROR) printf("LRDS_CommitTransaction failed!!!\n");
+
+	LRDS_Dismount(volId);
+	LRDS_FreeHandle(handle);
+	LRDS_Final();
+
+	return 0;
+}
+
+
+
+/*@================================
+ * EduPbM_Test()
+ *================================*/
+/*
+ * Function: Four EduPbM_Test(Four, Four)
+ *
+ * Description:
+ *  Run the test described above on a partitioned B+ tree.
+ *
+ * Returns:
+ *  error code
+ *    eBADBTREEPAGE_BTM if a check fails
+ *    some errors caused by function calls
+ */
+Four EduPbM_Test(
+    Four        volId,                  /* IN volume identifier */
+    Four        handle)                 /* IN system handle */
+{
+    Four        e;                      /* error number */
+    Four        i, j;                   /* indexes */
+    Four        v;                      /* number of a key */
+    Four        n;                      /* # of the entries moved by a merge */
+    FileID      fid;                    /* file identifier */
+    ObjectID    catalogEntry;           /* catalog object */
+    PageID      root;                   /* root page of the index */
+    PhysicalFileID pFid;                /* file of the index */
+    KeyDesc     kdesc;                  /* key descriptor */
+    char        step[64];               /* name of a step */
+
+
+	e = SM_CreateFile(volId, &fid, FALSE, NULL);
+	if (e < eNOERROR) ERR(e);
+
+	e = sm_GetCatalogEntryFromDataFileId(ARRAYINDEX, &fid, &catalogEntry);
+	if (e < eNOERROR) ERR(e);
+
+	kdesc.flag = KEYFLAG_UNIQUE;
+	kdesc.nparts = 1;
+	kdesc.kpart[0].type = SM_INT;
+	kdesc.kpart[0].offset = 0;
+	kdesc.kpart[0].length = sizeof(Four_Invariable);
+
+	e = EduPbM_CreateIndex(&catalogEntry, &root);
+	if (e < eNOERROR) ERR(e);
+
+	srand(41);
+	memset(ptest_oid, 0, sizeof(ptest_oid));
+	ptest_nextOid = 1;
+	ptest_maxPartitions = 0;
+	ptest_nMoved = 0;
+
+	for (i = 0; i < PTEST_ROUNDS; i++)
+	{
+		for (j = 0; j < PTEST_UPDATES; j++)
+		{
+			v = rand() % PTEST_NUMKEYS;
+
+			// Insertions win in the first half of the rounds, deletions in the second.
+			if (rand() % 100 < ((i < PTEST_ROUNDS/2) ? 70 : 30))
+			{
+				if (ptest_oid[v] != 0 && rand() % 2 == 0)
+					e = ptest_Insert(&catalogEntry, &root, &kdesc, v, ptest_oid[v]);
+				else
+					e = ptest_Insert(&catalogEntry, &root, &kdesc, v, ptest_nextOid++);
+			}
+			else if (ptest_oid[v] != 0 && rand() % 4 != 0)
+				e = ptest_Delete(&catalogEntry, &root, &kdesc, v, ptest_oid[v]);
+			else
+				e = ptest_Delete(&catalogEntry, &root, &kdesc, v, ptest_nextOid++);
+			if (e < eNOERROR) ERR(e);
+
+			if (rand() % PTEST_SEALRATE == 0)
+			{
+				e = EduPbM_NewPartition(&root, &kdesc);
+				if (e < eNOERROR) ERR(e);
+			}
+
+			if (rand() % PTEST_MERGERATE == 0)
+			{
+				e = ptest_Merge(&catalogEntry, &root, &kdesc, rand() % PTEST_MERGESTEP);
+				if (e < eNOERROR) ERR(e);
+			}
+		}
+
+		// Every third check finds the partitions from the keys.
+		if (i % 3 == 2) edupbm_DiscardPartitions(&root);
+
+		sprintf(step, "round %ld", (long)i);
+		e = ptest_Check(&catalogEntry, &root, &kdesc, step);
+		if (e < eNOERROR) ERR(e);
+	}
+
+	if (ptest_maxPartitions < PTEST_MINPARTITIONS || ptest_nMoved == 0)
+	{
+		printf("  the index had at most %ld partitions and the merges moved %ld entries\n",
+		       (long)ptest_maxPartitions, (long)ptest_nMoved);
+		ERR(eBADBTREEPAGE_BTM);
+	}
+
+	/* Merge all the partitions. */
+	e = EduPbM_NewPartition(&root, &kdesc);
+	if (e < eNOERROR) ERR(e);
+
+	do {
+		e = EduPbM_Merge(&catalogEntry, &root, &kdesc, PTEST_MERGESTEP, &n, &dlPool, &dlHead);
+		if (e < eNOERROR) ERR(e);
+	} while (n == PTEST_MERGESTEP);
+
+	e = ptest_Check(&catalogEntry, &root, &kdesc, "merged");
+	if (e < eNOERROR) ERR(e);
+
+	edupbm_DiscardPartitions(&root);
+
+	e = ptest_Check(&catalogEntry, &root, &kdesc, "merged and found again");
+	if (e < eNOERROR) ERR(e);
+
+	MAKE_PAGEID(pFid, catalogEntry.volNo, catalogEntry.pageNo);
+	e = EduPbM_DropIndex(&pFid, &root, &dlPool, &dlHead);
+	if (e < eNOERROR) ERR(e);
+
+	printf("all checks passed\n");
+
+	return(eNOERROR);
+
+} /* EduPbM_Test() */
+
+
+
+/*@================================
+ * ptest_Insert()
+ *================================*/
+/*
+ * Function: Four ptest_Insert(ObjectID*, PageID*, KeyDesc*, Four, Four)
+ *
+ * Description:
+ *  Insert the pair of the given key and ObjectID and update the array. An
+ *  insertion of a key in the array should return eDUPLICATEDKEY_BTM, even
+ *  if the ObjectID is the one in the array, since the index is unique.
+ *
+ * Returns:
+ *  error code
+ *    eBADBTREEPAGE_BTM if the result does not match the array
+ *    some errors caused by function calls
+ */
+Four ptest_Insert(
+    ObjectID        *catObjForFile,     /* IN catalog object of the index file */
+    PageID          *root,              /* IN root page of the index */
+    KeyDesc         *kdesc,             /* IN key descriptor */
+    Four            v,                  /* IN number of the key */
+    Four            unique)             /* IN 'unique' of the ObjectID */
+{
+    Four            e;                  /* error number */
+    Four            expected;           /* the error expected */
+    KeyValue        kval;               /* key value */
+    ObjectID        oid;                /* ObjectID of the key */
+
+
+	ptest_MakeKey(v, &kval);
+	ptest_MakeOid(catObjForFile, unique, &oid);
+
+	expected = (ptest_oid[v] == 0) ? eNOERROR : eDUPLICATEDKEY_BTM;
+
+	e = EduPbM_InsertObject(catObjForFile, root, kdesc, &kval, &oid, &dlPool, &dlHead);
+	if (e != expected)
+	{
+		if (e < eNOERROR && e != eDUPLICATEDKEY_BTM && e != eDUPLICATEDOBJECTID_BTM) ERR(e);
+
+		printf("  the insertion of the key %ld returns %ld instead of %ld\n", (long)v, (long)e, (long)expected);
+		ERR(eBADBTREEPAGE_BTM);
+	}
+
+	if (e == eNOERROR) ptest_oid[v] = unique;
+
+	return(eNOERROR);
+
+} /* ptest_Insert() */
+
+
+
+/*@================================
+ * ptest_Delete()
+ *================================*/
+/*
+ * Function: Four ptest_Delete(ObjectID*, PageID*, KeyDesc*, Four, Four)
+ *
+ * Description:
+ *  Delete the pair of the given key and ObjectID and update the array. A
+ *  deletion of a pair not in the array should return eNOTFOUND_BTM.
+ *
+ * Returns:
+ *  error code
+ *    eBADBTREEPAGE_BTM if the result does not match the array
+ *    some errors caused by function calls
+ */
+Four ptest_Delete(
+    ObjectID        *catObjForFile,     /* IN catalog object of the index file */
+    PageID          *root,              /* IN root page of the index */
+    KeyDesc         *kdesc,             /* IN key descriptor */
+    Four            v,                  /* IN number of the key */
+    Four            unique)             /* IN 'unique' of the ObjectID */
+{
+    Four            e;                  /* error number */
+    Four            expected;           /* the error expected */
+    KeyValue        kval;               /* key value */
+    ObjectID        oid;                /* ObjectID of the key */
+
+
+	ptest_MakeKey(v, &kval);
+	ptest_MakeOid(catObjForFile, unique, &oid);
+
+	expected = (ptest_oid[v] == unique) ? eNOERROR : eNOTFOUND_BTM;
+
+	e = EduPbM_DeleteObject(catObjForFile, root, kdesc, &kval, &oid, &dlPool, &dlHead);
+	if (e != expected)
+	{
+		if (e < eNOERROR && e != eNOTFOUND_BTM) ERR(e);
+
+		printf("  the deletion of the key %ld returns %ld instead of %ld\n", (long)v, (long)e, (long)expected);
+		ERR(eBADBTREEPAGE_BTM);
+	}
+
+	if (e == eNOERROR) ptest_oid[v] = 0;
+
+	return(eNOERROR);
+
+} /* ptest_Delete() */
+
+
+
+/*@================================
+ * ptest_Merge()
+ *================================*/
+/*
+ * Function: Four ptest_Merge(ObjectID*, PageID*, KeyDesc*, Four)
+ *
+ * Description:
+ *  Take a merge step of at most 'maxEntries' entries and count the
+ *  entries moved.
+ *
+ * Returns:
+ *  error code
+ *    some errors caused by function calls
+ */
+Four ptest_Merge(
+    ObjectID        *catObjForFile,     /* IN catalog object of the index file */
+    PageID          *root,              /* IN root page of the index */
+    KeyDesc         *kdesc,             /* IN key descriptor */
+    Four            maxEntries)         /* IN maximum # of the entries to move */
+{
+    Four            e;                  /* error number */
+    Four            n;                  /* # of the entries moved */
+
+
+	e = EduPbM_Merge(catObjForFile, root, kdesc, maxEntries, &n, &dlPool, &dlHead);
+	if (e < eNOERROR) ERR(e);
+
+	ptest_nMoved += n;
+
+	return(eNOERROR);
+
+} /* ptest_Merge() */
+
+
+
+/*@================================
+ * ptest_Search()
+ *================================*/
+/*
+ * Function: Four ptest_Search(PageID*, KeyDesc*, Four)
+ *
+ * Description:
+ *  Search for the given key and compare the result with the array. The
+ *  violations are printed and counted.
+ *
+ * Returns:
+ *  error code
+ *    some errors caused by function calls
+ */
+Four ptest_Search(
+    PageID          *root,              /* IN root page of the index */
+    KeyDesc         *kdesc,             /* IN key descriptor */
+    Four            v)                  /* IN number of the key */
+{
+    Four            e;                  /* error number */
+    KeyValue        kval;               /* key value */
+    BtreeCursor     cursor;             /* cursor of the search */
+
+
+	ptest_MakeKey(v, &kval);
+
+	e = EduPbM_Fetch(root, kdesc, &kval, SM_EQ, &kval, SM_EQ, &cursor);
+	if (e < eNOERROR) ERR(e);
+
+	if (cursor.flag != CURSOR_ON && ptest_oid[v] != 0)
+	{
+		printf("  the search misses the key %ld\n", (long)v);
+		ptest_nErrors++;
+	}
+	else if (cursor.flag == CURSOR_ON && cursor.oid.unique != ptest_oid[v])
+	{
+		printf("  the search for the key %ld returns the ObjectID %ld instead of %ld\n",
+		       (long)v, (long)cursor.oid.unique, (long)ptest_oid[v]);
+		ptest_nErrors++;
+	}
+
+	return(eNOERROR);
+
+} /* ptest_Search() */
+
+
+
+/*@================================
+ * ptest_Scan()
+ *================================*/
+/*
+ * Function: Four ptest_Scan(ObjectID*, PageID*, KeyDesc*, Four, Four)
+ *
+ * Description:
+ *  Scan the keys in [lo, hi] and compare them with the array; a 'lo' of -1
+ *  is the beginning and a 'hi' of PTEST_NUMKEYS is the end of the index.
+ *  A merge step is taken after every PTEST_SCANSTEP entries of the scan.
+ *  The violations are printed and counted.
+ *
+ * Returns:
+ *  error code
+ *    some errors caused by function calls
+ */
+Four ptest_Scan(
+    ObjectID        *catObjForFile,     /* IN catalog object of the index file */
+    PageID          *root,              /* IN root page of the index */
+    KeyDesc         *kdesc,             /* IN key descriptor */
+    Four            lo,                 /* IN the lower bound */
+    Four            hi)                 /* IN the upper bound */
+{
+    Four            e;                  /* error number */
+    Four            v;                  /* number of a key */
+    Four            expected;           /* number of the next key of the array in the range */
+    Four            n;                  /* # of keys returned by the scan */
+    Four            loOp, hiOp;         /* comparison operators of the bounds */
+    KeyValue        loKval, hiKval;     /* key values of the bounds */
+    BtreeCursor     cursor;             /* cursor of the scan */
+    BtreeCursor     next;               /* the next cursor of the scan */
+
+
+	loOp = (lo < 0) ? SM_BOF : SM_GE;
+	hiOp = (hi >= PTEST_NUMKEYS) ? SM_EOF : SM_LE;
+	ptest_MakeKey(lo, &loKval);
+	ptest_MakeKey(hi, &hiKval);
+
+	e = EduPbM_Fetch(root, kdesc, &loKval, loOp, &hiKval, hiOp, &cursor);
+	if (e < eNOERROR) ERR(e);
+
+	n = 0;
+	for (expected = (lo < 0) ? 0 : lo; ; expected++)
+	{
+		while (expected < PTEST_NUMKEYS && expected <= hi && ptest_oid[expected] == 0) expected++;
+		if (expected >= PTEST_NUMKEYS || expected > hi) expected = -1;
+
+		if (cursor.flag != CURSOR_ON) break;
+
+		v = ptest_KeyNumber(&cursor.key);
+		if (v != expected || cursor.oid.unique != ptest_oid[v])
+		{
+			printf("  the scan of [%ld, %ld] returns the key %ld with the ObjectID %ld instead of the key %ld\n",
+			       (long)lo, (long)hi, (long)v, (long)cursor.oid.unique, (long)expected);
+			ptest_nErrors++;
+			return(eNOERROR);
+		}
+
+		if (++n % PTEST_SCANSTEP == 0)
+		{
+			e = ptest_Merge(catObjForFile, root, kdesc, rand() % PTEST_MERGESTEP);
+			if (e < eNOERROR) ERR(e);
+		}
+
+		e = EduPbM_FetchNext(root, kdesc, &hiKval, hiOp, &cursor, &next);
+		if (e < eNOERROR) ERR(e);
+		cursor = next;
+	}
+
+	if (expected >= 0)
+	{
+		printf("  the scan of [%ld, %ld] misses the key %ld\n", (long)lo, (long)hi, (long)expected);
+		ptest_nErrors++;
+	}
+
+	return(eNOERROR);
+
+} /* ptest_Scan() */
+
+
+
+/*@================================
+ * ptest_Check()
+ *================================*/
+/*
+ * Function: Four ptest_Check(ObjectID*, PageID*, KeyDesc*, char*)
+ *
+ * Description:
+ *  Check the index against the array by random searches, a full scan and
+ *  a scan of a random range. The violations are printed.
+ *
+ * Returns:
+ *  error code
+ *    eBADBTREEPAGE_BTM if the check fails
+ *    some errors caused by function calls
+ */
+Four ptest_Check(
+    ObjectID        *catObjForFile,     /* IN catalog object of the index file */
+    PageID          *root,              /* IN root page of the index */
+    KeyDesc         *kdesc,             /* IN key descriptor */
+    char            *name)              /* IN name of the step */
+{
+    Four            e;                  /* error number */
+    Four            i;                  /* index */
+    Four            lo;                 /* lower bound of the range */
+    Four            nAlive;             /* # of keys of the array */
+    PbmPartitions   *parts;             /* the partitions of the index */
+
+
+	ptest_nErrors = 0;
+
+	for (i = 0; i < PTEST_SEARCHES; i++)
+	{
+		e = ptest_Search(root, kdesc, rand() % PTEST_NUMKEYS);
+		if (e < eNOERROR) ERR(e);
+	}
+
+	e = ptest_Scan(catObjForFile, root, kdesc, -1, PTEST_NUMKEYS);
+	if (e < eNOERROR) ERR(e);
+
+	lo = rand() % PTEST_NUMKEYS;
+	e = ptest_Scan(catObjForFile, root, kdesc, lo, lo + rand() % (PTEST_NUMKEYS / 4));
+	if (e < eNOERROR) ERR(e);
+
+	nAlive = 0;
+	for (i = 0; i < PTEST_NUMKEYS; i++)
+		if (ptest_oid[i] != 0) nAlive++;
+
+	e = edupbm_GetPartitions(root, kdesc, &parts);
+	if (e < eNOERROR) ERR(e);
+
+	if (parts->nPartitions > ptest_maxPartitions) ptest_maxPartitions = parts->nPartitions;
+
+	printf("%-24s %6ld keys %2ld partitions %s\n", name, (long)nAlive, (long)parts->nPartitions,
+	       (ptest_nErrors == 0) ? "ok" : "FAILED");
+
+	if (ptest_nErrors > 0) ERR(eBADBTREEPAGE_BTM);
+
+	return(eNOERROR);
+
+} /* ptest_Check() */
+
+
+
+/*@================================
+ * ptest_MakeKey()
+ *================================*/
+/*
+ * Function: void ptest_MakeKey(Four, KeyValue*)
+ *
+ * Description:
+ *  Make the integer key value of the given number.
+ *
+ * Returns:
+ *  None
+ */
+void ptest_MakeKey(
+    Four            v,                  /* IN number of the key */
+    KeyValue        *kval)              /* OUT key value */
+{
+    Four_Invariable k;                  /* the key as an integer */
+
+
+	k = v;
+	memcpy(kval->val, &k, sizeof(Four_Invariable));
+	kval->len = sizeof(Four_Invariable);
+
+} /* ptest_MakeKey() */
+
+
+
+/*@================================
+ * ptest_MakeOid()
+ *================================*/
+/*
+ * Function: void ptest_MakeOid(ObjectID*, Four, ObjectID*)
+ *
+ * Description:
+ *  Make the ObjectID of the given 'unique'. It is put into 'pageNo' too,
+ *  since ObjectIDs are told apart without 'unique' when they are compared.
+ *
+ * Returns:
+ *  None
+ */
+void ptest_MakeOid(
+    ObjectID        *catObjForFile,     /* IN catalog object of the index file */
+    Four            unique,             /* IN 'unique' of the ObjectID */
+    ObjectID        *oid)               /* OUT ObjectID */
+{
+	oid->volNo = catObjForFile->volNo;
+	oid->pageNo = unique;
+	oid->slotNo = 0;
+	oid->unique = unique;
+
+} /* ptest_MakeOid() */
+
+
+
+/*@================================
+ * ptest_KeyNumber()
+ *================================*/
+/*
+ * Function: Four ptest_KeyNumber(KeyValue*)
+ *
+ * Description:
+ *  Return the number of a key made by ptest_MakeKey().
+ *
+ * Returns:
+ *  number of the key
+ */
+Four ptest_KeyNumber(
+    KeyValue        *kval)              /* IN key value */
+{
+    Four_Invariable k;                  /* the key as an integer */
+
+
+	memcpy(&k, kval->val, sizeof(Four_Invariable));
+
+	return(k);
+
+} /* ptest_KeyNumber() */
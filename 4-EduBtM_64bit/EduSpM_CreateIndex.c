@@ -0,0 +1,76 @@
+/******************************************************************************/
+/*                                                                            */
+/*    ODYSSEUS/EduCOSMOS Educational-Purpose Object Storage System            */
+/*                                                                            */
+/*    Developed by Professor Kyu-Young Whang et al.                           */
+/*                                                                            */
+/*    Database and Multimedia Laboratory                                      */
+/*                                                                            */
+/*    Computer Science Department and                                         */
+/*    Advanced Information Technology Research Center (AITrc)                 */
+/*    Korea Advanced Institute of Science and Technology (KAIST)              */
+/*                                                                            */
+/*    e-mail: kywhang@cs.kaist.ac.kr                                          */
+/*    phone: +82-42-350-7722                                                  */
+/*    fax: +82-42-350-8380                                                    */
+/*                                                                            */
+/*    Copyright (c) 1995-2013 by Kyu-Young Whang                              */
+/*                                                                            */
+/*    All rights reserved. No part of this software may be reproduced,        */
+/*    stored in a retrieval system, or transmitted, in any form or by any     */
+/*    means, electronic, mechanical, photocopying, recording, or otherwise,   */
+/*    without prior written permission of the copyright owner.                */
+/*                                                                            */
+/******************************************************************************/
+/* 
+ * Module :	EduSpM_CreateIndex.c
+ *
+ * Description : 
+ *  Create the new spatial index. 
+ *
+ * Exports:
+ *  Four EduSpM_CreateIndex(ObjectID*, PageID*)
+ */
+
+
+#include "EduBtM_common.h"
+#include "EduSpM.h"
+#include "EduBtM.h"
+
+
+
+/*@================================
+ * EduSpM_CreateIndex()
+ *================================*/
+/* 
+ * Function: Four  EduSpM_CreateIndex(ObjectID*, PageID*)
+ *
+ * Description : 
+ *  Create the new spatial index. 
+ *  A spatial index is a B+ tree index keyed by the codes of the points on
+ *  a space filling curve, so the root page of a new B+ tree is allocated.
+ *  The space is described by the SpatialDesc given to the other calls.
+ *
+ * Returns :
+ *  error code
+ *    eBADPARAMETER_BTM
+ *    some errors caused by function calls
+ *
+ * Side effects:
+ *  The parameter rootPid is filled with the new root page's PageID. 
+ */
+Four EduSpM_CreateIndex(
+    ObjectID *catObjForFile,	/* IN catalog object of the index file */
+    PageID *rootPid)		/* OUT root page of the newly created spatial index */
+{
+    Four e;			/* error number */
+
+
+    if (catObjForFile == NULL || rootPid == NULL) ERR(eBADPARAMETER_BTM);
+
+	e = EduBtM_CreateIndex(catObjForFile, rootPid);
+	if (e < 0) ERR(e);
+
+    return(eNOERROR);
+    
+} /* EduSpM_CreateIndex() */
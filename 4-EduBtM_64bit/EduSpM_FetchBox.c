@@ -0,0 +1,113 @@
+/******************************************************************************/
+/*                                                                            */
+/*    ODYSSEUS/EduCOSMOS Educational-Purpose Object Storage System            */
+/*                                                                            */
+/*    Developed by Professor Kyu-Young Whang et al.                           */
+/*                                                                            */
+/*    Database and Multimedia Laboratory                                      */
+/*                                                                            */
+/*    Computer Science Department and                                         */
+/*    Advanced Information Technology Research Center (AITrc)                 */
+/*    Korea Advanced Institute of Science and Technology (KAIST)              */
+/*                                                                            */
+/*    e-mail: kywhang@cs.kaist.ac.kr                                          */
+/*    phone: +82-42-350-7722                                                  */
+/*    fax: +82-42-350-8380                                                    */
+/*                                                                            */
+/*    Copyright (c) 1995-2013 by Kyu-Young Whang                              */
+/*                                                                            */
+/*    All rights reserved. No part of this software may be reproduced,        */
+/*    stored in a retrieval system, or transmitted, in any form or by any     */
+/*    means, electronic, mechanical, photocopying, recording, or otherwise,   */
+/*    without prior written permission of the copyright owner.                */
+/*                                                                            */
+/******************************************************************************/
+/*
+ * Module: EduSpM_FetchBox.c
+ *
+ * Description :
+ *  Find the points of a spatial index in a box. The box is decomposed into
+ *  ranges of the codes on the first call, and the points are returned in
+ *  the order of their codes, 'maxItems' points per call.
+ *
+ * Exports:
+ *  Four EduSpM_FetchBox(PageID*, SpatialDesc*, UFour*, UFour*, SpatialCursor*, SpatialItem*, Four, Four*)
+ */
+
+
+#include "EduBtM_common.h"
+#include "EduSpM.h"
+
+
+
+/*@================================
+ * EduSpM_FetchBox()
+ *================================*/
+/*
+ * Function: Four EduSpM_FetchBox(PageID*, SpatialDesc*, UFour*, UFour*, SpatialCursor*, SpatialItem*, Four, Four*)
+ *
+ * Description:
+ *  Find the next points in the box ['lo', 'hi'], both corners included.
+ *  The cursor should be CURSOR_INVALID on the first call; the following
+ *  calls with the same box go on where the previous one stopped, until
+ *  the cursor becomes CURSOR_EOS. See above for detail.
+ *
+ * Returns:
+ *  error code
+ *    eBADPARAMETER_BTM
+ *    some errors caused by function calls
+ *
+ * Side effects:
+ *  items  : the points found, without their distance
+ *  nItems : # of the points found; less than 'maxItems' only at the end
+ *  cursor : CURSOR_EOS when all the points in the box have been returned
+ */
+Four EduSpM_FetchBox(
+    PageID   *root,		/* IN root page of the spatial index */
+    SpatialDesc *sdesc,		/* IN descriptor of the space */
+    UFour    *lo,		/* IN the lowest corner of the box */
+    UFour    *hi,		/* IN the highest corner of the box */
+    SpatialCursor *cursor,	/* INOUT the scan of the box */
+    SpatialItem *items,		/* OUT the points found */
+    Four     maxItems,		/* IN size of 'items' */
+    Four     *nItems)		/* OUT # of the points found */
+{
+    Four e;			/* error number */
+    Two  i;			/* index of a dimension */
+
+
+    if (root == NULL || lo == NULL || hi == NULL || cursor == NULL) ERR(eBADPARAMETER_BTM);
+
+    if (items == NULL || maxItems <= 0 || nItems == NULL) ERR(eBADPARAMETER_BTM);
+
+	e = eduspm_CheckDesc(sdesc);
+	if (e < 0) ERR(e);
+
+	if (!eduspm_ValidPoint(sdesc, lo) || !eduspm_ValidPoint(sdesc, hi)) ERR(eBADPARAMETER_BTM);
+
+	*nItems = 0;
+
+	if (cursor->flag == CURSOR_INVALID)
+	{
+		/* an empty box has no range */
+		for (i = 0; i < sdesc->nDims; i++)
+			if (lo[i] > hi[i]) break;
+
+		if (i < sdesc->nDims)
+			cursor->nRanges = 0;
+		else
+			eduspm_BoxRanges(sdesc, lo, hi, cursor->ranges, &cursor->nRanges);
+
+		cursor->range = 0;
+		cursor->btree.flag = CURSOR_INVALID;
+		cursor->flag = CURSOR_ON;
+	}
+
+	if (cursor->flag == CURSOR_EOS) return(eNOERROR);
+
+	e = eduspm_FetchBox(root, sdesc, lo, hi, cursor, items, maxItems, nItems);
+	if (e < 0) ERR(e);
+
+    return(eNOERROR);
+
+} /* EduSpM_FetchBox() */
@@ -0,0 +1,237 @@
+/******************************************************************************/
+/*                                                                            */
+/*    ODYSSEUS/EduCOSMOS Educational-Purpose Object Storage System            */
+/*                                                                            */
+/*    Developed by Professor Kyu-Young Whang et al.                           */
+/*                                                                            */
+/*    Database and Multimedia Laboratory                                      */
+/*                                                                            */
+/*    Computer Science Department and                                         */
+/*    Advanced Information Technology Research Center (AITrc)                 */
+/*    Korea Advanced Institute of Science and Technology (KAIST)              */
+/*                                                                            */
+/*    e-mail: kywhang@cs.kaist.ac.kr                                          */
+/*    phone: +82-42-350-7722                                                  */
+/*    fax: +82-42-350-8380                                                    */
+/*                                                                            */
+/*    Copyright (c) 1995-2013 by Kyu-Young Whang                              */
+/*                                                                            */
+/*    All rights reserved. No part of this software may be reproduced,        */
+/*    stored in a retrieval system, or transmitted, in any form or by any     */
+/*    means, electronic, mechanical, photocopying, recording, or otherwise,   */
+/*    without prior written permission of the copyright owner.                */
+/*                                                                            */
+/******************************************************************************/
+/*
+ * Module: EduSpM_FetchNearest.c
+ *
+ * Description :
+ *  Find the k nearest points of a spatial index to a query point by the
+ *  Euclidean distance. The points are searched in a box around the query
+ *  point, whose half side starts at 1 and doubles until k points are
+ *  found. The k-th distance found then bounds the answer; if the box does
+ *  not hold the ball of that radius, the box is grown to hold it and
+ *  searched once more.
+ *
+ * Exports:
+ *  Four EduSpM_FetchNearest(PageID*, SpatialDesc*, UFour*, Four, SpatialItem*, Four*)
+ *  void eduspm_PushNearest(SpatialItem*, Four*, Four, SpatialItem*)
+ *  void eduspm_SiftNearest(SpatialItem*, Four, Four)
+ */
+
+
+#include <math.h>
+#include "EduBtM_common.h"
+#include "EduSpM.h"
+
+
+
+/*@================================
+ * EduSpM_FetchNearest()
+ *================================*/
+/*
+ * Function: Four EduSpM_FetchNearest(PageID*, SpatialDesc*, UFour*, Four, SpatialItem*, Four*)
+ *
+ * Description:
+ *  Find the 'k' nearest points to 'point'; fewer if the index has fewer
+ *  points. See above for detail. Among the points at the same distance
+ *  as the k-th one, any may be returned.
+ *
+ * Returns:
+ *  error code
+ *    eBADPARAMETER_BTM
+ *    some errors caused by function calls
+ *
+ * Side effects:
+ *  items  : the points found, nearest first, with their squared distance
+ *  nItems : # of the points found
+ */
+Four EduSpM_FetchNearest(
+    PageID   *root,		/* IN root page of the spatial index */
+    SpatialDesc *sdesc,		/* IN descriptor of the space */
+    UFour    *point,		/* IN the query point */
+    Four     k,			/* IN # of the points to find */
+    SpatialItem *items,		/* OUT the points found; 'k' items */
+    Four     *nItems)		/* OUT # of the points found */
+{
+    Four e;			/* error number */
+    Four j;			/* index of an item */
+    Four nBatch;		/* # of the candidates read at once */
+    Two  i;			/* index of a dimension */
+    UEight r;			/* half side of the box */
+    UEight maxCoord;		/* the largest coordinate */
+    UFour lo[SPM_MAXDIMS];	/* the lowest corner of the box */
+    UFour hi[SPM_MAXDIMS];	/* the highest corner of the box */
+    Boolean whole;		/* TRUE if the box is the whole space */
+    double d;			/* distance along a dimension */
+    SpatialCursor cursor;	/* the scan of the box */
+    SpatialItem batch[SPM_NEARESTBATCH]; /* the candidates */
+    SpatialItem t;		/* for swapping */
+
+
+    if (root == NULL || point == NULL || k <= 0 || items == NULL || nItems == NULL) ERR(eBADPARAMETER_BTM);
+
+	e = eduspm_CheckDesc(sdesc);
+	if (e < 0) ERR(e);
+
+	if (!eduspm_ValidPoint(sdesc, point)) ERR(eBADPARAMETER_BTM);
+
+	maxCoord = ((UEight)1 << sdesc->nBits) - 1;
+
+	for (r = 1; ; )
+	{
+		whole = TRUE;
+		for (i = 0; i < sdesc->nDims; i++)
+		{
+			lo[i] = (point[i] > r) ? point[i] - r : 0;
+			hi[i] = (point[i] + r < maxCoord) ? point[i] + r : maxCoord;
+			if (lo[i] != 0 || hi[i] != maxCoord) whole = FALSE;
+		}
+
+		/* keep the k nearest candidates in a max-heap on the distance */
+		eduspm_BoxRanges(sdesc, lo, hi, cursor.ranges, &cursor.nRanges);
+		cursor.range = 0;
+		cursor.btree.flag = CURSOR_INVALID;
+		cursor.flag = CURSOR_ON;
+
+		*nItems = 0;
+		while (cursor.flag != CURSOR_EOS)
+		{
+			e = eduspm_FetchBox(root, sdesc, lo, hi, &cursor, batch, SPM_NEARESTBATCH, &nBatch);
+			if (e < 0) ERR(e);
+
+			for (j = 0; j < nBatch; j++)
+			{
+				batch[j].dist2 = 0;
+				for (i = 0; i < sdesc->nDims; i++)
+				{
+					d = (double)batch[j].point[i] - (double)point[i];
+					batch[j].dist2 += d * d;
+				}
+
+				eduspm_PushNearest(items, nItems, k, &batch[j]);
+			}
+		}
+
+		if (whole) break;
+
+		if (*nItems == k)
+		{
+			/* done if the box holds the ball through the k-th point */
+			if (items[0].dist2 <= (double)r * (double)r) break;
+
+			for (r = (UEight)sqrt(items[0].dist2); (double)r * (double)r < items[0].dist2; r++);
+		}
+		else
+			r *= 2;
+	}
+
+	/* sort the heap, nearest first */
+	for (j = *nItems - 1; j > 0; j--)
+	{
+		t = items[0];
+		items[0] = items[j];
+		items[j] = t;
+		eduspm_SiftNearest(items, j, 0);
+	}
+
+    return(eNOERROR);
+
+} /* EduSpM_FetchNearest() */
+
+
+
+/*@================================
+ * eduspm_PushNearest()
+ *================================*/
+/*
+ * Function: void eduspm_PushNearest(SpatialItem*, Four*, Four, SpatialItem*)
+ *
+ * Description:
+ *  Offer a candidate to the max-heap of the 'k' nearest points. When the
+ *  heap is full, the candidate replaces the farthest point if it is nearer.
+ *
+ * Returns:
+ *  None
+ */
+void eduspm_PushNearest(
+    SpatialItem         *heap,          /* INOUT the max-heap on the distance */
+    Four                *n,             /* INOUT # of the items in the heap */
+    Four                k,              /* IN size of the heap */
+    SpatialItem         *item)          /* IN the candidate */
+{
+    Four                j;              /* position of the candidate */
+    Four                parent;         /* position of the parent */
+
+
+	if (*n < k)
+	{
+		for (j = (*n)++; j > 0; j = parent)
+		{
+			parent = (j - 1) / 2;
+			if (heap[parent].dist2 >= item->dist2) break;
+			heap[j] = heap[parent];
+		}
+		heap[j] = *item;
+	}
+	else if (item->dist2 < heap[0].dist2)
+	{
+		heap[0] = *item;
+		eduspm_SiftNearest(heap, *n, 0);
+	}
+
+} /* eduspm_PushNearest() */
+
+
+
+/*@================================
+ * eduspm_SiftNearest()
+ *================================*/
+/*
+ * Function: void eduspm_SiftNearest(SpatialItem*, Four, Four)
+ *
+ * Description:
+ *  Move the item at 'j' down the max-heap to its place.
+ *
+ * Returns:
+ *  None
+ */
+void eduspm_SiftNearest(
+    SpatialItem         *heap,          /* INOUT the max-heap on the distance */
+    Four                n,              /* IN # of the items in the heap */
+    Four                j)              /* IN position of the item */
+{
+    Four                child;          /* the farther child */
+    SpatialItem         item;           /* the item to move */
+
+
+	item = heap[j];
+	for ( ; (child = 2 * j + 1) < n; j = child)
+	{
+		if (child + 1 < n && heap[child+1].dist2 > heap[child].dist2) child++;
+		if (heap[child].dist2 <= item.dist2) break;
+		heap[j] = heap[child];
+	}
+	heap[j] = item;
+
+} /* eduspm_SiftNearest() */
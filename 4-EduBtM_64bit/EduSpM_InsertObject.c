@@ -0,0 +1,94 @@
+/******************************************************************************/
+/*                                                                            */
+/*    ODYSSEUS/EduCOSMOS Educational-Purpose Object Storage System            */
+/*                                                                            */
+/*    Developed by Professor Kyu-Young Whang et al.                           */
+/*                                                                            */
+/*    Database and Multimedia Laboratory                                      */
+/*                                                                            */
+/*    Computer Science Department and                                         */
+/*    Advanced Information Technology Research Center (AITrc)                 */
+/*    Korea Advanced Institute of Science and Technology (KAIST)              */
+/*                                                                            */
+/*    e-mail: kywhang@cs.kaist.ac.kr                                          */
+/*    phone: +82-42-350-7722                                                  */
+/*    fax: +82-42-350-8380                                                    */
+/*                                                                            */
+/*    Copyright (c) 1995-2013 by Kyu-Young Whang                              */
+/*                                                                            */
+/*    All rights reserved. No part of this software may be reproduced,        */
+/*    stored in a retrieval system, or transmitted, in any form or by any     */
+/*    means, electronic, mechanical, photocopying, recording, or otherwise,   */
+/*    without prior written permission of the copyright owner.                */
+/*                                                                            */
+/******************************************************************************/
+/*
+ * Module: EduSpM_InsertObject.c
+ *
+ * Description :
+ *  Insert an ObjectID 'oid' into a spatial index at the point 'point'.
+ *
+ * Exports:
+ *  Four EduSpM_InsertObject(ObjectID*, PageID*, SpatialDesc*, UFour*, ObjectID*, Pool*, DeallocListElem*)
+ */
+
+
+#include "EduBtM_common.h"
+#include "EduSpM.h"
+#include "EduBtM.h"
+
+
+
+/*@================================
+ * EduSpM_InsertObject()
+ *================================*/
+/*
+ * Function: Four EduSpM_InsertObject(ObjectID*, PageID*, SpatialDesc*, UFour*, ObjectID*, Pool*, DeallocListElem*)
+ * 
+ * Description :
+ *  Insert an ObjectID 'oid' into a spatial index at the point 'point'.
+ *  The point is mapped to its code on the curve of the index, and the
+ *  code followed by 'oid' is inserted into the B+ tree as the key. So
+ *  any number of objects may be at the same point, but an object can be
+ *  inserted at a point only once.
+ *
+ * Returns:
+ *  error code
+ *    eBADPARAMETER_BTM
+ *    eDUPLICATEDOBJECTID_BTM
+ *    some errors caused by function calls
+ */
+Four EduSpM_InsertObject(
+    ObjectID *catObjForFile,	/* IN catalog object of the index file */
+    PageID   *root,		/* IN root page of the spatial index */
+    SpatialDesc *sdesc,		/* IN descriptor of the space */
+    UFour    *point,		/* IN coordinates of the point */
+    ObjectID *oid,		/* IN ObjectID which will be inserted */
+    Pool     *dlPool,		/* INOUT pool of dealloc list */
+    DeallocListElem *dlHead) /* INOUT head of the dealloc list */
+{
+    Four e;			/* error number */
+    KeyDesc kdesc;		/* key descriptor of the B+ tree */
+    KeyValue kval;		/* the code followed by the ObjectID */
+
+
+    /*@ check parameters */
+    
+    if (catObjForFile == NULL || root == NULL || oid == NULL) ERR(eBADPARAMETER_BTM);
+
+    if (dlPool == NULL || dlHead == NULL) ERR(eBADPARAMETER_BTM);
+
+	e = eduspm_CheckDesc(sdesc);
+	if (e < 0) ERR(e);
+
+	if (point == NULL || !eduspm_ValidPoint(sdesc, point)) ERR(eBADPARAMETER_BTM);
+
+	eduspm_KeyDesc(&kdesc);
+	eduspm_MakeKey(eduspm_Encode(sdesc, point), oid, FALSE, &kval);
+
+	e = EduBtM_InsertObject(catObjForFile, root, &kdesc, &kval, oid, dlPool, dlHead);
+	if (e < 0) ERR(e);
+
+    return(eNOERROR);
+    
+}   /* EduSpM_InsertObject() */
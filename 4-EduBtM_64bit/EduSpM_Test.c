@@ -0,0 +1,707 @@
+/******************************************************************************/
+/*                                                                            */
+/*    ODYSSEUS/EduCOSMOS Educational-Purpose Object Storage System            */
+/*                                                                            */
+/*    Developed by Professor Kyu-Young Whang et al.                           */
+/*                                                                            */
+/*    Database and Multimedia Laboratory                                      */
+/*                                                                            */
+/*    Computer Science Department and                                         */
+/*    Advanced Information Technology Research Center (AITrc)                 */
+/*    Korea Advanced Institute of Science and Technology (KAIST)              */
+/*                                                                            */
+/*    e-mail: kywhang@cs.kaist.ac.kr                                          */
+/*    phone: +82-42-350-7722                                                  */
+/*    fax: +82-42-350-8380                                                    */
+/*                                                                            */
+/*    Copyright (c) 1995-2013 by Kyu-Young Whang                              */
+/*                                                                            */
+/*    All rights reserved. No part of this software may be reproduced,        */
+/*    stored in a retrieval system, or transmitted, in any form or by any     */
+/*    means, electronic, mechanical, photocopying, recording, or otherwise,   */
+/*    without prior written permission of the copyright owner.                */
+/*                                                                            */
+/******************************************************************************/
+/*
+ * Module: EduSpM_Test.c
+ *
+ * Description :
+ *  Regression test of the spatial index. For the Z-order and the Hilbert
+ *  curve, in two and three dimensions, random points are inserted into an
+ *  index; a third of them fall in a small corner of the space, so many
+ *  share their place. Some of the points are deleted, and the index is
+ *  checked against a brute-force scan of the points kept in an array:
+ *   - EduSpM_FetchBox() on random boxes, large and small, a box of a
+ *     single point and the whole space, returns exactly the points in the
+ *     box, read a random number of points at a time, and
+ *   - EduSpM_FetchNearest() on random query points returns points with
+ *     the same distances as the nearest ones of the array, nearest first.
+ *  The deletions and the checks are repeated for a few rounds. Inserting a point twice returns eDUPLICATEDOBJECTID_BTM, and
+ *  deleting a point not in the index returns eNOTFOUND_BTM.
+ *
+ *  Usage: EduSpM_Test
+ *
+ *  The exit status is 0 if all the checks pass.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "EduBtM_common.h"
+#include "EduBtM_basictypes.h"
+#include "BfM.h"
+#include "EduSpM.h"
+#include "EduBtM_TestModule.h"
+
+
+#define STEST_VOLUME        "spmtest.vol"
+#define STEST_NUMPAGES      8000    /* # of pages of the volume */
+#define STEST_NUMPOINTS     6000    /* # of points inserted into an index */
+#define STEST_CLUSTER       64      /* the clustered points are in [0, STEST_CLUSTER) in each dimension */
+#define STEST_ROUNDS        3       /* # of rounds of deletions and checks */
+#define STEST_BOXES         100     /* # of random boxes in a check */
+#define STEST_NEAREST       50      /* # of random nearest neighbor searches in a check */
+#define STEST_MAXK          40      /* maximum 'k' of a nearest neighbor search */
+#define STEST_MAXITEMS      50      /* maximum # of points read from a box at once */
+
+Four SM_CreateFile(Four, FileID*, Boolean, void*);
+Four sm_GetCatalogEntryFromDataFileId(Four, FileID*, ObjectID*);
+
+Four EduSpM_Test(Four, Four);
+Four stest_Space(ObjectID*, SpatialDesc*);
+Four stest_Insert(ObjectID*, PageID*, SpatialDesc*, Four);
+Four stest_Delete(ObjectID*, PageID*, SpatialDesc*, Four);
+Four stest_Box(PageID*, SpatialDesc*, UFour*, UFour*);
+Four stest_Nearest(PageID*, SpatialDesc*, UFour*, Four);
+Four stest_Check(PageID*, SpatialDesc*, char*);
+void stest_RandomPoint(SpatialDesc*, UFour*);
+void stest_MakeOid(ObjectID*, Four, ObjectID*);
+double stest_Dist2(SpatialDesc*, UFour*, UFour*);
+int stest_CompareDist(const void*, const void*);
+
+static SpatialDesc stest_spaces[] = {          /* the spaces tested */
+	{ 2, 16, SPM_ZORDER },
+	{ 2, 16, SPM_HILBERT },
+	{ 3, 10, SPM_ZORDER },
+	{ 3, 10, SPM_HILBERT }
+};
+
+static UFour stest_point[STEST_NUMPOINTS][SPM_MAXDIMS];  /* the coordinates of each point */
+static char stest_alive[STEST_NUMPOINTS];               /* TRUE if the point is in the index */
+static Four stest_seen[STEST_NUMPOINTS];                /* # of the last query that returned the point */
+static Four stest_query;                                /* # of the current query */
+static SpatialItem stest_items[STEST_NUMPOINTS];        /* the points returned by a query */
+static double stest_dist[STEST_NUMPOINTS];              /* the distances of the points to a query point */
+static Four stest_nErrors;                              /* # of violations found by the current check */
+
+
+
+/*@================================
+ * main()
+ *================================*/
+int main(int argc, char *argv[])
+{
+	Four	e;									/* for errors */
+	Four	handle;								/* system handle */
+	char 	*devNames[1];						/* device name */
+	Four 	volId = 1000;						/* volume identifier */
+	Four 	numPagesInDevices[1];				/* # of pages in the device */
+	XactID 	xactId;								/* transaction identifier */
+
+
+	devNames[0] = STEST_VOLUME;
+	numPagesInDevices[0] = STEST_NUMPAGES;
+
+	e = LRDS_Init();
+	if (e < eNOERROR) { printf("LRDS_Init failed!!!\n"); exit(1); }
+
+	e = LRDS_AllocHandle(&handle);
+	if (e < eNOERROR) { printf("LRDS_AllocHandle failed!!!\n"); LRDS_Final(); exit(1); }
+
+	e = LRDS_FormatDataVolume(1, devNames, "spmtest", volId, 16, numPagesInDevices, 16);
+	if (e < eNOERROR) { printf("LRDS_FormatDataVolume failed!!!\n"); LRDS_FreeHandle(handle); LRDS_Final(); exit(1); }
+
+	e = LRDS_Mount(1, devNames, &volId);
+	if (e < eNOERROR) { printf("LRDS_Mount failed!!!\n"); LRDS_FreeHandle(handle); LRDS_Final(); exit(1); }
+
+	e = LRDS_BeginTransaction(&xactId, X_RR_RR);
+	if (e < eNOERROR) { LRDS_Dismount(volId); LRDS_FreeHandle(handle); LRDS_Final(); exit(1); }
+
+	e = EduSpM_Test(volId, handle);
+	if (e < eNOERROR) {
+		printf("EduSpM_Test failed!!!\n");
+		LRDS_AbortTransaction(&xactId);
+		LRDS_Dismount(volId);
+		LRDS_FreeHandle(handle);
+		LRDS_Final();
+		exit(1);
+	}
+
+	e = LRDS_CommitTransaction(&xactId);
+	if (e < eNOERROR) printf("LRDS_CommitTransaction failed!!!\n");
+
+	LRDS_Dismount(volId);
+	LRDS_FreeHandle(handle);
+	LRDS_Final();
+
+	return 0;
+}
+
+
+
+/*@================================
+ * EduSpM_Test()
+ *================================*/
+/*
+ * Function: Four EduSpM_Test(Four, Four)
+ *
+ * Description:
+ *  Run the test described above on each space of 'stest_spaces'.
+ *
+ * Returns:
+ *  error code
+ *    eBADBTREEPAGE_BTM if a check fails
+ *    some errors caused by function calls
+ */
+Four EduSpM_Test(
+    Four        volId,                  /* IN volume identifier */
+    Four        handle)                 /* IN system handle */
+{
+    Four        e;                      /* error number */
+    Four        i;                      /* index */
+    FileID      fid;                    /* file identifier */
+    ObjectID    catalogEntry;           /* catalog object */
+
+
+	e = SM_CreateFile(volId, &fid, FALSE, NULL);
+	if (e < eNOERROR) ERR(e);
+
+	e = sm_GetCatalogEntryFromDataFileId(ARRAYINDEX, &fid, &catalogEntry);
+	if (e < eNOERROR) ERR(e);
+
+	srand(43);
+	stest_query = 0;
+	memset(stest_seen, 0, sizeof(stest_seen));
+
+	for (i = 0; i < sizeof(stest_spaces) / sizeof(stest_spaces[0]); i++)
+	{
+		e = stest_Space(&catalogEntry, &stest_spaces[i]);
+		if (e < eNOERROR) ERR(e);
+	}
+
+	printf("all checks passed\n");
+
+	return(eNOERROR);
+
+} /* EduSpM_Test() */
+
+
+
+/*@================================
+ * stest_Space()
+ *================================*/
+/*
+ * Function: Four stest_Space(ObjectID*, SpatialDesc*)
+ *
+ * Description:
+ *  Build a spatial index of random points in the given space, check it
+ *  while deleting the points in rounds, and drop it.
+ *
+ * Returns:
+ *  error code
+ *    eBADBTREEPAGE_BTM if a check fails
+ *    some errors caused by function calls
+ */
+Four stest_Space(
+    ObjectID        *catObjForFile,     /* IN catalog object of the index file */
+    SpatialDesc     *sdesc)             /* IN descriptor of the space */
+{
+    Four            e;                  /* error number */
+    Four            i, j;               /* indexes */
+    PageID          root;               /* root page of the index */
+    PhysicalFileID  pFid;               /* file of the index */
+    char            step[64];           /* name of a step */
+
+
+	e = EduSpM_CreateIndex(catObjForFile, &root);
+	if (e < eNOERROR) ERR(e);
+
+	for (i = 0; i < STEST_NUMPOINTS; i++)
+	{
+		if (i % 3 == 0)
+			for (j = 0; j < sdesc->nDims; j++) stest_point[i][j] = rand() % STEST_CLUSTER;
+		else
+			stest_RandomPoint(sdesc, stest_point[i]);
+		stest_alive[i] = FALSE;
+
+		e = stest_Insert(catObjForFile, &root, sdesc, i);
+		if (e < eNOERROR) ERR(e);
+	}
+
+	sprintf(step, "%ldD %s built", (long)sdesc->nDims, (sdesc->curve == SPM_HILBERT) ? "Hilbert" : "Z-order");
+	e = stest_Check(&root, sdesc, step);
+	if (e < eNOERROR) ERR(e);
+
+	for (i = 0; i < STEST_ROUNDS; i++)
+	{
+		// Random points are deleted, some twice, and a few inserted again or twice.
+		for (j = 0; j < STEST_NUMPOINTS / 6; j++)
+		{
+			e = stest_Delete(catObjForFile, &root, sdesc, rand() % STEST_NUMPOINTS);
+			if (e < eNOERROR) ERR(e);
+
+			if (j % 50 == 0)
+			{
+				e = stest_Insert(catObjForFile, &root, sdesc, rand() % STEST_NUMPOINTS);
+				if (e < eNOERROR) ERR(e);
+			}
+		}
+
+		sprintf(step, "%ldD %s round %ld", (long)sdesc->nDims,
+		        (sdesc->curve == SPM_HILBERT) ? "Hilbert" : "Z-order", (long)i);
+		e = stest_Check(&root, sdesc, step);
+		if (e < eNOERROR) ERR(e);
+	}
+
+	MAKE_PAGEID(pFid, catObjForFile->volNo, catObjForFile->pageNo);
+	e = EduSpM_DropIndex(&pFid, &root, &dlPool, &dlHead);
+	if (e < eNOERROR) ERR(e);
+
+	return(eNOERROR);
+
+} /* stest_Space() */
+
+
+
+/*@================================
+ * stest_Insert()
+ *================================*/
+/*
+ * Function: Four stest_Insert(ObjectID*, PageID*, SpatialDesc*, Four)
+ *
+ * Description:
+ *  Insert the given point of the array. A point already in the index
+ *  should be refused with eDUPLICATEDOBJECTID_BTM.
+ *
+ * Returns:
+ *  error code
+ *    eBADBTREEPAGE_BTM if the result does not match the array
+ *    some errors caused by function calls
+ */
+Four stest_Insert(
+    ObjectID        *catObjForFile,     /* IN catalog object of the index file */
+    PageID          *root,              /* IN root page of the index */
+    SpatialDesc     *sdesc,             /* IN descriptor of the space */
+    Four            i)                  /* IN number of the point */
+{
+    Four            e;                  /* error number */
+    Four            expected;           /* the error expected */
+    ObjectID        oid;                /* ObjectID of the point */
+
+
+	stest_MakeOid(catObjForFile, i, &oid);
+	expected = stest_alive[i] ? eDUPLICATEDOBJECTID_BTM : eNOERROR;
+
+	e = EduSpM_InsertObject(catObjForFile, root, sdesc, stest_point[i], &oid, &dlPool, &dlHead);
+	if (e != expected)
+	{
+		if (e < eNOERROR && e != eDUPLICATEDOBJECTID_BTM) ERR(e);
+
+		printf("  the insertion of the point %ld returns %ld instead of %ld\n", (long)i, (long)e, (long)expected);
+		ERR(eBADBTREEPAGE_BTM);
+	}
+
+	stest_alive[i] = TRUE;
+
+	return(eNOERROR);
+
+} /* stest_Insert() */
+
+
+
+/*@================================
+ * stest_Delete()
+ *================================*/
+/*
+ * Function: Four stest_Delete(ObjectID*, PageID*, SpatialDesc*, Four)
+ *
+ * Description:
+ *  Delete the given point of the array. A point not in the index should
+ *  be refused with eNOTFOUND_BTM.
+ *
+ * Returns:
+ *  error code
+ *    eBADBTREEPAGE_BTM if the result does not match the array
+ *    some errors caused by function calls
+ */
+Four stest_Delete(
+    ObjectID        *catObjForFile,     /* IN catalog object of the index file */
+    PageID          *root,              /* IN root page of the index */
+    SpatialDesc     *sdesc,             /* IN descriptor of the space */
+    Four            i)                  /* IN number of the point */
+{
+    Four            e;                  /* error number */
+    Four            expected;           /* the error expected */
+    ObjectID        oid;                /* ObjectID of the point */
+
+
+	stest_MakeOid(catObjForFile, i, &oid);
+	expected = stest_alive[i] ? eNOERROR : eNOTFOUND_BTM;
+
+	e = EduSpM_DeleteObject(catObjForFile, root, sdesc, stest_point[i], &oid, &dlPool, &dlHead);
+	if (e != expected)
+	{
+		if (e < eNOERROR && e != eNOTFOUND_BTM) ERR(e);
+
+		printf("  the deletion of the point %ld returns %ld instead of %ld\n", (long)i, (long)e, (long)expected);
+		ERR(eBADBTREEPAGE_BTM);
+	}
+
+	stest_alive[i] = FALSE;
+
+	return(eNOERROR);
+
+} /* stest_Delete() */
+
+
+
+/*@================================
+ * stest_Box()
+ *================================*/
+/*
+ * Function: Four stest_Box(PageID*, SpatialDesc*, UFour*, UFour*)
+ *
+ * Description:
+ *  Read the points in the box ['lo', 'hi'] and compare them with the
+ *  points of the array in the box. The violations are printed and counted.
+ *
+ * Returns:
+ *  error code
+ *    some errors caused by function calls
+ */
+Four stest_Box(
+    PageID          *root,              /* IN root page of the index */
+    SpatialDesc     *sdesc,             /* IN descriptor of the space */
+    UFour           *lo,                /* IN the lowest corner of the box */
+    UFour           *hi)                /* IN the highest corner of the box */
+{
+    Four            e;                  /* error number */
+    Four            i, j;               /* indexes */
+    Four            u;                  /* number of a point */
+    Four            n;                  /* # of the points read at once */
+    Four            nFound;             /* # of the points returned */
+    Four            nExpected;          /* # of the points of the array in the box */
+    SpatialCursor   cursor;             /* scan of the box */
+
+
+	stest_query++;
+	nFound = 0;
+	cursor.flag = CURSOR_INVALID;
+	do {
+		e = EduSpM_FetchBox(root, sdesc, lo, hi, &cursor, stest_items, 1 + rand() % STEST_MAXITEMS, &n);
+		if (e < eNOERROR) ERR(e);
+
+		for (i = 0; i < n; i++)
+		{
+			u = stest_items[i].oid.unique;
+			if (u < 0 || u >= STEST_NUMPOINTS || !stest_alive[u] || stest_seen[u] == stest_query)
+			{
+				printf("  the box returns the point %ld, which is deleted or returned before\n", (long)u);
+				stest_nErrors++;
+				return(eNOERROR);
+			}
+			stest_seen[u] = stest_query;
+
+			for (j = 0; j < sdesc->nDims; j++)
+				if (stest_items[i].point[j] != stest_point[u][j] || stest_point[u][j] < lo[j] || stest_point[u][j] > hi[j]) break;
+			if (j < sdesc->nDims)
+			{
+				printf("  the box returns the point %ld at a wrong place or outside of the box\n", (long)u);
+				stest_nErrors++;
+				return(eNOERROR);
+			}
+		}
+		nFound += n;
+	} while (cursor.flag != CURSOR_EOS);
+
+	nExpected = 0;
+	for (u = 0; u < STEST_NUMPOINTS; u++)
+	{
+		if (!stest_alive[u]) continue;
+
+		for (j = 0; j < sdesc->nDims; j++)
+			if (stest_point[u][j] < lo[j] || stest_point[u][j] > hi[j]) break;
+		if (j == sdesc->nDims) nExpected++;
+	}
+
+	if (nFound != nExpected)
+	{
+		printf("  the box returns %ld points instead of %ld\n", (long)nFound, (long)nExpected);
+		stest_nErrors++;
+	}
+
+	return(eNOERROR);
+
+} /* stest_Box() */
+
+
+
+/*@================================
+ * stest_Nearest()
+ *================================*/
+/*
+ * Function: Four stest_Nearest(PageID*, SpatialDesc*, UFour*, Four)
+ *
+ * Description:
+ *  Find the 'k' nearest points to 'point' and compare their distances
+ *  with the 'k' smallest distances of the points of the array; the points
+ *  themselves may differ when several are at the same distance. The
+ *  violations are printed and counted.
+ *
+ * Returns:
+ *  error code
+ *    some errors caused by function calls
+ */
+Four stest_Nearest(
+    PageID          *root,              /* IN root page of the index */
+    SpatialDesc     *sdesc,             /* IN descriptor of the space */
+    UFour           *point,             /* IN the query point */
+    Four            k)                  /* IN # of the points to find */
+{
+    Four            e;                  /* error number */
+    Four            i;                  /* index */
+    Four            u;                  /* number of a point */
+    Four            n;                  /* # of the points found */
+    Four            nAlive;             /* # of the points of the array */
+
+
+	e = EduSpM_FetchNearest(root, sdesc, point, k, stest_items, &n);
+	if (e < eNOERROR) ERR(e);
+
+	nAlive = 0;
+	for (u = 0; u < STEST_NUMPOINTS; u++)
+		if (stest_alive[u]) stest_dist[nAlive++] = stest_Dist2(sdesc, stest_point[u], point);
+	qsort(stest_dist, nAlive, sizeof(double), stest_CompareDist);
+
+	if (n != MIN(k, nAlive))
+	{
+		printf("  the nearest neighbor search returns %ld points instead of %ld\n", (long)n, (long)MIN(k, nAlive));
+		stest_nErrors++;
+		return(eNOERROR);
+	}
+
+	stest_query++;
+	for (i = 0; i < n; i++)
+	{
+		u = stest_items[i].oid.unique;
+		if (u < 0 || u >= STEST_NUMPOINTS || !stest_alive[u] || stest_seen[u] == stest_query)
+		{
+			printf("  the nearest neighbor search returns the point %ld, which is deleted or returned before\n", (long)u);
+			stest_nErrors++;
+			return(eNOERROR);
+		}
+		stest_seen[u] = stest_query;
+
+		if (stest_items[i].dist2 != stest_Dist2(sdesc, stest_point[u], point) || stest_items[i].dist2 != stest_dist[i])
+		{
+			printf("  the %ld-th nearest point is at %.0f instead of %.0f\n", (long)i + 1, stest_items[i].dist2, stest_dist[i]);
+			stest_nErrors++;
+			return(eNOERROR);
+		}
+	}
+
+	return(eNOERROR);
+
+} /* stest_Nearest() */
+
+
+
+/*@================================
+ * stest_Check()
+ *================================*/
+/*
+ * Function: Four stest_Check(PageID*, SpatialDesc*, char*)
+ *
+ * Description:
+ *  Check the index against the array by random boxes and nearest neighbor
+ *  searches. Half of them are in the corner of the clustered points. The
+ *  violations are printed.
+ *
+ * Returns:
+ *  error code
+ *    eBADBTREEPAGE_BTM if the check fails
+ *    some errors caused by function calls
+ */
+Four stest_Check(
+    PageID          *root,              /* IN root page of the index */
+    SpatialDesc     *sdesc,             /* IN descriptor of the space */
+    char            *name)              /* IN name of the step */
+{
+    Four            e;                  /* error number */
+    Four            i, j;               /* indexes */
+    Four            nAlive;             /* # of the points of the array */
+    UFour           max;                /* the largest coordinate */
+    UFour           width;              /* width of a box */
+    UFour           lo[SPM_MAXDIMS];    /* the lowest corner of a box */
+    UFour           hi[SPM_MAXDIMS];    /* the highest corner of a box */
+
+
+	stest_nErrors = 0;
+	max = (sdesc->nBits == 32) ? ~(UFour)0 : ((UFour)1 << sdesc->nBits) - 1;
+
+	for (i = 0; i < STEST_BOXES; i++)
+	{
+		// The first box is the whole space and the second a single point of the array.
+		if (i == 1)
+			memcpy(lo, stest_point[rand() % STEST_NUMPOINTS], sizeof(lo));
+		else if (i % 2 == 0)
+			for (j = 0; j < sdesc->nDims; j++) lo[j] = rand() % STEST_CLUSTER;
+		else
+			stest_RandomPoint(sdesc, lo);
+
+		for (j = 0; j < sdesc->nDims; j++)
+		{
+			if (i == 0) { lo[j] = 0; width = max; }
+			else if (i == 1) width = 0;
+			else if (i % 2 == 0) width = rand() % STEST_CLUSTER;
+			else width = rand() % (max / 4 + 1);
+			hi[j] = (max - lo[j] < width) ? max : lo[j] + width;
+		}
+
+		e = stest_Box(root, sdesc, lo, hi);
+		if (e < eNOERROR) ERR(e);
+	}
+
+	for (i = 0; i < STEST_NEAREST; i++)
+	{
+		if (i % 2 == 0)
+			for (j = 0; j < sdesc->nDims; j++) lo[j] = rand() % STEST_CLUSTER;
+		else
+			stest_RandomPoint(sdesc, lo);
+
+		e = stest_Nearest(root, sdesc, lo, 1 + rand() % STEST_MAXK);
+		if (e < eNOERROR) ERR(e);
+	}
+
+	nAlive = 0;
+	for (i = 0; i < STEST_NUMPOINTS; i++)
+		if (stest_alive[i]) nAlive++;
+
+	printf("%-24s %6ld points %s\n", name, (long)nAlive, (stest_nErrors == 0) ? "ok" : "FAILED");
+
+	if (stest_nErrors > 0) ERR(eBADBTREEPAGE_BTM);
+
+	return(eNOERROR);
+
+} /* stest_Check() */
+
+
+
+/*@================================
+ * stest_RandomPoint()
+ *================================*/
+/*
+ * Function: void stest_RandomPoint(SpatialDesc*, UFour*)
+ *
+ * Description:
+ *  Make a point anywhere in the space.
+ *
+ * Returns:
+ *  None
+ */
+void stest_RandomPoint(
+    SpatialDesc     *sdesc,             /* IN descriptor of the space */
+    UFour           *point)             /* OUT the coordinates */
+{
+    Four            j;                  /* index */
+
+
+	for (j = 0; j < sdesc->nDims; j++)
+		point[j] = ((UFour)rand() * 7919u + rand()) & (((UEight)1 << sdesc->nBits) - 1);
+
+} /* stest_RandomPoint() */
+
+
+
+/*@================================
+ * stest_MakeOid()
+ *================================*/
+/*
+ * Function: void stest_MakeOid(ObjectID*, Four, ObjectID*)
+ *
+ * Description:
+ *  Make the ObjectID of the given point.
+ *
+ * Returns:
+ *  None
+ */
+void stest_MakeOid(
+    ObjectID        *catObjForFile,     /* IN catalog object of the index file */
+    Four            i,                  /* IN number of the point */
+    ObjectID        *oid)               /* OUT ObjectID */
+{
+	oid->volNo = catObjForFile->volNo;
+	oid->pageNo = i;
+	oid->slotNo = 0;
+	oid->unique = i;
+
+} /* stest_MakeOid() */
+
+
+
+/*@================================
+ * stest_Dist2()
+ *================================*/
+/*
+ * Function: double stest_Dist2(SpatialDesc*, UFour*, UFour*)
+ *
+ * Description:
+ *  Return the squared distance of two points.
+ *
+ * Returns:
+ *  squared distance
+ */
+double stest_Dist2(
+    SpatialDesc     *sdesc,             /* IN descriptor of the space */
+    UFour           *a,                 /* IN a point */
+    UFour           *b)                 /* IN another point */
+{
+    Four            j;                  /* index */
+    double          d;                  /* difference in a dimension */
+    double          dist2;              /* the squared distance */
+
+
+	dist2 = 0;
+	for (j = 0; j < sdesc->nDims; j++)
+	{
+		d = (double)a[j] - (double)b[j];
+		dist2 += d * d;
+	}
+
+	return(dist2);
+
+} /* stest_Dist2() */
+
+
+
+/*@================================
+ * stest_CompareDist()
+ *================================*/
+/*
+ * Function: int stest_CompareDist(const void*, const void*)
+ *
+ * Description:
+ *  Compare two distances for qsort().
+ *
+ * Returns:
+ *  negative, 0 or positive as the first is smaller, equal or larger
+ */
+int stest_CompareDist(
+    const void      *a,                 /* IN a distance */
+    const void      *b)                 /* IN another distance */
+{
+	if (*(double *)a < *(double *)b) return(-1);
+	if (*(double *)a > *(double *)b) return(1);
+
+	return(0);
+
+} /* stest_CompareDist() */
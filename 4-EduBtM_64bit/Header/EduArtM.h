@@ -0,0 +1,47 @@
+/******************************************************************************/
+/*                                                                            */
+/*    ODYSSEUS/EduCOSMOS Educational-Purpose Object Storage System            */
+/*                                                                            */
+/*    Developed by Professor Kyu-Young Whang et al.                           */
+/*                                                                            */
+/*    Database and Multimedia Laboratory                                      */
+/*                                                                            */
+/*    Computer Science Department and                                         */
+/*    Advanced Information Technology Research Center (AITrc)                 */
+/*    Korea Advanced Institute of Science and Technology (KAIST)              */
+/*                                                                            */
+/*    e-mail: kywhang@cs.kaist.ac.kr                                          */
+/*    phone: +82-42-350-7722                                                  */
+/*    fax: +82-42-350-8380                                                    */
+/*                                                                            */
+/*    Copyright (c) 1995-2013 by Kyu-Young Whang                              */
+/*                                                                            */
+/*    All rights reserved. No part of this software may be reproduced,        */
+/*    stored in a retrieval system, or transmitted, in any form or by any     */
+/*    means, electronic, mechanical, photocopying, recording, or otherwise,   */
+/*    without prior written permission of the copyright owner.                */
+/*                                                                            */
+/******************************************************************************/
+#ifndef _EDUARTM_H_
+#define _EDUARTM_H_
+
+
+#include "EduArtM_Internal.h"
+
+
+
+/*@
+ * Function Prototypes
+ */
+/* Interface Function Prototypes */
+Four EduArtM_CreateIndex(KeyDesc*, ArtIndex**);
+Four EduArtM_DeleteObject(ArtIndex*, KeyValue*, ObjectID*);
+Four EduArtM_DropIndex(ArtIndex*);
+Four EduArtM_Fetch(ArtIndex*, KeyValue*, Four, KeyValue*, Four, BtreeCursor*);
+Four EduArtM_FetchNext(ArtIndex*, KeyValue*, Four, BtreeCursor*, BtreeCursor*);
+Four EduArtM_InsertObject(ArtIndex*, KeyValue*, ObjectID*);
+Four EduArtM_Rebuild(ObjectID*, KeyDesc*, ArtIndex**);
+Four EduArtM_Snapshot(ObjectID*, ArtIndex*);
+
+
+#endif /* _EDUARTM_H_ */
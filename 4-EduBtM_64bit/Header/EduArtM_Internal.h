@@ -0,0 +1,151 @@
+/******************************************************************************/
+/*                                                                            */
+/*    ODYSSEUS/EduCOSMOS Educational-Purpose Object Storage System            */
+/*                                                                            */
+/*    Developed by Professor Kyu-Young Whang et al.                           */
+/*                                                                            */
+/*    Database and Multimedia Laboratory                                      */
+/*                                                                            */
+/*    Computer Science Department and                                         */
+/*    Advanced Information Technology Research Center (AITrc)                 */
+/*    Korea Advanced Institute of Science and Technology (KAIST)              */
+/*                                                                            */
+/*    e-mail: kywhang@cs.kaist.ac.kr                                          */
+/*    phone: +82-42-350-7722                                                  */
+/*    fax: +82-42-350-8380                                                    */
+/*                                                                            */
+/*    Copyright (c) 1995-2013 by Kyu-Young Whang                              */
+/*                                                                            */
+/*    All rights reserved. No part of this software may be reproduced,        */
+/*    stored in a retrieval system, or transmitted, in any form or by any     */
+/*    means, electronic, mechanical, photocopying, recording, or otherwise,   */
+/*    without prior written permission of the copyright owner.                */
+/*                                                                            */
+/******************************************************************************/
+#ifndef _EDUARTM_INTERNAL_H_
+#define _EDUARTM_INTERNAL_H_
+
+
+#include "EduBtM_Internal.h"
+#include "OM_Internal.h"
+
+
+/*@
+ * Constant Definitions
+ */
+/*
+ * Node types of the adaptive radix tree
+ *  An inner node of type ART_NODEn has up to n children; a node grows to
+ *  the next type when it is full and shrinks when it gets sparse, so the
+ *  fan-out adapts to the keys below it.
+ */
+#define ART_LEAF        0
+#define ART_NODE4       1
+#define ART_NODE16      2
+#define ART_NODE48      3
+#define ART_NODE256     4
+
+/* # of the bytes of the compressed path kept in a node */
+#define ART_MAXPREFIXLEN    8
+
+/* Maximum size of an object of a snapshot of the index */
+#define ART_SNAPSHOTOBJLEN  4000
+
+
+/*@
+ * Type Definitions
+ */
+/*
+ * ArtNode:
+ *  Header of the inner nodes. The node skips 'prefixLen' bytes of the
+ *  keys, which are the same for all the keys below it; only the first
+ *  ART_MAXPREFIXLEN of them are kept and the rest are read from a leaf.
+ */
+typedef struct {
+	One     type;               /* ART_NODE4, ART_NODE16, ART_NODE48 or ART_NODE256 */
+	Two     nChildren;          /* # of children */
+	Four    prefixLen;          /* length of the compressed path */
+	unsigned char prefix[ART_MAXPREFIXLEN]; /* the compressed path */
+} ArtNode;
+
+typedef struct {   /* children in the order of the key bytes */
+	ArtNode n;                  /* header of the node */
+	unsigned char keys[4];      /* key byte of each child */
+	void    *children[4];       /* the children */
+} ArtNode4;
+
+typedef struct {   /* children in the order of the key bytes */
+	ArtNode n;                  /* header of the node */
+	unsigned char keys[16];     /* key byte of each child */
+	void    *children[16];      /* the children */
+} ArtNode16;
+
+typedef struct {   /* 'index' gives 1 + the position of the child of the key byte or 0 */
+	ArtNode n;                  /* header of the node */
+	unsigned char index[256];   /* position of the child of each key byte */
+	void    *children[48];      /* the children */
+} ArtNode48;
+
+typedef struct {   /* a child for each key byte */
+	ArtNode n;                  /* header of the node */
+	void    *children[256];     /* the children */
+} ArtNode256;
+
+/*
+ * ArtLeaf:
+ *  An entry of the index. 'key' holds the normalized key of 'nlen' bytes,
+ *  which are compared by memcmp(), and then the key value of 'klen' bytes
+ *  as given to EduArtM_InsertObject().
+ */
+typedef struct {
+	One      type;              /* ART_LEAF */
+	Two      nlen;              /* length of the normalized key */
+	Two      klen;              /* length of the key value */
+	ObjectID oid;               /* ObjectID of the entry */
+	unsigned char key[1];       /* the normalized key and the key value */
+} ArtLeaf;
+
+#define ART_LEAF_FIXED  OFFSET_OF(ArtLeaf, key[0])
+
+/* Macro: ART_TYPE(p)
+ * Description: return the type of the node or the leaf given as a parameter
+ */
+#define ART_TYPE(p)     (((ArtNode*)(p))->type)
+
+/*
+ * ArtIndex:
+ *  An adaptive radix tree index; it lives only in the memory.
+ */
+typedef struct {
+	KeyDesc kdesc;              /* key descriptor */
+	void    *root;              /* root node or leaf; NULL if empty */
+	Four    nEntries;           /* # of entries */
+} ArtIndex;
+
+
+/*@
+ * Function Prototypes
+ */
+/*
+** Adaptive Radix Tree Index Manager Internal function prototypes
+*/
+Four eduartm_NormalizeKey(KeyDesc*, KeyValue*, unsigned char*, Two*);
+Four eduartm_CompareLeaf(ArtLeaf*, unsigned char*, Two);
+Four eduartm_PrefixMismatch(ArtNode*, unsigned char*, Two, Four);
+ArtLeaf *eduartm_Minimum(void*);
+ArtLeaf *eduartm_Maximum(void*);
+void **eduartm_FindChild(ArtNode*, unsigned char);
+void *eduartm_ChildAfter(ArtNode*, Four);
+void *eduartm_ChildBefore(ArtNode*, Four);
+Four eduartm_AddChild(ArtNode*, void**, unsigned char, void*);
+void eduartm_RemoveChild(ArtNode*, void**, unsigned char, void**);
+ArtNode *eduartm_AllocNode(One);
+void eduartm_FreeTree(void*);
+Four eduartm_Insert(void**, unsigned char*, Two, Four, ArtLeaf*);
+ArtLeaf *eduartm_Delete(void**, unsigned char*, Two, Four, ObjectID*);
+ArtLeaf *eduartm_Search(void*, unsigned char*, Two);
+ArtLeaf *eduartm_Seek(void*, unsigned char*, Two, Four, Boolean, Boolean);
+void eduartm_SetCursor(ArtIndex*, ArtLeaf*, KeyValue*, Four, BtreeCursor*);
+
+
+#endif /* _EDUARTM_INTERNAL_H_ */
@@ -36,11 +36,35 @@
  */
 /* Interface Function Prototypes */
 Four EduBtM_CreateIndex(ObjectID*, PageID*);
+Four EduBtM_CreateCoveringIndex(ObjectID*, PageID*, Two);
+Four EduBtM_CreatePackedIndex(ObjectID*, PageID*);
 Four EduBtM_DeleteObject(ObjectID*, PageID*, KeyDesc*, KeyValue*, ObjectID*, Pool*, DeallocListElem*);
+Four EduBtM_DeleteRange(ObjectID*, PageID*, KeyDesc*, KeyValue*, Four, KeyValue*, Four, Pool*, DeallocListElem*);
 Four EduBtM_DropIndex(PhysicalFileID*, PageID*, Pool*, DeallocListElem*);
 Four EduBtM_Fetch(PageID*, KeyDesc*, KeyValue*, Four, KeyValue*, Four, BtreeCursor*);
 Four EduBtM_FetchNext(PageID*, KeyDesc*, KeyValue*, Four, BtreeCursor*, BtreeCursor*);
+Four EduBtM_FetchPrefix(PageID*, KeyDesc*, Two, KeyValue*, Four, KeyValue*, Four, BtreeCursor*);
+Four EduBtM_FetchNextPrefix(PageID*, KeyDesc*, Two, KeyValue*, Four, BtreeCursor*, BtreeCursor*);
 Four EduBtM_InsertObject(ObjectID*, PageID*, KeyDesc*, KeyValue*, ObjectID*, Pool*, DeallocListElem*);
+Four EduBtM_InsertCovering(ObjectID*, PageID*, KeyDesc*, KeyValue*, ObjectID*, char*, Pool*, DeallocListElem*);
+Four EduBtM_InsertBatch(ObjectID*, PageID*, KeyDesc*, BtreeBatchItem*, Four, Pool*, DeallocListElem*);
+Four EduBtM_IndexJoin(PageID*, KeyDesc*, BtreeBatchItem*, Four, BtreeJoinPair*, Four*);
+Four EduBtM_MergeJoin(PageID*, KeyDesc*, PageID*, KeyDesc*, KeyValue*, Four, KeyValue*, Four, BtreeJoinCursor*, BtreeJoinPair*, Four, Four*);
+Four EduBtM_Reorganize(ObjectID*, PageID*, KeyDesc*, BtreeReorgCursor*, Four, Pool*, DeallocListElem*);
+Four EduBtM_GetStats(PageID*, KeyDesc*, BtreeStats*);
+Four EduBtM_SkipScan(PageID*, KeyDesc*, Two, KeyValue*, Four, KeyValue*, Four, BtreeCursor*);
+Four EduBtM_SkipScanNext(PageID*, KeyDesc*, Two, KeyValue*, Four, KeyValue*, Four, BtreeCursor*, BtreeCursor*);
+Four EduBtM_ExportSnapshot(PageID*, KeyDesc*, char*);
+Four EduBtM_OpenSnapshot(char*, BtreeSnapshot*);
+Four EduBtM_CloseSnapshot(BtreeSnapshot*);
+Four EduBtM_SnapshotFetch(BtreeSnapshot*, KeyValue*, Four, KeyValue*, Four, BtreeSnapshotCursor*);
+Four EduBtM_SnapshotFetchNext(BtreeSnapshot*, KeyValue*, Four, BtreeSnapshotCursor*, BtreeSnapshotCursor*);
+Four EduBtM_CacheTopLevels(PageID*, KeyDesc*, Four);
+Four EduBtM_UncacheTopLevels(PageID*);
+Four EduBtM_StartTrace(FILE*, Four);
+Four EduBtM_StopTrace(void);
+Four EduBtM_GetTrace(BtreeTrace*);
+Four EduBtM_DumpTrace(FILE*);
 
 
 #endif /* _EDUBTM_H_ */
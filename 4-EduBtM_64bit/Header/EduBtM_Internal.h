@@ -27,6 +27,7 @@
 
 
 #include "Util_pool.h"
+#include "BfM.h"
 
 
 /*@
@@ -116,6 +117,46 @@ typedef struct {   /* Internal (Nonleaf) Page */
  */
 #define BI_CFREE(p)   (PAGESIZE - BI_FIXED - (p)->hdr.free - ((p)->hdr.nSlots-1)*((CONSTANT_CASTING_TYPE)sizeof(Two)))
 #define BI_HALF       ((CONSTANT_CASTING_TYPE)((PAGESIZE-BI_FIXED)/2))
+#define BI_QUARTER    ((CONSTANT_CASTING_TYPE)((PAGESIZE-BI_FIXED)/4))
+
+/* Macro: BI_USED(p)
+ * Description: return the size of the area used by the entries and the slots of the internal page
+ * Parameter:
+ *  BtreeInternal *p      : pointer to the internal page
+ * Returns: (Four) size of used area
+ */
+#define BI_USED(p)    ((p)->hdr.free - (p)->hdr.reserved - (p)->hdr.unused + (p)->hdr.nSlots*(CONSTANT_CASTING_TYPE)sizeof(Two))
+
+/*
+ * Message buffer of the internal page:
+ *  In an index with KEYFLAG_BUFFERED, the first 'hdr.reserved' bytes of the
+ *  data area of an internal page hold the insert/delete messages which are
+ *  not yet applied to the subtree. The internal entries follow the buffer,
+ *  so 'hdr.free' never falls below 'hdr.reserved'. 'hdr.reserved' is 0 for
+ *  the internal pages of the ordinary indexes.
+ */
+typedef struct {
+	Two used;           /* # of bytes used by the messages */
+	Two nMsgs;          /* # of messages in the buffer */
+} btm_MsgBufferHdr;
+
+#define BI_MSGBUFSIZE   ((CONSTANT_CASTING_TYPE)(PAGESIZE/4))
+
+/* Macro: BI_MSGHDR(p), BI_MSGS(p)
+ * Description: return the header and the first message of the message buffer of the internal page
+ * Parameter:
+ *  BtreeInternal *p      : pointer to the internal page
+ */
+#define BI_MSGHDR(p)    ((btm_MsgBufferHdr*)(p)->data)
+#define BI_MSGS(p)      ((p)->data + sizeof(btm_MsgBufferHdr))
+
+/* Macro: BI_MSGFREE(p)
+ * Description: return the size of free area of the message buffer of the internal page
+ * Parameter:
+ *  BtreeInternal *p      : pointer to the internal page
+ * Returns: (Four) size of free area
+ */
+#define BI_MSGFREE(p)   ((p)->hdr.reserved - (CONSTANT_CASTING_TYPE)sizeof(btm_MsgBufferHdr) - BI_MSGHDR(p)->used)
 
 
 /*
@@ -158,8 +199,17 @@ typedef struct {   /* Leaf Page */
  */
 #define BL_CFREE(p)    (PAGESIZE - BL_FIXED - (p)->hdr.free - ((p)->hdr.nSlots-1)*((CONSTANT_CASTING_TYPE)sizeof(Two)))
 #define BL_HALF        ((CONSTANT_CASTING_TYPE)((PAGESIZE-BL_FIXED)/2))
+#define BL_QUARTER     ((CONSTANT_CASTING_TYPE)((PAGESIZE-BL_FIXED)/4))
 #define OVERFLOW_SPLIT ((CONSTANT_CASTING_TYPE)(PAGESIZE-BL_FIXED)/3)
 
+/* Macro: BL_USED(p)
+ * Description: return the size of the area used by the entries and the slots of the leaf page
+ * Parameter:
+ *  BtreeLeaf *p      : pointer to the leaf page
+ * Returns: (Four) size of used area
+ */
+#define BL_USED(p)    ((p)->hdr.free - (p)->hdr.unused + (p)->hdr.nSlots*(CONSTANT_CASTING_TYPE)sizeof(Two))
+
 
 /*
  * BteeOverflow:
@@ -212,6 +262,9 @@ typedef union {
 #define LEAF        0x04
 #define OVERFLOW    0x08
 #define FREEPAGE    0x10
+#define HASH        0x20    /* page of a hash index; see EduHtM_Internal.h */
+#define LSM         0x40    /* page of an LSM index; see EduLsM_Internal.h */
+#define PACKED      0x80    /* leaf whose ObjectIDs are packed; see btm_OidBase */
 
 
 /****************************************************************
@@ -247,8 +300,132 @@ typedef struct {
 	Two klen;           /* key length */
 				/* From this point, alignment is counted. */
 	char kval[1];       /* key value and (ObjectID array or overflow PageID) */
+				/* and the included columns of a covering index */
 } btm_LeafEntry;
 
+/* Data type of Message; the same layout as the leaf entry */
+typedef struct {
+	Two op;             /* BTM_MSG_INSERT or BTM_MSG_DELETE */
+	/* 'klen' and 'kval' should be attached in this order */
+	/* to cast this variables the type KeyVlaue. */
+	Two klen;           /* key length */
+	char kval[1];       /* key value and ObjectID */
+} btm_Message;
+
+#define BTM_MSG_DELETE  0
+#define BTM_MSG_INSERT  1
+#define BTM_MSGLEN(klen) (2*sizeof(Two) + ALIGNED_LENGTH(klen) + sizeof(ObjectID))
+
+/* Macro: BI_ENTRYLEN(e), BL_ENTRYLEN(p, e)
+ * Description: return the length of the internal entry and the leaf entry given as a parameter
+ * Parameter:
+ *  BtreeLeaf *p      : pointer to the leaf page holding the entry
+ *  btm_InternalEntry *e or btm_LeafEntry *e : pointer to the entry
+ * Returns: (Two) length of the entry
+ */
+#define BI_ENTRYLEN(e)  ((Two)(sizeof(ShortPageID) + sizeof(Two) + ALIGNED_LENGTH((e)->klen)))
+#define BL_ENTRYLEN(p, e)  ((Two)(2*sizeof(Two) + ALIGNED_LENGTH((e)->klen) + BL_OIDLEN(p, e) + ALIGNED_LENGTH((p)->hdr.reserved)))
+
+/* Macro: BL_ITEMLEN(p, i)
+ * Description: return the length of the leaf entry of the LeafItem when stored in the leaf
+ * Parameter:
+ *  BtreeLeaf *p      : pointer to the leaf page
+ *  LeafItem *i       : pointer to the item
+ * Returns: (Two) length of the entry
+ */
+#define BL_ITEMLEN(p, i)  ((Two)(2*sizeof(Two) + ALIGNED_LENGTH((i)->klen) + \
+	(((p)->hdr.type & PACKED) ? edubtm_PackOid((p), &(i)->oid, NULL) : (Two)sizeof(ObjectID)) + \
+	ALIGNED_LENGTH((p)->hdr.reserved)))
+
+/*
+ * btm_OidBase:
+ *  Packed ObjectIDs of a leaf. In a leaf of type PACKED the data area
+ *  begins with the base below, and the ObjectID of an entry is stored as
+ *  varints relative to it; see edubtm_PackOid.c. The base is taken from the
+ *  first ObjectID stored in the leaf and is copied to the leaves split off,
+ *  so the leaves of an index share it and the entries are moved between
+ *  them as they are.
+ */
+typedef struct {
+	PageNo  pageNo;     /* page No. of the base; NIL until an ObjectID is stored */
+	VolNo   volNo;      /* volume No. of the base */
+} btm_OidBase;
+
+#define BTM_MAXVARINTLEN 5  /* maximum length of the varint of a UFour */
+#define BL_OIDBASE(p)   ((btm_OidBase*)(p)->data)
+#define BL_DATASTART(p) ((Two)(((p)->hdr.type & PACKED) ? ALIGNED_LENGTH(sizeof(btm_OidBase)) : 0))
+
+/* Macro: BL_OID(e), BL_OIDLEN(p, e)
+ * Description: return the position and the length of the ObjectID of the leaf entry
+ * Parameter:
+ *  BtreeLeaf *p      : pointer to the leaf page holding the entry
+ *  btm_LeafEntry *e  : pointer to the entry
+ */
+#define BL_OID(e)       ((e)->kval + ALIGNED_LENGTH((e)->klen))
+#define BL_OIDLEN(p, e) \
+	(((p)->hdr.type & PACKED) ? edubtm_UnpackOid((p), BL_OID(e), NULL) : (Two)sizeof(ObjectID))
+
+/* Macro: BTM_COPY_KEY(to, from)
+ * Description: copy the key length and the used bytes of the key value; 'to' and 'from'
+ *  point to a KeyValue or to the 'klen' of an entry or an item
+ */
+#define BTM_COPY_KEY(to, from) \
+	memcpy((to), (from), sizeof(Two) + ((KeyValue*)(from))->len)
+
+/*
+ * Included columns of a covering index:
+ *  'hdr.reserved' of a leaf page is the length of the included columns of
+ *  the index. Every entry of the leaf carries that many bytes after its
+ *  ObjectID, so an index-only query need not read the data file. It is 0
+ *  for the ordinary indexes and is inherited by the leaves split off.
+ */
+#define BL_INCLUDED(p, e)  (BL_OID(e) + BL_OIDLEN(p, e))
+
+/* Data type of an entry of a B+ tree snapshot; every entry has the same size */
+typedef struct {
+	/* 'klen' and 'kval' should be attached in this order */
+	/* to cast this variables the type KeyVlaue. */
+	Two klen;           /* key length */
+	char kval[1];       /* key value padded to the longest one */
+				/* and the ObjectID and the included columns at the end */
+} btm_SnapshotEntry;
+
+/* Macro: BTM_SNAPSHOT_ENTRY(s, k), BTM_SNAPSHOT_OID(s, e)
+ * Description: return the k-th entry in the Eytzinger order and the ObjectID of the entry
+ * Parameter:
+ *  BtreeSnapshot *s      : pointer to the snapshot
+ *  Four k                : entry No., 1 to 'nEntries'
+ *  btm_SnapshotEntry *e  : pointer to the entry
+ */
+#define BTM_SNAPSHOT_ENTRY(s, k) \
+	((btm_SnapshotEntry*)((s)->entries + ((k)-1)*(s)->hdr->entrySize))
+#define BTM_SNAPSHOT_OID(s, e) \
+	((ObjectID*)((char*)(e) + (s)->hdr->entrySize - ALIGNED_LENGTH((s)->hdr->includedLen) - sizeof(ObjectID)))
+
+/* Macro: BTM_INTERPOLATABLE(kdesc)
+ * Description: return TRUE if the pages of the index are searched by the interpolation search;
+ *  the index asks for it and the key is a single integer
+ */
+#define BTM_INTERPOLATABLE(kdesc) \
+	(((kdesc)->flag & KEYFLAG_INTERPOLATE) && (kdesc)->nparts == 1 && \
+	 (kdesc)->kpart[0].type == SM_INT && (kdesc)->kpart[0].length == sizeof(Four_Invariable))
+
+/* Macro: BTM_LEAF_UNDERFULL(kdesc, p), BTM_INTERNAL_UNDERFULL(kdesc, p)
+ * Description: return TRUE if the page is to be merged or redistributed after a deletion
+ *  by the delete policy of the index: when less than half full by default, when less
+ *  than a quarter full with KEYFLAG_MERGEQUARTER, or when empty with KEYFLAG_FREEEMPTY;
+ *  an internal page is empty when only 'p0' is left
+ */
+#define BTM_LEAF_UNDERFULL(kdesc, p) \
+	(((kdesc)->flag & KEYFLAG_FREEEMPTY) ? (p)->hdr.nSlots == 0 : \
+	 ((kdesc)->flag & KEYFLAG_MERGEQUARTER) ? BL_USED(p) < BL_QUARTER : (Four)BL_FREE(p) > BL_HALF)
+#define BTM_INTERNAL_UNDERFULL(kdesc, p) \
+	(((kdesc)->flag & KEYFLAG_FREEEMPTY) ? (p)->hdr.nSlots == 0 : \
+	 ((kdesc)->flag & KEYFLAG_MERGEQUARTER) ? BI_USED(p) < BI_QUARTER : (Four)BI_FREE(p) > BI_HALF)
+
+/* the maximum # of slots of a page; an entry has at least 2*sizeof(Two) bytes */
+#define BTM_MAXSLOTS    ((CONSTANT_CASTING_TYPE)((PAGESIZE-BI_FIXED)/(3*sizeof(Two))))
+
 /* Data type for representing an internal item */
 typedef struct {
 	ShortPageID spid;       /* points to the child page */
@@ -262,9 +439,44 @@ typedef struct {
 	Two nObjects;       /* # of ObjectIDs */
 	Two  klen;          /* key length */
 	char kval[MAXKEYLEN];   /* key value */
+	char included[MAXINCLUDEDLEN];  /* included columns */
 } LeafItem;
 
 
+/*
+ * btm_TopCache:
+ *  decoded copy of the top levels of the internal pages of an index, set up
+ *  by EduBtM_CacheTopLevels(). A node mirrors an internal page: 'p0' and the
+ *  children of the separators are in one array, and the separators in
+ *  another one, as the integers themselves for a single SM_INT key. The
+ *  nodes are kept in the breadth-first order, so the children of a node
+ *  of an upper level are the consecutive nodes from 'child' on.
+ *  A change of a mirrored page marks the cache invalid, and the next search
+ *  builds it again.
+ */
+typedef struct {
+	ShortPageID pageNo;         /* the mirrored page */
+	Two         nKeys;          /* # of separators */
+	Four        child;          /* node No. of the child 'p0', or NIL at the last level */
+	ShortPageID *spids;         /* 'p0' and the children of the separators; the node's memory */
+	Four_Invariable *ikeys;     /* separators of a single SM_INT key, or NULL */
+	Two         *offsets;       /* offsets of the separators in 'keys' */
+	char        *keys;          /* separators laid out as KeyValues */
+} btm_TopCacheNode;
+
+typedef struct {
+	PageID      root;           /* root of the index */
+	KeyDesc     kdesc;          /* key descriptor of the index */
+	Two         nLevels;        /* # of levels asked for; 0 for a free entry */
+	Two         height;         /* # of levels mirrored */
+	Boolean     valid;          /* FALSE if a mirrored page has changed */
+	Four        nNodes;         /* # of 'nodes' */
+	btm_TopCacheNode *nodes;    /* the nodes in the breadth-first order */
+} btm_TopCache;
+
+#define BTM_MAXTOPCACHES    16  /* maximum # of indexes with the top levels cached */
+
+
 /*@
 ** Macro Definitions
 */
@@ -283,6 +495,29 @@ BEGIN_MACRO \
     catEntry = &(((sm_CatOverlayForSysTables*)&(obj->data))->btree);\
 END_MACRO
 
+/* Macro: ERRT(e, op)
+ * Description: end tracing the operation 'op' and return the error 'e' as ERR() does;
+ *  used for the errors between edubtm_TraceBegin() and edubtm_TraceEnd()
+ */
+#define ERRT(e, op) \
+BEGIN_MACRO \
+    PRTERR(e); edubtm_TraceEnd(op); if (1) return(e); \
+END_MACRO
+
+
+/*@
+ * Global Variables
+ */
+extern Four edubtm_nProbes;     /* # of the keys read by the searches in the pages */
+extern Four edubtm_nFixes;      /* # of the pages fixed */
+extern Four edubtm_nSplits;     /* # of the pages splitted */
+extern Four edubtm_nMerges;     /* # of the pages merged into their siblings */
+extern Four edubtm_nRedistributions;  /* # of the redistributions between siblings */
+extern btm_TopCache edubtm_topCaches[BTM_MAXTOPCACHES];  /* caches of the top levels */
+extern Four edubtm_nTopCaches;  /* # of the used entries of 'edubtm_topCaches' */
+extern Boolean edubtm_tracing;  /* TRUE while EduBtM_StartTrace() is in effect */
+extern BtreeTrace edubtm_trace; /* the counters of the tracing */
+extern Two edubtm_traceDepth;   /* level of the page the current descent fixes next */
 
 /*@
  * Function Prototypes
@@ -291,21 +526,74 @@ END_MACRO
 ** B+tree Manager Internal function prototypes
 */
 Boolean edubtm_BinarySearchInternal(BtreeInternal*, KeyDesc*, KeyValue*, Two*);
+Boolean edubtm_InterpolationSearch(char*, Two*, Two, Two, Four_Invariable, Two*);
 Boolean edubtm_BinarySearchLeaf(BtreeLeaf*, KeyDesc*, KeyValue*, Two*);
 void edubtm_CompactInternalPage(BtreeInternal*, Two);
 void edubtm_CompactLeafPage(BtreeLeaf*, Two);
 Four edubtm_KeyCompare(KeyDesc*, KeyValue*, KeyValue*);
+Four edubtm_DuplicateError(KeyDesc*, ObjectID*, ObjectID*);
+Two edubtm_PackOid(BtreeLeaf*, ObjectID*, char*);
+Two edubtm_UnpackOid(BtreeLeaf*, char*, ObjectID*);
+void edubtm_GetOid(BtreeLeaf*, btm_LeafEntry*, ObjectID*);
+void edubtm_PutOid(BtreeLeaf*, btm_LeafEntry*, ObjectID*);
+void edubtm_CopyLeafFormat(BtreeLeaf*, BtreeLeaf*);
 Four edubtm_Delete(ObjectID*, PageID*, KeyDesc*, KeyValue*, ObjectID*, Boolean*, Boolean*, InternalItem*, Pool*, DeallocListElem*);
-Four edubtm_Insert(ObjectID*, PageID*, KeyDesc*, KeyValue*, ObjectID*, Boolean*, Boolean*, InternalItem*, Pool*, DeallocListElem*);
-Four edubtm_InsertLeaf(ObjectID*, PageID*, BtreeLeaf*, KeyDesc*, KeyValue*, ObjectID*, Boolean*, Boolean*, InternalItem*);
+Four edubtm_DeleteLeaf(PhysicalFileID*, PageID*, BtreeLeaf*, KeyDesc*, KeyValue*, ObjectID*, Boolean*, Boolean*, InternalItem*, Pool*, DeallocListElem*);
+Four edubtm_DeleteRange(PhysicalFileID*, PageID*, KeyDesc*, KeyValue*, Four, KeyValue*, Four, Pool*, DeallocListElem*);
+Four edubtm_Insert(ObjectID*, PageID*, KeyDesc*, KeyValue*, ObjectID*, char*, Boolean*, Boolean*, InternalItem*, Pool*, DeallocListElem*);
+Four edubtm_InsertLeaf(ObjectID*, PageID*, BtreeLeaf*, KeyDesc*, KeyValue*, ObjectID*, char*, Boolean*, Boolean*, InternalItem*);
 Four edubtm_InsertInternal(ObjectID*, BtreeInternal*, InternalItem*, Two, Boolean*, InternalItem*);
+void edubtm_InsertInternalEntry(BtreeInternal*, Two, InternalItem*);
+Four edubtm_InsertBatch(ObjectID*, PageID*, KeyDesc*, BtreeBatchItem*, Four*, Four, InternalItem**, Four*);
+Four edubtm_InsertBatchInternal(ObjectID*, PageID*, BtreeInternal*, KeyDesc*, InternalItem*, Four, InternalItem**, Four*);
+void edubtm_InsertLeafEntry(BtreeLeaf*, Two, LeafItem*);
+Four edubtm_IndexJoin(PageID*, KeyDesc*, BtreeBatchItem*, Four*, Four, BtreeJoinPair*, Four*);
+Two edubtm_KeyPartsLength(KeyDesc*, KeyValue*, Two);
 Four edubtm_FirstObject(PageID*, KeyDesc*, KeyValue*, Four, BtreeCursor*);
+Four edubtm_FreePage(PageID*, Pool*, DeallocListElem*);
 Four edubtm_FreePages(PhysicalFileID*, PageID*, Pool*, DeallocListElem*);
+Four edubtm_GetTrain(PageID*, char**, Four);
 Four edubtm_InitInternal(PageID*, Boolean, Boolean);
+void edubtm_InitMsgBuffer(BtreeInternal*);
 Four edubtm_InitLeaf(PageID*, Boolean, Boolean);
+Four edubtm_BufferedLookup(PageID*, KeyDesc*, KeyValue*, Boolean*, ObjectID*);
+Four edubtm_BufferedNext(PageID*, KeyDesc*, KeyValue*, Boolean, Boolean*, KeyValue*, ObjectID*);
 Four edubtm_LastObject(PageID*, KeyDesc*, KeyValue*, Four, BtreeCursor*);
+Four edubtm_MergeJoin(KeyDesc*, KeyDesc*, KeyValue*, Four, BtreeJoinCursor*, BtreeJoinPair*, Four, Four*);
+void edubtm_MoveInternalEntries(BtreeInternal*, Two, Two, BtreeInternal*, Two);
+void edubtm_MoveLeafEntries(BtreeLeaf*, Two, Two, BtreeLeaf*, Two);
+Four edubtm_PushMessage(ObjectID*, PageID*, KeyDesc*, Two, KeyValue*, ObjectID*, Boolean*, Boolean*, InternalItem*, Pool*, DeallocListElem*);
+Four edubtm_PutMessage(ObjectID*, PageID*, KeyDesc*, Two, KeyValue*, ObjectID*, Pool*, DeallocListElem*);
+Four edubtm_RangeLinkLeaves(PageID*, KeyDesc*, KeyValue*, KeyValue*);
+Four edubtm_RangeRepair(ObjectID*, PageID*, KeyDesc*, KeyValue*, Boolean, Boolean*, Boolean*, InternalItem*, Pool*, DeallocListElem*);
+Two edubtm_PrefixBound(char*, Two*, Two, Two, KeyDesc*, KeyValue*, Boolean);
+Four edubtm_RelocateLeaf(ObjectID*, PageID*, KeyDesc*, BtreeReorgCursor*, Pool*, DeallocListElem*);
+void edubtm_RemoveInternalEntries(BtreeInternal*, Two, Two);
+void edubtm_RemoveLeafEntries(BtreeLeaf*, Two, Two);
+Four edubtm_ReorgMerge(ObjectID*, PageID*, KeyDesc*, KeyValue*, Boolean*, Boolean*, Boolean*, InternalItem*, Pool*, DeallocListElem*);
+Four edubtm_ReorgNext(PageID*, KeyDesc*, KeyValue*, Boolean*);
+Four edubtm_ReorgStart(PageID*, BtreeReorgCursor*);
 Four edubtm_SplitInternal(ObjectID*, BtreeInternal*, Two, InternalItem*, InternalItem*);
 Four edubtm_SplitLeaf(ObjectID*, PageID*, BtreeLeaf*, Two, LeafItem*, InternalItem*);
+Four edubtm_SeekPrefix(PageID*, KeyDesc*, KeyValue*, Four, BtreeCursor*);
+Four edubtm_SnapshotFirst(Four);
+Four edubtm_SnapshotLast(Four);
+Four edubtm_SnapshotNext(Four, Four);
+Four edubtm_SnapshotPrev(Four, Four);
+Four edubtm_SnapshotSearch(BtreeSnapshot*, KeyValue*, Boolean);
+void edubtm_SnapshotSetCursor(BtreeSnapshot*, Four, KeyValue*, Four, BtreeSnapshotCursor*);
+void edubtm_SortBatch(KeyDesc*, BtreeBatchItem*, Four*, Four*, Four);
+Four edubtm_SplitMessages(BtreeInternal*, KeyDesc*, InternalItem*);
+Four edubtm_TopCacheBuild(btm_TopCache*);
+void edubtm_TopCacheDrop(PageID*);
+btm_TopCache *edubtm_TopCacheFind(PageID*);
+void edubtm_TopCacheFree(btm_TopCache*);
+void edubtm_TopCacheInvalidate(PageID*);
+Four edubtm_TopCacheSearch(PageID*, KeyValue*, PageID*);
+void edubtm_TraceBegin(Four);
+void edubtm_TraceEnd(Four);
+Four edubtm_TraceFix(PageID*, char**, Four);
+Four edubtm_Underflow(ObjectID*, BtreeInternal*, PageID*, Two, Boolean*, Boolean*, InternalItem*, Pool*, DeallocListElem*);
 Four edubtm_get_objectid_from_leaf(BtreeCursor*);
 Four edubtm_root_insert(ObjectID*, PageID*, InternalItem*);
 
@@ -321,17 +609,43 @@ Four btm_get_objectid_from_overflow(BtreeCursor*);
 Four btm_root_delete(PhysicalFileID*, PageID*, Pool*, DeallocListElem*);
 Four btm_IsTemporary(ObjectID*, Boolean*);
 
+Four bfm_LookUp(PageID*, Four);
+
 
 /*
  * B+tree Manager Interface function prototypes
  */
 /*
 Four EduBtM_CreateIndex(ObjectID*, PageID*);
+Four EduBtM_CreateCoveringIndex(ObjectID*, PageID*, Two);
+Four EduBtM_CreatePackedIndex(ObjectID*, PageID*);
 Four EduBtM_DeleteObject(ObjectID*, PageID*, KeyDesc*, KeyValue*, ObjectID*, Pool*, DeallocListElem*);
+Four EduBtM_DeleteRange(ObjectID*, PageID*, KeyDesc*, KeyValue*, Four, KeyValue*, Four, Pool*, DeallocListElem*);
 Four EduBtM_DropIndex(PhysicalFileID*, PageID*, Pool*, DeallocListElem*);
 Four EduBtM_Fetch(PageID*, KeyDesc*, KeyValue*, Four, KeyValue*, Four, BtreeCursor*);
 Four EduBtM_FetchNext(PageID*, KeyDesc*, KeyValue*, Four, BtreeCursor*, BtreeCursor*);
+Four EduBtM_FetchPrefix(PageID*, KeyDesc*, Two, KeyValue*, Four, KeyValue*, Four, BtreeCursor*);
+Four EduBtM_FetchNextPrefix(PageID*, KeyDesc*, Two, KeyValue*, Four, BtreeCursor*, BtreeCursor*);
 Four EduBtM_InsertObject(ObjectID*, PageID*, KeyDesc*, KeyValue*, ObjectID*, Pool*, DeallocListElem*);
+Four EduBtM_InsertCovering(ObjectID*, PageID*, KeyDesc*, KeyValue*, ObjectID*, char*, Pool*, DeallocListElem*);
+Four EduBtM_InsertBatch(ObjectID*, PageID*, KeyDesc*, BtreeBatchItem*, Four, Pool*, DeallocListElem*);
+Four EduBtM_IndexJoin(PageID*, KeyDesc*, BtreeBatchItem*, Four, BtreeJoinPair*, Four*);
+Four EduBtM_MergeJoin(PageID*, KeyDesc*, PageID*, KeyDesc*, KeyValue*, Four, KeyValue*, Four, BtreeJoinCursor*, BtreeJoinPair*, Four, Four*);
+Four EduBtM_Reorganize(ObjectID*, PageID*, KeyDesc*, BtreeReorgCursor*, Four, Pool*, DeallocListElem*);
+Four EduBtM_GetStats(PageID*, KeyDesc*, BtreeStats*);
+Four EduBtM_SkipScan(PageID*, KeyDesc*, Two, KeyValue*, Four, KeyValue*, Four, BtreeCursor*);
+Four EduBtM_SkipScanNext(PageID*, KeyDesc*, Two, KeyValue*, Four, KeyValue*, Four, BtreeCursor*, BtreeCursor*);
+Four EduBtM_ExportSnapshot(PageID*, KeyDesc*, char*);
+Four EduBtM_OpenSnapshot(char*, BtreeSnapshot*);
+Four EduBtM_CloseSnapshot(BtreeSnapshot*);
+Four EduBtM_SnapshotFetch(BtreeSnapshot*, KeyValue*, Four, KeyValue*, Four, BtreeSnapshotCursor*);
+Four EduBtM_SnapshotFetchNext(BtreeSnapshot*, KeyValue*, Four, BtreeSnapshotCursor*, BtreeSnapshotCursor*);
+Four EduBtM_CacheTopLevels(PageID*, KeyDesc*, Four);
+Four EduBtM_UncacheTopLevels(PageID*);
+Four EduBtM_StartTrace(FILE*, Four);
+Four EduBtM_StopTrace(void);
+Four EduBtM_GetTrace(BtreeTrace*);
+Four EduBtM_DumpTrace(FILE*);
 */
 
 
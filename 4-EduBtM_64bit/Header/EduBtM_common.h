@@ -37,6 +37,9 @@
 /* Btree Maximum Key Length */
 #define MAXKEYLEN  256
 
+/* Btree Maximum Length of the Included Columns */
+#define MAXINCLUDEDLEN 64
+
 /* Btree Maximum Number of Key Parts */
 #define MAXNUMKEYPARTS 8
 
@@ -330,6 +333,22 @@ typedef struct {
 } KeyDesc;
 
 #define KEYFLAG_UNIQUE 0x1
+#define KEYFLAG_BUFFERED 0x2  /* buffer updates in the internal pages (B-epsilon) */
+#define KEYFLAG_INTERPOLATE 0x4  /* interpolation search in the pages of an SM_INT key */
+#define KEYFLAG_MERGEQUARTER 0x8  /* merge a page after a deletion when less than a quarter full */
+#define KEYFLAG_FREEEMPTY 0x10  /* merge a page after a deletion only when it becomes empty */
+
+/* a pair of a key value and an ObjectID given to EduBtM_InsertBatch() */
+typedef struct {
+	KeyValue    kval;                   /* key value */
+	ObjectID    oid;                    /* ObjectID to insert with 'kval' */
+} BtreeBatchItem;
+
+/* a pair of ObjectIDs returned by EduBtM_IndexJoin() and EduBtM_MergeJoin() */
+typedef struct {
+	ObjectID    outer;                  /* ObjectID of the outer row */
+	ObjectID    inner;                  /* ObjectID of the matching entry of the inner index */
+} BtreeJoinPair;
 
 
 /* BtreeCursor:
@@ -343,6 +362,8 @@ typedef struct {
 	PageID   overflow;      /* which overflow page? */
 	Two      slotNo;        /* which slot? */
 	Two      oidArrayElemNo;    /* which element of the object array? */
+	Two      includedLen;   /* length of the included columns */
+	char     included[MAXINCLUDEDLEN]; /* included columns of the entry */
 } BtreeCursor;
 
 /* values of 'flag' field; cursor status */
@@ -351,6 +372,119 @@ typedef struct {
 #define CURSOR_EOS     3    /* end of scan */
 
 
+/* BtreeJoinCursor:
+ *  merge join of two B+ trees; 'flag' takes the values of BtreeCursor and
+ *  is set to CURSOR_INVALID by the caller before the first call
+ */
+typedef struct {
+	One      flag;      /* state of the join */
+	PageID   leaf[2];   /* current leaves of the outer and the inner index */
+	Two      slotNo[2]; /* current entries of the two leaves */
+} BtreeJoinCursor;
+
+
+/* BtreeReorgCursor:
+ *  state of an incremental reorganization of a B+ tree
+ */
+typedef struct {
+	One      phase;     /* phase of the reorganization */
+	KeyValue key;       /* the first key of the leaf to visit next */
+	PageID   last;      /* the leaf visited last in REORG_RELOCATE */
+} BtreeReorgCursor;
+
+/* values of 'phase' field */
+#define REORG_BEGIN    0    /* not started; set by the caller */
+#define REORG_MERGE    1    /* merging the underfull pages */
+#define REORG_RELOCATE 2    /* rewriting the leaves in key order */
+#define REORG_DONE     3    /* finished */
+
+
+/* BtreeStats:
+ *  statistics of a B+ tree; the level 0 is the root
+ */
+#define BTM_STATS_MAXLEVELS 16      /* maximum height reported */
+#define BTM_STATS_NBUCKETS  10      /* # of buckets of the key histogram */
+#define BTM_STATS_NSAMPLES  100     /* # of sampled descents */
+
+typedef struct {
+	Two      height;                            /* # of levels */
+	Four     nPages[BTM_STATS_MAXLEVELS];       /* # of pages of each level */
+	double   avgFill[BTM_STATS_MAXLEVELS];      /* average used fraction of the pages of each level */
+	double   minFill[BTM_STATS_MAXLEVELS];      /* minimum used fraction */
+	double   maxFill[BTM_STATS_MAXLEVELS];      /* maximum used fraction */
+	Four     nOverflowPages;                    /* estimated # of overflow pages */
+	Four     nObjects;                          /* estimated # of ObjectIDs */
+	Four     nDistinctKeys;                     /* estimated # of distinct keys */
+	Two      nBuckets;                          /* # of buckets of the histogram */
+	KeyValue bound[BTM_STATS_NBUCKETS];         /* the largest key of each bucket */
+	Four     depth[BTM_STATS_NBUCKETS];         /* estimated # of keys in each bucket */
+} BtreeStats;
+
+
+/* BtreeTrace:
+ *  counters collected while the tracing is on; the level 0 is the root
+ */
+#define BTM_TRACE_FETCH        0    /* EduBtM_Fetch() */
+#define BTM_TRACE_FETCHNEXT    1    /* EduBtM_FetchNext() */
+#define BTM_TRACE_INSERT       2    /* EduBtM_InsertObject()/EduBtM_InsertCovering() */
+#define BTM_TRACE_DELETE       3    /* EduBtM_DeleteObject() */
+#define BTM_TRACE_NOPS         4    /* # of the traced operations */
+#define BTM_TRACE_NBUCKETS     32   /* the bucket i holds the latencies in [2^i, 2^(i+1)) ns */
+#define BTM_TRACE_SAMPLEPERIOD 16   /* the latency of every 16th operation is measured */
+
+typedef struct {
+	Eight    nOps[BTM_TRACE_NOPS];              /* # of the operations started */
+	Eight    nFixes[BTM_TRACE_NOPS];            /* # of the pages fixed by the operations */
+	Eight    nComparisons[BTM_TRACE_NOPS];      /* # of the keys compared by the searches in the pages */
+	Eight    nHits[BTM_STATS_MAXLEVELS];        /* # of the fixes of each level found in the buffer */
+	Eight    nMisses[BTM_STATS_MAXLEVELS];      /* # of the fixes of each level read from the disk */
+	Eight    nOtherHits;                        /* the fixes of the overflow pages, the catalog, ... */
+	Eight    nOtherMisses;
+	Eight    nLeafSplits;                       /* # of the leaves splitted */
+	Eight    nInternalSplits;                   /* # of the internal pages splitted */
+	Eight    nMerges;                           /* # of the pages merged into their siblings */
+	Eight    nRedistributions;                  /* # of the redistributions between siblings */
+	Eight    nSampled[BTM_TRACE_NOPS];          /* # of the operations whose latencies are measured */
+	Eight    latency[BTM_TRACE_NOPS][BTM_TRACE_NBUCKETS];  /* histograms of the sampled latencies */
+} BtreeTrace;
+
+
+/* BtreeSnapshot:
+ *  a read-only snapshot of a B+ tree in a file mapped into the memory;
+ *  the first page holds the header and the entries follow it from the
+ *  next page in the Eytzinger (breadth-first) order of the sorted keys
+ */
+#define BTM_SNAPSHOT_MAGIC   0x53544245  /* "EBTS" */
+#define BTM_SNAPSHOT_VERSION 1
+
+typedef struct {
+	Four     magic;                 /* BTM_SNAPSHOT_MAGIC */
+	Four     version;               /* BTM_SNAPSHOT_VERSION */
+	Four     nEntries;              /* # of entries */
+	Four     entrySize;             /* size of an entry */
+	Two      includedLen;           /* length of the included columns of each entry */
+	KeyDesc  kdesc;                 /* key descriptor of the index */
+} BtreeSnapshotHdr;
+
+typedef struct {
+	BtreeSnapshotHdr *hdr;          /* the mapped file */
+	char     *entries;              /* the entries; the first one is numbered 1 */
+	Four     size;                  /* size of the mapped file */
+} BtreeSnapshot;
+
+/* BtreeSnapshotCursor:
+ *  scan using a B+ tree snapshot; 'flag' takes the values of BtreeCursor
+ */
+typedef struct {
+	One      flag;      /* state of the cursor */
+	Four     pos;       /* entry No. in the Eytzinger order */
+	ObjectID oid;       /* object pointed by the cursor */
+	KeyValue key;       /* what key value? */
+	Two      includedLen;   /* length of the included columns */
+	char     included[MAXINCLUDEDLEN]; /* included columns of the entry */
+} BtreeSnapshotCursor;
+
+
 /*
  * Main Memory Data Structure of Scan Manager Catalog Table SM_SYSTABLES
  */
@@ -56,3 +56,11 @@
 #define eBADCACHETREELATCHCELLPTR_BTM            ERR_ENCODE_ERROR_CODE(BTM_ERR_BASE,12)
 #define NUM_ERRORS_BTM_ERR_BASE                  13
 #define eNOTSUPPORTED_EDUBTM                     ERR_ENCODE_ERROR_CODE(BTM_ERR_BASE,14)
+#define eMEMORYALLOCERR_BTM                      ERR_ENCODE_ERROR_CODE(BTM_ERR_BASE,15)
+#define eNOFREEWRITEBUFFER_BTM                   ERR_ENCODE_ERROR_CODE(BTM_ERR_BASE,16)
+#define eTOOMANYRUNS_BTM                         ERR_ENCODE_ERROR_CODE(BTM_ERR_BASE,17)
+#define eSNAPSHOTIO_BTM                          ERR_ENCODE_ERROR_CODE(BTM_ERR_BASE,18)
+#define eBADSNAPSHOT_BTM                         ERR_ENCODE_ERROR_CODE(BTM_ERR_BASE,19)
+#define eTOOMANYTOPCACHES_BTM                    ERR_ENCODE_ERROR_CODE(BTM_ERR_BASE,20)
+#define eTOOMANYPARTITIONEDINDEXES_BTM           ERR_ENCODE_ERROR_CODE(BTM_ERR_BASE,21)
+#define eTOOMANYPARTITIONS_BTM                   ERR_ENCODE_ERROR_CODE(BTM_ERR_BASE,22)
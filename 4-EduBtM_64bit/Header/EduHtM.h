@@ -0,0 +1,46 @@
+/******************************************************************************/
+/*                                                                            */
+/*    ODYSSEUS/EduCOSMOS Educational-Purpose Object Storage System            */
+/*                                                                            */
+/*    Developed by Professor Kyu-Young Whang et al.                           */
+/*                                                                            */
+/*    Database and Multimedia Laboratory                                      */
+/*                                                                            */
+/*    Computer Science Department and                                         */
+/*    Advanced Information Technology Research Center (AITrc)                 */
+/*    Korea Advanced Institute of Science and Technology (KAIST)              */
+/*                                                                            */
+/*    e-mail: kywhang@cs.kaist.ac.kr                                          */
+/*    phone: +82-42-350-7722                                                  */
+/*    fax: +82-42-350-8380                                                    */
+/*                                                                            */
+/*    Copyright (c) 1995-2013 by Kyu-Young Whang                              */
+/*                                                                            */
+/*    All rights reserved. No part of this software may be reproduced,        */
+/*    stored in a retrieval system, or transmitted, in any form or by any     */
+/*    means, electronic, mechanical, photocopying, recording, or otherwise,   */
+/*    without prior written permission of the copyright owner.                */
+/*                                                                            */
+/******************************************************************************/
+#ifndef _EDUHTM_H_
+#define _EDUHTM_H_
+
+
+#include "EduHtM_Internal.h"
+#include "Util_pool.h"
+
+
+
+/*@
+ * Function Prototypes
+ */
+/* Interface Function Prototypes */
+Four EduHtM_CreateIndex(ObjectID*, PageID*);
+Four EduHtM_DeleteObject(ObjectID*, PageID*, KeyDesc*, KeyValue*, ObjectID*, Pool*, DeallocListElem*);
+Four EduHtM_DropIndex(PhysicalFileID*, PageID*, Pool*, DeallocListElem*);
+Four EduHtM_Fetch(PageID*, KeyDesc*, KeyValue*, Four, BtreeCursor*);
+Four EduHtM_FetchNext(PageID*, KeyDesc*, KeyValue*, BtreeCursor*, BtreeCursor*);
+Four EduHtM_InsertObject(ObjectID*, PageID*, KeyDesc*, KeyValue*, ObjectID*, Pool*, DeallocListElem*);
+
+
+#endif /* _EDUHTM_H_ */
@@ -0,0 +1,209 @@
+/******************************************************************************/
+/*                                                                            */
+/*    ODYSSEUS/EduCOSMOS Educational-Purpose Object Storage System            */
+/*                                                                            */
+/*    Developed by Professor Kyu-Young Whang et al.                           */
+/*                                                                            */
+/*    Database and Multimedia Laboratory                                      */
+/*                                                                            */
+/*    Computer Science Department and                                         */
+/*    Advanced Information Technology Research Center (AITrc)                 */
+/*    Korea Advanced Institute of Science and Technology (KAIST)              */
+/*                                                                            */
+/*    e-mail: kywhang@cs.kaist.ac.kr                                          */
+/*    phone: +82-42-350-7722                                                  */
+/*    fax: +82-42-350-8380                                                    */
+/*                                                                            */
+/*    Copyright (c) 1995-2013 by Kyu-Young Whang                              */
+/*                                                                            */
+/*    All rights reserved. No part of this software may be reproduced,        */
+/*    stored in a retrieval system, or transmitted, in any form or by any     */
+/*    means, electronic, mechanical, photocopying, recording, or otherwise,   */
+/*    without prior written permission of the copyright owner.                */
+/*                                                                            */
+/******************************************************************************/
+#ifndef _EDUHTM_INTERNAL_H_
+#define _EDUHTM_INTERNAL_H_
+
+
+#include "EduBtM_Internal.h"
+#include "Util_pool.h"
+
+
+/*@
+ * Constant Definitions
+ */
+/*
+ * Hash page type
+ *  A hash index uses the page type flags of the B+ tree combined with HASH;
+ *  HASH|ROOT is the meta page, HASH|INTERNAL is a directory page,
+ *  HASH|LEAF is a primary bucket and HASH|OVERFLOW is an overflow bucket.
+ *  HASH is defined with the other page type flags in EduBtM_Internal.h.
+ */
+
+#define HTM_MAXOPENINDEXES  16      /* # of indexes whose directories are kept in memory */
+#define HTM_MINDIRSIZE      64      /* # of buckets first allocated for a directory in memory */
+
+
+/*@
+ * Type Definitions
+ */
+/*********************************************************
+ * The structure of Hash Pages - Meta / Directory / Bucket *
+ *********************************************************/
+
+/*
+ * HashMeta Page:
+ *  Root page of a linear hashing index. Like the root of a B+ tree it is
+ *  never moved, so its PageID identifies the index. The PageIDs of the
+ *  first HM_NDIRECT buckets are kept in the meta page itself; the rest are
+ *  kept in directory pages whose PageIDs are stored in 'dirPage'.
+ */
+typedef struct {
+	PageID pid;                 /* page id of this page, should be located on the beginning */
+	Four flags;                 /* flag to store page information */
+	Four reserved;              /* reserved space to store page information */
+	One    type;                /* HASH|ROOT */
+	Two    level;               /* current round of the linear hashing */
+	Four   next;                /* next bucket to be splitted in this round */
+	Four   nBuckets;            /* # of buckets; (1 << level) + next */
+	Four   nEntries;            /* # of entries in the index */
+	Two    nDirPages;           /* # of directory pages */
+} HashMetaHdr;
+
+#define HM_FIXED        (sizeof(HashMetaHdr))
+#define HM_MAXDIRPAGES  64
+#define HM_NDIRECT      ((CONSTANT_CASTING_TYPE)((PAGESIZE-HM_FIXED)/sizeof(ShortPageID) - HM_MAXDIRPAGES))
+
+typedef struct {   /* Meta page */
+	HashMetaHdr hdr;                    /* header of the meta page */
+	ShortPageID dirPage[HM_MAXDIRPAGES];/* directory pages */
+	ShortPageID bucket[HM_NDIRECT];     /* the first buckets */
+} HashMeta;
+
+
+/*
+ * HashDir Page:
+ *  Page holding the PageIDs of HD_MAXBUCKETS consecutive buckets.
+ */
+typedef struct {
+	PageID pid;                 /* page id of this page, should be located on the beginning */
+	Four flags;                 /* flag to store page information */
+	Four reserved;              /* reserved space to store page information */
+	One    type;                /* HASH|INTERNAL */
+} HashDirHdr;
+
+#define HD_FIXED        (sizeof(HashDirHdr))
+#define HD_MAXBUCKETS   ((CONSTANT_CASTING_TYPE)((PAGESIZE-HD_FIXED)/sizeof(ShortPageID)))
+
+typedef struct {   /* Directory page */
+	HashDirHdr  hdr;                    /* header of the directory page */
+	ShortPageID bucket[HD_MAXBUCKETS];  /* buckets */
+} HashDir;
+
+/* Maximum # of buckets */
+#define HTM_MAXBUCKETS  (HM_NDIRECT + HM_MAXDIRPAGES*HD_MAXBUCKETS)
+
+
+/*
+ * HashBucket Page:
+ *  Primary or overflow page of a bucket. Entries are stored contiguously
+ *  from the beginning of the data area; there is no slot array since a
+ *  bucket is always scanned sequentially.
+ */
+typedef struct {
+	PageID pid;                 /* page id of this page, should be located on the beginning */
+	Four flags;                 /* flag to store page information */
+	Four reserved;              /* reserved space to store page information */
+	One     type;               /* HASH|LEAF or HASH|OVERFLOW */
+	Two     nEntries;           /* # of entries in this page */
+	Two     free;               /* starting point of the free space */
+	ShortPageID nextPage;       /* next overflow page of the bucket */
+} HashBucketHdr;
+
+#define HB_FIXED  (sizeof(HashBucketHdr))
+
+typedef struct {   /* Bucket page */
+	HashBucketHdr hdr;                  /* header of the bucket page */
+	char          data[PAGESIZE-HB_FIXED]; /* data area */
+} HashBucket;
+
+/* Macro: HB_FREE(p)
+ * Description: return the size of free area of the bucket page given as a parameter
+ * Parameter:
+ *  HashBucket *p      : pointer to the bucket page
+ * Returns: (Four) size of free area
+ */
+#define HB_FREE(p)    (PAGESIZE - HB_FIXED - (p)->hdr.free)
+
+
+/*
+ * HashPage:
+ *  Page type contains all page types of a hash index
+ */
+typedef union {
+	BtreeAny      any;      /* any page */
+	HashMeta      hm;       /* meta page */
+	HashDir       hd;       /* directory page */
+	HashBucket    hb;       /* bucket page */
+} HashPage;
+
+
+/*
+ * HtmDirectory:
+ *  Copy in memory of the directory of a hash index: the header of the
+ *  meta page, whose 'pid' identifies the index, and the primary pages of
+ *  all the buckets.
+ */
+typedef struct {
+	HashMetaHdr hdr;            /* header of the meta page */
+	Boolean     used;           /* FALSE if the entry is free */
+	Four        size;           /* # of allocated elements of 'bucket' */
+	ShortPageID *bucket;        /* primary pages of the buckets */
+} HtmDirectory;
+
+
+/* Data type of Bucket Entry */
+typedef struct {
+	UFour hash;         /* hash value of the key */
+	/* 'klen' and 'kval' should be attached in this order */
+	/* to cast this variables the type KeyValue. */
+	Two  klen;          /* key length */
+	char kval[1];       /* key value and ObjectID */
+} htm_Entry;
+
+#define HTM_ENTRY_FIXED OFFSET_OF(htm_Entry, kval[0])
+
+/* Macro: HTM_ENTRY_LEN(klen)
+ * Description: return the length of a bucket entry having the given key length
+ * Parameter:
+ *  Two klen      : key length
+ * Returns: (Four) aligned length of the entry
+ */
+#define HTM_ENTRY_LEN(klen) \
+	((CONSTANT_CASTING_TYPE)ALIGNED_LENGTH(HTM_ENTRY_FIXED + ALIGNED_LENGTH(klen) + OBJECTID_SIZE))
+
+
+/*@
+ * Function Prototypes
+ */
+/*
+** Hash Index Manager Internal function prototypes
+*/
+UFour eduhtm_Hash(KeyDesc*, KeyValue*);
+Four eduhtm_BucketNo(HashMetaHdr*, UFour);
+Four eduhtm_GetBucket(HashMeta*, Four, PageID*);
+Four eduhtm_SetBucket(ObjectID*, HashMeta*, Four, PageID*);
+Four eduhtm_GetDirectory(PageID*, HtmDirectory**);
+void eduhtm_DiscardDirectory(PageID*);
+Four eduhtm_UpdateDirectory(HashMeta*, Four, PageID*);
+Four eduhtm_InitBucket(PageID*, Boolean);
+Boolean eduhtm_SearchBucket(HashBucket*, KeyDesc*, KeyValue*, UFour, ObjectID*, Two*);
+Four eduhtm_AppendEntry(ObjectID*, PageID*, UFour, KeyValue*, ObjectID*, Boolean*);
+void eduhtm_RemoveEntry(HashBucket*, Two);
+Four eduhtm_SplitBucket(ObjectID*, HashMeta*, Pool*, DeallocListElem*);
+Four eduhtm_FreeChain(PageID*, Pool*, DeallocListElem*);
+Four eduhtm_FreePage(PageID*, Pool*, DeallocListElem*);
+
+
+#endif /* _EDUHTM_INTERNAL_H_ */
@@ -0,0 +1,193 @@
+/******************************************************************************/
+/*                                                                            */
+/*    ODYSSEUS/EduCOSMOS Educational-Purpose Object Storage System            */
+/*                                                                            */
+/*    Developed by Professor Kyu-Young Whang et al.                           */
+/*                                                                            */
+/*    Database and Multimedia Laboratory                                      */
+/*                                                                            */
+/*    Computer Science Department and                                         */
+/*    Advanced Information Technology Research Center (AITrc)                 */
+/*    Korea Advanced Institute of Science and Technology (KAIST)              */
+/*                                                                            */
+/*    e-mail: kywhang@cs.kaist.ac.kr                                          */
+/*    phone: +82-42-350-7722                                                  */
+/*    fax: +82-42-350-8380                                                    */
+/*                                                                            */
+/*    Copyright (c) 1995-2013 by Kyu-Young Whang                              */
+/*                                                                            */
+/*    All rights reserved. No part of this software may be reproduced,        */
+/*    stored in a retrieval system, or transmitted, in any form or by any     */
+/*    means, electronic, mechanical, photocopying, recording, or otherwise,   */
+/*    without prior written permission of the copyright owner.                */
+/*                                                                            */
+/******************************************************************************/
+#ifndef _EDULSM_INTERNAL_H_
+#define _EDULSM_INTERNAL_H_
+
+
+#include "EduBtM_Internal.h"
+#include "Util_pool.h"
+
+
+/*@
+ * Constant Definitions
+ */
+/*
+ * LSM page type
+ *  An LSM index uses the page type flags of the B+ tree combined with LSM;
+ *  LSM|ROOT is the meta page, LSM|INTERNAL is a fence page of a run,
+ *  LSM|LEAF is a leaf of a run and LSM|OVERFLOW is the filter of a run.
+ *  LSM is defined with the other page type flags in EduBtM_Internal.h.
+ */
+
+#define LSM_BUFFERENTRIES   2048    /* # of entries of the write buffer */
+#define LSM_MAXOPENINDEXES  16      /* # of indexes which may have a write buffer */
+#define LSM_MAXRUNS         32      /* maximum # of runs of an index */
+#define LSM_TIERFANOUT      4       /* # of runs of a tier which are merged */
+#define LSM_MAXHEIGHT       8       /* maximum height of a run */
+#define LSM_NHASHES         3       /* # of bits set in the filter for a key */
+
+/* value of 'nObjects' of an entry */
+#define LSM_DELETE  0               /* the entry deletes the pair (tombstone) */
+#define LSM_INSERT  1               /* the entry inserts the pair */
+
+/* seek modes of a run or the write buffer */
+#define LSM_SEEK_FIRST  0           /* the first entry */
+#define LSM_SEEK_GE     1           /* the first entry whose key >= kval */
+#define LSM_SEEK_GT     2           /* the first entry whose key > kval */
+#define LSM_SEEK_AFTER  3           /* the first entry whose (key, oid) > (kval, oid) */
+
+
+/*@
+ * Type Definitions
+ */
+/*************************************************
+ * The structure of LSM Pages - Meta / Filter    *
+ * (fence pages and leaves are BtreeInternal and *
+ *  BtreeLeaf pages)                             *
+ *************************************************/
+
+/*
+ * LsmRun:
+ *  An immutable sorted run. A run is a B+ tree built bottom-up with fully
+ *  packed pages; the internal pages are the fence pointers of the leaves.
+ *  Every leaf entry holds one ObjectID and its 'nObjects' is LSM_INSERT or
+ *  LSM_DELETE. Entries are sorted by (key, ObjectID) and a pair appears at
+ *  most once in a run.
+ */
+typedef struct {
+	ShortPageID root;           /* root page of the run */
+	ShortPageID firstLeaf;      /* the leftmost leaf of the run */
+	ShortPageID filter;         /* filter page of the run */
+	Two         height;         /* # of levels; 1 if the root is a leaf */
+	Two         tier;           /* size tier of the run */
+	Four        nEntries;       /* # of entries of the run */
+	Four        nPages;         /* # of leaves and fence pages */
+} LsmRun;
+
+/*
+ * LsmMeta Page:
+ *  Root page of an LSM index. Its PageID identifies the index. The runs
+ *  are kept from the newest to the oldest.
+ */
+typedef struct {
+	PageID pid;                 /* page id of this page, should be located on the beginning */
+	Four flags;                 /* flag to store page information */
+	Four reserved;              /* reserved space to store page information */
+	One    type;                /* LSM|ROOT */
+	Two    nRuns;               /* # of runs */
+} LsmMetaHdr;
+
+typedef struct {   /* Meta page */
+	LsmMetaHdr  hdr;                    /* header of the meta page */
+	LsmRun      run[LSM_MAXRUNS];       /* runs from the newest */
+} LsmMeta;
+
+/*
+ * LsmFilter Page:
+ *  Bloom filter on the keys of a run.
+ */
+typedef struct {
+	PageID pid;                 /* page id of this page, should be located on the beginning */
+	Four flags;                 /* flag to store page information */
+	Four reserved;              /* reserved space to store page information */
+	One    type;                /* LSM|OVERFLOW */
+} LsmFilterHdr;
+
+#define LF_FIXED    (sizeof(LsmFilterHdr))
+#define LF_NBITS    ((CONSTANT_CASTING_TYPE)((PAGESIZE-LF_FIXED)*8))
+
+typedef struct {   /* Filter page */
+	LsmFilterHdr    hdr;                    /* header of the filter page */
+	unsigned char   bits[PAGESIZE-LF_FIXED];/* bit array */
+} LsmFilter;
+
+
+/* Data type for representing an entry of the write buffer or a run */
+typedef struct {
+	ObjectID oid;       /* an ObjectID */
+	Two nObjects;       /* LSM_INSERT or LSM_DELETE */
+	KeyValue key;       /* key value */
+} lsm_Item;
+
+/*
+ * LsmBuffer:
+ *  In-memory write buffer of an LSM index. The items are kept in a slab and
+ *  'order' keeps them sorted by (key, ObjectID). The buffer is written as a
+ *  new run when it becomes full or EduLsM_Flush() is called.
+ */
+typedef struct {
+	PageID      root;       /* meta page of the index */
+	Four        nItems;     /* # of items in the buffer */
+	lsm_Item    *item;      /* slab of the items; NULL if the buffer is not used */
+	lsm_Item    **order;    /* items sorted by (key, ObjectID) */
+} LsmBuffer;
+
+/* State of building a run bottom-up */
+typedef struct {
+	ObjectID    *catObj;                    /* catalog object of the index file */
+	PageID      near;                       /* pages are allocated near this page */
+	Two         height;                     /* # of levels built so far */
+	PageID      first[LSM_MAXHEIGHT];       /* the first page of each level */
+	PageID      page[LSM_MAXHEIGHT];        /* the current page of each level */
+	BtreePage   *apage[LSM_MAXHEIGHT];      /* buffers of the current pages */
+	PageID      filter;                     /* filter page */
+	LsmFilter   *fpage;                     /* buffer of the filter page */
+	Four        nEntries;                   /* # of entries appended */
+	Four        nPages;                     /* # of pages allocated */
+} lsm_RunBuilder;
+
+/* State of scanning the leaves of a run */
+typedef struct {
+	PageID      leaf;       /* current leaf; pageNo is NIL at the end */
+	BtreeLeaf   *page;      /* buffer of the current leaf */
+	Two         slotNo;     /* current slot */
+} lsm_RunScan;
+
+
+/*@
+ * Function Prototypes
+ */
+/*
+** LSM Index Manager Internal function prototypes
+*/
+Four edulsm_Compare(KeyDesc*, KeyValue*, ObjectID*, KeyValue*, ObjectID*);
+Boolean edulsm_Beyond(KeyDesc*, KeyValue*, ObjectID*, KeyValue*, ObjectID*, Four);
+Four edulsm_GetBuffer(PageID*, Boolean, LsmBuffer**);
+void edulsm_DiscardBuffer(PageID*);
+void edulsm_PutBuffer(LsmBuffer*, KeyDesc*, lsm_Item*);
+Boolean edulsm_SeekBuffer(LsmBuffer*, KeyDesc*, KeyValue*, ObjectID*, Four, lsm_Item*);
+Four edulsm_FlushBuffer(ObjectID*, PageID*, KeyDesc*, Pool*, DeallocListElem*);
+Four edulsm_BeginRun(ObjectID*, PageID*, lsm_RunBuilder*);
+Four edulsm_AppendRun(lsm_RunBuilder*, KeyDesc*, lsm_Item*);
+Four edulsm_EndRun(lsm_RunBuilder*, LsmRun*);
+Four edulsm_SeekRun(VolID, LsmRun*, KeyDesc*, KeyValue*, ObjectID*, Four, lsm_Item*, Boolean*);
+Four edulsm_MayContain(VolID, LsmRun*, KeyDesc*, KeyValue*, Boolean*);
+void edulsm_SetFilter(LsmFilter*, KeyDesc*, KeyValue*);
+Four edulsm_MergeRuns(ObjectID*, LsmMeta*, KeyDesc*, Pool*, DeallocListElem*);
+Four edulsm_FreeRun(VolID, LsmRun*, Pool*, DeallocListElem*);
+Four edulsm_Next(PageID*, KeyDesc*, KeyValue*, ObjectID*, Four, KeyValue*, Four, BtreeCursor*);
+
+
+#endif /* _EDULSM_INTERNAL_H_ */
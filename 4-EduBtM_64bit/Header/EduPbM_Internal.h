@@ -0,0 +1,87 @@
+/******************************************************************************/
+/*                                                                            */
+/*    ODYSSEUS/EduCOSMOS Educational-Purpose Object Storage System            */
+/*                                                                            */
+/*    Developed by Professor Kyu-Young Whang et al.                           */
+/*                                                                            */
+/*    Database and Multimedia Laboratory                                      */
+/*                                                                            */
+/*    Computer Science Department and                                         */
+/*    Advanced Information Technology Research Center (AITrc)                 */
+/*    Korea Advanced Institute of Science and Technology (KAIST)              */
+/*                                                                            */
+/*    e-mail: kywhang@cs.kaist.ac.kr                                          */
+/*    phone: +82-42-350-7722                                                  */
+/*    fax: +82-42-350-8380                                                    */
+/*                                                                            */
+/*    Copyright (c) 1995-2013 by Kyu-Young Whang                              */
+/*                                                                            */
+/*    All rights reserved. No part of this software may be reproduced,        */
+/*    stored in a retrieval system, or transmitted, in any form or by any     */
+/*    means, electronic, mechanical, photocopying, recording, or otherwise,   */
+/*    without prior written permission of the copyright owner.                */
+/*                                                                            */
+/******************************************************************************/
+#ifndef _EDUPBM_INTERNAL_H_
+#define _EDUPBM_INTERNAL_H_
+
+
+#include "EduBtM_Internal.h"
+
+
+/*@
+ * Constant Definitions
+ */
+/*
+ * A partitioned B+ tree is one B+ tree whose keys are prefixed by a hidden
+ * SM_INT partition number. The partitions are numbered in the order of
+ * their creation; the insertions go to the newest one, and the older ones
+ * are merged into the oldest one by EduPbM_Merge().
+ */
+#define PBM_PARTITIONENTRIES    4096    /* # of entries after which the insertions start a new partition */
+#define PBM_MAXPARTITIONS       32      /* maximum # of partitions of an index */
+#define PBM_MAXOPENINDEXES      16      /* # of indexes whose partitions are kept in memory */
+#define PBM_MERGEBATCH          256     /* # of entries moved at once by a merge */
+
+/* the partition number prefix of a key */
+#define PBM_PREFIXLEN           ((CONSTANT_CASTING_TYPE)sizeof(Four_Invariable))
+
+
+/*@
+ * Type Definitions
+ */
+/*
+ * PbmPartitions:
+ *  The live partitions of a partitioned B+ tree. They are not stored in the
+ *  index but found from its keys when the index is first used, so all the
+ *  partitions live in the B+ tree of the index file and its catalog entry.
+ */
+typedef struct {
+	PageID      root;                           /* root page of the index */
+	Boolean     used;                           /* FALSE if the entry is free */
+	Boolean     sealed;                         /* TRUE if the next insertion starts a new partition */
+	Two         nPartitions;                    /* # of the live partitions */
+	Four        partition[PBM_MAXPARTITIONS];   /* the partition numbers, the oldest first */
+	Four        nNewest;                        /* # of the entries of the newest partition */
+} PbmPartitions;
+
+
+/*@
+ * Function Prototypes
+ */
+/*
+** Partitioned B+ tree Index Manager Internal function prototypes
+*/
+Four edupbm_KeyDesc(KeyDesc*, KeyDesc*);
+Four edupbm_MakeKey(KeyDesc*, Four, KeyValue*, KeyValue*);
+void edupbm_UserKey(KeyValue*, KeyValue*);
+Four edupbm_KeyPartition(KeyValue*);
+Four edupbm_GetPartitions(PageID*, KeyDesc*, PbmPartitions**);
+void edupbm_DiscardPartitions(PageID*);
+Four edupbm_AddPartition(PbmPartitions*);
+void edupbm_RemovePartition(PbmPartitions*, Two);
+Four edupbm_FetchPartition(PageID*, KeyDesc*, Four, KeyValue*, Four, KeyValue*, Four, BtreeCursor*);
+Four edupbm_Next(PageID*, KeyDesc*, PbmPartitions*, KeyValue*, Four, KeyValue*, Four, BtreeCursor*);
+
+
+#endif /* _EDUPBM_INTERNAL_H_ */
@@ -0,0 +1,46 @@
+/******************************************************************************/
+/*                                                                            */
+/*    ODYSSEUS/EduCOSMOS Educational-Purpose Object Storage System            */
+/*                                                                            */
+/*    Developed by Professor Kyu-Young Whang et al.                           */
+/*                                                                            */
+/*    Database and Multimedia Laboratory                                      */
+/*                                                                            */
+/*    Computer Science Department and                                         */
+/*    Advanced Information Technology Research Center (AITrc)                 */
+/*    Korea Advanced Institute of Science and Technology (KAIST)              */
+/*                                                                            */
+/*    e-mail: kywhang@cs.kaist.ac.kr                                          */
+/*    phone: +82-42-350-7722                                                  */
+/*    fax: +82-42-350-8380                                                    */
+/*                                                                            */
+/*    Copyright (c) 1995-2013 by Kyu-Young Whang                              */
+/*                                                                            */
+/*    All rights reserved. No part of this software may be reproduced,        */
+/*    stored in a retrieval system, or transmitted, in any form or by any     */
+/*    means, electronic, mechanical, photocopying, recording, or otherwise,   */
+/*    without prior written permission of the copyright owner.                */
+/*                                                                            */
+/******************************************************************************/
+#ifndef _EDUSPM_H_
+#define _EDUSPM_H_
+
+
+#include "EduSpM_Internal.h"
+#include "Util_pool.h"
+
+
+
+/*@
+ * Function Prototypes
+ */
+/* Interface Function Prototypes */
+Four EduSpM_CreateIndex(ObjectID*, PageID*);
+Four EduSpM_DeleteObject(ObjectID*, PageID*, SpatialDesc*, UFour*, ObjectID*, Pool*, DeallocListElem*);
+Four EduSpM_DropIndex(PhysicalFileID*, PageID*, Pool*, DeallocListElem*);
+Four EduSpM_FetchBox(PageID*, SpatialDesc*, UFour*, UFour*, SpatialCursor*, SpatialItem*, Four, Four*);
+Four EduSpM_FetchNearest(PageID*, SpatialDesc*, UFour*, Four, SpatialItem*, Four*);
+Four EduSpM_InsertObject(ObjectID*, PageID*, SpatialDesc*, UFour*, ObjectID*, Pool*, DeallocListElem*);
+
+
+#endif /* _EDUSPM_H_ */
@@ -0,0 +1,140 @@
+/******************************************************************************/
+/*                                                                            */
+/*    ODYSSEUS/EduCOSMOS Educational-Purpose Object Storage System            */
+/*                                                                            */
+/*    Developed by Professor Kyu-Young Whang et al.                           */
+/*                                                                            */
+/*    Database and Multimedia Laboratory                                      */
+/*                                                                            */
+/*    Computer Science Department and                                         */
+/*    Advanced Information Technology Research Center (AITrc)                 */
+/*    Korea Advanced Institute of Science and Technology (KAIST)              */
+/*                                                                            */
+/*    e-mail: kywhang@cs.kaist.ac.kr                                          */
+/*    phone: +82-42-350-7722                                                  */
+/*    fax: +82-42-350-8380                                                    */
+/*                                                                            */
+/*    Copyright (c) 1995-2013 by Kyu-Young Whang                              */
+/*                                                                            */
+/*    All rights reserved. No part of this software may be reproduced,        */
+/*    stored in a retrieval system, or transmitted, in any form or by any     */
+/*    means, electronic, mechanical, photocopying, recording, or otherwise,   */
+/*    without prior written permission of the copyright owner.                */
+/*                                                                            */
+/******************************************************************************/
+#ifndef _EDUSPM_INTERNAL_H_
+#define _EDUSPM_INTERNAL_H_
+
+
+#include "EduBtM_Internal.h"
+
+
+/*@
+ * Constant Definitions
+ */
+/*
+ * Space filling curves
+ *  A point of 'nDims' coordinates of 'nBits' bits is mapped to a code of
+ *  nDims * nBits bits by the curve; the points of an aligned cell of the
+ *  space get the codes of one range on both curves. The Hilbert curve keeps
+ *  the neighbors closer, so a box is covered by fewer ranges.
+ */
+#define SPM_ZORDER      0
+#define SPM_HILBERT     1
+
+/* Maximum # of the dimensions */
+#define SPM_MAXDIMS     8
+
+/* Maximum # of the bits of a coordinate */
+#define SPM_MAXBITS     31
+
+/* Maximum # of the bits of a code; the code is kept in two SM_INT key parts */
+#define SPM_MAXCODEBITS 62
+
+/* Maximum # of the key ranges a box is decomposed into */
+#define SPM_MAXRANGES   64
+
+/*
+ * Key of a spatial index
+ *  The code is split into two SM_INT parts of 31 bits, and the ObjectID is
+ *  appended in three SM_INT parts so that the points at the same place
+ *  still get different keys.
+ */
+#define SPM_KEYPARTS    5
+#define SPM_KEYLEN      (SPM_KEYPARTS * sizeof(Four))
+
+/* # of the candidates read from the index at once by a nearest neighbor search */
+#define SPM_NEARESTBATCH    64
+
+
+/*@
+ * Type Definitions
+ */
+/*
+ * SpatialDesc:
+ *  Describes the space of a spatial index; it is given to every call,
+ *  as a KeyDesc is given to EduBtM.
+ */
+typedef struct {
+	Two         nDims;                  /* # of the dimensions */
+	Two         nBits;                  /* # of the bits of a coordinate */
+	Two         curve;                  /* SPM_ZORDER or SPM_HILBERT */
+} SpatialDesc;
+
+/*
+ * SpatialItem:
+ *  A point returned by a query.
+ */
+typedef struct {
+	ObjectID    oid;                    /* ObjectID of the point */
+	UFour       point[SPM_MAXDIMS];     /* the coordinates */
+	double      dist2;                  /* squared distance to the query point; nearest neighbor search only */
+} SpatialItem;
+
+/*
+ * spm_Range:
+ *  A range of the codes, both ends included.
+ */
+typedef struct {
+	UEight      first;
+	UEight      last;
+} spm_Range;
+
+/*
+ * SpatialCursor:
+ *  Scan of a box. The box is decomposed into the ranges on the first call;
+ *  'btree' is the last entry read from the current range, or the cursor is
+ *  not CURSOR_ON when the range has not been started yet.
+ */
+typedef struct {
+	One         flag;                   /* CURSOR_INVALID before the first call, CURSOR_ON, CURSOR_EOS */
+	Two         nRanges;                /* # of the ranges */
+	Two         range;                  /* the current range */
+	spm_Range   ranges[SPM_MAXRANGES];  /* the ranges covering the box in the order of the codes */
+	BtreeCursor btree;                  /* position in the current range */
+} SpatialCursor;
+
+
+/*@
+ * Function Prototypes
+ */
+/*
+** Spatial Index Manager Internal function prototypes
+*/
+Four eduspm_CheckDesc(SpatialDesc*);
+Boolean eduspm_ValidPoint(SpatialDesc*, UFour*);
+UEight eduspm_Encode(SpatialDesc*, UFour*);
+void eduspm_Decode(SpatialDesc*, UEight, UFour*);
+void eduspm_AxesToTranspose(UFour*, Two, Two);
+void eduspm_TransposeToAxes(UFour*, Two, Two);
+void eduspm_KeyDesc(KeyDesc*);
+void eduspm_MakeKey(UEight, ObjectID*, Boolean, KeyValue*);
+UEight eduspm_KeyCode(KeyValue*);
+void eduspm_BoxRanges(SpatialDesc*, UFour*, UFour*, spm_Range*, Two*);
+Boolean eduspm_AddRange(spm_Range*, Boolean*, Two*, UEight, UEight, Boolean);
+Four eduspm_FetchBox(PageID*, SpatialDesc*, UFour*, UFour*, SpatialCursor*, SpatialItem*, Four, Four*);
+void eduspm_PushNearest(SpatialItem*, Four*, Four, SpatialItem*);
+void eduspm_SiftNearest(SpatialItem*, Four, Four);
+
+
+#endif /* _EDUSPM_INTERNAL_H_ */
@@ -81,5 +81,15 @@ typedef struct {
 	catEntry = (sm_CatOverlayForData*)obj->data; \
 }
 
+/* OM_NextObject() returns EOS after the last object of the file */
+#define EOS     1
+
+/*
+ * Object Manager functions used by the indexes
+ */
+Four OM_CreateObject(ObjectID*, ObjectID*, ObjectHdr*, Four, char*, ObjectID*);
+Four OM_NextObject(ObjectID*, ObjectID*, ObjectID*, ObjectHdr*);
+Four OM_ReadObject(ObjectID*, Four, Four, char*);
+
     
 #endif /* _OM_INTERNAL_H_ */
@@ -0,0 +1,189 @@
+/******************************************************************************/
+/*                                                                            */
+/*    ODYSSEUS/EduCOSMOS Educational-Purpose Object Storage System            */
+/*                                                                            */
+/*    Developed by Professor Kyu-Young Whang et al.                           */
+/*                                                                            */
+/*    Database and Multimedia Laboratory                                      */
+/*                                                                            */
+/*    Computer Science Department and                                         */
+/*    Advanced Information Technology Research Center (AITrc)                 */
+/*    Korea Advanced Institute of Science and Technology (KAIST)              */
+/*                                                                            */
+/*    e-mail: kywhang@cs.kaist.ac.kr                                          */
+/*    phone: +82-42-350-7722                                                  */
+/*    fax: +82-42-350-8380                                                    */
+/*                                                                            */
+/*    Copyright (c) 1995-2013 by Kyu-Young Whang                              */
+/*                                                                            */
+/*    All rights reserved. No part of this software may be reproduced,        */
+/*    stored in a retrieval system, or transmitted, in any form or by any     */
+/*    means, electronic, mechanical, photocopying, recording, or otherwise,   */
+/*    without prior written permission of the copyright owner.                */
+/*                                                                            */
+/******************************************************************************/
+/*
+ * Module: eduartm_Key.c
+ *
+ * Description:
+ *  Normalized keys of the adaptive radix tree. A key value is turned into
+ *  a string of bytes whose order by memcmp() is the order given by
+ *  edubtm_KeyCompare(), so the tree can branch on one byte at a time.
+ *  An integer becomes its big-endian bytes with the sign bit flipped, and
+ *  a string becomes its characters and a terminating 0. No normalized key
+ *  is then a proper prefix of another.
+ *
+ * Exports:
+ *  Four eduartm_NormalizeKey(KeyDesc*, KeyValue*, unsigned char*, Two*)
+ *  Four eduartm_CompareLeaf(ArtLeaf*, unsigned char*, Two)
+ *  Four eduartm_PrefixMismatch(ArtNode*, unsigned char*, Two, Four)
+ */
+
+
+#include <string.h>
+#include "EduBtM_common.h"
+#include "EduArtM_Internal.h"
+
+
+
+/*@================================
+ * eduartm_NormalizeKey()
+ *================================*/
+/*
+ * Function: Four eduartm_NormalizeKey(KeyDesc*, KeyValue*, unsigned char*, Two*)
+ *
+ * Description:
+ *  Make the normalized key of the key value. The normalized key is not
+ *  longer than the key value.
+ *
+ * Returns:
+ *  error code
+ *    eNOTSUPPORTED_EDUBTM
+ *
+ * Side effects:
+ *  nkey : the normalized key; it should have MAXKEYLEN bytes
+ *  nlen : length of the normalized key
+ */
+Four eduartm_NormalizeKey(
+    KeyDesc             *kdesc,         /* IN key descriptor */
+    KeyValue            *kval,          /* IN key value */
+    unsigned char       *nkey,          /* OUT the normalized key */
+    Two                 *nlen)          /* OUT length of the normalized key */
+{
+    Two                 i;              /* index for # of key parts */
+    Two                 j;              /* position in the key value */
+    Two                 k;              /* length of a string */
+    Two                 len;            /* string length */
+    Four_Invariable     v;              /* an integer */
+    UFour_Invariable    u;              /* the integer with the sign bit flipped */
+
+
+	*nlen = 0;
+	for (i = 0, j = 0; i < kdesc->nparts; i++)
+	{
+		if (kdesc->kpart[i].type == SM_INT)
+		{
+			if (kdesc->kpart[i].length != sizeof(Four_Invariable)) ERR(eNOTSUPPORTED_EDUBTM);
+
+			memcpy(&v, &kval->val[j], sizeof(Four_Invariable));
+			u = (UFour_Invariable)v ^ 0x80000000;
+			nkey[(*nlen)++] = (unsigned char)(u >> 24);
+			nkey[(*nlen)++] = (unsigned char)(u >> 16);
+			nkey[(*nlen)++] = (unsigned char)(u >> 8);
+			nkey[(*nlen)++] = (unsigned char)u;
+
+			j += sizeof(Four_Invariable);
+		}
+		else if (kdesc->kpart[i].type == SM_VARSTRING)
+		{
+			memcpy(&len, &kval->val[j], sizeof(Two));
+			j += sizeof(Two);
+
+			for (k = 0; k < len && kval->val[j+k] != '\0'; k++)
+				nkey[(*nlen)++] = kval->val[j+k];
+			nkey[(*nlen)++] = '\0';
+
+			j += len;
+		}
+		else
+			ERR(eNOTSUPPORTED_EDUBTM);
+	}
+
+	return(eNOERROR);
+
+} /* eduartm_NormalizeKey() */
+
+
+
+/*@================================
+ * eduartm_CompareLeaf()
+ *================================*/
+/*
+ * Function: Four eduartm_CompareLeaf(ArtLeaf*, unsigned char*, Two)
+ *
+ * Description:
+ *  Compare the normalized key of the leaf with the given normalized key.
+ *
+ * Returns:
+ *  LESS, EQUAL or GREATER as the key of the leaf is to 'nkey'
+ */
+Four eduartm_CompareLeaf(
+    ArtLeaf             *leaf,          /* IN a leaf */
+    unsigned char       *nkey,          /* IN normalized key */
+    Two                 nlen)           /* IN length of 'nkey' */
+{
+    Four                cmp;            /* result of memcmp() */
+
+
+	cmp = memcmp(leaf->key, nkey, (leaf->nlen < nlen) ? leaf->nlen : nlen);
+	if (cmp == 0) cmp = leaf->nlen - nlen;
+
+	return((cmp < 0) ? LESS : (cmp > 0) ? GREATER : EQUAL);
+
+} /* eduartm_CompareLeaf() */
+
+
+
+/*@================================
+ * eduartm_PrefixMismatch()
+ *================================*/
+/*
+ * Function: Four eduartm_PrefixMismatch(ArtNode*, unsigned char*, Two, Four)
+ *
+ * Description:
+ *  Return the length of the common part of the compressed path of the
+ *  node and the key from 'depth'. The bytes beyond ART_MAXPREFIXLEN are
+ *  read from the smallest leaf below the node, which has the same path.
+ *
+ * Returns:
+ *  # of the matching bytes; 'prefixLen' of the node if all match
+ */
+Four eduartm_PrefixMismatch(
+    ArtNode             *node,          /* IN an inner node */
+    unsigned char       *nkey,          /* IN normalized key */
+    Two                 nlen,           /* IN length of 'nkey' */
+    Four                depth)          /* IN # of the key bytes above the node */
+{
+    Four                i;              /* index */
+    Four                max;            /* # of the bytes to compare */
+    ArtLeaf             *leaf;          /* the smallest leaf */
+
+
+	max = (node->prefixLen < ART_MAXPREFIXLEN) ? node->prefixLen : ART_MAXPREFIXLEN;
+	if (max > nlen - depth) max = nlen - depth;
+
+	for (i = 0; i < max; i++)
+		if (node->prefix[i] != nkey[depth+i]) return(i);
+
+	if (node->prefixLen > ART_MAXPREFIXLEN)
+	{
+		leaf = eduartm_Minimum(node);
+		max = (node->prefixLen < nlen - depth) ? node->prefixLen : nlen - depth;
+
+		for (; i < max; i++)
+			if (leaf->key[depth+i] != nkey[depth+i]) return(i);
+	}
+
+	return(i);
+
+} /* eduartm_PrefixMismatch() */
@@ -0,0 +1,609 @@
+/******************************************************************************/
+/*                                                                            */
+/*    ODYSSEUS/EduCOSMOS Educational-Purpose Object Storage System            */
+/*                                                                            */
+/*    Developed by Professor Kyu-Young Whang et al.                           */
+/*                                                                            */
+/*    Database and Multimedia Laboratory                                      */
+/*                                                                            */
+/*    Computer Science Department and                                         */
+/*    Advanced Information Technology Research Center (AITrc)                 */
+/*    Korea Advanced Institute of Science and Technology (KAIST)              */
+/*                                                                            */
+/*    e-mail: kywhang@cs.kaist.ac.kr                                          */
+/*    phone: +82-42-350-7722                                                  */
+/*    fax: +82-42-350-8380                                                    */
+/*                                                                            */
+/*    Copyright (c) 1995-2013 by Kyu-Young Whang                              */
+/*                                                                            */
+/*    All rights reserved. No part of this software may be reproduced,        */
+/*    stored in a retrieval system, or transmitted, in any form or by any     */
+/*    means, electronic, mechanical, photocopying, recording, or otherwise,   */
+/*    without prior written permission of the copyright owner.                */
+/*                                                                            */
+/******************************************************************************/
+/*
+ * Module: eduartm_Node.c
+ *
+ * Description:
+ *  Inner nodes of the adaptive radix tree. A node keeps its children in
+ *  the smallest of the four layouts which can hold them: sorted arrays of
+ *  4 or 16 key bytes, an index of 256 bytes into 48 children, or a direct
+ *  array of 256 children. A node is replaced by the next larger layout
+ *  when it is full and by the next smaller one when it gets sparse; a
+ *  ART_NODE4 left with a single child is merged into the child.
+ *
+ * Exports:
+ *  ArtNode *eduartm_AllocNode(One)
+ *  void eduartm_FreeTree(void*)
+ *  void **eduartm_FindChild(ArtNode*, unsigned char)
+ *  void *eduartm_ChildAfter(ArtNode*, Four)
+ *  void *eduartm_ChildBefore(ArtNode*, Four)
+ *  Four eduartm_AddChild(ArtNode*, void**, unsigned char, void*)
+ *  void eduartm_RemoveChild(ArtNode*, void**, unsigned char, void**)
+ *  ArtLeaf *eduartm_Minimum(void*)
+ *  ArtLeaf *eduartm_Maximum(void*)
+ */
+
+
+#include <stdlib.h>
+#include <string.h>
+#include "EduBtM_common.h"
+#include "EduArtM_Internal.h"
+
+
+/*@ Internal Function Prototypes */
+void eduartm_CopyHeader(ArtNode*, ArtNode*);
+
+
+
+/*@================================
+ * eduartm_AllocNode()
+ *================================*/
+/*
+ * Function: ArtNode *eduartm_AllocNode(One)
+ *
+ * Description:
+ *  Allocate an empty inner node of the given type.
+ *
+ * Returns:
+ *  the new node or NULL if the memory is short
+ */
+ArtNode *eduartm_AllocNode(
+    One                 type)           /* IN type of the node */
+{
+    ArtNode             *node;          /* the new node */
+
+
+	switch (type)
+	{
+	  case ART_NODE4:   node = (ArtNode*)calloc(1, sizeof(ArtNode4)); break;
+	  case ART_NODE16:  node = (ArtNode*)calloc(1, sizeof(ArtNode16)); break;
+	  case ART_NODE48:  node = (ArtNode*)calloc(1, sizeof(ArtNode48)); break;
+	  default:          node = (ArtNode*)calloc(1, sizeof(ArtNode256)); break;
+	}
+
+	if (node != NULL) node->type = type;
+
+	return(node);
+
+} /* eduartm_AllocNode() */
+
+
+
+/*@================================
+ * eduartm_FreeTree()
+ *================================*/
+/*
+ * Function: void eduartm_FreeTree(void*)
+ *
+ * Description:
+ *  Free the node or the leaf and everything below it.
+ *
+ * Returns:
+ *  None
+ */
+void eduartm_FreeTree(
+    void                *p)             /* IN a node or a leaf */
+{
+    Four                i;              /* index */
+    ArtNode             *node;          /* 'p' as an inner node */
+
+
+	if (p == NULL) return;
+
+	node = (ArtNode*)p;
+	switch (node->type)
+	{
+	  case ART_NODE4:
+		for (i = 0; i < node->nChildren; i++) eduartm_FreeTree(((ArtNode4*)node)->children[i]);
+		break;
+
+	  case ART_NODE16:
+		for (i = 0; i < node->nChildren; i++) eduartm_FreeTree(((ArtNode16*)node)->children[i]);
+		break;
+
+	  case ART_NODE48:
+		for (i = 0; i < 48; i++) eduartm_FreeTree(((ArtNode48*)node)->children[i]);
+		break;
+
+	  case ART_NODE256:
+		for (i = 0; i < 256; i++) eduartm_FreeTree(((ArtNode256*)node)->children[i]);
+		break;
+	}
+
+	free(p);
+
+} /* eduartm_FreeTree() */
+
+
+
+/*@================================
+ * eduartm_FindChild()
+ *================================*/
+/*
+ * Function: void **eduartm_FindChild(ArtNode*, unsigned char)
+ *
+ * Description:
+ *  Find the child of the key byte 'c'.
+ *
+ * Returns:
+ *  pointer to the child pointer in the node, or NULL if there is no child
+ */
+void **eduartm_FindChild(
+    ArtNode             *node,          /* IN an inner node */
+    unsigned char       c)              /* IN key byte */
+{
+    Four                i;              /* index */
+    ArtNode4            *n4;            /* 'node' as ART_NODE4 */
+    ArtNode16           *n16;           /* 'node' as ART_NODE16 */
+    ArtNode48           *n48;           /* 'node' as ART_NODE48 */
+    ArtNode256          *n256;          /* 'node' as ART_NODE256 */
+
+
+	switch (node->type)
+	{
+	  case ART_NODE4:
+		n4 = (ArtNode4*)node;
+		for (i = 0; i < node->nChildren; i++)
+			if (n4->keys[i] == c) return(&n4->children[i]);
+		break;
+
+	  case ART_NODE16:
+		n16 = (ArtNode16*)node;
+		for (i = 0; i < node->nChildren && n16->keys[i] <= c; i++)
+			if (n16->keys[i] == c) return(&n16->children[i]);
+		break;
+
+	  case ART_NODE48:
+		n48 = (ArtNode48*)node;
+		if (n48->index[c] != 0) return(&n48->children[n48->index[c]-1]);
+		break;
+
+	  case ART_NODE256:
+		n256 = (ArtNode256*)node;
+		if (n256->children[c] != NULL) return(&n256->children[c]);
+		break;
+	}
+
+	return(NULL);
+
+} /* eduartm_FindChild() */
+
+
+
+/*@================================
+ * eduartm_ChildAfter()
+ *================================*/
+/*
+ * Function: void *eduartm_ChildAfter(ArtNode*, Four)
+ *
+ * Description:
+ *  Find the child of the smallest key byte greater than 'c'; 'c' may be
+ *  -1 for the first child.
+ *
+ * Returns:
+ *  the child or NULL if there is no such child
+ */
+void *eduartm_ChildAfter(
+    ArtNode             *node,          /* IN an inner node */
+    Four                c)              /* IN key byte */
+{
+    Four                i;              /* index */
+    ArtNode4            *n4;            /* 'node' as ART_NODE4 */
+    ArtNode16           *n16;           /* 'node' as ART_NODE16 */
+    ArtNode48           *n48;           /* 'node' as ART_NODE48 */
+    ArtNode256          *n256;          /* 'node' as ART_NODE256 */
+
+
+	switch (node->type)
+	{
+	  case ART_NODE4:
+		n4 = (ArtNode4*)node;
+		for (i = 0; i < node->nChildren; i++)
+			if (n4->keys[i] > c) return(n4->children[i]);
+		break;
+
+	  case ART_NODE16:
+		n16 = (ArtNode16*)node;
+		for (i = 0; i < node->nChildren; i++)
+			if (n16->keys[i] > c) return(n16->children[i]);
+		break;
+
+	  case ART_NODE48:
+		n48 = (ArtNode48*)node;
+		for (i = c+1; i < 256; i++)
+			if (n48->index[i] != 0) return(n48->children[n48->index[i]-1]);
+		break;
+
+	  case ART_NODE256:
+		n256 = (ArtNode256*)node;
+		for (i = c+1; i < 256; i++)
+			if (n256->children[i] != NULL) return(n256->children[i]);
+		break;
+	}
+
+	return(NULL);
+
+} /* eduartm_ChildAfter() */
+
+
+
+/*@================================
+ * eduartm_ChildBefore()
+ *================================*/
+/*
+ * Function: void *eduartm_ChildBefore(ArtNode*, Four)
+ *
+ * Description:
+ *  Find the child of the largest key byte less than 'c'; 'c' may be 256
+ *  for the last child.
+ *
+ * Returns:
+ *  the child or NULL if there is no such child
+ */
+void *eduartm_ChildBefore(
+    ArtNode             *node,          /* IN an inner node */
+    Four                c)              /* IN key byte */
+{
+    Four                i;              /* index */
+    ArtNode4            *n4;            /* 'node' as ART_NODE4 */
+    ArtNode16           *n16;           /* 'node' as ART_NODE16 */
+    ArtNode48           *n48;           /* 'node' as ART_NODE48 */
+    ArtNode256          *n256;          /* 'node' as ART_NODE256 */
+
+
+	switch (node->type)
+	{
+	  case ART_NODE4:
+		n4 = (ArtNode4*)node;
+		for (i = node->nChildren-1; i >= 0; i--)
+			if (n4->keys[i] < c) return(n4->children[i]);
+		break;
+
+	  case ART_NODE16:
+		n16 = (ArtNode16*)node;
+		for (i = node->nChildren-1; i >= 0; i--)
+			if (n16->keys[i] < c) return(n16->children[i]);
+		break;
+
+	  case ART_NODE48:
+		n48 = (ArtNode48*)node;
+		for (i = c-1; i >= 0; i--)
+			if (n48->index[i] != 0) return(n48->children[n48->index[i]-1]);
+		break;
+
+	  case ART_NODE256:
+		n256 = (ArtNode256*)node;
+		for (i = c-1; i >= 0; i--)
+			if (n256->children[i] != NULL) return(n256->children[i]);
+		break;
+	}
+
+	return(NULL);
+
+} /* eduartm_ChildBefore() */
+
+
+
+/*@================================
+ * eduartm_CopyHeader()
+ *================================*/
+/*
+ * Function: void eduartm_CopyHeader(ArtNode*, ArtNode*)
+ *
+ * Description:
+ *  Copy the # of children and the compressed path to a node of another type.
+ *
+ * Returns:
+ *  None
+ */
+void eduartm_CopyHeader(
+    ArtNode             *to,            /* OUT the new node */
+    ArtNode             *from)          /* IN the old node */
+{
+	to->nChildren = from->nChildren;
+	to->prefixLen = from->prefixLen;
+	memcpy(to->prefix, from->prefix, ART_MAXPREFIXLEN);
+
+} /* eduartm_CopyHeader() */
+
+
+
+/*@================================
+ * eduartm_AddChild()
+ *================================*/
+/*
+ * Function: Four eduartm_AddChild(ArtNode*, void**, unsigned char, void*)
+ *
+ * Description:
+ *  Add the child of the key byte 'c', which is not in the node. A full
+ *  node is replaced by a node of the next larger type, and '*ref' is
+ *  changed to point to it.
+ *
+ * Returns:
+ *  error code
+ *    eMEMORYALLOCERR_BTM
+ */
+Four eduartm_AddChild(
+    ArtNode             *node,          /* IN an inner node */
+    void                **ref,          /* INOUT the pointer to the node in its parent */
+    unsigned char       c,              /* IN key byte */
+    void                *child)         /* IN the new child */
+{
+    Four                i, j;           /* indexes */
+    ArtNode             *newNode;       /* the larger node */
+    ArtNode4            *n4;            /* 'node' as ART_NODE4 */
+    ArtNode16           *n16;           /* 'node' as ART_NODE16 */
+    ArtNode48           *n48;           /* 'node' as ART_NODE48 */
+
+
+	switch (node->type)
+	{
+	  case ART_NODE4:
+		n4 = (ArtNode4*)node;
+		if (node->nChildren < 4)
+		{
+			for (i = 0; i < node->nChildren && n4->keys[i] < c; i++);
+			memmove(&n4->keys[i+1], &n4->keys[i], node->nChildren - i);
+			memmove(&n4->children[i+1], &n4->children[i], (node->nChildren - i) * sizeof(void*));
+			n4->keys[i] = c;
+			n4->children[i] = child;
+			node->nChildren++;
+			return(eNOERROR);
+		}
+
+		newNode = eduartm_AllocNode(ART_NODE16);
+		if (newNode == NULL) ERR(eMEMORYALLOCERR_BTM);
+		eduartm_CopyHeader(newNode, node);
+		memcpy(((ArtNode16*)newNode)->keys, n4->keys, 4);
+		memcpy(((ArtNode16*)newNode)->children, n4->children, 4 * sizeof(void*));
+		break;
+
+	  case ART_NODE16:
+		n16 = (ArtNode16*)node;
+		if (node->nChildren < 16)
+		{
+			for (i = 0; i < node->nChildren && n16->keys[i] < c; i++);
+			memmove(&n16->keys[i+1], &n16->keys[i], node->nChildren - i);
+			memmove(&n16->children[i+1], &n16->children[i], (node->nChildren - i) * sizeof(void*));
+			n16->keys[i] = c;
+			n16->children[i] = child;
+			node->nChildren++;
+			return(eNOERROR);
+		}
+
+		newNode = eduartm_AllocNode(ART_NODE48);
+		if (newNode == NULL) ERR(eMEMORYALLOCERR_BTM);
+		eduartm_CopyHeader(newNode, node);
+		for (i = 0; i < 16; i++)
+		{
+			((ArtNode48*)newNode)->children[i] = n16->children[i];
+			((ArtNode48*)newNode)->index[n16->keys[i]] = i+1;
+		}
+		break;
+
+	  case ART_NODE48:
+		n48 = (ArtNode48*)node;
+		if (node->nChildren < 48)
+		{
+			for (i = 0; n48->children[i] != NULL; i++);
+			n48->children[i] = child;
+			n48->index[c] = i+1;
+			node->nChildren++;
+			return(eNOERROR);
+		}
+
+		newNode = eduartm_AllocNode(ART_NODE256);
+		if (newNode == NULL) ERR(eMEMORYALLOCERR_BTM);
+		eduartm_CopyHeader(newNode, node);
+		for (j = 0; j < 256; j++)
+			if (n48->index[j] != 0)
+				((ArtNode256*)newNode)->children[j] = n48->children[n48->index[j]-1];
+		break;
+
+	  default:
+		((ArtNode256*)node)->children[c] = child;
+		node->nChildren++;
+		return(eNOERROR);
+	}
+
+	/* The larger node takes the place of the full one. */
+	*ref = newNode;
+	free(node);
+
+	return(eduartm_AddChild(newNode, ref, c, child));
+
+} /* eduartm_AddChild() */
+
+
+
+/*@================================
+ * eduartm_RemoveChild()
+ *================================*/
+/*
+ * Function: void eduartm_RemoveChild(ArtNode*, void**, unsigned char, void**)
+ *
+ * Description:
+ *  Remove the child of the key byte 'c'; 'slot' is the pointer returned by
+ *  eduartm_FindChild(). A sparse node is replaced by a node of the next
+ *  smaller type, and a ART_NODE4 left with one child by the child itself
+ *  with the compressed paths joined; '*ref' is changed accordingly.
+ *
+ * Returns:
+ *  None
+ *
+ * Note:
+ *  A node gets smaller at fewer children than it grows, so that a node at
+ *  the boundary is not replaced at every insertion and deletion.
+ */
+void eduartm_RemoveChild(
+    ArtNode             *node,          /* IN an inner node */
+    void                **ref,          /* INOUT the pointer to the node in its parent */
+    unsigned char       c,              /* IN key byte */
+    void                **slot)         /* IN the pointer to the child in the node */
+{
+    Four                i, j;           /* indexes */
+    Four                len;            /* length of the joined path */
+    ArtNode             *newNode;       /* the smaller node */
+    ArtNode             *child;         /* the only child */
+    ArtNode4            *n4;            /* 'node' as ART_NODE4 */
+    ArtNode16           *n16;           /* 'node' as ART_NODE16 */
+    ArtNode48           *n48;           /* 'node' as ART_NODE48 */
+    ArtNode256          *n256;          /* 'node' as ART_NODE256 */
+
+
+	switch (node->type)
+	{
+	  case ART_NODE4:
+		n4 = (ArtNode4*)node;
+		i = (void**)slot - n4->children;
+		memmove(&n4->keys[i], &n4->keys[i+1], node->nChildren - i - 1);
+		memmove(&n4->children[i], &n4->children[i+1], (node->nChildren - i - 1) * sizeof(void*));
+		node->nChildren--;
+		if (node->nChildren > 1) return;
+
+		/* Merge the node into its only child. */
+		child = (ArtNode*)n4->children[0];
+		if (child->type != ART_LEAF)
+		{
+			len = node->prefixLen;
+			if (len < ART_MAXPREFIXLEN) node->prefix[len++] = n4->keys[0];
+			if (len < ART_MAXPREFIXLEN)
+			{
+				j = (child->prefixLen < ART_MAXPREFIXLEN - len) ? child->prefixLen : ART_MAXPREFIXLEN - len;
+				memcpy(&node->prefix[len], child->prefix, j);
+				len += j;
+			}
+			memcpy(child->prefix, node->prefix, (len < ART_MAXPREFIXLEN) ? len : ART_MAXPREFIXLEN);
+			child->prefixLen += node->prefixLen + 1;
+		}
+		*ref = child;
+		free(node);
+		return;
+
+	  case ART_NODE16:
+		n16 = (ArtNode16*)node;
+		i = (void**)slot - n16->children;
+		memmove(&n16->keys[i], &n16->keys[i+1], node->nChildren - i - 1);
+		memmove(&n16->children[i], &n16->children[i+1], (node->nChildren - i - 1) * sizeof(void*));
+		node->nChildren--;
+		if (node->nChildren > 3) return;
+
+		newNode = eduartm_AllocNode(ART_NODE4);
+		if (newNode == NULL) return;    /* stay larger */
+		eduartm_CopyHeader(newNode, node);
+		memcpy(((ArtNode4*)newNode)->keys, n16->keys, node->nChildren);
+		memcpy(((ArtNode4*)newNode)->children, n16->children, node->nChildren * sizeof(void*));
+		break;
+
+	  case ART_NODE48:
+		n48 = (ArtNode48*)node;
+		n48->children[n48->index[c]-1] = NULL;
+		n48->index[c] = 0;
+		node->nChildren--;
+		if (node->nChildren > 12) return;
+
+		newNode = eduartm_AllocNode(ART_NODE16);
+		if (newNode == NULL) return;
+		eduartm_CopyHeader(newNode, node);
+		for (i = 0, j = 0; i < 256; i++)
+			if (n48->index[i] != 0)
+			{
+				((ArtNode16*)newNode)->keys[j] = i;
+				((ArtNode16*)newNode)->children[j++] = n48->children[n48->index[i]-1];
+			}
+		break;
+
+	  default:
+		n256 = (ArtNode256*)node;
+		n256->children[c] = NULL;
+		node->nChildren--;
+		if (node->nChildren > 37) return;
+
+		newNode = eduartm_AllocNode(ART_NODE48);
+		if (newNode == NULL) return;
+		eduartm_CopyHeader(newNode, node);
+		for (i = 0, j = 0; i < 256; i++)
+			if (n256->children[i] != NULL)
+			{
+				((ArtNode48*)newNode)->children[j] = n256->children[i];
+				((ArtNode48*)newNode)->index[i] = ++j;
+			}
+		break;
+	}
+
+	*ref = newNode;
+	free(node);
+
+} /* eduartm_RemoveChild() */
+
+
+
+/*@================================
+ * eduartm_Minimum()
+ *================================*/
+/*
+ * Function: ArtLeaf *eduartm_Minimum(void*)
+ *
+ * Description:
+ *  Return the leaf of the smallest key below the node.
+ *
+ * Returns:
+ *  the leaf or NULL if 'p' is NULL
+ */
+ArtLeaf *eduartm_Minimum(
+    void                *p)             /* IN a node or a leaf */
+{
+
+	while (p != NULL && ART_TYPE(p) != ART_LEAF)
+		p = eduartm_ChildAfter((ArtNode*)p, -1);
+
+	return((ArtLeaf*)p);
+
+} /* eduartm_Minimum() */
+
+
+
+/*@================================
+ * eduartm_Maximum()
+ *================================*/
+/*
+ * Function: ArtLeaf *eduartm_Maximum(void*)
+ *
+ * Description:
+ *  Return the leaf of the largest key below the node.
+ *
+ * Returns:
+ *  the leaf or NULL if 'p' is NULL
+ */
+ArtLeaf *eduartm_Maximum(
+    void                *p)             /* IN a node or a leaf */
+{
+
+	while (p != NULL && ART_TYPE(p) != ART_LEAF)
+		p = eduartm_ChildBefore((ArtNode*)p, 256);
+
+	return((ArtLeaf*)p);
+
+} /* eduartm_Maximum() */
@@ -0,0 +1,394 @@
+/******************************************************************************/
+/*                                                                            */
+/*    ODYSSEUS/EduCOSMOS Educational-Purpose Object Storage System            */
+/*                                                                            */
+/*    Developed by Professor Kyu-Young Whang et al.                           */
+/*                                                                            */
+/*    Database and Multimedia Laboratory                                      */
+/*                                                                            */
+/*    Computer Science Department and                                         */
+/*    Advanced Information Technology Research Center (AITrc)                 */
+/*    Korea Advanced Institute of Science and Technology (KAIST)              */
+/*                                                                            */
+/*    e-mail: kywhang@cs.kaist.ac.kr                                          */
+/*    phone: +82-42-350-7722                                                  */
+/*    fax: +82-42-350-8380                                                    */
+/*                                                                            */
+/*    Copyright (c) 1995-2013 by Kyu-Young Whang                              */
+/*                                                                            */
+/*    All rights reserved. No part of this software may be reproduced,        */
+/*    stored in a retrieval system, or transmitted, in any form or by any     */
+/*    means, electronic, mechanical, photocopying, recording, or otherwise,   */
+/*    without prior written permission of the copyright owner.                */
+/*                                                                            */
+/******************************************************************************/
+/*
+ * Module: eduartm_Search.c
+ *
+ * Description:
+ *  Insertion, deletion and search of the leaves of the adaptive radix
+ *  tree. The tree branches on one byte of the normalized key at each inner
+ *  node, after the bytes of the compressed path of the node.
+ *
+ * Exports:
+ *  Four eduartm_Insert(void**, unsigned char*, Two, Four, ArtLeaf*)
+ *  ArtLeaf *eduartm_Delete(void**, unsigned char*, Two, Four, ObjectID*)
+ *  ArtLeaf *eduartm_Search(void*, unsigned char*, Two)
+ *  ArtLeaf *eduartm_Seek(void*, unsigned char*, Two, Four, Boolean, Boolean)
+ *  void eduartm_SetCursor(ArtIndex*, ArtLeaf*, KeyValue*, Four, BtreeCursor*)
+ */
+
+
+#include <string.h>
+#include "EduBtM_common.h"
+#include "EduArtM_Internal.h"
+
+
+
+/*@================================
+ * eduartm_Insert()
+ *================================*/
+/*
+ * Function: Four eduartm_Insert(void**, unsigned char*, Two, Four, ArtLeaf*)
+ *
+ * Description:
+ *  Insert the leaf below the node '*ref', whose compressed path starts at
+ *  the byte 'depth' of the key. A leaf met on the way is split into a
+ *  ART_NODE4 over both leaves, and a compressed path which differs from
+ *  the key is split into a ART_NODE4 over the node and the new leaf.
+ *
+ * Returns:
+ *  error code
+ *    eDUPLICATEDKEY_BTM
+ *    some errors caused by function calls
+ */
+Four eduartm_Insert(
+    void                **ref,          /* INOUT the pointer to the node in its parent */
+    unsigned char       *nkey,          /* IN normalized key of the leaf */
+    Two                 nlen,           /* IN length of 'nkey' */
+    Four                depth,          /* IN # of the key bytes above the node */
+    ArtLeaf             *leaf)          /* IN the new leaf */
+{
+    Four                i;              /* index */
+    Four                diff;           /* length of the common path */
+    void                *p;             /* the node or the leaf at '*ref' */
+    void                **child;        /* the pointer to the child */
+    ArtNode             *node;          /* 'p' as an inner node */
+    ArtNode             *newNode;       /* the new ART_NODE4 */
+    ArtLeaf             *old;           /* 'p' as a leaf */
+
+
+	p = *ref;
+	if (p == NULL)
+	{
+		*ref = leaf;
+		return(eNOERROR);
+	}
+
+	if (ART_TYPE(p) == ART_LEAF)
+	{
+		old = (ArtLeaf*)p;
+		if (eduartm_CompareLeaf(old, nkey, nlen) == EQUAL) ERR(eDUPLICATEDKEY_BTM);
+
+		newNode = eduartm_AllocNode(ART_NODE4);
+		if (newNode == NULL) ERR(eMEMORYALLOCERR_BTM);
+
+		/* No normalized key is a prefix of another, so both go on after the common path. */
+		for (i = depth; i < old->nlen && i < nlen && old->key[i] == nkey[i]; i++);
+		newNode->prefixLen = i - depth;
+		memcpy(newNode->prefix, &nkey[depth], MIN(newNode->prefixLen, ART_MAXPREFIXLEN));
+
+		*ref = newNode;
+		(Four)eduartm_AddChild(newNode, ref, old->key[i], old);
+		(Four)eduartm_AddChild(newNode, ref, nkey[i], leaf);
+
+		return(eNOERROR);
+	}
+
+	node = (ArtNode*)p;
+	if (node->prefixLen > 0)
+	{
+		diff = eduartm_PrefixMismatch(node, nkey, nlen, depth);
+		if (diff < node->prefixLen)
+		{
+			newNode = eduartm_AllocNode(ART_NODE4);
+			if (newNode == NULL) ERR(eMEMORYALLOCERR_BTM);
+
+			newNode->prefixLen = diff;
+			memcpy(newNode->prefix, node->prefix, MIN(diff, ART_MAXPREFIXLEN));
+			*ref = newNode;
+
+			/* The node keeps the part of its path after the branching byte. */
+			if (node->prefixLen <= ART_MAXPREFIXLEN)
+			{
+				(Four)eduartm_AddChild(newNode, ref, node->prefix[diff], node);
+				node->prefixLen -= diff + 1;
+				memmove(node->prefix, &node->prefix[diff+1], MIN(node->prefixLen, ART_MAXPREFIXLEN));
+			}
+			else
+			{
+				old = eduartm_Minimum(node);
+				(Four)eduartm_AddChild(newNode, ref, old->key[depth+diff], node);
+				node->prefixLen -= diff + 1;
+				memcpy(node->prefix, &old->key[depth+diff+1], MIN(node->prefixLen, ART_MAXPREFIXLEN));
+			}
+
+			(Four)eduartm_AddChild(newNode, ref, nkey[depth+diff], leaf);
+
+			return(eNOERROR);
+		}
+
+		depth += node->prefixLen;
+	}
+
+	child = eduartm_FindChild(node, nkey[depth]);
+	if (child != NULL)
+		return(eduartm_Insert(child, nkey, nlen, depth+1, leaf));
+
+	return(eduartm_AddChild(node, ref, nkey[depth], leaf));
+
+} /* eduartm_Insert() */
+
+
+
+/*@================================
+ * eduartm_Delete()
+ *================================*/
+/*
+ * Function: ArtLeaf *eduartm_Delete(void**, unsigned char*, Two, Four, ObjectID*)
+ *
+ * Description:
+ *  Remove the leaf of the key and the ObjectID from below the node '*ref'.
+ *  The inner node which held the leaf may be replaced by a smaller one.
+ *
+ * Returns:
+ *  the removed leaf, which the caller frees, or NULL if not found
+ */
+ArtLeaf *eduartm_Delete(
+    void                **ref,          /* INOUT the pointer to the node in its parent */
+    unsigned char       *nkey,          /* IN normalized key */
+    Two                 nlen,           /* IN length of 'nkey' */
+    Four                depth,          /* IN # of the key bytes above the node */
+    ObjectID            *oid)           /* IN ObjectID of the leaf */
+{
+    void                *p;             /* the node or the leaf at '*ref' */
+    void                **child;        /* the pointer to the child */
+    ArtNode             *node;          /* 'p' as an inner node */
+    ArtLeaf             *leaf;          /* the leaf found */
+
+
+	p = *ref;
+	if (p == NULL) return(NULL);
+
+	if (ART_TYPE(p) == ART_LEAF)
+	{
+		leaf = (ArtLeaf*)p;
+		if (eduartm_CompareLeaf(leaf, nkey, nlen) != EQUAL || btm_ObjectIdComp(&leaf->oid, oid) != EQUAL) return(NULL);
+
+		*ref = NULL;
+		return(leaf);
+	}
+
+	node = (ArtNode*)p;
+	if (node->prefixLen > 0)
+	{
+		if (eduartm_PrefixMismatch(node, nkey, nlen, depth) < node->prefixLen) return(NULL);
+		depth += node->prefixLen;
+	}
+	if (depth >= nlen) return(NULL);
+
+	child = eduartm_FindChild(node, nkey[depth]);
+	if (child == NULL) return(NULL);
+
+	if (ART_TYPE(*child) != ART_LEAF)
+		return(eduartm_Delete(child, nkey, nlen, depth+1, oid));
+
+	leaf = (ArtLeaf*)*child;
+	if (eduartm_CompareLeaf(leaf, nkey, nlen) != EQUAL || btm_ObjectIdComp(&leaf->oid, oid) != EQUAL) return(NULL);
+
+	eduartm_RemoveChild(node, ref, nkey[depth], child);
+
+	return(leaf);
+
+} /* eduartm_Delete() */
+
+
+
+/*@================================
+ * eduartm_Search()
+ *================================*/
+/*
+ * Function: ArtLeaf *eduartm_Search(void*, unsigned char*, Two)
+ *
+ * Description:
+ *  Find the leaf of the key. Only the kept bytes of the compressed paths
+ *  are compared on the way down; the key of the leaf reached is compared
+ *  as a whole at the end.
+ *
+ * Returns:
+ *  the leaf or NULL if not found
+ */
+ArtLeaf *eduartm_Search(
+    void                *p,             /* IN the root */
+    unsigned char       *nkey,          /* IN normalized key */
+    Two                 nlen)           /* IN length of 'nkey' */
+{
+    Four                i;              /* index */
+    Four                depth;          /* # of the key bytes above the node */
+    void                **child;        /* the pointer to the child */
+    ArtNode             *node;          /* 'p' as an inner node */
+
+
+	for (depth = 0; p != NULL; depth++)
+	{
+		if (ART_TYPE(p) == ART_LEAF)
+			return((eduartm_CompareLeaf((ArtLeaf*)p, nkey, nlen) == EQUAL) ? (ArtLeaf*)p : NULL);
+
+		node = (ArtNode*)p;
+		if (node->prefixLen > 0)
+		{
+			if (depth + node->prefixLen >= nlen) return(NULL);
+
+			for (i = 0; i < MIN(node->prefixLen, ART_MAXPREFIXLEN); i++)
+				if (node->prefix[i] != nkey[depth+i]) return(NULL);
+
+			depth += node->prefixLen;
+		}
+		if (depth >= nlen) return(NULL);
+
+		child = eduartm_FindChild(node, nkey[depth]);
+		p = (child != NULL) ? *child : NULL;
+	}
+
+	return(NULL);
+
+} /* eduartm_Search() */
+
+
+
+/*@================================
+ * eduartm_Seek()
+ *================================*/
+/*
+ * Function: ArtLeaf *eduartm_Seek(void*, unsigned char*, Two, Four, Boolean, Boolean)
+ *
+ * Description:
+ *  Find the leaf of the smallest key greater than or equal to the given
+ *  key below the node if 'forward' is TRUE, or of the largest key less
+ *  than or equal to it otherwise. If 'strict' is TRUE, the key itself is
+ *  excluded. A subtree whose path branches off from the key lies wholly
+ *  on one side of it, so at most one child is searched at each node
+ *  besides the minimum or the maximum of its neighbour.
+ *
+ * Returns:
+ *  the leaf or NULL if not found
+ */
+ArtLeaf *eduartm_Seek(
+    void                *p,             /* IN the node */
+    unsigned char       *nkey,          /* IN normalized key */
+    Two                 nlen,           /* IN length of 'nkey' */
+    Four                depth,          /* IN # of the key bytes above the node */
+    Boolean             forward,        /* IN TRUE if the next key is wanted */
+    Boolean             strict)         /* IN TRUE if the key itself is excluded */
+{
+    Four                i;              /* # of the matching bytes */
+    Four                cmp;            /* result of comparison */
+    unsigned char       c;              /* a byte of the compressed path */
+    void                **child;        /* the pointer to the child */
+    ArtNode             *node;          /* 'p' as an inner node */
+    ArtLeaf             *leaf;          /* the leaf found */
+
+
+	if (p == NULL) return(NULL);
+
+	if (ART_TYPE(p) == ART_LEAF)
+	{
+		cmp = eduartm_CompareLeaf((ArtLeaf*)p, nkey, nlen);
+		if (cmp == (forward ? GREATER : LESS) || (cmp == EQUAL && !strict)) return((ArtLeaf*)p);
+
+		return(NULL);
+	}
+
+	node = (ArtNode*)p;
+	if (node->prefixLen > 0)
+	{
+		i = eduartm_PrefixMismatch(node, nkey, nlen, depth);
+		if (i < node->prefixLen)
+		{
+			/* The whole subtree is on one side of the key. */
+			if (depth + i >= nlen)
+				cmp = GREATER;
+			else
+			{
+				c = (i < ART_MAXPREFIXLEN) ? node->prefix[i] : eduartm_Minimum(node)->key[depth+i];
+				cmp = (c > nkey[depth+i]) ? GREATER : LESS;
+			}
+
+			if (cmp == GREATER) return(forward ? eduartm_Minimum(node) : NULL);
+			else return(forward ? NULL : eduartm_Maximum(node));
+		}
+
+		depth += node->prefixLen;
+	}
+
+	if (depth >= nlen) return(forward ? eduartm_Minimum(node) : NULL);
+
+	child = eduartm_FindChild(node, nkey[depth]);
+	if (child != NULL)
+	{
+		leaf = eduartm_Seek(*child, nkey, nlen, depth+1, forward, strict);
+		if (leaf != NULL) return(leaf);
+	}
+
+	if (forward)
+		return(eduartm_Minimum(eduartm_ChildAfter(node, nkey[depth])));
+	else
+		return(eduartm_Maximum(eduartm_ChildBefore(node, nkey[depth])));
+
+} /* eduartm_Seek() */
+
+
+
+/*@================================
+ * eduartm_SetCursor()
+ *================================*/
+/*
+ * Function: void eduartm_SetCursor(ArtIndex*, ArtLeaf*, KeyValue*, Four, BtreeCursor*)
+ *
+ * Description:
+ *  Make the cursor point to the leaf if the leaf satisfies the stop
+ *  condition; otherwise the cursor gets CURSOR_EOS.
+ *
+ * Returns:
+ *  None
+ */
+void eduartm_SetCursor(
+    ArtIndex            *index,         /* IN the index */
+    ArtLeaf             *leaf,          /* IN the leaf found or NULL */
+    KeyValue            *stopKval,      /* IN key value of stop condition */
+    Four                stopCompOp,     /* IN comparison operator of stop condition */
+    BtreeCursor         *cursor)        /* OUT the cursor */
+{
+    Four                cmp;            /* result of comparison */
+
+
+	cursor->flag = CURSOR_EOS;
+	if (leaf == NULL) return;
+
+	cursor->key.len = leaf->klen;
+	memcpy(cursor->key.val, &leaf->key[leaf->nlen], leaf->klen);
+
+	if (stopCompOp != SM_EOF && stopCompOp != SM_BOF)
+	{
+		cmp = edubtm_KeyCompare(&index->kdesc, &cursor->key, stopKval);
+		if ((stopCompOp == SM_EQ && cmp != EQUAL) ||
+		    (stopCompOp == SM_LT && cmp != LESS) ||
+		    (stopCompOp == SM_LE && cmp == GREAT) ||
+		    (stopCompOp == SM_GT && cmp != GREAT) ||
+		    (stopCompOp == SM_GE && cmp == LESS)) return;
+	}
+
+	cursor->flag = CURSOR_ON;
+	cursor->oid = leaf->oid;
+
+} /* eduartm_SetCursor() */
@@ -33,17 +33,30 @@
  *  the given key value in the function edubtm_BinarSearchInternal; in the
  *  function edubtm_BinarySearchLeaf() the index whose key value is the smallest
  *  in the given page but larger than the given key value.
+ *  An index with KEYFLAG_INTERPOLATE on a single SM_INT key part is searched
+ *  by edubtm_InterpolationSearch() instead.
  *
  * Exports:
  *  Boolean edubtm_BinarySearchInternal(BtreeInternal*, KeyDesc*, KeyValue*, Two*)
  *  Boolean edubtm_BinarySearchLeaf(BtreeLeaf*, KeyDesc*, KeyValue*, Two*)
+ *  Boolean edubtm_InterpolationSearch(char*, Two*, Two, Two, Four_Invariable, Two*)
  */
 
 
+#include <stddef.h>
+#include <string.h>
 #include "EduBtM_common.h"
 #include "EduBtM_Internal.h"
 
 
+/* # of the keys read by the searches in the pages; for the benchmarks */
+Four edubtm_nProbes = 0;
+
+/* read the SM_INT key of the i-th slot of a page */
+#define EDUBTM_SLOTKEY(data, slot, i, keyOffset, v) \
+	memcpy(&(v), (data) + (slot)[-1*(i)] + (keyOffset), sizeof(Four_Invariable))
+
+
 
 /*@================================
  * edubtm_BinarySearchInternal()
@@ -78,6 +91,7 @@ Boolean edubtm_BinarySearchInternal(
     Two  		high;		/* high index */
     Four 		cmp;		/* result of comparison */
     btm_InternalEntry 	*entry;	/* an internal entry */
+    Four_Invariable	key;		/* the integer key */
 
     
     /* Error check whether using not supported functionality by EduBtM */
@@ -88,6 +102,21 @@ Boolean edubtm_BinarySearchInternal(
             ERR(eNOTSUPPORTED_EDUBTM);
     }
 
+	/* An empty page has no entry to compare with. */
+	if (ipage->hdr.nSlots == 0)
+	{
+		*idx = -1;
+		return FALSE;
+	}
+
+	/* Interpolation search for the integer keys. */
+	if (BTM_INTERPOLATABLE(kdesc))
+	{
+		memcpy(&key, kval->val, sizeof(Four_Invariable));
+		return(edubtm_InterpolationSearch(ipage->data, ipage->slot, ipage->hdr.nSlots,
+						  offsetof(btm_InternalEntry, kval), key, idx));
+	}
+
 	/* Binary search. */
 	low = 0;
 	high = ipage->hdr.nSlots-1;
@@ -98,6 +127,7 @@ Boolean edubtm_BinarySearchInternal(
 
 		entry = ipage->data + ipage->slot[-1*mid];
 		cmp = edubtm_KeyCompare(kdesc, &entry->klen, kval);
+		edubtm_nProbes++;
 		if (cmp == LESS) 		low = mid+1;
 		else if (cmp == EQUAL) 	break;
 		else 					high = mid-1;
@@ -152,6 +182,7 @@ Boolean edubtm_BinarySearchLeaf(
     Two  		high;		/* high index */
     Four 		cmp;		/* result of comparison */
     btm_LeafEntry 	*entry;		/* a leaf entry */
+    Four_Invariable	key;		/* the integer key */
 
     /* Error check whether using not supported functionality by EduBtM */
     int i;
@@ -161,6 +192,21 @@ Boolean edubtm_BinarySearchLeaf(
             ERR(eNOTSUPPORTED_EDUBTM);
     }
 
+	/* An empty page has no entry to compare with. */
+	if (lpage->hdr.nSlots == 0)
+	{
+		*idx = -1;
+		return FALSE;
+	}
+
+	/* Interpolation search for the integer keys. */
+	if (BTM_INTERPOLATABLE(kdesc))
+	{
+		memcpy(&key, kval->val, sizeof(Four_Invariable));
+		return(edubtm_InterpolationSearch(lpage->data, lpage->slot, lpage->hdr.nSlots,
+						  offsetof(btm_LeafEntry, kval), key, idx));
+	}
+
 	/* Binary search. */
 	low = 0;
 	high = lpage->hdr.nSlots-1;
@@ -171,6 +217,7 @@ Boolean edubtm_BinarySearchLeaf(
 
 		entry = lpage->data + lpage->slot[-1*mid];
 		cmp = edubtm_KeyCompare(kdesc, &entry->klen, kval);
+		edubtm_nProbes++;
 		if (cmp == LESS) 		low = mid+1;
 		else if (cmp == EQUAL) 	break;
 		else 					high = mid-1;
@@ -190,3 +237,135 @@ Boolean edubtm_BinarySearchLeaf(
 	}
 
 } /* edubtm_BinarySearchLeaf() */
+
+
+
+/*@================================
+ * edubtm_InterpolationSearch()
+ *================================*/
+/*
+ * Function: Boolean edubtm_InterpolationSearch(char*, Two*, Two, Two, Four_Invariable, Two*)
+ *
+ * Description:
+ *  Search the slot of which key equals to or is less than the given integer
+ *  key in a page of either type. The first probe is placed where the key
+ *  would be if the keys between the first and the last one were uniform,
+ *  which hits the key or its neighbor on the dense keys. From there the
+ *  search gallops by the steps 1, 2, 4, ... toward the key, so a skewed
+ *  page costs at most about twice the binary search, and then the binary
+ *  search finishes in the range bracketed by the gallop.
+ *
+ * Returns:
+ *  Result of search: TRUE if the same key is found, FALSE otherwise
+ *
+ * Side effects:
+ *  1) parameter idx : slot No of the slot having the key equal to or
+ *                     less than the given key value, or -1
+ *
+ * Note:
+ *  The page should have at least one slot.
+ */
+Boolean edubtm_InterpolationSearch(
+    char		*data,		/* IN data area of the page */
+    Two			*slot,		/* IN the first slot of the page */
+    Two			nSlots,		/* IN # of slots */
+    Two			keyOffset,	/* IN offset of the key value in an entry */
+    Four_Invariable	key,		/* IN key value */
+    Two			*idx)		/* OUT index to be returned */
+{
+    Two			low, high;	/* key(low) <= key < key(high) */
+    Two			mid;		/* probed index */
+    Two			step;		/* step of the gallop */
+    Four_Invariable	kLow, kHigh;	/* keys of 'low' and 'high' */
+    Four_Invariable	kMid;		/* key of 'mid' */
+
+
+	low = 0;
+	high = nSlots-1;
+	EDUBTM_SLOTKEY(data, slot, low, keyOffset, kLow);
+	EDUBTM_SLOTKEY(data, slot, high, keyOffset, kHigh);
+	edubtm_nProbes += 2;
+
+	if (key < kLow)
+	{
+		*idx = -1;
+		return FALSE;
+	}
+	if (key >= kHigh)
+	{
+		*idx = high;
+		return(key == kHigh);
+	}
+	if (key == kLow)
+	{
+		*idx = low;
+		return TRUE;
+	}
+
+	/* Interpolate the first probe in (low, high). */
+	if (high - low > 1)
+	{
+		mid = low + (Two)(((double)key - kLow) * (high - low) / ((double)kHigh - kLow));
+		if (mid <= low) mid = low+1;
+		if (mid >= high) mid = high-1;
+
+		EDUBTM_SLOTKEY(data, slot, mid, keyOffset, kMid);
+		edubtm_nProbes++;
+
+		if (kMid == key)
+		{
+			*idx = mid;
+			return TRUE;
+		}
+
+		/* Gallop toward the key until it is bracketed. */
+		if (kMid < key)
+		{
+			low = mid;
+			for (step = 1; low + step < high; step *= 2)
+			{
+				EDUBTM_SLOTKEY(data, slot, low+step, keyOffset, kMid);
+				edubtm_nProbes++;
+				if (kMid > key) { high = low+step; break; }
+				low += step;
+				if (kMid == key) { *idx = low; return TRUE; }
+			}
+		}
+		else
+		{
+			high = mid;
+			for (step = 1; high - step > low; step *= 2)
+			{
+				EDUBTM_SLOTKEY(data, slot, high-step, keyOffset, kMid);
+				edubtm_nProbes++;
+				if (kMid <= key)
+				{
+					low = high-step;
+					if (kMid == key) { *idx = low; return TRUE; }
+					break;
+				}
+				high -= step;
+			}
+		}
+	}
+
+	/* Binary search in the bracket. */
+	while (high - low > 1)
+	{
+		mid = (low + high)/2;
+		EDUBTM_SLOTKEY(data, slot, mid, keyOffset, kMid);
+		edubtm_nProbes++;
+
+		if (kMid == key)
+		{
+			*idx = mid;
+			return TRUE;
+		}
+		if (kMid < key) low = mid;
+		else high = mid;
+	}
+
+	*idx = low;
+	return FALSE;
+
+} /* edubtm_InterpolationSearch() */
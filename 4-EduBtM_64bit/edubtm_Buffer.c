@@ -0,0 +1,953 @@
+/******************************************************************************/
+/*                                                                            */
+/*    ODYSSEUS/EduCOSMOS Educational-Purpose Object Storage System            */
+/*                                                                            */
+/*    Developed by Professor Kyu-Young Whang et al.                           */
+/*                                                                            */
+/*    Database and Multimedia Laboratory                                      */
+/*                                                                            */
+/*    Computer Science Department and                                         */
+/*    Advanced Information Technology Research Center (AITrc)                 */
+/*    Korea Advanced Institute of Science and Technology (KAIST)              */
+/*                                                                            */
+/*    e-mail: kywhang@cs.kaist.ac.kr                                          */
+/*    phone: +82-42-350-7722                                                  */
+/*    fax: +82-42-350-8380                                                    */
+/*                                                                            */
+/*    Copyright (c) 1995-2013 by Kyu-Young Whang                              */
+/*                                                                            */
+/*    All rights reserved. No part of this software may be reproduced,        */
+/*    stored in a retrieval system, or transmitted, in any form or by any     */
+/*    means, electronic, mechanical, photocopying, recording, or otherwise,   */
+/*    without prior written permission of the copyright owner.                */
+/*                                                                            */
+/******************************************************************************/
+/*
+ * Module: edubtm_Buffer.c
+ *
+ * Description:
+ *  Message buffers of the B-epsilon indexes, i.e., the indexes whose key
+ *  descriptor has KEYFLAG_BUFFERED. An insertion or a deletion is put into
+ *  the message buffer of the root page as a message. When a buffer is full,
+ *  the messages for the child having the most bytes of messages are moved
+ *  down to the child together; so a leaf page is fixed once for a batch of
+ *  updates instead of once for each update.
+ *
+ *  The messages are blind: they are put without looking at the leaves, and
+ *  the leaf decides their effect. An insertion whose key is already in the
+ *  leaf is dropped, and so is a deletion whose key and ObjectID are not.
+ *  A message in a page is always newer than the messages and the entries
+ *  in the pages below it, and the messages in a page are kept in the order
+ *  of arrival. So the search for a key applies the messages of each page
+ *  on the way back from the leaf, the oldest first, in the same way.
+ *
+ * Exports:
+ *  void edubtm_InitMsgBuffer(BtreeInternal*)
+ *  Four edubtm_PutMessage(ObjectID*, PageID*, KeyDesc*, Two, KeyValue*, ObjectID*,
+ *                         Pool*, DeallocListElem*)
+ *  Four edubtm_PushMessage(ObjectID*, PageID*, KeyDesc*, Two, KeyValue*, ObjectID*,
+ *                          Boolean*, Boolean*, InternalItem*, Pool*, DeallocListElem*)
+ *  Four edubtm_SplitMessages(BtreeInternal*, KeyDesc*, InternalItem*)
+ *  Four edubtm_BufferedLookup(PageID*, KeyDesc*, KeyValue*, Boolean*, ObjectID*)
+ *  Four edubtm_BufferedNext(PageID*, KeyDesc*, KeyValue*, Boolean, Boolean*,
+ *                           KeyValue*, ObjectID*)
+ */
+
+
+#include <string.h>
+#include "EduBtM_common.h"
+#include "BfM.h"
+#include "EduBtM_Internal.h"
+
+
+/*@ Internal Function Prototypes */
+ShortPageID edubtm_ChildPage(BtreeInternal*, KeyDesc*, KeyValue*);
+void edubtm_AppendMessage(BtreeInternal*, btm_Message*);
+Boolean edubtm_CancelMessage(BtreeInternal*, KeyDesc*, btm_Message*);
+Two edubtm_TakeBatch(BtreeInternal*, KeyDesc*, char*);
+Four edubtm_ApplyMessages(ObjectID*, BtreeInternal*, KeyDesc*, char*, Two, Two*,
+                          Boolean*, InternalItem*, Pool*, DeallocListElem*);
+Four edubtm_NextCandidate(PageID*, KeyDesc*, KeyValue*, Boolean, Boolean*, KeyValue*);
+
+
+/* maximum # of messages in a message buffer */
+#define BI_MAXMSGS (BI_MSGBUFSIZE / (CONSTANT_CASTING_TYPE)BTM_MSGLEN(0))
+
+
+
+/*@================================
+ * edubtm_InitMsgBuffer()
+ *================================*/
+/*
+ * Function: void edubtm_InitMsgBuffer(BtreeInternal*)
+ *
+ * Description:
+ *  Make an empty message buffer of BI_MSGBUFSIZE bytes at the beginning of
+ *  the data area of the given internal page. The entries are moved behind
+ *  the buffer. Nothing is done if the page already has a buffer.
+ *
+ * Returns:
+ *  None
+ *
+ * Note:
+ *  The page should have BI_MSGBUFSIZE bytes of contiguous free space, which
+ *  holds for the new root page made by edubtm_root_insert().
+ */
+void edubtm_InitMsgBuffer(
+    BtreeInternal       *page)          /* INOUT internal page */
+{
+    Two                 i;              /* slot No. */
+
+
+	if (page->hdr.reserved > 0) return;
+
+	memmove(page->data + BI_MSGBUFSIZE, page->data, page->hdr.free);
+	for (i = 0; i < page->hdr.nSlots; i++)
+		page->slot[-1*i] += BI_MSGBUFSIZE;
+
+	page->hdr.free += BI_MSGBUFSIZE;
+	page->hdr.reserved = BI_MSGBUFSIZE;
+	BI_MSGHDR(page)->used = 0;
+	BI_MSGHDR(page)->nMsgs = 0;
+
+} /* edubtm_InitMsgBuffer() */
+
+
+
+/*@================================
+ * edubtm_PutMessage()
+ *================================*/
+/*
+ * Function: Four edubtm_PutMessage(ObjectID*, PageID*, KeyDesc*, Two, KeyValue*,
+ *                                  ObjectID*, Pool*, DeallocListElem*)
+ *
+ * Description:
+ *  Put an insert/delete message into the B-epsilon tree given by 'root'.
+ *  When the root page is splitted before the message is accepted, a new
+ *  root is made and the message is given again from the new root.
+ *
+ * Returns:
+ *  Error code
+ *    some errors caused by function calls
+ *
+ * Note:
+ *  The caller checks that the message is valid: the key of an insertion is
+ *  not in the index and the key and the ObjectID of a deletion are in it.
+ */
+Four edubtm_PutMessage(
+    ObjectID            *catObjForFile, /* IN catalog object of B+ tree file */
+    PageID              *root,          /* IN root of the B-epsilon tree */
+    KeyDesc             *kdesc,         /* IN key descriptor */
+    Two                 op,             /* IN BTM_MSG_INSERT or BTM_MSG_DELETE */
+    KeyValue            *kval,          /* IN key value */
+    ObjectID            *oid,           /* IN ObjectID */
+    Pool                *dlPool,        /* INOUT pool of dealloc list */
+    DeallocListElem     *dlHead)        /* INOUT head of the dealloc list */
+{
+    Four                e;              /* error number */
+    Boolean             done;           /* TRUE if the message is accepted */
+    Boolean             h;              /* TRUE if the root page is splitted */
+    InternalItem        item;           /* internal item for the new root */
+    BtreeInternal       *rpage;         /* pointer to the buffer of the root page */
+
+
+	do
+	{
+		e = edubtm_PushMessage(catObjForFile, root, kdesc, op, kval, oid, &done, &h, &item, dlPool, dlHead);
+		if (e < 0) ERR(e);
+
+		if (h == TRUE)
+		{
+			e = edubtm_root_insert(catObjForFile, root, &item);
+			if (e < 0) ERR(e);
+
+			// The new root buffers the messages, too.
+			e = edubtm_GetTrain(root, &rpage, PAGE_BUF);
+			if (e < 0) ERR(e);
+
+			edubtm_InitMsgBuffer(rpage);
+
+			e = BfM_SetDirty(root, PAGE_BUF);
+			if (e < 0) ERRB1(e, root, PAGE_BUF);
+
+			e = BfM_FreeTrain(root, PAGE_BUF);
+			if (e < 0) ERR(e);
+		}
+	} while (done == FALSE);
+
+
+    return(eNOERROR);
+
+} /* edubtm_PutMessage() */
+
+
+
+/*@================================
+ * edubtm_PushMessage()
+ *================================*/
+/*
+ * Function: Four edubtm_PushMessage(ObjectID*, PageID*, KeyDesc*, Two, KeyValue*,
+ *                                   ObjectID*, Boolean*, Boolean*, InternalItem*,
+ *                                   Pool*, DeallocListElem*)
+ *
+ * Description:
+ *  Give a message to the subtree given by 'root'. A leaf page applies the
+ *  message at once. A buffered internal page appends it to the message
+ *  buffer; if the buffer has no room, batches of messages are moved down to
+ *  the children until it has. An internal page without a buffer passes the
+ *  message to the child.
+ *
+ *  In a unique index, a deletion cancels the insertion of the same key and
+ *  ObjectID waiting in the buffer instead of being appended. The insertion
+ *  was checked then, so the key is in no page below; in other indexes the
+ *  same pair may be in the leaf already, and the deletion has to reach it.
+ *
+ *  If the page is splitted while the messages are moved down, the rest of
+ *  the batch is put back, the messages are divided between the two pages,
+ *  and the given message is not accepted; the caller gives it again after
+ *  inserting 'item'.
+ *
+ * Returns:
+ *  Error code
+ *    some errors caused by function calls
+ *
+ * Side effects:
+ *  1) done : TRUE if the message is accepted
+ *  2) h    : TRUE if the page is splitted
+ *  3) item : internal item to be inserted into the parent if 'h' is TRUE
+ */
+Four edubtm_PushMessage(
+    ObjectID            *catObjForFile, /* IN catalog object of B+ tree file */
+    PageID              *root,          /* IN root of the subtree */
+    KeyDesc             *kdesc,         /* IN key descriptor */
+    Two                 op,             /* IN BTM_MSG_INSERT or BTM_MSG_DELETE */
+    KeyValue            *kval,          /* IN key value */
+    ObjectID            *oid,           /* IN ObjectID */
+    Boolean             *done,          /* OUT TRUE if the message is accepted */
+    Boolean             *h,             /* OUT whether the page is splitted */
+    InternalItem        *item,          /* OUT internal item which will be inserted */
+                                        /*     into the parent when 'h' is TRUE */
+    Pool                *dlPool,        /* INOUT pool of dealloc list */
+    DeallocListElem     *dlHead)        /* INOUT head of the dealloc list */
+{
+    Four                e;              /* error number */
+    Boolean             lf;             /* local 'f' */
+    Boolean             lh;             /* local 'h' */
+    Boolean             found;          /* TRUE if the key is in the leaf */
+    Two                 idx;            /* slot No. of the key in the leaf */
+    ObjectID            tOid;           /* ObjectID of the key in the leaf */
+    BtreePage           *apage;         /* pointer to the buffer of the root page */
+    btm_LeafEntry       *lEntry;        /* a leaf entry */
+    PhysicalFileID      pFid;           /* B+-tree file's FileID */
+    char                mbuf[BTM_MSGLEN(MAXKEYLEN)];   /* the given message */
+    btm_Message         *msg;           /* the given message */
+    Two                 msgLen;         /* length of the given message */
+    char                batch[BI_MSGBUFSIZE];   /* messages moved down together */
+    Two                 batchLen;       /* length of the batch */
+    Two                 applied;        /* length of the applied part of the batch */
+    Two                 offset;         /* offset of a message in the batch */
+
+
+    /*@ Initially the flags are FALSE */
+    *done = *h = FALSE;
+
+	e = edubtm_GetTrain(root, &apage, PAGE_BUF);
+	if (e < 0) ERR(e);
+
+	if (apage->any.hdr.type & LEAF)
+	{
+		found = edubtm_BinarySearchLeaf(&apage->bl, kdesc, kval, &idx);
+		if (found == TRUE)
+		{
+			lEntry = apage->bl.data + apage->bl.slot[-1*idx];
+			edubtm_GetOid(&apage->bl, lEntry, &tOid);
+		}
+
+		// An insertion of a key in the leaf and a deletion of a pair not in it are dropped.
+		if (op == BTM_MSG_INSERT && found == FALSE)
+		{
+			e = edubtm_InsertLeaf(catObjForFile, root, &apage->bl, kdesc, kval, oid, NULL, &lf, h, item);
+			if (e < 0) ERRB1(e, root, PAGE_BUF);
+		}
+		else if (op == BTM_MSG_DELETE && found == TRUE && tOid.pageNo == oid->pageNo && tOid.volNo == oid->volNo
+		         && tOid.slotNo == oid->slotNo && tOid.unique == oid->unique)
+		{
+			// Leaves are not merged; an empty leaf stays until the index is dropped.
+			MAKE_PAGEID(pFid, catObjForFile->volNo, catObjForFile->pageNo);
+			e = edubtm_DeleteLeaf(&pFid, root, &apage->bl, kdesc, kval, oid, &lf, &lh, item, dlPool, dlHead);
+			if (e < 0) ERRB1(e, root, PAGE_BUF);
+		}
+		*done = TRUE;
+	}
+	else if (apage->any.hdr.type & INTERNAL)
+	{
+		// Make the message.
+		msg = (btm_Message*)mbuf;
+		msg->op = op;
+		msg->klen = kval->len;
+		memcpy(msg->kval, kval->val, kval->len);
+		memcpy(msg->kval + ALIGNED_LENGTH(msg->klen), oid, sizeof(ObjectID));
+		msgLen = BTM_MSGLEN(msg->klen);
+
+		if (apage->bi.hdr.reserved == 0)
+		{
+			e = edubtm_ApplyMessages(catObjForFile, &apage->bi, kdesc, mbuf, msgLen, &applied, h, item, dlPool, dlHead);
+			if (e < 0) ERRB1(e, root, PAGE_BUF);
+
+			*done = (applied == msgLen);
+		}
+		else if (op == BTM_MSG_DELETE && (kdesc->flag & KEYFLAG_UNIQUE) && edubtm_CancelMessage(&apage->bi, kdesc, msg))
+		{
+			*done = TRUE;
+		}
+		else
+		{
+			while (BI_MSGFREE(&apage->bi) < msgLen)
+			{
+				batchLen = edubtm_TakeBatch(&apage->bi, kdesc, batch);
+
+				e = edubtm_ApplyMessages(catObjForFile, &apage->bi, kdesc, batch, batchLen, &applied, h, item, dlPool, dlHead);
+				if (e < 0) ERRB1(e, root, PAGE_BUF);
+
+				// Put back the messages not applied.
+				for (offset = applied; offset < batchLen; offset += BTM_MSGLEN(((btm_Message*)(batch + offset))->klen))
+					edubtm_AppendMessage(&apage->bi, (btm_Message*)(batch + offset));
+
+				if (*h == TRUE)
+				{
+					e = edubtm_SplitMessages(&apage->bi, kdesc, item);
+					if (e < 0) ERRB1(e, root, PAGE_BUF);
+					break;
+				}
+			}
+
+			if (*h == FALSE)
+			{
+				edubtm_AppendMessage(&apage->bi, msg);
+				*done = TRUE;
+			}
+		}
+	}
+	else
+		ERRB1(eBADBTREEPAGE_BTM, root, PAGE_BUF);
+
+	e = BfM_SetDirty(root, PAGE_BUF);
+	if (e < 0) ERRB1(e, root, PAGE_BUF);
+
+	e = BfM_FreeTrain(root, PAGE_BUF);
+	if (e < 0) ERR(e);
+
+
+    return(eNOERROR);
+
+} /* edubtm_PushMessage() */
+
+
+
+/*@================================
+ * edubtm_SplitMessages()
+ *================================*/
+/*
+ * Function: Four edubtm_SplitMessages(BtreeInternal*, KeyDesc*, InternalItem*)
+ *
+ * Description:
+ *  After the internal page 'fpage' is splitted, move the messages whose keys
+ *  are equal to or greater than the key of 'ritem' into the new page
+ *  'ritem->spid'. The order of the messages is kept in both pages.
+ *
+ * Returns:
+ *  Error code
+ *    some errors caused by function calls
+ */
+Four edubtm_SplitMessages(
+    BtreeInternal       *fpage,         /* INOUT the splitted page */
+    KeyDesc             *kdesc,         /* IN key descriptor */
+    InternalItem        *ritem)         /* IN internal item for the new page */
+{
+    Four                e;              /* error number */
+    PageID              newPid;         /* PageID of the new page */
+    BtreeInternal       *npage;         /* pointer to the buffer of the new page */
+    char                msgs[BI_MSGBUFSIZE];    /* copy of the messages of fpage */
+    Two                 used;           /* length of the messages */
+    Two                 offset;         /* offset of a message */
+    btm_Message         *msg;           /* a message */
+
+
+	if (fpage->hdr.reserved == 0 || BI_MSGHDR(fpage)->nMsgs == 0) return(eNOERROR);
+
+	MAKE_PAGEID(newPid, fpage->hdr.pid.volNo, ritem->spid);
+	e = edubtm_GetTrain(&newPid, &npage, PAGE_BUF);
+	if (e < 0) ERR(e);
+
+	used = BI_MSGHDR(fpage)->used;
+	memcpy(msgs, BI_MSGS(fpage), used);
+	BI_MSGHDR(fpage)->used = 0;
+	BI_MSGHDR(fpage)->nMsgs = 0;
+
+	for (offset = 0; offset < used; offset += BTM_MSGLEN(msg->klen))
+	{
+		msg = (btm_Message*)(msgs + offset);
+		if (edubtm_KeyCompare(kdesc, (KeyValue*)&msg->klen, (KeyValue*)&ritem->klen) == LESS)
+			edubtm_AppendMessage(fpage, msg);
+		else
+			edubtm_AppendMessage(npage, msg);
+	}
+
+	e = BfM_SetDirty(&newPid, PAGE_BUF);
+	if (e < 0) ERRB1(e, &newPid, PAGE_BUF);
+
+	e = BfM_FreeTrain(&newPid, PAGE_BUF);
+	if (e < 0) ERR(e);
+
+
+    return(eNOERROR);
+
+} /* edubtm_SplitMessages() */
+
+
+
+/*@================================
+ * edubtm_BufferedLookup()
+ *================================*/
+/*
+ * Function: Four edubtm_BufferedLookup(PageID*, KeyDesc*, KeyValue*, Boolean*, ObjectID*)
+ *
+ * Description:
+ *  Search the B-epsilon tree for the given key. The leaf gives the first
+ *  result, and then the messages for the key in each page on the path are
+ *  applied to it, from the lowest page up and the oldest message first, in
+ *  the way the leaf will apply them: an insertion counts only if the key is
+ *  not found, and a deletion only if the key is found with its ObjectID.
+ *
+ * Returns:
+ *  Error code
+ *    eBADBTREEPAGE_BTM
+ *    some errors caused by function calls
+ *
+ * Side effects:
+ *  1) found : TRUE if the key is in the index
+ *  2) oid   : ObjectID of the key if found
+ */
+Four edubtm_BufferedLookup(
+    PageID              *root,          /* IN root of the subtree */
+    KeyDesc             *kdesc,         /* IN key descriptor */
+    KeyValue            *kval,          /* IN key value */
+    Boolean             *found,         /* OUT TRUE if the key is found */
+    ObjectID            *oid)           /* OUT ObjectID of the key */
+{
+    Four                e;              /* error number */
+    Two                 idx;            /* slot No. */
+    Two                 offset;         /* offset of a message */
+    PageID              child;          /* child page */
+    BtreePage           *apage;         /* pointer to the buffer of the root page */
+    btm_Message         *msg;           /* a message */
+    ObjectID            mOid;           /* ObjectID of a message */
+    btm_LeafEntry       *lEntry;        /* a leaf entry */
+
+
+	*found = FALSE;
+
+	e = edubtm_GetTrain(root, &apage, PAGE_BUF);
+	if (e < 0) ERR(e);
+
+	if (apage->any.hdr.type & INTERNAL)
+	{
+		MAKE_PAGEID(child, root->volNo, edubtm_ChildPage(&apage->bi, kdesc, kval));
+		e = edubtm_BufferedLookup(&child, kdesc, kval, found, oid);
+		if (e < 0) ERRB1(e, root, PAGE_BUF);
+
+		if (apage->bi.hdr.reserved > 0)
+		{
+			for (offset = 0; offset < BI_MSGHDR(&apage->bi)->used; offset += BTM_MSGLEN(msg->klen))
+			{
+				msg = (btm_Message*)(BI_MSGS(&apage->bi) + offset);
+				if (edubtm_KeyCompare(kdesc, (KeyValue*)&msg->klen, kval) != EQUAL) continue;
+
+				memcpy(&mOid, msg->kval + ALIGNED_LENGTH(msg->klen), sizeof(ObjectID));
+				if (msg->op == BTM_MSG_INSERT && *found == FALSE)
+				{
+					*found = TRUE;
+					*oid = mOid;
+				}
+				else if (msg->op == BTM_MSG_DELETE && *found == TRUE && oid->pageNo == mOid.pageNo && oid->volNo == mOid.volNo
+				         && oid->slotNo == mOid.slotNo && oid->unique == mOid.unique)
+					*found = FALSE;
+			}
+		}
+	}
+	else if (apage->any.hdr.type & LEAF)
+	{
+		if (edubtm_BinarySearchLeaf(&apage->bl, kdesc, kval, &idx) == TRUE)
+		{
+			lEntry = apage->bl.data + apage->bl.slot[-1*idx];
+			edubtm_GetOid(&apage->bl, lEntry, oid);
+			*found = TRUE;
+		}
+	}
+	else
+		ERRB1(eBADBTREEPAGE_BTM, root, PAGE_BUF);
+
+	e = BfM_FreeTrain(root, PAGE_BUF);
+	if (e < 0) ERR(e);
+
+
+    return(eNOERROR);
+
+} /* edubtm_BufferedLookup() */
+
+
+
+/*@================================
+ * edubtm_BufferedNext()
+ *================================*/
+/*
+ * Function: Four edubtm_BufferedNext(PageID*, KeyDesc*, KeyValue*, Boolean,
+ *                                    Boolean*, KeyValue*, ObjectID*)
+ *
+ * Description:
+ *  Find the smallest key in the B-epsilon tree which is greater than (or
+ *  equal to, if 'inclusive' is TRUE) the given key. If 'kval' is NULL, the
+ *  smallest key of the tree is found. A key in a message or a leaf is only a
+ *  candidate; the candidates deleted by newer messages are skipped.
+ *
+ * Returns:
+ *  Error code
+ *    some errors caused by function calls
+ *
+ * Side effects:
+ *  1) found   : TRUE if such a key exists
+ *  2) nextKey : the key found
+ *  3) oid     : ObjectID of the key found
+ */
+Four edubtm_BufferedNext(
+    PageID              *root,          /* IN root of the B-epsilon tree */
+    KeyDesc             *kdesc,         /* IN key descriptor */
+    KeyValue            *kval,          /* IN key value; NULL for the first key */
+    Boolean             inclusive,      /* IN TRUE if 'kval' itself may be returned */
+    Boolean             *found,         /* OUT TRUE if the key is found */
+    KeyValue            *nextKey,       /* OUT the key found */
+    ObjectID            *oid)           /* OUT ObjectID of the key found */
+{
+    Four                e;              /* error number */
+    Boolean             live;           /* TRUE if the candidate is in the index */
+    KeyValue            tKey;           /* a skipped candidate */
+
+
+	for (;;)
+	{
+		e = edubtm_NextCandidate(root, kdesc, kval, inclusive, found, nextKey);
+		if (e < 0) ERR(e);
+		if (*found == FALSE) break;
+
+		e = edubtm_BufferedLookup(root, kdesc, nextKey, &live, oid);
+		if (e < 0) ERR(e);
+		if (live == TRUE) break;
+
+		BTM_COPY_KEY(&tKey, nextKey);
+		kval = &tKey;
+		inclusive = FALSE;
+	}
+
+
+    return(eNOERROR);
+
+} /* edubtm_BufferedNext() */
+
+
+
+/*@================================
+ * edubtm_NextCandidate()
+ *================================*/
+/*
+ * Function: Four edubtm_NextCandidate(PageID*, KeyDesc*, KeyValue*, Boolean, Boolean*, KeyValue*)
+ *
+ * Description:
+ *  Find the smallest key after 'kval' among the messages and the leaf
+ *  entries of the subtree given by 'root', whether it is deleted or not.
+ *  The children are visited from the one 'kval' belongs to until a key is
+ *  found or the children cannot have a key smaller than the messages.
+ *
+ * Returns:
+ *  Error code
+ *    eBADBTREEPAGE_BTM
+ *    some errors caused by function calls
+ */
+Four edubtm_NextCandidate(
+    PageID              *root,          /* IN root of the subtree */
+    KeyDesc             *kdesc,         /* IN key descriptor */
+    KeyValue            *kval,          /* IN key value; NULL for the first key */
+    Boolean             inclusive,      /* IN TRUE if 'kval' itself may be returned */
+    Boolean             *found,         /* OUT TRUE if a candidate is found */
+    KeyValue            *cand)          /* OUT the candidate */
+{
+    Four                e;              /* error number */
+    Four                cmp;            /* result of comparison */
+    Two                 idx;            /* slot No. */
+    Two                 offset;         /* offset of a message */
+    Boolean             cfound;         /* TRUE if the child has a candidate */
+    KeyValue            ckey;           /* candidate of the child */
+    PageID              child;          /* child page */
+    BtreePage           *apage;         /* pointer to the buffer of the root page */
+    btm_Message         *msg;           /* a message */
+    btm_InternalEntry   *iEntry;        /* an internal entry */
+    btm_LeafEntry       *lEntry;        /* a leaf entry */
+
+
+	*found = FALSE;
+
+	e = edubtm_GetTrain(root, &apage, PAGE_BUF);
+	if (e < 0) ERR(e);
+
+	if (apage->any.hdr.type & INTERNAL)
+	{
+		// The smallest key after 'kval' in the messages.
+		if (apage->bi.hdr.reserved > 0)
+		{
+			for (offset = 0; offset < BI_MSGHDR(&apage->bi)->used; offset += BTM_MSGLEN(msg->klen))
+			{
+				msg = (btm_Message*)(BI_MSGS(&apage->bi) + offset);
+				if (kval != NULL)
+				{
+					cmp = edubtm_KeyCompare(kdesc, (KeyValue*)&msg->klen, kval);
+					if (cmp == LESS || (cmp == EQUAL && !inclusive)) continue;
+				}
+				if (*found == FALSE || edubtm_KeyCompare(kdesc, (KeyValue*)&msg->klen, cand) == LESS)
+				{
+					cand->len = msg->klen;
+					memcpy(cand->val, msg->kval, msg->klen);
+					*found = TRUE;
+				}
+			}
+		}
+
+		// The first child having a key after 'kval'.
+		if (kval == NULL)
+			idx = -1;
+		else
+			edubtm_BinarySearchInternal(&apage->bi, kdesc, kval, &idx);
+		for ( ; idx < apage->bi.hdr.nSlots; idx++)
+		{
+			if (idx >= 0)
+			{
+				iEntry = apage->bi.data + apage->bi.slot[-1*idx];
+				if (*found == TRUE && edubtm_KeyCompare(kdesc, cand, (KeyValue*)&iEntry->klen) == LESS) break;
+				MAKE_PAGEID(child, root->volNo, iEntry->spid);
+			}
+			else
+				MAKE_PAGEID(child, root->volNo, apage->bi.hdr.p0);
+
+			e = edubtm_NextCandidate(&child, kdesc, kval, inclusive, &cfound, &ckey);
+			if (e < 0) ERRB1(e, root, PAGE_BUF);
+
+			if (cfound == TRUE)
+			{
+				if (*found == FALSE || edubtm_KeyCompare(kdesc, &ckey, cand) == LESS)
+					*cand = ckey;
+				*found = TRUE;
+				break;
+			}
+		}
+	}
+	else if (apage->any.hdr.type & LEAF)
+	{
+		if (kval == NULL)
+			idx = 0;
+		else if (edubtm_BinarySearchLeaf(&apage->bl, kdesc, kval, &idx) == FALSE || !inclusive)
+			idx++;
+
+		if (idx < apage->bl.hdr.nSlots)
+		{
+			lEntry = apage->bl.data + apage->bl.slot[-1*idx];
+			cand->len = lEntry->klen;
+			memcpy(cand->val, lEntry->kval, lEntry->klen);
+			*found = TRUE;
+		}
+	}
+	else
+		ERRB1(eBADBTREEPAGE_BTM, root, PAGE_BUF);
+
+	e = BfM_FreeTrain(root, PAGE_BUF);
+	if (e < 0) ERR(e);
+
+
+    return(eNOERROR);
+
+} /* edubtm_NextCandidate() */
+
+
+
+/*@================================
+ * edubtm_ChildPage()
+ *================================*/
+/*
+ * Function: ShortPageID edubtm_ChildPage(BtreeInternal*, KeyDesc*, KeyValue*)
+ *
+ * Description:
+ *  Return the child page of the given internal page which the given key
+ *  belongs to.
+ *
+ * Returns:
+ *  page number of the child
+ */
+ShortPageID edubtm_ChildPage(
+    BtreeInternal       *page,          /* IN internal page */
+    KeyDesc             *kdesc,         /* IN key descriptor */
+    KeyValue            *kval)          /* IN key value */
+{
+    Two                 idx;            /* slot No. */
+    btm_InternalEntry   *iEntry;        /* an internal entry */
+
+
+	edubtm_BinarySearchInternal(page, kdesc, kval, &idx);
+	if (idx < 0) return(page->hdr.p0);
+
+	iEntry = page->data + page->slot[-1*idx];
+	return(iEntry->spid);
+
+} /* edubtm_ChildPage() */
+
+
+
+/*@================================
+ * edubtm_AppendMessage()
+ *================================*/
+/*
+ * Function: void edubtm_AppendMessage(BtreeInternal*, btm_Message*)
+ *
+ * Description:
+ *  Append the message to the message buffer of the given page.
+ *
+ * Returns:
+ *  None
+ *
+ * Note:
+ *  The caller checks that the buffer has room for the message.
+ */
+void edubtm_AppendMessage(
+    BtreeInternal       *page,          /* INOUT internal page */
+    btm_Message         *msg)           /* IN message to append */
+{
+    Two                 len;            /* length of the message */
+
+
+	len = BTM_MSGLEN(msg->klen);
+	memcpy(BI_MSGS(page) + BI_MSGHDR(page)->used, msg, len);
+	BI_MSGHDR(page)->used += len;
+	BI_MSGHDR(page)->nMsgs++;
+
+} /* edubtm_AppendMessage() */
+
+
+
+/*@================================
+ * edubtm_CancelMessage()
+ *================================*/
+/*
+ * Function: Boolean edubtm_CancelMessage(BtreeInternal*, KeyDesc*, btm_Message*)
+ *
+ * Description:
+ *  If the newest message for the key of the given deletion is the insertion
+ *  of the same ObjectID, remove the insertion from the buffer; both of them
+ *  have no effect on the index.
+ *
+ * Returns:
+ *  TRUE if the insertion is removed
+ */
+Boolean edubtm_CancelMessage(
+    BtreeInternal       *page,          /* INOUT internal page */
+    KeyDesc             *kdesc,         /* IN key descriptor */
+    btm_Message         *msg)           /* IN deletion message */
+{
+    Two                 offset;         /* offset of a message */
+    Two                 newest;         /* offset of the newest message for the key */
+    Two                 len;            /* length of the message */
+    btm_Message         *m;             /* a message */
+    ObjectID            *oid;           /* ObjectID of the deletion */
+    ObjectID            tOid;           /* ObjectID of the insertion */
+
+
+	newest = NIL;
+	for (offset = 0; offset < BI_MSGHDR(page)->used; offset += BTM_MSGLEN(m->klen))
+	{
+		m = (btm_Message*)(BI_MSGS(page) + offset);
+		if (edubtm_KeyCompare(kdesc, (KeyValue*)&m->klen, (KeyValue*)&msg->klen) == EQUAL)
+			newest = offset;
+	}
+	if (newest == NIL) return(FALSE);
+
+	m = (btm_Message*)(BI_MSGS(page) + newest);
+	if (m->op != BTM_MSG_INSERT) return(FALSE);
+
+	oid = (ObjectID*)(msg->kval + ALIGNED_LENGTH(msg->klen));
+	memcpy(&tOid, m->kval + ALIGNED_LENGTH(m->klen), sizeof(ObjectID));
+	if (tOid.pageNo != oid->pageNo || tOid.volNo != oid->volNo
+			|| tOid.slotNo != oid->slotNo || tOid.unique != oid->unique)
+		return(FALSE);
+
+	len = BTM_MSGLEN(m->klen);
+	memmove(BI_MSGS(page) + newest, BI_MSGS(page) + newest + len, BI_MSGHDR(page)->used - newest - len);
+	BI_MSGHDR(page)->used -= len;
+	BI_MSGHDR(page)->nMsgs--;
+
+	return(TRUE);
+
+} /* edubtm_CancelMessage() */
+
+
+
+/*@================================
+ * edubtm_TakeBatch()
+ *================================*/
+/*
+ * Function: Two edubtm_TakeBatch(BtreeInternal*, KeyDesc*, char*)
+ *
+ * Description:
+ *  Remove from the message buffer the messages for the child which has the
+ *  most bytes of messages, and copy them into 'batch' in the order of
+ *  arrival.
+ *
+ * Returns:
+ *  length of the batch
+ */
+Two edubtm_TakeBatch(
+    BtreeInternal       *page,          /* INOUT internal page */
+    KeyDesc             *kdesc,         /* IN key descriptor */
+    char                *batch)         /* OUT messages for the child */
+{
+    Two                 i, j;           /* indices of messages */
+    Two                 n;              /* # of messages */
+    Two                 offset;         /* offset of a message */
+    Two                 kept;           /* length of the messages kept in the buffer */
+    Two                 batchLen;       /* length of the batch */
+    Four                load;           /* bytes of messages for a child */
+    Four                maxLoad;        /* the most bytes of messages for a child */
+    ShortPageID         target;         /* the child having the most messages */
+    ShortPageID         child[BI_MAXMSGS];      /* child of each message */
+    Two                 len[BI_MAXMSGS];        /* length of each message */
+    btm_Message         *msg;           /* a message */
+
+
+	// Find the child of each message.
+	n = 0;
+	for (offset = 0; offset < BI_MSGHDR(page)->used; offset += len[n++])
+	{
+		msg = (btm_Message*)(BI_MSGS(page) + offset);
+		child[n] = edubtm_ChildPage(page, kdesc, (KeyValue*)&msg->klen);
+		len[n] = BTM_MSGLEN(msg->klen);
+	}
+
+	// Choose the child having the most bytes of messages.
+	maxLoad = 0;
+	target = NIL;
+	for (i = 0; i < n; i++)
+	{
+		for (load = 0, j = 0; j < n; j++)
+			if (child[j] == child[i]) load += len[j];
+		if (load > maxLoad)
+		{
+			maxLoad = load;
+			target = child[i];
+		}
+	}
+
+	// Move the messages of the child into the batch, keeping the others.
+	kept = batchLen = 0;
+	for (offset = 0, i = 0; i < n; offset += len[i++])
+	{
+		if (child[i] == target)
+		{
+			memcpy(batch + batchLen, BI_MSGS(page) + offset, len[i]);
+			batchLen += len[i];
+			BI_MSGHDR(page)->nMsgs--;
+		}
+		else
+		{
+			memmove(BI_MSGS(page) + kept, BI_MSGS(page) + offset, len[i]);
+			kept += len[i];
+		}
+	}
+	BI_MSGHDR(page)->used = kept;
+
+	return(batchLen);
+
+} /* edubtm_TakeBatch() */
+
+
+
+/*@================================
+ * edubtm_ApplyMessages()
+ *================================*/
+/*
+ * Function: Four edubtm_ApplyMessages(ObjectID*, BtreeInternal*, KeyDesc*, char*, Two, Two*,
+ *                                     Boolean*, InternalItem*, Pool*, DeallocListElem*)
+ *
+ * Description:
+ *  Give the messages to the children of the given internal page in order.
+ *  The child of each message is found again, because a child may be
+ *  splitted by an earlier message. When a child is splitted, the new
+ *  internal item is inserted into the page; if the page itself is splitted,
+ *  the rest of the messages are not given.
+ *
+ * Returns:
+ *  Error code
+ *    some errors caused by function calls
+ *
+ * Side effects:
+ *  1) applied : length of the leading messages accepted by the children
+ *  2) h       : TRUE if the page is splitted
+ *  3) item    : internal item to be inserted into the parent if 'h' is TRUE
+ */
+Four edubtm_ApplyMessages(
+    ObjectID            *catObjForFile, /* IN catalog object of B+ tree file */
+    BtreeInternal       *page,          /* INOUT internal page */
+    KeyDesc             *kdesc,         /* IN key descriptor */
+    char                *msgs,          /* IN messages */
+    Two                 msgsLen,        /* IN length of the messages */
+    Two                 *applied,       /* OUT length of the accepted messages */
+    Boolean             *h,             /* OUT whether the page is splitted */
+    InternalItem        *item,          /* OUT internal item for the parent */
+    Pool                *dlPool,        /* INOUT pool of dealloc list */
+    DeallocListElem     *dlHead)        /* INOUT head of the dealloc list */
+{
+    Four                e;              /* error number */
+    Two                 idx;            /* slot No. for the new internal item */
+    Boolean             ldone;          /* TRUE if the child accepts the message */
+    Boolean             lh;             /* TRUE if the child is splitted */
+    InternalItem        litem;          /* internal item for the splitted child */
+    PageID              child;          /* child page */
+    KeyValue            tKey;           /* key of the message */
+    ObjectID            tOid;           /* ObjectID of the message */
+    btm_Message         *msg;           /* a message */
+
+
+	*h = FALSE;
+	*applied = 0;
+
+	while (*applied < msgsLen)
+	{
+		msg = (btm_Message*)(msgs + *applied);
+		tKey.len = msg->klen;
+		memcpy(tKey.val, msg->kval, msg->klen);
+		memcpy(&tOid, msg->kval + ALIGNED_LENGTH(msg->klen), sizeof(ObjectID));
+
+		MAKE_PAGEID(child, page->hdr.pid.volNo, edubtm_ChildPage(page, kdesc, &tKey));
+		e = edubtm_PushMessage(catObjForFile, &child, kdesc, msg->op, &tKey, &tOid, &ldone, &lh, &litem, dlPool, dlHead);
+		if (e < 0) ERR(e);
+
+		if (ldone == TRUE)
+			*applied += BTM_MSGLEN(msg->klen);
+
+		if (lh == TRUE)
+		{
+			edubtm_BinarySearchInternal(page, kdesc, (KeyValue*)&litem.klen, &idx);
+			e = edubtm_InsertInternal(catObjForFile, page, &litem, idx, h, item);
+			if (e < 0) ERR(e);
+
+			if (*h == TRUE) break;
+		}
+	}
+
+
+    return(eNOERROR);
+
+} /* edubtm_ApplyMessages() */
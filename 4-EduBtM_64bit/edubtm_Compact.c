@@ -35,11 +35,24 @@
  */
 
 
+#include <stdlib.h>
 #include <string.h>
 #include "EduBtM_common.h"
 #include "EduBtM_Internal.h"
 
 
+/* a slot with the offset of its entry; used to visit the entries in the physical order */
+typedef struct {
+    Two offset;                 /* starting offset of the entry */
+    Two slotNo;                 /* slot No. of the entry */
+} btm_SlotOffset;
+
+
+/*@ Internal Function Prototypes */
+Four edubtm_SortSlotsByOffset(Two*, Two, Two, btm_SlotOffset*);
+int edubtm_SlotOffsetCompare(const void*, const void*);
+
+
 
 /*@================================
  * edubtm_CompactInternalPage()
@@ -56,6 +69,13 @@
  *  slot array. To compress out holes, entries must be moved toward the
  *  beginning of the page.
  *
+ *  The entries are visited in the order of their offsets and slid down
+ *  with memmove(), so no copy of the whole page is needed. Only the entry
+ *  of 'slotNo' is saved aside because it goes to the end.
+ *
+ *  The message buffer of a buffered internal page, the first 'hdr.reserved'
+ *  bytes of the data area, is left in place.
+ *
  * Returns:
  *  None
  *
@@ -66,32 +86,37 @@ void edubtm_CompactInternalPage(
     BtreeInternal       *apage,                 /* INOUT internal page to compact */
     Two                 slotNo)                 /* IN slot to go to the boundary of free space */
 {
-    BtreeInternal       tpage;                  /* temporay page used to save the given page */
+    btm_SlotOffset      order[BTM_MAXSLOTS];    /* slots sorted by the offsets of the entries */
+    InternalItem        last;                   /* the entry of 'slotNo' */
     Two                 apageDataOffset;        /* where the next object is to be moved */
     Two                 len;                    /* length of the leaf entry */
     Two                 i;                      /* index variable */
+    Two                 n;                      /* # of entries to move */
     btm_InternalEntry   *entry;                 /* an entry in leaf page */
 
 
-	tpage = *apage;
-	apageDataOffset = 0;
+	if (slotNo != NIL)
+	{
+		entry = (btm_InternalEntry*)&(apage->data[apage->slot[-1*slotNo]]);
+		memcpy(&last, entry, BI_ENTRYLEN(entry));
+	}
 
-	for (i=0; i<apage->hdr.nSlots; i++)
+	n = edubtm_SortSlotsByOffset(apage->slot, apage->hdr.nSlots, slotNo, order);
+	apageDataOffset = apage->hdr.reserved;	/* entries follow the message buffer */
+
+	for (i=0; i<n; i++)
 	{
-		if (i != slotNo)
-		{
-			entry = tpage.data + tpage.slot[-1*i];
-			len = sizeof(ShortPageID) + sizeof(Two) + ALIGNED_LENGTH(entry->klen);
-			memcpy(apage->data + apageDataOffset, entry, len);
-			apage->slot[-1*i] = apageDataOffset;
-			apageDataOffset += len;
-		}
+		entry = (btm_InternalEntry*)&(apage->data[order[i].offset]);
+		len = BI_ENTRYLEN(entry);
+		if (order[i].offset != apageDataOffset)
+			memmove(apage->data + apageDataOffset, entry, len);
+		apage->slot[-1*order[i].slotNo] = apageDataOffset;
+		apageDataOffset += len;
 	}
 	if (slotNo != NIL)
 	{
-		entry = tpage.data + tpage.slot[-1*slotNo];
-		len = sizeof(ShortPageID) + sizeof(Two) + ALIGNED_LENGTH(entry->klen);
-		memcpy(apage->data + apageDataOffset, entry, len);
+		len = BI_ENTRYLEN(&last);
+		memcpy(apage->data + apageDataOffset, &last, len);
 		apage->slot[-1*slotNo] = apageDataOffset;
 		apageDataOffset += len;
 	}
@@ -118,6 +143,8 @@ void edubtm_CompactInternalPage(
  *  slot array. To compress out holes, entries must be moved toward the
  *  beginning of the page.
  *	
+ *  As edubtm_CompactInternalPage(), the entries are moved in place.
+ *
  * Return Values :
  *  None
  *
@@ -128,33 +155,37 @@ void edubtm_CompactLeafPage(
     BtreeLeaf 		*apage,			/* INOUT leaf page to compact */
     Two       		slotNo)			/* IN slot to go to the boundary of free space */
 {	
-    BtreeLeaf 		tpage;			/* temporay page used to save the given page */
+    btm_SlotOffset      order[BTM_MAXSLOTS];    /* slots sorted by the offsets of the entries */
+    char                last[sizeof(LeafItem)+4*BTM_MAXVARINTLEN]; /* the entry of 'slotNo' */
     Two                 apageDataOffset;        /* where the next object is to be moved */
     Two                 len;                    /* length of the leaf entry */
     Two                 i;                      /* index variable */
+    Two                 n;                      /* # of entries to move */
     btm_LeafEntry 	*entry;			/* an entry in leaf page */
-    Two 		alignedKlen;		/* aligned length of the key length */
 
 
-	tpage = *apage;
-	apageDataOffset = 0;
+	if (slotNo != NIL)
+	{
+		entry = (btm_LeafEntry*)&(apage->data[apage->slot[-1*slotNo]]);
+		memcpy(last, entry, BL_ENTRYLEN(apage, entry));
+	}
 
-	for (i=0; i<apage->hdr.nSlots; i++)
+	n = edubtm_SortSlotsByOffset(apage->slot, apage->hdr.nSlots, slotNo, order);
+	apageDataOffset = BL_DATASTART(apage);
+
+	for (i=0; i<n; i++)
 	{
-		if (i != slotNo)
-		{
-			entry = tpage.data + tpage.slot[-1*i];
-			len = 2*sizeof(Two) + ALIGNED_LENGTH(entry->klen) + sizeof(ObjectID);
-			memcpy(apage->data + apageDataOffset, entry, len);
-			apage->slot[-1*i] = apageDataOffset;
-			apageDataOffset += len;
-		}
+		entry = (btm_LeafEntry*)&(apage->data[order[i].offset]);
+		len = BL_ENTRYLEN(apage, entry);
+		if (order[i].offset != apageDataOffset)
+			memmove(apage->data + apageDataOffset, entry, len);
+		apage->slot[-1*order[i].slotNo] = apageDataOffset;
+		apageDataOffset += len;
 	}
 	if (slotNo != NIL)
 	{
-		entry = tpage.data + tpage.slot[-1*slotNo];
-		len = 2*sizeof(Two) + ALIGNED_LENGTH(entry->klen) + sizeof(ObjectID);
-		memcpy(apage->data + apageDataOffset, entry, len);
+		len = BL_ENTRYLEN(apage, (btm_LeafEntry*)last);
+		memcpy(apage->data + apageDataOffset, last, len);
 		apage->slot[-1*slotNo] = apageDataOffset;
 		apageDataOffset += len;
 	}
@@ -163,3 +194,62 @@ void edubtm_CompactLeafPage(
 	apage->hdr.unused = 0;
 
 } /* edubtm_CompactLeafPage() */
+
+
+
+/*@================================
+ * edubtm_SortSlotsByOffset()
+ *================================*/
+/*
+ * Function: Four edubtm_SortSlotsByOffset(Two*, Two, Two, btm_SlotOffset*)
+ *
+ * Description:
+ *  Collect the slots except 'slotNo' into 'order' sorted by the offsets of
+ *  their entries. Moving the entries down in this order never overwrites
+ *  an entry which is not moved yet.
+ *
+ * Returns:
+ *  # of slots collected
+ */
+Four edubtm_SortSlotsByOffset(
+    Two                 *slot,                  /* IN the first slot of the page */
+    Two                 nSlots,                 /* IN # of slots of the page */
+    Two                 slotNo,                 /* IN slot to exclude */
+    btm_SlotOffset      *order)                 /* OUT slots sorted by the offsets */
+{
+    Two                 i;                      /* index variable */
+    Two                 n = 0;                  /* # of slots collected */
+
+
+	for (i=0; i<nSlots; i++)
+	{
+		if (i == slotNo) continue;
+		order[n].offset = slot[-1*i];
+		order[n].slotNo = i;
+		n++;
+	}
+
+	qsort(order, n, sizeof(btm_SlotOffset), edubtm_SlotOffsetCompare);
+
+	return(n);
+
+} /* edubtm_SortSlotsByOffset() */
+
+
+
+/*@================================
+ * edubtm_SlotOffsetCompare()
+ *================================*/
+/*
+ * Function: int edubtm_SlotOffsetCompare(const void*, const void*)
+ *
+ * Description:
+ *  qsort() comparator of btm_SlotOffset by the offset.
+ */
+int edubtm_SlotOffsetCompare(
+    const void          *a,                     /* IN a slot */
+    const void          *b)                     /* IN another slot */
+{
+	return(((btm_SlotOffset*)a)->offset - ((btm_SlotOffset*)b)->offset);
+
+} /* edubtm_SlotOffsetCompare() */
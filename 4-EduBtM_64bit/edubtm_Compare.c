@@ -103,9 +103,9 @@ Four edubtm_KeyCompare(
 			memcpy(&len1, &left[j], sizeof(Two));
 			memcpy(&len2, &right[k], sizeof(Two));
 
-			if (strcmp(&left[j+sizeof(Two)], &right[j+sizeof(Two)]) > 0)
+			if (strcmp(&left[j+sizeof(Two)], &right[k+sizeof(Two)]) > 0)
 				return (GREAT);
-			else if (strcmp(&left[j+sizeof(Two)], &right[j+sizeof(Two)]) < 0)
+			else if (strcmp(&left[j+sizeof(Two)], &right[k+sizeof(Two)]) < 0)
 				return (LESS);
 			
 			j += sizeof(Two) + len1;
@@ -32,7 +32,14 @@
  *  recursively calls itself using the child as a root page. If the filled
  *  area of the child page is less than half of the page, it should merge
  *  or redistribute using the given root, and set the flag 'f' according to
- *  the result status of the given root page.
+ *  the result status of the given root page. The merge and the
+ *  redistribution are done by edubtm_Underflow().
+ *
+ *  KEYFLAG_MERGEQUARTER and KEYFLAG_FREEEMPTY in the key descriptor lower
+ *  the threshold to a quarter of the page or to an empty page, which keeps
+ *  the pages from being merged and splitted again and again under mixed
+ *  insertions and deletions. The pages left underfull are merged later by
+ *  the merge phase of EduBtM_Reorganize(); see BTM_LEAF_UNDERFULL().
  *
  *  If the root page is a leaf page , it find out the correct node (entry)
  *  using the binary search routine.  If the entry is normal,  it simply
@@ -51,6 +58,8 @@
  * Exports:
  *  Four edubtm_Delete(ObjectID*, PageID*, KeyDesc*, KeyValue*, ObjectID*,
  *                  Boolean*, Boolean*, InternalItem*, Pool*, DeallocListElem*)
+ *  Four edubtm_DeleteLeaf(PhysicalFileID*, PageID*, BtreeLeaf*, KeyDesc*, KeyValue*,
+ *                      ObjectID*, Boolean*, Boolean*, InternalItem*, Pool*, DeallocListElem*)
  *
  */
 
@@ -63,11 +72,6 @@
 #include "EduBtM_Internal.h"
 
 
-/*@ Internal Function Prototypes */
-Four edubtm_DeleteLeaf(PhysicalFileID*, PageID*, BtreeLeaf*, KeyDesc*, KeyValue*, ObjectID*,
-		    Boolean*, Boolean*, InternalItem*, Pool*, DeallocListElem*);
-
-
 
 /*@================================
  * edubtm_Delete()
@@ -128,7 +132,7 @@ Four edubtm_Delete(
         
     *h = *f = FALSE;
     
-	e = BfM_GetTrain(root, &apage, PAGE_BUF);
+	e = edubtm_GetTrain(root, &apage, PAGE_BUF);
 	if (e < 0) ERR(e);
 
 	/* If root page is internal page */
@@ -149,34 +153,41 @@ Four edubtm_Delete(
 
 		// Delete from the child page (child).
 		lf = lh = FALSE;
+		edubtm_traceDepth++;
 		e = edubtm_Delete(catObjForFile, &child, kdesc, kval, oid, &lf, &lh, &litem, dlPool, dlHead);
-		if (e < 0) ERR(e);
+		edubtm_traceDepth--;
+		if (e < 0) ERRB1(e, root, PAGE_BUF);
 	
-		if (lf == TRUE)
+		// The child's redistribution splitted the child.
+		if (lh == TRUE)
 		{
-			MAKE_PAGEID(pFid, catObjForFile->volNo, catObjForFile->pageNo);
-			lf = lh = FALSE;
-			btm_Underflow(&pFid, apage, &child, idx, &lf, &lh, &litem, dlPool, dlHead);
+			edubtm_BinarySearchInternal(&apage->bi, kdesc, (KeyValue*)&litem.klen, &idx);
+			e = edubtm_InsertInternal(catObjForFile, &apage->bi, &litem, idx, h, item);
+			if (e < 0) ERRB1(e, root, PAGE_BUF);
 
-			if (lh == TRUE)
-			{
-				memcpy(&tKey, &litem.klen, sizeof(KeyValue));
-				if (btm_BinarySearchInternal(apage, kdesc, &tKey, &idx) == FALSE)
-					return (eNOTFOUND_BTM);
+			e = BfM_SetDirty(root, PAGE_BUF);
+			if (e < 0) ERRB1(e, root, PAGE_BUF);
+		}
+		else if (lf == TRUE)
+		{
+			/* the siblings fixed by edubtm_Underflow() are at the child's level */
+			edubtm_traceDepth++;
+			e = edubtm_Underflow(catObjForFile, &apage->bi, &child, idx, f, h, item, dlPool, dlHead);
+			edubtm_traceDepth--;
+			if (e < 0) ERRB1(e, root, PAGE_BUF);
 
-				e = edubtm_InsertInternal(catObjForFile, apage, &litem, idx, h, item);
-				if (e < 0) ERR(e);
-			}
+			// The delete policy of the index may leave the page as it is.
+			if (*f == TRUE) *f = BTM_INTERNAL_UNDERFULL(kdesc, &apage->bi);
 
 			e = BfM_SetDirty(root, PAGE_BUF);
-			if (e < 0) ERR(e);
+			if (e < 0) ERRB1(e, root, PAGE_BUF);
 		}
 	}
 	/* If root page is leaf page */
 	else if (apage->any.hdr.type & LEAF)
 	{
 		e = edubtm_DeleteLeaf(catObjForFile, root, apage, kdesc, kval, oid, f, h, item, dlPool, dlHead);
-		if (e < 0) ERR(e);
+		if (e < 0) ERRB1(e, root, PAGE_BUF);
 	}
 
 
@@ -242,8 +253,6 @@ Four edubtm_DeleteLeaf(
     Two                         alignedKlen;    /* aligned length of the key length */
     PageID                      ovPid;          /* overflow page's PageID */
     DeallocListElem             *dlElem;        /* an element of the dealloc list */
-	Two							freeOffset;
-	Two							oldFree;
 
     /* Error check whether using not supported functionality by EduBtM */
     for (i=0; i<kdesc->nparts; i++)
@@ -252,40 +261,21 @@ Four edubtm_DeleteLeaf(
             ERR(eNOTSUPPORTED_EDUBTM);
     }
 
-	oldFree = apage->hdr.free;
-	apage->hdr.free = 0;
-	for (i=0; i<apage->hdr.nSlots; i++)
-	{
-		lEntry = apage->data + apage->slot[-1*i];
-		oidArray = lEntry->kval + ALIGNED_LENGTH(lEntry->klen);
-		memcpy(&tOid, oidArray, sizeof(ObjectID));
-		if (tOid.pageNo == oid->pageNo 	&& tOid.volNo == oid->volNo
-				&& tOid.slotNo == oid->slotNo && tOid.unique == oid->unique)
-		{
-			oldLen = 2*sizeof(Two) + ALIGNED_LENGTH(lEntry->klen) + sizeof(ObjectID); 
-			break;
-		}
-	}
-
-	for (; i<apage->hdr.nSlots; i++)
-		apage->slot[-1*i] = apage->slot[-1*(i+1)];
-
-	apage->hdr.nSlots--;
-	for (i=0; i<apage->hdr.nSlots; i++)
+	// Find the entry of the given key and check its ObjectID.
+	found = edubtm_BinarySearchLeaf(apage, kdesc, kval, &idx);
+	if (found == TRUE)
 	{
-		lEntry = apage->data + apage->slot[-1*i];
-		entryLen = 2*sizeof(Two) + ALIGNED_LENGTH(lEntry->klen) + sizeof(ObjectID); 
-		freeOffset = apage->slot[-1*i] + entryLen;
-		if (apage->hdr.free < freeOffset)
-			apage->hdr.free = freeOffset;
+		lEntry = apage->data + apage->slot[-1*idx];
+		edubtm_GetOid(apage, lEntry, &tOid);
 	}
+	if (found == FALSE || tOid.pageNo != oid->pageNo || tOid.volNo != oid->volNo
+			|| tOid.slotNo != oid->slotNo || tOid.unique != oid->unique)
+		ERR(eNOTFOUND_BTM);
 
-	if (oldFree == apage->hdr.free)
-		apage->hdr.unused += oldLen;
-	else
-		apage->hdr.unused -= oldFree - apage->hdr.free + oldLen;
+	// Remove the entry in place; 'free' and 'unused' are updated arithmetically.
+	edubtm_RemoveLeafEntries(apage, idx, 1);
 
-	if (BL_FREE(apage) < BL_HALF)
+	if (BTM_LEAF_UNDERFULL(kdesc, apage))
 		*f = TRUE;
 
 
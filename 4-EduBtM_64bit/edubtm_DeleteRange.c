@@ -0,0 +1,651 @@
+/******************************************************************************/
+/*                                                                            */
+/*    ODYSSEUS/EduCOSMOS Educational-Purpose Object Storage System            */
+/*                                                                            */
+/*    Developed by Professor Kyu-Young Whang et al.                           */
+/*                                                                            */
+/*    Database and Multimedia Laboratory                                      */
+/*                                                                            */
+/*    Computer Science Department and                                         */
+/*    Advanced Information Technology Research Center (AITrc)                 */
+/*    Korea Advanced Institute of Science and Technology (KAIST)              */
+/*                                                                            */
+/*    e-mail: kywhang@cs.kaist.ac.kr                                          */
+/*    phone: +82-42-350-7722                                                  */
+/*    fax: +82-42-350-8380                                                    */
+/*                                                                            */
+/*    Copyright (c) 1995-2013 by Kyu-Young Whang                              */
+/*                                                                            */
+/*    All rights reserved. No part of this software may be reproduced,        */
+/*    stored in a retrieval system, or transmitted, in any form or by any     */
+/*    means, electronic, mechanical, photocopying, recording, or otherwise,   */
+/*    without prior written permission of the copyright owner.                */
+/*                                                                            */
+/******************************************************************************/
+/*
+ * Module: edubtm_DeleteRange.c
+ *
+ * Description :
+ *  Steps of the range deletion done by EduBtM_DeleteRange(). The deletion
+ *  goes down along the two boundary paths only, the path to the start key
+ *  and the path to the stop key. The subtrees between the two paths are
+ *  wholly in the range; they are detached from their parents and freed
+ *  without visiting their entries one by one. The pages on the boundary
+ *  paths are repaired afterward as edubtm_Delete() does, except that a
+ *  boundary subtree left without any entry is freed instead of merged.
+ *
+ * Exports:
+ *  Four edubtm_DeleteRange(PhysicalFileID*, PageID*, KeyDesc*, KeyValue*, Four,
+ *                          KeyValue*, Four, Pool*, DeallocListElem*)
+ *  Four edubtm_RangeLinkLeaves(PageID*, KeyDesc*, KeyValue*, KeyValue*)
+ *  Four edubtm_RangeRepair(ObjectID*, PageID*, KeyDesc*, KeyValue*, Boolean,
+ *                          Boolean*, Boolean*, InternalItem*, Pool*, DeallocListElem*)
+ */
+
+
+#include "EduBtM_common.h"
+#include "BfM.h"
+#include "EduBtM_Internal.h"
+
+
+/*@ Internal Function Prototypes */
+Two edubtm_RangeChild(BtreeInternal*, KeyDesc*, KeyValue*, Boolean);
+Four edubtm_RangeFindLeaf(PageID*, KeyDesc*, KeyValue*, Boolean, PageID*);
+Four edubtm_RangeEmpty(PageID*, Boolean*, PageID*);
+Four edubtm_RangeFreeEmpty(PhysicalFileID*, PageID*, PageID*, Pool*, DeallocListElem*);
+
+
+
+/*@================================
+ * edubtm_DeleteRange()
+ *================================*/
+/*
+ * Function: Four edubtm_DeleteRange(PhysicalFileID*, PageID*, KeyDesc*, KeyValue*, Four,
+ *                                   KeyValue*, Four, Pool*, DeallocListElem*)
+ *
+ * Description:
+ *  Delete the entries in the range from the subtree 'root'. In an internal
+ *  page, the children between the child of the start key and the child of
+ *  the stop key are freed with their subtrees and their entries are
+ *  removed; the two boundary children are visited recursively. In a leaf,
+ *  the entries in the range are removed. The underfull pages are left as
+ *  they are; see edubtm_RangeRepair().
+ *
+ *  'startKval' is NULL for SM_BOF and 'stopKval' is NULL for SM_EOF. Below
+ *  the page where the two paths part, the child of the start key is visited
+ *  with a NULL stop key and the child of the stop key with a NULL start key.
+ *
+ * Returns:
+ *  error code
+ *    some errors caused by function calls
+ *
+ * Note:
+ *  The links of the leaves are not changed; see edubtm_RangeLinkLeaves().
+ */
+Four edubtm_DeleteRange(
+    PhysicalFileID      *pFid,          /* IN FileID of the Btree file */
+    PageID              *root,          /* IN root of the subtree */
+    KeyDesc             *kdesc,         /* IN a key descriptor */
+    KeyValue            *startKval,     /* IN key value of start condition or NULL */
+    Four                startCompOp,    /* IN SM_GE or SM_GT */
+    KeyValue            *stopKval,      /* IN key value of stop condition or NULL */
+    Four                stopCompOp,     /* IN SM_LE or SM_LT */
+    Pool                *dlPool,        /* INOUT pool of dealloc list elements */
+    DeallocListElem     *dlHead)        /* INOUT head of the dealloc list */
+{
+    Four                e;              /* error number */
+    Two                 i;              /* slot No. */
+    Two                 lo, hi;         /* the entries in [lo, hi) are in the range */
+    Two                 from, to;       /* the children in [from, to] are freed */
+    Boolean             keepLo, keepHi; /* whether the boundary children are kept */
+    Boolean             found;          /* search result */
+    PageID              child;          /* a child page */
+    BtreePage           *apage;         /* buffer of the page */
+    btm_InternalEntry   *iEntry;        /* an internal entry */
+
+
+	e = edubtm_GetTrain(root, &apage, PAGE_BUF);
+	if (e < 0) ERR(e);
+
+	if (apage->any.hdr.type & INTERNAL)
+	{
+		lo = edubtm_RangeChild(&apage->bi, kdesc, startKval, FALSE);
+		hi = edubtm_RangeChild(&apage->bi, kdesc, stopKval, TRUE);
+
+		/*
+		 * A boundary child is kept only if its bound lies in this subtree. A
+		 * NULL key means the range extends beyond the subtree on that side, so
+		 * the children up to the first one or from the last one are freed as
+		 * well; otherwise they would be left empty and out of the repaired
+		 * paths. Only 'p0' is kept when both keys are NULL.
+		 */
+		keepLo = (startKval != NULL || stopKval == NULL);
+		keepHi = (stopKval != NULL && (keepLo == FALSE || lo != hi));
+		from = (keepLo == TRUE) ? lo+1 : lo;
+		to = (keepHi == TRUE) ? hi-1 : hi;
+
+		for (i = lo; i <= hi; i++)
+		{
+			if (i < 0)
+				MAKE_PAGEID(child, root->volNo, apage->bi.hdr.p0);
+			else
+			{
+				iEntry = (btm_InternalEntry*)&(apage->bi.data[apage->bi.slot[-1*i]]);
+				MAKE_PAGEID(child, root->volNo, iEntry->spid);
+			}
+
+			if (i >= from && i <= to)
+				e = edubtm_FreePages(pFid, &child, dlPool, dlHead);
+			else if (i == lo && keepLo == TRUE)
+				e = edubtm_DeleteRange(pFid, &child, kdesc, startKval, startCompOp,
+				                       (lo == hi) ? stopKval : NULL, stopCompOp, dlPool, dlHead);
+			else
+				e = edubtm_DeleteRange(pFid, &child, kdesc, NULL, startCompOp, stopKval, stopCompOp, dlPool, dlHead);
+			if (e < 0) ERRB1(e, root, PAGE_BUF);
+		}
+
+		if (from <= to)
+		{
+			edubtm_TopCacheInvalidate(root);
+
+			// With 'p0' freed, the kept child of the stop key becomes 'p0'.
+			if (from < 0)
+			{
+				iEntry = (btm_InternalEntry*)&(apage->bi.data[apage->bi.slot[-1*hi]]);
+				apage->bi.hdr.p0 = iEntry->spid;
+				edubtm_RemoveInternalEntries(&apage->bi, 0, hi+1);
+			}
+			else
+				edubtm_RemoveInternalEntries(&apage->bi, from, to-from+1);
+		}
+	}
+	else
+	{
+		lo = 0;
+		if (startKval != NULL)
+		{
+			found = edubtm_BinarySearchLeaf(&apage->bl, kdesc, startKval, &lo);
+			if (found == FALSE || startCompOp == SM_GT) lo++;
+		}
+
+		hi = apage->bl.hdr.nSlots;
+		if (stopKval != NULL)
+		{
+			found = edubtm_BinarySearchLeaf(&apage->bl, kdesc, stopKval, &hi);
+			if (found == FALSE || stopCompOp == SM_LE) hi++;
+		}
+
+		if (lo < hi)
+			edubtm_RemoveLeafEntries(&apage->bl, lo, hi-lo);
+	}
+
+	e = BfM_SetDirty(root, PAGE_BUF);
+	if (e < 0) ERRB1(e, root, PAGE_BUF);
+
+	e = BfM_FreeTrain(root, PAGE_BUF);
+	if (e < 0) ERR(e);
+
+	return(eNOERROR);
+
+} /* edubtm_DeleteRange() */
+
+
+
+/*@================================
+ * edubtm_RangeLinkLeaves()
+ *================================*/
+/*
+ * Function: Four edubtm_RangeLinkLeaves(PageID*, KeyDesc*, KeyValue*, KeyValue*)
+ *
+ * Description:
+ *  Link the leaf of the start key and the leaf of the stop key to each
+ *  other, dropping the leaves between them from the leaf list. A NULL key
+ *  means the leftmost or the rightmost leaf, which then has no neighbor on
+ *  that side any more.
+ *
+ * Returns:
+ *  error code
+ *    some errors caused by function calls
+ */
+Four edubtm_RangeLinkLeaves(
+    PageID              *root,          /* IN root page */
+    KeyDesc             *kdesc,         /* IN a key descriptor */
+    KeyValue            *startKval,     /* IN key value of start condition or NULL */
+    KeyValue            *stopKval)      /* IN key value of stop condition or NULL */
+{
+    Four                e;              /* error number */
+    PageID              left;           /* the leaf of the start key */
+    PageID              right;          /* the leaf of the stop key */
+    BtreeLeaf           *apage;         /* buffer of a leaf */
+
+
+	e = edubtm_RangeFindLeaf(root, kdesc, startKval, FALSE, &left);
+	if (e < 0) ERR(e);
+
+	e = edubtm_RangeFindLeaf(root, kdesc, stopKval, TRUE, &right);
+	if (e < 0) ERR(e);
+
+	// Without a start or a stop key, the remaining leaf is the first or the last one.
+	if (left.pageNo == right.pageNo && startKval != NULL && stopKval != NULL) return(eNOERROR);
+
+	e = edubtm_GetTrain(&left, &apage, PAGE_BUF);
+	if (e < 0) ERR(e);
+
+	if (startKval == NULL) apage->hdr.prevPage = NIL;
+	if (left.pageNo != right.pageNo) apage->hdr.nextPage = right.pageNo;
+	else if (stopKval == NULL) apage->hdr.nextPage = NIL;
+
+	e = BfM_SetDirty(&left, PAGE_BUF);
+	if (e < 0) ERRB1(e, &left, PAGE_BUF);
+
+	e = BfM_FreeTrain(&left, PAGE_BUF);
+	if (e < 0) ERR(e);
+
+	if (left.pageNo == right.pageNo) return(eNOERROR);
+
+	e = edubtm_GetTrain(&right, &apage, PAGE_BUF);
+	if (e < 0) ERR(e);
+
+	apage->hdr.prevPage = left.pageNo;
+	if (stopKval == NULL) apage->hdr.nextPage = NIL;
+
+	e = BfM_SetDirty(&right, PAGE_BUF);
+	if (e < 0) ERRB1(e, &right, PAGE_BUF);
+
+	e = BfM_FreeTrain(&right, PAGE_BUF);
+	if (e < 0) ERR(e);
+
+	return(eNOERROR);
+
+} /* edubtm_RangeLinkLeaves() */
+
+
+
+/*@================================
+ * edubtm_RangeRepair()
+ *================================*/
+/*
+ * Function: Four edubtm_RangeRepair(ObjectID*, PageID*, KeyDesc*, KeyValue*, Boolean,
+ *                                   Boolean*, Boolean*, InternalItem*, Pool*, DeallocListElem*)
+ *
+ * Description:
+ *  Go down along a boundary path of the range deletion, and on the way
+ *  back merge or redistribute every underfull page on the path by
+ *  edubtm_Underflow(). A NULL 'kval' means the leftmost path, or the
+ *  rightmost one if 'rightmost' is TRUE.
+ *
+ *  A child holding no entry at all, i.e. an empty leaf or internal pages
+ *  with no slot down to an empty leaf, is not merged: it is freed and its
+ *  entry is removed. If it is the only child, the page itself is left for
+ *  its parent to free, or becomes an empty leaf if it is the root.
+ *
+ * Returns:
+ *  error code
+ *    some errors caused by function calls
+ *
+ * Side effects:
+ *  f    : TRUE if the given page is not half full.
+ *  h    : TRUE if the given page is splitted.
+ *  item : The internal item to be inserted into the parent if 'h' is TRUE.
+ */
+Four edubtm_RangeRepair(
+    ObjectID            *catObjForFile, /* IN catalog object of B+ tree file */
+    PageID              *root,          /* IN root of the subtree */
+    KeyDesc             *kdesc,         /* IN a key descriptor */
+    KeyValue            *kval,          /* IN a boundary key or NULL */
+    Boolean             rightmost,      /* IN which path to take when 'kval' is NULL */
+    Boolean             *f,             /* OUT whether the page is not half full */
+    Boolean             *h,             /* OUT TRUE if the page is splitted */
+    InternalItem        *item,          /* OUT the internal item to be returned */
+    Pool                *dlPool,        /* INOUT pool of dealloc list elements */
+    DeallocListElem     *dlHead)        /* INOUT head of the dealloc list */
+{
+    Four                e;              /* error number */
+    Boolean             lf;             /* TRUE if the child is not half full */
+    Boolean             lh;             /* TRUE if the child is splitted */
+    Boolean             empty;          /* TRUE if the child has no entry */
+    Two                 idx;            /* slot No. of the child */
+    PageID              child;          /* the child page */
+    PageID              leaf;           /* the leaf under the child */
+    PhysicalFileID      pFid;           /* B+-tree file's FileID */
+    BtreePage           *apage;         /* buffer of the page */
+    btm_InternalEntry   *iEntry;        /* an internal entry */
+    InternalItem        litem;          /* local internal item */
+
+
+	*f = *h = FALSE;
+
+	e = edubtm_GetTrain(root, &apage, PAGE_BUF);
+	if (e < 0) ERR(e);
+
+	if (apage->any.hdr.type & LEAF)
+	{
+		if ((Four)BL_FREE(&apage->bl) > BL_HALF)
+			*f = TRUE;
+
+		e = BfM_FreeTrain(root, PAGE_BUF);
+		if (e < 0) ERR(e);
+
+		return(eNOERROR);
+	}
+
+	idx = edubtm_RangeChild(&apage->bi, kdesc, kval, rightmost);
+	if (idx >= 0)
+	{
+		iEntry = (btm_InternalEntry*)&(apage->bi.data[apage->bi.slot[-1*idx]]);
+		MAKE_PAGEID(child, root->volNo, iEntry->spid);
+	}
+	else
+		MAKE_PAGEID(child, root->volNo, apage->bi.hdr.p0);
+
+	e = edubtm_RangeRepair(catObjForFile, &child, kdesc, kval, rightmost, &lf, &lh, &litem, dlPool, dlHead);
+	if (e < 0) ERRB1(e, root, PAGE_BUF);
+
+	if (lh == TRUE)
+	{
+		edubtm_BinarySearchInternal(&apage->bi, kdesc, (KeyValue*)&litem.klen, &idx);
+		e = edubtm_InsertInternal(catObjForFile, &apage->bi, &litem, idx, h, item);
+		if (e < 0) ERRB1(e, root, PAGE_BUF);
+
+		e = BfM_SetDirty(root, PAGE_BUF);
+		if (e < 0) ERRB1(e, root, PAGE_BUF);
+	}
+	else if (lf == TRUE)
+	{
+		e = edubtm_RangeEmpty(&child, &empty, &leaf);
+		if (e < 0) ERRB1(e, root, PAGE_BUF);
+
+		MAKE_PAGEID(pFid, catObjForFile->volNo, catObjForFile->pageNo);
+
+		if (empty == TRUE && apage->bi.hdr.nSlots > 0)
+		{
+			e = edubtm_RangeFreeEmpty(&pFid, &child, &leaf, dlPool, dlHead);
+			if (e < 0) ERRB1(e, root, PAGE_BUF);
+
+			edubtm_TopCacheInvalidate(root);
+
+			// With 'p0' freed, the child of the first entry becomes 'p0'.
+			if (idx < 0)
+			{
+				iEntry = (btm_InternalEntry*)&(apage->bi.data[apage->bi.slot[0]]);
+				apage->bi.hdr.p0 = iEntry->spid;
+				idx = 0;
+			}
+			edubtm_RemoveInternalEntries(&apage->bi, idx, 1);
+
+			e = BfM_SetDirty(root, PAGE_BUF);
+			if (e < 0) ERRB1(e, root, PAGE_BUF);
+		}
+		else if (empty == TRUE && (apage->any.hdr.type & ROOT))
+		{
+			// The whole tree is empty; the root becomes an empty leaf.
+			e = edubtm_RangeFreeEmpty(&pFid, &child, &leaf, dlPool, dlHead);
+			if (e < 0) ERRB1(e, root, PAGE_BUF);
+
+			edubtm_TopCacheInvalidate(root);
+
+			e = edubtm_InitLeaf(root, TRUE, FALSE);
+			if (e < 0) ERRB1(e, root, PAGE_BUF);
+
+			e = BfM_FreeTrain(root, PAGE_BUF);
+			if (e < 0) ERR(e);
+
+			return(eNOERROR);
+		}
+		else if (empty == FALSE && apage->bi.hdr.nSlots > 0)
+		{
+			e = edubtm_Underflow(catObjForFile, &apage->bi, &child, idx, &lf, h, item, dlPool, dlHead);
+			if (e < 0) ERRB1(e, root, PAGE_BUF);
+
+			e = BfM_SetDirty(root, PAGE_BUF);
+			if (e < 0) ERRB1(e, root, PAGE_BUF);
+		}
+	}
+
+	if (*h == FALSE && (Four)BI_FREE(&apage->bi) > BI_HALF)
+		*f = TRUE;
+
+	e = BfM_FreeTrain(root, PAGE_BUF);
+	if (e < 0) ERR(e);
+
+	return(eNOERROR);
+
+} /* edubtm_RangeRepair() */
+
+
+
+/*@================================
+ * edubtm_RangeChild()
+ *================================*/
+/*
+ * Function: Two edubtm_RangeChild(BtreeInternal*, KeyDesc*, KeyValue*, Boolean)
+ *
+ * Description:
+ *  Return the slot No. of the child of the internal page containing 'kval'
+ *  (-1 for 'p0'). A NULL 'kval' means the first child, or the last one if
+ *  'rightmost' is TRUE.
+ *
+ * Returns:
+ *  slot No. of the child
+ */
+Two edubtm_RangeChild(
+    BtreeInternal       *apage,         /* IN an internal page */
+    KeyDesc             *kdesc,         /* IN a key descriptor */
+    KeyValue            *kval,          /* IN a key value or NULL */
+    Boolean             rightmost)      /* IN which child to take when 'kval' is NULL */
+{
+    Two                 idx;            /* slot No. of the child */
+
+
+	if (kval == NULL)
+		return((rightmost == TRUE) ? apage->hdr.nSlots-1 : -1);
+
+	edubtm_BinarySearchInternal(apage, kdesc, kval, &idx);
+
+	return(idx);
+
+} /* edubtm_RangeChild() */
+
+
+
+/*@================================
+ * edubtm_RangeFindLeaf()
+ *================================*/
+/*
+ * Function: Four edubtm_RangeFindLeaf(PageID*, KeyDesc*, KeyValue*, Boolean, PageID*)
+ *
+ * Description:
+ *  Find the leaf containing 'kval' by edubtm_RangeChild().
+ *
+ * Returns:
+ *  error code
+ *    some errors caused by function calls
+ */
+Four edubtm_RangeFindLeaf(
+    PageID              *root,          /* IN root page */
+    KeyDesc             *kdesc,         /* IN a key descriptor */
+    KeyValue            *kval,          /* IN a key value or NULL */
+    Boolean             rightmost,      /* IN which leaf to take when 'kval' is NULL */
+    PageID              *leaf)          /* OUT the leaf */
+{
+    Four                e;              /* error number */
+    Two                 idx;            /* slot No. of the child */
+    PageID              pid;            /* a page on the path */
+    PageID              child;          /* the child of 'pid' on the path */
+    BtreePage           *apage;         /* buffer of 'pid' */
+    btm_InternalEntry   *iEntry;        /* an internal entry */
+
+
+	pid = *root;
+	for (;;)
+	{
+		e = edubtm_GetTrain(&pid, &apage, PAGE_BUF);
+		if (e < 0) ERR(e);
+
+		if (apage->any.hdr.type & LEAF)
+		{
+			*leaf = pid;
+			e = BfM_FreeTrain(&pid, PAGE_BUF);
+			if (e < 0) ERR(e);
+			break;
+		}
+
+		idx = edubtm_RangeChild(&apage->bi, kdesc, kval, rightmost);
+		if (idx >= 0)
+		{
+			iEntry = (btm_InternalEntry*)&(apage->bi.data[apage->bi.slot[-1*idx]]);
+			MAKE_PAGEID(child, root->volNo, iEntry->spid);
+		}
+		else
+			MAKE_PAGEID(child, root->volNo, apage->bi.hdr.p0);
+
+		e = BfM_FreeTrain(&pid, PAGE_BUF);
+		if (e < 0) ERR(e);
+		pid = child;
+	}
+
+	return(eNOERROR);
+
+} /* edubtm_RangeFindLeaf() */
+
+
+
+/*@================================
+ * edubtm_RangeEmpty()
+ *================================*/
+/*
+ * Function: Four edubtm_RangeEmpty(PageID*, Boolean*, PageID*)
+ *
+ * Description:
+ *  Find whether the subtree 'root' holds no entry. Only a subtree made of
+ *  internal pages with no slot over an empty leaf does, so the test follows
+ *  'p0' down to the first page with a slot or to the leaf.
+ *
+ * Returns:
+ *  error code
+ *    some errors caused by function calls
+ *
+ * Side effects:
+ *  empty : TRUE if the subtree holds no entry.
+ *  leaf  : The leaf of the subtree if 'empty' is TRUE.
+ */
+Four edubtm_RangeEmpty(
+    PageID              *root,          /* IN root of the subtree */
+    Boolean             *empty,         /* OUT TRUE if the subtree holds no entry */
+    PageID              *leaf)          /* OUT the leaf of an empty subtree */
+{
+    Four                e;              /* error number */
+    PageID              pid;            /* a page of the subtree */
+    PageID              child;          /* 'p0' of 'pid' */
+    BtreePage           *apage;         /* buffer of 'pid' */
+
+
+	*empty = FALSE;
+
+	pid = *root;
+	for (;;)
+	{
+		e = edubtm_GetTrain(&pid, &apage, PAGE_BUF);
+		if (e < 0) ERR(e);
+
+		if (apage->any.hdr.type & LEAF)
+		{
+			if (apage->bl.hdr.nSlots == 0)
+			{
+				*empty = TRUE;
+				*leaf = pid;
+			}
+			e = BfM_FreeTrain(&pid, PAGE_BUF);
+			if (e < 0) ERR(e);
+			break;
+		}
+
+		if (apage->bi.hdr.nSlots > 0)
+		{
+			e = BfM_FreeTrain(&pid, PAGE_BUF);
+			if (e < 0) ERR(e);
+			break;
+		}
+
+		MAKE_PAGEID(child, root->volNo, apage->bi.hdr.p0);
+		e = BfM_FreeTrain(&pid, PAGE_BUF);
+		if (e < 0) ERR(e);
+		pid = child;
+	}
+
+	return(eNOERROR);
+
+} /* edubtm_RangeEmpty() */
+
+
+
+/*@================================
+ * edubtm_RangeFreeEmpty()
+ *================================*/
+/*
+ * Function: Four edubtm_RangeFreeEmpty(PhysicalFileID*, PageID*, PageID*, Pool*, DeallocListElem*)
+ *
+ * Description:
+ *  Free the empty subtree 'root' found by edubtm_RangeEmpty(), dropping its
+ *  leaf from the leaf list first. The caller removes the entry of 'root'.
+ *
+ * Returns:
+ *  error code
+ *    some errors caused by function calls
+ */
+Four edubtm_RangeFreeEmpty(
+    PhysicalFileID      *pFid,          /* IN FileID of the Btree file */
+    PageID              *root,          /* IN root of the empty subtree */
+    PageID              *leaf,          /* IN the leaf of the subtree */
+    Pool                *dlPool,        /* INOUT pool of dealloc list elements */
+    DeallocListElem     *dlHead)        /* INOUT head of the dealloc list */
+{
+    Four                e;              /* error number */
+    PageID              prevPid;        /* the previous leaf */
+    PageID              nextPid;        /* the next leaf */
+    BtreeLeaf           *apage;         /* buffer of a leaf */
+
+
+	e = edubtm_GetTrain(leaf, &apage, PAGE_BUF);
+	if (e < 0) ERR(e);
+
+	MAKE_PAGEID(prevPid, leaf->volNo, apage->hdr.prevPage);
+	MAKE_PAGEID(nextPid, leaf->volNo, apage->hdr.nextPage);
+
+	e = BfM_FreeTrain(leaf, PAGE_BUF);
+	if (e < 0) ERR(e);
+
+	if (prevPid.pageNo != NIL)
+	{
+		e = edubtm_GetTrain(&prevPid, &apage, PAGE_BUF);
+		if (e < 0) ERR(e);
+
+		apage->hdr.nextPage = nextPid.pageNo;
+
+		e = BfM_SetDirty(&prevPid, PAGE_BUF);
+		if (e < 0) ERRB1(e, &prevPid, PAGE_BUF);
+
+		e = BfM_FreeTrain(&prevPid, PAGE_BUF);
+		if (e < 0) ERR(e);
+	}
+
+	if (nextPid.pageNo != NIL)
+	{
+		e = edubtm_GetTrain(&nextPid, &apage, PAGE_BUF);
+		if (e < 0) ERR(e);
+
+		apage->hdr.prevPage = prevPid.pageNo;
+
+		e = BfM_SetDirty(&nextPid, PAGE_BUF);
+		if (e < 0) ERRB1(e, &nextPid, PAGE_BUF);
+
+		e = BfM_FreeTrain(&nextPid, PAGE_BUF);
+		if (e < 0) ERR(e);
+	}
+
+	e = edubtm_FreePages(pFid, root, dlPool, dlHead);
+	if (e < 0) ERR(e);
+
+	return(eNOERROR);
+
+} /* edubtm_RangeFreeEmpty() */
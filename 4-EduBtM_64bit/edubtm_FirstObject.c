@@ -90,22 +90,30 @@ Four edubtm_FirstObject(
             ERR(eNOTSUPPORTED_EDUBTM);
     }
 
-	e = BfM_GetTrain(root, &apage, PAGE_BUF);
+	e = edubtm_GetTrain(root, &apage, PAGE_BUF);
 	if (e < 0) ERR(e);
 	
     if (apage->any.hdr.type & INTERNAL)
 	{
 		MAKE_PAGEID(child, root->volNo, apage->bi.hdr.p0);
+		edubtm_traceDepth++;
 		edubtm_FirstObject(&child, kdesc, stopKval, stopCompOp, cursor);
+		edubtm_traceDepth--;
+	}
+	else if (apage->any.hdr.type & LEAF && apage->bl.hdr.nSlots == 0)
+	{
+		/* the index is empty */
+		cursor->flag = CURSOR_EOS;
 	}
 	else if (apage->any.hdr.type & LEAF)
 	{
 		lEntry = apage->bl.data + apage->bl.slot[0];
-		alignedKlen = ALIGNED_LENGTH(lEntry->klen);
 		
 		cursor->flag = CURSOR_ON;
-		memcpy(&cursor->oid, &lEntry->kval + alignedKlen, sizeof(ObjectID));
-		memcpy(&cursor->key, &lEntry->klen, sizeof(KeyValue));
+		edubtm_GetOid(&apage->bl, lEntry, &cursor->oid);
+		cursor->includedLen = apage->bl.hdr.reserved;
+		memcpy(cursor->included, BL_INCLUDED(&apage->bl, lEntry), cursor->includedLen);
+		BTM_COPY_KEY(&cursor->key, &lEntry->klen);
 		cursor->leaf = *root;
 		cursor->slotNo = 0;
 	}
@@ -79,13 +79,16 @@ Four edubtm_FreePages(
     Two                 lEntryOffset;   /* starting offset of a leaf entry */
     btm_InternalEntry   *iEntry;        /* an internal entry */
     btm_LeafEntry       *lEntry;        /* a leaf entry */
-    DeallocListElem     *dlElem;        /* an element of dealloc list */
 
-	e = BfM_GetNewTrain(curPid, &apage, PAGE_BUF);
+	e = edubtm_GetTrain(curPid, &apage, PAGE_BUF);
 	if (e < 0) ERR(e);
 
 	if (apage->any.hdr.type & INTERNAL) 
 	{
+		MAKE_PAGEID(tPid, curPid->volNo, apage->bi.hdr.p0);
+		e = edubtm_FreePages(pFid, &tPid, dlPool, dlHead);
+		if (e < 0) ERRB1(e, curPid, PAGE_BUF);
+
 		for (i=0; i<apage->bi.hdr.nSlots; i++) 
 		{
 			iEntryOffset = apage->bi.slot[-1*i];
@@ -93,21 +96,14 @@ Four edubtm_FreePages(
 			MAKE_PAGEID(tPid, curPid->volNo, iEntry->spid);
 
 			e = edubtm_FreePages(pFid, &tPid, dlPool, dlHead);
-			if (e < 0) ERR(e);
+			if (e < 0) ERRB1(e, curPid, PAGE_BUF);
 		}
 	}
 
-	apage->any.hdr.type = FREEPAGE;
-
-	dlElem = (DeallocListElem*) malloc(sizeof(DeallocListElem));
-	e = Util_getElementFromPool(dlPool, dlElem);
+	e = BfM_FreeTrain(curPid, PAGE_BUF);
 	if (e < 0) ERR(e);
-	dlElem->type = DL_PAGE;
-	dlElem->elem.pid = apage->any.hdr.pid;
-	dlElem->next = dlHead;
-	dlHead = dlElem;
 
-	e = BfM_FreeTrain(curPid, PAGE_BUF);
+	e = edubtm_FreePage(curPid, dlPool, dlHead);
 	if (e < 0) ERR(e);
 	
 	return(eNOERROR);
@@ -71,9 +71,10 @@ Four edubtm_InitInternal(
 
 	MAKE_PAGEID(page->hdr.pid, internal->volNo, internal->pageNo);
 	SET_PAGE_TYPE(page, BTREE_PAGE_TYPE);
-	page->hdr.type |= INTERNAL;
+	page->hdr.type = INTERNAL;
 	if (root)
 		page->hdr.type |= ROOT;
+	page->hdr.reserved = 0;
 	page->hdr.p0 = NIL;
 	page->hdr.nSlots = 0;
 	page->hdr.free = 0;
@@ -120,9 +121,10 @@ Four edubtm_InitLeaf(
 
 	MAKE_PAGEID(page->hdr.pid, leaf->volNo, leaf->pageNo);
 	SET_PAGE_TYPE(page, BTREE_PAGE_TYPE);
-	page->hdr.type |= LEAF;
+	page->hdr.type = LEAF;
 	if (root)
 		page->hdr.type |= ROOT;
+	page->hdr.reserved = 0;
 	page->hdr.nSlots = 0;
 	page->hdr.free = 0;
 	page->hdr.prevPage = NIL;
@@ -35,12 +35,13 @@
  *  return values.
  *
  * Exports:
- *  Four edubtm_Insert(ObjectID*, PageID*, KeyDesc*, KeyValue*, ObjectID*,
+ *  Four edubtm_Insert(ObjectID*, PageID*, KeyDesc*, KeyValue*, ObjectID*, char*,
  *                  Boolean*, Boolean*, InternalItem*, Pool*, DeallocListElem*)
  *  Four edubtm_InsertLeaf(ObjectID*, PageID*, BtreeLeaf*, KeyDesc*, KeyValue*,
- *                      ObjectID*, Boolean*, Boolean*, InternalItem*)
+ *                      ObjectID*, char*, Boolean*, Boolean*, InternalItem*)
  *  Four edubtm_InsertInternal(ObjectID*, BtreeInternal*, InternalItem*,
  *                          Two, Boolean*, InternalItem*)
+ *  Four edubtm_DuplicateError(KeyDesc*, ObjectID*, ObjectID*)
  */
 
 
@@ -57,7 +58,7 @@
  *================================*/
 /*
  * Function: Four edubtm_Insert(ObjectID*, PageID*, KeyDesc*, KeyValue*,
- *                           ObjectID*, Boolean*, Boolean*, InternalItem*,
+ *                           ObjectID*, char*, Boolean*, Boolean*, InternalItem*,
  *                           Pool*, DeallocListElem*)
  *
  * Description:
@@ -87,6 +88,7 @@ Four edubtm_Insert(
     KeyDesc                     *kdesc,                 /* IN Btree key descriptor */
     KeyValue                    *kval,                  /* IN key value */
     ObjectID                    *oid,                   /* IN ObjectID which will be inserted */
+    char                        *included,              /* IN included columns of a covering index or NULL */
     Boolean                     *f,                     /* OUT whether it is merged by creating a new overflow page */
     Boolean                     *h,                     /* OUT whether it is splitted */
     InternalItem                *item,                  /* OUT Internal Item which will be inserted */
@@ -121,7 +123,7 @@ Four edubtm_Insert(
     /*@ Initially the flags are FALSE */
     *h = *f = FALSE;
 
-	e = BfM_GetTrain(root, &apage, PAGE_BUF);
+	e = edubtm_GetTrain(root, &apage, PAGE_BUF);
 	if (e < 0) ERR(e);
 
 	/* If root page is internal page */
@@ -143,14 +145,16 @@ Four edubtm_Insert(
 
 		// Insert into the child page (newPid).
 		lf = lh = FALSE;
-		e = edubtm_Insert(catObjForFile, &newPid, kdesc, kval, oid, &lf, &lh, &litem, dlPool, dlHead);
+		edubtm_traceDepth++;
+		e = edubtm_Insert(catObjForFile, &newPid, kdesc, kval, oid, included, &lf, &lh, &litem, dlPool, dlHead);
+		edubtm_traceDepth--;
 		if (e < 0) ERR(e);
 
 		// If there is split in child page
 		if (lh == TRUE)
 		{
 			// Decide slotNo in index entry.
-			memcpy(&tKey, &litem.klen, sizeof(Two) + sizeof(char) * MAXKEYLEN);
+			BTM_COPY_KEY(&tKey, &litem.klen);
 			edubtm_BinarySearchInternal(&apage->bi, kdesc, &tKey, &idx); // parameter?
 
 			// Insert new child page's internal index entry (litem) into root page. 
@@ -162,7 +166,7 @@ Four edubtm_Insert(
 	else if (apage->any.hdr.type & LEAF)
 	{
 		// Insert into leaf page.
-		e = edubtm_InsertLeaf(catObjForFile, root, apage, kdesc, kval, oid, f, h, item);
+		e = edubtm_InsertLeaf(catObjForFile, root, apage, kdesc, kval, oid, included, f, h, item);
 		if (e < 0) ERR(e);
 	}
 
@@ -183,7 +187,7 @@ Four edubtm_Insert(
  *================================*/
 /*
  * Function: Four edubtm_InsertLeaf(ObjectID*, PageID*, BtreeLeaf*, KeyDesc*,
- *                               KeyValue*, ObjectID*, Boolean*, Boolean*,
+ *                               KeyValue*, ObjectID*, char*, Boolean*, Boolean*,
  *                               InternalItem*)
  *
  * Description:
@@ -192,10 +196,14 @@ Four edubtm_Insert(
  *
  *  Insert into the given leaf page an ObjectID with the given key.
  *
+ *  In a covering index, the first 'page->hdr.reserved' bytes of 'included'
+ *  are stored after the ObjectID; they are zero-filled if 'included' is NULL.
+ *
  * Returns:
  *  Error code
  *    eDUPLICATEDKEY_BTM
  *    eDUPLICATEDOBJECTID_BTM
+ *    eNOTSUPPORTED_EDUBTM
  *    some errors causd by function calls
  *
  * Side effects:
@@ -210,6 +218,7 @@ Four edubtm_InsertLeaf(
     KeyDesc                     *kdesc,         /* IN Btree key descriptor */
     KeyValue                    *kval,          /* IN key value */
     ObjectID                    *oid,           /* IN ObjectID which will be inserted */
+    char                        *included,      /* IN included columns or NULL */
     Boolean                     *f,             /* OUT whether it is merged by creating */
                                                 /*     a new overflow page */
     Boolean                     *h,             /* OUT whether it is splitted */
@@ -230,6 +239,7 @@ Four edubtm_InsertLeaf(
 	Two							neededSpace;
     ObjectID                    *oidArray;      /* an array of ObjectIDs */
     Two                         oidArrayElemNo; /* an index for the ObjectID array */
+    ObjectID                    tOid;           /* ObjectID of the duplicated key */
 
 
     /* Error check whether using not supported functionality by EduBtM */
@@ -243,17 +253,19 @@ Four edubtm_InsertLeaf(
     /*@ Initially the flags are FALSE */
     *h = *f = FALSE;
     
-	// Decide index of new index entry.
-	if (btm_BinarySearchLeaf(page, kdesc, kval, &idx) == TRUE)
-		ERR(eDUPLICATEDKEY_BTM);
+	// Decide index of new index entry; the same search finds the duplicated key.
+	if (edubtm_BinarySearchLeaf(page, kdesc, kval, &idx) == TRUE)
+	{
+		entry = (btm_LeafEntry*)&(page->data[page->slot[-1*idx]]);
+		edubtm_GetOid(page, entry, &tOid);
+		ERR(edubtm_DuplicateError(kdesc, &tOid, oid));
+	}
 
 	// Calculate needed space size for entry (index entry size + slot size).
-	if (kdesc->kpart[0].type == SM_INT)
-		len = kdesc->kpart[0].length;
-	else
-		len = kval->len;
+	len = kval->len;
 	alignedKlen = ALIGNED_LENGTH(len);
-	entryLen = 2*sizeof(Two) + alignedKlen + sizeof(ObjectID);
+	entryLen = 2*sizeof(Two) + alignedKlen + ALIGNED_LENGTH(page->hdr.reserved)
+		+ ((page->hdr.type & PACKED) ? edubtm_PackOid(page, oid, NULL) : sizeof(ObjectID));
 	neededSpace = entryLen + sizeof(Two);
 
 	// If there is enough free space
@@ -268,7 +280,11 @@ Four edubtm_InsertLeaf(
 		entry->nObjects = 1;
 		entry->klen = kval->len;
 		memcpy(entry->kval, kval->val, len);
-		memcpy(entry->kval + alignedKlen, oid, sizeof(ObjectID));
+		edubtm_PutOid(page, entry, oid);
+		if (included != NULL)
+			memcpy(BL_INCLUDED(page, entry), included, page->hdr.reserved);
+		else
+			memset(BL_INCLUDED(page, entry), 0, page->hdr.reserved);
 		
 		for (i=page->hdr.nSlots-1; i>=idx; i--)
 			page->slot[-1*(i+1)] = page->slot[-1*i];
@@ -283,7 +299,11 @@ Four edubtm_InsertLeaf(
 		*h = TRUE;
 		leaf.oid = *oid;
 		leaf.nObjects = 1;
-		memcpy(&leaf.klen, kval, sizeof(KeyValue));		
+		BTM_COPY_KEY(&leaf.klen, kval);
+		if (included != NULL)
+			memcpy(leaf.included, included, page->hdr.reserved);
+		else
+			memset(leaf.included, 0, page->hdr.reserved);
 		edubtm_SplitLeaf(catObjForFile, pid, page, idx, &leaf, item);
 	}
 
@@ -338,6 +358,7 @@ Four edubtm_InsertInternal(
     /*@ Initially the flag are FALSE */
     *h = FALSE;
     
+	edubtm_TopCacheInvalidate(&page->hdr.pid);
     
 	// Calculate needed space size for entry (index entry size + slot size).
 	alignedKlen = ALIGNED_LENGTH(item->klen);
@@ -376,3 +397,36 @@ Four edubtm_InsertInternal(
     
 } /* edubtm_InsertInternal() */
 
+
+
+/*@================================
+ * edubtm_DuplicateError()
+ *================================*/
+/*
+ * Function: Four edubtm_DuplicateError(KeyDesc*, ObjectID*, ObjectID*)
+ *
+ * Description:
+ *  Decide the error of inserting the ObjectID 'oid' with a key value which
+ *  is already in the index with the ObjectID 'old'. A unique index
+ *  (KEYFLAG_UNIQUE) rejects the key itself. Other indexes reject the same
+ *  pair inserted again with eDUPLICATEDOBJECTID_BTM, and a second ObjectID
+ *  for the key with eDUPLICATEDKEY_BTM as before, since EduBtM keeps one
+ *  ObjectID per key.
+ *
+ * Returns:
+ *  eDUPLICATEDKEY_BTM or eDUPLICATEDOBJECTID_BTM
+ */
+Four edubtm_DuplicateError(
+    KeyDesc                     *kdesc,         /* IN Btree key descriptor */
+    ObjectID                    *old,           /* IN ObjectID of the key in the index */
+    ObjectID                    *oid)           /* IN ObjectID to be inserted */
+{
+	if (kdesc->flag & KEYFLAG_UNIQUE)
+		return(eDUPLICATEDKEY_BTM);
+
+	if (btm_ObjectIdComp(old, oid) == EQUAL)
+		return(eDUPLICATEDOBJECTID_BTM);
+
+	return(eDUPLICATEDKEY_BTM);
+
+} /* edubtm_DuplicateError() */
@@ -0,0 +1,565 @@
+/******************************************************************************/
+/*                                                                            */
+/*    ODYSSEUS/EduCOSMOS Educational-Purpose Object Storage System            */
+/*                                                                            */
+/*    Developed by Professor Kyu-Young Whang et al.                           */
+/*                                                                            */
+/*    Database and Multimedia Laboratory                                      */
+/*                                                                            */
+/*    Computer Science Department and                                         */
+/*    Advanced Information Technology Research Center (AITrc)                 */
+/*    Korea Advanced Institute of Science and Technology (KAIST)              */
+/*                                                                            */
+/*    e-mail: kywhang@cs.kaist.ac.kr                                          */
+/*    phone: +82-42-350-7722                                                  */
+/*    fax: +82-42-350-8380                                                    */
+/*                                                                            */
+/*    Copyright (c) 1995-2013 by Kyu-Young Whang                              */
+/*                                                                            */
+/*    All rights reserved. No part of this software may be reproduced,        */
+/*    stored in a retrieval system, or transmitted, in any form or by any     */
+/*    means, electronic, mechanical, photocopying, recording, or otherwise,   */
+/*    without prior written permission of the copyright owner.                */
+/*                                                                            */
+/******************************************************************************/
+/*
+ * Module: edubtm_InsertBatch.c
+ *
+ * Description :
+ *  Steps of the batch insertion done by EduBtM_InsertBatch(). The batch is
+ *  sorted once, and then each page on the way down gets the whole run of
+ *  the keys which go into its subtree, so a page is visited once per batch
+ *  instead of once per key. A page which overflows is split once into as
+ *  many pages as the run needs, and the new separators of the children are
+ *  put into their parent together.
+ *
+ * Exports:
+ *  void edubtm_SortBatch(KeyDesc*, BtreeBatchItem*, Four*, Four*, Four)
+ *  Four edubtm_InsertBatch(ObjectID*, PageID*, KeyDesc*, BtreeBatchItem*, Four*, Four,
+ *                          InternalItem**, Four*)
+ *  Four edubtm_InsertBatchInternal(ObjectID*, PageID*, BtreeInternal*, KeyDesc*,
+ *                                  InternalItem*, Four, InternalItem**, Four*)
+ */
+
+
+#include <stdlib.h>
+#include <string.h>
+#include "EduBtM_common.h"
+#include "BfM.h"
+#include "EduBtM_Internal.h"
+
+
+/* the size of the data area of an empty page, slots included */
+#define BL_CAPACITY     ((CONSTANT_CASTING_TYPE)(PAGESIZE - BL_FIXED + sizeof(Two)))
+#define BI_CAPACITY     ((CONSTANT_CASTING_TYPE)(PAGESIZE - BI_FIXED + sizeof(Two)))
+
+
+/*@ Internal Function Prototypes */
+Four edubtm_InsertBatchLeaf(ObjectID*, PageID*, BtreeLeaf*, KeyDesc*, BtreeBatchItem*, Four*, Four,
+                            InternalItem**, Four*);
+
+
+
+/*@================================
+ * edubtm_SortBatch()
+ *================================*/
+/*
+ * Function: void edubtm_SortBatch(KeyDesc*, BtreeBatchItem*, Four*, Four*, Four)
+ *
+ * Description:
+ *  Sort the indexes of the items in 'order' by the key values with the
+ *  merge sort; the items themselves are not moved.
+ *
+ * Returns:
+ *  None
+ */
+void edubtm_SortBatch(
+    KeyDesc             *kdesc,         /* IN a key descriptor */
+    BtreeBatchItem      *pairs,         /* IN the items of the batch */
+    Four                *order,         /* INOUT indexes of the items to sort */
+    Four                *tmp,           /* IN work area of 'n' indexes */
+    Four                n)              /* IN # of indexes */
+{
+    Four                i, j, k;        /* indexes */
+    Four                half;           /* # of indexes of the first half */
+
+
+	if (n < 2) return;
+
+	half = n / 2;
+	edubtm_SortBatch(kdesc, pairs, order, tmp, half);
+	edubtm_SortBatch(kdesc, pairs, order+half, tmp, n-half);
+
+	for (i = 0, j = half, k = 0; i < half && j < n; k++)
+	{
+		if (edubtm_KeyCompare(kdesc, &pairs[order[j]].kval, &pairs[order[i]].kval) == LESS)
+			tmp[k] = order[j++];
+		else
+			tmp[k] = order[i++];
+	}
+	while (i < half) tmp[k++] = order[i++];
+	while (j < n) tmp[k++] = order[j++];
+
+	memcpy(order, tmp, n*sizeof(Four));
+
+} /* edubtm_SortBatch() */
+
+
+
+/*@================================
+ * edubtm_InsertBatch()
+ *================================*/
+/*
+ * Function: Four edubtm_InsertBatch(ObjectID*, PageID*, KeyDesc*, BtreeBatchItem*, Four*,
+ *                                   Four, InternalItem**, Four*)
+ *
+ * Description:
+ *  Insert the sorted run of items into the subtree 'root'. An internal page
+ *  cuts the run at its separators and gives each part to the child, and
+ *  then takes the new separators returned by the children at once.
+ *
+ * Returns:
+ *  error code
+ *    eDUPLICATEDKEY_BTM
+ *    eDUPLICATEDOBJECTID_BTM
+ *    eMEMORYALLOCERR_BTM
+ *    some errors caused by function calls
+ *
+ * Side effects:
+ *  items  : the internal items of the new pages split off from 'root', in
+ *           key order, which should be inserted into the parent. The array
+ *           is allocated by malloc() if 'nItems' > 0.
+ *  nItems : # of 'items'
+ */
+Four edubtm_InsertBatch(
+    ObjectID            *catObjForFile, /* IN catalog object of B+ tree file */
+    PageID              *root,          /* IN root of the subtree */
+    KeyDesc             *kdesc,         /* IN a key descriptor */
+    BtreeBatchItem      *pairs,         /* IN the items of the batch */
+    Four                *order,         /* IN indexes of the run in key order */
+    Four                n,              /* IN # of items of the run */
+    InternalItem        **items,        /* OUT items to insert into the parent */
+    Four                *nItems)        /* OUT # of 'items' */
+{
+    Four                e;              /* error number */
+    Four                i, end;         /* the part [i, end) of the run goes to a child */
+    Four                j;              /* index */
+    Two                 idx;            /* slot No. of the child */
+    PageID              child;          /* a child page */
+    BtreePage           *apage;         /* buffer of 'root' */
+    btm_InternalEntry   *iEntry;        /* an internal entry */
+    InternalItem        *childItems;    /* items returned by a child */
+    Four                nChildItems;    /* # of 'childItems' */
+    InternalItem        *newItems;      /* items returned by all the children */
+    Four                nNewItems = 0;  /* # of 'newItems' */
+
+
+	*items = NULL;
+	*nItems = 0;
+
+	e = edubtm_GetTrain(root, &apage, PAGE_BUF);
+	if (e < 0) ERR(e);
+
+	if (apage->any.hdr.type & LEAF)
+	{
+		e = edubtm_InsertBatchLeaf(catObjForFile, root, &apage->bl, kdesc, pairs, order, n, items, nItems);
+		if (e < 0) ERRB1(e, root, PAGE_BUF);
+	}
+	else
+	{
+		newItems = NULL;
+		for (i = 0; i < n; i = end)
+		{
+			edubtm_BinarySearchInternal(&apage->bi, kdesc, &pairs[order[i]].kval, &idx);
+			if (idx >= 0)
+			{
+				iEntry = (btm_InternalEntry*)&(apage->bi.data[apage->bi.slot[-1*idx]]);
+				MAKE_PAGEID(child, root->volNo, iEntry->spid);
+			}
+			else
+				MAKE_PAGEID(child, root->volNo, apage->bi.hdr.p0);
+
+			// The part ends at the separator of the next child.
+			end = n;
+			if (idx+1 < apage->bi.hdr.nSlots)
+			{
+				iEntry = (btm_InternalEntry*)&(apage->bi.data[apage->bi.slot[-1*(idx+1)]]);
+				for (end = i+1; end < n; end++)
+					if (edubtm_KeyCompare(kdesc, &pairs[order[end]].kval, (KeyValue*)&iEntry->klen) != LESS)
+						break;
+			}
+
+			e = edubtm_InsertBatch(catObjForFile, &child, kdesc, pairs, order+i, end-i, &childItems, &nChildItems);
+			if (e < 0) { free(newItems); ERRB1(e, root, PAGE_BUF); }
+
+			if (nChildItems > 0)
+			{
+				newItems = (InternalItem*)realloc(newItems, (nNewItems+nChildItems)*sizeof(InternalItem));
+				if (newItems == NULL) { free(childItems); ERRB1(eMEMORYALLOCERR_BTM, root, PAGE_BUF); }
+				for (j = 0; j < nChildItems; j++)
+					memcpy(&newItems[nNewItems+j], &childItems[j], BI_ENTRYLEN(&childItems[j]));
+				nNewItems += nChildItems;
+				free(childItems);
+			}
+		}
+
+		if (nNewItems > 0)
+		{
+			e = edubtm_InsertBatchInternal(catObjForFile, root, &apage->bi, kdesc, newItems, nNewItems, items, nItems);
+			free(newItems);
+			if (e < 0) ERRB1(e, root, PAGE_BUF);
+		}
+	}
+
+	e = BfM_SetDirty(root, PAGE_BUF);
+	if (e < 0) ERRB1(e, root, PAGE_BUF);
+
+	e = BfM_FreeTrain(root, PAGE_BUF);
+	if (e < 0) ERR(e);
+
+	return(eNOERROR);
+
+} /* edubtm_InsertBatch() */
+
+
+
+/*@================================
+ * edubtm_InsertBatchLeaf()
+ *================================*/
+/*
+ * Function: Four edubtm_InsertBatchLeaf(ObjectID*, PageID*, BtreeLeaf*, KeyDesc*,
+ *                                       BtreeBatchItem*, Four*, Four, InternalItem**, Four*)
+ *
+ * Description:
+ *  Merge the sorted run of items into the leaf. If they do not fit, the
+ *  entries of the leaf and the items are laid out in key order over the
+ *  leaf and as few new leaves as needed, filled evenly.
+ *
+ * Returns:
+ *  error code
+ *    eDUPLICATEDKEY_BTM
+ *    eDUPLICATEDOBJECTID_BTM
+ *    eMEMORYALLOCERR_BTM
+ *    some errors caused by function calls
+ *
+ * Side effects:
+ *  items, nItems : the internal items of the new leaves
+ */
+Four edubtm_InsertBatchLeaf(
+    ObjectID            *catObjForFile, /* IN catalog object of B+ tree file */
+    PageID              *pid,           /* IN PageID of the leaf */
+    BtreeLeaf           *page,          /* INOUT buffer of the leaf */
+    KeyDesc             *kdesc,         /* IN a key descriptor */
+    BtreeBatchItem      *pairs,         /* IN the items of the batch */
+    Four                *order,         /* IN indexes of the run in key order */
+    Four                n,              /* IN # of items of the run */
+    InternalItem        **items,        /* OUT items of the new leaves */
+    Four                *nItems)        /* OUT # of 'items' */
+{
+    Four                e;              /* error number */
+    Four                i, j;           /* next entry of 'old' and next item of the run */
+    Four                cmp;            /* result of comparison */
+    Four                total;          /* size of all the entries and their slots */
+    Four                target;         /* size to fill each leaf up to */
+    Four                used;           /* size filled in the current leaf */
+    Four                len;            /* size of an entry and its slot */
+    Four                nPages;         /* # of leaves needed */
+    Four                capacity;       /* size available in a leaf */
+    BtreeLeaf           old;            /* copy of the leaf before the insertion */
+    btm_LeafEntry       *lEntry;        /* an entry of 'old' */
+    LeafItem            leaf;           /* the entry to lay out next */
+    ObjectID            tOid;           /* ObjectID of 'lEntry' */
+    PageID              curPid;         /* the leaf being filled */
+    PageID              newPid;         /* a new leaf */
+    PageID              nextPid;        /* the leaf following the new leaves */
+    BtreeLeaf           *cpage;         /* buffer of 'curPid' */
+    BtreeLeaf           *npage;         /* buffer of 'newPid' */
+
+
+	*items = NULL;
+	*nItems = 0;
+
+	memcpy(&old, page, PAGESIZE);
+
+	// Check the duplicated keys and sum up the size before changing the leaf.
+	total = BL_USED(&old);
+	for (i = 0, j = 0; j < n; j++)
+	{
+		for (; i < old.hdr.nSlots; i++)
+		{
+			lEntry = (btm_LeafEntry*)&(old.data[old.slot[-1*i]]);
+			cmp = edubtm_KeyCompare(kdesc, (KeyValue*)&lEntry->klen, &pairs[order[j]].kval);
+			if (cmp == EQUAL)
+			{
+				edubtm_GetOid(&old, lEntry, &tOid);
+				ERR(edubtm_DuplicateError(kdesc, &tOid, &pairs[order[j]].oid));
+			}
+			if (cmp == GREATER) break;
+		}
+		total += 2*sizeof(Two) + ALIGNED_LENGTH(pairs[order[j]].kval.len)
+				+ ((old.hdr.type & PACKED) ? edubtm_PackOid(&old, &pairs[order[j]].oid, NULL) : sizeof(ObjectID))
+				+ ALIGNED_LENGTH(old.hdr.reserved) + sizeof(Two);
+	}
+
+	// The leaf is filled from empty; the entries are copied from 'old'.
+	capacity = BL_CAPACITY - BL_DATASTART(&old);
+	nPages = (total + capacity - 1) / capacity;
+	target = (total + nPages - 1) / nPages;
+	if (nPages > 1)
+	{
+		*items = (InternalItem*)malloc((2*nPages+1)*sizeof(InternalItem));
+		if (*items == NULL) ERR(eMEMORYALLOCERR_BTM);
+	}
+
+	page->hdr.nSlots = 0;
+	page->hdr.free = BL_DATASTART(page);
+	page->hdr.unused = 0;
+
+	curPid = *pid;
+	cpage = page;
+	used = 0;
+	for (i = 0, j = 0; i < old.hdr.nSlots || j < n; )
+	{
+		if (i < old.hdr.nSlots)
+			lEntry = (btm_LeafEntry*)&(old.data[old.slot[-1*i]]);
+		if (j >= n || (i < old.hdr.nSlots &&
+				edubtm_KeyCompare(kdesc, (KeyValue*)&lEntry->klen, &pairs[order[j]].kval) == LESS))
+		{
+			leaf.nObjects = lEntry->nObjects;
+			leaf.klen = lEntry->klen;
+			memcpy(leaf.kval, lEntry->kval, lEntry->klen);
+			edubtm_GetOid(&old, lEntry, &leaf.oid);
+			memcpy(leaf.included, BL_INCLUDED(&old, lEntry), old.hdr.reserved);
+			i++;
+		}
+		else
+		{
+			leaf.nObjects = 1;
+			BTM_COPY_KEY(&leaf.klen, &pairs[order[j]].kval);
+			leaf.oid = pairs[order[j]].oid;
+			memset(leaf.included, 0, old.hdr.reserved);
+			j++;
+		}
+		len = BL_ITEMLEN(cpage, &leaf) + sizeof(Two);
+
+		// Go to a new leaf when the current one is filled.
+		if (cpage->hdr.nSlots > 0 && (used >= target || used + len > capacity))
+		{
+			e = btm_AllocPage(catObjForFile, &curPid, &newPid);
+			if (e < 0) ERR(e);
+
+			e = edubtm_InitLeaf(&newPid, FALSE, FALSE);
+			if (e < 0) ERR(e);
+
+			e = edubtm_GetTrain(&newPid, &npage, PAGE_BUF);
+			if (e < 0) ERR(e);
+
+			edubtm_CopyLeafFormat(npage, cpage);
+			npage->hdr.prevPage = curPid.pageNo;
+			npage->hdr.nextPage = cpage->hdr.nextPage;
+			cpage->hdr.nextPage = newPid.pageNo;
+
+			if (cpage != page)
+			{
+				e = BfM_SetDirty(&curPid, PAGE_BUF);
+				if (e < 0) ERRB2(e, &curPid, PAGE_BUF, &newPid, PAGE_BUF);
+				e = BfM_FreeTrain(&curPid, PAGE_BUF);
+				if (e < 0) ERRB1(e, &newPid, PAGE_BUF);
+			}
+
+			(*items)[*nItems].spid = newPid.pageNo;
+			memcpy(&(*items)[*nItems].klen, &leaf.klen, sizeof(Two) + leaf.klen);
+			(*nItems)++;
+
+			curPid = newPid;
+			cpage = npage;
+			used = 0;
+		}
+
+		edubtm_InsertLeafEntry(cpage, cpage->hdr.nSlots, &leaf);
+		used += len;
+	}
+
+	// The leaf after the new leaves points back to the last one.
+	if (cpage != page)
+	{
+		if (cpage->hdr.nextPage != NIL)
+		{
+			MAKE_PAGEID(nextPid, curPid.volNo, cpage->hdr.nextPage);
+			e = edubtm_GetTrain(&nextPid, &npage, PAGE_BUF);
+			if (e < 0) ERRB1(e, &curPid, PAGE_BUF);
+			npage->hdr.prevPage = curPid.pageNo;
+			e = BfM_SetDirty(&nextPid, PAGE_BUF);
+			if (e < 0) ERRB2(e, &nextPid, PAGE_BUF, &curPid, PAGE_BUF);
+			e = BfM_FreeTrain(&nextPid, PAGE_BUF);
+			if (e < 0) ERRB1(e, &curPid, PAGE_BUF);
+		}
+
+		e = BfM_SetDirty(&curPid, PAGE_BUF);
+		if (e < 0) ERRB1(e, &curPid, PAGE_BUF);
+		e = BfM_FreeTrain(&curPid, PAGE_BUF);
+		if (e < 0) ERR(e);
+	}
+
+	return(eNOERROR);
+
+} /* edubtm_InsertBatchLeaf() */
+
+
+
+/*@================================
+ * edubtm_InsertBatchInternal()
+ *================================*/
+/*
+ * Function: Four edubtm_InsertBatchInternal(ObjectID*, PageID*, BtreeInternal*, KeyDesc*,
+ *                                           InternalItem*, Four, InternalItem**, Four*)
+ *
+ * Description:
+ *  Merge the sorted internal items into the internal page. If they do not
+ *  fit, the entries are laid out over the page and as few new pages as
+ *  needed; the first entry of each new page goes up to the parent and its
+ *  child becomes 'p0' of the new page.
+ *
+ * Returns:
+ *  error code
+ *    eMEMORYALLOCERR_BTM
+ *    some errors caused by function calls
+ *
+ * Side effects:
+ *  items, nItems : the internal items of the new pages
+ *
+ * Note:
+ *  The page should have no message buffer.
+ */
+Four edubtm_InsertBatchInternal(
+    ObjectID            *catObjForFile, /* IN catalog object of B+ tree file */
+    PageID              *pid,           /* IN PageID of the internal page */
+    BtreeInternal       *page,          /* INOUT buffer of the internal page */
+    KeyDesc             *kdesc,         /* IN a key descriptor */
+    InternalItem        *newItems,      /* IN the sorted items to insert */
+    Four                nNew,           /* IN # of 'newItems' */
+    InternalItem        **items,        /* OUT items of the new pages */
+    Four                *nItems)        /* OUT # of 'items' */
+{
+    Four                e;              /* error number */
+    Four                i, j;           /* next entry of 'old' and next item of 'newItems' */
+    Four                total;          /* size of all the entries and their slots */
+    Four                target;         /* size to fill each page up to */
+    Four                used;           /* size filled in the current page */
+    Four                len;            /* size of an entry and its slot */
+    Four                nPages;         /* # of pages needed */
+    BtreeInternal       old;            /* copy of the page before the insertion */
+    btm_InternalEntry   *iEntry;        /* an entry of 'old' */
+    InternalItem        *next;          /* the entry to lay out next */
+    InternalItem        tItem;          /* an entry of 'old' as an item */
+    PageID              curPid;         /* the page being filled */
+    PageID              newPid;         /* a new page */
+    BtreeInternal       *cpage;         /* buffer of 'curPid' */
+    BtreeInternal       *npage;         /* buffer of 'newPid' */
+
+
+	*items = NULL;
+	*nItems = 0;
+
+	edubtm_TopCacheInvalidate(pid);
+
+	total = BI_USED(page);
+	for (j = 0; j < nNew; j++)
+		total += sizeof(ShortPageID) + sizeof(Two) + ALIGNED_LENGTH(newItems[j].klen) + sizeof(Two);
+
+	// All the items fit; put each in its place.
+	if (total <= BI_CAPACITY)
+	{
+		for (i = 0, j = 0; j < nNew; j++)
+		{
+			for (; i < page->hdr.nSlots; i++)
+			{
+				iEntry = (btm_InternalEntry*)&(page->data[page->slot[-1*i]]);
+				if (edubtm_KeyCompare(kdesc, (KeyValue*)&iEntry->klen, (KeyValue*)&newItems[j].klen) == GREATER)
+					break;
+			}
+			edubtm_InsertInternalEntry(page, i, &newItems[j]);
+			i++;
+		}
+
+		return(eNOERROR);
+	}
+
+	memcpy(&old, page, PAGESIZE);
+
+	nPages = (total + BI_CAPACITY - 1) / BI_CAPACITY;
+	target = (total + nPages - 1) / nPages;
+	*items = (InternalItem*)malloc((2*nPages+1)*sizeof(InternalItem));
+	if (*items == NULL) ERR(eMEMORYALLOCERR_BTM);
+
+	page->hdr.nSlots = 0;
+	page->hdr.free = 0;
+	page->hdr.unused = 0;
+
+	curPid = *pid;
+	cpage = page;
+	used = 0;
+	for (i = 0, j = 0; i < old.hdr.nSlots || j < nNew; )
+	{
+		if (i < old.hdr.nSlots)
+		{
+			iEntry = (btm_InternalEntry*)&(old.data[old.slot[-1*i]]);
+			memcpy(&tItem, iEntry, BI_ENTRYLEN(iEntry));
+		}
+		if (j >= nNew || (i < old.hdr.nSlots &&
+				edubtm_KeyCompare(kdesc, (KeyValue*)&tItem.klen, (KeyValue*)&newItems[j].klen) == LESS))
+		{
+			next = &tItem;
+			i++;
+		}
+		else
+			next = &newItems[j++];
+		len = BI_ENTRYLEN(next) + sizeof(Two);
+
+		// Go to a new page when the current one is filled; 'next' goes up.
+		if (cpage->hdr.nSlots > 0 && (used >= target || used + len > BI_CAPACITY))
+		{
+			e = btm_AllocPage(catObjForFile, &curPid, &newPid);
+			if (e < 0) ERR(e);
+
+			e = edubtm_InitInternal(&newPid, FALSE, FALSE);
+			if (e < 0) ERR(e);
+
+			e = edubtm_GetTrain(&newPid, &npage, PAGE_BUF);
+			if (e < 0) ERR(e);
+
+			npage->hdr.p0 = next->spid;
+
+			if (cpage != page)
+			{
+				e = BfM_SetDirty(&curPid, PAGE_BUF);
+				if (e < 0) ERRB2(e, &curPid, PAGE_BUF, &newPid, PAGE_BUF);
+				e = BfM_FreeTrain(&curPid, PAGE_BUF);
+				if (e < 0) ERRB1(e, &newPid, PAGE_BUF);
+			}
+
+			(*items)[*nItems].spid = newPid.pageNo;
+			memcpy(&(*items)[*nItems].klen, &next->klen, sizeof(Two) + next->klen);
+			(*nItems)++;
+
+			curPid = newPid;
+			cpage = npage;
+			used = 0;
+			continue;
+		}
+
+		edubtm_InsertInternalEntry(cpage, cpage->hdr.nSlots, next);
+		used += len;
+	}
+
+	if (cpage != page)
+	{
+		e = BfM_SetDirty(&curPid, PAGE_BUF);
+		if (e < 0) ERRB1(e, &curPid, PAGE_BUF);
+		e = BfM_FreeTrain(&curPid, PAGE_BUF);
+		if (e < 0) ERR(e);
+	}
+
+	return(eNOERROR);
+
+} /* edubtm_InsertBatchInternal() */
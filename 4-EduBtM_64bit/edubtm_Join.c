@@ -0,0 +1,248 @@
+/******************************************************************************/
+/*                                                                            */
+/*    ODYSSEUS/EduCOSMOS Educational-Purpose Object Storage System            */
+/*                                                                            */
+/*    Developed by Professor Kyu-Young Whang et al.                           */
+/*                                                                            */
+/*    Database and Multimedia Laboratory                                      */
+/*                                                                            */
+/*    Computer Science Department and                                         */
+/*    Advanced Information Technology Research Center (AITrc)                 */
+/*    Korea Advanced Institute of Science and Technology (KAIST)              */
+/*                                                                            */
+/*    e-mail: kywhang@cs.kaist.ac.kr                                          */
+/*    phone: +82-42-350-7722                                                  */
+/*    fax: +82-42-350-8380                                                    */
+/*                                                                            */
+/*    Copyright (c) 1995-2013 by Kyu-Young Whang                              */
+/*                                                                            */
+/*    All rights reserved. No part of this software may be reproduced,        */
+/*    stored in a retrieval system, or transmitted, in any form or by any     */
+/*    means, electronic, mechanical, photocopying, recording, or otherwise,   */
+/*    without prior written permission of the copyright owner.                */
+/*                                                                            */
+/******************************************************************************/
+/*
+ * Module: edubtm_Join.c
+ *
+ * Description :
+ *  Steps of the joins done by EduBtM_IndexJoin() and EduBtM_MergeJoin().
+ *
+ * Exports:
+ *  Four edubtm_IndexJoin(PageID*, KeyDesc*, BtreeBatchItem*, Four*, Four, BtreeJoinPair*, Four*)
+ *  Four edubtm_MergeJoin(KeyDesc*, KeyDesc*, KeyValue*, Four, BtreeJoinCursor*, BtreeJoinPair*,
+ *                        Four, Four*)
+ */
+
+
+#include "EduBtM_common.h"
+#include "BfM.h"
+#include "EduBtM_Internal.h"
+
+
+
+/*@================================
+ * edubtm_IndexJoin()
+ *================================*/
+/*
+ * Function: Four edubtm_IndexJoin(PageID*, KeyDesc*, BtreeBatchItem*, Four*, Four,
+ *                                 BtreeJoinPair*, Four*)
+ *
+ * Description:
+ *  Look up the sorted run of outer keys in the subtree 'root'. An internal
+ *  page cuts the run at its separators and gives each part to the child;
+ *  a leaf appends a pair to 'pairs' for each key found in it.
+ *
+ * Returns:
+ *  error code
+ *    some errors caused by function calls
+ */
+Four edubtm_IndexJoin(
+    PageID              *root,          /* IN root of the subtree */
+    KeyDesc             *kdesc,         /* IN a key descriptor */
+    BtreeBatchItem      *outer,         /* IN the outer rows */
+    Four                *order,         /* IN indexes of the run in key order */
+    Four                n,              /* IN # of rows of the run */
+    BtreeJoinPair       *pairs,         /* INOUT the matching pairs */
+    Four                *nPairs)        /* INOUT # of 'pairs' */
+{
+    Four                e;              /* error number */
+    Four                i, end;         /* the part [i, end) of the run goes to a child */
+    Two                 idx;            /* slot No. of the child or of the entry */
+    PageID              child;          /* a child page */
+    BtreePage           *apage;         /* buffer of 'root' */
+    btm_InternalEntry   *iEntry;        /* an internal entry */
+    btm_LeafEntry       *lEntry;        /* a leaf entry */
+
+
+	e = edubtm_GetTrain(root, &apage, PAGE_BUF);
+	if (e < 0) ERR(e);
+
+	if (apage->any.hdr.type & LEAF)
+	{
+		for (i = 0; i < n; i++)
+		{
+			if (edubtm_BinarySearchLeaf(&apage->bl, kdesc, &outer[order[i]].kval, &idx) == TRUE)
+			{
+				lEntry = (btm_LeafEntry*)&(apage->bl.data[apage->bl.slot[-1*idx]]);
+				pairs[*nPairs].outer = outer[order[i]].oid;
+				edubtm_GetOid(&apage->bl, lEntry, &pairs[*nPairs].inner);
+				(*nPairs)++;
+			}
+		}
+	}
+	else
+	{
+		for (i = 0; i < n; i = end)
+		{
+			edubtm_BinarySearchInternal(&apage->bi, kdesc, &outer[order[i]].kval, &idx);
+			if (idx >= 0)
+			{
+				iEntry = (btm_InternalEntry*)&(apage->bi.data[apage->bi.slot[-1*idx]]);
+				MAKE_PAGEID(child, root->volNo, iEntry->spid);
+			}
+			else
+				MAKE_PAGEID(child, root->volNo, apage->bi.hdr.p0);
+
+			// The part ends at the separator of the next child.
+			end = n;
+			if (idx+1 < apage->bi.hdr.nSlots)
+			{
+				iEntry = (btm_InternalEntry*)&(apage->bi.data[apage->bi.slot[-1*(idx+1)]]);
+				for (end = i+1; end < n; end++)
+					if (edubtm_KeyCompare(kdesc, &outer[order[end]].kval, (KeyValue*)&iEntry->klen) != LESS)
+						break;
+			}
+
+			e = edubtm_IndexJoin(&child, kdesc, outer, order+i, end-i, pairs, nPairs);
+			if (e < 0) ERRB1(e, root, PAGE_BUF);
+		}
+	}
+
+	e = BfM_FreeTrain(root, PAGE_BUF);
+	if (e < 0) ERR(e);
+
+	return(eNOERROR);
+
+} /* edubtm_IndexJoin() */
+
+
+
+/*@================================
+ * edubtm_MergeJoin()
+ *================================*/
+/*
+ * Function: Four edubtm_MergeJoin(KeyDesc*, KeyDesc*, KeyValue*, Four, BtreeJoinCursor*,
+ *                                 BtreeJoinPair*, Four, Four*)
+ *
+ * Description:
+ *  Scan the leaves of the outer and the inner index together from the
+ *  position of 'cursor' until 'maxPairs' pairs are found or a key does not
+ *  satisfy the stop condition. The current leaf of each index stays fixed
+ *  until the scan leaves it.
+ *
+ * Returns:
+ *  error code
+ *    some errors caused by function calls
+ *
+ * Side effects:
+ *  cursor : the position to continue from, or CURSOR_EOS
+ */
+Four edubtm_MergeJoin(
+    KeyDesc             *outerKdesc,    /* IN key descriptor of the outer index */
+    KeyDesc             *innerKdesc,    /* IN key descriptor of the inner index */
+    KeyValue            *kval,          /* IN key value of stop condition */
+    Four                compOp,         /* IN comparison operator of stop condition */
+    BtreeJoinCursor     *cursor,        /* INOUT position of the join */
+    BtreeJoinPair       *pairs,         /* OUT the matching pairs */
+    Four                maxPairs,       /* IN room of 'pairs' */
+    Four                *nPairs)        /* OUT # of 'pairs' */
+{
+    Four                e;              /* error number */
+    Four                cmp;            /* result of comparison */
+    Two                 i;              /* 0 for the outer index and 1 for the inner one */
+    Two                 idx;            /* slot No. found by the binary search */
+    KeyDesc             *kdesc[2];      /* key descriptors of the two indexes */
+    PageID              nextPid;        /* the next leaf */
+    BtreeLeaf           *apage[2];      /* buffers of the current leaves */
+    btm_LeafEntry       *entry[2];      /* the current entries */
+    btm_LeafEntry       *last;          /* the last entry of a leaf */
+
+
+	kdesc[0] = outerKdesc;
+	kdesc[1] = innerKdesc;
+
+	e = edubtm_GetTrain(&cursor->leaf[0], &apage[0], PAGE_BUF);
+	if (e < 0) ERR(e);
+
+	e = edubtm_GetTrain(&cursor->leaf[1], &apage[1], PAGE_BUF);
+	if (e < 0) ERRB1(e, &cursor->leaf[0], PAGE_BUF);
+
+	while (*nPairs < maxPairs)
+	{
+		for (i = 0; i < 2 && cursor->flag == CURSOR_ON; i++)
+		{
+			// Go to the next leaf at the end of the current one.
+			while (cursor->slotNo[i] >= apage[i]->hdr.nSlots)
+			{
+				if (apage[i]->hdr.nextPage == NIL)
+				{
+					cursor->flag = CURSOR_EOS;
+					break;
+				}
+
+				MAKE_PAGEID(nextPid, cursor->leaf[i].volNo, apage[i]->hdr.nextPage);
+				e = BfM_FreeTrain(&cursor->leaf[i], PAGE_BUF);
+				if (e < 0) ERRB1(e, &cursor->leaf[1-i], PAGE_BUF);
+
+				cursor->leaf[i] = nextPid;
+				e = edubtm_GetTrain(&cursor->leaf[i], &apage[i], PAGE_BUF);
+				if (e < 0) ERRB1(e, &cursor->leaf[1-i], PAGE_BUF);
+				cursor->slotNo[i] = 0;
+			}
+			if (cursor->flag == CURSOR_EOS) break;
+
+			entry[i] = (btm_LeafEntry*)&(apage[i]->data[apage[i]->slot[-1*cursor->slotNo[i]]]);
+
+			// No key beyond the stop condition can be matched on the other side.
+			if (compOp != SM_EOF)
+			{
+				cmp = edubtm_KeyCompare(kdesc[i], (KeyValue*)&entry[i]->klen, kval);
+				if ((compOp == SM_LT && cmp != LESS) || (compOp == SM_LE && cmp == GREATER))
+					cursor->flag = CURSOR_EOS;
+			}
+		}
+		if (cursor->flag == CURSOR_EOS) break;
+
+		cmp = edubtm_KeyCompare(kdesc[0], (KeyValue*)&entry[0]->klen, (KeyValue*)&entry[1]->klen);
+		if (cmp == EQUAL)
+		{
+			edubtm_GetOid(apage[0], entry[0], &pairs[*nPairs].outer);
+			edubtm_GetOid(apage[1], entry[1], &pairs[*nPairs].inner);
+			(*nPairs)++;
+
+			cursor->slotNo[0]++;
+			cursor->slotNo[1]++;
+			continue;
+		}
+
+		// The index behind skips to the first key not less than the key of the other one.
+		i = (cmp == LESS) ? 0 : 1;
+		last = (btm_LeafEntry*)&(apage[i]->data[apage[i]->slot[-1*(apage[i]->hdr.nSlots-1)]]);
+		if (edubtm_KeyCompare(kdesc[i], (KeyValue*)&last->klen, (KeyValue*)&entry[1-i]->klen) == LESS)
+			cursor->slotNo[i] = apage[i]->hdr.nSlots;
+		else if (edubtm_BinarySearchLeaf(apage[i], kdesc[i], (KeyValue*)&entry[1-i]->klen, &idx) == TRUE)
+			cursor->slotNo[i] = idx;
+		else
+			cursor->slotNo[i] = idx + 1;
+	}
+
+	e = BfM_FreeTrain(&cursor->leaf[0], PAGE_BUF);
+	if (e < 0) ERRB1(e, &cursor->leaf[1], PAGE_BUF);
+
+	e = BfM_FreeTrain(&cursor->leaf[1], PAGE_BUF);
+	if (e < 0) ERR(e);
+
+	return(eNOERROR);
+
+} /* edubtm_MergeJoin() */
@@ -94,29 +94,41 @@ Four edubtm_LastObject(
             ERR(eNOTSUPPORTED_EDUBTM);
     }
     
-	e = BfM_GetTrain(root, &apage, PAGE_BUF);
+	e = edubtm_GetTrain(root, &apage, PAGE_BUF);
 	if (e < 0) ERR(e);
 	
     if (apage->any.hdr.type & INTERNAL)
 	{
-		MAKE_PAGEID(child, root->volNo, apage->bi.hdr.p0);
-		edubtm_LastObject(&child, kdesc, stopKval, stopCompOp, cursor);
+		/* The rightmost child holds the largest keys. */
+		if (apage->bi.hdr.nSlots > 0)
+		{
+			iEntry = (btm_InternalEntry*)(apage->bi.data + apage->bi.slot[-1*(apage->bi.hdr.nSlots-1)]);
+			MAKE_PAGEID(child, root->volNo, iEntry->spid);
+		}
+		else
+			MAKE_PAGEID(child, root->volNo, apage->bi.hdr.p0);
+
+		edubtm_traceDepth++;
+		e = edubtm_LastObject(&child, kdesc, stopKval, stopCompOp, cursor);
+		edubtm_traceDepth--;
+		if (e < 0) ERRB1(e, root, PAGE_BUF);
 	}
 	else if (apage->any.hdr.type & LEAF)
 	{
-		if (apage->bl.hdr.nextPage != NIL)
+		if (apage->bl.hdr.nSlots == 0)
 		{
-			MAKE_PAGEID(curPid, root->volNo, apage->bl.hdr.nextPage);
-			edubtm_LastObject(&curPid, kdesc, stopKval, stopCompOp, cursor);
+			/* the index is empty */
+			cursor->flag = CURSOR_EOS;
 		}
 		else
 		{
 			lEntry = apage->bl.data + apage->bl.slot[-1*(apage->bl.hdr.nSlots-1)];
-			alignedKlen = ALIGNED_LENGTH(lEntry->klen);
 		
 			cursor->flag = CURSOR_ON;
-			memcpy(&cursor->oid, &lEntry->kval + alignedKlen, sizeof(ObjectID));
-			memcpy(&cursor->key, &lEntry->klen, sizeof(KeyValue));
+			edubtm_GetOid(&apage->bl, lEntry, &cursor->oid);
+			cursor->includedLen = apage->bl.hdr.reserved;
+			memcpy(cursor->included, BL_INCLUDED(&apage->bl, lEntry), cursor->includedLen);
+			BTM_COPY_KEY(&cursor->key, &lEntry->klen);
 			cursor->leaf = *root;
 			cursor->slotNo = apage->bl.hdr.nSlots-1;
 		}
@@ -0,0 +1,478 @@
+/******************************************************************************/
+/*                                                                            */
+/*    ODYSSEUS/EduCOSMOS Educational-Purpose Object Storage System            */
+/*                                                                            */
+/*    Developed by Professor Kyu-Young Whang et al.                           */
+/*                                                                            */
+/*    Database and Multimedia Laboratory                                      */
+/*                                                                            */
+/*    Computer Science Department and                                         */
+/*    Advanced Information Technology Research Center (AITrc)                 */
+/*    Korea Advanced Institute of Science and Technology (KAIST)              */
+/*                                                                            */
+/*    e-mail: kywhang@cs.kaist.ac.kr                                          */
+/*    phone: +82-42-350-7722                                                  */
+/*    fax: +82-42-350-8380                                                    */
+/*                                                                            */
+/*    Copyright (c) 1995-2013 by Kyu-Young Whang                              */
+/*                                                                            */
+/*    All rights reserved. No part of this software may be reproduced,        */
+/*    stored in a retrieval system, or transmitted, in any form or by any     */
+/*    means, electronic, mechanical, photocopying, recording, or otherwise,   */
+/*    without prior written permission of the copyright owner.                */
+/*                                                                            */
+/******************************************************************************/
+/*
+ * Module: edubtm_Merge.c
+ *
+ * Description:
+ *  Handle the underflow of a page after a deletion. The underflowed child
+ *  is merged with its sibling when the two fit in one page, or the entries
+ *  are redistributed between them otherwise. The entries are moved in
+ *  place by the functions of edubtm_Move.c.
+ *
+ *  The sibling is the right one if it exists, and the left one otherwise.
+ *  The right page of the two is always the one freed by a merge.
+ *
+ * Exports:
+ *  Four edubtm_Underflow(ObjectID*, BtreeInternal*, PageID*, Two, Boolean*,
+ *                        Boolean*, InternalItem*, Pool*, DeallocListElem*)
+ *  Four edubtm_FreePage(PageID*, Pool*, DeallocListElem*)
+ */
+
+
+#include <string.h>
+#include "EduBtM_common.h"
+#include "Util.h"
+#include "BfM.h"
+#include "EduBtM_Internal.h"
+
+
+/*@ Internal Function Prototypes */
+Four edubtm_MergeLeaf(BtreeInternal*, Two, BtreeLeaf*, BtreeLeaf*, Pool*, DeallocListElem*);
+Four edubtm_MergeInternal(BtreeInternal*, Two, BtreeInternal*, BtreeInternal*, Pool*, DeallocListElem*);
+void edubtm_RedistributeLeaf(BtreeLeaf*, BtreeLeaf*, InternalItem*);
+void edubtm_RedistributeInternal(BtreeInternal*, BtreeInternal*, InternalItem*);
+
+
+/* # of the merges and the redistributions; for the benchmarks */
+Four edubtm_nMerges = 0;
+Four edubtm_nRedistributions = 0;
+
+
+
+/*@================================
+ * edubtm_Underflow()
+ *================================*/
+/*
+ * Function: Four edubtm_Underflow(ObjectID*, BtreeInternal*, PageID*, Two, Boolean*,
+ *                                 Boolean*, InternalItem*, Pool*, DeallocListElem*)
+ *
+ * Description:
+ *  The child 'child' of the internal page 'ppage', reached by the slot
+ *  'slotNo' of 'ppage' (-1 for 'p0'), is less than half full. Merge it with
+ *  its sibling or redistribute the entries of the two pages. A merge
+ *  removes an entry from 'ppage'; a redistribution replaces the separating
+ *  entry of 'ppage', which may split 'ppage'.
+ *
+ * Returns:
+ *  Error code
+ *    some errors caused by function calls
+ *
+ * Side effects:
+ *  f    : TRUE if 'ppage' becomes less than half full.
+ *  h    : TRUE if 'ppage' is splitted.
+ *  item : The internal item to be inserted into the parent of 'ppage' if 'h' is TRUE.
+ *
+ * Note:
+ *  The caller should call BfM_SetDirty() for 'ppage'.
+ */
+Four edubtm_Underflow(
+    ObjectID                    *catObjForFile, /* IN catalog object of B+ tree file */
+    BtreeInternal               *ppage,         /* INOUT parent of the underflowed page */
+    PageID                      *child,         /* IN the underflowed page */
+    Two                         slotNo,         /* IN slot No. of 'child' in 'ppage' */
+    Boolean                     *f,             /* OUT whether 'ppage' is not half full */
+    Boolean                     *h,             /* OUT whether 'ppage' is splitted */
+    InternalItem                *item,          /* OUT the internal item to be returned */
+    Pool                        *dlPool,        /* INOUT pool of dealloc list elements */
+    DeallocListElem             *dlHead)        /* INOUT head of the dealloc list */
+{
+    Four                        e;              /* error number */
+    Two                         sepIdx;         /* slot No. of the entry separating the two pages */
+    PageID                      leftPid;        /* the left page of the two */
+    PageID                      rightPid;       /* the right page of the two */
+    BtreePage                   *lpage;         /* buffer of the left page */
+    BtreePage                   *rpage;         /* buffer of the right page */
+    btm_InternalEntry           *iEntry;        /* an internal entry of 'ppage' */
+    InternalItem                sep;            /* the new separating item */
+    Boolean                     merged;         /* TRUE if the two pages are merged */
+
+
+    *f = *h = FALSE;
+
+	if (ppage->hdr.nSlots == 0) return(eNOERROR);
+
+	edubtm_TopCacheInvalidate(&ppage->hdr.pid);
+
+	// Decide the sibling.
+	if (slotNo+1 < ppage->hdr.nSlots)
+	{
+		sepIdx = slotNo+1;
+		leftPid = *child;
+		iEntry = (btm_InternalEntry*)&(ppage->data[ppage->slot[-1*sepIdx]]);
+		MAKE_PAGEID(rightPid, child->volNo, iEntry->spid);
+	}
+	else
+	{
+		sepIdx = slotNo;
+		rightPid = *child;
+		if (slotNo > 0)
+		{
+			iEntry = (btm_InternalEntry*)&(ppage->data[ppage->slot[-1*(slotNo-1)]]);
+			MAKE_PAGEID(leftPid, child->volNo, iEntry->spid);
+		}
+		else
+			MAKE_PAGEID(leftPid, child->volNo, ppage->hdr.p0);
+	}
+
+	e = edubtm_GetTrain(&leftPid, &lpage, PAGE_BUF);
+	if (e < 0) ERR(e);
+
+	e = edubtm_GetTrain(&rightPid, &rpage, PAGE_BUF);
+	if (e < 0) ERRB1(e, &leftPid, PAGE_BUF);
+
+	if (lpage->any.hdr.type & LEAF)
+	{
+		merged = (BL_USED(&rpage->bl) <= (Four)BL_FREE(&lpage->bl));
+		if (merged)
+		{
+			e = edubtm_MergeLeaf(ppage, sepIdx, &lpage->bl, &rpage->bl, dlPool, dlHead);
+			if (e < 0) ERRB2(e, &leftPid, PAGE_BUF, &rightPid, PAGE_BUF);
+		}
+		else
+			edubtm_RedistributeLeaf(&lpage->bl, &rpage->bl, &sep);
+	}
+	else
+	{
+		iEntry = (btm_InternalEntry*)&(ppage->data[ppage->slot[-1*sepIdx]]);
+		merged = (BI_USED(&rpage->bi) + BI_ENTRYLEN(iEntry) + (Four)sizeof(Two) <= (Four)BI_FREE(&lpage->bi));
+		if (merged)
+		{
+			e = edubtm_MergeInternal(ppage, sepIdx, &lpage->bi, &rpage->bi, dlPool, dlHead);
+			if (e < 0) ERRB2(e, &leftPid, PAGE_BUF, &rightPid, PAGE_BUF);
+		}
+		else
+		{
+			memcpy(&sep, iEntry, BI_ENTRYLEN(iEntry));
+			edubtm_RedistributeInternal(&lpage->bi, &rpage->bi, &sep);
+		}
+	}
+
+	e = BfM_SetDirty(&leftPid, PAGE_BUF);
+	if (e < 0) ERRB2(e, &leftPid, PAGE_BUF, &rightPid, PAGE_BUF);
+
+	e = BfM_SetDirty(&rightPid, PAGE_BUF);
+	if (e < 0) ERRB2(e, &leftPid, PAGE_BUF, &rightPid, PAGE_BUF);
+
+	e = BfM_FreeTrain(&leftPid, PAGE_BUF);
+	if (e < 0) ERRB1(e, &rightPid, PAGE_BUF);
+
+	e = BfM_FreeTrain(&rightPid, PAGE_BUF);
+	if (e < 0) ERR(e);
+
+	if (merged)
+	{
+		edubtm_nMerges++;
+		if (edubtm_tracing) edubtm_trace.nMerges++;
+		e = edubtm_FreePage(&rightPid, dlPool, dlHead);
+		if (e < 0) ERR(e);
+	}
+	else
+	{
+		edubtm_nRedistributions++;
+		if (edubtm_tracing) edubtm_trace.nRedistributions++;
+		// Replace the separating entry with the new one.
+		sep.spid = rightPid.pageNo;
+		edubtm_RemoveInternalEntries(ppage, sepIdx, 1);
+		e = edubtm_InsertInternal(catObjForFile, ppage, &sep, sepIdx-1, h, item);
+		if (e < 0) ERR(e);
+	}
+
+	if (*h == FALSE && (Four)BI_FREE(ppage) > BI_HALF)
+		*f = TRUE;
+
+
+    return(eNOERROR);
+
+} /* edubtm_Underflow() */
+
+
+
+/*@================================
+ * edubtm_MergeLeaf()
+ *================================*/
+/*
+ * Function: Four edubtm_MergeLeaf(BtreeInternal*, Two, BtreeLeaf*, BtreeLeaf*,
+ *                                 Pool*, DeallocListElem*)
+ *
+ * Description:
+ *  Append all entries of 'rpage' to 'lpage', take 'rpage' out of the
+ *  doubly linked list of the leaves, and remove the separating entry
+ *  from the parent.
+ *
+ * Returns:
+ *  Error code
+ *    some errors caused by function calls
+ */
+Four edubtm_MergeLeaf(
+    BtreeInternal               *ppage,         /* INOUT the parent page */
+    Two                         sepIdx,         /* IN slot No. of the separating entry in 'ppage' */
+    BtreeLeaf                   *lpage,         /* INOUT the left page */
+    BtreeLeaf                   *rpage,         /* INOUT the right page */
+    Pool                        *dlPool,        /* INOUT pool of dealloc list elements */
+    DeallocListElem             *dlHead)        /* INOUT head of the dealloc list */
+{
+    Four                        e;              /* error number */
+    PageID                      nextPid;        /* the next page of 'rpage' */
+    BtreeLeaf                   *npage;         /* buffer of the next page */
+
+
+	edubtm_MoveLeafEntries(rpage, 0, rpage->hdr.nSlots, lpage, lpage->hdr.nSlots);
+
+	lpage->hdr.nextPage = rpage->hdr.nextPage;
+	if (rpage->hdr.nextPage != NIL)
+	{
+		MAKE_PAGEID(nextPid, rpage->hdr.pid.volNo, rpage->hdr.nextPage);
+		e = edubtm_GetTrain(&nextPid, &npage, PAGE_BUF);
+		if (e < 0) ERR(e);
+
+		npage->hdr.prevPage = lpage->hdr.pid.pageNo;
+
+		e = BfM_SetDirty(&nextPid, PAGE_BUF);
+		if (e < 0) ERRB1(e, &nextPid, PAGE_BUF);
+
+		e = BfM_FreeTrain(&nextPid, PAGE_BUF);
+		if (e < 0) ERR(e);
+	}
+
+	edubtm_RemoveInternalEntries(ppage, sepIdx, 1);
+
+
+	return(eNOERROR);
+
+} /* edubtm_MergeLeaf() */
+
+
+
+/*@================================
+ * edubtm_MergeInternal()
+ *================================*/
+/*
+ * Function: Four edubtm_MergeInternal(BtreeInternal*, Two, BtreeInternal*, BtreeInternal*,
+ *                                     Pool*, DeallocListElem*)
+ *
+ * Description:
+ *  Pull the separating entry down into 'lpage' pointing to the first child
+ *  of 'rpage', and append all entries of 'rpage' after it.
+ *
+ * Returns:
+ *  Error code
+ *    some errors caused by function calls
+ */
+Four edubtm_MergeInternal(
+    BtreeInternal               *ppage,         /* INOUT the parent page */
+    Two                         sepIdx,         /* IN slot No. of the separating entry in 'ppage' */
+    BtreeInternal               *lpage,         /* INOUT the left page */
+    BtreeInternal               *rpage,         /* INOUT the right page */
+    Pool                        *dlPool,        /* INOUT pool of dealloc list elements */
+    DeallocListElem             *dlHead)        /* INOUT head of the dealloc list */
+{
+    InternalItem                sep;            /* the separating item */
+    btm_InternalEntry           *iEntry;        /* the separating entry in 'ppage' */
+
+
+	iEntry = (btm_InternalEntry*)&(ppage->data[ppage->slot[-1*sepIdx]]);
+	memcpy(&sep, iEntry, BI_ENTRYLEN(iEntry));
+	sep.spid = rpage->hdr.p0;
+
+	edubtm_InsertInternalEntry(lpage, lpage->hdr.nSlots, &sep);
+	edubtm_MoveInternalEntries(rpage, 0, rpage->hdr.nSlots, lpage, lpage->hdr.nSlots);
+
+	edubtm_RemoveInternalEntries(ppage, sepIdx, 1);
+
+
+	return(eNOERROR);
+
+} /* edubtm_MergeInternal() */
+
+
+
+/*@================================
+ * edubtm_RedistributeLeaf()
+ *================================*/
+/*
+ * Function: void edubtm_RedistributeLeaf(BtreeLeaf*, BtreeLeaf*, InternalItem*)
+ *
+ * Description:
+ *  Move the entries from the fuller page to the other until the two pages
+ *  are balanced, and return the first key of 'rpage' as the new separator.
+ *
+ * Returns:
+ *  None
+ */
+void edubtm_RedistributeLeaf(
+    BtreeLeaf                   *lpage,         /* INOUT the left page */
+    BtreeLeaf                   *rpage,         /* INOUT the right page */
+    InternalItem                *sep)           /* OUT the new separating item */
+{
+    Four                        lUsed;          /* used area of 'lpage' after the move */
+    Four                        rUsed;          /* used area of 'rpage' after the move */
+    Four                        len;            /* length of an entry and its slot */
+    Two                         k;              /* # of entries to move */
+    btm_LeafEntry               *lEntry;        /* a leaf entry */
+
+
+	lUsed = BL_USED(lpage);
+	rUsed = BL_USED(rpage);
+
+	if (lUsed < rUsed)
+	{
+		for (k = 0; k < rpage->hdr.nSlots-1; k++)
+		{
+			len = BL_ENTRYLEN(rpage, (btm_LeafEntry*)&(rpage->data[rpage->slot[-1*k]])) + sizeof(Two);
+			if (lUsed + len > rUsed - len) break;
+			lUsed += len;
+			rUsed -= len;
+		}
+		edubtm_MoveLeafEntries(rpage, 0, k, lpage, lpage->hdr.nSlots);
+	}
+	else
+	{
+		for (k = 0; k < lpage->hdr.nSlots-1; k++)
+		{
+			len = BL_ENTRYLEN(lpage, (btm_LeafEntry*)&(lpage->data[lpage->slot[-1*(lpage->hdr.nSlots-1-k)]])) + sizeof(Two);
+			if (rUsed + len > lUsed - len) break;
+			rUsed += len;
+			lUsed -= len;
+		}
+		edubtm_MoveLeafEntries(lpage, lpage->hdr.nSlots-k, k, rpage, 0);
+	}
+
+	lEntry = (btm_LeafEntry*)&(rpage->data[rpage->slot[0]]);
+	sep->klen = lEntry->klen;
+	memcpy(sep->kval, lEntry->kval, lEntry->klen);
+
+} /* edubtm_RedistributeLeaf() */
+
+
+
+/*@================================
+ * edubtm_RedistributeInternal()
+ *================================*/
+/*
+ * Function: void edubtm_RedistributeInternal(BtreeInternal*, BtreeInternal*, InternalItem*)
+ *
+ * Description:
+ *  Rotate the entries through the separating entry from the fuller page
+ *  to the other until the two pages are balanced. 'sep' is the separating
+ *  item on entry and the new one on return.
+ *
+ * Returns:
+ *  None
+ */
+void edubtm_RedistributeInternal(
+    BtreeInternal               *lpage,         /* INOUT the left page */
+    BtreeInternal               *rpage,         /* INOUT the right page */
+    InternalItem                *sep)           /* INOUT the separating item */
+{
+    Four                        sepLen;         /* length of the separating entry and its slot */
+    Four                        len;            /* length of an entry and its slot */
+    btm_InternalEntry           *iEntry;        /* the entry rotated to the parent */
+    InternalItem                down;           /* the item rotated down from the parent */
+
+
+	for (;;)
+	{
+		sepLen = BI_ENTRYLEN(sep) + sizeof(Two);
+
+		if (BI_USED(lpage) < BI_USED(rpage) && rpage->hdr.nSlots > 1)
+		{
+			iEntry = (btm_InternalEntry*)&(rpage->data[rpage->slot[0]]);
+			len = BI_ENTRYLEN(iEntry) + sizeof(Two);
+			if (BI_USED(lpage) + sepLen > BI_USED(rpage) - len) break;
+
+			memcpy(&down, sep, sepLen - sizeof(Two));
+			down.spid = rpage->hdr.p0;
+			memcpy(sep, iEntry, len - sizeof(Two));
+			rpage->hdr.p0 = sep->spid;
+			edubtm_RemoveInternalEntries(rpage, 0, 1);
+			edubtm_InsertInternalEntry(lpage, lpage->hdr.nSlots, &down);
+		}
+		else if (BI_USED(rpage) < BI_USED(lpage) && lpage->hdr.nSlots > 1)
+		{
+			iEntry = (btm_InternalEntry*)&(lpage->data[lpage->slot[-1*(lpage->hdr.nSlots-1)]]);
+			len = BI_ENTRYLEN(iEntry) + sizeof(Two);
+			if (BI_USED(rpage) + sepLen > BI_USED(lpage) - len) break;
+
+			memcpy(&down, sep, sepLen - sizeof(Two));
+			down.spid = rpage->hdr.p0;
+			memcpy(sep, iEntry, len - sizeof(Two));
+			rpage->hdr.p0 = sep->spid;
+			edubtm_RemoveInternalEntries(lpage, lpage->hdr.nSlots-1, 1);
+			edubtm_InsertInternalEntry(rpage, 0, &down);
+		}
+		else
+			break;
+	}
+
+} /* edubtm_RedistributeInternal() */
+
+
+
+/*@================================
+ * edubtm_FreePage()
+ *================================*/
+/*
+ * Function: Four edubtm_FreePage(PageID*, Pool*, DeallocListElem*)
+ *
+ * Description:
+ *  Mark the given page as a free page and put it into the dealloc list.
+ *
+ * Returns:
+ *  Error code
+ *    some errors caused by function calls
+ */
+Four edubtm_FreePage(
+    PageID                      *pid,           /* IN page to be freed */
+    Pool                        *dlPool,        /* INOUT pool of dealloc list elements */
+    DeallocListElem             *dlHead)        /* INOUT head of the dealloc list */
+{
+    Four                        e;              /* error number */
+    BtreeAny                    *apage;         /* buffer of the page */
+    DeallocListElem             *dlElem;        /* an element of the dealloc list */
+
+
+	e = edubtm_GetTrain(pid, &apage, PAGE_BUF);
+	if (e < 0) ERR(e);
+
+	apage->hdr.type = FREEPAGE;
+
+	e = BfM_SetDirty(pid, PAGE_BUF);
+	if (e < 0) ERRB1(e, pid, PAGE_BUF);
+
+	e = BfM_FreeTrain(pid, PAGE_BUF);
+	if (e < 0) ERR(e);
+
+	e = Util_getElementFromPool(dlPool, &dlElem);
+	if (e < 0) ERR(e);
+
+	dlElem->type = DL_PAGE;
+	dlElem->elem.pid = *pid;
+	dlElem->next = dlHead->next;
+	dlHead->next = dlElem;
+
+
+	return(eNOERROR);
+
+} /* edubtm_FreePage() */
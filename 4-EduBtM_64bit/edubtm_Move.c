@@ -0,0 +1,365 @@
+/******************************************************************************/
+/*                                                                            */
+/*    ODYSSEUS/EduCOSMOS Educational-Purpose Object Storage System            */
+/*                                                                            */
+/*    Developed by Professor Kyu-Young Whang et al.                           */
+/*                                                                            */
+/*    Database and Multimedia Laboratory                                      */
+/*                                                                            */
+/*    Computer Science Department and                                         */
+/*    Advanced Information Technology Research Center (AITrc)                 */
+/*    Korea Advanced Institute of Science and Technology (KAIST)              */
+/*                                                                            */
+/*    e-mail: kywhang@cs.kaist.ac.kr                                          */
+/*    phone: +82-42-350-7722                                                  */
+/*    fax: +82-42-350-8380                                                    */
+/*                                                                            */
+/*    Copyright (c) 1995-2013 by Kyu-Young Whang                              */
+/*                                                                            */
+/*    All rights reserved. No part of this software may be reproduced,        */
+/*    stored in a retrieval system, or transmitted, in any form or by any     */
+/*    means, electronic, mechanical, photocopying, recording, or otherwise,   */
+/*    without prior written permission of the copyright owner.                */
+/*                                                                            */
+/******************************************************************************/
+/*
+ * Module: edubtm_Move.c
+ *
+ * Description:
+ *  Functions which move the entries of the B+ tree pages in place. The
+ *  slots of a range of entries are shifted by a single memmove() and the
+ *  entries lying next to each other in the data area are copied together,
+ *  and the 'free' and 'unused' fields are updated arithmetically instead of
+ *  rescanning the page. The split, the merge, the redistribution and the
+ *  deletion are built on them.
+ *
+ *  The space of a removed entry goes back to the contiguous free area when
+ *  the entry ends at 'hdr.free', and is counted in 'hdr.unused' otherwise.
+ *
+ * Exports:
+ *  void edubtm_MoveInternalEntries(BtreeInternal*, Two, Two, BtreeInternal*, Two)
+ *  void edubtm_MoveLeafEntries(BtreeLeaf*, Two, Two, BtreeLeaf*, Two)
+ *  void edubtm_RemoveInternalEntries(BtreeInternal*, Two, Two)
+ *  void edubtm_RemoveLeafEntries(BtreeLeaf*, Two, Two)
+ *  void edubtm_InsertInternalEntry(BtreeInternal*, Two, InternalItem*)
+ *  void edubtm_InsertLeafEntry(BtreeLeaf*, Two, LeafItem*)
+ */
+
+
+#include <string.h>
+#include "EduBtM_common.h"
+#include "EduBtM_Internal.h"
+
+
+
+/*@================================
+ * edubtm_MoveInternalEntries()
+ *================================*/
+/*
+ * Function: void edubtm_MoveInternalEntries(BtreeInternal*, Two, Two, BtreeInternal*, Two)
+ *
+ * Description:
+ *  Move 'n' entries from the slot 'from' of 'spage' to the slot 'to' of
+ *  'dpage'. The entries of 'dpage' from the slot 'to' are shifted back.
+ *
+ * Returns:
+ *  None
+ *
+ * Note:
+ *  'dpage' should have enough free space for the entries and their slots.
+ */
+void edubtm_MoveInternalEntries(
+    BtreeInternal       *spage,         /* INOUT page from which the entries are moved */
+    Two                 from,           /* IN the first slot No. of the entries in 'spage' */
+    Two                 n,              /* IN # of entries to move */
+    BtreeInternal       *dpage,         /* INOUT page to which the entries are moved */
+    Two                 to)             /* IN slot No. of the first entry in 'dpage' */
+{
+    Two                 i, j, k;        /* slot No.s */
+    Two                 runStart;       /* starting offset of adjacent entries in 'spage' */
+    Two                 runLen;         /* length of adjacent entries in 'spage' */
+    Four                len;            /* total length of the entries */
+
+
+	if (n <= 0) return;
+
+	for (len = 0, i = from; i < from+n; i++)
+		len += BI_ENTRYLEN((btm_InternalEntry*)&(spage->data[spage->slot[-1*i]]));
+	if ((Four)BI_CFREE(dpage) < len + n*(Four)sizeof(Two))
+		edubtm_CompactInternalPage(dpage, NIL);
+
+	// Open 'n' slots at 'to'.
+	if (dpage->hdr.nSlots > to)
+		memmove(&dpage->slot[-1*(dpage->hdr.nSlots-1+n)], &dpage->slot[-1*(dpage->hdr.nSlots-1)],
+				(dpage->hdr.nSlots-to)*sizeof(Two));
+
+	// Copy the entries; adjacent entries are copied together.
+	for (i = from, k = to; i < from+n; i = j)
+	{
+		runStart = spage->slot[-1*i];
+		runLen = BI_ENTRYLEN((btm_InternalEntry*)&(spage->data[runStart]));
+		for (j = i+1; j < from+n && spage->slot[-1*j] == runStart + runLen; j++)
+			runLen += BI_ENTRYLEN((btm_InternalEntry*)&(spage->data[spage->slot[-1*j]]));
+
+		memcpy(&dpage->data[dpage->hdr.free], &spage->data[runStart], runLen);
+		for (; i < j; i++, k++)
+			dpage->slot[-1*k] = dpage->hdr.free + (spage->slot[-1*i] - runStart);
+		dpage->hdr.free += runLen;
+	}
+	dpage->hdr.nSlots += n;
+
+	edubtm_RemoveInternalEntries(spage, from, n);
+
+} /* edubtm_MoveInternalEntries() */
+
+
+
+/*@================================
+ * edubtm_MoveLeafEntries()
+ *================================*/
+/*
+ * Function: void edubtm_MoveLeafEntries(BtreeLeaf*, Two, Two, BtreeLeaf*, Two)
+ *
+ * Description:
+ *  Move 'n' entries from the slot 'from' of 'spage' to the slot 'to' of
+ *  'dpage'. The entries of 'dpage' from the slot 'to' are shifted back.
+ *
+ * Returns:
+ *  None
+ *
+ * Note:
+ *  'dpage' should have enough free space for the entries and their slots.
+ */
+void edubtm_MoveLeafEntries(
+    BtreeLeaf           *spage,         /* INOUT page from which the entries are moved */
+    Two                 from,           /* IN the first slot No. of the entries in 'spage' */
+    Two                 n,              /* IN # of entries to move */
+    BtreeLeaf           *dpage,         /* INOUT page to which the entries are moved */
+    Two                 to)             /* IN slot No. of the first entry in 'dpage' */
+{
+    Two                 i, j, k;        /* slot No.s */
+    Two                 runStart;       /* starting offset of adjacent entries in 'spage' */
+    Two                 runLen;         /* length of adjacent entries in 'spage' */
+    Four                len;            /* total length of the entries */
+
+
+	if (n <= 0) return;
+
+	for (len = 0, i = from; i < from+n; i++)
+		len += BL_ENTRYLEN(spage, (btm_LeafEntry*)&(spage->data[spage->slot[-1*i]]));
+	if ((Four)BL_CFREE(dpage) < len + n*(Four)sizeof(Two))
+		edubtm_CompactLeafPage(dpage, NIL);
+
+	// Open 'n' slots at 'to'.
+	if (dpage->hdr.nSlots > to)
+		memmove(&dpage->slot[-1*(dpage->hdr.nSlots-1+n)], &dpage->slot[-1*(dpage->hdr.nSlots-1)],
+				(dpage->hdr.nSlots-to)*sizeof(Two));
+
+	// Copy the entries; adjacent entries are copied together.
+	for (i = from, k = to; i < from+n; i = j)
+	{
+		runStart = spage->slot[-1*i];
+		runLen = BL_ENTRYLEN(spage, (btm_LeafEntry*)&(spage->data[runStart]));
+		for (j = i+1; j < from+n && spage->slot[-1*j] == runStart + runLen; j++)
+			runLen += BL_ENTRYLEN(spage, (btm_LeafEntry*)&(spage->data[spage->slot[-1*j]]));
+
+		memcpy(&dpage->data[dpage->hdr.free], &spage->data[runStart], runLen);
+		for (; i < j; i++, k++)
+			dpage->slot[-1*k] = dpage->hdr.free + (spage->slot[-1*i] - runStart);
+		dpage->hdr.free += runLen;
+	}
+	dpage->hdr.nSlots += n;
+
+	edubtm_RemoveLeafEntries(spage, from, n);
+
+} /* edubtm_MoveLeafEntries() */
+
+
+
+/*@================================
+ * edubtm_RemoveInternalEntries()
+ *================================*/
+/*
+ * Function: void edubtm_RemoveInternalEntries(BtreeInternal*, Two, Two)
+ *
+ * Description:
+ *  Remove 'n' entries from the slot 'from' of the internal page.
+ *
+ * Returns:
+ *  None
+ */
+void edubtm_RemoveInternalEntries(
+    BtreeInternal       *apage,         /* INOUT internal page */
+    Two                 from,           /* IN the first slot No. of the entries */
+    Two                 n)              /* IN # of entries to remove */
+{
+    Two                 i;              /* slot No. */
+    Two                 offset;         /* starting offset of an entry */
+    Two                 len;            /* length of an entry */
+
+
+	if (n <= 0) return;
+
+	for (i = from; i < from+n; i++)
+	{
+		offset = apage->slot[-1*i];
+		len = BI_ENTRYLEN((btm_InternalEntry*)&(apage->data[offset]));
+		if (offset + len == apage->hdr.free)
+			apage->hdr.free = offset;
+		else
+			apage->hdr.unused += len;
+	}
+
+	// Close the gap of the slots.
+	if (apage->hdr.nSlots > from+n)
+		memmove(&apage->slot[-1*(apage->hdr.nSlots-1-n)], &apage->slot[-1*(apage->hdr.nSlots-1)],
+				(apage->hdr.nSlots-from-n)*sizeof(Two));
+	apage->hdr.nSlots -= n;
+
+	if (apage->hdr.nSlots == 0)
+	{
+		apage->hdr.free = apage->hdr.reserved;
+		apage->hdr.unused = 0;
+	}
+
+} /* edubtm_RemoveInternalEntries() */
+
+
+
+/*@================================
+ * edubtm_RemoveLeafEntries()
+ *================================*/
+/*
+ * Function: void edubtm_RemoveLeafEntries(BtreeLeaf*, Two, Two)
+ *
+ * Description:
+ *  Remove 'n' entries from the slot 'from' of the leaf page.
+ *
+ * Returns:
+ *  None
+ */
+void edubtm_RemoveLeafEntries(
+    BtreeLeaf           *apage,         /* INOUT leaf page */
+    Two                 from,           /* IN the first slot No. of the entries */
+    Two                 n)              /* IN # of entries to remove */
+{
+    Two                 i;              /* slot No. */
+    Two                 offset;         /* starting offset of an entry */
+    Two                 len;            /* length of an entry */
+
+
+	if (n <= 0) return;
+
+	for (i = from; i < from+n; i++)
+	{
+		offset = apage->slot[-1*i];
+		len = BL_ENTRYLEN(apage, (btm_LeafEntry*)&(apage->data[offset]));
+		if (offset + len == apage->hdr.free)
+			apage->hdr.free = offset;
+		else
+			apage->hdr.unused += len;
+	}
+
+	// Close the gap of the slots.
+	if (apage->hdr.nSlots > from+n)
+		memmove(&apage->slot[-1*(apage->hdr.nSlots-1-n)], &apage->slot[-1*(apage->hdr.nSlots-1)],
+				(apage->hdr.nSlots-from-n)*sizeof(Two));
+	apage->hdr.nSlots -= n;
+
+	if (apage->hdr.nSlots == 0)
+	{
+		apage->hdr.free = BL_DATASTART(apage);
+		apage->hdr.unused = 0;
+	}
+
+} /* edubtm_RemoveLeafEntries() */
+
+
+
+/*@================================
+ * edubtm_InsertInternalEntry()
+ *================================*/
+/*
+ * Function: void edubtm_InsertInternalEntry(BtreeInternal*, Two, InternalItem*)
+ *
+ * Description:
+ *  Insert the given item into the slot 'slotNo' of the internal page.
+ *
+ * Returns:
+ *  None
+ *
+ * Note:
+ *  The page should have enough free space for the item and its slot.
+ */
+void edubtm_InsertInternalEntry(
+    BtreeInternal       *apage,         /* INOUT internal page */
+    Two                 slotNo,         /* IN slot No. of the new entry */
+    InternalItem        *item)          /* IN item to insert */
+{
+    btm_InternalEntry   *entry;         /* the new entry */
+    Two                 len;            /* length of the new entry */
+
+
+	len = BI_ENTRYLEN(item);
+	if ((Four)BI_CFREE(apage) < len + (Four)sizeof(Two))
+		edubtm_CompactInternalPage(apage, NIL);
+
+	entry = (btm_InternalEntry*)&(apage->data[apage->hdr.free]);
+	entry->spid = item->spid;
+	entry->klen = item->klen;
+	memcpy(entry->kval, item->kval, item->klen);
+
+	if (apage->hdr.nSlots > slotNo)
+		memmove(&apage->slot[-1*apage->hdr.nSlots], &apage->slot[-1*(apage->hdr.nSlots-1)],
+				(apage->hdr.nSlots-slotNo)*sizeof(Two));
+	apage->slot[-1*slotNo] = apage->hdr.free;
+	apage->hdr.free += len;
+	apage->hdr.nSlots++;
+
+} /* edubtm_InsertInternalEntry() */
+
+
+
+/*@================================
+ * edubtm_InsertLeafEntry()
+ *================================*/
+/*
+ * Function: void edubtm_InsertLeafEntry(BtreeLeaf*, Two, LeafItem*)
+ *
+ * Description:
+ *  Insert the given item into the slot 'slotNo' of the leaf page.
+ *
+ * Returns:
+ *  None
+ *
+ * Note:
+ *  The page should have enough free space for the item and its slot.
+ */
+void edubtm_InsertLeafEntry(
+    BtreeLeaf           *apage,         /* INOUT leaf page */
+    Two                 slotNo,         /* IN slot No. of the new entry */
+    LeafItem            *item)          /* IN item to insert */
+{
+    btm_LeafEntry       *entry;         /* the new entry */
+    Two                 len;            /* length of the new entry */
+
+
+	len = BL_ITEMLEN(apage, item);
+	if ((Four)BL_CFREE(apage) < len + (Four)sizeof(Two))
+		edubtm_CompactLeafPage(apage, NIL);
+
+	entry = (btm_LeafEntry*)&(apage->data[apage->hdr.free]);
+	entry->nObjects = item->nObjects;
+	entry->klen = item->klen;
+	memcpy(entry->kval, item->kval, item->klen);
+	edubtm_PutOid(apage, entry, &item->oid);
+	memcpy(BL_INCLUDED(apage, entry), item->included, apage->hdr.reserved);
+
+	if (apage->hdr.nSlots > slotNo)
+		memmove(&apage->slot[-1*apage->hdr.nSlots], &apage->slot[-1*(apage->hdr.nSlots-1)],
+				(apage->hdr.nSlots-slotNo)*sizeof(Two));
+	apage->slot[-1*slotNo] = apage->hdr.free;
+	apage->hdr.free += len;
+	apage->hdr.nSlots++;
+
+} /* edubtm_InsertLeafEntry() */
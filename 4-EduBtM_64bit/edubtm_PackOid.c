@@ -0,0 +1,305 @@
+/******************************************************************************/
+/*                                                                            */
+/*    ODYSSEUS/EduCOSMOS Educational-Purpose Object Storage System            */
+/*                                                                            */
+/*    Developed by Professor Kyu-Young Whang et al.                           */
+/*                                                                            */
+/*    Database and Multimedia Laboratory                                      */
+/*                                                                            */
+/*    Computer Science Department and                                         */
+/*    Advanced Information Technology Research Center (AITrc)                 */
+/*    Korea Advanced Institute of Science and Technology (KAIST)              */
+/*                                                                            */
+/*    e-mail: kywhang@cs.kaist.ac.kr                                          */
+/*    phone: +82-42-350-7722                                                  */
+/*    fax: +82-42-350-8380                                                    */
+/*                                                                            */
+/*    Copyright (c) 1995-2013 by Kyu-Young Whang                              */
+/*                                                                            */
+/*    All rights reserved. No part of this software may be reproduced,        */
+/*    stored in a retrieval system, or transmitted, in any form or by any     */
+/*    means, electronic, mechanical, photocopying, recording, or otherwise,   */
+/*    without prior written permission of the copyright owner.                */
+/*                                                                            */
+/******************************************************************************/
+/*
+ * Module: edubtm_PackOid.c
+ *
+ * Description :
+ *  Packed ObjectIDs of the leaf entries. In a leaf of type PACKED the
+ *  ObjectID after the key is stored as four varints relative to the base
+ *  of the page (see btm_OidBase): the zigzag differences of the page No.
+ *  and the volume No. from the base, the slot No. and the unique No. The
+ *  ObjectIDs of an index usually point to a few data pages near each
+ *  other, so most of them take 4 or 8 bytes instead of sizeof(ObjectID).
+ *
+ *  The varints are 7 bits per byte, the lowest group first; the high bit
+ *  is set in every byte but the last one.
+ *
+ * Exports:
+ *  Two edubtm_PackOid(BtreeLeaf*, ObjectID*, char*)
+ *  Two edubtm_UnpackOid(BtreeLeaf*, char*, ObjectID*)
+ *  void edubtm_GetOid(BtreeLeaf*, btm_LeafEntry*, ObjectID*)
+ *  void edubtm_PutOid(BtreeLeaf*, btm_LeafEntry*, ObjectID*)
+ *  void edubtm_CopyLeafFormat(BtreeLeaf*, BtreeLeaf*)
+ */
+
+
+#include <string.h>
+#include "EduBtM_common.h"
+#include "EduBtM_Internal.h"
+
+
+/*@ Internal Function Prototypes */
+Two edubtm_PutVarint(UFour, char*);
+Two edubtm_GetVarint(char*, UFour*);
+
+/* zigzag encoding of a difference; the small differences of both signs become small */
+#define EDUBTM_ZIGZAG(d)    ((UFour)(((UFour)(d) << 1) ^ (UFour)((Four)(d) >> 31)))
+#define EDUBTM_UNZIGZAG(u)  ((Four)(((u) >> 1) ^ (UFour)(-(Four)((u) & 1))))
+
+
+
+/*@================================
+ * edubtm_PackOid()
+ *================================*/
+/*
+ * Function: Two edubtm_PackOid(BtreeLeaf*, ObjectID*, char*)
+ *
+ * Description:
+ *  Pack the ObjectID relative to the base of the PACKED leaf into 'to',
+ *  padded with zeros to the alignment. A NULL 'to' only computes the
+ *  length. If the base of the page is not set yet, the ObjectID becomes
+ *  the base when it is stored.
+ *
+ * Returns:
+ *  aligned length of the packed ObjectID
+ */
+Two edubtm_PackOid(
+    BtreeLeaf           *apage,         /* INOUT a PACKED leaf */
+    ObjectID            *oid,           /* IN ObjectID to pack */
+    char                *to)            /* OUT packed ObjectID or NULL */
+{
+    btm_OidBase         base;           /* base of the page */
+    char                buf[4*BTM_MAXVARINTLEN];  /* the varints */
+    Two                 len;            /* length of the varints */
+    Two                 alignedLen;     /* aligned length */
+
+
+	// The first ObjectID stored in the page becomes the base.
+	if (BL_OIDBASE(apage)->pageNo == NIL)
+	{
+		base.pageNo = oid->pageNo;
+		base.volNo = oid->volNo;
+		if (to != NULL) *BL_OIDBASE(apage) = base;
+	}
+	else
+		base = *BL_OIDBASE(apage);
+
+	len = edubtm_PutVarint(EDUBTM_ZIGZAG(oid->pageNo - base.pageNo), buf);
+	len += edubtm_PutVarint(EDUBTM_ZIGZAG(oid->volNo - base.volNo), buf + len);
+	len += edubtm_PutVarint((UTwo)oid->slotNo, buf + len);
+	len += edubtm_PutVarint(oid->unique, buf + len);
+
+	alignedLen = ALIGNED_LENGTH(len);
+	if (to != NULL)
+	{
+		memcpy(to, buf, len);
+		memset(to + len, 0, alignedLen - len);
+	}
+
+	return(alignedLen);
+
+} /* edubtm_PackOid() */
+
+
+
+/*@================================
+ * edubtm_UnpackOid()
+ *================================*/
+/*
+ * Function: Two edubtm_UnpackOid(BtreeLeaf*, char*, ObjectID*)
+ *
+ * Description:
+ *  Unpack the packed ObjectID at 'from' of the PACKED leaf. A NULL 'oid'
+ *  only computes the length.
+ *
+ * Returns:
+ *  aligned length of the packed ObjectID
+ */
+Two edubtm_UnpackOid(
+    BtreeLeaf           *apage,         /* IN a PACKED leaf */
+    char                *from,          /* IN packed ObjectID */
+    ObjectID            *oid)           /* OUT ObjectID or NULL */
+{
+    btm_OidBase         *base;          /* base of the page */
+    UFour               v[4];           /* the varints */
+    Two                 len;            /* length of the varints */
+    Two                 i;              /* index */
+
+
+	for (len = 0, i = 0; i < 4; i++)
+		len += edubtm_GetVarint(from + len, &v[i]);
+
+	if (oid != NULL)
+	{
+		base = BL_OIDBASE(apage);
+		oid->pageNo = base->pageNo + EDUBTM_UNZIGZAG(v[0]);
+		oid->volNo = base->volNo + EDUBTM_UNZIGZAG(v[1]);
+		oid->slotNo = (SlotNo)v[2];
+		oid->unique = v[3];
+	}
+
+	return(ALIGNED_LENGTH(len));
+
+} /* edubtm_UnpackOid() */
+
+
+
+/*@================================
+ * edubtm_GetOid()
+ *================================*/
+/*
+ * Function: void edubtm_GetOid(BtreeLeaf*, btm_LeafEntry*, ObjectID*)
+ *
+ * Description:
+ *  Get the ObjectID of the leaf entry, which is packed if the leaf is
+ *  PACKED.
+ *
+ * Returns:
+ *  None
+ */
+void edubtm_GetOid(
+    BtreeLeaf           *apage,         /* IN leaf page holding the entry */
+    btm_LeafEntry       *entry,         /* IN leaf entry */
+    ObjectID            *oid)           /* OUT ObjectID of the entry */
+{
+
+	if (apage->hdr.type & PACKED)
+		edubtm_UnpackOid(apage, BL_OID(entry), oid);
+	else
+		memcpy(oid, BL_OID(entry), sizeof(ObjectID));
+
+} /* edubtm_GetOid() */
+
+
+
+/*@================================
+ * edubtm_PutOid()
+ *================================*/
+/*
+ * Function: void edubtm_PutOid(BtreeLeaf*, btm_LeafEntry*, ObjectID*)
+ *
+ * Description:
+ *  Store the ObjectID after the key of the leaf entry, packed if the leaf
+ *  is PACKED. The key should be stored already.
+ *
+ * Returns:
+ *  None
+ */
+void edubtm_PutOid(
+    BtreeLeaf           *apage,         /* INOUT leaf page holding the entry */
+    btm_LeafEntry       *entry,         /* INOUT leaf entry */
+    ObjectID            *oid)           /* IN ObjectID of the entry */
+{
+
+	if (apage->hdr.type & PACKED)
+		edubtm_PackOid(apage, oid, BL_OID(entry));
+	else
+		memcpy(BL_OID(entry), oid, sizeof(ObjectID));
+
+} /* edubtm_PutOid() */
+
+
+
+/*@================================
+ * edubtm_CopyLeafFormat()
+ *================================*/
+/*
+ * Function: void edubtm_CopyLeafFormat(BtreeLeaf*, BtreeLeaf*)
+ *
+ * Description:
+ *  Give the empty leaf 'to' the entry format of the leaf 'from': the
+ *  length of the included columns and, for a PACKED leaf, the base of the
+ *  packed ObjectIDs. The entries moved between the two need not be
+ *  repacked.
+ *
+ * Returns:
+ *  None
+ */
+void edubtm_CopyLeafFormat(
+    BtreeLeaf           *to,            /* INOUT an empty leaf */
+    BtreeLeaf           *from)          /* IN a leaf of the same index */
+{
+
+	to->hdr.reserved = from->hdr.reserved;
+
+	if (from->hdr.type & PACKED)
+	{
+		to->hdr.type |= PACKED;
+		*BL_OIDBASE(to) = *BL_OIDBASE(from);
+		to->hdr.free = BL_DATASTART(to);
+		to->hdr.unused = 0;
+	}
+
+} /* edubtm_CopyLeafFormat() */
+
+
+
+/*@================================
+ * edubtm_PutVarint()
+ *================================*/
+/*
+ * Function: Two edubtm_PutVarint(UFour, char*)
+ *
+ * Description:
+ *  Write the varint of 'v' into 'to'.
+ *
+ * Returns:
+ *  # of bytes written
+ */
+Two edubtm_PutVarint(
+    UFour               v,              /* IN value */
+    char                *to)            /* OUT varint */
+{
+    Two                 n;              /* # of bytes */
+
+
+	for (n = 0; v >= 0x80; n++, v >>= 7)
+		to[n] = (char)(v | 0x80);
+	to[n++] = (char)v;
+
+	return(n);
+
+} /* edubtm_PutVarint() */
+
+
+
+/*@================================
+ * edubtm_GetVarint()
+ *================================*/
+/*
+ * Function: Two edubtm_GetVarint(char*, UFour*)
+ *
+ * Description:
+ *  Read the varint at 'from' into 'v'.
+ *
+ * Returns:
+ *  # of bytes read
+ */
+Two edubtm_GetVarint(
+    char                *from,          /* IN varint */
+    UFour               *v)             /* OUT value */
+{
+    Two                 n;              /* # of bytes */
+    Two                 shift;          /* position of the next 7 bits */
+
+
+	*v = 0;
+	for (n = 0, shift = 0; from[n] & 0x80; n++, shift += 7)
+		*v |= (UFour)(from[n] & 0x7f) << shift;
+	*v |= (UFour)(unsigned char)from[n++] << shift;
+
+	return(n);
+
+} /* edubtm_GetVarint() */
@@ -0,0 +1,521 @@
+/******************************************************************************/
+/*                                                                            */
+/*    ODYSSEUS/EduCOSMOS Educational-Purpose Object Storage System            */
+/*                                                                            */
+/*    Developed by Professor Kyu-Young Whang et al.                           */
+/*                                                                            */
+/*    Database and Multimedia Laboratory                                      */
+/*                                                                            */
+/*    Computer Science Department and                                         */
+/*    Advanced Information Technology Research Center (AITrc)                 */
+/*    Korea Advanced Institute of Science and Technology (KAIST)              */
+/*                                                                            */
+/*    e-mail: kywhang@cs.kaist.ac.kr                                          */
+/*    phone: +82-42-350-7722                                                  */
+/*    fax: +82-42-350-8380                                                    */
+/*                                                                            */
+/*    Copyright (c) 1995-2013 by Kyu-Young Whang                              */
+/*                                                                            */
+/*    All rights reserved. No part of this software may be reproduced,        */
+/*    stored in a retrieval system, or transmitted, in any form or by any     */
+/*    means, electronic, mechanical, photocopying, recording, or otherwise,   */
+/*    without prior written permission of the copyright owner.                */
+/*                                                                            */
+/******************************************************************************/
+/*
+ * Module: edubtm_Reorganize.c
+ *
+ * Description :
+ *  Steps of the incremental reorganization done by EduBtM_Reorganize().
+ *  The position of the reorganization is kept as the first key of the
+ *  leaf to visit next, not as a PageID, because the leaves may be merged
+ *  or split by the updates between the steps.
+ *
+ * Exports:
+ *  Four edubtm_ReorgStart(PageID*, BtreeReorgCursor*)
+ *  Four edubtm_ReorgNext(PageID*, KeyDesc*, KeyValue*, Boolean*)
+ *  Four edubtm_ReorgMerge(ObjectID*, PageID*, KeyDesc*, KeyValue*, Boolean*, Boolean*,
+ *                         Boolean*, InternalItem*, Pool*, DeallocListElem*)
+ *  Four edubtm_RelocateLeaf(ObjectID*, PageID*, KeyDesc*, BtreeReorgCursor*,
+ *                           Pool*, DeallocListElem*)
+ */
+
+
+#include <string.h>
+#include "EduBtM_common.h"
+#include "BfM.h"
+#include "EduBtM_Internal.h"
+
+
+/*@ Internal Function Prototypes */
+Four edubtm_ReorgFindLeaf(PageID*, KeyDesc*, KeyValue*, PageID*, PageID*, Two*);
+Four edubtm_ReorgFirstKey(PageID*, KeyValue*, Boolean*);
+
+
+
+/*@================================
+ * edubtm_ReorgStart()
+ *================================*/
+/*
+ * Function: Four edubtm_ReorgStart(PageID*, BtreeReorgCursor*)
+ *
+ * Description:
+ *  Set the cursor at the first key of the leftmost leaf for a new phase.
+ *  The phase becomes REORG_DONE if the index is empty.
+ *
+ * Returns:
+ *  error code
+ *    some errors caused by function calls
+ */
+Four edubtm_ReorgStart(
+    PageID              *root,          /* IN root page */
+    BtreeReorgCursor    *cursor)        /* INOUT state of the reorganization */
+{
+    Four                e;              /* error number */
+    PageID              pid;            /* a page on the leftmost path */
+    BtreePage           *apage;         /* buffer of 'pid' */
+    ShortPageID         p0;             /* the first child */
+    Boolean             found;          /* TRUE if the index is not empty */
+
+
+	pid = *root;
+	for (;;)
+	{
+		e = edubtm_GetTrain(&pid, &apage, PAGE_BUF);
+		if (e < 0) ERR(e);
+
+		if (apage->any.hdr.type & LEAF)
+		{
+			e = BfM_FreeTrain(&pid, PAGE_BUF);
+			if (e < 0) ERR(e);
+			break;
+		}
+
+		p0 = apage->bi.hdr.p0;
+		e = BfM_FreeTrain(&pid, PAGE_BUF);
+		if (e < 0) ERR(e);
+		MAKE_PAGEID(pid, root->volNo, p0);
+	}
+
+	e = edubtm_ReorgFirstKey(&pid, &cursor->key, &found);
+	if (e < 0) ERR(e);
+
+	cursor->last.volNo = root->volNo;
+	cursor->last.pageNo = NIL;
+	if (found == FALSE) cursor->phase = REORG_DONE;
+
+	return(eNOERROR);
+
+} /* edubtm_ReorgStart() */
+
+
+
+/*@================================
+ * edubtm_ReorgNext()
+ *================================*/
+/*
+ * Function: Four edubtm_ReorgNext(PageID*, KeyDesc*, KeyValue*, Boolean*)
+ *
+ * Description:
+ *  Replace 'key' by the first key of the leaf next to the leaf containing
+ *  'key'.
+ *
+ * Returns:
+ *  error code
+ *    some errors caused by function calls
+ *
+ * Side effects:
+ *  found : FALSE if the leaf containing 'key' is the last leaf.
+ */
+Four edubtm_ReorgNext(
+    PageID              *root,          /* IN root page */
+    KeyDesc             *kdesc,         /* IN a key descriptor */
+    KeyValue            *key,           /* INOUT the first key of a leaf */
+    Boolean             *found)         /* OUT TRUE if the next leaf exists */
+{
+    Four                e;              /* error number */
+    PageID              leaf;           /* the leaf containing 'key' */
+    PageID              parent;         /* parent of 'leaf' */
+    Two                 slotNo;         /* slot No. of 'leaf' in 'parent' */
+    BtreeLeaf           *apage;         /* buffer of 'leaf' */
+    ShortPageID         next;           /* the next leaf */
+
+
+	e = edubtm_ReorgFindLeaf(root, kdesc, key, &leaf, &parent, &slotNo);
+	if (e < 0) ERR(e);
+
+	e = edubtm_GetTrain(&leaf, &apage, PAGE_BUF);
+	if (e < 0) ERR(e);
+	next = apage->hdr.nextPage;
+	e = BfM_FreeTrain(&leaf, PAGE_BUF);
+	if (e < 0) ERR(e);
+
+	*found = FALSE;
+	if (next == NIL) return(eNOERROR);
+
+	MAKE_PAGEID(leaf, root->volNo, next);
+	e = edubtm_ReorgFirstKey(&leaf, key, found);
+	if (e < 0) ERR(e);
+
+	return(eNOERROR);
+
+} /* edubtm_ReorgNext() */
+
+
+
+/*@================================
+ * edubtm_ReorgMerge()
+ *================================*/
+/*
+ * Function: Four edubtm_ReorgMerge(ObjectID*, PageID*, KeyDesc*, KeyValue*, Boolean*,
+ *                                  Boolean*, Boolean*, InternalItem*, Pool*, DeallocListElem*)
+ *
+ * Description:
+ *  Go down to the leaf containing 'kval' as edubtm_Delete() does, and on
+ *  the way back merge or redistribute every underfull page on the path by
+ *  edubtm_Underflow().
+ *
+ * Returns:
+ *  error code
+ *    some errors caused by function calls
+ *
+ * Side effects:
+ *  merged : TRUE if two pages are merged on the path.
+ *  f      : TRUE if the given page is not half full.
+ *  h      : TRUE if the given page is splitted.
+ *  item   : The internal item to be inserted into the parent if 'h' is TRUE.
+ */
+Four edubtm_ReorgMerge(
+    ObjectID            *catObjForFile, /* IN catalog object of B+ tree file */
+    PageID              *root,          /* IN root of the subtree */
+    KeyDesc             *kdesc,         /* IN a key descriptor */
+    KeyValue            *kval,          /* IN the first key of the leaf */
+    Boolean             *merged,        /* INOUT TRUE if pages are merged */
+    Boolean             *f,             /* OUT whether the page is not half full */
+    Boolean             *h,             /* OUT TRUE if the page is splitted */
+    InternalItem        *item,          /* OUT the internal item to be returned */
+    Pool                *dlPool,        /* INOUT pool of dealloc list elements */
+    DeallocListElem     *dlHead)        /* INOUT head of the dealloc list */
+{
+    Four                e;              /* error number */
+    Boolean             lf;             /* TRUE if the child is not half full */
+    Boolean             lh;             /* TRUE if the child is splitted */
+    Two                 idx;            /* the index by the binary search */
+    Two                 nSlots;         /* # of slots before edubtm_Underflow() */
+    PageID              child;          /* the child page */
+    BtreePage           *apage;         /* buffer of the page */
+    btm_InternalEntry   *iEntry;        /* an internal entry */
+    InternalItem        litem;          /* local internal item */
+
+
+	*f = *h = FALSE;
+
+	e = edubtm_GetTrain(root, &apage, PAGE_BUF);
+	if (e < 0) ERR(e);
+
+	if (apage->any.hdr.type & LEAF)
+	{
+		if ((Four)BL_FREE(&apage->bl) > BL_HALF)
+			*f = TRUE;
+
+		e = BfM_FreeTrain(root, PAGE_BUF);
+		if (e < 0) ERR(e);
+
+		return(eNOERROR);
+	}
+
+	edubtm_BinarySearchInternal(&apage->bi, kdesc, kval, &idx);
+	if (idx >= 0)
+	{
+		iEntry = (btm_InternalEntry*)&(apage->bi.data[apage->bi.slot[-1*idx]]);
+		MAKE_PAGEID(child, root->volNo, iEntry->spid);
+	}
+	else
+		MAKE_PAGEID(child, root->volNo, apage->bi.hdr.p0);
+
+	e = edubtm_ReorgMerge(catObjForFile, &child, kdesc, kval, merged, &lf, &lh, &litem, dlPool, dlHead);
+	if (e < 0) ERRB1(e, root, PAGE_BUF);
+
+	if (lh == TRUE)
+	{
+		edubtm_BinarySearchInternal(&apage->bi, kdesc, (KeyValue*)&litem.klen, &idx);
+		e = edubtm_InsertInternal(catObjForFile, &apage->bi, &litem, idx, h, item);
+		if (e < 0) ERRB1(e, root, PAGE_BUF);
+
+		e = BfM_SetDirty(root, PAGE_BUF);
+		if (e < 0) ERRB1(e, root, PAGE_BUF);
+	}
+	else if (lf == TRUE && apage->bi.hdr.nSlots > 0)
+	{
+		nSlots = apage->bi.hdr.nSlots;
+		e = edubtm_Underflow(catObjForFile, &apage->bi, &child, idx, &lf, h, item, dlPool, dlHead);
+		if (e < 0) ERRB1(e, root, PAGE_BUF);
+
+		if (*h == FALSE && apage->bi.hdr.nSlots < nSlots)
+			*merged = TRUE;
+
+		e = BfM_SetDirty(root, PAGE_BUF);
+		if (e < 0) ERRB1(e, root, PAGE_BUF);
+	}
+
+	if (*h == FALSE && (Four)BI_FREE(&apage->bi) > BI_HALF)
+		*f = TRUE;
+
+	e = BfM_FreeTrain(root, PAGE_BUF);
+	if (e < 0) ERR(e);
+
+	return(eNOERROR);
+
+} /* edubtm_ReorgMerge() */
+
+
+
+/*@================================
+ * edubtm_RelocateLeaf()
+ *================================*/
+/*
+ * Function: Four edubtm_RelocateLeaf(ObjectID*, PageID*, KeyDesc*, BtreeReorgCursor*,
+ *                                    Pool*, DeallocListElem*)
+ *
+ * Description:
+ *  Copy the leaf containing 'cursor->key' to a new page allocated next to
+ *  'cursor->last', and free the old page. The links of the neighbor leaves
+ *  and the pointer of the parent are redirected to the new page. The leaf
+ *  is left in place if it already follows 'cursor->last'.
+ *
+ * Returns:
+ *  error code
+ *    some errors caused by function calls
+ *
+ * Side effects:
+ *  cursor->last : the leaf containing 'cursor->key'
+ */
+Four edubtm_RelocateLeaf(
+    ObjectID            *catObjForFile, /* IN catalog object of B+ tree file */
+    PageID              *root,          /* IN root page */
+    KeyDesc             *kdesc,         /* IN a key descriptor */
+    BtreeReorgCursor    *cursor,        /* INOUT state of the reorganization */
+    Pool                *dlPool,        /* INOUT pool of dealloc list elements */
+    DeallocListElem     *dlHead)        /* INOUT head of the dealloc list */
+{
+    Four                e;              /* error number */
+    PageID              leaf;           /* the leaf to relocate */
+    PageID              parent;         /* parent of 'leaf' */
+    PageID              newPid;         /* the new page of the leaf */
+    PageID              pid;            /* a neighbor leaf */
+    Two                 slotNo;         /* slot No. of 'leaf' in 'parent' */
+    BtreeLeaf           *lpage;         /* buffer of 'leaf' */
+    BtreeLeaf           *npage;         /* buffer of 'newPid' */
+    BtreeLeaf           *mpage;         /* buffer of a neighbor leaf */
+    BtreeInternal       *ppage;         /* buffer of 'parent' */
+    btm_InternalEntry   *iEntry;        /* entry of 'parent' pointing to 'leaf' */
+
+
+	e = edubtm_ReorgFindLeaf(root, kdesc, &cursor->key, &leaf, &parent, &slotNo);
+	if (e < 0) ERR(e);
+
+	// The root never moves.
+	if (parent.pageNo == NIL) return(eNOERROR);
+
+	if (cursor->last.pageNo != NIL && leaf.pageNo == cursor->last.pageNo + 1)
+	{
+		cursor->last = leaf;
+		return(eNOERROR);
+	}
+
+	e = btm_AllocPage(catObjForFile, (cursor->last.pageNo != NIL) ? &cursor->last : &leaf, &newPid);
+	if (e < 0) ERR(e);
+
+	e = edubtm_GetTrain(&leaf, &lpage, PAGE_BUF);
+	if (e < 0) ERR(e);
+
+	e = BfM_GetNewTrain(&newPid, &npage, PAGE_BUF);
+	if (e < 0) ERRB1(e, &leaf, PAGE_BUF);
+
+	memcpy(npage, lpage, PAGESIZE);
+	npage->hdr.pid = newPid;
+
+	e = BfM_SetDirty(&newPid, PAGE_BUF);
+	if (e < 0) ERRB2(e, &leaf, PAGE_BUF, &newPid, PAGE_BUF);
+
+	// Redirect the neighbor leaves.
+	if (npage->hdr.prevPage != NIL)
+	{
+		MAKE_PAGEID(pid, leaf.volNo, npage->hdr.prevPage);
+		e = edubtm_GetTrain(&pid, &mpage, PAGE_BUF);
+		if (e < 0) ERRB2(e, &leaf, PAGE_BUF, &newPid, PAGE_BUF);
+		mpage->hdr.nextPage = newPid.pageNo;
+		e = BfM_SetDirty(&pid, PAGE_BUF);
+		if (e < 0) ERRB2(e, &leaf, PAGE_BUF, &newPid, PAGE_BUF);
+		e = BfM_FreeTrain(&pid, PAGE_BUF);
+		if (e < 0) ERRB2(e, &leaf, PAGE_BUF, &newPid, PAGE_BUF);
+	}
+	if (npage->hdr.nextPage != NIL)
+	{
+		MAKE_PAGEID(pid, leaf.volNo, npage->hdr.nextPage);
+		e = edubtm_GetTrain(&pid, &mpage, PAGE_BUF);
+		if (e < 0) ERRB2(e, &leaf, PAGE_BUF, &newPid, PAGE_BUF);
+		mpage->hdr.prevPage = newPid.pageNo;
+		e = BfM_SetDirty(&pid, PAGE_BUF);
+		if (e < 0) ERRB2(e, &leaf, PAGE_BUF, &newPid, PAGE_BUF);
+		e = BfM_FreeTrain(&pid, PAGE_BUF);
+		if (e < 0) ERRB2(e, &leaf, PAGE_BUF, &newPid, PAGE_BUF);
+	}
+
+	e = BfM_FreeTrain(&newPid, PAGE_BUF);
+	if (e < 0) ERRB1(e, &leaf, PAGE_BUF);
+
+	e = BfM_FreeTrain(&leaf, PAGE_BUF);
+	if (e < 0) ERR(e);
+
+	// Redirect the parent.
+	edubtm_TopCacheInvalidate(&parent);
+
+	e = edubtm_GetTrain(&parent, &ppage, PAGE_BUF);
+	if (e < 0) ERR(e);
+
+	if (slotNo >= 0)
+	{
+		iEntry = (btm_InternalEntry*)&(ppage->data[ppage->slot[-1*slotNo]]);
+		iEntry->spid = newPid.pageNo;
+	}
+	else
+		ppage->hdr.p0 = newPid.pageNo;
+
+	e = BfM_SetDirty(&parent, PAGE_BUF);
+	if (e < 0) ERRB1(e, &parent, PAGE_BUF);
+
+	e = BfM_FreeTrain(&parent, PAGE_BUF);
+	if (e < 0) ERR(e);
+
+	e = edubtm_FreePage(&leaf, dlPool, dlHead);
+	if (e < 0) ERR(e);
+
+	cursor->last = newPid;
+
+	return(eNOERROR);
+
+} /* edubtm_RelocateLeaf() */
+
+
+
+/*@================================
+ * edubtm_ReorgFindLeaf()
+ *================================*/
+/*
+ * Function: Four edubtm_ReorgFindLeaf(PageID*, KeyDesc*, KeyValue*, PageID*, PageID*, Two*)
+ *
+ * Description:
+ *  Find the leaf containing 'kval' with its parent and its slot No. in the
+ *  parent (-1 for 'p0'). 'parent->pageNo' is NIL if the root is a leaf.
+ *
+ * Returns:
+ *  error code
+ *    some errors caused by function calls
+ */
+Four edubtm_ReorgFindLeaf(
+    PageID              *root,          /* IN root page */
+    KeyDesc             *kdesc,         /* IN a key descriptor */
+    KeyValue            *kval,          /* IN key value */
+    PageID              *leaf,          /* OUT the leaf containing 'kval' */
+    PageID              *parent,        /* OUT parent of 'leaf' */
+    Two                 *slotNo)        /* OUT slot No. of 'leaf' in 'parent' */
+{
+    Four                e;              /* error number */
+    PageID              pid;            /* a page on the path */
+    BtreePage           *apage;         /* buffer of 'pid' */
+    btm_InternalEntry   *iEntry;        /* an internal entry */
+    Two                 idx;            /* the index by the binary search */
+
+
+	pid = *root;
+	MAKE_PAGEID(*parent, root->volNo, NIL);
+	*slotNo = NIL;
+
+	for (;;)
+	{
+		e = edubtm_GetTrain(&pid, &apage, PAGE_BUF);
+		if (e < 0) ERR(e);
+
+		if (apage->any.hdr.type & LEAF)
+		{
+			e = BfM_FreeTrain(&pid, PAGE_BUF);
+			if (e < 0) ERR(e);
+			break;
+		}
+
+		*parent = pid;
+		edubtm_BinarySearchInternal(&apage->bi, kdesc, kval, &idx);
+		*slotNo = idx;
+		if (idx >= 0)
+		{
+			iEntry = (btm_InternalEntry*)&(apage->bi.data[apage->bi.slot[-1*idx]]);
+			MAKE_PAGEID(pid, root->volNo, iEntry->spid);
+		}
+		else
+			MAKE_PAGEID(pid, root->volNo, apage->bi.hdr.p0);
+
+		e = BfM_FreeTrain(parent, PAGE_BUF);
+		if (e < 0) ERR(e);
+	}
+
+	*leaf = pid;
+
+	return(eNOERROR);
+
+} /* edubtm_ReorgFindLeaf() */
+
+
+
+/*@================================
+ * edubtm_ReorgFirstKey()
+ *================================*/
+/*
+ * Function: Four edubtm_ReorgFirstKey(PageID*, KeyValue*, Boolean*)
+ *
+ * Description:
+ *  Get the first key of the first non-empty leaf from the given leaf.
+ *
+ * Returns:
+ *  error code
+ *    some errors caused by function calls
+ *
+ * Side effects:
+ *  found : FALSE if all the leaves from the given leaf are empty.
+ */
+Four edubtm_ReorgFirstKey(
+    PageID              *leaf,          /* IN the leaf to start */
+    KeyValue            *key,           /* OUT the first key */
+    Boolean             *found)         /* OUT TRUE if a key is found */
+{
+    Four                e;              /* error number */
+    PageID              pid;            /* a leaf */
+    BtreeLeaf           *apage;         /* buffer of 'pid' */
+    btm_LeafEntry       *lEntry;        /* the first entry */
+    ShortPageID         next;           /* the next leaf */
+
+
+	*found = FALSE;
+
+	for (pid = *leaf; pid.pageNo != NIL; pid.pageNo = next)
+	{
+		e = edubtm_GetTrain(&pid, &apage, PAGE_BUF);
+		if (e < 0) ERR(e);
+
+		if (apage->hdr.nSlots > 0)
+		{
+			lEntry = (btm_LeafEntry*)&(apage->data[apage->slot[0]]);
+			memcpy(key, &lEntry->klen, sizeof(Two) + lEntry->klen);
+			*found = TRUE;
+		}
+		next = apage->hdr.nextPage;
+
+		e = BfM_FreeTrain(&pid, PAGE_BUF);
+		if (e < 0) ERR(e);
+
+		if (*found == TRUE) break;
+	}
+
+	return(eNOERROR);
+
+} /* edubtm_ReorgFirstKey() */
@@ -0,0 +1,248 @@
+/******************************************************************************/
+/*                                                                            */
+/*    ODYSSEUS/EduCOSMOS Educational-Purpose Object Storage System            */
+/*                                                                            */
+/*    Developed by Professor Kyu-Young Whang et al.                           */
+/*                                                                            */
+/*    Database and Multimedia Laboratory                                      */
+/*                                                                            */
+/*    Computer Science Department and                                         */
+/*    Advanced Information Technology Research Center (AITrc)                 */
+/*    Korea Advanced Institute of Science and Technology (KAIST)              */
+/*                                                                            */
+/*    e-mail: kywhang@cs.kaist.ac.kr                                          */
+/*    phone: +82-42-350-7722                                                  */
+/*    fax: +82-42-350-8380                                                    */
+/*                                                                            */
+/*    Copyright (c) 1995-2013 by Kyu-Young Whang                              */
+/*                                                                            */
+/*    All rights reserved. No part of this software may be reproduced,        */
+/*    stored in a retrieval system, or transmitted, in any form or by any     */
+/*    means, electronic, mechanical, photocopying, recording, or otherwise,   */
+/*    without prior written permission of the copyright owner.                */
+/*                                                                            */
+/******************************************************************************/
+/*
+ * Module: edubtm_SeekPrefix.c
+ *
+ * Description:
+ *  Position a cursor by the first k parts of a multi-part key. The keys of
+ *  the B+ tree are ordered part by part, so the entries whose first k parts
+ *  compare in a given way with a key value form a run of consecutive
+ *  entries; the search finds the boundary of the run with the comparisons
+ *  restricted to the first k parts.
+ *
+ * Exports:
+ *  Two edubtm_KeyPartsLength(KeyDesc*, KeyValue*, Two)
+ *  Two edubtm_PrefixBound(char*, Two*, Two, Two, KeyDesc*, KeyValue*, Boolean)
+ *  Four edubtm_SeekPrefix(PageID*, KeyDesc*, KeyValue*, Four, BtreeCursor*)
+ */
+
+
+#include <stddef.h>
+#include <string.h>
+#include "EduBtM_common.h"
+#include "BfM.h"
+#include "EduBtM_Internal.h"
+
+
+
+/*@================================
+ * edubtm_KeyPartsLength()
+ *================================*/
+/*
+ * Function: Two edubtm_KeyPartsLength(KeyDesc*, KeyValue*, Two)
+ *
+ * Description:
+ *  Return the # of bytes taken by the first 'nparts' parts of the key value.
+ *
+ * Returns:
+ *  length of the parts
+ */
+Two edubtm_KeyPartsLength(
+    KeyDesc             *kdesc,         /* IN key descriptor */
+    KeyValue            *kval,          /* IN key value */
+    Two                 nparts)         /* IN # of the key parts */
+{
+    Two                 i;              /* index for # of key parts */
+    Two                 j;              /* position in the key value */
+    Two                 len;            /* string length */
+
+
+	for (i = 0, j = 0; i < nparts; i++)
+	{
+		if (kdesc->kpart[i].type == SM_VARSTRING)
+		{
+			memcpy(&len, &kval->val[j], sizeof(Two));
+			j += sizeof(Two) + len;
+		}
+		else
+			j += kdesc->kpart[i].length;
+	}
+
+	return(j);
+
+} /* edubtm_KeyPartsLength() */
+
+
+
+/*@================================
+ * edubtm_PrefixBound()
+ *================================*/
+/*
+ * Function: Two edubtm_PrefixBound(char*, Two*, Two, Two, KeyDesc*, KeyValue*, Boolean)
+ *
+ * Description:
+ *  Binary search of a page by the key parts of 'pdesc'. Return the # of the
+ *  entries whose key is less than 'kval', or less than or equal to it if
+ *  'upper' is TRUE. The key of an entry is at 'klenOffset' in the entry.
+ *
+ * Returns:
+ *  # of the entries before the boundary
+ */
+Two edubtm_PrefixBound(
+    char                *data,          /* IN data area of the page */
+    Two                 *slot,          /* IN slot array of the page */
+    Two                 nSlots,         /* IN # of the entries */
+    Two                 klenOffset,     /* IN offset of the key in an entry */
+    KeyDesc             *pdesc,         /* IN key descriptor of the compared parts */
+    KeyValue            *kval,          /* IN key value */
+    Boolean             upper)          /* IN TRUE if the equal keys come before the boundary */
+{
+    Two                 low;            /* low index */
+    Two                 mid;            /* mid index */
+    Two                 high;           /* high index */
+    Four                cmp;            /* result of comparison */
+
+
+	low = 0;
+	high = nSlots;
+
+	while (low < high)
+	{
+		mid = (low + high)/2;
+
+		cmp = edubtm_KeyCompare(pdesc, (KeyValue*)(data + slot[-1*mid] + klenOffset), kval);
+		edubtm_nProbes++;
+		if (cmp == LESS || (upper && cmp == EQUAL)) low = mid+1;
+		else                                         high = mid;
+	}
+
+	return(low);
+
+} /* edubtm_PrefixBound() */
+
+
+
+/*@================================
+ * edubtm_SeekPrefix()
+ *================================*/
+/*
+ * Function: Four edubtm_SeekPrefix(PageID*, KeyDesc*, KeyValue*, Four, BtreeCursor*)
+ *
+ * Description:
+ *  Find the first entry whose key parts of 'pdesc' are greater than or
+ *  equal to (SM_GE) or greater than (SM_GT) 'kval', or the last entry
+ *  whose parts are less than or equal to (SM_LE) or less than (SM_LT) it.
+ *  'pdesc' is the key descriptor of the index cut to the compared parts.
+ *  The entry is in the leaf reached by the search or next to it.
+ *
+ * Returns:
+ *  Error code
+ *    some errors caused by function calls
+ *
+ * Side effects:
+ *  cursor : the entry found or CURSOR_EOS
+ */
+Four edubtm_SeekPrefix(
+    PageID              *root,          /* IN The current root of the subtree */
+    KeyDesc             *pdesc,         /* IN key descriptor of the compared parts */
+    KeyValue            *kval,          /* IN key value */
+    Four                compOp,         /* IN SM_GE, SM_GT, SM_LE or SM_LT */
+    BtreeCursor         *cursor)        /* OUT Btree Cursor */
+{
+    Four                e;              /* error number */
+    Two                 idx;            /* index of the entry */
+    Boolean             upper;          /* TRUE if the equal keys are skipped forward */
+    PageID              child;          /* child page */
+    PageID              leafPid;        /* leaf page of the entry */
+    BtreePage           *apage;         /* a page pointer */
+    btm_InternalEntry   *iEntry;        /* an internal entry */
+    btm_LeafEntry       *lEntry;        /* a leaf entry */
+
+
+	upper = (compOp == SM_GT || compOp == SM_LE);
+
+	e = edubtm_GetTrain(root, &apage, PAGE_BUF);
+	if (e < 0) ERR(e);
+
+	if (apage->any.hdr.type & INTERNAL)
+	{
+		/* The child of the last separator before the boundary holds it. */
+		idx = edubtm_PrefixBound(apage->bi.data, apage->bi.slot, apage->bi.hdr.nSlots,
+					 offsetof(btm_InternalEntry, klen), pdesc, kval, upper) - 1;
+		if (idx >= 0)
+		{
+			iEntry = (btm_InternalEntry*)(apage->bi.data + apage->bi.slot[-1*idx]);
+			MAKE_PAGEID(child, root->volNo, iEntry->spid);
+		}
+		else
+			MAKE_PAGEID(child, root->volNo, apage->bi.hdr.p0);
+
+		e = edubtm_SeekPrefix(&child, pdesc, kval, compOp, cursor);
+		if (e < 0) ERRB1(e, root, PAGE_BUF);
+
+		e = BfM_FreeTrain(root, PAGE_BUF);
+		if (e < 0) ERR(e);
+
+		return(eNOERROR);
+	}
+
+	idx = edubtm_PrefixBound(apage->bl.data, apage->bl.slot, apage->bl.hdr.nSlots,
+				 offsetof(btm_LeafEntry, klen), pdesc, kval, upper);
+	if (compOp == SM_LE || compOp == SM_LT) idx--;
+
+	cursor->flag = CURSOR_ON;
+	leafPid = *root;
+	if (idx >= apage->bl.hdr.nSlots)
+	{
+		if (apage->bl.hdr.nextPage != NIL)
+		{
+			MAKE_PAGEID(leafPid, root->volNo, apage->bl.hdr.nextPage);
+			idx = 0;
+		}
+		else
+			cursor->flag = CURSOR_EOS;
+	}
+	else if (idx < 0)
+	{
+		if (apage->bl.hdr.prevPage != NIL)
+			MAKE_PAGEID(leafPid, root->volNo, apage->bl.hdr.prevPage);
+		else
+			cursor->flag = CURSOR_EOS;
+	}
+
+	e = BfM_FreeTrain(root, PAGE_BUF);
+	if (e < 0) ERR(e);
+
+	if (cursor->flag == CURSOR_EOS) return(eNOERROR);
+
+	e = edubtm_GetTrain(&leafPid, &apage, PAGE_BUF);
+	if (e < 0) ERR(e);
+
+	if (idx < 0) idx = apage->bl.hdr.nSlots-1;
+
+	lEntry = (btm_LeafEntry*)(apage->bl.data + apage->bl.slot[-1*idx]);
+	edubtm_GetOid(&apage->bl, lEntry, &cursor->oid);
+	cursor->includedLen = apage->bl.hdr.reserved;
+	memcpy(cursor->included, BL_INCLUDED(&apage->bl, lEntry), cursor->includedLen);
+	BTM_COPY_KEY(&cursor->key, &lEntry->klen);
+	cursor->leaf = leafPid;
+	cursor->slotNo = idx;
+
+	e = BfM_FreeTrain(&leafPid, PAGE_BUF);
+	if (e < 0) ERR(e);
+
+    return(eNOERROR);
+
+} /* edubtm_SeekPrefix() */
@@ -0,0 +1,268 @@
+/******************************************************************************/
+/*                                                                            */
+/*    ODYSSEUS/EduCOSMOS Educational-Purpose Object Storage System            */
+/*                                                                            */
+/*    Developed by Professor Kyu-Young Whang et al.                           */
+/*                                                                            */
+/*    Database and Multimedia Laboratory                                      */
+/*                                                                            */
+/*    Computer Science Department and                                         */
+/*    Advanced Information Technology Research Center (AITrc)                 */
+/*    Korea Advanced Institute of Science and Technology (KAIST)              */
+/*                                                                            */
+/*    e-mail: kywhang@cs.kaist.ac.kr                                          */
+/*    phone: +82-42-350-7722                                                  */
+/*    fax: +82-42-350-8380                                                    */
+/*                                                                            */
+/*    Copyright (c) 1995-2013 by Kyu-Young Whang                              */
+/*                                                                            */
+/*    All rights reserved. No part of this software may be reproduced,        */
+/*    stored in a retrieval system, or transmitted, in any form or by any     */
+/*    means, electronic, mechanical, photocopying, recording, or otherwise,   */
+/*    without prior written permission of the copyright owner.                */
+/*                                                                            */
+/******************************************************************************/
+/*
+ * Module: edubtm_Snapshot.c
+ *
+ * Description :
+ *  Navigation of a B+ tree snapshot. The entries are kept in the Eytzinger
+ *  order: the entry k has the children 2k and 2k+1, and the in-order walk
+ *  of this implicit tree visits the keys in ascending order. A search
+ *  touches the entries 1, 2 or 3, 4 to 7, ... so the first levels share a
+ *  few pages which stay in the memory, and no pointer is stored.
+ *
+ * Exports:
+ *  Four edubtm_SnapshotFirst(Four)
+ *  Four edubtm_SnapshotLast(Four)
+ *  Four edubtm_SnapshotNext(Four, Four)
+ *  Four edubtm_SnapshotPrev(Four, Four)
+ *  Four edubtm_SnapshotSearch(BtreeSnapshot*, KeyValue*, Boolean)
+ *  void edubtm_SnapshotSetCursor(BtreeSnapshot*, Four, KeyValue*, Four, BtreeSnapshotCursor*)
+ */
+
+
+#include <string.h>
+#include "EduBtM_common.h"
+#include "EduBtM_Internal.h"
+
+
+
+/*@================================
+ * edubtm_SnapshotFirst()
+ *================================*/
+/*
+ * Function: Four edubtm_SnapshotFirst(Four)
+ *
+ * Description:
+ *  Return the entry No. of the smallest key, i.e., the leftmost entry.
+ *
+ * Returns:
+ *  entry No. or 0 if there is no entry
+ */
+Four edubtm_SnapshotFirst(
+    Four                n)              /* IN # of entries */
+{
+    Four                k;              /* entry No. */
+
+
+	if (n == 0) return(0);
+
+	for (k = 1; 2*k <= n; k = 2*k);
+
+	return(k);
+
+} /* edubtm_SnapshotFirst() */
+
+
+
+/*@================================
+ * edubtm_SnapshotLast()
+ *================================*/
+/*
+ * Function: Four edubtm_SnapshotLast(Four)
+ *
+ * Description:
+ *  Return the entry No. of the largest key, i.e., the rightmost entry.
+ *
+ * Returns:
+ *  entry No. or 0 if there is no entry
+ */
+Four edubtm_SnapshotLast(
+    Four                n)              /* IN # of entries */
+{
+    Four                k;              /* entry No. */
+
+
+	if (n == 0) return(0);
+
+	for (k = 1; 2*k+1 <= n; k = 2*k+1);
+
+	return(k);
+
+} /* edubtm_SnapshotLast() */
+
+
+
+/*@================================
+ * edubtm_SnapshotNext()
+ *================================*/
+/*
+ * Function: Four edubtm_SnapshotNext(Four, Four)
+ *
+ * Description:
+ *  Return the entry No. of the key next to the entry 'k'. It is the
+ *  leftmost entry of the right subtree if any; otherwise go up while 'k'
+ *  is a right child, and then once more.
+ *
+ * Returns:
+ *  entry No. or 0 if 'k' is the last one
+ */
+Four edubtm_SnapshotNext(
+    Four                n,              /* IN # of entries */
+    Four                k)              /* IN entry No. */
+{
+
+	if (2*k+1 <= n)
+	{
+		for (k = 2*k+1; 2*k <= n; k = 2*k);
+		return(k);
+	}
+
+	while (k & 1) k >>= 1;
+
+	return(k >> 1);
+
+} /* edubtm_SnapshotNext() */
+
+
+
+/*@================================
+ * edubtm_SnapshotPrev()
+ *================================*/
+/*
+ * Function: Four edubtm_SnapshotPrev(Four, Four)
+ *
+ * Description:
+ *  Return the entry No. of the key previous to the entry 'k'; the mirror
+ *  image of edubtm_SnapshotNext().
+ *
+ * Returns:
+ *  entry No. or 0 if 'k' is the first one
+ */
+Four edubtm_SnapshotPrev(
+    Four                n,              /* IN # of entries */
+    Four                k)              /* IN entry No. */
+{
+
+	if (2*k <= n)
+	{
+		for (k = 2*k; 2*k+1 <= n; k = 2*k+1);
+		return(k);
+	}
+
+	while (k > 1 && !(k & 1)) k >>= 1;
+
+	return(k >> 1);
+
+} /* edubtm_SnapshotPrev() */
+
+
+
+/*@================================
+ * edubtm_SnapshotSearch()
+ *================================*/
+/*
+ * Function: Four edubtm_SnapshotSearch(BtreeSnapshot*, KeyValue*, Boolean)
+ *
+ * Description:
+ *  Find the first entry whose key is greater than or equal to 'kval', or
+ *  greater than 'kval' if 'upper' is TRUE. The search goes down to the
+ *  bottom without a branch on the result; 'k' then records the path, and
+ *  the answer is the node where the path turned left last, which is found
+ *  by removing the trailing right turns and one more bit.
+ *
+ * Returns:
+ *  entry No. or 0 if there is no such entry
+ */
+Four edubtm_SnapshotSearch(
+    BtreeSnapshot       *snap,          /* IN the snapshot */
+    KeyValue            *kval,          /* IN key value to search */
+    Boolean             upper)          /* IN TRUE to skip the equal keys */
+{
+    Four                k;              /* entry No. */
+    Four                n;              /* # of entries */
+    Four                cmp;            /* result of comparison */
+
+
+	n = snap->hdr->nEntries;
+
+	for (k = 1; k <= n; )
+	{
+		cmp = edubtm_KeyCompare(&snap->hdr->kdesc, (KeyValue*)&BTM_SNAPSHOT_ENTRY(snap, k)->klen, kval);
+		k = 2*k + (cmp == LESS || (upper && cmp == EQUAL));
+	}
+
+	while (k & 1) k >>= 1;
+
+	return(k >> 1);
+
+} /* edubtm_SnapshotSearch() */
+
+
+
+/*@================================
+ * edubtm_SnapshotSetCursor()
+ *================================*/
+/*
+ * Function: void edubtm_SnapshotSetCursor(BtreeSnapshot*, Four, KeyValue*, Four, BtreeSnapshotCursor*)
+ *
+ * Description:
+ *  Make the cursor point to the entry 'k' if it satisfies the stop
+ *  condition; otherwise the cursor reaches the end of scan.
+ *
+ * Returns:
+ *  None
+ */
+void edubtm_SnapshotSetCursor(
+    BtreeSnapshot       *snap,          /* IN the snapshot */
+    Four                k,              /* IN entry No. or 0 */
+    KeyValue            *stopKval,      /* IN key value of stop condition */
+    Four                stopCompOp,     /* IN comparison operator of stop condition */
+    BtreeSnapshotCursor *cursor)        /* OUT the cursor */
+{
+    Four                cmp;            /* result of comparison */
+    btm_SnapshotEntry   *entry;         /* the entry 'k' */
+
+
+	if (k == 0)
+	{
+		cursor->flag = CURSOR_EOS;
+		return;
+	}
+
+	entry = BTM_SNAPSHOT_ENTRY(snap, k);
+
+	if (stopCompOp != SM_BOF && stopCompOp != SM_EOF)
+	{
+		cmp = edubtm_KeyCompare(&snap->hdr->kdesc, (KeyValue*)&entry->klen, stopKval);
+		if ((stopCompOp == SM_EQ && !(cmp == EQUAL)) ||
+				(stopCompOp == SM_LT && !(cmp == LESS)) ||
+				(stopCompOp == SM_LE && !(cmp == LESS || cmp == EQUAL)) ||
+				(stopCompOp == SM_GT && !(cmp == GREATER)) ||
+				(stopCompOp == SM_GE && !(cmp == GREATER || cmp == EQUAL)))
+		{
+			cursor->flag = CURSOR_EOS;
+			return;
+		}
+	}
+
+	cursor->flag = CURSOR_ON;
+	cursor->pos = k;
+	cursor->key.len = entry->klen;
+	memcpy(cursor->key.val, entry->kval, entry->klen);
+	memcpy(&cursor->oid, BTM_SNAPSHOT_OID(snap, entry), sizeof(ObjectID));
+	cursor->includedLen = snap->hdr->includedLen;
+	memcpy(cursor->included, (char*)BTM_SNAPSHOT_OID(snap, entry) + sizeof(ObjectID), cursor->includedLen);
+
+} /* edubtm_SnapshotSetCursor() */
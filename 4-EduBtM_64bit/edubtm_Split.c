@@ -43,6 +43,10 @@
 #include "EduBtM_Internal.h"
 
 
+/* # of the pages splitted; for the benchmarks */
+Four edubtm_nSplits = 0;
+
+
 
 /*@================================
  * edubtm_SplitInternal()
@@ -60,8 +64,12 @@
  *  the new internal item should be inserted into their parent and the item will
  *  be returned by 'ritem'.
  *
- *  A temporary page is used because it is difficult to use the given page
- *  directly and the temporary page will be copied to the given page later.
+ *  The split is done in place: the split point is found from the entry
+ *  lengths, and the entries after it are moved to the new page by
+ *  edubtm_MoveInternalEntries(). The given page is not copied.
+ *
+ *  The message buffer of a buffered internal page stays in 'fpage'; the new
+ *  page gets an empty buffer of the same size.
  *
  * Returns:
  *  error code
@@ -78,103 +86,83 @@ Four edubtm_SplitInternal(
     InternalItem                *ritem)                 /* OUT the item which will be returned by spliting */
 {
     Four                        e;                      /* error number */
-    Two                         i;                      /* slot No. in the given page, fpage */
-    Two                         j = 0;                  /* slot No. in the splitted pages */
-    Two                         k = 0;                  /* slot No. in the new page */
-    Two                         maxLoop;                /* # of max loops; # of slots in fpage + 1 */
+    Two                         i;                      /* position in the (nSlots+1) entries */
+    Two                         s;                      /* position of the entry going up to the parent */
+    Two                         n;                      /* # of slots in fpage */
     Four                        sum = 0;                /* the size of a filled area */
-    Boolean                     flag = FALSE;           /* TRUE if 'item' become a member of fpage -> nono~~ */
+    Four                        half;                   /* half of the entry area */
     PageID                      newPid;                 /* for a New Allocated Page */
     BtreeInternal               *npage;                 /* a page pointer for the new allocated page */
-	BtreeInternal				tpage = *fpage;
-    Two                         fEntryOffset = 0;       /* starting offset of an entry in fpage */
-    Two                         nEntryOffset = 0;       /* starting offset of an entry in npage */
-    Two                         entryLen;               /* length of an entry */
     btm_InternalEntry           *fEntry;                /* internal entry in the given page, fpage */
-    btm_InternalEntry           *nEntry;                /* internal entry in the new page, npage*/
-    Boolean                     isTmp;
 
 
 	// Allocate new page.
 	e = btm_AllocPage(catObjForFile, &fpage->hdr.pid, &newPid);
 	if (e < 0) ERR(e);
+	edubtm_nSplits++;
+	if (edubtm_tracing) edubtm_trace.nInternalSplits++;
 
 	// Initialize the page to internal page.
 	e = edubtm_InitInternal(&newPid, FALSE, FALSE);
 	if (e < 0) ERR(e);
 
-	e = BfM_GetTrain(&newPid, &npage, PAGE_BUF);
+	e = edubtm_GetTrain(&newPid, &npage, PAGE_BUF);
 	if (e < 0) ERR(e);
 
-	// Split and save entries in overflow page(fpage) and new page(npage).
-	maxLoop = fpage->hdr.nSlots + 1; 
-	for (i=0; i < maxLoop; i++)
+	// The new page has an empty message buffer of the same size.
+	// The caller moves the messages by edubtm_SplitMessages().
+	if (fpage->hdr.reserved > 0)
+	{
+		npage->hdr.reserved = fpage->hdr.reserved;
+		npage->hdr.free = npage->hdr.reserved;
+		BI_MSGHDR(npage)->used = 0;
+		BI_MSGHDR(npage)->nMsgs = 0;
+	}
+	half = (PAGESIZE - BI_FIXED - fpage->hdr.reserved) / 2;
+
+	// The given 'item' is the (high+1)-th entry of the (nSlots+1) entries.
+	// The entries before the half stay in fpage, the first entry of the
+	// second half goes up to the parent, and the rest go to npage.
+	n = fpage->hdr.nSlots;
+	for (i = 0; i <= n && sum < half; i++)
 	{
-		// if half of the fpage is not full, save entry in fpage. 
-		if (sum < BI_HALF)
-		{
-			if ((i+1) < high)
-			{
-				// copy i-th entry for j-th entry of fpage
-				fEntry = tpage.data + tpage.slot[-1*i];
-				entryLen = sizeof(ShortPageID) + sizeof(Two) + fEntry->klen;
-				memcpy(fpage->data + fEntryOffset, tpage.data + tpage.slot[-1*i], entryLen);
-			}
-			else if ((i+1) == high)
-			{
-				// copy item for j-th entry of fpage
-				entryLen = sizeof(ShortPageID) + sizeof(Two) + ALIGNED_LENGTH(item->klen);
-				memcpy(fpage->data + fEntryOffset, item, entryLen);
-			}
-			else
-			{
-				// copy (i-1)-th entry for j-th entry of fpage
-				fEntry = tpage.data + tpage.slot[-1*(i-1)];
-				entryLen = sizeof(ShortPageID) + sizeof(Two) + fEntry->klen;
-				memcpy(fpage->data + fEntryOffset, tpage.data + tpage.slot[-1*(i-1)], entryLen);
-			}
-			fpage->slot[-1*j] = fEntryOffset;
-			fEntryOffset += entryLen;
-			fpage->hdr.free = fEntryOffset;
-			j++;
-		}
-		// if half of the fpage is full, save entry in npage.
+		if (i == high+1)
+			fEntry = (btm_InternalEntry*)item;
 		else
-		{
-			if ((i+1) < high)
-			{
-				// copy i-th entry for k-th entry of npage.
-				nEntry = tpage.data + tpage.slot[-1*i];
-				entryLen = sizeof(ShortPageID) + sizeof(Two) + nEntry->klen;
-				memcpy(npage->data + nEntryOffset, tpage.data + tpage.slot[-1*i], entryLen);
-			}
-			else if ((i+1) == high)
-			{
-				// copy item for k-th entry of npage.
-				entryLen = sizeof(ShortPageID) + sizeof(Two) + item->klen;
-				memcpy(npage->data + nEntryOffset, item, entryLen);
-			}
-			else
-			{
-				// copy (i-1)-th entry for k-th entry of npage.
-				nEntry = tpage.data + tpage.slot[-1*(i-1)];
-				entryLen = sizeof(ShortPageID) + sizeof(Two) + nEntry->klen;
-				memcpy(npage->data + nEntryOffset, tpage.data + tpage.slot[-1*(i-1)], entryLen);
-			}
-			npage->slot[-1*k] = nEntryOffset;
-			nEntryOffset += entryLen;
-			npage->hdr.free = nEntryOffset;
-			k++;
-		}
-		sum += entryLen + sizeof(Two);
+			fEntry = (btm_InternalEntry*)&(fpage->data[fpage->slot[-1*(i <= high ? i : i-1)]]);
+		sum += BI_ENTRYLEN(fEntry) + sizeof(Two);
+	}
+	s = (i > n) ? n : i;
+
+	if (s == high+1)
+	{
+		// The given item goes up.
+		memcpy(ritem, item, BI_ENTRYLEN(item));
+		edubtm_MoveInternalEntries(fpage, s, n-s, npage, 0);
+	}
+	else if (s < high+1)
+	{
+		fEntry = (btm_InternalEntry*)&(fpage->data[fpage->slot[-1*s]]);
+		memcpy(ritem, fEntry, BI_ENTRYLEN(fEntry));
+		edubtm_MoveInternalEntries(fpage, s+1, n-s-1, npage, 0);
+		edubtm_RemoveInternalEntries(fpage, s, 1);
+		edubtm_InsertInternalEntry(npage, high-s, item);
+	}
+	else
+	{
+		fEntry = (btm_InternalEntry*)&(fpage->data[fpage->slot[-1*(s-1)]]);
+		memcpy(ritem, fEntry, BI_ENTRYLEN(fEntry));
+		edubtm_MoveInternalEntries(fpage, s, n-s, npage, 0);
+		edubtm_RemoveInternalEntries(fpage, s-1, 1);
+		edubtm_InsertInternalEntry(fpage, high+1, item);
 	}
-	nEntry = npage->data + npage->slot[0];
-	npage->hdr.p0 = nEntry->spid;
 
-	fpage->hdr.nSlots = j;
-	npage->hdr.nSlots = k;
+	// The child of the item going up becomes the first pointer of npage.
+	npage->hdr.p0 = ritem->spid;
+	ritem->spid = newPid.pageNo;
 
-	memcpy(ritem, nEntry, sizeof(InternalItem));
+	e = BfM_SetDirty(&newPid, PAGE_BUF);
+	if (e < 0) ERRB1(e, &newPid, PAGE_BUF);
 
 	e = BfM_FreeTrain(&newPid, PAGE_BUF);
 	if (e < 0) ERR(e);
@@ -202,6 +190,8 @@ Four edubtm_SplitInternal(
  *  Internal pages do not maintain the linked list, but leaves do it, so links
  *  are properly updated.
  *
+ *  As edubtm_SplitInternal(), the entries are moved in place.
+ *
  *  Error code
  *  eDUPLICATEDOBJECTID_BTM
  *    some errors caused by function calls
@@ -218,122 +208,79 @@ Four edubtm_SplitLeaf(
     InternalItem                *ritem)         /* OUT the item which will be returned by spliting */
 {
     Four                        e;              /* error number */
-    Two                         i;              /* slot No. in the given page, fpage */
-    Two                         j = 0;          /* slot No. in the splitted pages */
-    Two                         k = 0;          /* slot No. in the new page */
-    Two                         maxLoop;        /* # of max loops; # of slots in fpage + 1 */
+    Two                         i;              /* position in the (nSlots+1) entries */
+    Two                         s;              /* position of the first entry of the new page */
+    Two                         n;              /* # of slots in fpage */
     Four                        sum = 0;        /* the size of a filled area */
     PageID                      newPid;         /* for a New Allocated Page */
     PageID                      nextPid;        /* for maintaining doubly linked list */
-    BtreeLeaf                   tpage = *fpage; /* a temporary page for the given page */
     BtreeLeaf                   *npage;         /* a page pointer for the new page */
     BtreeLeaf                   *mpage;         /* for doubly linked list */
-    btm_LeafEntry               *itemEntry;     /* entry for the given 'item' */
-    btm_LeafEntry               *fEntry;        /* an entry in the given page, 'fpage' */
     btm_LeafEntry               *nEntry;        /* an entry in the new page, 'npage' */
-    ObjectID                    *iOidArray;     /* ObjectID array of 'itemEntry' */
-    ObjectID                    *fOidArray;     /* ObjectID array of 'fEntry' */
-    Two                         fEntryOffset = 0;/* starting offset of 'fEntry' */
-    Two                         nEntryOffset = 0;/* starting offset of 'nEntry' */
-    Two                         oidArrayNo;     /* element No in an ObjectID array */
-    Two                         alignedKlen;    /* aligned length of the key length */
-    Two                         itemEntryLen;   /* length of entry for item */
-    Two                         entryLen;       /* entry length */
-    Boolean                     flag;
-    Boolean                     isTmp;
  
     
 	// Allocate new page.
 	e = btm_AllocPage(catObjForFile, &fpage->hdr.pid, &newPid);
 	if (e < 0) ERR(e);
+	edubtm_nSplits++;
+	if (edubtm_tracing) edubtm_trace.nLeafSplits++;
 
 	// Initialize the page to leaf page.
 	e = edubtm_InitLeaf(&newPid, FALSE, FALSE);
 	if (e < 0) ERR(e);
 
-	e = BfM_GetTrain(&newPid, &npage, PAGE_BUF);
+	e = edubtm_GetTrain(&newPid, &npage, PAGE_BUF);
 	if (e < 0) ERR(e);
 
-	// Split and save entries in overflow page(fpage) and new page(npage).
-	maxLoop = fpage->hdr.nSlots + 1; 
-	for (i=0; i < maxLoop; i++)
+	// The new leaf carries the included columns of the same length and the base of the ObjectIDs.
+	edubtm_CopyLeafFormat(npage, fpage);
+
+	// The given 'item' is the (high+1)-th entry of the (nSlots+1) entries.
+	// The entries before the half stay in fpage and the rest go to npage.
+	n = fpage->hdr.nSlots;
+	for (i = 0; i <= n && sum < BL_HALF; i++)
 	{
-		// if half of the fpage is not full, save entry in fpage. 
-		if (sum < BL_HALF)
-		{
-			if ((i+1) < high)
-			{
-				// copy i-th entry for j-th entry of fpage
-				fEntry = tpage.data + tpage.slot[-1*i];
-				entryLen = 2*sizeof(Two) + ALIGNED_LENGTH(fEntry->klen) + sizeof(ObjectID);
-				memcpy(fpage->data + fEntryOffset, tpage.data + tpage.slot[-1*i], entryLen);
-			}
-			else if ((i+1) == high)
-			{
-				// copy item for j-th entry of fpage
-				fEntry = &item->nObjects;
-				entryLen = 2*sizeof(Two) + ALIGNED_LENGTH(item->klen);
-				memcpy(fpage->data + fEntryOffset, fEntry, entryLen);
-				memcpy(fpage->data + fEntryOffset + entryLen, &item->oid, sizeof(ObjectID));
-				entryLen += sizeof(ObjectID);
-			}
-			else
-			{
-				// copy (i-1)-th entry for j-th entry of fpage
-				fEntry = tpage.data + tpage.slot[-1*(i-1)];
-				entryLen = 2*sizeof(Two) + ALIGNED_LENGTH(fEntry->klen) + sizeof(ObjectID);
-				memcpy(fpage->data + fEntryOffset, tpage.data + tpage.slot[-1*(i-1)], entryLen);
-			}
-			fpage->slot[-1*j] = fEntryOffset;
-			fEntryOffset += entryLen;
-			fpage->hdr.free = fEntryOffset;
-			j++;
-		}
-		// if half of the fpage is full, save entry in npage.
+		if (i == high+1)
+			sum += BL_ITEMLEN(fpage, item) + sizeof(Two);
 		else
-		{
-			if ((i+1) < high)
-			{
-				// copy i-th entry for k-th entry of npage.
-				nEntry = tpage.data + tpage.slot[-1*i];
-				entryLen = 2*sizeof(Two) + ALIGNED_LENGTH(nEntry->klen) + sizeof(ObjectID);
-				memcpy(npage->data + nEntryOffset, tpage.data + tpage.slot[-1*i], entryLen);
-			}
-			else if ((i+1) == high)
-			{
-				// copy item for k-th entry of npage.
-				fEntry = &item->nObjects;
-				entryLen = 2*sizeof(Two) + ALIGNED_LENGTH(item->klen);
-				memcpy(npage->data + nEntryOffset, fEntry, entryLen);
-				memcpy(npage->data + nEntryOffset + entryLen, &item->oid, sizeof(ObjectID));
-				entryLen += sizeof(ObjectID);
-			}
-			else
-			{
-				// copy (i-1)-th entry for k-th entry of npage.
-				nEntry = tpage.data + tpage.slot[-1*(i-1)];
-				entryLen = 2*sizeof(Two) + ALIGNED_LENGTH(nEntry->klen) + sizeof(ObjectID);
-				memcpy(npage->data + nEntryOffset, tpage.data + tpage.slot[-1*(i-1)], entryLen);
-			}
-			npage->slot[-1*k] = nEntryOffset;
-			nEntryOffset += entryLen;
-			npage->hdr.free = nEntryOffset;
-			k++;
-		}
-		sum += entryLen + sizeof(Two);
+			sum += BL_ENTRYLEN(fpage, (btm_LeafEntry*)&(fpage->data[fpage->slot[-1*(i <= high ? i : i-1)]])) + sizeof(Two);
+	}
+	s = (i > n) ? n : i;
+
+	if (s <= high+1)
+	{
+		edubtm_MoveLeafEntries(fpage, s, n-s, npage, 0);
+		edubtm_InsertLeafEntry(npage, high+1-s, item);
+	}
+	else
+	{
+		edubtm_MoveLeafEntries(fpage, s-1, n-s+1, npage, 0);
+		edubtm_InsertLeafEntry(fpage, high+1, item);
 	}
-	fpage->hdr.nSlots = j;
-	npage->hdr.nSlots = k;
 
 	// Insert the allocated page into doubly liked list of leaf pages.
 	npage->hdr.prevPage = fpage->hdr.pid.pageNo;
 	npage->hdr.nextPage = fpage->hdr.nextPage;
 	fpage->hdr.nextPage = npage->hdr.pid.pageNo;
+	if (npage->hdr.nextPage != NIL)
+	{
+		MAKE_PAGEID(nextPid, newPid.volNo, npage->hdr.nextPage);
+		e = edubtm_GetTrain(&nextPid, &mpage, PAGE_BUF);
+		if (e < 0) ERRB1(e, &newPid, PAGE_BUF);
+		mpage->hdr.prevPage = newPid.pageNo;
+		e = BfM_SetDirty(&nextPid, PAGE_BUF);
+		if (e < 0) ERRB2(e, &nextPid, PAGE_BUF, &newPid, PAGE_BUF);
+		e = BfM_FreeTrain(&nextPid, PAGE_BUF);
+		if (e < 0) ERRB1(e, &newPid, PAGE_BUF);
+	}
 
 	// Make internal index entry that points the allocated page.
 	ritem->spid = npage->hdr.pid.pageNo;
 	nEntry = npage->data + npage->slot[0];
-	memcpy(&ritem->klen, &nEntry->klen, sizeof(InternalItem) - sizeof(ShortPageID));
+	BTM_COPY_KEY(&ritem->klen, &nEntry->klen);
+
+	e = BfM_SetDirty(&newPid, PAGE_BUF);
+	if (e < 0) ERRB1(e, &newPid, PAGE_BUF);
 
 	e = BfM_FreeTrain(&newPid, PAGE_BUF);
 	if (e < 0) ERR(e);
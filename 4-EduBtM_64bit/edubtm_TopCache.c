@@ -0,0 +1,509 @@
+/******************************************************************************/
+/*                                                                            */
+/*    ODYSSEUS/EduCOSMOS Educational-Purpose Object Storage System            */
+/*                                                                            */
+/*    Developed by Professor Kyu-Young Whang et al.                           */
+/*                                                                            */
+/*    Database and Multimedia Laboratory                                      */
+/*                                                                            */
+/*    Computer Science Department and                                         */
+/*    Advanced Information Technology Research Center (AITrc)                 */
+/*    Korea Advanced Institute of Science and Technology (KAIST)              */
+/*                                                                            */
+/*    e-mail: kywhang@cs.kaist.ac.kr                                          */
+/*    phone: +82-42-350-7722                                                  */
+/*    fax: +82-42-350-8380                                                    */
+/*                                                                            */
+/*    Copyright (c) 1995-2013 by Kyu-Young Whang                              */
+/*                                                                            */
+/*    All rights reserved. No part of this software may be reproduced,        */
+/*    stored in a retrieval system, or transmitted, in any form or by any     */
+/*    means, electronic, mechanical, photocopying, recording, or otherwise,   */
+/*    without prior written permission of the copyright owner.                */
+/*                                                                            */
+/******************************************************************************/
+/*
+ * Module: edubtm_TopCache.c
+ *
+ * Description :
+ *  Decoded copies of the top levels of the internal pages of the indexes.
+ *  The top levels of an index are small and searched by every descent, so
+ *  EduBtM_CacheTopLevels() keeps them in the memory as contiguous arrays
+ *  of the separators and the child page numbers; a search goes through
+ *  them without fixing a page or following the slots of the pages. The
+ *  functions changing an internal page invalidate the cache mirroring it,
+ *  and the next search builds the cache again.
+ *
+ * Exports:
+ *  Four edubtm_TopCacheBuild(btm_TopCache*)
+ *  void edubtm_TopCacheDrop(PageID*)
+ *  btm_TopCache *edubtm_TopCacheFind(PageID*)
+ *  void edubtm_TopCacheFree(btm_TopCache*)
+ *  void edubtm_TopCacheInvalidate(PageID*)
+ *  Four edubtm_TopCacheSearch(PageID*, KeyValue*, PageID*)
+ */
+
+
+#include <stdlib.h>
+#include <string.h>
+#include "EduBtM_common.h"
+#include "BfM.h"
+#include "EduBtM_Internal.h"
+
+
+/*@ Global Variables */
+btm_TopCache edubtm_topCaches[BTM_MAXTOPCACHES];
+Four edubtm_nTopCaches = 0;
+
+/*@ Internal Function Prototypes */
+Four edubtm_TopCacheDecode(btm_TopCache*, BtreeInternal*, btm_TopCacheNode*);
+Two edubtm_TopCacheSearchNode(btm_TopCacheNode*, KeyDesc*, KeyValue*);
+
+
+
+/*@================================
+ * edubtm_TopCacheFind()
+ *================================*/
+/*
+ * Function: btm_TopCache *edubtm_TopCacheFind(PageID*)
+ *
+ * Description:
+ *  Return the cache of the index whose root is 'root'.
+ *
+ * Returns:
+ *  pointer to the cache or NULL if the index is not cached
+ */
+btm_TopCache *edubtm_TopCacheFind(
+    PageID              *root)          /* IN root of the index */
+{
+    Four                i;              /* index */
+
+
+	for (i = 0; i < BTM_MAXTOPCACHES; i++)
+		if (edubtm_topCaches[i].nLevels > 0 && edubtm_topCaches[i].root.volNo == root->volNo
+		    && edubtm_topCaches[i].root.pageNo == root->pageNo)
+			return(&edubtm_topCaches[i]);
+
+	return(NULL);
+
+} /* edubtm_TopCacheFind() */
+
+
+
+/*@================================
+ * edubtm_TopCacheFree()
+ *================================*/
+/*
+ * Function: void edubtm_TopCacheFree(btm_TopCache*)
+ *
+ * Description:
+ *  Free the nodes of the cache and mark it invalid; the entry stays used.
+ *
+ * Returns:
+ *  None
+ */
+void edubtm_TopCacheFree(
+    btm_TopCache        *cache)         /* INOUT the cache */
+{
+    Four                k;              /* node No. */
+
+
+	for (k = 0; k < cache->nNodes; k++)
+		free(cache->nodes[k].spids);
+	free(cache->nodes);
+
+	cache->nodes = NULL;
+	cache->nNodes = 0;
+	cache->height = 0;
+	cache->valid = FALSE;
+
+} /* edubtm_TopCacheFree() */
+
+
+
+/*@================================
+ * edubtm_TopCacheDrop()
+ *================================*/
+/*
+ * Function: void edubtm_TopCacheDrop(PageID*)
+ *
+ * Description:
+ *  Free the cache of the index whose root is 'root', if any, and release
+ *  its entry.
+ *
+ * Returns:
+ *  None
+ */
+void edubtm_TopCacheDrop(
+    PageID              *root)          /* IN root of the index */
+{
+    btm_TopCache        *cache;         /* cache of the index */
+
+
+	cache = edubtm_TopCacheFind(root);
+	if (cache == NULL) return;
+
+	edubtm_TopCacheFree(cache);
+	cache->nLevels = 0;
+	edubtm_nTopCaches--;
+
+} /* edubtm_TopCacheDrop() */
+
+
+
+/*@================================
+ * edubtm_TopCacheInvalidate()
+ *================================*/
+/*
+ * Function: void edubtm_TopCacheInvalidate(PageID*)
+ *
+ * Description:
+ *  Mark invalid the cache mirroring the internal page 'pid'. It is called
+ *  before an internal page or the root is changed; the pages below the
+ *  cached levels change freely since the cache keeps only their PageNos.
+ *
+ * Returns:
+ *  None
+ */
+void edubtm_TopCacheInvalidate(
+    PageID              *pid)           /* IN the page to be changed */
+{
+    Four                i;              /* index */
+    Four                k;              /* node No. */
+    btm_TopCache        *cache;         /* a cache */
+
+
+	if (edubtm_nTopCaches == 0) return;
+
+	for (i = 0; i < BTM_MAXTOPCACHES; i++)
+	{
+		cache = &edubtm_topCaches[i];
+		if (cache->nLevels == 0 || !cache->valid || cache->root.volNo != pid->volNo) continue;
+
+		// The root is checked apart since a leaf root has no node.
+		if (cache->root.pageNo == pid->pageNo)
+		{
+			cache->valid = FALSE;
+			continue;
+		}
+
+		for (k = 0; k < cache->nNodes; k++)
+			if (cache->nodes[k].pageNo == pid->pageNo)
+			{
+				cache->valid = FALSE;
+				break;
+			}
+	}
+
+} /* edubtm_TopCacheInvalidate() */
+
+
+
+/*@================================
+ * edubtm_TopCacheBuild()
+ *================================*/
+/*
+ * Function: Four edubtm_TopCacheBuild(btm_TopCache*)
+ *
+ * Description:
+ *  Mirror the top 'nLevels' levels of the internal pages of the index in
+ *  the cache, or all of them if the index has fewer. The height is found
+ *  along the leftmost path first, and then the pages are decoded level by
+ *  level, so the children of a node are appended next to one another.
+ *
+ * Returns:
+ *  error code
+ *    eMEMORYALLOCERR_BTM
+ *    some errors caused by function calls
+ */
+Four edubtm_TopCacheBuild(
+    btm_TopCache        *cache)         /* INOUT the cache */
+{
+    Four                e;              /* error number */
+    Four                i;              /* index */
+    Four                k;              /* node No. */
+    Four                level;          /* level being decoded; the root is 0 */
+    Four                levelStart;     /* the first node of the level */
+    Four                levelEnd;       /* the node next to the last one of the level */
+    Four                maxNodes;       /* # of nodes allocated */
+    Two                 height;         /* # of internal levels to mirror */
+    Boolean             isInternal;     /* TRUE if 'pid' is an internal page */
+    ShortPageID         p0;             /* the leftmost child of 'pid' */
+    PageID              pid;            /* a page */
+    BtreePage           *apage;         /* buffer of 'pid' */
+    btm_TopCacheNode    *nodes;         /* reallocated nodes */
+
+
+	edubtm_TopCacheFree(cache);
+
+	// Count the internal levels along the leftmost path.
+	pid = cache->root;
+	for (height = 0; height < cache->nLevels; height++)
+	{
+		e = edubtm_GetTrain(&pid, &apage, PAGE_BUF);
+		if (e < 0) ERR(e);
+
+		isInternal = (apage->any.hdr.type & INTERNAL) ? TRUE : FALSE;
+		p0 = apage->bi.hdr.p0;
+
+		e = BfM_FreeTrain(&pid, PAGE_BUF);
+		if (e < 0) ERR(e);
+
+		if (!isInternal) break;
+		MAKE_PAGEID(pid, cache->root.volNo, p0);
+	}
+	cache->height = height;
+
+	if (height == 0)
+	{
+		cache->valid = TRUE;
+		return(eNOERROR);
+	}
+
+	maxNodes = 16;
+	cache->nodes = (btm_TopCacheNode*)malloc(maxNodes*sizeof(btm_TopCacheNode));
+	if (cache->nodes == NULL) ERR(eMEMORYALLOCERR_BTM);
+	cache->nodes[0].pageNo = cache->root.pageNo;
+	cache->nodes[0].spids = NULL;
+	cache->nNodes = 1;
+
+	for (level = 0, levelStart = 0; level < height; level++, levelStart = levelEnd)
+	{
+		levelEnd = cache->nNodes;
+		for (k = levelStart; k < levelEnd; k++)
+		{
+			MAKE_PAGEID(pid, cache->root.volNo, cache->nodes[k].pageNo);
+			e = edubtm_GetTrain(&pid, &apage, PAGE_BUF);
+			if (e < 0) { edubtm_TopCacheFree(cache); ERR(e); }
+
+			e = edubtm_TopCacheDecode(cache, &apage->bi, &cache->nodes[k]);
+			if (e < 0) { edubtm_TopCacheFree(cache); ERRB1(e, &pid, PAGE_BUF); }
+
+			e = BfM_FreeTrain(&pid, PAGE_BUF);
+			if (e < 0) { edubtm_TopCacheFree(cache); ERR(e); }
+
+			if (level+1 == height)
+			{
+				cache->nodes[k].child = NIL;
+				continue;
+			}
+
+			// The children are the nodes of the next level.
+			if (cache->nNodes + cache->nodes[k].nKeys + 1 > maxNodes)
+			{
+				maxNodes = 2*(cache->nNodes + cache->nodes[k].nKeys + 1);
+				nodes = (btm_TopCacheNode*)realloc(cache->nodes, maxNodes*sizeof(btm_TopCacheNode));
+				if (nodes == NULL) { edubtm_TopCacheFree(cache); ERR(eMEMORYALLOCERR_BTM); }
+				cache->nodes = nodes;
+			}
+
+			cache->nodes[k].child = cache->nNodes;
+			for (i = 0; i <= cache->nodes[k].nKeys; i++)
+			{
+				cache->nodes[cache->nNodes].pageNo = cache->nodes[k].spids[i];
+				cache->nodes[cache->nNodes].spids = NULL;
+				cache->nNodes++;
+			}
+		}
+	}
+
+	cache->valid = TRUE;
+
+	return(eNOERROR);
+
+} /* edubtm_TopCacheBuild() */
+
+
+
+/*@================================
+ * edubtm_TopCacheDecode()
+ *================================*/
+/*
+ * Function: Four edubtm_TopCacheDecode(btm_TopCache*, BtreeInternal*, btm_TopCacheNode*)
+ *
+ * Description:
+ *  Copy the separators and the children of the internal page into the
+ *  node. The arrays of the node share one piece of memory: the children,
+ *  and then the integer separators or the offsets and the separators.
+ *
+ * Returns:
+ *  error code
+ *    eMEMORYALLOCERR_BTM
+ */
+Four edubtm_TopCacheDecode(
+    btm_TopCache        *cache,         /* IN the cache */
+    BtreeInternal       *page,          /* IN the internal page */
+    btm_TopCacheNode    *node)          /* OUT the node */
+{
+    Two                 i;              /* slot No. */
+    Four                size;           /* size of the memory of the node */
+    Two                 offset;         /* offset of the next separator */
+    Boolean             isInt;          /* TRUE for a single SM_INT key */
+    btm_InternalEntry   *iEntry;        /* an internal entry */
+
+
+	isInt = (cache->kdesc.nparts == 1 && cache->kdesc.kpart[0].type == SM_INT &&
+		 cache->kdesc.kpart[0].length == sizeof(Four_Invariable));
+
+	node->nKeys = page->hdr.nSlots;
+	size = (node->nKeys+1)*sizeof(ShortPageID);
+	if (isInt)
+		size += node->nKeys*sizeof(Four_Invariable);
+	else
+	{
+		size += node->nKeys*sizeof(Two);
+		for (i = 0; i < node->nKeys; i++)
+		{
+			iEntry = (btm_InternalEntry*)&(page->data[page->slot[-1*i]]);
+			size += ALIGNED_LENGTH(sizeof(Two) + iEntry->klen);
+		}
+	}
+
+	node->spids = (ShortPageID*)malloc(size);
+	if (node->spids == NULL) ERR(eMEMORYALLOCERR_BTM);
+
+	node->ikeys = NULL;
+	node->offsets = NULL;
+	node->keys = NULL;
+	if (isInt)
+		node->ikeys = (Four_Invariable*)(node->spids + node->nKeys+1);
+	else
+	{
+		node->offsets = (Two*)(node->spids + node->nKeys+1);
+		node->keys = (char*)(node->offsets + node->nKeys);
+	}
+
+	node->spids[0] = page->hdr.p0;
+	for (i = 0, offset = 0; i < node->nKeys; i++)
+	{
+		iEntry = (btm_InternalEntry*)&(page->data[page->slot[-1*i]]);
+		node->spids[i+1] = iEntry->spid;
+
+		if (isInt)
+			memcpy(&node->ikeys[i], iEntry->kval, sizeof(Four_Invariable));
+		else
+		{
+			node->offsets[i] = offset;
+			BTM_COPY_KEY(node->keys + offset, &iEntry->klen);
+			offset += ALIGNED_LENGTH(sizeof(Two) + iEntry->klen);
+		}
+	}
+
+	return(eNOERROR);
+
+} /* edubtm_TopCacheDecode() */
+
+
+
+/*@================================
+ * edubtm_TopCacheSearchNode()
+ *================================*/
+/*
+ * Function: Two edubtm_TopCacheSearchNode(btm_TopCacheNode*, KeyDesc*, KeyValue*)
+ *
+ * Description:
+ *  Binary search of the node as edubtm_BinarySearchInternal() does: find
+ *  the last separator equal to or less than 'kval'.
+ *
+ * Returns:
+ *  index of the separator, or -1 if all the separators are greater
+ */
+Two edubtm_TopCacheSearchNode(
+    btm_TopCacheNode    *node,          /* IN the node */
+    KeyDesc             *kdesc,         /* IN key descriptor */
+    KeyValue            *kval)          /* IN key value */
+{
+    Two                 low;            /* low index */
+    Two                 mid;            /* mid index */
+    Two                 high;           /* high index */
+    Four_Invariable     key;            /* the integer key */
+
+
+	low = 0;
+	high = node->nKeys-1;
+
+	if (node->ikeys != NULL)
+	{
+		memcpy(&key, kval->val, sizeof(Four_Invariable));
+		while (low <= high)
+		{
+			mid = (low + high)/2;
+			edubtm_nProbes++;
+			if (node->ikeys[mid] <= key) low = mid+1;
+			else                         high = mid-1;
+		}
+	}
+	else
+	{
+		while (low <= high)
+		{
+			mid = (low + high)/2;
+			edubtm_nProbes++;
+			if (edubtm_KeyCompare(kdesc, (KeyValue*)(node->keys + node->offsets[mid]), kval) != GREATER)
+				low = mid+1;
+			else
+				high = mid-1;
+		}
+	}
+
+	return(high);
+
+} /* edubtm_TopCacheSearchNode() */
+
+
+
+/*@================================
+ * edubtm_TopCacheSearch()
+ *================================*/
+/*
+ * Function: Four edubtm_TopCacheSearch(PageID*, KeyValue*, PageID*)
+ *
+ * Description:
+ *  Go down the cached levels of the index toward the key value 'kval' and
+ *  return the page of the first level not cached; the search goes on from
+ *  there through the buffer. An index not cached returns its root. An
+ *  invalid cache is built again first.
+ *
+ * Returns:
+ *  error code
+ *    some errors caused by function calls
+ */
+Four edubtm_TopCacheSearch(
+    PageID              *root,          /* IN root of the index */
+    KeyValue            *kval,          /* IN key value to search */
+    PageID              *pid)           /* OUT the page to go on from */
+{
+    Four                e;              /* error number */
+    Four                k;              /* node No. */
+    Two                 idx;            /* index of the separator */
+    btm_TopCache        *cache;         /* cache of the index */
+
+
+	*pid = *root;
+
+	if (edubtm_nTopCaches == 0) return(eNOERROR);
+
+	cache = edubtm_TopCacheFind(root);
+	if (cache == NULL) return(eNOERROR);
+
+	if (!cache->valid)
+	{
+		e = edubtm_TopCacheBuild(cache);
+		if (e < 0) ERR(e);
+	}
+
+	if (cache->height == 0) return(eNOERROR);
+
+	for (k = 0; ; k = cache->nodes[k].child + idx+1)
+	{
+		idx = edubtm_TopCacheSearchNode(&cache->nodes[k], &cache->kdesc, kval);
+		if (cache->nodes[k].child == NIL) break;
+	}
+	MAKE_PAGEID(*pid, root->volNo, cache->nodes[k].spids[idx+1]);
+
+	/* the descent goes on below the cached levels */
+	edubtm_traceDepth = cache->height;
+
+	return(eNOERROR);
+
+} /* edubtm_TopCacheSearch() */
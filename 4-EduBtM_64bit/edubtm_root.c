@@ -81,6 +81,8 @@ Four edubtm_root_insert(
     Boolean   isTmp;
 
 
+	edubtm_TopCacheInvalidate(root);
+
 	// Allocate new page.
 	e = btm_AllocPage(catObjForFile, root, &newPid);
 	if (e < 0) ERR(e);
@@ -88,9 +90,10 @@ Four edubtm_root_insert(
 	if (e < 0) ERR(e);
 
 	// Copy rootPage to newPage.
-	e = BfM_GetTrain(root, &rootPage, PAGE_BUF);
+	e = edubtm_GetTrain(root, &rootPage, PAGE_BUF);
 	if (e < 0) ERR(e);
 	memcpy(newPage, rootPage, sizeof(BtreePage));
+	newPage->any.hdr.pid = newPid;
 	newPage->any.hdr.type &= ~ROOT;
 
 	// Initialize origin rootPage as new rootPage.
@@ -113,7 +116,7 @@ Four edubtm_root_insert(
 
 	// If both new internal item and new page are leaf page
 	MAKE_PAGEID(nextPid, root->volNo, entry->spid);
-	e = BfM_GetTrain(&nextPid, &nextPage, PAGE_BUF);
+	e = edubtm_GetTrain(&nextPid, &nextPage, PAGE_BUF);
 	if (e < 0) ERR(e);
 
 	if ((newPage->any.hdr.type & LEAF) && (nextPage->hdr.type & LEAF))
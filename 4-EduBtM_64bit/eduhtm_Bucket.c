@@ -0,0 +1,361 @@
+/******************************************************************************/
+/*                                                                            */
+/*    ODYSSEUS/EduCOSMOS Educational-Purpose Object Storage System            */
+/*                                                                            */
+/*    Developed by Professor Kyu-Young Whang et al.                           */
+/*                                                                            */
+/*    Database and Multimedia Laboratory                                      */
+/*                                                                            */
+/*    Computer Science Department and                                         */
+/*    Advanced Information Technology Research Center (AITrc)                 */
+/*    Korea Advanced Institute of Science and Technology (KAIST)              */
+/*                                                                            */
+/*    e-mail: kywhang@cs.kaist.ac.kr                                          */
+/*    phone: +82-42-350-7722                                                  */
+/*    fax: +82-42-350-8380                                                    */
+/*                                                                            */
+/*    Copyright (c) 1995-2013 by Kyu-Young Whang                              */
+/*                                                                            */
+/*    All rights reserved. No part of this software may be reproduced,        */
+/*    stored in a retrieval system, or transmitted, in any form or by any     */
+/*    means, electronic, mechanical, photocopying, recording, or otherwise,   */
+/*    without prior written permission of the copyright owner.                */
+/*                                                                            */
+/******************************************************************************/
+/*
+ * Module: eduhtm_Bucket.c
+ *
+ * Description :
+ *  This file has the functions which manipulate the pages of a bucket.
+ *  A bucket is a chain of a primary page and zero or more overflow pages;
+ *  the entries of a page are stored contiguously and scanned sequentially.
+ *
+ * Exports:
+ *  Four eduhtm_InitBucket(PageID*, Boolean)
+ *  Boolean eduhtm_SearchBucket(HashBucket*, KeyDesc*, KeyValue*, UFour, ObjectID*, Two*)
+ *  Four eduhtm_AppendEntry(ObjectID*, PageID*, UFour, KeyValue*, ObjectID*, Boolean*)
+ *  void eduhtm_RemoveEntry(HashBucket*, Two)
+ *  Four eduhtm_FreePage(PageID*, Pool*, DeallocListElem*)
+ *  Four eduhtm_FreeChain(PageID*, Pool*, DeallocListElem*)
+ */
+
+
+#include <string.h>
+#include "EduBtM_common.h"
+#include "Util.h"
+#include "BfM.h"
+#include "EduHtM_Internal.h"
+
+
+
+/*@================================
+ * eduhtm_InitBucket()
+ *================================*/
+/*
+ * Function: Four eduhtm_InitBucket(PageID*, Boolean)
+ *
+ * Description:
+ *  Initialize as a bucket page. If 'overflow' is TRUE, this page is
+ *  initialized as an overflow page of a bucket.
+ *
+ * Returns:
+ *  Error code
+ *    some errors caused by function calls
+ */
+Four eduhtm_InitBucket(
+    PageID      *bucket,        /* IN the PageID to be initialized */
+    Boolean     overflow)       /* IN Is it an overflow page ? */
+{
+    Four        e;              /* error number */
+    HashBucket  *page;          /* a page pointer */
+
+
+	e = BfM_GetNewTrain(bucket, &page, PAGE_BUF);
+	if (e < 0) ERR(e);
+
+	MAKE_PAGEID(page->hdr.pid, bucket->volNo, bucket->pageNo);
+	SET_PAGE_TYPE(page, BTREE_PAGE_TYPE);
+	page->hdr.type = HASH | (overflow ? OVERFLOW : LEAF);
+	page->hdr.nEntries = 0;
+	page->hdr.free = 0;
+	page->hdr.nextPage = NIL;
+
+	e = BfM_SetDirty(bucket, PAGE_BUF);
+	if (e < 0) ERRB1(e, bucket, PAGE_BUF);
+	e = BfM_FreeTrain(bucket, PAGE_BUF);
+	if (e < 0) ERR(e);
+
+	return(eNOERROR);
+
+} /* eduhtm_InitBucket() */
+
+
+
+/*@================================
+ * eduhtm_SearchBucket()
+ *================================*/
+/*
+ * Function: Boolean eduhtm_SearchBucket(HashBucket*, KeyDesc*, KeyValue*,
+ *                                       UFour, ObjectID*, Two*)
+ *
+ * Description:
+ *  Search the given bucket page for an entry having the given key, starting
+ *  at the entry whose offset is given by 'offset'. The hash value is
+ *  compared first so that the keys are compared only for the candidates.
+ *  If 'oid' is not NULL, the entry should also have the given ObjectID.
+ *
+ * Returns:
+ *  Result of search: TRUE if the entry is found, FALSE otherwise
+ *
+ * Side effects:
+ *  1) parameter offset : offset of the found entry in the data area
+ */
+Boolean eduhtm_SearchBucket(
+    HashBucket  *page,          /* IN bucket page */
+    KeyDesc     *kdesc,         /* IN key descriptor */
+    KeyValue    *kval,          /* IN key value */
+    UFour       hash,           /* IN hash value of 'kval' */
+    ObjectID    *oid,           /* IN ObjectID to be searched; NULL for any ObjectID */
+    Two         *offset)        /* INOUT starting offset / offset of the found entry */
+{
+    Two         entryOffset;    /* starting offset of an entry */
+    htm_Entry   *entry;         /* an entry of the bucket */
+    ObjectID    tOid;           /* ObjectID of the entry */
+
+
+	for (entryOffset = *offset; entryOffset < page->hdr.free; entryOffset += HTM_ENTRY_LEN(entry->klen))
+	{
+		entry = (htm_Entry*)&page->data[entryOffset];
+
+		if (entry->hash != hash) continue;
+		if (edubtm_KeyCompare(kdesc, (KeyValue*)&entry->klen, kval) != EQUAL) continue;
+
+		if (oid != NULL)
+		{
+			memcpy(&tOid, &entry->kval[ALIGNED_LENGTH(entry->klen)], sizeof(ObjectID));
+			if (btm_ObjectIdComp(&tOid, oid) != EQUAL) continue;
+		}
+
+		*offset = entryOffset;
+		return(TRUE);
+	}
+
+	return(FALSE);
+
+} /* eduhtm_SearchBucket() */
+
+
+
+/*@================================
+ * eduhtm_AppendEntry()
+ *================================*/
+/*
+ * Function: Four eduhtm_AppendEntry(ObjectID*, PageID*, UFour, KeyValue*,
+ *                                   ObjectID*, Boolean*)
+ *
+ * Description:
+ *  Append an entry to the first page of the bucket chain which has enough
+ *  free space. If no page has enough space, a new overflow page is
+ *  allocated and linked at the end of the chain.
+ *
+ * Returns:
+ *  Error code
+ *    some errors caused by function calls
+ *
+ * Side effects:
+ *  1) parameter overflowed : TRUE if the entry was not stored in the primary page
+ */
+Four eduhtm_AppendEntry(
+    ObjectID    *catObjForFile, /* IN catalog object of the index file */
+    PageID      *bucketPid,     /* IN primary page of the bucket */
+    UFour       hash,           /* IN hash value of 'kval' */
+    KeyValue    *kval,          /* IN key value */
+    ObjectID    *oid,           /* IN ObjectID to be stored */
+    Boolean     *overflowed)    /* OUT whether the entry went to an overflow page */
+{
+    Four        e;              /* error number */
+    Two         entryLen;       /* length of the new entry */
+    PageID      curPid;         /* current page of the chain */
+    PageID      newPid;         /* newly allocated overflow page */
+    HashBucket  *page;          /* pointer to the buffer holding the current page */
+    htm_Entry   *entry;         /* the new entry */
+
+
+	entryLen = HTM_ENTRY_LEN(kval->len);
+	*overflowed = FALSE;
+	curPid = *bucketPid;
+
+	e = BfM_GetTrain(&curPid, &page, PAGE_BUF);
+	if (e < 0) ERR(e);
+
+	while (HB_FREE(page) < entryLen)
+	{
+		*overflowed = TRUE;
+
+		if (page->hdr.nextPage == NIL)
+		{
+			e = btm_AllocPage(catObjForFile, &curPid, &newPid);
+			if (e < 0) ERRB1(e, &curPid, PAGE_BUF);
+			e = eduhtm_InitBucket(&newPid, TRUE);
+			if (e < 0) ERRB1(e, &curPid, PAGE_BUF);
+
+			page->hdr.nextPage = newPid.pageNo;
+			e = BfM_SetDirty(&curPid, PAGE_BUF);
+			if (e < 0) ERRB1(e, &curPid, PAGE_BUF);
+		}
+
+		MAKE_PAGEID(newPid, curPid.volNo, page->hdr.nextPage);
+		e = BfM_FreeTrain(&curPid, PAGE_BUF);
+		if (e < 0) ERR(e);
+
+		curPid = newPid;
+		e = BfM_GetTrain(&curPid, &page, PAGE_BUF);
+		if (e < 0) ERR(e);
+	}
+
+	entry = (htm_Entry*)&page->data[page->hdr.free];
+	entry->hash = hash;
+	entry->klen = kval->len;
+	memcpy(entry->kval, kval->val, kval->len);
+	memcpy(&entry->kval[ALIGNED_LENGTH(kval->len)], oid, sizeof(ObjectID));
+
+	page->hdr.free += entryLen;
+	page->hdr.nEntries++;
+
+	e = BfM_SetDirty(&curPid, PAGE_BUF);
+	if (e < 0) ERRB1(e, &curPid, PAGE_BUF);
+	e = BfM_FreeTrain(&curPid, PAGE_BUF);
+	if (e < 0) ERR(e);
+
+	return(eNOERROR);
+
+} /* eduhtm_AppendEntry() */
+
+
+
+/*@================================
+ * eduhtm_RemoveEntry()
+ *================================*/
+/*
+ * Function: void eduhtm_RemoveEntry(HashBucket*, Two)
+ *
+ * Description:
+ *  Remove the entry at the given offset by moving the following entries
+ *  toward the beginning of the page, so the free space stays contiguous.
+ *
+ * Returns:
+ *  None
+ *
+ * Note:
+ *  The caller should call BfM_SetDirty() for 'page'.
+ */
+void eduhtm_RemoveEntry(
+    HashBucket  *page,          /* INOUT bucket page */
+    Two         offset)         /* IN offset of the entry to be removed */
+{
+    Two         entryLen;       /* length of the removed entry */
+    htm_Entry   *entry;         /* the removed entry */
+
+
+	entry = (htm_Entry*)&page->data[offset];
+	entryLen = HTM_ENTRY_LEN(entry->klen);
+
+	memmove(&page->data[offset], &page->data[offset + entryLen], page->hdr.free - offset - entryLen);
+
+	page->hdr.free -= entryLen;
+	page->hdr.nEntries--;
+
+} /* eduhtm_RemoveEntry() */
+
+
+
+/*@================================
+ * eduhtm_FreePage()
+ *================================*/
+/*
+ * Function: Four eduhtm_FreePage(PageID*, Pool*, DeallocListElem*)
+ *
+ * Description:
+ *  Mark the given page as a free page and put it into the dealloc list.
+ *
+ * Returns:
+ *  Error code
+ *    some errors caused by function calls
+ */
+Four eduhtm_FreePage(
+    PageID          *pid,       /* IN page to be freed */
+    Pool            *dlPool,    /* INOUT pool of dealloc list elements */
+    DeallocListElem *dlHead)    /* INOUT head of the dealloc list */
+{
+    Four            e;          /* error number */
+    BtreeAny        *apage;     /* pointer to the buffer holding the page */
+    DeallocListElem *dlElem;    /* an element of the dealloc list */
+
+
+	e = BfM_GetTrain(pid, &apage, PAGE_BUF);
+	if (e < 0) ERR(e);
+
+	apage->hdr.type = FREEPAGE;
+
+	e = BfM_SetDirty(pid, PAGE_BUF);
+	if (e < 0) ERRB1(e, pid, PAGE_BUF);
+	e = BfM_FreeTrain(pid, PAGE_BUF);
+	if (e < 0) ERR(e);
+
+	e = Util_getElementFromPool(dlPool, &dlElem);
+	if (e < 0) ERR(e);
+
+	dlElem->type = DL_PAGE;
+	dlElem->elem.pid = *pid;
+	dlElem->next = dlHead->next;
+	dlHead->next = dlElem;
+
+	return(eNOERROR);
+
+} /* eduhtm_FreePage() */
+
+
+
+/*@================================
+ * eduhtm_FreeChain()
+ *================================*/
+/*
+ * Function: Four eduhtm_FreeChain(PageID*, Pool*, DeallocListElem*)
+ *
+ * Description:
+ *  Free all pages of the chain starting at the given page.
+ *
+ * Returns:
+ *  Error code
+ *    some errors caused by function calls
+ */
+Four eduhtm_FreeChain(
+    PageID          *firstPid,  /* IN first page of the chain */
+    Pool            *dlPool,    /* INOUT pool of dealloc list elements */
+    DeallocListElem *dlHead)    /* INOUT head of the dealloc list */
+{
+    Four            e;          /* error number */
+    PageID          curPid;     /* current page of the chain */
+    PageID          nextPid;    /* next page of the chain */
+    HashBucket      *page;      /* pointer to the buffer holding the current page */
+
+
+	curPid = *firstPid;
+
+	while (curPid.pageNo != NIL)
+	{
+		e = BfM_GetTrain(&curPid, &page, PAGE_BUF);
+		if (e < 0) ERR(e);
+		MAKE_PAGEID(nextPid, curPid.volNo, page->hdr.nextPage);
+		e = BfM_FreeTrain(&curPid, PAGE_BUF);
+		if (e < 0) ERR(e);
+
+		e = eduhtm_FreePage(&curPid, dlPool, dlHead);
+		if (e < 0) ERR(e);
+
+		curPid = nextPid;
+	}
+
+	return(eNOERROR);
+
+} /* eduhtm_FreeChain() */
@@ -0,0 +1,281 @@
+/******************************************************************************/
+/*                                                                            */
+/*    ODYSSEUS/EduCOSMOS Educational-Purpose Object Storage System            */
+/*                                                                            */
+/*    Developed by Professor Kyu-Young Whang et al.                           */
+/*                                                                            */
+/*    Database and Multimedia Laboratory                                      */
+/*                                                                            */
+/*    Computer Science Department and                                         */
+/*    Advanced Information Technology Research Center (AITrc)                 */
+/*    Korea Advanced Institute of Science and Technology (KAIST)              */
+/*                                                                            */
+/*    e-mail: kywhang@cs.kaist.ac.kr                                          */
+/*    phone: +82-42-350-7722                                                  */
+/*    fax: +82-42-350-8380                                                    */
+/*                                                                            */
+/*    Copyright (c) 1995-2013 by Kyu-Young Whang                              */
+/*                                                                            */
+/*    All rights reserved. No part of this software may be reproduced,        */
+/*    stored in a retrieval system, or transmitted, in any form or by any     */
+/*    means, electronic, mechanical, photocopying, recording, or otherwise,   */
+/*    without prior written permission of the copyright owner.                */
+/*                                                                            */
+/******************************************************************************/
+/*
+ * Module: eduhtm_Directory.c
+ *
+ * Description:
+ *  In-memory copies of the directories of the hash indexes. The copy of an
+ *  index holds the header of its meta page and the primary pages of all
+ *  its buckets, and is found by the PageID of the meta page. A lookup
+ *  finds the bucket of its key in the copy, so it fixes only the pages of
+ *  one bucket chain instead of the meta page and a directory page as well.
+ *
+ *  The primary page of a bucket never changes once the bucket exists; the
+ *  directory changes only when a bucket is splitted, and the split updates
+ *  the copy. When all the entries are used, the copy of another index is
+ *  given up in round-robin order, and read again from the meta page and
+ *  the directory pages when that index is used next.
+ *
+ * Exports:
+ *  Four eduhtm_GetDirectory(PageID*, HtmDirectory**)
+ *  void eduhtm_DiscardDirectory(PageID*)
+ *  Four eduhtm_UpdateDirectory(HashMeta*, Four, PageID*)
+ */
+
+
+#include <stdlib.h>
+#include "EduBtM_common.h"
+#include "BfM.h"
+#include "EduHtM_Internal.h"
+
+
+/* directories of the hash indexes */
+static HtmDirectory eduhtm_directories[HTM_MAXOPENINDEXES];
+
+/* entry to be given up next when all the entries are used */
+static Four eduhtm_nextVictim = 0;
+
+/*@ Internal Function Prototypes */
+HtmDirectory *eduhtm_FindDirectory(PageID*);
+Four eduhtm_GrowDirectory(HtmDirectory*, Four);
+
+
+
+/*@================================
+ * eduhtm_GetDirectory()
+ *================================*/
+/*
+ * Function: Four eduhtm_GetDirectory(PageID*, HtmDirectory**)
+ *
+ * Description:
+ *  Find the directory of the hash index given by its meta page 'root'. If
+ *  it is not in memory, it is read from the meta page and the directory
+ *  pages.
+ *
+ * Returns:
+ *  Error code
+ *    eBADPAGETYPE_BTM
+ *    eMEMORYALLOCERR_BTM
+ *    some errors caused by function calls
+ *
+ * Side effects:
+ *  1) parameter dir : the directory of the index
+ */
+Four eduhtm_GetDirectory(
+    PageID              *root,          /* IN meta page of the hash index */
+    HtmDirectory        **dir)          /* OUT the directory */
+{
+    Four                e;              /* error number */
+    Four                i;              /* index of an entry */
+    Four                d;              /* index of a directory page */
+    Four                n;              /* # of buckets to be copied */
+    PageID              dirPid;         /* PageID of a directory page */
+    HashMeta            *meta;          /* pointer to the buffer holding the meta page */
+    HashDir             *dpage;         /* pointer to the buffer holding a directory page */
+    HtmDirectory        *freeDir;       /* an unused entry */
+
+
+	*dir = eduhtm_FindDirectory(root);
+	if (*dir != NULL) return(eNOERROR);
+
+	freeDir = NULL;
+	for (i = 0; i < HTM_MAXOPENINDEXES && freeDir == NULL; i++)
+		if (!eduhtm_directories[i].used) freeDir = &eduhtm_directories[i];
+
+	if (freeDir == NULL)
+	{
+		freeDir = &eduhtm_directories[eduhtm_nextVictim];
+		eduhtm_nextVictim = (eduhtm_nextVictim + 1) % HTM_MAXOPENINDEXES;
+		freeDir->used = FALSE;
+	}
+
+	e = BfM_GetTrain(root, &meta, PAGE_BUF);
+	if (e < 0) ERR(e);
+
+	if (meta->hdr.type != (HASH | ROOT)) ERRB1(eBADPAGETYPE_BTM, root, PAGE_BUF);
+
+	e = eduhtm_GrowDirectory(freeDir, meta->hdr.nBuckets);
+	if (e < 0) ERRB1(e, root, PAGE_BUF);
+
+	freeDir->hdr = meta->hdr;
+
+	n = MIN(meta->hdr.nBuckets, HM_NDIRECT);
+	for (i = 0; i < n; i++)
+		freeDir->bucket[i] = meta->bucket[i];
+
+	for (d = 0; d < meta->hdr.nDirPages; d++)
+	{
+		MAKE_PAGEID(dirPid, root->volNo, meta->dirPage[d]);
+		e = BfM_GetTrain(&dirPid, &dpage, PAGE_BUF);
+		if (e < 0) ERRB1(e, root, PAGE_BUF);
+
+		n = MIN(meta->hdr.nBuckets - HM_NDIRECT - d*HD_MAXBUCKETS, HD_MAXBUCKETS);
+		for (i = 0; i < n; i++)
+			freeDir->bucket[HM_NDIRECT + d*HD_MAXBUCKETS + i] = dpage->bucket[i];
+
+		e = BfM_FreeTrain(&dirPid, PAGE_BUF);
+		if (e < 0) ERRB1(e, root, PAGE_BUF);
+	}
+
+	e = BfM_FreeTrain(root, PAGE_BUF);
+	if (e < 0) ERR(e);
+
+	freeDir->used = TRUE;
+	*dir = freeDir;
+
+	return(eNOERROR);
+
+} /* eduhtm_GetDirectory() */
+
+
+
+/*@================================
+ * eduhtm_DiscardDirectory()
+ *================================*/
+/*
+ * Function: void eduhtm_DiscardDirectory(PageID*)
+ *
+ * Description:
+ *  Forget the directory of the hash index given by its meta page 'root'.
+ *
+ * Returns:
+ *  None
+ */
+void eduhtm_DiscardDirectory(
+    PageID              *root)          /* IN meta page of the hash index */
+{
+    HtmDirectory        *dir;           /* the directory of the index */
+
+
+	dir = eduhtm_FindDirectory(root);
+	if (dir != NULL) dir->used = FALSE;
+
+} /* eduhtm_DiscardDirectory() */
+
+
+
+/*@================================
+ * eduhtm_UpdateDirectory()
+ *================================*/
+/*
+ * Function: Four eduhtm_UpdateDirectory(HashMeta*, Four, PageID*)
+ *
+ * Description:
+ *  Bring the directory of the index in memory, if any, up to date with the
+ *  meta page after the bucket 'bucketNo' is added by a split.
+ *
+ * Returns:
+ *  Error code
+ *    eMEMORYALLOCERR_BTM
+ */
+Four eduhtm_UpdateDirectory(
+    HashMeta            *meta,          /* IN meta page */
+    Four                bucketNo,       /* IN the new bucket */
+    PageID              *bucketPid)     /* IN primary page of the new bucket */
+{
+    Four                e;              /* error number */
+    HtmDirectory        *dir;           /* the directory of the index */
+
+
+	dir = eduhtm_FindDirectory(&meta->hdr.pid);
+	if (dir == NULL) return(eNOERROR);
+
+	e = eduhtm_GrowDirectory(dir, bucketNo + 1);
+	if (e < 0) { dir->used = FALSE; ERR(e); }
+
+	dir->hdr = meta->hdr;
+	dir->bucket[bucketNo] = bucketPid->pageNo;
+
+	return(eNOERROR);
+
+} /* eduhtm_UpdateDirectory() */
+
+
+
+/*@================================
+ * eduhtm_FindDirectory()
+ *================================*/
+/*
+ * Function: HtmDirectory *eduhtm_FindDirectory(PageID*)
+ *
+ * Description:
+ *  Return the directory in memory of the index given by its meta page.
+ *
+ * Returns:
+ *  pointer to the directory or NULL if it is not in memory
+ */
+HtmDirectory *eduhtm_FindDirectory(
+    PageID              *root)          /* IN meta page of the hash index */
+{
+    Four                i;              /* index of an entry */
+
+
+	for (i = 0; i < HTM_MAXOPENINDEXES; i++)
+		if (eduhtm_directories[i].used &&
+		    eduhtm_directories[i].hdr.pid.volNo == root->volNo &&
+		    eduhtm_directories[i].hdr.pid.pageNo == root->pageNo)
+			return(&eduhtm_directories[i]);
+
+	return(NULL);
+
+} /* eduhtm_FindDirectory() */
+
+
+
+/*@================================
+ * eduhtm_GrowDirectory()
+ *================================*/
+/*
+ * Function: Four eduhtm_GrowDirectory(HtmDirectory*, Four)
+ *
+ * Description:
+ *  Make room for at least 'n' buckets in the directory. The room is
+ *  doubled, so a growing index reallocates it rarely.
+ *
+ * Returns:
+ *  Error code
+ *    eMEMORYALLOCERR_BTM
+ */
+Four eduhtm_GrowDirectory(
+    HtmDirectory        *dir,           /* INOUT the directory */
+    Four                n)              /* IN # of buckets */
+{
+    Four                size;           /* the new # of elements of 'bucket' */
+    ShortPageID         *bucket;        /* the new array of the buckets */
+
+
+	if (n <= dir->size) return(eNOERROR);
+
+	for (size = (dir->size > 0) ? dir->size : HTM_MINDIRSIZE; size < n; size *= 2);
+
+	bucket = (ShortPageID*)realloc(dir->bucket, sizeof(ShortPageID) * size);
+	if (bucket == NULL) ERR(eMEMORYALLOCERR_BTM);
+
+	dir->bucket = bucket;
+	dir->size = size;
+
+	return(eNOERROR);
+
+} /* eduhtm_GrowDirectory() */
@@ -0,0 +1,268 @@
+/******************************************************************************/
+/*                                                                            */
+/*    ODYSSEUS/EduCOSMOS Educational-Purpose Object Storage System            */
+/*                                                                            */
+/*    Developed by Professor Kyu-Young Whang et al.                           */
+/*                                                                            */
+/*    Database and Multimedia Laboratory                                      */
+/*                                                                            */
+/*    Computer Science Department and                                         */
+/*    Advanced Information Technology Research Center (AITrc)                 */
+/*    Korea Advanced Institute of Science and Technology (KAIST)              */
+/*                                                                            */
+/*    e-mail: kywhang@cs.kaist.ac.kr                                          */
+/*    phone: +82-42-350-7722                                                  */
+/*    fax: +82-42-350-8380                                                    */
+/*                                                                            */
+/*    Copyright (c) 1995-2013 by Kyu-Young Whang                              */
+/*                                                                            */
+/*    All rights reserved. No part of this software may be reproduced,        */
+/*    stored in a retrieval system, or transmitted, in any form or by any     */
+/*    means, electronic, mechanical, photocopying, recording, or otherwise,   */
+/*    without prior written permission of the copyright owner.                */
+/*                                                                            */
+/******************************************************************************/
+/*
+ * Module: eduhtm_Hash.c
+ *
+ * Description :
+ *  This file has the functions which map a key value to a bucket of the
+ *  linear hashing index. The hash value is computed on the key parts as
+ *  they are compared by edubtm_KeyCompare(), so equal keys always have
+ *  the same hash value. The bucket is located through the bucket array of
+ *  the meta page or, for the buckets beyond HM_NDIRECT, of a directory page.
+ *
+ * Exports:
+ *  UFour eduhtm_Hash(KeyDesc*, KeyValue*)
+ *  Four eduhtm_BucketNo(HashMetaHdr*, UFour)
+ *  Four eduhtm_GetBucket(HashMeta*, Four, PageID*)
+ *  Four eduhtm_SetBucket(ObjectID*, HashMeta*, Four, PageID*)
+ */
+
+
+#include <string.h>
+#include "EduBtM_common.h"
+#include "BfM.h"
+#include "EduHtM_Internal.h"
+
+
+/* FNV-1a parameters */
+#define HTM_FNV_OFFSET  2166136261U
+#define HTM_FNV_PRIME   16777619U
+
+
+
+/*@================================
+ * eduhtm_Hash()
+ *================================*/
+/*
+ * Function: UFour eduhtm_Hash(KeyDesc*, KeyValue*)
+ *
+ * Description:
+ *  Compute the hash value of the given key. Each key part is hashed by the
+ *  bytes which take part in the comparison; for SM_VARSTRING only the
+ *  characters up to the terminating null character are used. The result is
+ *  mixed once more because the bucket number uses the low order bits.
+ *
+ * Returns:
+ *  hash value of the key
+ */
+UFour eduhtm_Hash(
+    KeyDesc     *kdesc,         /* IN key descriptor */
+    KeyValue    *kval)          /* IN key value */
+{
+    UFour       h;              /* hash value */
+    Two         i;              /* index for # of key parts */
+    Two         j;              /* offset in the key value */
+    Two         k;              /* index for the bytes of a key part */
+    Two         len;            /* length of the current key part */
+    unsigned char *p;           /* pointer to the key value */
+
+
+	p = (unsigned char*)kval->val;
+	h = HTM_FNV_OFFSET;
+	j = 0;
+
+	for (i = 0; i < kdesc->nparts; i++)
+	{
+		if (kdesc->kpart[i].type == SM_VARSTRING)
+		{
+			memcpy(&len, &p[j], sizeof(Two));
+			for (k = 0; k < len && p[j+sizeof(Two)+k] != '\0'; k++)
+				h = (h ^ p[j+sizeof(Two)+k]) * HTM_FNV_PRIME;
+			j += sizeof(Two) + len;
+		}
+		else
+		{
+			len = kdesc->kpart[i].length;
+			for (k = 0; k < len; k++)
+				h = (h ^ p[j+k]) * HTM_FNV_PRIME;
+			j += len;
+		}
+	}
+
+	h ^= h >> 16;
+	h *= 0x85ebca6bU;
+	h ^= h >> 13;
+
+	return(h);
+
+} /* eduhtm_Hash() */
+
+
+
+/*@================================
+ * eduhtm_BucketNo()
+ *================================*/
+/*
+ * Function: Four eduhtm_BucketNo(HashMetaHdr*, UFour)
+ *
+ * Description:
+ *  Return the bucket number of the given hash value. The hash value is
+ *  taken modulo 2^level; the buckets before 'next' were already splitted
+ *  in this round, so they are addressed modulo 2^(level+1).
+ *
+ * Returns:
+ *  bucket number
+ */
+Four eduhtm_BucketNo(
+    HashMetaHdr *hdr,           /* IN header of the meta page */
+    UFour       hash)           /* IN hash value */
+{
+    UFour       bucketNo;       /* bucket number */
+
+
+	bucketNo = hash & ((1U << hdr->level) - 1);
+	if (bucketNo < (UFour)hdr->next)
+		bucketNo = hash & ((1U << (hdr->level+1)) - 1);
+
+	return((Four)bucketNo);
+
+} /* eduhtm_BucketNo() */
+
+
+
+/*@================================
+ * eduhtm_GetBucket()
+ *================================*/
+/*
+ * Function: Four eduhtm_GetBucket(HashMeta*, Four, PageID*)
+ *
+ * Description:
+ *  Get the PageID of the primary page of the given bucket.
+ *
+ * Returns:
+ *  error code
+ *    eBADPARAMETER_BTM
+ *    some errors caused by function calls
+ */
+Four eduhtm_GetBucket(
+    HashMeta    *meta,          /* IN meta page */
+    Four        bucketNo,       /* IN bucket number */
+    PageID      *bucketPid)     /* OUT primary page of the bucket */
+{
+    Four        e;              /* error number */
+    PageID      dirPid;         /* PageID of the directory page */
+    HashDir     *dpage;         /* pointer to the buffer holding the directory page */
+
+
+	if (bucketNo < 0 || bucketNo >= meta->hdr.nBuckets) ERR(eBADPARAMETER_BTM);
+
+	if (bucketNo < HM_NDIRECT)
+	{
+		MAKE_PAGEID(*bucketPid, meta->hdr.pid.volNo, meta->bucket[bucketNo]);
+		return(eNOERROR);
+	}
+
+	bucketNo -= HM_NDIRECT;
+	MAKE_PAGEID(dirPid, meta->hdr.pid.volNo, meta->dirPage[bucketNo / HD_MAXBUCKETS]);
+
+	e = BfM_GetTrain(&dirPid, &dpage, PAGE_BUF);
+	if (e < 0) ERR(e);
+
+	MAKE_PAGEID(*bucketPid, meta->hdr.pid.volNo, dpage->bucket[bucketNo % HD_MAXBUCKETS]);
+
+	e = BfM_FreeTrain(&dirPid, PAGE_BUF);
+	if (e < 0) ERR(e);
+
+	return(eNOERROR);
+
+} /* eduhtm_GetBucket() */
+
+
+
+/*@================================
+ * eduhtm_SetBucket()
+ *================================*/
+/*
+ * Function: Four eduhtm_SetBucket(ObjectID*, HashMeta*, Four, PageID*)
+ *
+ * Description:
+ *  Record the primary page of the given bucket. If the bucket is the first
+ *  one of a directory page which does not exist yet, the directory page is
+ *  allocated.
+ *
+ * Returns:
+ *  error code
+ *    eBADPARAMETER_BTM
+ *    some errors caused by function calls
+ *
+ * Note:
+ *  The caller should call BfM_SetDirty() for the meta page.
+ */
+Four eduhtm_SetBucket(
+    ObjectID    *catObjForFile, /* IN catalog object of the index file */
+    HashMeta    *meta,          /* INOUT meta page */
+    Four        bucketNo,       /* IN bucket number */
+    PageID      *bucketPid)     /* IN primary page of the bucket */
+{
+    Four        e;              /* error number */
+    Four        dirNo;          /* index of the directory page */
+    PageID      dirPid;         /* PageID of the directory page */
+    HashDir     *dpage;         /* pointer to the buffer holding the directory page */
+
+
+	if (bucketNo < 0 || bucketNo >= HTM_MAXBUCKETS) ERR(eBADPARAMETER_BTM);
+
+	if (bucketNo < HM_NDIRECT)
+	{
+		meta->bucket[bucketNo] = bucketPid->pageNo;
+		return(eNOERROR);
+	}
+
+	bucketNo -= HM_NDIRECT;
+	dirNo = bucketNo / HD_MAXBUCKETS;
+
+	if (dirNo == meta->hdr.nDirPages)
+	{
+		e = btm_AllocPage(catObjForFile, &meta->hdr.pid, &dirPid);
+		if (e < 0) ERR(e);
+
+		e = BfM_GetNewTrain(&dirPid, &dpage, PAGE_BUF);
+		if (e < 0) ERR(e);
+
+		dpage->hdr.pid = dirPid;
+		SET_PAGE_TYPE(dpage, BTREE_PAGE_TYPE);
+		dpage->hdr.type = HASH | INTERNAL;
+
+		meta->dirPage[dirNo] = dirPid.pageNo;
+		meta->hdr.nDirPages++;
+	}
+	else
+	{
+		MAKE_PAGEID(dirPid, meta->hdr.pid.volNo, meta->dirPage[dirNo]);
+
+		e = BfM_GetTrain(&dirPid, &dpage, PAGE_BUF);
+		if (e < 0) ERR(e);
+	}
+
+	dpage->bucket[bucketNo % HD_MAXBUCKETS] = bucketPid->pageNo;
+
+	e = BfM_SetDirty(&dirPid, PAGE_BUF);
+	if (e < 0) ERRB1(e, &dirPid, PAGE_BUF);
+	e = BfM_FreeTrain(&dirPid, PAGE_BUF);
+	if (e < 0) ERR(e);
+
+	return(eNOERROR);
+
+} /* eduhtm_SetBucket() */
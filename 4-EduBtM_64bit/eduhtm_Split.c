@@ -0,0 +1,211 @@
+/******************************************************************************/
+/*                                                                            */
+/*    ODYSSEUS/EduCOSMOS Educational-Purpose Object Storage System            */
+/*                                                                            */
+/*    Developed by Professor Kyu-Young Whang et al.                           */
+/*                                                                            */
+/*    Database and Multimedia Laboratory                                      */
+/*                                                                            */
+/*    Computer Science Department and                                         */
+/*    Advanced Information Technology Research Center (AITrc)                 */
+/*    Korea Advanced Institute of Science and Technology (KAIST)              */
+/*                                                                            */
+/*    e-mail: kywhang@cs.kaist.ac.kr                                          */
+/*    phone: +82-42-350-7722                                                  */
+/*    fax: +82-42-350-8380                                                    */
+/*                                                                            */
+/*    Copyright (c) 1995-2013 by Kyu-Young Whang                              */
+/*                                                                            */
+/*    All rights reserved. No part of this software may be reproduced,        */
+/*    stored in a retrieval system, or transmitted, in any form or by any     */
+/*    means, electronic, mechanical, photocopying, recording, or otherwise,   */
+/*    without prior written permission of the copyright owner.                */
+/*                                                                            */
+/******************************************************************************/
+/*
+ * Module: eduhtm_Split.c
+ *
+ * Description :
+ *  Split a bucket of the linear hashing index. Buckets are splitted in
+ *  round-robin order regardless of which bucket overflowed; the bucket
+ *  pointed by 'next' is splitted into itself and its buddy bucket
+ *  'next + 2^level', and the overflow chain of the splitted bucket shrinks.
+ *
+ * Exports:
+ *  Four eduhtm_SplitBucket(ObjectID*, HashMeta*, Pool*, DeallocListElem*)
+ */
+
+
+#include <stdlib.h>
+#include <string.h>
+#include "EduBtM_common.h"
+#include "BfM.h"
+#include "EduHtM_Internal.h"
+
+
+
+/*@================================
+ * eduhtm_SplitBucket()
+ *================================*/
+/*
+ * Function: Four eduhtm_SplitBucket(ObjectID*, HashMeta*, Pool*, DeallocListElem*)
+ *
+ * Description:
+ *  Split the bucket 'next' of the current round. At first, all entries of
+ *  the bucket are copied out and the pages of the chain are emptied.
+ *  Secondly, each entry is stored again either in the old chain or in the
+ *  newly allocated buddy bucket according to the next bit of its hash value.
+ *  The overflow pages which became empty are freed if the dealloc list is
+ *  given; otherwise they are kept at the end of the chain for later use.
+ *
+ * Returns:
+ *  error code
+ *    some errors caused by function calls
+ *
+ * Note:
+ *  The caller should call BfM_SetDirty() for the meta page.
+ */
+Four eduhtm_SplitBucket(
+    ObjectID        *catObjForFile, /* IN catalog object of the index file */
+    HashMeta        *meta,          /* INOUT meta page */
+    Pool            *dlPool,        /* INOUT pool of dealloc list elements */
+    DeallocListElem *dlHead)        /* INOUT head of the dealloc list */
+{
+    Four            e;              /* error number */
+    Four            oldNo;          /* bucket to be splitted */
+    Four            newNo;          /* buddy bucket */
+    PageID          oldPid;         /* primary page of the old bucket */
+    PageID          newPid;         /* primary page of the new bucket */
+    PageID          curPid;         /* current page of the chain */
+    PageID          nextPid;        /* next page of the chain */
+    PageID          prevPid;        /* previous page of the chain */
+    HashBucket      *page;          /* pointer to the buffer holding a bucket page */
+    HashBucket      *npage;         /* pointer to the buffer holding the next page */
+    Two             nEntries;       /* # of entries in the next page */
+    char            *buf;           /* entries copied out of the old bucket */
+    Four            bufSize;        /* allocated size of 'buf' */
+    Four            bufLen;         /* used size of 'buf' */
+    Four            offset;         /* offset of an entry in 'buf' */
+    htm_Entry       *entry;         /* an entry */
+    ObjectID        oid;            /* ObjectID of an entry */
+    Boolean         overflowed;     /* dummy result of eduhtm_AppendEntry() */
+
+
+	if (meta->hdr.nBuckets >= HTM_MAXBUCKETS) return(eNOERROR);
+
+	oldNo = meta->hdr.next;
+	newNo = oldNo + (1 << meta->hdr.level);
+
+	e = eduhtm_GetBucket(meta, oldNo, &oldPid);
+	if (e < 0) ERR(e);
+
+	/* Allocate the buddy bucket. */
+	e = btm_AllocPage(catObjForFile, &oldPid, &newPid);
+	if (e < 0) ERR(e);
+	e = eduhtm_InitBucket(&newPid, FALSE);
+	if (e < 0) ERR(e);
+
+	meta->hdr.nBuckets++;
+	e = eduhtm_SetBucket(catObjForFile, meta, newNo, &newPid);
+	if (e < 0) ERR(e);
+
+	/* Copy out the entries of the old bucket and empty its pages. */
+	bufSize = PAGESIZE;
+	bufLen = 0;
+	buf = (char*)malloc(bufSize);
+	if (buf == NULL) ERR(eMEMORYALLOCERR_BTM);
+
+	curPid = oldPid;
+	while (curPid.pageNo != NIL)
+	{
+		e = BfM_GetTrain(&curPid, &page, PAGE_BUF);
+		if (e < 0) { free(buf); ERR(e); }
+
+		if (bufLen + page->hdr.free > bufSize)
+		{
+			bufSize *= 2;
+			buf = (char*)realloc(buf, bufSize);
+			if (buf == NULL) ERRB1(eMEMORYALLOCERR_BTM, &curPid, PAGE_BUF);
+		}
+		memcpy(&buf[bufLen], page->data, page->hdr.free);
+		bufLen += page->hdr.free;
+
+		page->hdr.nEntries = 0;
+		page->hdr.free = 0;
+		MAKE_PAGEID(nextPid, curPid.volNo, page->hdr.nextPage);
+
+		e = BfM_SetDirty(&curPid, PAGE_BUF);
+		if (e < 0) { free(buf); ERRB1(e, &curPid, PAGE_BUF); }
+		e = BfM_FreeTrain(&curPid, PAGE_BUF);
+		if (e < 0) { free(buf); ERR(e); }
+
+		curPid = nextPid;
+	}
+
+	/* Redistribute the entries by the next bit of the hash value. */
+	for (offset = 0; offset < bufLen; offset += HTM_ENTRY_LEN(entry->klen))
+	{
+		entry = (htm_Entry*)&buf[offset];
+		memcpy(&oid, &entry->kval[ALIGNED_LENGTH(entry->klen)], sizeof(ObjectID));
+
+		if (entry->hash & (1U << meta->hdr.level))
+			e = eduhtm_AppendEntry(catObjForFile, &newPid, entry->hash, (KeyValue*)&entry->klen, &oid, &overflowed);
+		else
+			e = eduhtm_AppendEntry(catObjForFile, &oldPid, entry->hash, (KeyValue*)&entry->klen, &oid, &overflowed);
+		if (e < 0) { free(buf); ERR(e); }
+	}
+	free(buf);
+
+	/* Free the overflow pages which became empty. */
+	/* They are at the end of the chain since the entries are refilled in order. */
+	if (dlPool != NULL && dlHead != NULL)
+	{
+		prevPid = oldPid;
+		e = BfM_GetTrain(&prevPid, &page, PAGE_BUF);
+		if (e < 0) ERR(e);
+
+		while (page->hdr.nextPage != NIL)
+		{
+			MAKE_PAGEID(curPid, prevPid.volNo, page->hdr.nextPage);
+			e = BfM_GetTrain(&curPid, &npage, PAGE_BUF);
+			if (e < 0) ERRB1(e, &prevPid, PAGE_BUF);
+			nEntries = npage->hdr.nEntries;
+			e = BfM_FreeTrain(&curPid, PAGE_BUF);
+			if (e < 0) ERRB1(e, &prevPid, PAGE_BUF);
+
+			if (nEntries == 0)
+			{
+				page->hdr.nextPage = NIL;
+				e = BfM_SetDirty(&prevPid, PAGE_BUF);
+				if (e < 0) ERRB1(e, &prevPid, PAGE_BUF);
+
+				e = eduhtm_FreeChain(&curPid, dlPool, dlHead);
+				if (e < 0) ERRB1(e, &prevPid, PAGE_BUF);
+				break;
+			}
+
+			e = BfM_FreeTrain(&prevPid, PAGE_BUF);
+			if (e < 0) ERR(e);
+			prevPid = curPid;
+			e = BfM_GetTrain(&prevPid, &page, PAGE_BUF);
+			if (e < 0) ERR(e);
+		}
+
+		e = BfM_FreeTrain(&prevPid, PAGE_BUF);
+		if (e < 0) ERR(e);
+	}
+
+	/* Advance the split pointer. */
+	meta->hdr.next++;
+	if (meta->hdr.next == (1 << meta->hdr.level))
+	{
+		meta->hdr.level++;
+		meta->hdr.next = 0;
+	}
+
+	e = eduhtm_UpdateDirectory(meta, newNo, &newPid);
+	if (e < 0) ERR(e);
+
+	return(eNOERROR);
+
+} /* eduhtm_SplitBucket() */
@@ -0,0 +1,259 @@
+/******************************************************************************/
+/*                                                                            */
+/*    ODYSSEUS/EduCOSMOS Educational-Purpose Object Storage System            */
+/*                                                                            */
+/*    Developed by Professor Kyu-Young Whang et al.                           */
+/*                                                                            */
+/*    Database and Multimedia Laboratory                                      */
+/*                                                                            */
+/*    Computer Science Department and                                         */
+/*    Advanced Information Technology Research Center (AITrc)                 */
+/*    Korea Advanced Institute of Science and Technology (KAIST)              */
+/*                                                                            */
+/*    e-mail: kywhang@cs.kaist.ac.kr                                          */
+/*    phone: +82-42-350-7722                                                  */
+/*    fax: +82-42-350-8380                                                    */
+/*                                                                            */
+/*    Copyright (c) 1995-2013 by Kyu-Young Whang                              */
+/*                                                                            */
+/*    All rights reserved. No part of this software may be reproduced,        */
+/*    stored in a retrieval system, or transmitted, in any form or by any     */
+/*    means, electronic, mechanical, photocopying, recording, or otherwise,   */
+/*    without prior written permission of the copyright owner.                */
+/*                                                                            */
+/******************************************************************************/
+/*
+ * Module: edulsm_Buffer.c
+ *
+ * Description:
+ *  The write buffers of the LSM indexes. A write buffer collects the
+ *  insertions and deletions of an index in memory, sorted by (key, ObjectID),
+ *  until it is written as a new run. The buffers are found by the PageID of
+ *  the meta page of the index.
+ *
+ * Exports:
+ *  Four edulsm_GetBuffer(PageID*, Boolean, LsmBuffer**)
+ *  void edulsm_DiscardBuffer(PageID*)
+ *  void edulsm_PutBuffer(LsmBuffer*, KeyDesc*, lsm_Item*)
+ *  Boolean edulsm_SeekBuffer(LsmBuffer*, KeyDesc*, KeyValue*, ObjectID*, Four, lsm_Item*)
+ */
+
+
+#include <stdlib.h>
+#include <string.h>
+#include "EduBtM_common.h"
+#include "EduLsM_Internal.h"
+
+
+/* write buffers of the LSM indexes */
+static LsmBuffer edulsm_buffers[LSM_MAXOPENINDEXES];
+
+
+
+/*@================================
+ * edulsm_GetBuffer()
+ *================================*/
+/*
+ * Function: Four edulsm_GetBuffer(PageID*, Boolean, LsmBuffer**)
+ *
+ * Description:
+ *  Find the write buffer of the index given by 'root'. If the index has no
+ *  buffer and 'create' is TRUE, an unused buffer is assigned to the index.
+ *
+ * Returns:
+ *  Error code
+ *    eNOFREEWRITEBUFFER_BTM
+ *    eMEMORYALLOCERR_BTM
+ *
+ * Side effects:
+ *  1) parameter buf : the write buffer; NULL if not found and 'create' is FALSE
+ */
+Four edulsm_GetBuffer(
+    PageID      *root,          /* IN meta page of the LSM index */
+    Boolean     create,         /* IN create the buffer if not exist */
+    LsmBuffer   **buf)          /* OUT the write buffer */
+{
+    Four        i;              /* index of a buffer */
+    LsmBuffer   *freeBuf;       /* an unused buffer */
+
+
+	freeBuf = NULL;
+	for (i = 0; i < LSM_MAXOPENINDEXES; i++)
+	{
+		if (edulsm_buffers[i].item == NULL)
+		{
+			if (freeBuf == NULL) freeBuf = &edulsm_buffers[i];
+		}
+		else if (edulsm_buffers[i].root.volNo == root->volNo &&
+		         edulsm_buffers[i].root.pageNo == root->pageNo)
+		{
+			*buf = &edulsm_buffers[i];
+			return(eNOERROR);
+		}
+	}
+
+	*buf = NULL;
+	if (!create) return(eNOERROR);
+
+	if (freeBuf == NULL) ERR(eNOFREEWRITEBUFFER_BTM);
+
+	freeBuf->item = (lsm_Item*)malloc(sizeof(lsm_Item)*LSM_BUFFERENTRIES);
+	freeBuf->order = (lsm_Item**)malloc(sizeof(lsm_Item*)*LSM_BUFFERENTRIES);
+	if (freeBuf->item == NULL || freeBuf->order == NULL)
+	{
+		free(freeBuf->item);
+		free(freeBuf->order);
+		freeBuf->item = NULL;
+		freeBuf->order = NULL;
+		ERR(eMEMORYALLOCERR_BTM);
+	}
+
+	freeBuf->root = *root;
+	freeBuf->nItems = 0;
+	*buf = freeBuf;
+
+	return(eNOERROR);
+
+} /* edulsm_GetBuffer() */
+
+
+
+/*@================================
+ * edulsm_DiscardBuffer()
+ *================================*/
+/*
+ * Function: void edulsm_DiscardBuffer(PageID*)
+ *
+ * Description:
+ *  Release the write buffer of the index given by 'root' without writing it.
+ *
+ * Returns:
+ *  None
+ */
+void edulsm_DiscardBuffer(
+    PageID      *root)          /* IN meta page of the LSM index */
+{
+    Four        i;              /* index of a buffer */
+
+
+	for (i = 0; i < LSM_MAXOPENINDEXES; i++)
+	{
+		if (edulsm_buffers[i].item != NULL &&
+		    edulsm_buffers[i].root.volNo == root->volNo &&
+		    edulsm_buffers[i].root.pageNo == root->pageNo)
+		{
+			free(edulsm_buffers[i].item);
+			free(edulsm_buffers[i].order);
+			edulsm_buffers[i].item = NULL;
+			edulsm_buffers[i].order = NULL;
+			edulsm_buffers[i].nItems = 0;
+		}
+	}
+
+} /* edulsm_DiscardBuffer() */
+
+
+
+/*@================================
+ * edulsm_PutBuffer()
+ *================================*/
+/*
+ * Function: void edulsm_PutBuffer(LsmBuffer*, KeyDesc*, lsm_Item*)
+ *
+ * Description:
+ *  Put the item into the write buffer. If the buffer already has the pair
+ *  (key, ObjectID) of the item, the older operation is replaced.
+ *
+ * Returns:
+ *  None
+ *
+ * Note:
+ *  The caller should flush the buffer if it is full.
+ */
+void edulsm_PutBuffer(
+    LsmBuffer   *buf,           /* INOUT the write buffer */
+    KeyDesc     *kdesc,         /* IN key descriptor */
+    lsm_Item    *item)          /* IN item to be put */
+{
+    Four        low, high, mid; /* range of the binary search */
+    Four        cmp;            /* result of comparison */
+    lsm_Item    *newItem;       /* item in the slab */
+
+
+	/* Find the first position whose pair is not less than the item's. */
+	low = 0;
+	high = buf->nItems;
+	while (low < high)
+	{
+		mid = (low + high) / 2;
+		cmp = edulsm_Compare(kdesc, &buf->order[mid]->key, &buf->order[mid]->oid, &item->key, &item->oid);
+		if (cmp == LESS) low = mid + 1;
+		else high = mid;
+	}
+
+	if (low < buf->nItems &&
+	    edulsm_Compare(kdesc, &buf->order[low]->key, &buf->order[low]->oid, &item->key, &item->oid) == EQUAL)
+	{
+		buf->order[low]->nObjects = item->nObjects;
+		return;
+	}
+
+	newItem = &buf->item[buf->nItems];
+	newItem->oid = item->oid;
+	newItem->nObjects = item->nObjects;
+	newItem->key.len = item->key.len;
+	memcpy(newItem->key.val, item->key.val, item->key.len);
+
+	memmove(&buf->order[low+1], &buf->order[low], sizeof(lsm_Item*)*(buf->nItems - low));
+	buf->order[low] = newItem;
+	buf->nItems++;
+
+} /* edulsm_PutBuffer() */
+
+
+
+/*@================================
+ * edulsm_SeekBuffer()
+ *================================*/
+/*
+ * Function: Boolean edulsm_SeekBuffer(LsmBuffer*, KeyDesc*, KeyValue*, ObjectID*, Four, lsm_Item*)
+ *
+ * Description:
+ *  Find the first item of the write buffer satisfying the seek condition.
+ *
+ * Returns:
+ *  TRUE if such an item exists, FALSE otherwise
+ *
+ * Side effects:
+ *  1) parameter item : the found item
+ */
+Boolean edulsm_SeekBuffer(
+    LsmBuffer   *buf,           /* IN the write buffer */
+    KeyDesc     *kdesc,         /* IN key descriptor */
+    KeyValue    *kval,          /* IN key value of the seek */
+    ObjectID    *oid,           /* IN ObjectID of the seek */
+    Four        mode,           /* IN seek mode */
+    lsm_Item    *item)          /* OUT the found item */
+{
+    Four        low, high, mid; /* range of the binary search */
+
+
+	low = 0;
+	high = buf->nItems;
+	while (low < high)
+	{
+		mid = (low + high) / 2;
+		if (edulsm_Beyond(kdesc, &buf->order[mid]->key, &buf->order[mid]->oid, kval, oid, mode)) high = mid;
+		else low = mid + 1;
+	}
+
+	if (low == buf->nItems) return(FALSE);
+
+	item->oid = buf->order[low]->oid;
+	item->nObjects = buf->order[low]->nObjects;
+	item->key.len = buf->order[low]->key.len;
+	memcpy(item->key.val, buf->order[low]->key.val, item->key.len);
+
+	return(TRUE);
+
+} /* edulsm_SeekBuffer() */
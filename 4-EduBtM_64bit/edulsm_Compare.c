@@ -0,0 +1,116 @@
+/******************************************************************************/
+/*                                                                            */
+/*    ODYSSEUS/EduCOSMOS Educational-Purpose Object Storage System            */
+/*                                                                            */
+/*    Developed by Professor Kyu-Young Whang et al.                           */
+/*                                                                            */
+/*    Database and Multimedia Laboratory                                      */
+/*                                                                            */
+/*    Computer Science Department and                                         */
+/*    Advanced Information Technology Research Center (AITrc)                 */
+/*    Korea Advanced Institute of Science and Technology (KAIST)              */
+/*                                                                            */
+/*    e-mail: kywhang@cs.kaist.ac.kr                                          */
+/*    phone: +82-42-350-7722                                                  */
+/*    fax: +82-42-350-8380                                                    */
+/*                                                                            */
+/*    Copyright (c) 1995-2013 by Kyu-Young Whang                              */
+/*                                                                            */
+/*    All rights reserved. No part of this software may be reproduced,        */
+/*    stored in a retrieval system, or transmitted, in any form or by any     */
+/*    means, electronic, mechanical, photocopying, recording, or otherwise,   */
+/*    without prior written permission of the copyright owner.                */
+/*                                                                            */
+/******************************************************************************/
+/*
+ * Module: edulsm_Compare.c
+ *
+ * Description:
+ *  The entries of an LSM index are ordered by the pair (key, ObjectID) so
+ *  that the versions of a pair in the write buffer and in the runs can be
+ *  matched while merging.
+ *
+ * Exports:
+ *  Four edulsm_Compare(KeyDesc*, KeyValue*, ObjectID*, KeyValue*, ObjectID*)
+ *  Boolean edulsm_Beyond(KeyDesc*, KeyValue*, ObjectID*, KeyValue*, ObjectID*, Four)
+ */
+
+
+#include "EduBtM_common.h"
+#include "EduLsM_Internal.h"
+
+
+
+/*@================================
+ * edulsm_Compare()
+ *================================*/
+/*
+ * Function: Four edulsm_Compare(KeyDesc*, KeyValue*, ObjectID*, KeyValue*, ObjectID*)
+ *
+ * Description:
+ *  Compare the pair (key1, oid1) with the pair (key2, oid2). The keys are
+ *  compared by edubtm_KeyCompare() and the ObjectIDs are compared only if
+ *  the keys are equal.
+ *
+ * Returns:
+ *  Result of comparison
+ *    EQUAL : (key1, oid1) == (key2, oid2)
+ *    GREAT : (key1, oid1) >  (key2, oid2)
+ *    LESS  : (key1, oid1) <  (key2, oid2)
+ */
+Four edulsm_Compare(
+    KeyDesc     *kdesc,         /* IN key descriptor */
+    KeyValue    *key1,          /* IN the first key value */
+    ObjectID    *oid1,          /* IN the first ObjectID */
+    KeyValue    *key2,          /* IN the second key value */
+    ObjectID    *oid2)          /* IN the second ObjectID */
+{
+    Four        cmp;            /* result of comparison */
+
+
+	cmp = edubtm_KeyCompare(kdesc, key1, key2);
+	if (cmp != EQUAL) return(cmp);
+
+	return(btm_ObjectIdComp(oid1, oid2));
+
+} /* edulsm_Compare() */
+
+
+
+/*@================================
+ * edulsm_Beyond()
+ *================================*/
+/*
+ * Function: Boolean edulsm_Beyond(KeyDesc*, KeyValue*, ObjectID*, KeyValue*, ObjectID*, Four)
+ *
+ * Description:
+ *  Check whether the entry (key, keyOid) is located at or after the position
+ *  given by the seek mode. Because the result changes from FALSE to TRUE only once in a
+ *  sorted sequence, the first entry of the seek is found by binary search.
+ *
+ * Returns:
+ *  TRUE if the entry satisfies the seek condition, FALSE otherwise
+ */
+Boolean edulsm_Beyond(
+    KeyDesc     *kdesc,         /* IN key descriptor */
+    KeyValue    *key,           /* IN key value of the entry */
+    ObjectID    *keyOid,        /* IN ObjectID of the entry */
+    KeyValue    *kval,          /* IN key value of the seek */
+    ObjectID    *oid,           /* IN ObjectID of the seek; used by LSM_SEEK_AFTER */
+    Four        mode)           /* IN seek mode */
+{
+	switch (mode) {
+	  case LSM_SEEK_FIRST:
+		return(TRUE);
+
+	  case LSM_SEEK_GE:
+		return(edubtm_KeyCompare(kdesc, key, kval) != LESS);
+
+	  case LSM_SEEK_GT:
+		return(edubtm_KeyCompare(kdesc, key, kval) == GREAT);
+
+	  default: /* LSM_SEEK_AFTER */
+		return(edulsm_Compare(kdesc, key, keyOid, kval, oid) == GREAT);
+	}
+
+} /* edulsm_Beyond() */
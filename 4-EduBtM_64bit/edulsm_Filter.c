@@ -0,0 +1,143 @@
+/******************************************************************************/
+/*                                                                            */
+/*    ODYSSEUS/EduCOSMOS Educational-Purpose Object Storage System            */
+/*                                                                            */
+/*    Developed by Professor Kyu-Young Whang et al.                           */
+/*                                                                            */
+/*    Database and Multimedia Laboratory                                      */
+/*                                                                            */
+/*    Computer Science Department and                                         */
+/*    Advanced Information Technology Research Center (AITrc)                 */
+/*    Korea Advanced Institute of Science and Technology (KAIST)              */
+/*                                                                            */
+/*    e-mail: kywhang@cs.kaist.ac.kr                                          */
+/*    phone: +82-42-350-7722                                                  */
+/*    fax: +82-42-350-8380                                                    */
+/*                                                                            */
+/*    Copyright (c) 1995-2013 by Kyu-Young Whang                              */
+/*                                                                            */
+/*    All rights reserved. No part of this software may be reproduced,        */
+/*    stored in a retrieval system, or transmitted, in any form or by any     */
+/*    means, electronic, mechanical, photocopying, recording, or otherwise,   */
+/*    without prior written permission of the copyright owner.                */
+/*                                                                            */
+/******************************************************************************/
+/*
+ * Module: edulsm_Filter.c
+ *
+ * Description:
+ *  Every run of an LSM index has a Bloom filter on its keys in one page.
+ *  An equality search skips the runs whose filter says that the key is
+ *  not there, so a point lookup usually reads only the runs having the key.
+ *  The bits of a key are derived from eduhtm_Hash() by double hashing.
+ *
+ * Exports:
+ *  void edulsm_SetFilter(LsmFilter*, KeyDesc*, KeyValue*)
+ *  Four edulsm_MayContain(VolID, LsmRun*, KeyDesc*, KeyValue*, Boolean*)
+ */
+
+
+#include "EduBtM_common.h"
+#include "BfM.h"
+#include "EduLsM_Internal.h"
+#include "EduHtM_Internal.h"
+
+
+/* Macro: LF_BITNO(h1, h2, i)
+ * Description: return the i-th bit number of the key whose hash values are h1 and h2
+ */
+#define LF_BITNO(h1, h2, i)     (((h1) + (UFour)(i)*(h2)) % (UFour)LF_NBITS)
+
+
+
+/*@================================
+ * edulsm_SetFilter()
+ *================================*/
+/*
+ * Function: void edulsm_SetFilter(LsmFilter*, KeyDesc*, KeyValue*)
+ *
+ * Description:
+ *  Set the bits of the given key in the filter.
+ *
+ * Returns:
+ *  None
+ */
+void edulsm_SetFilter(
+    LsmFilter   *fpage,         /* INOUT the filter page */
+    KeyDesc     *kdesc,         /* IN key descriptor */
+    KeyValue    *kval)          /* IN key value */
+{
+    Four        i;              /* index of the hash function */
+    UFour       h1, h2;         /* hash values of the key */
+    UFour       bitNo;          /* a bit number */
+
+
+	h1 = eduhtm_Hash(kdesc, kval);
+	h2 = ((h1 >> 16) | (h1 << 16)) | 1;
+
+	for (i = 0; i < LSM_NHASHES; i++)
+	{
+		bitNo = LF_BITNO(h1, h2, i);
+		fpage->bits[bitNo >> 3] |= (1 << (bitNo & 7));
+	}
+
+} /* edulsm_SetFilter() */
+
+
+
+/*@================================
+ * edulsm_MayContain()
+ *================================*/
+/*
+ * Function: Four edulsm_MayContain(VolID, LsmRun*, KeyDesc*, KeyValue*, Boolean*)
+ *
+ * Description:
+ *  Check the filter of the run for the given key.
+ *
+ * Returns:
+ *  Error code
+ *    some errors caused by function calls
+ *
+ * Side effects:
+ *  1) parameter result : FALSE if the run has no entry with the key;
+ *                        TRUE if the run may have the key
+ */
+Four edulsm_MayContain(
+    VolID       volNo,          /* IN volume of the index */
+    LsmRun      *run,           /* IN the run */
+    KeyDesc     *kdesc,         /* IN key descriptor */
+    KeyValue    *kval,          /* IN key value */
+    Boolean     *result)        /* OUT result of the check */
+{
+    Four        e;              /* error number */
+    Four        i;              /* index of the hash function */
+    UFour       h1, h2;         /* hash values of the key */
+    UFour       bitNo;          /* a bit number */
+    PageID      pid;            /* the filter page */
+    LsmFilter   *fpage;         /* buffer of the filter page */
+
+
+	MAKE_PAGEID(pid, volNo, run->filter);
+	e = BfM_GetTrain(&pid, &fpage, PAGE_BUF);
+	if (e < 0) ERR(e);
+
+	h1 = eduhtm_Hash(kdesc, kval);
+	h2 = ((h1 >> 16) | (h1 << 16)) | 1;
+
+	*result = TRUE;
+	for (i = 0; i < LSM_NHASHES; i++)
+	{
+		bitNo = LF_BITNO(h1, h2, i);
+		if (!(fpage->bits[bitNo >> 3] & (1 << (bitNo & 7))))
+		{
+			*result = FALSE;
+			break;
+		}
+	}
+
+	e = BfM_FreeTrain(&pid, PAGE_BUF);
+	if (e < 0) ERR(e);
+
+	return(eNOERROR);
+
+} /* edulsm_MayContain() */
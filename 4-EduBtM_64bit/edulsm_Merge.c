@@ -0,0 +1,311 @@
+/******************************************************************************/
+/*                                                                            */
+/*    ODYSSEUS/EduCOSMOS Educational-Purpose Object Storage System            */
+/*                                                                            */
+/*    Developed by Professor Kyu-Young Whang et al.                           */
+/*                                                                            */
+/*    Database and Multimedia Laboratory                                      */
+/*                                                                            */
+/*    Computer Science Department and                                         */
+/*    Advanced Information Technology Research Center (AITrc)                 */
+/*    Korea Advanced Institute of Science and Technology (KAIST)              */
+/*                                                                            */
+/*    e-mail: kywhang@cs.kaist.ac.kr                                          */
+/*    phone: +82-42-350-7722                                                  */
+/*    fax: +82-42-350-8380                                                    */
+/*                                                                            */
+/*    Copyright (c) 1995-2013 by Kyu-Young Whang                              */
+/*                                                                            */
+/*    All rights reserved. No part of this software may be reproduced,        */
+/*    stored in a retrieval system, or transmitted, in any form or by any     */
+/*    means, electronic, mechanical, photocopying, recording, or otherwise,   */
+/*    without prior written permission of the copyright owner.                */
+/*                                                                            */
+/******************************************************************************/
+/*
+ * Module: edulsm_Merge.c
+ *
+ * Description:
+ *  Merge the runs of an LSM index by size tiers. A flushed write buffer
+ *  becomes a run of tier 0; when a tier has LSM_TIERFANOUT runs, they are
+ *  merged into one run of the next tier. So an entry is rewritten once per
+ *  tier and the number of runs grows with the logarithm of the index size.
+ *
+ * Exports:
+ *  Four edulsm_MergeRuns(ObjectID*, LsmMeta*, KeyDesc*, Pool*, DeallocListElem*)
+ */
+
+
+#include <string.h>
+#include "EduBtM_common.h"
+#include "BfM.h"
+#include "EduLsM_Internal.h"
+
+
+/*@ Internal Function Prototypes */
+Four edulsm_MergeGroup(ObjectID*, LsmMeta*, Two, Two, KeyDesc*, Pool*, DeallocListElem*);
+Four edulsm_OpenScan(VolID, LsmRun*, lsm_RunScan*, lsm_Item*);
+Four edulsm_AdvanceScan(lsm_RunScan*, lsm_Item*);
+
+
+
+/*@================================
+ * edulsm_MergeRuns()
+ *================================*/
+/*
+ * Function: Four edulsm_MergeRuns(ObjectID*, LsmMeta*, KeyDesc*, Pool*, DeallocListElem*)
+ *
+ * Description:
+ *  Merge the runs of the tiers which have LSM_TIERFANOUT runs until no
+ *  tier has. The runs are kept from the newest, and a run is never newer
+ *  than a run of a lower tier, so the runs of a tier are adjacent.
+ *
+ * Returns:
+ *  Error code
+ *    some errors caused by function calls
+ *
+ * Note:
+ *  The caller should call BfM_SetDirty() for the meta page.
+ */
+Four edulsm_MergeRuns(
+    ObjectID        *catObjForFile, /* IN catalog object of the index file */
+    LsmMeta         *meta,          /* INOUT the meta page */
+    KeyDesc         *kdesc,         /* IN key descriptor */
+    Pool            *dlPool,        /* INOUT pool of dealloc list elements */
+    DeallocListElem *dlHead)        /* INOUT head of the dealloc list */
+{
+    Four            e;              /* error number */
+    Two             i, j;           /* range of the runs of a tier */
+    Boolean         merged;         /* TRUE if a tier was merged */
+
+
+	do {
+		merged = FALSE;
+
+		for (i = 0; i < meta->hdr.nRuns; i = j)
+		{
+			for (j = i; j < meta->hdr.nRuns && meta->run[j].tier == meta->run[i].tier; j++);
+
+			if (j - i >= LSM_TIERFANOUT)
+			{
+				e = edulsm_MergeGroup(catObjForFile, meta, i, j - i, kdesc, dlPool, dlHead);
+				if (e < 0) ERR(e);
+
+				merged = TRUE;
+				break;
+			}
+		}
+	} while (merged);
+
+	return(eNOERROR);
+
+} /* edulsm_MergeRuns() */
+
+
+
+/*@================================
+ * edulsm_MergeGroup()
+ *================================*/
+/*
+ * Function: Four edulsm_MergeGroup(ObjectID*, LsmMeta*, Two, Two, KeyDesc*, Pool*, DeallocListElem*)
+ *
+ * Description:
+ *  Merge the 'n' runs starting from 'first' into a new run of the next
+ *  tier. If a pair (key, ObjectID) is in several runs, the entry of the
+ *  newest run survives. The deletion entries are dropped when the oldest
+ *  run of the index takes part in the merge, since there is no older entry
+ *  left for them to hide.
+ *
+ * Returns:
+ *  Error code
+ *    some errors caused by function calls
+ */
+Four edulsm_MergeGroup(
+    ObjectID        *catObjForFile, /* IN catalog object of the index file */
+    LsmMeta         *meta,          /* INOUT the meta page */
+    Two             first,          /* IN the first (newest) run to be merged */
+    Two             n,              /* IN # of runs to be merged */
+    KeyDesc         *kdesc,         /* IN key descriptor */
+    Pool            *dlPool,        /* INOUT pool of dealloc list elements */
+    DeallocListElem *dlHead)        /* INOUT head of the dealloc list */
+{
+    Four            e;              /* error number */
+    Two             i;              /* index of a run */
+    Two             minIdx;         /* run having the smallest current entry */
+    Boolean         dropDeletes;    /* TRUE if the deletion entries are dropped */
+    VolID           volNo;          /* volume of the index */
+    lsm_RunBuilder  b;              /* state of building the new run */
+    LsmRun          newRun;         /* the merged run */
+    lsm_RunScan     scan[LSM_MAXRUNS];  /* scans of the merged runs */
+    lsm_Item        cur[LSM_MAXRUNS];   /* current entries of the scans */
+
+
+	volNo = meta->hdr.pid.volNo;
+	dropDeletes = (first + n == meta->hdr.nRuns);
+
+	for (i = 0; i < n; i++)
+	{
+		e = edulsm_OpenScan(volNo, &meta->run[first+i], &scan[i], &cur[i]);
+		if (e < 0) ERR(e);
+	}
+
+	e = edulsm_BeginRun(catObjForFile, &meta->hdr.pid, &b);
+	if (e < 0) ERR(e);
+
+	for (;;)
+	{
+		/* The newer run wins the tie because only a smaller entry replaces it. */
+		minIdx = -1;
+		for (i = 0; i < n; i++)
+		{
+			if (scan[i].leaf.pageNo == NIL) continue;
+			if (minIdx < 0 ||
+			    edulsm_Compare(kdesc, &cur[i].key, &cur[i].oid, &cur[minIdx].key, &cur[minIdx].oid) == LESS)
+				minIdx = i;
+		}
+		if (minIdx < 0) break;
+
+		if (!(dropDeletes && cur[minIdx].nObjects == LSM_DELETE))
+		{
+			e = edulsm_AppendRun(&b, kdesc, &cur[minIdx]);
+			if (e < 0) ERR(e);
+		}
+
+		/* Skip the older versions of the pair. */
+		for (i = minIdx + 1; i < n; i++)
+		{
+			if (scan[i].leaf.pageNo == NIL) continue;
+			if (edulsm_Compare(kdesc, &cur[i].key, &cur[i].oid, &cur[minIdx].key, &cur[minIdx].oid) == EQUAL)
+			{
+				e = edulsm_AdvanceScan(&scan[i], &cur[i]);
+				if (e < 0) ERR(e);
+			}
+		}
+
+		e = edulsm_AdvanceScan(&scan[minIdx], &cur[minIdx]);
+		if (e < 0) ERR(e);
+	}
+
+	e = edulsm_EndRun(&b, &newRun);
+	if (e < 0) ERR(e);
+	newRun.tier = meta->run[first].tier + 1;
+
+	for (i = 0; i < n; i++)
+	{
+		e = edulsm_FreeRun(volNo, &meta->run[first+i], dlPool, dlHead);
+		if (e < 0) ERR(e);
+	}
+
+	/* Replace the merged runs by the new run; an empty run is dropped. */
+	if (newRun.nEntries > 0)
+	{
+		meta->run[first] = newRun;
+		first++;
+		n--;
+	}
+	else
+	{
+		e = edulsm_FreeRun(volNo, &newRun, dlPool, dlHead);
+		if (e < 0) ERR(e);
+	}
+
+	memmove(&meta->run[first], &meta->run[first+n], sizeof(LsmRun)*(meta->hdr.nRuns - first - n));
+	meta->hdr.nRuns -= n;
+
+	return(eNOERROR);
+
+} /* edulsm_MergeGroup() */
+
+
+
+/*@================================
+ * edulsm_OpenScan()
+ *================================*/
+/*
+ * Function: Four edulsm_OpenScan(VolID, LsmRun*, lsm_RunScan*, lsm_Item*)
+ *
+ * Description:
+ *  Start scanning the leaves of the run from its first entry. The current
+ *  leaf stays fixed in the buffer until the scan moves to the next leaf.
+ *
+ * Returns:
+ *  Error code
+ *    some errors caused by function calls
+ *
+ * Side effects:
+ *  1) parameter item : the first entry of the run
+ */
+Four edulsm_OpenScan(
+    VolID           volNo,          /* IN volume of the index */
+    LsmRun          *run,           /* IN the run to be scanned */
+    lsm_RunScan     *scan,          /* OUT state of the scan */
+    lsm_Item        *item)          /* OUT the current entry */
+{
+    Four            e;              /* error number */
+
+
+	MAKE_PAGEID(scan->leaf, volNo, run->firstLeaf);
+	e = BfM_GetTrain(&scan->leaf, &scan->page, PAGE_BUF);
+	if (e < 0) ERR(e);
+
+	scan->slotNo = -1;
+	e = edulsm_AdvanceScan(scan, item);
+	if (e < 0) ERR(e);
+
+	return(eNOERROR);
+
+} /* edulsm_OpenScan() */
+
+
+
+/*@================================
+ * edulsm_AdvanceScan()
+ *================================*/
+/*
+ * Function: Four edulsm_AdvanceScan(lsm_RunScan*, lsm_Item*)
+ *
+ * Description:
+ *  Move the scan to the next entry. When the scan passes the last entry,
+ *  the leaf is unfixed and the pageNo of 'leaf' becomes NIL.
+ *
+ * Returns:
+ *  Error code
+ *    some errors caused by function calls
+ *
+ * Side effects:
+ *  1) parameter item : the current entry
+ */
+Four edulsm_AdvanceScan(
+    lsm_RunScan     *scan,          /* INOUT state of the scan */
+    lsm_Item        *item)          /* OUT the current entry */
+{
+    Four            e;              /* error number */
+    ShortPageID     nextPage;       /* the next leaf */
+    btm_LeafEntry   *entry;         /* the current entry */
+
+
+	scan->slotNo++;
+
+	while (scan->slotNo >= scan->page->hdr.nSlots)
+	{
+		nextPage = scan->page->hdr.nextPage;
+		e = BfM_FreeTrain(&scan->leaf, PAGE_BUF);
+		if (e < 0) ERR(e);
+
+		scan->leaf.pageNo = nextPage;
+		if (nextPage == NIL) return(eNOERROR);
+
+		e = BfM_GetTrain(&scan->leaf, &scan->page, PAGE_BUF);
+		if (e < 0) ERR(e);
+		scan->slotNo = 0;
+	}
+
+	entry = (btm_LeafEntry*)&scan->page->data[scan->page->slot[-scan->slotNo]];
+	item->nObjects = entry->nObjects;
+	item->key.len = entry->klen;
+	memcpy(item->key.val, entry->kval, entry->klen);
+	memcpy(&item->oid, &entry->kval[ALIGNED_LENGTH(entry->klen)], sizeof(ObjectID));
+
+	return(eNOERROR);
+
+} /* edulsm_AdvanceScan() */
@@ -0,0 +1,593 @@
+/******************************************************************************/
+/*                                                                            */
+/*    ODYSSEUS/EduCOSMOS Educational-Purpose Object Storage System            */
+/*                                                                            */
+/*    Developed by Professor Kyu-Young Whang et al.                           */
+/*                                                                            */
+/*    Database and Multimedia Laboratory                                      */
+/*                                                                            */
+/*    Computer Science Department and                                         */
+/*    Advanced Information Technology Research Center (AITrc)                 */
+/*    Korea Advanced Institute of Science and Technology (KAIST)              */
+/*                                                                            */
+/*    e-mail: kywhang@cs.kaist.ac.kr                                          */
+/*    phone: +82-42-350-7722                                                  */
+/*    fax: +82-42-350-8380                                                    */
+/*                                                                            */
+/*    Copyright (c) 1995-2013 by Kyu-Young Whang                              */
+/*                                                                            */
+/*    All rights reserved. No part of this software may be reproduced,        */
+/*    stored in a retrieval system, or transmitted, in any form or by any     */
+/*    means, electronic, mechanical, photocopying, recording, or otherwise,   */
+/*    without prior written permission of the copyright owner.                */
+/*                                                                            */
+/******************************************************************************/
+/*
+ * Module: edulsm_Run.c
+ *
+ * Description:
+ *  This file has the functions which build, search and free the immutable
+ *  sorted runs of an LSM index. A run is built bottom-up from a stream of
+ *  entries sorted by (key, ObjectID): every leaf and fence page is filled
+ *  up before the next one is allocated, so a run needs no splits and has no
+ *  free space but the tail of the last page of each level.
+ *
+ * Exports:
+ *  Four edulsm_BeginRun(ObjectID*, PageID*, lsm_RunBuilder*)
+ *  Four edulsm_AppendRun(lsm_RunBuilder*, KeyDesc*, lsm_Item*)
+ *  Four edulsm_EndRun(lsm_RunBuilder*, LsmRun*)
+ *  Four edulsm_SeekRun(VolID, LsmRun*, KeyDesc*, KeyValue*, ObjectID*, Four, lsm_Item*, Boolean*)
+ *  Four edulsm_FreeRun(VolID, LsmRun*, Pool*, DeallocListElem*)
+ */
+
+
+#include <string.h>
+#include "EduBtM_common.h"
+#include "BfM.h"
+#include "EduLsM_Internal.h"
+#include "EduHtM_Internal.h"
+
+
+/*@ Internal Function Prototypes */
+Four edulsm_NewPage(lsm_RunBuilder*, Two, PageID*, BtreePage**);
+Four edulsm_PushFence(lsm_RunBuilder*, Two, KeyValue*, PageID*);
+Four edulsm_FreeTree(PageID*, Two, Pool*, DeallocListElem*);
+
+
+
+/*@================================
+ * edulsm_BeginRun()
+ *================================*/
+/*
+ * Function: Four edulsm_BeginRun(ObjectID*, PageID*, lsm_RunBuilder*)
+ *
+ * Description:
+ *  Start building a new run. The filter page of the run is allocated and
+ *  cleared; the leaves and fence pages are allocated as the entries come.
+ *
+ * Returns:
+ *  Error code
+ *    some errors caused by function calls
+ */
+Four edulsm_BeginRun(
+    ObjectID        *catObjForFile, /* IN catalog object of the index file */
+    PageID          *near,          /* IN pages are allocated near this page */
+    lsm_RunBuilder  *b)             /* OUT state of the building */
+{
+    Four            e;              /* error number */
+
+
+	b->catObj = catObjForFile;
+	b->near = *near;
+	b->height = 0;
+	b->nEntries = 0;
+	b->nPages = 0;
+
+	e = btm_AllocPage(catObjForFile, near, &b->filter);
+	if (e < 0) ERR(e);
+
+	e = BfM_GetNewTrain(&b->filter, &b->fpage, PAGE_BUF);
+	if (e < 0) ERR(e);
+
+	MAKE_PAGEID(b->fpage->hdr.pid, b->filter.volNo, b->filter.pageNo);
+	SET_PAGE_TYPE(b->fpage, BTREE_PAGE_TYPE);
+	b->fpage->hdr.type = LSM | OVERFLOW;
+	memset(b->fpage->bits, 0, sizeof(b->fpage->bits));
+
+	return(eNOERROR);
+
+} /* edulsm_BeginRun() */
+
+
+
+/*@================================
+ * edulsm_NewPage()
+ *================================*/
+/*
+ * Function: Four edulsm_NewPage(lsm_RunBuilder*, Two, PageID*, BtreePage**)
+ *
+ * Description:
+ *  Allocate and initialize a page of the given level of the run; level 0
+ *  is the leaf level. The page is fixed in the buffer on return.
+ *
+ * Returns:
+ *  Error code
+ *    some errors caused by function calls
+ */
+Four edulsm_NewPage(
+    lsm_RunBuilder  *b,             /* INOUT state of the building */
+    Two             level,          /* IN level of the page */
+    PageID          *pid,           /* OUT the new page */
+    BtreePage       **apage)        /* OUT buffer of the new page */
+{
+    Four            e;              /* error number */
+
+
+	e = btm_AllocPage(b->catObj, &b->near, pid);
+	if (e < 0) ERR(e);
+
+	e = BfM_GetNewTrain(pid, apage, PAGE_BUF);
+	if (e < 0) ERR(e);
+
+	MAKE_PAGEID((*apage)->any.hdr.pid, pid->volNo, pid->pageNo);
+	SET_PAGE_TYPE(*apage, BTREE_PAGE_TYPE);
+
+	if (level == 0)
+	{
+		(*apage)->bl.hdr.type = LSM | LEAF;
+		(*apage)->bl.hdr.nSlots = 0;
+		(*apage)->bl.hdr.free = 0;
+		(*apage)->bl.hdr.prevPage = NIL;
+		(*apage)->bl.hdr.nextPage = NIL;
+		(*apage)->bl.hdr.unused = 0;
+	}
+	else
+	{
+		(*apage)->bi.hdr.type = LSM | INTERNAL;
+		(*apage)->bi.hdr.p0 = NIL;
+		(*apage)->bi.hdr.nSlots = 0;
+		(*apage)->bi.hdr.free = 0;
+		(*apage)->bi.hdr.unused = 0;
+	}
+
+	b->nPages++;
+
+	return(eNOERROR);
+
+} /* edulsm_NewPage() */
+
+
+
+/*@================================
+ * edulsm_AppendRun()
+ *================================*/
+/*
+ * Function: Four edulsm_AppendRun(lsm_RunBuilder*, KeyDesc*, lsm_Item*)
+ *
+ * Description:
+ *  Append an entry to the run being built. The entries should be appended
+ *  in the ascending order of (key, ObjectID). If the current leaf is full,
+ *  a new leaf is chained after it and its first key is pushed up to the
+ *  fence page of the level above.
+ *
+ * Returns:
+ *  Error code
+ *    some errors caused by function calls
+ */
+Four edulsm_AppendRun(
+    lsm_RunBuilder  *b,             /* INOUT state of the building */
+    KeyDesc         *kdesc,         /* IN key descriptor */
+    lsm_Item        *item)          /* IN entry to be appended */
+{
+    Four            e;              /* error number */
+    Two             alignedKlen;    /* aligned length of the key length */
+    Two             entryLen;       /* length of the entry */
+    PageID          newPid;         /* a new leaf */
+    BtreePage       *npage;         /* buffer of the new leaf */
+    BtreeLeaf       *page;          /* the current leaf */
+    btm_LeafEntry   *entry;         /* the appended entry */
+
+
+	alignedKlen = ALIGNED_LENGTH(item->key.len);
+	entryLen = 2*sizeof(Two) + alignedKlen + sizeof(ObjectID);
+
+	if (b->height == 0)
+	{
+		e = edulsm_NewPage(b, 0, &b->page[0], &b->apage[0]);
+		if (e < 0) ERR(e);
+
+		b->first[0] = b->page[0];
+		b->height = 1;
+	}
+	else if (BL_CFREE(&b->apage[0]->bl) < entryLen + sizeof(Two))
+	{
+		e = edulsm_NewPage(b, 0, &newPid, &npage);
+		if (e < 0) ERR(e);
+
+		b->apage[0]->bl.hdr.nextPage = newPid.pageNo;
+		npage->bl.hdr.prevPage = b->page[0].pageNo;
+
+		e = BfM_SetDirty(&b->page[0], PAGE_BUF);
+		if (e < 0) ERRB1(e, &b->page[0], PAGE_BUF);
+		e = BfM_FreeTrain(&b->page[0], PAGE_BUF);
+		if (e < 0) ERR(e);
+
+		b->page[0] = newPid;
+		b->apage[0] = npage;
+
+		e = edulsm_PushFence(b, 1, &item->key, &newPid);
+		if (e < 0) ERR(e);
+	}
+
+	page = &b->apage[0]->bl;
+	entry = (btm_LeafEntry*)&page->data[page->hdr.free];
+	entry->nObjects = item->nObjects;
+	entry->klen = item->key.len;
+	memcpy(entry->kval, item->key.val, item->key.len);
+	memcpy(entry->kval + alignedKlen, &item->oid, sizeof(ObjectID));
+
+	page->slot[-page->hdr.nSlots] = page->hdr.free;
+	page->hdr.free += entryLen;
+	page->hdr.nSlots++;
+
+	edulsm_SetFilter(b->fpage, kdesc, &item->key);
+	b->nEntries++;
+
+	return(eNOERROR);
+
+} /* edulsm_AppendRun() */
+
+
+
+/*@================================
+ * edulsm_PushFence()
+ *================================*/
+/*
+ * Function: Four edulsm_PushFence(lsm_RunBuilder*, Two, KeyValue*, PageID*)
+ *
+ * Description:
+ *  Append the fence entry (kval, child) to the current page of the given
+ *  level. The level is created when its lower level gets the second page;
+ *  the first page of the lower level becomes 'p0'. If the current page is
+ *  full, a new page starting with 'child' as 'p0' is allocated and pushed
+ *  up to the next level.
+ *
+ * Returns:
+ *  Error code
+ *    eEXCEEDMAXDEPTHOFBTREE_BTM
+ *    some errors caused by function calls
+ */
+Four edulsm_PushFence(
+    lsm_RunBuilder  *b,             /* INOUT state of the building */
+    Two             level,          /* IN level of the fence page */
+    KeyValue        *kval,          /* IN the first key of 'child' */
+    PageID          *child)         /* IN the child page */
+{
+    Four            e;              /* error number */
+    Two             alignedKlen;    /* aligned length of the key length */
+    Two             entryLen;       /* length of the entry */
+    PageID          newPid;         /* a new fence page */
+    BtreePage       *npage;         /* buffer of the new fence page */
+    BtreeInternal   *page;          /* the current fence page */
+    btm_InternalEntry *entry;       /* the appended entry */
+
+
+	alignedKlen = ALIGNED_LENGTH(kval->len);
+	entryLen = sizeof(ShortPageID) + sizeof(Two) + alignedKlen;
+
+	if (level == b->height)
+	{
+		if (level == LSM_MAXHEIGHT) ERR(eEXCEEDMAXDEPTHOFBTREE_BTM);
+
+		e = edulsm_NewPage(b, level, &b->page[level], &b->apage[level]);
+		if (e < 0) ERR(e);
+
+		b->apage[level]->bi.hdr.p0 = b->first[level-1].pageNo;
+		b->first[level] = b->page[level];
+		b->height++;
+	}
+	else if (BI_CFREE(&b->apage[level]->bi) < entryLen + sizeof(Two))
+	{
+		e = edulsm_NewPage(b, level, &newPid, &npage);
+		if (e < 0) ERR(e);
+
+		npage->bi.hdr.p0 = child->pageNo;
+
+		e = BfM_SetDirty(&b->page[level], PAGE_BUF);
+		if (e < 0) ERRB1(e, &b->page[level], PAGE_BUF);
+		e = BfM_FreeTrain(&b->page[level], PAGE_BUF);
+		if (e < 0) ERR(e);
+
+		b->page[level] = newPid;
+		b->apage[level] = npage;
+
+		e = edulsm_PushFence(b, level+1, kval, &newPid);
+		if (e < 0) ERR(e);
+
+		return(eNOERROR);
+	}
+
+	page = &b->apage[level]->bi;
+	entry = (btm_InternalEntry*)&page->data[page->hdr.free];
+	entry->spid = child->pageNo;
+	entry->klen = kval->len;
+	memcpy(entry->kval, kval->val, kval->len);
+
+	page->slot[-page->hdr.nSlots] = page->hdr.free;
+	page->hdr.free += entryLen;
+	page->hdr.nSlots++;
+
+	return(eNOERROR);
+
+} /* edulsm_PushFence() */
+
+
+
+/*@================================
+ * edulsm_EndRun()
+ *================================*/
+/*
+ * Function: Four edulsm_EndRun(lsm_RunBuilder*, LsmRun*)
+ *
+ * Description:
+ *  Finish building the run. The current pages of all levels and the filter
+ *  page are written; the only page of the top level is the root of the run.
+ *
+ * Returns:
+ *  Error code
+ *    some errors caused by function calls
+ *
+ * Side effects:
+ *  1) parameter run : descriptor of the built run; its tier is 0
+ */
+Four edulsm_EndRun(
+    lsm_RunBuilder  *b,             /* INOUT state of the building */
+    LsmRun          *run)           /* OUT the built run */
+{
+    Four            e;              /* error number */
+    Two             level;          /* a level of the run */
+
+
+	/* An empty run still has a leaf so that it can be searched. */
+	if (b->height == 0)
+	{
+		e = edulsm_NewPage(b, 0, &b->page[0], &b->apage[0]);
+		if (e < 0) ERR(e);
+
+		b->first[0] = b->page[0];
+		b->height = 1;
+	}
+
+	for (level = 0; level < b->height; level++)
+	{
+		e = BfM_SetDirty(&b->page[level], PAGE_BUF);
+		if (e < 0) ERRB1(e, &b->page[level], PAGE_BUF);
+		e = BfM_FreeTrain(&b->page[level], PAGE_BUF);
+		if (e < 0) ERR(e);
+	}
+
+	e = BfM_SetDirty(&b->filter, PAGE_BUF);
+	if (e < 0) ERRB1(e, &b->filter, PAGE_BUF);
+	e = BfM_FreeTrain(&b->filter, PAGE_BUF);
+	if (e < 0) ERR(e);
+
+	run->root = b->page[b->height-1].pageNo;
+	run->firstLeaf = b->first[0].pageNo;
+	run->filter = b->filter.pageNo;
+	run->height = b->height;
+	run->tier = 0;
+	run->nEntries = b->nEntries;
+	run->nPages = b->nPages;
+
+	return(eNOERROR);
+
+} /* edulsm_EndRun() */
+
+
+
+/*@================================
+ * edulsm_SeekRun()
+ *================================*/
+/*
+ * Function: Four edulsm_SeekRun(VolID, LsmRun*, KeyDesc*, KeyValue*, ObjectID*,
+ *                               Four, lsm_Item*, Boolean*)
+ *
+ * Description:
+ *  Find the first entry of the run satisfying the seek condition. In each
+ *  fence page we follow the last child whose fence key is less than 'kval',
+ *  because the entries having the key 'kval' may start in that child. The
+ *  search goes on to the next leaves if the leaf has no such entry.
+ *
+ * Returns:
+ *  Error code
+ *    some errors caused by function calls
+ *
+ * Side effects:
+ *  1) parameter item  : the found entry
+ *  2) parameter found : TRUE if such an entry exists
+ */
+Four edulsm_SeekRun(
+    VolID           volNo,          /* IN volume of the index */
+    LsmRun          *run,           /* IN the run */
+    KeyDesc         *kdesc,         /* IN key descriptor */
+    KeyValue        *kval,          /* IN key value of the seek */
+    ObjectID        *oid,           /* IN ObjectID of the seek */
+    Four            mode,           /* IN seek mode */
+    lsm_Item        *item,          /* OUT the found entry */
+    Boolean         *found)         /* OUT TRUE if found */
+{
+    Four            e;              /* error number */
+    Two             level;          /* level of the current page */
+    Two             low, high, mid; /* range of the binary search */
+    PageID          pid;            /* the current page */
+    ShortPageID     child;          /* the child page to be followed */
+    BtreePage       *apage;         /* buffer of the current page */
+    btm_InternalEntry *iEntry;      /* an internal entry */
+    btm_LeafEntry   *lEntry;        /* a leaf entry */
+    ObjectID        tOid;           /* ObjectID of a leaf entry */
+
+
+	*found = FALSE;
+	MAKE_PAGEID(pid, volNo, run->root);
+
+	for (level = run->height - 1; level > 0; level--)
+	{
+		e = BfM_GetTrain(&pid, &apage, PAGE_BUF);
+		if (e < 0) ERR(e);
+
+		/* Find the first fence entry whose key is not less than 'kval'. */
+		low = 0;
+		high = (mode == LSM_SEEK_FIRST) ? 0 : apage->bi.hdr.nSlots;
+		while (low < high)
+		{
+			mid = (low + high) / 2;
+			iEntry = (btm_InternalEntry*)&apage->bi.data[apage->bi.slot[-mid]];
+			if (edubtm_KeyCompare(kdesc, (KeyValue*)&iEntry->klen, kval) == LESS) low = mid + 1;
+			else high = mid;
+		}
+
+		if (low == 0)
+			child = apage->bi.hdr.p0;
+		else
+			child = ((btm_InternalEntry*)&apage->bi.data[apage->bi.slot[-(low-1)]])->spid;
+
+		e = BfM_FreeTrain(&pid, PAGE_BUF);
+		if (e < 0) ERR(e);
+
+		MAKE_PAGEID(pid, volNo, child);
+	}
+
+	while (pid.pageNo != NIL)
+	{
+		e = BfM_GetTrain(&pid, &apage, PAGE_BUF);
+		if (e < 0) ERR(e);
+
+		low = 0;
+		high = apage->bl.hdr.nSlots;
+		while (low < high)
+		{
+			mid = (low + high) / 2;
+			lEntry = (btm_LeafEntry*)&apage->bl.data[apage->bl.slot[-mid]];
+			memcpy(&tOid, &lEntry->kval[ALIGNED_LENGTH(lEntry->klen)], sizeof(ObjectID));
+			if (edulsm_Beyond(kdesc, (KeyValue*)&lEntry->klen, &tOid, kval, oid, mode)) high = mid;
+			else low = mid + 1;
+		}
+
+		if (low < apage->bl.hdr.nSlots)
+		{
+			lEntry = (btm_LeafEntry*)&apage->bl.data[apage->bl.slot[-low]];
+			item->nObjects = lEntry->nObjects;
+			item->key.len = lEntry->klen;
+			memcpy(item->key.val, lEntry->kval, lEntry->klen);
+			memcpy(&item->oid, &lEntry->kval[ALIGNED_LENGTH(lEntry->klen)], sizeof(ObjectID));
+			*found = TRUE;
+
+			e = BfM_FreeTrain(&pid, PAGE_BUF);
+			if (e < 0) ERR(e);
+
+			return(eNOERROR);
+		}
+
+		child = apage->bl.hdr.nextPage;
+		e = BfM_FreeTrain(&pid, PAGE_BUF);
+		if (e < 0) ERR(e);
+
+		MAKE_PAGEID(pid, volNo, child);
+	}
+
+	return(eNOERROR);
+
+} /* edulsm_SeekRun() */
+
+
+
+/*@================================
+ * edulsm_FreeRun()
+ *================================*/
+/*
+ * Function: Four edulsm_FreeRun(VolID, LsmRun*, Pool*, DeallocListElem*)
+ *
+ * Description:
+ *  Put all pages of the run including its filter page into the dealloc list.
+ *
+ * Returns:
+ *  Error code
+ *    some errors caused by function calls
+ */
+Four edulsm_FreeRun(
+    VolID           volNo,          /* IN volume of the index */
+    LsmRun          *run,           /* IN the run to be freed */
+    Pool            *dlPool,        /* INOUT pool of dealloc list elements */
+    DeallocListElem *dlHead)        /* INOUT head of the dealloc list */
+{
+    Four            e;              /* error number */
+    PageID          pid;            /* a page of the run */
+
+
+	MAKE_PAGEID(pid, volNo, run->root);
+	e = edulsm_FreeTree(&pid, run->height, dlPool, dlHead);
+	if (e < 0) ERR(e);
+
+	MAKE_PAGEID(pid, volNo, run->filter);
+	e = eduhtm_FreePage(&pid, dlPool, dlHead);
+	if (e < 0) ERR(e);
+
+	return(eNOERROR);
+
+} /* edulsm_FreeRun() */
+
+
+
+/*@================================
+ * edulsm_FreeTree()
+ *================================*/
+/*
+ * Function: Four edulsm_FreeTree(PageID*, Two, Pool*, DeallocListElem*)
+ *
+ * Description:
+ *  Free the subtree of a run rooted at 'pid' recursively.
+ *
+ * Returns:
+ *  Error code
+ *    some errors caused by function calls
+ */
+Four edulsm_FreeTree(
+    PageID          *pid,           /* IN root of the subtree */
+    Two             height,         /* IN height of the subtree */
+    Pool            *dlPool,        /* INOUT pool of dealloc list elements */
+    DeallocListElem *dlHead)        /* INOUT head of the dealloc list */
+{
+    Four            e;              /* error number */
+    Two             i;              /* index of an entry */
+    PageID          child;          /* a child page */
+    BtreeInternal   *apage;         /* buffer of the fence page */
+    btm_InternalEntry *entry;       /* an internal entry */
+
+
+	if (height > 1)
+	{
+		e = BfM_GetTrain(pid, &apage, PAGE_BUF);
+		if (e < 0) ERR(e);
+
+		MAKE_PAGEID(child, pid->volNo, apage->hdr.p0);
+		e = edulsm_FreeTree(&child, height-1, dlPool, dlHead);
+		if (e < 0) ERRB1(e, pid, PAGE_BUF);
+
+		for (i = 0; i < apage->hdr.nSlots; i++)
+		{
+			entry = (btm_InternalEntry*)&apage->data[apage->slot[-i]];
+			MAKE_PAGEID(child, pid->volNo, entry->spid);
+			e = edulsm_FreeTree(&child, height-1, dlPool, dlHead);
+			if (e < 0) ERRB1(e, pid, PAGE_BUF);
+		}
+
+		e = BfM_FreeTrain(pid, PAGE_BUF);
+		if (e < 0) ERR(e);
+	}
+
+	e = eduhtm_FreePage(pid, dlPool, dlHead);
+	if (e < 0) ERR(e);
+
+	return(eNOERROR);
+
+} /* edulsm_FreeTree() */
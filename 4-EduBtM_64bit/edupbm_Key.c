@@ -0,0 +1,215 @@
+/******************************************************************************/
+/*                                                                            */
+/*    ODYSSEUS/EduCOSMOS Educational-Purpose Object Storage System            */
+/*                                                                            */
+/*    Developed by Professor Kyu-Young Whang et al.                           */
+/*                                                                            */
+/*    Database and Multimedia Laboratory                                      */
+/*                                                                            */
+/*    Computer Science Department and                                         */
+/*    Advanced Information Technology Research Center (AITrc)                 */
+/*    Korea Advanced Institute of Science and Technology (KAIST)              */
+/*                                                                            */
+/*    e-mail: kywhang@cs.kaist.ac.kr                                          */
+/*    phone: +82-42-350-7722                                                  */
+/*    fax: +82-42-350-8380                                                    */
+/*                                                                            */
+/*    Copyright (c) 1995-2013 by Kyu-Young Whang                              */
+/*                                                                            */
+/*    All rights reserved. No part of this software may be reproduced,        */
+/*    stored in a retrieval system, or transmitted, in any form or by any     */
+/*    means, electronic, mechanical, photocopying, recording, or otherwise,   */
+/*    without prior written permission of the copyright owner.                */
+/*                                                                            */
+/******************************************************************************/
+/*
+ * Module: edupbm_Key.c
+ *
+ * Description:
+ *  Keys of a partitioned B+ tree. The key of an entry in the B+ tree is
+ *  the partition number as an SM_INT part followed by the key value given
+ *  by the user, so the entries of a partition are together and ordered by
+ *  the user's key. The partition number is never seen by the user.
+ *
+ * Exports:
+ *  Four edupbm_KeyDesc(KeyDesc*, KeyDesc*)
+ *  Four edupbm_MakeKey(KeyDesc*, Four, KeyValue*, KeyValue*)
+ *  void edupbm_UserKey(KeyValue*, KeyValue*)
+ *  Four edupbm_KeyPartition(KeyValue*)
+ */
+
+
+#include <string.h>
+#include "EduBtM_common.h"
+#include "EduPbM_Internal.h"
+
+
+
+/*@================================
+ * edupbm_KeyDesc()
+ *================================*/
+/*
+ * Function: Four edupbm_KeyDesc(KeyDesc*, KeyDesc*)
+ *
+ * Description:
+ *  Make the key descriptor of the B+ tree from the user's one by putting
+ *  the partition number in front of the key parts. The B-epsilon mode
+ *  (KEYFLAG_BUFFERED) is not supported, since the partitions serve the
+ *  same purpose and the merges use EduBtM_DeleteRange().
+ *
+ * Returns:
+ *  error code
+ *    eBADPARAMETER_BTM
+ *    eNOTSUPPORTED_EDUBTM
+ */
+Four edupbm_KeyDesc(
+    KeyDesc             *kdesc,         /* IN the user's key descriptor */
+    KeyDesc             *pkdesc)        /* OUT key descriptor of the B+ tree */
+{
+    Two                 i;              /* index of a key part */
+
+
+    if (kdesc == NULL) ERR(eBADPARAMETER_BTM);
+
+	if (kdesc->nparts < 1 || kdesc->nparts >= MAXNUMKEYPARTS) ERR(eNOTSUPPORTED_EDUBTM);
+
+	if (kdesc->flag & KEYFLAG_BUFFERED) ERR(eNOTSUPPORTED_EDUBTM);
+
+    /* Error check whether using not supported functionality by EduBtM */
+    for(i=0; i<kdesc->nparts; i++)
+    {
+        if(kdesc->kpart[i].type!=SM_INT && kdesc->kpart[i].type!=SM_VARSTRING)
+            ERR(eNOTSUPPORTED_EDUBTM);
+    }
+
+	pkdesc->flag = kdesc->flag;
+	pkdesc->nparts = kdesc->nparts + 1;
+	pkdesc->kpart[0].type = SM_INT;
+	pkdesc->kpart[0].offset = 0;
+	pkdesc->kpart[0].length = PBM_PREFIXLEN;
+
+	for (i = 0; i < kdesc->nparts; i++)
+	{
+		pkdesc->kpart[i+1] = kdesc->kpart[i];
+		pkdesc->kpart[i+1].offset += PBM_PREFIXLEN;
+	}
+
+    return(eNOERROR);
+
+} /* edupbm_KeyDesc() */
+
+
+
+/*@================================
+ * edupbm_MakeKey()
+ *================================*/
+/*
+ * Function: Four edupbm_MakeKey(KeyDesc*, Four, KeyValue*, KeyValue*)
+ *
+ * Description:
+ *  Make the key of the B+ tree from the partition number and the user's
+ *  key value. If 'kval' is NULL, every part of the user's key gets its
+ *  smallest value, the smallest integer or the empty string; the key is
+ *  then not greater than any key of the partition and greater than all
+ *  the keys of the partitions before it.
+ *
+ * Returns:
+ *  error code
+ *    eBADPARAMETER_BTM
+ */
+Four edupbm_MakeKey(
+    KeyDesc             *kdesc,         /* IN the user's key descriptor */
+    Four                partition,      /* IN the partition number */
+    KeyValue            *kval,          /* IN the user's key value or NULL */
+    KeyValue            *pkval)         /* OUT key of the B+ tree */
+{
+    Two                 i;              /* index of a key part */
+    Two                 len;            /* string length */
+    Four_Invariable     p;              /* the partition number */
+    Four_Invariable     minInt;         /* the smallest integer */
+
+
+	p = partition;
+	memcpy(pkval->val, &p, PBM_PREFIXLEN);
+	pkval->len = PBM_PREFIXLEN;
+
+	if (kval != NULL)
+	{
+		if (kval->len < 0 || kval->len > MAXKEYLEN - PBM_PREFIXLEN) ERR(eBADPARAMETER_BTM);
+
+		memcpy(&pkval->val[PBM_PREFIXLEN], kval->val, kval->len);
+		pkval->len += kval->len;
+
+		return(eNOERROR);
+	}
+
+	minInt = (Four_Invariable)0x80000000;
+	for (i = 0; i < kdesc->nparts; i++)
+	{
+		if (kdesc->kpart[i].type == SM_INT)
+		{
+			memcpy(&pkval->val[pkval->len], &minInt, kdesc->kpart[i].length);
+			pkval->len += kdesc->kpart[i].length;
+		}
+		else
+		{
+			len = 1;
+			memcpy(&pkval->val[pkval->len], &len, sizeof(Two));
+			pkval->val[pkval->len + sizeof(Two)] = '\0';
+			pkval->len += sizeof(Two) + len;
+		}
+	}
+
+    return(eNOERROR);
+
+} /* edupbm_MakeKey() */
+
+
+
+/*@================================
+ * edupbm_UserKey()
+ *================================*/
+/*
+ * Function: void edupbm_UserKey(KeyValue*, KeyValue*)
+ *
+ * Description:
+ *  Take the user's key value from a key of the B+ tree.
+ *
+ * Returns:
+ *  None
+ */
+void edupbm_UserKey(
+    KeyValue            *pkval,         /* IN key of the B+ tree */
+    KeyValue            *kval)          /* OUT the user's key value */
+{
+
+	kval->len = pkval->len - PBM_PREFIXLEN;
+	memmove(kval->val, &pkval->val[PBM_PREFIXLEN], kval->len);
+
+} /* edupbm_UserKey() */
+
+
+
+/*@================================
+ * edupbm_KeyPartition()
+ *================================*/
+/*
+ * Function: Four edupbm_KeyPartition(KeyValue*)
+ *
+ * Description:
+ *  Take the partition number from a key of the B+ tree.
+ *
+ * Returns:
+ *  the partition number
+ */
+Four edupbm_KeyPartition(
+    KeyValue            *pkval)         /* IN key of the B+ tree */
+{
+    Four_Invariable     p;              /* the partition number */
+
+
+	memcpy(&p, pkval->val, PBM_PREFIXLEN);
+
+    return(p);
+
+} /* edupbm_KeyPartition() */
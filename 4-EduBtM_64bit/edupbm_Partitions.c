@@ -0,0 +1,259 @@
+/******************************************************************************/
+/*                                                                            */
+/*    ODYSSEUS/EduCOSMOS Educational-Purpose Object Storage System            */
+/*                                                                            */
+/*    Developed by Professor Kyu-Young Whang et al.                           */
+/*                                                                            */
+/*    Database and Multimedia Laboratory                                      */
+/*                                                                            */
+/*    Computer Science Department and                                         */
+/*    Advanced Information Technology Research Center (AITrc)                 */
+/*    Korea Advanced Institute of Science and Technology (KAIST)              */
+/*                                                                            */
+/*    e-mail: kywhang@cs.kaist.ac.kr                                          */
+/*    phone: +82-42-350-7722                                                  */
+/*    fax: +82-42-350-8380                                                    */
+/*                                                                            */
+/*    Copyright (c) 1995-2013 by Kyu-Young Whang                              */
+/*                                                                            */
+/*    All rights reserved. No part of this software may be reproduced,        */
+/*    stored in a retrieval system, or transmitted, in any form or by any     */
+/*    means, electronic, mechanical, photocopying, recording, or otherwise,   */
+/*    without prior written permission of the copyright owner.                */
+/*                                                                            */
+/******************************************************************************/
+/*
+ * Module: edupbm_Partitions.c
+ *
+ * Description:
+ *  The live partitions of the partitioned B+ trees. They are kept in memory
+ *  and found by the PageID of the root page of the index. When an index is
+ *  first used, its partitions are found by descending the B+ tree once per
+ *  partition: the first key at or after the smallest key of partition p+1
+ *  gives the partition following p.
+ *
+ * Exports:
+ *  Four edupbm_GetPartitions(PageID*, KeyDesc*, PbmPartitions**)
+ *  void edupbm_DiscardPartitions(PageID*)
+ *  Four edupbm_AddPartition(PbmPartitions*)
+ *  void edupbm_RemovePartition(PbmPartitions*, Two)
+ */
+
+
+#include "EduBtM_common.h"
+#include "EduPbM_Internal.h"
+#include "EduBtM.h"
+
+
+/* partitions of the partitioned B+ tree indexes */
+static PbmPartitions edupbm_partitions[PBM_MAXOPENINDEXES];
+
+
+
+/*@================================
+ * edupbm_GetPartitions()
+ *================================*/
+/*
+ * Function: Four edupbm_GetPartitions(PageID*, KeyDesc*, PbmPartitions**)
+ *
+ * Description:
+ *  Find the partitions of the index given by 'root'. If they are not in
+ *  memory, they are found from the B+ tree as above, and the entries of
+ *  the newest partition are counted.
+ *
+ * Returns:
+ *  Error code
+ *    eTOOMANYPARTITIONEDINDEXES_BTM
+ *    eTOOMANYPARTITIONS_BTM
+ *    some errors caused by function calls
+ *
+ * Side effects:
+ *  1) parameter parts : the partitions of the index
+ */
+Four edupbm_GetPartitions(
+    PageID              *root,          /* IN root page of the index */
+    KeyDesc             *kdesc,         /* IN the user's key descriptor */
+    PbmPartitions       **parts)        /* OUT the partitions */
+{
+    Four                e;              /* error number */
+    Four                i;              /* index of an entry */
+    Four                p;              /* a partition number */
+    KeyDesc             pkdesc;         /* key descriptor of the B+ tree */
+    KeyValue            low;            /* the smallest key of a partition */
+    KeyValue            high;           /* the smallest key of the next partition */
+    BtreeCursor         cursor;         /* a cursor on the B+ tree */
+    BtreeCursor         next;           /* the next cursor */
+    PbmPartitions       *freeParts;     /* an unused entry */
+
+
+	freeParts = NULL;
+	for (i = 0; i < PBM_MAXOPENINDEXES; i++)
+	{
+		if (!edupbm_partitions[i].used)
+		{
+			if (freeParts == NULL) freeParts = &edupbm_partitions[i];
+		}
+		else if (edupbm_partitions[i].root.volNo == root->volNo &&
+		         edupbm_partitions[i].root.pageNo == root->pageNo)
+		{
+			*parts = &edupbm_partitions[i];
+			return(eNOERROR);
+		}
+	}
+
+	if (freeParts == NULL) ERR(eTOOMANYPARTITIONEDINDEXES_BTM);
+
+	e = edupbm_KeyDesc(kdesc, &pkdesc);
+	if (e < 0) ERR(e);
+
+	freeParts->root = *root;
+	freeParts->sealed = FALSE;
+	freeParts->nPartitions = 0;
+	freeParts->nNewest = 0;
+
+	/* one descent per partition */
+	e = EduBtM_Fetch(root, &pkdesc, NULL, SM_BOF, NULL, SM_EOF, &cursor);
+	if (e < 0) ERR(e);
+
+	while (cursor.flag == CURSOR_ON)
+	{
+		p = edupbm_KeyPartition(&cursor.key);
+
+		if (freeParts->nPartitions == PBM_MAXPARTITIONS) ERR(eTOOMANYPARTITIONS_BTM);
+		freeParts->partition[freeParts->nPartitions++] = p;
+
+		e = edupbm_MakeKey(kdesc, p + 1, NULL, &low);
+		if (e < 0) ERR(e);
+
+		e = EduBtM_Fetch(root, &pkdesc, &low, SM_GE, &low, SM_EOF, &cursor);
+		if (e < 0) ERR(e);
+	}
+
+	/* count the entries of the newest partition */
+	if (freeParts->nPartitions > 0)
+	{
+		p = freeParts->partition[freeParts->nPartitions - 1];
+
+		e = edupbm_MakeKey(kdesc, p, NULL, &low);
+		if (e < 0) ERR(e);
+
+		e = edupbm_MakeKey(kdesc, p + 1, NULL, &high);
+		if (e < 0) ERR(e);
+
+		e = EduBtM_Fetch(root, &pkdesc, &low, SM_GE, &high, SM_LT, &cursor);
+		if (e < 0) ERR(e);
+
+		while (cursor.flag == CURSOR_ON)
+		{
+			freeParts->nNewest++;
+
+			e = EduBtM_FetchNext(root, &pkdesc, &high, SM_LT, &cursor, &next);
+			if (e < 0) ERR(e);
+			cursor = next;
+		}
+	}
+
+	freeParts->used = TRUE;
+	*parts = freeParts;
+
+	return(eNOERROR);
+
+} /* edupbm_GetPartitions() */
+
+
+
+/*@================================
+ * edupbm_DiscardPartitions()
+ *================================*/
+/*
+ * Function: void edupbm_DiscardPartitions(PageID*)
+ *
+ * Description:
+ *  Forget the partitions of the index given by 'root'.
+ *
+ * Returns:
+ *  None
+ */
+void edupbm_DiscardPartitions(
+    PageID              *root)          /* IN root page of the index */
+{
+    Four                i;              /* index of an entry */
+
+
+	for (i = 0; i < PBM_MAXOPENINDEXES; i++)
+	{
+		if (edupbm_partitions[i].used &&
+		    edupbm_partitions[i].root.volNo == root->volNo &&
+		    edupbm_partitions[i].root.pageNo == root->pageNo)
+			edupbm_partitions[i].used = FALSE;
+	}
+
+} /* edupbm_DiscardPartitions() */
+
+
+
+/*@================================
+ * edupbm_AddPartition()
+ *================================*/
+/*
+ * Function: Four edupbm_AddPartition(PbmPartitions*)
+ *
+ * Description:
+ *  Start a new partition after the newest one. The partition exists in
+ *  the B+ tree only after its first entry is inserted.
+ *
+ * Returns:
+ *  Error code
+ *    eTOOMANYPARTITIONS_BTM
+ */
+Four edupbm_AddPartition(
+    PbmPartitions       *parts)         /* INOUT the partitions */
+{
+
+	if (parts->nPartitions == PBM_MAXPARTITIONS) ERR(eTOOMANYPARTITIONS_BTM);
+
+	if (parts->nPartitions == 0)
+		parts->partition[0] = 0;
+	else
+		parts->partition[parts->nPartitions] = parts->partition[parts->nPartitions - 1] + 1;
+
+	parts->nPartitions++;
+	parts->nNewest = 0;
+	parts->sealed = FALSE;
+
+	return(eNOERROR);
+
+} /* edupbm_AddPartition() */
+
+
+
+/*@================================
+ * edupbm_RemovePartition()
+ *================================*/
+/*
+ * Function: void edupbm_RemovePartition(PbmPartitions*, Two)
+ *
+ * Description:
+ *  Remove the i-th partition, which has no entry any more.
+ *
+ * Returns:
+ *  None
+ */
+void edupbm_RemovePartition(
+    PbmPartitions       *parts,         /* INOUT the partitions */
+    Two                 i)              /* IN index of the partition */
+{
+
+	if (i == parts->nPartitions - 1)
+	{
+		/* the next insertion starts a new partition */
+		parts->nNewest = 0;
+		parts->sealed = TRUE;
+	}
+
+	for ( ; i < parts->nPartitions - 1; i++)
+		parts->partition[i] = parts->partition[i+1];
+
+	parts->nPartitions--;
+
+} /* edupbm_RemovePartition() */
@@ -0,0 +1,283 @@
+/******************************************************************************/
+/*                                                                            */
+/*    ODYSSEUS/EduCOSMOS Educational-Purpose Object Storage System            */
+/*                                                                            */
+/*    Developed by Professor Kyu-Young Whang et al.                           */
+/*                                                                            */
+/*    Database and Multimedia Laboratory                                      */
+/*                                                                            */
+/*    Computer Science Department and                                         */
+/*    Advanced Information Technology Research Center (AITrc)                 */
+/*    Korea Advanced Institute of Science and Technology (KAIST)              */
+/*                                                                            */
+/*    e-mail: kywhang@cs.kaist.ac.kr                                          */
+/*    phone: +82-42-350-7722                                                  */
+/*    fax: +82-42-350-8380                                                    */
+/*                                                                            */
+/*    Copyright (c) 1995-2013 by Kyu-Young Whang                              */
+/*                                                                            */
+/*    All rights reserved. No part of this software may be reproduced,        */
+/*    stored in a retrieval system, or transmitted, in any form or by any     */
+/*    means, electronic, mechanical, photocopying, recording, or otherwise,   */
+/*    without prior written permission of the copyright owner.                */
+/*                                                                            */
+/******************************************************************************/
+/*
+ * Module: eduspm_Box.c
+ *
+ * Description:
+ *  Box queries of the spatial index. On both curves the points of an
+ *  aligned cell of side 2^l get the codes of one range of 2^(nDims*l)
+ *  codes, and the range of a cell is split into the ranges of its 2^nDims
+ *  subcells. A box is decomposed into ranges by refining the cells which
+ *  cross its border level by level; the cells inside the box become
+ *  ranges of their own and the cells outside of it are dropped. The
+ *  refinement stops when the next level would need more than
+ *  SPM_MAXRANGES ranges, so the ranges may cover points outside of the
+ *  box and every point read is checked against the box.
+ *
+ * Exports:
+ *  void eduspm_BoxRanges(SpatialDesc*, UFour*, UFour*, spm_Range*, Two*)
+ *  Boolean eduspm_AddRange(spm_Range*, Boolean*, Two*, UEight, UEight, Boolean)
+ *  Four eduspm_FetchBox(PageID*, SpatialDesc*, UFour*, UFour*, SpatialCursor*, SpatialItem*, Four, Four*)
+ */
+
+
+#include "EduBtM_common.h"
+#include "EduSpM_Internal.h"
+#include "EduBtM.h"
+
+
+
+/*@================================
+ * eduspm_BoxRanges()
+ *================================*/
+/*
+ * Function: void eduspm_BoxRanges(SpatialDesc*, UFour*, UFour*, spm_Range*, Two*)
+ *
+ * Description:
+ *  Decompose the box ['lo', 'hi'] into at most SPM_MAXRANGES ranges of the
+ *  codes. See above for detail. The ranges are in the order of the codes,
+ *  and adjacent ranges are merged.
+ *
+ * Returns:
+ *  None
+ */
+void eduspm_BoxRanges(
+    SpatialDesc         *sdesc,         /* IN descriptor of the space */
+    UFour               *lo,            /* IN the lowest corner of the box */
+    UFour               *hi,            /* IN the highest corner of the box */
+    spm_Range           *ranges,        /* OUT the ranges */
+    Two                 *nRanges)       /* OUT # of the ranges */
+{
+    Two                 i;              /* index of a dimension */
+    Two                 j;              /* index of a range */
+    Two                 level;          /* level of the subcells; the side of a subcell is 2^(nBits-level) */
+    Two                 n;              /* # of the ranges of the previous level */
+    Two                 m;              /* # of the ranges of this level */
+    UEight              first;          /* first code of a subcell */
+    UEight              cellCodes;      /* # of the codes of a subcell */
+    UFour               side;           /* length of a side of a subcell */
+    UFour               corner[SPM_MAXDIMS]; /* the lowest corner of a subcell */
+    Boolean             inside;         /* TRUE if the subcell is inside the box */
+    Boolean             disjoint;       /* TRUE if the subcell is outside of the box */
+    Boolean             refine;         /* TRUE if some ranges are still to be refined */
+    Boolean             full;           /* TRUE if the ranges of this level are too many */
+    Boolean             partial[SPM_MAXRANGES]; /* TRUE if the range is a cell crossing the border */
+    Boolean             nPartial[SPM_MAXRANGES]; /* 'partial' of this level */
+    spm_Range           next[SPM_MAXRANGES]; /* the ranges of this level */
+
+
+	/* the whole space is a cell crossing the border */
+	n = 1;
+	ranges[0].first = 0;
+	ranges[0].last = ((UEight)1 << (sdesc->nDims * sdesc->nBits)) - 1;
+	partial[0] = TRUE;
+
+	refine = TRUE;
+	for (level = 1; level <= sdesc->nBits && refine; level++)
+	{
+		cellCodes = (UEight)1 << (sdesc->nDims * (sdesc->nBits - level));
+		side = (UFour)1 << (sdesc->nBits - level);
+
+		m = 0;
+		full = FALSE;
+		refine = FALSE;
+		for (j = 0; j < n && !full; j++)
+		{
+			if (!partial[j])
+			{
+				full = !eduspm_AddRange(next, nPartial, &m, ranges[j].first, ranges[j].last, FALSE);
+				continue;
+			}
+
+			for (first = ranges[j].first; first <= ranges[j].last && !full; first += cellCodes)
+			{
+				eduspm_Decode(sdesc, first, corner);
+
+				inside = TRUE;
+				disjoint = FALSE;
+				for (i = 0; i < sdesc->nDims; i++)
+				{
+					corner[i] &= ~(side - 1);
+					if (corner[i] > hi[i] || corner[i] + (side - 1) < lo[i]) disjoint = TRUE;
+					if (corner[i] < lo[i] || corner[i] + (side - 1) > hi[i]) inside = FALSE;
+				}
+
+				if (disjoint) continue;
+
+				full = !eduspm_AddRange(next, nPartial, &m, first, first + cellCodes - 1, !inside);
+				if (!inside) refine = TRUE;
+			}
+		}
+
+		/* keep the ranges of the previous level if this level needs too many */
+		if (full) break;
+
+		for (j = 0; j < m; j++)
+		{
+			ranges[j] = next[j];
+			partial[j] = nPartial[j];
+		}
+		n = m;
+	}
+
+	/* merge the adjacent ranges */
+	for (j = 0, m = 0; j < n; j++)
+	{
+		if (m > 0 && ranges[m-1].last + 1 == ranges[j].first)
+			ranges[m-1].last = ranges[j].last;
+		else
+			ranges[m++] = ranges[j];
+	}
+	*nRanges = m;
+
+} /* eduspm_BoxRanges() */
+
+
+
+/*@================================
+ * eduspm_AddRange()
+ *================================*/
+/*
+ * Function: Boolean eduspm_AddRange(spm_Range*, Boolean*, Two*, UEight, UEight, Boolean)
+ *
+ * Description:
+ *  Append the range to the ranges. A range which need not be refined is
+ *  merged with the previous one if both are adjacent and neither is to be
+ *  refined; a cell to be refined stays a range of its own.
+ *
+ * Returns:
+ *  FALSE if there are already SPM_MAXRANGES ranges
+ */
+Boolean eduspm_AddRange(
+    spm_Range           *ranges,        /* INOUT the ranges */
+    Boolean             *partial,       /* INOUT TRUE for the ranges to be refined */
+    Two                 *nRanges,       /* INOUT # of the ranges */
+    UEight              first,          /* IN first code of the range */
+    UEight              last,           /* IN last code of the range */
+    Boolean             refine)         /* IN TRUE if the range is to be refined */
+{
+
+	if (!refine && *nRanges > 0 && !partial[*nRanges-1] && ranges[*nRanges-1].last + 1 == first)
+	{
+		ranges[*nRanges-1].last = last;
+		return(TRUE);
+	}
+
+	if (*nRanges == SPM_MAXRANGES) return(FALSE);
+
+	ranges[*nRanges].first = first;
+	ranges[*nRanges].last = last;
+	partial[*nRanges] = refine;
+	(*nRanges)++;
+
+    return(TRUE);
+
+} /* eduspm_AddRange() */
+
+
+
+/*@================================
+ * eduspm_FetchBox()
+ *================================*/
+/*
+ * Function: Four eduspm_FetchBox(PageID*, SpatialDesc*, UFour*, UFour*, SpatialCursor*, SpatialItem*, Four, Four*)
+ *
+ * Description:
+ *  Read the points in the box from the ranges of the cursor, from where
+ *  the cursor stands, until 'maxItems' points are found or the ranges are
+ *  exhausted. Each range is scanned from the smallest key of its first
+ *  code to the largest key of its last code.
+ *
+ * Returns:
+ *  error code
+ *    some errors caused by function calls
+ *
+ * Side effects:
+ *  cursor : CURSOR_EOS if the ranges are exhausted; CURSOR_ON otherwise
+ */
+Four eduspm_FetchBox(
+    PageID              *root,          /* IN root page of the spatial index */
+    SpatialDesc         *sdesc,         /* IN descriptor of the space */
+    UFour               *lo,            /* IN the lowest corner of the box */
+    UFour               *hi,            /* IN the highest corner of the box */
+    SpatialCursor       *cursor,        /* INOUT the scan of the box */
+    SpatialItem         *items,         /* OUT the points found */
+    Four                maxItems,       /* IN size of 'items' */
+    Four                *nItems)        /* OUT # of the points found */
+{
+    Four                e;              /* error number */
+    Two                 i;              /* index of a dimension */
+    KeyDesc             kdesc;          /* key descriptor of the B+ tree */
+    KeyValue            startKval;      /* the smallest key of the range */
+    KeyValue            stopKval;       /* the largest key of the range */
+    BtreeCursor         next;           /* the next entry of the range */
+    UFour               point[SPM_MAXDIMS]; /* the point of an entry */
+
+
+	eduspm_KeyDesc(&kdesc);
+
+	*nItems = 0;
+	while (*nItems < maxItems && cursor->range < cursor->nRanges)
+	{
+		eduspm_MakeKey(cursor->ranges[cursor->range].last, NULL, TRUE, &stopKval);
+
+		if (cursor->btree.flag != CURSOR_ON)
+		{
+			eduspm_MakeKey(cursor->ranges[cursor->range].first, NULL, FALSE, &startKval);
+			e = EduBtM_Fetch(root, &kdesc, &startKval, SM_GE, &stopKval, SM_LE, &cursor->btree);
+			if (e < 0) ERR(e);
+		}
+		else
+		{
+			e = EduBtM_FetchNext(root, &kdesc, &stopKval, SM_LE, &cursor->btree, &next);
+			if (e < 0) ERR(e);
+			cursor->btree = next;
+		}
+
+		if (cursor->btree.flag != CURSOR_ON)
+		{
+			cursor->range++;
+			cursor->btree.flag = CURSOR_INVALID;
+			continue;
+		}
+
+		eduspm_Decode(sdesc, eduspm_KeyCode(&cursor->btree.key), point);
+
+		for (i = 0; i < sdesc->nDims; i++)
+			if (point[i] < lo[i] || point[i] > hi[i]) break;
+
+		if (i < sdesc->nDims) continue;
+
+		items[*nItems].oid = cursor->btree.oid;
+		for (i = 0; i < sdesc->nDims; i++) items[*nItems].point[i] = point[i];
+		items[*nItems].dist2 = 0;
+		(*nItems)++;
+	}
+
+	cursor->flag = (cursor->range < cursor->nRanges) ? CURSOR_ON : CURSOR_EOS;
+
+    return(eNOERROR);
+
+} /* eduspm_FetchBox() */
@@ -0,0 +1,289 @@
+/******************************************************************************/
+/*                                                                            */
+/*    ODYSSEUS/EduCOSMOS Educational-Purpose Object Storage System            */
+/*                                                                            */
+/*    Developed by Professor Kyu-Young Whang et al.                           */
+/*                                                                            */
+/*    Database and Multimedia Laboratory                                      */
+/*                                                                            */
+/*    Computer Science Department and                                         */
+/*    Advanced Information Technology Research Center (AITrc)                 */
+/*    Korea Advanced Institute of Science and Technology (KAIST)              */
+/*                                                                            */
+/*    e-mail: kywhang@cs.kaist.ac.kr                                          */
+/*    phone: +82-42-350-7722                                                  */
+/*    fax: +82-42-350-8380                                                    */
+/*                                                                            */
+/*    Copyright (c) 1995-2013 by Kyu-Young Whang                              */
+/*                                                                            */
+/*    All rights reserved. No part of this software may be reproduced,        */
+/*    stored in a retrieval system, or transmitted, in any form or by any     */
+/*    means, electronic, mechanical, photocopying, recording, or otherwise,   */
+/*    without prior written permission of the copyright owner.                */
+/*                                                                            */
+/******************************************************************************/
+/*
+ * Module: eduspm_Curve.c
+ *
+ * Description:
+ *  Space filling curves of the spatial index. The Z-order code of a point
+ *  interleaves the bits of its coordinates, from the most significant bit
+ *  of the first coordinate. The Hilbert code is computed by the method of
+ *  J. Skilling, "Programming the Hilbert curve" (2004): the coordinates
+ *  are transformed in place into the 'transpose' of the Hilbert index,
+ *  which is then interleaved as a Z-order code is.
+ *
+ * Exports:
+ *  Four eduspm_CheckDesc(SpatialDesc*)
+ *  Boolean eduspm_ValidPoint(SpatialDesc*, UFour*)
+ *  UEight eduspm_Encode(SpatialDesc*, UFour*)
+ *  void eduspm_Decode(SpatialDesc*, UEight, UFour*)
+ *  void eduspm_AxesToTranspose(UFour*, Two, Two)
+ *  void eduspm_TransposeToAxes(UFour*, Two, Two)
+ */
+
+
+#include "EduBtM_common.h"
+#include "EduSpM_Internal.h"
+
+
+
+/*@================================
+ * eduspm_CheckDesc()
+ *================================*/
+/*
+ * Function: Four eduspm_CheckDesc(SpatialDesc*)
+ *
+ * Description:
+ *  Check that the space can be mapped onto a curve of the index.
+ *
+ * Returns:
+ *  error code
+ *    eBADPARAMETER_BTM
+ */
+Four eduspm_CheckDesc(
+    SpatialDesc         *sdesc)         /* IN descriptor of the space */
+{
+
+    if (sdesc == NULL) ERR(eBADPARAMETER_BTM);
+
+	if (sdesc->nDims < 1 || sdesc->nDims > SPM_MAXDIMS) ERR(eBADPARAMETER_BTM);
+
+	if (sdesc->nBits < 1 || sdesc->nBits > SPM_MAXBITS) ERR(eBADPARAMETER_BTM);
+
+	if (sdesc->nDims * sdesc->nBits > SPM_MAXCODEBITS) ERR(eBADPARAMETER_BTM);
+
+	if (sdesc->curve != SPM_ZORDER && sdesc->curve != SPM_HILBERT) ERR(eBADPARAMETER_BTM);
+
+    return(eNOERROR);
+
+} /* eduspm_CheckDesc() */
+
+
+
+/*@================================
+ * eduspm_ValidPoint()
+ *================================*/
+/*
+ * Function: Boolean eduspm_ValidPoint(SpatialDesc*, UFour*)
+ *
+ * Description:
+ *  Check that every coordinate of the point fits in 'nBits' bits.
+ *
+ * Returns:
+ *  TRUE if the point is in the space
+ */
+Boolean eduspm_ValidPoint(
+    SpatialDesc         *sdesc,         /* IN descriptor of the space */
+    UFour               *point)         /* IN coordinates of the point */
+{
+    Two                 i;              /* index of a dimension */
+
+
+	for (i = 0; i < sdesc->nDims; i++)
+		if (point[i] >> sdesc->nBits) return(FALSE);
+
+    return(TRUE);
+
+} /* eduspm_ValidPoint() */
+
+
+
+/*@================================
+ * eduspm_Encode()
+ *================================*/
+/*
+ * Function: UEight eduspm_Encode(SpatialDesc*, UFour*)
+ *
+ * Description:
+ *  Map the point to its code on the curve of the space.
+ *
+ * Returns:
+ *  the code of nDims * nBits bits
+ */
+UEight eduspm_Encode(
+    SpatialDesc         *sdesc,         /* IN descriptor of the space */
+    UFour               *point)         /* IN coordinates of the point */
+{
+    Two                 i;              /* index of a dimension */
+    Two                 b;              /* index of a bit */
+    UFour               x[SPM_MAXDIMS]; /* the coordinates or their transpose */
+    UEight              code;           /* the code */
+
+
+	for (i = 0; i < sdesc->nDims; i++) x[i] = point[i];
+
+	if (sdesc->curve == SPM_HILBERT)
+		eduspm_AxesToTranspose(x, sdesc->nBits, sdesc->nDims);
+
+	code = 0;
+	for (b = sdesc->nBits - 1; b >= 0; b--)
+		for (i = 0; i < sdesc->nDims; i++)
+			code = (code << 1) | ((x[i] >> b) & 1);
+
+    return(code);
+
+} /* eduspm_Encode() */
+
+
+
+/*@================================
+ * eduspm_Decode()
+ *================================*/
+/*
+ * Function: void eduspm_Decode(SpatialDesc*, UEight, UFour*)
+ *
+ * Description:
+ *  Map the code back to the point; the inverse of eduspm_Encode().
+ *
+ * Returns:
+ *  None
+ */
+void eduspm_Decode(
+    SpatialDesc         *sdesc,         /* IN descriptor of the space */
+    UEight              code,           /* IN code of the point */
+    UFour               *point)         /* OUT coordinates of the point */
+{
+    Two                 i;              /* index of a dimension */
+    Two                 b;              /* index of a bit */
+    Two                 shift;          /* position of the next bit in the code */
+
+
+	for (i = 0; i < sdesc->nDims; i++) point[i] = 0;
+
+	shift = sdesc->nDims * sdesc->nBits;
+	for (b = sdesc->nBits - 1; b >= 0; b--)
+		for (i = 0; i < sdesc->nDims; i++)
+			point[i] |= (UFour)((code >> --shift) & 1) << b;
+
+	if (sdesc->curve == SPM_HILBERT)
+		eduspm_TransposeToAxes(point, sdesc->nBits, sdesc->nDims);
+
+} /* eduspm_Decode() */
+
+
+
+/*@================================
+ * eduspm_AxesToTranspose()
+ *================================*/
+/*
+ * Function: void eduspm_AxesToTranspose(UFour*, Two, Two)
+ *
+ * Description:
+ *  Turn the coordinates into the transpose of their Hilbert index. The
+ *  rotations and reflections of the cells are undone from the largest
+ *  cell down, and the result is Gray encoded.
+ *
+ * Returns:
+ *  None
+ */
+void eduspm_AxesToTranspose(
+    UFour               *x,             /* INOUT the coordinates; the transpose on return */
+    Two                 nBits,          /* IN # of the bits of a coordinate */
+    Two                 nDims)          /* IN # of the dimensions */
+{
+    Two                 i;              /* index of a dimension */
+    UFour               p;              /* the bits below q */
+    UFour               q;              /* the bit of the current level */
+    UFour               t;              /* bits to exchange or to flip */
+
+
+	/* undo the rotations and the reflections */
+	for (q = (UFour)1 << (nBits - 1); q > 1; q >>= 1)
+	{
+		p = q - 1;
+		for (i = 0; i < nDims; i++)
+		{
+			if (x[i] & q)
+				x[0] ^= p;		/* reflect */
+			else
+			{
+				t = (x[0] ^ x[i]) & p;	/* exchange */
+				x[0] ^= t;
+				x[i] ^= t;
+			}
+		}
+	}
+
+	/* Gray encode */
+	for (i = 1; i < nDims; i++) x[i] ^= x[i-1];
+
+	t = 0;
+	for (q = (UFour)1 << (nBits - 1); q > 1; q >>= 1)
+		if (x[nDims-1] & q) t ^= q - 1;
+
+	for (i = 0; i < nDims; i++) x[i] ^= t;
+
+} /* eduspm_AxesToTranspose() */
+
+
+
+/*@================================
+ * eduspm_TransposeToAxes()
+ *================================*/
+/*
+ * Function: void eduspm_TransposeToAxes(UFour*, Two, Two)
+ *
+ * Description:
+ *  Turn the transpose of a Hilbert index into the coordinates; the
+ *  inverse of eduspm_AxesToTranspose().
+ *
+ * Returns:
+ *  None
+ */
+void eduspm_TransposeToAxes(
+    UFour               *x,             /* INOUT the transpose; the coordinates on return */
+    Two                 nBits,          /* IN # of the bits of a coordinate */
+    Two                 nDims)          /* IN # of the dimensions */
+{
+    Two                 i;              /* index of a dimension */
+    UFour               n;              /* the bit above the coordinates */
+    UFour               p;              /* the bits below q */
+    UFour               q;              /* the bit of the current level */
+    UFour               t;              /* bits to exchange or to flip */
+
+
+	/* Gray decode */
+	t = x[nDims-1] >> 1;
+	for (i = nDims - 1; i > 0; i--) x[i] ^= x[i-1];
+	x[0] ^= t;
+
+	/* redo the rotations and the reflections */
+	n = (UFour)2 << (nBits - 1);
+	for (q = 2; q != n; q <<= 1)
+	{
+		p = q - 1;
+		for (i = nDims - 1; i >= 0; i--)
+		{
+			if (x[i] & q)
+				x[0] ^= p;		/* reflect */
+			else
+			{
+				t = (x[0] ^ x[i]) & p;	/* exchange */
+				x[0] ^= t;
+				x[i] ^= t;
+			}
+		}
+	}
+
+} /* eduspm_TransposeToAxes() */
@@ -0,0 +1,144 @@
+/******************************************************************************/
+/*                                                                            */
+/*    ODYSSEUS/EduCOSMOS Educational-Purpose Object Storage System            */
+/*                                                                            */
+/*    Developed by Professor Kyu-Young Whang et al.                           */
+/*                                                                            */
+/*    Database and Multimedia Laboratory                                      */
+/*                                                                            */
+/*    Computer Science Department and                                         */
+/*    Advanced Information Technology Research Center (AITrc)                 */
+/*    Korea Advanced Institute of Science and Technology (KAIST)              */
+/*                                                                            */
+/*    e-mail: kywhang@cs.kaist.ac.kr                                          */
+/*    phone: +82-42-350-7722                                                  */
+/*    fax: +82-42-350-8380                                                    */
+/*                                                                            */
+/*    Copyright (c) 1995-2013 by Kyu-Young Whang                              */
+/*                                                                            */
+/*    All rights reserved. No part of this software may be reproduced,        */
+/*    stored in a retrieval system, or transmitted, in any form or by any     */
+/*    means, electronic, mechanical, photocopying, recording, or otherwise,   */
+/*    without prior written permission of the copyright owner.                */
+/*                                                                            */
+/******************************************************************************/
+/*
+ * Module: eduspm_Key.c
+ *
+ * Description:
+ *  Keys of the B+ tree under a spatial index. The code of a point is split
+ *  into two SM_INT parts of 31 bits, so the order of the keys is the order
+ *  of the codes, and the ObjectID follows in three SM_INT parts.
+ *
+ * Exports:
+ *  void eduspm_KeyDesc(KeyDesc*)
+ *  void eduspm_MakeKey(UEight, ObjectID*, Boolean, KeyValue*)
+ *  UEight eduspm_KeyCode(KeyValue*)
+ */
+
+
+#include <string.h>
+#include "EduBtM_common.h"
+#include "EduSpM_Internal.h"
+
+
+
+/*@================================
+ * eduspm_KeyDesc()
+ *================================*/
+/*
+ * Function: void eduspm_KeyDesc(KeyDesc*)
+ *
+ * Description:
+ *  Make the key descriptor of the B+ tree. The keys are unique by the
+ *  ObjectID, so the index need not be declared unique.
+ *
+ * Returns:
+ *  None
+ */
+void eduspm_KeyDesc(
+    KeyDesc             *kdesc)         /* OUT key descriptor */
+{
+    Two                 i;              /* index of a key part */
+
+
+	kdesc->flag = 0;
+	kdesc->nparts = SPM_KEYPARTS;
+	for (i = 0; i < SPM_KEYPARTS; i++)
+	{
+		kdesc->kpart[i].type = SM_INT;
+		kdesc->kpart[i].offset = i * sizeof(Four_Invariable);
+		kdesc->kpart[i].length = sizeof(Four_Invariable);
+	}
+
+} /* eduspm_KeyDesc() */
+
+
+
+/*@================================
+ * eduspm_MakeKey()
+ *================================*/
+/*
+ * Function: void eduspm_MakeKey(UEight, ObjectID*, Boolean, KeyValue*)
+ *
+ * Description:
+ *  Make the key of the code and the ObjectID. If 'oid' is NULL, the
+ *  ObjectID parts are the smallest values, or the largest ones if 'high'
+ *  is TRUE; such a key bounds all the keys of the code.
+ *
+ * Returns:
+ *  None
+ */
+void eduspm_MakeKey(
+    UEight              code,           /* IN code of the point */
+    ObjectID            *oid,           /* IN ObjectID or NULL */
+    Boolean             high,           /* IN the largest ObjectID parts if 'oid' is NULL */
+    KeyValue            *kval)          /* OUT the key */
+{
+    Two                 i;              /* index of a key part */
+    Four_Invariable     part[SPM_KEYPARTS]; /* the key parts */
+
+
+	part[0] = (Four_Invariable)(code >> 31);
+	part[1] = (Four_Invariable)(code & 0x7fffffff);
+
+	if (oid != NULL)
+	{
+		part[2] = oid->pageNo;
+		part[3] = ((Four_Invariable)oid->volNo << 16) | (UTwo)oid->slotNo;
+		part[4] = (Four_Invariable)oid->unique;
+	}
+	else
+		for (i = 2; i < SPM_KEYPARTS; i++)
+			part[i] = high ? (Four_Invariable)0x7fffffff : (Four_Invariable)0x80000000;
+
+	kval->len = SPM_KEYLEN;
+	memcpy(kval->val, part, SPM_KEYLEN);
+
+} /* eduspm_MakeKey() */
+
+
+
+/*@================================
+ * eduspm_KeyCode()
+ *================================*/
+/*
+ * Function: UEight eduspm_KeyCode(KeyValue*)
+ *
+ * Description:
+ *  Get the code back from a key.
+ *
+ * Returns:
+ *  the code
+ */
+UEight eduspm_KeyCode(
+    KeyValue            *kval)          /* IN the key */
+{
+    Four_Invariable     part[2];        /* the parts of the code */
+
+
+	memcpy(part, kval->val, sizeof(part));
+
+    return(((UEight)(UFour)part[0] << 31) | (UFour)part[1]);
+
+} /* eduspm_KeyCode() */
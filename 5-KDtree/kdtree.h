@@ -14,6 +14,7 @@
 #include <string>
 #include <utility>
 #include <set>
+#include <vector>
 
 #include "bounded_priority_queue.h"
 #include "point.h"
@@ -41,6 +42,15 @@ class KDTree {
   // Constructs an empty KDTree.
   KDTree();
 
+  // template <typename InputIterator>
+  // KDTree(InputIterator begin, InputIterator end);
+  // Usage: KDTree<3, int> myTree(points.begin(), points.end());
+  // ----------------------------------------------------
+  // Constructs a balanced KDTree from a range of std::pair<Point<N>, ElemType>.
+  // See build below.
+  template <typename InputIterator>
+  KDTree(InputIterator begin, InputIterator end);
+
   // KDTree(const KDTree& rhs);
   // KDTree& operator=(const KDTree& rhs);
   // Usage: KDTree<3, int> one = two;
@@ -85,6 +95,25 @@ class KDTree {
   // overwrite the existing one.
   void insert(const Point<N>& point, const ElemType& value);
 
+  // template <typename InputIterator>
+  // void build(InputIterator begin, InputIterator end);
+  // Usage: kd.build(points.begin(), points.end());
+  // ----------------------------------------------------
+  // Replaces the contents of the KDTree with the points of a range of
+  // std::pair<Point<N>, ElemType>. The tree is balanced whatever the order of
+  // the range: each subtree is split at the median of its axis, found with
+  // nth_element, so the build takes O(n log n) time. If a point occurs more
+  // than once, the last value wins, as with repeated inserts.
+  template <typename InputIterator>
+  void build(InputIterator begin, InputIterator end);
+
+  // int height() const;
+  // Usage: int h = kd.height();
+  // ----------------------------------------------------
+  // Returns the number of nodes on the longest path from the root to a leaf,
+  // which bounds the work of contains and at.
+  int height() const;
+
   // ElemType& operator[](const Point<N>& pt);
   // Usage: kd[v] = "Some Value";
   // ----------------------------------------------------
@@ -118,6 +147,8 @@ class KDTree {
    struct Node<N, ElemType>* insertNode(struct Node<N, ElemType>* root, const Point<N>& point, const ElemType& value, int depth);
    struct Node<N, ElemType>* findNode(struct Node<N, ElemType>* root, const Point<N>& point, int depth) const;
    void copyNode(struct Node<N, ElemType>** dst, struct Node<N, ElemType>*const* src);
+   struct Node<N, ElemType>* buildNode(std::vector<std::pair<Point<N>, ElemType> >& points, int lo, int hi, int depth);
+   int heightNode(struct Node<N, ElemType>* root) const;
    void searchKNNValue(struct Node<N, ElemType>* root, const Point<N>& key, BoundedPriorityQueue<ElemType>& bpq, int depth) const;
    ElemType decideKNNValue(BoundedPriorityQueue<ElemType> bpq) const;
 };
@@ -130,6 +161,14 @@ KDTree<N, ElemType>::KDTree() {
   head.root = NULL;
 }
 
+template <int N, typename ElemType>
+template <typename InputIterator>
+KDTree<N, ElemType>::KDTree(InputIterator begin, InputIterator end) {
+  head.size = 0;
+  head.root = NULL;
+  build(begin, end);
+}
+
 template <int N, typename ElemType>
 KDTree<N, ElemType>::KDTree(const KDTree& rhs) {
   *this = rhs;
@@ -191,6 +230,37 @@ void KDTree<N, ElemType>::insert(const Point<N>& point, const ElemType& value) {
   }
 }
 
+// The points are sorted lexicographically to drop the duplicates, keeping the
+// last value of each point, and then handed to buildNode.
+template <int N, typename ElemType>
+template <typename InputIterator>
+void KDTree<N, ElemType>::build(InputIterator begin, InputIterator end) {
+  std::vector<std::pair<Point<N>, ElemType> > points(begin, end);
+  std::stable_sort(points.begin(), points.end(),
+      [](const std::pair<Point<N>, ElemType>& a, const std::pair<Point<N>, ElemType>& b) {
+        return std::lexicographical_compare(a.first.begin(), a.first.end(), b.first.begin(), b.first.end());
+      });
+  int unique = 0;
+  for (int i = 0; i < (int) points.size(); i++) {
+    if (i + 1 < (int) points.size() && points[i + 1].first == points[i].first)
+      continue;
+    if (unique != i)
+      points[unique] = points[i];
+    unique++;
+  }
+  points.resize(unique);
+
+  if (head.root != NULL)
+    deleteNode(head.root);
+  head.root = buildNode(points, 0, unique, 0);
+  head.size = unique;
+}
+
+template <int N, typename ElemType>
+int KDTree<N, ElemType>::height() const {
+  return heightNode(head.root);
+}
+
 template <int N, typename ElemType>
 ElemType& KDTree<N, ElemType>::operator[](const Point<N>& point) {
   struct Node<N, ElemType> *node;
@@ -319,6 +389,44 @@ void KDTree<N, ElemType>::copyNode(struct Node<N, ElemType>** dst, struct Node<N
     (*dst)->right_child = NULL;
 }
 
+// The median of points[lo, hi) on the axis becomes the root. findNode goes
+// left only for coordinates smaller than the root's, so the points equal to
+// the median are moved to the right subtree and the root is the first of them.
+template<int N, typename ElemType>
+struct Node<N, ElemType>* KDTree<N, ElemType>::buildNode(
+  std::vector<std::pair<Point<N>, ElemType> >& points, int lo, int hi, int depth) {
+  if (lo >= hi)
+    return NULL;
+
+  int index = depth % N;
+  int half = lo + (hi - lo) / 2;
+  std::nth_element(points.begin() + lo, points.begin() + half, points.begin() + hi,
+      [index](const std::pair<Point<N>, ElemType>& a, const std::pair<Point<N>, ElemType>& b) {
+        return a.first[index] < b.first[index];
+      });
+  double median = points[half].first[index];
+  int mid = std::partition(points.begin() + lo, points.begin() + half,
+      [index, median](const std::pair<Point<N>, ElemType>& a) {
+        return a.first[index] < median;
+      }) - points.begin();
+  std::swap(points[mid], points[half]);
+
+  struct Node<N, ElemType> *root;
+  root = (struct Node<N, ElemType>*) malloc(sizeof(struct Node<N, ElemType>));
+  root->point = points[mid].first;
+  root->value = points[mid].second;
+  root->left_child = buildNode(points, lo, mid, depth + 1);
+  root->right_child = buildNode(points, mid + 1, hi, depth + 1);
+  return root;
+}
+
+template<int N, typename ElemType>
+int KDTree<N, ElemType>::heightNode(struct Node<N, ElemType>* root) const {
+  if (root == NULL)
+    return 0;
+  return 1 + std::max(heightNode(root->left_child), heightNode(root->right_child));
+}
+
 template<int N, typename ElemType>
 void KDTree<N, ElemType>::searchKNNValue(
   Node<N, ElemType>* root, const Point<N>& key, BoundedPriorityQueue<ElemType>& bpq, int depth) const {
@@ -355,7 +463,7 @@ ElemType KDTree<N, ElemType>::decideKNNValue(BoundedPriorityQueue<ElemType> bpq)
 
   int max = 0;
   ElemType KNNValue;
-  for (std::multiset<ElemType>::const_iterator i(value_set.begin()), end(value_set.end()); i != end; ++i) {
+  for (typename std::multiset<ElemType>::const_iterator i(value_set.begin()), end(value_set.end()); i != end; ++i) {
     if (max < value_set.count(*i)) {
       max = value_set.count(*i);
       KNNValue = *i;
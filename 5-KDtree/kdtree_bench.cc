@@ -0,0 +1,165 @@
+/*************************************************
+ * file: kdtree_bench.cc
+ *
+ * benchmarks of the kdtree construction and
+ * layout.  for each tree they report the
+ * construction time, the height, and the average
+ * latency of contains and kNNValue.
+ *
+ * the sorted benchmark compares a kdtree built
+ * by repeated insert with one built by build()
+ * from the same points.  the points are fed in
+ * sorted order, the worst case for insertion:
+ * every new point is the largest on the first
+ * axis, so the tree degenerates toward a list.
+ *
+ * the layout benchmark compares the pointer
+ * KDTree with StaticKDTree, both balanced, on
+ * uniform random points, so only the memory
+ * layout differs.  the default size is well
+ * beyond the caches.  naming one of the trees
+ * runs only that one, so that a profiler such as
+ * perf stat -e cache-misses can count its misses.
+ *
+ * usage: kdtree_bench [number of points]
+ *        kdtree_bench layout [number of points] [pointer|implicit]
+ */
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "kdtree.h"
+#include "static_kdtree.h"
+
+/* Number of lookups and kNN queries timed per tree. */
+const int kNumLookups = 2000;
+const int kNumQueries = 200;
+const int kNeighbors = 5;
+
+/* Returns the seconds elapsed since start. */
+double SecondsSince(std::chrono::steady_clock::time_point start) {
+  return std::chrono::duration<double>(std::chrono::steady_clock::now() - start)
+      .count();
+}
+
+/* Prints the header of the report. */
+void PrintHeader() {
+  std::cout << std::left << std::setw(12) << "tree" << std::right
+            << std::setw(12) << "build(ms)" << std::setw(10) << "height"
+            << std::setw(14) << "contains(ns)" << std::setw(14) << "kNN(ns)"
+            << std::endl;
+}
+
+/* Times the queries against the tree and prints one row of the report. */
+template <typename Tree>
+void Report(const std::string& name, const Tree& kd, double build,
+            const std::vector<std::pair<Point<2>, int> >& points,
+            const std::vector<Point<2> >& queries) {
+  int found = 0;
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < kNumLookups; ++i)
+    found += kd.contains(points[(i * 7919L) % points.size()].first);
+  double lookup = SecondsSince(start) / kNumLookups;
+
+  long checksum = 0;
+  start = std::chrono::steady_clock::now();
+  for (const Point<2>& key : queries)
+    checksum += kd.kNNValue(key, kNeighbors);
+  double knn = SecondsSince(start) / queries.size();
+
+  std::cout << std::left << std::setw(12) << name << std::right
+            << std::setw(12) << std::fixed << std::setprecision(3) << build * 1e3
+            << std::setw(10) << kd.height() << std::setw(14)
+            << std::setprecision(1) << lookup * 1e9 << std::setw(14)
+            << knn * 1e9 << "   (found " << found << ", checksum "
+            << checksum << ")" << std::endl;
+}
+
+/* Returns kNumQueries random points in [0, side) x [0, side). */
+std::vector<Point<2> > RandomQueries(double side) {
+  std::vector<Point<2> > queries;
+  for (int i = 0; i < kNumQueries; ++i) {
+    Point<2> pt;
+    pt[0] = rand() / (RAND_MAX + 1.0) * side;
+    pt[1] = rand() / (RAND_MAX + 1.0) * side;
+    queries.push_back(pt);
+  }
+  return queries;
+}
+
+/* Repeated insert against build() on sorted points. */
+void SortedBenchmark(int n) {
+  /* Points on a jittered grid, sorted by x and then y. */
+  std::vector<std::pair<Point<2>, int> > points;
+  int side = 1;
+  while (side * side < n) ++side;
+  srand(137);
+  for (int i = 0; i < n; ++i) {
+    Point<2> pt;
+    pt[0] = i / side + rand() / (RAND_MAX + 1.0) * 0.5;
+    pt[1] = i % side + rand() / (RAND_MAX + 1.0) * 0.5;
+    points.push_back(std::make_pair(pt, i % 10));
+  }
+
+  std::vector<Point<2> > queries = RandomQueries(side);
+
+  std::cout << n << " points in sorted order" << std::endl;
+  PrintHeader();
+
+  {
+    auto start = std::chrono::steady_clock::now();
+    KDTree<2, int> kd;
+    for (const auto& point : points) kd.insert(point.first, point.second);
+    Report("insert", kd, SecondsSince(start), points, queries);
+  }
+
+  {
+    auto start = std::chrono::steady_clock::now();
+    KDTree<2, int> kd(points.begin(), points.end());
+    Report("build", kd, SecondsSince(start), points, queries);
+  }
+}
+
+/* The pointer KDTree against StaticKDTree on random points; which names the
+ * tree to run, or is empty for both.
+ */
+void LayoutBenchmark(int n, const std::string& which) {
+  std::vector<std::pair<Point<2>, int> > points;
+  srand(137);
+  for (int i = 0; i < n; ++i) {
+    Point<2> pt;
+    pt[0] = rand() / (RAND_MAX + 1.0);
+    pt[1] = rand() / (RAND_MAX + 1.0);
+    points.push_back(std::make_pair(pt, i % 10));
+  }
+  std::vector<Point<2> > queries = RandomQueries(1.0);
+
+  std::cout << n << " random points, "
+            << sizeof(Node<2, int>) << " bytes per pointer node, "
+            << sizeof(double) * 2 + sizeof(int) << " bytes per implicit node"
+            << std::endl;
+  PrintHeader();
+
+  if (which.empty() || which == "pointer") {
+    auto start = std::chrono::steady_clock::now();
+    KDTree<2, int> kd(points.begin(), points.end());
+    Report("pointer", kd, SecondsSince(start), points, queries);
+  }
+
+  if (which.empty() || which == "implicit") {
+    auto start = std::chrono::steady_clock::now();
+    StaticKDTree<2, int> kd(points.begin(), points.end());
+    Report("implicit", kd, SecondsSince(start), points, queries);
+  }
+}
+
+int main(int argc, char* argv[]) {
+  if (argc > 1 && std::string(argv[1]) == "layout")
+    LayoutBenchmark(argc > 2 ? atoi(argv[2]) : 2000000, argc > 3 ? argv[3] : "");
+  else
+    SortedBenchmark(argc > 1 ? atoi(argv[1]) : 20000);
+
+  return 0;
+}
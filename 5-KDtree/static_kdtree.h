@@ -0,0 +1,303 @@
+/**
+ * File: static_kdtree.h
+ * ------------------------
+ * A kd-tree that is built once from a set of data and then only queried. It
+ * answers contains, at and kNNValue like KDTree, but keeps no pointers: the
+ * nodes live in one array in breadth-first (implicit heap) order, so the
+ * children of node i are nodes 2i + 1 and 2i + 2. The coordinates of all the
+ * nodes are packed in one array of doubles and the values in another, which
+ * keeps the top levels of the tree in a few cache lines and lets a query
+ * walk the tree without chasing heap pointers.
+ */
+#ifndef STATIC_KDTREE_H_
+#define STATIC_KDTREE_H_
+
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <set>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "bounded_priority_queue.h"
+#include "point.h"
+
+template <int N, typename ElemType>
+class StaticKDTree {
+ public:
+  // Constructor: StaticKDTree();
+  // Usage: StaticKDTree<3, int> myTree;
+  // ----------------------------------------------------
+  // Constructs an empty StaticKDTree.
+  StaticKDTree();
+
+  // template <typename InputIterator>
+  // StaticKDTree(InputIterator begin, InputIterator end);
+  // Usage: StaticKDTree<3, int> myTree(points.begin(), points.end());
+  // ----------------------------------------------------
+  // Constructs a StaticKDTree from a range of std::pair<Point<N>, ElemType>.
+  // See build below.
+  template <typename InputIterator>
+  StaticKDTree(InputIterator begin, InputIterator end);
+
+  // int dimension() const;
+  // Usage: int dim = kd.dimension();
+  // ----------------------------------------------------
+  // Returns the dimension of the points stored in this StaticKDTree.
+  int dimension() const;
+
+  // int size() const;
+  // bool empty() const;
+  // Usage: if (kd.empty())
+  // ----------------------------------------------------
+  // Returns the number of elements in the kd-tree and whether the tree is
+  // empty.
+  int size() const;
+  bool empty() const;
+
+  // int height() const;
+  // Usage: int h = kd.height();
+  // ----------------------------------------------------
+  // Returns the number of levels of the tree, which is always the smallest
+  // possible for its size.
+  int height() const;
+
+  // template <typename InputIterator>
+  // void build(InputIterator begin, InputIterator end);
+  // Usage: kd.build(points.begin(), points.end());
+  // ----------------------------------------------------
+  // Replaces the contents of the StaticKDTree with the points of a range of
+  // std::pair<Point<N>, ElemType>, in O(n log n) time. The tree is complete:
+  // each subtree is split with nth_element so that its left part gets the
+  // size of the left subtree of a complete tree. If a point occurs more than
+  // once, the last value wins.
+  template <typename InputIterator>
+  void build(InputIterator begin, InputIterator end);
+
+  // bool contains(const Point<N>& pt) const;
+  // Usage: if (kd.contains(pt))
+  // ----------------------------------------------------
+  // Returns whether the specified point is contained in the StaticKDTree.
+  bool contains(const Point<N>& point) const;
+
+  // ElemType& at(const Point<N>& pt);
+  // const ElemType& at(const Point<N>& pt) const;
+  // Usage: cout << kd.at(v) << endl;
+  // ----------------------------------------------------
+  // Returns a reference to the value associated with the point pt. If the
+  // point is not in the tree, this function throws an out_of_range exception.
+  ElemType& at(const Point<N>& point);
+  const ElemType& at(const Point<N>& point) const;
+
+  // ElemType kNNValue(const Point<N>& key, int k) const
+  // Usage: cout << kd.kNNValue(v, 3) << endl;
+  // ----------------------------------------------------
+  // Given a point v and an integer k, finds the k points in the StaticKDTree
+  // nearest to v and returns the most common value associated with those
+  // points. In the event of a tie, one of the most frequent value will be
+  // chosen.
+  ElemType kNNValue(const Point<N>& key, int k) const;
+
+ private:
+  int size_;
+  std::vector<double> coordinates_;   // N coordinates per node
+  std::vector<ElemType> values_;
+
+  static int leftSize(int size);
+  void buildNode(std::vector<std::pair<Point<N>, ElemType> >& points, int lo, int hi, int node, int depth);
+  bool equalPoint(int node, const Point<N>& point) const;
+  int findNode(int node, const Point<N>& point, int depth) const;
+  void searchKNNValue(int node, const Point<N>& key, BoundedPriorityQueue<ElemType>& bpq, int depth) const;
+  ElemType decideKNNValue(BoundedPriorityQueue<ElemType> bpq) const;
+};
+
+/** StaticKDTree class implementation details */
+
+template <int N, typename ElemType>
+StaticKDTree<N, ElemType>::StaticKDTree() {
+  size_ = 0;
+}
+
+template <int N, typename ElemType>
+template <typename InputIterator>
+StaticKDTree<N, ElemType>::StaticKDTree(InputIterator begin, InputIterator end) {
+  size_ = 0;
+  build(begin, end);
+}
+
+template <int N, typename ElemType>
+int StaticKDTree<N, ElemType>::dimension() const {
+  return N;
+}
+
+template <int N, typename ElemType>
+int StaticKDTree<N, ElemType>::size() const {
+  return size_;
+}
+
+template <int N, typename ElemType>
+bool StaticKDTree<N, ElemType>::empty() const {
+  return size() == 0;
+}
+
+template <int N, typename ElemType>
+int StaticKDTree<N, ElemType>::height() const {
+  int levels = 0;
+  while ((1L << levels) - 1 < size_)
+    levels++;
+  return levels;
+}
+
+// The points are sorted lexicographically to drop the duplicates, keeping the
+// last value of each point, and then handed to buildNode.
+template <int N, typename ElemType>
+template <typename InputIterator>
+void StaticKDTree<N, ElemType>::build(InputIterator begin, InputIterator end) {
+  std::vector<std::pair<Point<N>, ElemType> > points(begin, end);
+  std::stable_sort(points.begin(), points.end(),
+      [](const std::pair<Point<N>, ElemType>& a, const std::pair<Point<N>, ElemType>& b) {
+        return std::lexicographical_compare(a.first.begin(), a.first.end(), b.first.begin(), b.first.end());
+      });
+  int unique = 0;
+  for (int i = 0; i < (int) points.size(); i++) {
+    if (i + 1 < (int) points.size() && points[i + 1].first == points[i].first)
+      continue;
+    if (unique != i)
+      points[unique] = points[i];
+    unique++;
+  }
+  points.resize(unique);
+
+  size_ = unique;
+  coordinates_.assign((size_t) unique * N, 0.0);
+  values_.assign(unique, ElemType());
+  buildNode(points, 0, unique, 0, 0);
+}
+
+template <int N, typename ElemType>
+bool StaticKDTree<N, ElemType>::contains(const Point<N>& point) const {
+  return findNode(0, point, 0) >= 0;
+}
+
+template <int N, typename ElemType>
+ElemType& StaticKDTree<N, ElemType>::at(const Point<N>& point) {
+  return const_cast<ElemType&>(
+      static_cast<const StaticKDTree<N, ElemType>&>(*this).at(point));
+}
+
+template <int N, typename ElemType>
+const ElemType& StaticKDTree<N, ElemType>::at(const Point<N>& point) const {
+  int node = findNode(0, point, 0);
+  if (node < 0)
+    throw std::out_of_range("Function at: out of range error");
+  else
+    return values_[node];
+}
+
+template <int N, typename ElemType>
+ElemType StaticKDTree<N, ElemType>::kNNValue(const Point<N>& key, int k) const {
+  BoundedPriorityQueue<ElemType> bpq(k);
+  searchKNNValue(0, key, bpq, 0);
+  return decideKNNValue(bpq);
+}
+
+// Size of the left subtree of a complete binary tree of the given size: the
+// full levels below the root are split evenly, and the last level fills the
+// left subtree first.
+template <int N, typename ElemType>
+int StaticKDTree<N, ElemType>::leftSize(int size) {
+  if (size <= 1)
+    return 0;
+  int half = 1;   // each subtree has half - 1 nodes on its full levels
+  while (4 * half - 1 <= size)
+    half *= 2;
+  return (half - 1) + std::min(size - (2 * half - 1), half);
+}
+
+// The node gets the point whose rank on the axis equals the size of the left
+// subtree. Unlike KDTree::buildNode, the points equal to it on the axis may
+// end up on either side, because the shape of the tree is fixed; findNode
+// therefore searches both sides on a tie.
+template <int N, typename ElemType>
+void StaticKDTree<N, ElemType>::buildNode(
+  std::vector<std::pair<Point<N>, ElemType> >& points, int lo, int hi, int node, int depth) {
+  if (lo >= hi)
+    return;
+
+  int index = depth % N;
+  int mid = lo + leftSize(hi - lo);
+  std::nth_element(points.begin() + lo, points.begin() + mid, points.begin() + hi,
+      [index](const std::pair<Point<N>, ElemType>& a, const std::pair<Point<N>, ElemType>& b) {
+        return a.first[index] < b.first[index];
+      });
+
+  std::copy(points[mid].first.begin(), points[mid].first.end(), coordinates_.begin() + (size_t) node * N);
+  values_[node] = points[mid].second;
+  buildNode(points, lo, mid, 2 * node + 1, depth + 1);
+  buildNode(points, mid + 1, hi, 2 * node + 2, depth + 1);
+}
+
+template <int N, typename ElemType>
+bool StaticKDTree<N, ElemType>::equalPoint(int node, const Point<N>& point) const {
+  return std::equal(point.begin(), point.end(), coordinates_.begin() + (size_t) node * N);
+}
+
+template <int N, typename ElemType>
+int StaticKDTree<N, ElemType>::findNode(int node, const Point<N>& point, int depth) const {
+  while (node < size_) {
+    if (equalPoint(node, point))
+      return node;
+
+    int index = depth % N;
+    double split = coordinates_[(size_t) node * N + index];
+    if (point[index] == split) {
+      int found = findNode(2 * node + 1, point, depth + 1);
+      if (found >= 0)
+        return found;
+    }
+    node = point[index] < split ? 2 * node + 1 : 2 * node + 2;
+    depth++;
+  }
+  return -1;
+}
+
+template <int N, typename ElemType>
+void StaticKDTree<N, ElemType>::searchKNNValue(
+  int node, const Point<N>& key, BoundedPriorityQueue<ElemType>& bpq, int depth) const {
+  if (node >= size_)
+    return;
+
+  const double* coordinates = &coordinates_[(size_t) node * N];
+  double dist = 0.0;
+  for (int i = 0; i < N; i++)
+    dist += (key[i] - coordinates[i]) * (key[i] - coordinates[i]);
+  bpq.enqueue(values_[node], sqrt(dist));
+
+  int index = depth % N;
+  int near = key[index] < coordinates[index] ? 2 * node + 1 : 2 * node + 2;
+  int far = near == 2 * node + 1 ? 2 * node + 2 : 2 * node + 1;
+  searchKNNValue(near, key, bpq, depth + 1);
+
+  if (bpq.size() < bpq.maxSize() || fabs(key[index] - coordinates[index]) < bpq.worst())
+    searchKNNValue(far, key, bpq, depth + 1);
+}
+
+template <int N, typename ElemType>
+ElemType StaticKDTree<N, ElemType>::decideKNNValue(BoundedPriorityQueue<ElemType> bpq) const {
+  std::multiset<ElemType> value_set;
+  while (!bpq.empty())
+    value_set.insert(bpq.dequeueMin());
+
+  size_t max = 0;
+  ElemType KNNValue = ElemType();
+  for (typename std::multiset<ElemType>::const_iterator i(value_set.begin()), end(value_set.end()); i != end; ++i) {
+    if (max < value_set.count(*i)) {
+      max = value_set.count(*i);
+      KNNValue = *i;
+    }
+  }
+  return KNNValue;
+}
+
+#endif  // STATIC_KDTREE_H_
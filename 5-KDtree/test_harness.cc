@@ -12,6 +12,7 @@
  * cases here pass.
  */
 #include <cstdarg>
+#include <cstdlib>
 #include <iomanip>
 #include <iostream>
 #include <set>
@@ -19,6 +20,7 @@
 #include <string>
 #include <vector>
 #include "kdtree.h"
+#include "static_kdtree.h"
 
 /* these flags control which tests will be run.  initially, only the
  * basic test will be executed.  as you complete more and more parts
@@ -39,6 +41,10 @@
 #define BasicCopyTestEnabled           1  // Step three checks
 #define ModerateCopyTestEnabled        1
 
+#define BulkBuildKDTreeTestEnabled     1  // Step five checks
+
+#define StaticKDTreeTestEnabled        1  // Step six checks
+
 enum class TestResult { kPass, kFail, kTestDisabled };
 
 struct Test {
@@ -849,6 +855,158 @@ TestResult ModerateCopyTest() try {
   return TestResult::kFail;
 }
 
+/* Bulk build test: Does build produce a balanced tree holding the same
+ * elements, with the same nearest neighbors, as repeated insertion, even
+ * from sorted input with many equal coordinates?
+ */
+TestResult BulkBuildKDTreeTest() try {
+#if BulkBuildKDTreeTestEnabled
+  bool pass = true;
+
+  PrintBanner("Bulk Build KDTree Test");
+
+  /* A grid in sorted order, so every row and column repeats a coordinate,
+   * followed by new values for the first ten points.
+   */
+  std::vector<std::pair<Point<2>, size_t> > grid;
+  for (size_t i = 0; i < 20; ++i)
+    for (size_t j = 0; j < 20; ++j)
+      grid.push_back(std::make_pair(MakePoint(i, j), 20 * i + j));
+  for (size_t i = 0; i < 10; ++i)
+    grid.push_back(std::make_pair(grid[i].first, 1000 + i));
+
+  KDTree<2, size_t> kd(grid.begin(), grid.end());
+  pass &= CheckCondition(kd.size() == 400, "Duplicate points are stored once.");
+  /* The points equal to a median all go right, so the ties cost a few levels
+   * over the ideal height of 9.
+   */
+  pass &= CheckCondition(kd.height() <= 12, "Tree of 400 points stays shallow.");
+
+  for (size_t i = 0; i < 400; ++i)
+    pass &= CheckCondition(kd.contains(grid[i].first) &&
+                               kd.at(grid[i].first) == (i < 10 ? 1000 + i : i),
+                           "Built tree has correct values; the last one wins.");
+  pass &= CheckCondition(!kd.contains(MakePoint(0.5, 0.0)),
+                         "Nonexistent elements aren't in the tree.");
+
+  /* Random points with no ties, so both trees must agree on every query. */
+  std::vector<std::pair<Point<2>, size_t> > cloud;
+  KDTree<2, size_t> inserted;
+  srand(137);
+  for (size_t i = 0; i < 2000; ++i) {
+    Point<2> pt = MakePoint(rand() / (RAND_MAX + 1.0), rand() / (RAND_MAX + 1.0));
+    cloud.push_back(std::make_pair(pt, i % 7));
+    inserted.insert(pt, i % 7);
+  }
+  kd.build(cloud.begin(), cloud.end());
+  pass &= CheckCondition(kd.size() == 2000, "Rebuilt tree has the new points only.");
+  pass &= CheckCondition(kd.height() <= 11, "Tree of 2000 points has height at most 11.");
+  pass &= CheckCondition(!kd.contains(grid[0].first), "Old points are gone after build.");
+
+  bool same = true;
+  for (size_t i = 0; i < 200; ++i) {
+    Point<2> key = MakePoint(rand() / (RAND_MAX + 1.0), rand() / (RAND_MAX + 1.0));
+    same &= kd.kNNValue(key, 5) == inserted.kNNValue(key, 5);
+  }
+  pass &= CheckCondition(same, "Built and inserted trees agree on kNN queries.");
+
+  KDTree<2, size_t> empty(cloud.end(), cloud.end());
+  pass &= CheckCondition(empty.empty() && empty.height() == 0,
+                         "Building from an empty range gives an empty tree.");
+
+  EndTest();
+  return pass ? TestResult::kPass : TestResult::kFail;
+#else
+  TestDisabled("BulkBuildKDTreeTest");
+  return TestResult::kTestDisabled;
+#endif
+} catch (const std::exception& e) {
+  FailTest(e);
+  return TestResult::kFail;
+}
+
+/* Static tree test: Does the implicit layout find every point of trees of
+ * all the shapes a complete tree can take, even with ties on the axes, and
+ * answer kNN queries like KDTree does?
+ */
+TestResult StaticKDTreeTest() try {
+#if StaticKDTreeTestEnabled
+  bool pass = true;
+
+  PrintBanner("Static KDTree Test");
+
+  StaticKDTree<2, size_t> empty;
+  pass &= CheckCondition(empty.empty() && empty.height() == 0,
+                         "New static KD tree is empty.");
+  pass &= CheckCondition(!empty.contains(MakePoint(0, 0)),
+                         "Empty static KD tree contains nothing.");
+
+  /* Grids of every size from 1 to 64 points, in sorted order, so that the
+   * last level of the complete tree takes every possible fill and the
+   * coordinates repeat across rows and columns.
+   */
+  bool found = true;
+  bool heights = true;
+  for (size_t n = 1; n <= 64; ++n) {
+    std::vector<std::pair<Point<2>, size_t> > grid;
+    for (size_t i = 0; i < n; ++i)
+      grid.push_back(std::make_pair(MakePoint(i / 5, i % 5), i));
+    StaticKDTree<2, size_t> kd(grid.begin(), grid.end());
+    for (size_t i = 0; i < n; ++i)
+      found &= kd.contains(grid[i].first) && kd.at(grid[i].first) == i;
+    found &= !kd.contains(MakePoint(0.5, 0.5)) && kd.size() == (int) n;
+    heights &= (1u << kd.height()) > n && (1u << (kd.height() - 1)) <= n;
+  }
+  pass &= CheckCondition(found, "Static KD trees find all their points.");
+  pass &= CheckCondition(heights, "Static KD trees have the minimum height.");
+
+  /* Duplicates keep the last value, and at can modify a value. */
+  std::vector<std::pair<Point<2>, size_t> > dups;
+  dups.push_back(std::make_pair(MakePoint(1, 1), 1));
+  dups.push_back(std::make_pair(MakePoint(2, 2), 2));
+  dups.push_back(std::make_pair(MakePoint(1, 1), 3));
+  StaticKDTree<2, size_t> small(dups.begin(), dups.end());
+  pass &= CheckCondition(small.size() == 2 && small.at(MakePoint(1, 1)) == 3,
+                         "Duplicate points are stored once; the last one wins.");
+  small.at(MakePoint(2, 2)) = 137;
+  pass &= CheckCondition(small.at(MakePoint(2, 2)) == 137,
+                         "Values can be changed through at.");
+  bool threw = false;
+  try {
+    small.at(MakePoint(3, 3));
+  } catch (const std::out_of_range&) {
+    threw = true;
+  }
+  pass &= CheckCondition(threw, "at throws for a missing point.");
+
+  /* Random points with no ties, so both trees must agree on every query. */
+  std::vector<std::pair<Point<3>, size_t> > cloud;
+  srand(271);
+  for (size_t i = 0; i < 3000; ++i)
+    cloud.push_back(std::make_pair(
+        MakePoint(rand() / (RAND_MAX + 1.0), rand() / (RAND_MAX + 1.0),
+                  rand() / (RAND_MAX + 1.0)), i % 11));
+  KDTree<3, size_t> tree(cloud.begin(), cloud.end());
+  StaticKDTree<3, size_t> flat(cloud.begin(), cloud.end());
+  bool same = true;
+  for (size_t i = 0; i < 200; ++i) {
+    Point<3> key = MakePoint(rand() / (RAND_MAX + 1.0), rand() / (RAND_MAX + 1.0),
+                             rand() / (RAND_MAX + 1.0));
+    same &= flat.kNNValue(key, 1 + i % 9) == tree.kNNValue(key, 1 + i % 9);
+  }
+  pass &= CheckCondition(same, "Static and pointer trees agree on kNN queries.");
+
+  EndTest();
+  return pass ? TestResult::kPass : TestResult::kFail;
+#else
+  TestDisabled("StaticKDTreeTest");
+  return TestResult::kTestDisabled;
+#endif
+} catch (const std::exception& e) {
+  FailTest(e);
+  return TestResult::kFail;
+}
+
 /* Main entry point simply runs all the tests.  Note that these functions might
  * be no-ops
  * if they are disabled by the configuration settings at the top of the program.
@@ -869,6 +1027,10 @@ int main() {
       /* Step Four Tests */
       {"BasicCopyTest", BasicCopyTest},
       {"ModerateCopyTest", ModerateCopyTest},
+      /* Step Five Tests */
+      {"BulkBuildKDTreeTest", BulkBuildKDTreeTest},
+      /* Step Six Tests */
+      {"StaticKDTreeTest", StaticKDTreeTest},
   };
 
   int test_total = sizeof(tests) / sizeof(tests[0]);